@@ -24,6 +24,10 @@ namespace adria::CommandLineOptions
 		Bool perf_report = false;
 		Bool perf_hud = false;
 		Bool wait_debugger = false;
+		std::string benchmark_path{};
+		Int benchmark_frames = 0;
+		Int benchmark_warmup_frames = 0;
+		std::string benchmark_csv{};
 
 		void RegisterOptions(CLIParser& cli_parser)
 		{
@@ -47,6 +51,10 @@ namespace adria::CommandLineOptions
 			cli_parser.AddArg(false, "-perfreport");
 			cli_parser.AddArg(false, "-perfhud");
 			cli_parser.AddArg(false, "-waitdebugger");
+			cli_parser.AddArg(true, "-benchmark");
+			cli_parser.AddArg(true, "-benchmarkframes");
+			cli_parser.AddArg(true, "-benchmarkwarmup");
+			cli_parser.AddArg(true, "-benchmarkcsv");
 		}
 	}
 
@@ -75,6 +83,10 @@ namespace adria::CommandLineOptions
 		perf_report = parse_result["-perfreport"];
 		perf_hud = parse_result["-perfhud"];
 		wait_debugger = parse_result["-waitdebugger"];
+		benchmark_path = parse_result["-benchmark"].AsStringOr("");
+		benchmark_frames = parse_result["-benchmarkframes"].AsIntOr(1000);
+		benchmark_warmup_frames = parse_result["-benchmarkwarmup"].AsIntOr(60);
+		benchmark_csv = parse_result["-benchmarkcsv"].AsStringOr("");
 	}
 
 	std::string const& GetLogFile()
@@ -171,5 +183,25 @@ namespace adria::CommandLineOptions
 		return wait_debugger;
 	}
 
+	std::string const& GetBenchmarkPath()
+	{
+		return benchmark_path;
+	}
+
+	Int GetBenchmarkFrames()
+	{
+		return benchmark_frames;
+	}
+
+	Int GetBenchmarkWarmupFrames()
+	{
+		return benchmark_warmup_frames;
+	}
+
+	std::string const& GetBenchmarkCsv()
+	{
+		return benchmark_csv;
+	}
+
 }
 
@@ -25,6 +25,10 @@ namespace adria
 		Bool GetPerfReport();
 		Bool GetPerfHUD();
 		Bool WaitDebugger();
+		std::string const& GetBenchmarkPath();
+		Int GetBenchmarkFrames();
+		Int GetBenchmarkWarmupFrames();
+		std::string const& GetBenchmarkCsv();
 	}
 }
 
@@ -1,39 +1,13 @@
 #include "ConsoleManager.h"
+#include "ConsoleTokenizer.h"
+#include "Paths.h"
 #include "Utilities/StringConversions.h"
 
+namespace fs = std::filesystem;
+
 namespace adria
 {
-	class ConsoleVariableBase : public IConsoleVariable
-	{
-	public:
-		ConsoleVariableBase(Char const* name, Char const* help)
-		{
-			SetName(name);
-			SetHelp(help);
-		}
-
-		virtual Char const* GetHelp() const override { return help.c_str(); }
-		virtual void SetHelp(Char const* _help) override { help = _help; }
-
-		virtual Char const* GetName() const override { return name.c_str(); }
-		virtual void SetName(Char const* _name) override { name = _name; }
-
-		virtual void AddOnChanged(ConsoleVariableDelegate const& delegate)
-		{
-			on_changed_callback.Add(delegate);
-		}
-		virtual ConsoleVariableMulticastDelegate& OnChangedDelegate() override { return on_changed_callback; }
-
-		virtual class IConsoleVariable* AsVariable() override
-		{
-			return this;
-		}
-
-	private:
-		std::string name;
-		std::string help;
-		ConsoleVariableMulticastDelegate on_changed_callback;
-	};
+	ADRIA_LOG_CHANNEL(Console);
 
 	namespace detail
 	{
@@ -118,6 +92,174 @@ namespace adria
 		}
 	}
 
+	class ConsoleVariableBase : public IConsoleVariable
+	{
+	public:
+		ConsoleVariableBase(Char const* name, Char const* help)
+		{
+			SetName(name);
+			SetHelp(help);
+		}
+
+		virtual Char const* GetHelp() const override { return help.c_str(); }
+		virtual void SetHelp(Char const* _help) override { help = _help; }
+
+		virtual Char const* GetName() const override { return name.c_str(); }
+		virtual void SetName(Char const* _name) override { name = _name; }
+
+		virtual void AddOnChanged(ConsoleVariableDelegate const& delegate)
+		{
+			on_changed_callback.Add(delegate);
+		}
+		virtual ConsoleVariableMulticastDelegate& OnChangedDelegate() override { return on_changed_callback; }
+
+		virtual class IConsoleVariable* AsVariable() override
+		{
+			return this;
+		}
+
+		virtual void SetMetadata(ConsoleVariableMetadata const& _metadata) override { metadata = _metadata; }
+		virtual ConsoleVariableMetadata const& GetMetadata() const override { return metadata; }
+		virtual std::string GetValueHint() const override
+		{
+			std::string hint;
+			if (!metadata.enum_names.empty())
+			{
+				hint = "<";
+				for (Uint64 i = 0; i < metadata.enum_names.size(); ++i)
+				{
+					if (i > 0) hint += '|';
+					hint += metadata.enum_names[i];
+				}
+				hint += '>';
+			}
+			else if (metadata.min_value || metadata.max_value)
+			{
+				hint = std::format("[{}, {}]", metadata.min_value ? std::format("{}", *metadata.min_value) : "-inf",
+											  metadata.max_value ? std::format("{}", *metadata.max_value) : "inf");
+			}
+			else if (IsBool())
+			{
+				hint = "<true|false>";
+			}
+			auto AddFlag = [&hint](Char const* flag_name)
+				{
+					hint += hint.empty() ? "" : (hint.back() == '>' || hint.back() == ']' ? " " : ", ");
+					hint += flag_name;
+				};
+			if (HasFlag(metadata.flags, ConsoleVariableFlag::ReadOnly)) AddFlag("read only");
+			if (HasFlag(metadata.flags, ConsoleVariableFlag::Cheat)) AddFlag("cheat");
+			if (HasFlag(metadata.flags, ConsoleVariableFlag::RequiresRestart)) AddFlag("requires restart");
+			return hint;
+		}
+
+	protected:
+		ConsoleVariableMetadata metadata;
+
+	protected:
+		void QueueWrite(std::function<Bool()>&& apply)
+		{
+			g_ConsoleManager.QueueWrite(this, std::move(apply));
+		}
+
+		//int variables with enum names accept a case insensitive name in addition to the number
+		template<typename T>
+		Bool ParseValue(Char const* str_value, T& out) const
+		{
+			if constexpr (std::is_same_v<T, Int>)
+			{
+				std::string_view const str(str_value);
+				for (Uint64 i = 0; i < metadata.enum_names.size(); ++i)
+				{
+					std::string const& enum_name = metadata.enum_names[i];
+					if (std::equal(enum_name.begin(), enum_name.end(), str.begin(), str.end(), [](Char a, Char b) { return tolower(a) == tolower(b); }))
+					{
+						out = (Int)i;
+						return true;
+					}
+				}
+			}
+			return FromCString(str_value, out);
+		}
+
+		//enum values outside of the named range are rejected, numbers outside of [min, max] are clamped
+		template<typename T>
+		Bool Constrain(T& new_value) const
+		{
+			if constexpr (std::is_same_v<T, Int>)
+			{
+				if (!metadata.enum_names.empty())
+				{
+					if (new_value < 0 || new_value >= (Int)metadata.enum_names.size())
+					{
+						ADRIA_LOG(WARNING, "%s: %d is not a valid value, expected %s", GetName(), new_value, GetValueHint().c_str());
+						return false;
+					}
+					return true;
+				}
+			}
+			if constexpr (std::is_same_v<T, Int> || std::is_same_v<T, Float>)
+			{
+				T clamped = new_value;
+				if (metadata.min_value && clamped < (T)*metadata.min_value) clamped = (T)*metadata.min_value;
+				if (metadata.max_value && clamped > (T)*metadata.max_value) clamped = (T)*metadata.max_value;
+				if (clamped != new_value)
+				{
+					ADRIA_LOG(WARNING, "%s: %s is outside of %s, clamped to %s", GetName(),
+						detail::ConsoleVariableConversionHelper<T>::GetString(new_value).c_str(), GetValueHint().c_str(),
+						detail::ConsoleVariableConversionHelper<T>::GetString(clamped).c_str());
+					new_value = clamped;
+				}
+			}
+			return true;
+		}
+
+		template<typename T>
+		std::string ToString(T const& value) const
+		{
+			if constexpr (std::is_same_v<T, Int>)
+			{
+				if (value >= 0 && value < (Int)metadata.enum_names.size()) return metadata.enum_names[value];
+			}
+			return detail::ConsoleVariableConversionHelper<T>::GetString(value);
+		}
+
+		//scalars are read and published with atomic accesses so readers on any thread never see a torn value,
+		//strings are copied under a lock. the storage itself is only written at the frame sync point
+		template<typename T>
+		T Load(T const& value) const
+		{
+			if constexpr (std::is_scalar_v<T>)
+			{
+				return std::atomic_ref<T>(const_cast<T&>(value)).load(std::memory_order_acquire);
+			}
+			else
+			{
+				std::lock_guard<std::mutex> lock(string_mutex);
+				return value;
+			}
+		}
+		template<typename T>
+		void Store(T& value, T const& new_value)
+		{
+			if constexpr (std::is_scalar_v<T>)
+			{
+				std::atomic_ref<T>(value).store(new_value, std::memory_order_release);
+			}
+			else
+			{
+				std::lock_guard<std::mutex> lock(string_mutex);
+				value = new_value;
+			}
+		}
+
+	private:
+		std::string name;
+		std::string help;
+		ConsoleVariableMulticastDelegate on_changed_callback;
+		mutable std::mutex string_mutex;
+	};
+
 	class ConsoleCommandBase : public IConsoleCommand
 	{
 	public:
@@ -147,18 +289,16 @@ namespace adria
 	class ConsoleVariable : public ConsoleVariableBase
 	{
 	public:
-		ConsoleVariable(T default_value, Char const* name, Char const* help) : ConsoleVariableBase(name, help), value(default_value)
+		ConsoleVariable(T default_value, Char const* name, Char const* help) : ConsoleVariableBase(name, help), value(default_value), default_value(default_value)
 		{
 		}
 
 		virtual Bool Set(Char const* str_value) override
 		{
 			T out;
-			if (FromCString(str_value, out))
+			if (ParseValue(str_value, out))
 			{
-				value = out;
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(out);
 			}
 			return false;
 		}
@@ -166,27 +306,19 @@ namespace adria
 		{
 			if constexpr (std::is_same_v<T, Bool>)
 			{
-				value = bool_value;
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(bool_value);
 			}
 			else if constexpr (std::is_same_v<T, Int>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Bool>::GetInt(bool_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Bool>::GetInt(bool_value));
 			}
 			else if constexpr (std::is_same_v<T, Float>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Bool>::GetFloat(bool_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Bool>::GetFloat(bool_value));
 			}
 			else if constexpr (std::is_same_v<T, std::string>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Bool>::GetString(bool_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Bool>::GetString(bool_value));
 			}
 			return false;
 		}
@@ -194,27 +326,19 @@ namespace adria
 		{
 			if constexpr (std::is_same_v<T, Int>)
 			{
-				value = int_value;
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(int_value);
 			}
 			else if constexpr (std::is_same_v<T, Bool>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Int>::GetInt(int_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Int>::GetInt(int_value));
 			}
 			else if constexpr (std::is_same_v<T, Float>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Int>::GetFloat(int_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Int>::GetFloat(int_value));
 			}
 			else if constexpr (std::is_same_v<T, std::string>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Int>::GetString(int_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Int>::GetString(int_value));
 			}
 			return false;
 		}
@@ -222,48 +346,61 @@ namespace adria
 		{
 			if constexpr (std::is_same_v<T, Float>)
 			{
-				value = float_value;
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(float_value);
 			}
 			else if constexpr (std::is_same_v<T, Int>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Float>::GetInt(float_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Float>::GetInt(float_value));
 			}
 			else if constexpr (std::is_same_v<T, Bool>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Float>::GetBool(float_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Float>::GetBool(float_value));
 			}
 			else if constexpr (std::is_same_v<T, std::string>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Float>::GetString(float_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Float>::GetString(float_value));
 			}
 			return false;
 		}
 
-		virtual Bool GetBool() const override { return detail::ConsoleVariableConversionHelper<T>::GetBool(value); }
-		virtual Int GetInt() const override { return detail::ConsoleVariableConversionHelper<T>::GetInt(value); }
-		virtual Float GetFloat() const override { return detail::ConsoleVariableConversionHelper<T>::GetFloat(value); }
-		virtual std::string GetString() const override { return detail::ConsoleVariableConversionHelper<T>::GetString(value); }
+		virtual Bool GetBool() const override { return detail::ConsoleVariableConversionHelper<T>::GetBool(Load(value)); }
+		virtual Int GetInt() const override { return detail::ConsoleVariableConversionHelper<T>::GetInt(Load(value)); }
+		virtual Float GetFloat() const override { return detail::ConsoleVariableConversionHelper<T>::GetFloat(Load(value)); }
+		virtual std::string GetString() const override { return ToString(Load(value)); }
+
+		virtual std::string GetDefaultString() const override { return ToString(default_value); }
+		virtual Bool IsDefault() const override { return Load(value) == default_value; }
+		virtual Bool Equals(Char const* str_value) const override
+		{
+			T parsed{};
+			return ParseValue(str_value, parsed) && parsed == Load(value);
+		}
+		virtual void Reset() override
+		{
+			Write(default_value);
+		}
 
 		virtual Bool IsBool() const override { return false; }
 		virtual Bool IsInt() const override { return false; }
 		virtual Bool IsFloat() const override { return false; }
 		virtual Bool IsString() const override { return false; }
 
-		virtual Bool* GetBoolPtr() override { return nullptr; }
-		virtual Int* GetIntPtr() override { return nullptr; }
-		virtual Float* GetFloatPtr() override { return nullptr; }
-		virtual std::string* GetStringPtr() override { return nullptr; }
-
 	private:
 		T value;
+		T const default_value;
+
+	private:
+		Bool Write(T new_value)
+		{
+			if (!Constrain(new_value)) return false;
+			QueueWrite([this, new_value]()
+				{
+					if (Load(value) == new_value) return false;
+					Store(value, new_value);
+					return true;
+				});
+			return true;
+		}
 	};
 
 	template<> Bool ConsoleVariable<Bool>::IsBool() const
@@ -282,37 +419,21 @@ namespace adria
 	{
 		return true;
 	}
-	template<> Bool* ConsoleVariable<Bool>::GetBoolPtr()
-	{
-		return &value;
-	}
-	template<> Int* ConsoleVariable<Int>::GetIntPtr()
-	{
-		return &value;
-	}
-	template<> Float* ConsoleVariable<Float>::GetFloatPtr()
-	{
-		return &value;
-	}
-	template<> std::string* ConsoleVariable<std::string>::GetStringPtr()
-	{
-		return &value;
-	}
 
 	template <typename T>
 	class ConsoleVariableRef : public ConsoleVariableBase
 	{
 	public:
-		ConsoleVariableRef(T& ref_value, Char const* name, Char const* help) : ConsoleVariableBase(name, help), value(ref_value)
+		ConsoleVariableRef(T& ref_value, Char const* name, Char const* help) : ConsoleVariableBase(name, help), value(ref_value), default_value(ref_value)
 		{
 		}
 
 		virtual Bool Set(Char const* str_value) override
 		{
-			if (FromCString(str_value, value))
+			T out;
+			if (ParseValue(str_value, out))
 			{
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(out);
 			}
 			return false;
 		}
@@ -320,27 +441,19 @@ namespace adria
 		{
 			if constexpr (std::is_same_v<T, Bool>)
 			{
-				value = bool_value;
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(bool_value);
 			}
 			else if constexpr (std::is_same_v<T, Int>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Bool>::GetInt(bool_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Bool>::GetInt(bool_value));
 			}
 			else if constexpr (std::is_same_v<T, Float>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Bool>::GetFloat(bool_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Bool>::GetFloat(bool_value));
 			}
 			else if constexpr (std::is_same_v<T, std::string>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Bool>::GetString(bool_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Bool>::GetString(bool_value));
 			}
 			return false;
 		}
@@ -348,27 +461,19 @@ namespace adria
 		{
 			if constexpr (std::is_same_v<T, Int>)
 			{
-				value = int_value;
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(int_value);
 			}
 			else if constexpr (std::is_same_v<T, Bool>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Int>::GetInt(int_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Int>::GetInt(int_value));
 			}
 			else if constexpr (std::is_same_v<T, Float>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Int>::GetFloat(int_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Int>::GetFloat(int_value));
 			}
 			else if constexpr (std::is_same_v<T, std::string>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Int>::GetString(int_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Int>::GetString(int_value));
 			}
 			return false;
 		}
@@ -376,36 +481,40 @@ namespace adria
 		{
 			if constexpr (std::is_same_v<T, Float>)
 			{
-				value = float_value;
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(float_value);
 			}
 			else if constexpr (std::is_same_v<T, Int>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Float>::GetInt(float_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Float>::GetInt(float_value));
 			}
 			else if constexpr (std::is_same_v<T, Bool>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Float>::GetBool(float_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Float>::GetBool(float_value));
 			}
 			else if constexpr (std::is_same_v<T, std::string>)
 			{
-				value = detail::ConsoleVariableConversionHelper<Float>::GetString(float_value);
-				OnChangedDelegate().Broadcast(this);
-				return true;
+				return Write(detail::ConsoleVariableConversionHelper<Float>::GetString(float_value));
 			}
 			return false;
 		}
 
 
-		virtual Bool GetBool() const override { return detail::ConsoleVariableConversionHelper<T>::GetBool(value); }
-		virtual Int GetInt() const override { return detail::ConsoleVariableConversionHelper<T>::GetInt(value); }
-		virtual Float GetFloat() const override { return detail::ConsoleVariableConversionHelper<T>::GetFloat(value); }
-		virtual std::string GetString() const override { return detail::ConsoleVariableConversionHelper<T>::GetString(value); }
+		virtual Bool GetBool() const override { return detail::ConsoleVariableConversionHelper<T>::GetBool(Load(value)); }
+		virtual Int GetInt() const override { return detail::ConsoleVariableConversionHelper<T>::GetInt(Load(value)); }
+		virtual Float GetFloat() const override { return detail::ConsoleVariableConversionHelper<T>::GetFloat(Load(value)); }
+		virtual std::string GetString() const override { return ToString(Load(value)); }
+
+		virtual std::string GetDefaultString() const override { return ToString(default_value); }
+		virtual Bool IsDefault() const override { return Load(value) == default_value; }
+		virtual Bool Equals(Char const* str_value) const override
+		{
+			T parsed{};
+			return ParseValue(str_value, parsed) && parsed == Load(value);
+		}
+		virtual void Reset() override
+		{
+			Write(default_value);
+		}
 
 		virtual Bool IsBool() const override { return false; }
 		virtual Bool IsInt() const override { return false; }
@@ -414,6 +523,20 @@ namespace adria
 
 	private:
 		T& value;
+		T const default_value;
+
+	private:
+		Bool Write(T new_value)
+		{
+			if (!Constrain(new_value)) return false;
+			QueueWrite([this, new_value]()
+				{
+					if (Load(value) == new_value) return false;
+					Store(value, new_value);
+					return true;
+				});
+			return true;
+		}
 	};
 
 	template<> Bool ConsoleVariableRef<Bool>::IsBool() const
@@ -533,19 +656,28 @@ namespace adria
 
 	void ConsoleManager::UnregisterConsoleObject(IConsoleObject* console_obj)
 	{
-		for (auto& [name, obj] : console_objects)
 		{
-			if (console_obj == obj)
-			{
-				UnregisterConsoleObject(name);
-				break;
-			}
+			std::lock_guard<std::mutex> lock(objects_mutex);
+			auto it = std::find_if(console_objects.begin(), console_objects.end(), [console_obj](auto const& entry) { return entry.second == console_obj; });
+			if (it == console_objects.end()) return;
+			name_index.Erase(it->first);
+			console_objects.erase(it);
 		}
+		DiscardPendingWrites(console_obj);
 	}
 
 	void ConsoleManager::UnregisterConsoleObject(std::string const& name)
 	{
-		console_objects.erase(std::string(name));
+		IConsoleObject* console_obj = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(objects_mutex);
+			auto it = console_objects.find(name);
+			if (it == console_objects.end()) return;
+			console_obj = it->second;
+			name_index.Erase(it->first);
+			console_objects.erase(it);
+		}
+		DiscardPendingWrites(console_obj);
 	}
 
 	IConsoleVariable* ConsoleManager::FindConsoleVariable(std::string const& name) const
@@ -562,27 +694,279 @@ namespace adria
 
 	IConsoleObject* ConsoleManager::FindConsoleObject(std::string const& name) const
 	{
-		if (!console_objects.contains(name)) return nullptr;
-		return console_objects.find(name)->second;
+		std::lock_guard<std::mutex> lock(objects_mutex);
+		auto it = console_objects.find(name);
+		return it != console_objects.end() ? it->second : nullptr;
 	}
 
 	void ConsoleManager::ForAllObjects(ConsoleObjectDelegate const& delegate) const
 	{
-		for (auto& [name, obj] : console_objects) delegate(obj);
+		//the delegate runs without the lock held so it can look up or register objects
+		std::vector<IConsoleObject*> objects;
+		{
+			std::lock_guard<std::mutex> lock(objects_mutex);
+			objects.reserve(console_objects.size());
+			for (auto const& [name, obj] : console_objects) objects.push_back(obj);
+		}
+		for (IConsoleObject* obj : objects) delegate(obj);
+	}
+
+	void ConsoleManager::FindConsoleObjectNames(std::string_view prefix, std::vector<std::string>& names, Uint32 max_results) const
+	{
+		std::lock_guard<std::mutex> lock(objects_mutex);
+		name_index.FindPrefix(prefix, names, max_results);
 	}
 
+	void ConsoleManager::SearchConsoleObjects(std::string_view query, std::vector<ConsoleNameMatch>& matches, Uint32 max_results) const
+	{
+		std::lock_guard<std::mutex> lock(objects_mutex);
+		name_index.Search(query, matches, max_results);
+	}
+
+	void ConsoleManager::QueueWrite(IConsoleVariable* cvar, std::function<Bool()>&& apply)
+	{
+		{
+			std::lock_guard<std::mutex> lock(pending_writes_mutex);
+			if (frame_sync_started)
+			{
+				//only the last write of a variable in a frame matters
+				auto it = std::find_if(pending_writes.begin(), pending_writes.end(), [cvar](PendingWrite const& write) { return write.cvar == cvar; });
+				if (it != pending_writes.end()) it->apply = std::move(apply);
+				else pending_writes.push_back(PendingWrite{ .cvar = cvar, .apply = std::move(apply) });
+				return;
+			}
+		}
+		//before the first frame writes are applied right away, initialization code expects to read them back
+		if (apply()) cvar->OnChangedDelegate().Broadcast(cvar);
+	}
+
+	void ConsoleManager::ApplyPendingChanges()
+	{
+		//writes are applied under the lock so a variable can't be unregistered in the middle of its write,
+		//the callbacks run without it and may set or unregister variables
+		std::vector<IConsoleVariable*> changed;
+		{
+			std::lock_guard<std::mutex> lock(pending_writes_mutex);
+			frame_sync_started = true;
+			changed_variables.clear();
+			for (PendingWrite& write : pending_writes)
+			{
+				if (write.apply() && std::find(changed_variables.begin(), changed_variables.end(), write.cvar) == changed_variables.end())
+				{
+					changed_variables.push_back(write.cvar);
+				}
+			}
+			pending_writes.clear();
+			changed = changed_variables;
+		}
+		for (IConsoleVariable* cvar : changed)
+		{
+			cvar->OnChangedDelegate().Broadcast(cvar);
+		}
+	}
+
+	std::vector<IConsoleVariable*> ConsoleManager::GetChangedVariables() const
+	{
+		std::lock_guard<std::mutex> lock(pending_writes_mutex);
+		return changed_variables;
+	}
+
+	void ConsoleManager::DiscardPendingWrites(IConsoleObject* console_obj)
+	{
+		std::lock_guard<std::mutex> lock(pending_writes_mutex);
+		std::erase_if(pending_writes, [console_obj](PendingWrite const& write) { return static_cast<IConsoleObject*>(write.cvar) == console_obj; });
+		std::erase(changed_variables, console_obj);
+	}
+
+	std::vector<IConsoleVariable*> ConsoleManager::GetConsoleVariables() const
+	{
+		std::lock_guard<std::mutex> lock(objects_mutex);
+		std::vector<IConsoleVariable*> cvars;
+		for (auto const& [name, obj] : console_objects)
+		{
+			if (IConsoleVariable* cvar = obj->AsVariable()) cvars.push_back(cvar);
+		}
+		return cvars;
+	}
+
+	static TAutoConsoleVariable<Bool> AllowCheats("cvar.AllowCheats", false, "Allows setting console variables flagged as cheats from the console");
+
 	Bool ConsoleManager::ProcessInput(std::string const& cmd)
 	{
-		std::vector<std::string> args = SplitString(cmd, ' ');
-		if (args.empty()) return false;
+		std::vector<ConsoleTokens> commands;
+		std::string error;
+		if (!TokenizeConsoleInput(cmd, commands, &error))
+		{
+			ADRIA_LOG(WARNING, "%s: %s", cmd.c_str(), error.c_str());
+			return false;
+		}
+		if (commands.empty()) return false;
+
+		Bool result = true;
+		for (ConsoleTokens const& args : commands)
+		{
+			result &= ExecuteTokens(args);
+		}
+		return result;
+	}
+
+	Bool ConsoleManager::ProcessIniFile(std::string const& ini_path)
+	{
+		//relative paths of nested exec commands are resolved against the including ini file
+		fs::path path(ini_path);
+		if (path.is_relative() && !exec_stack.empty())
+		{
+			path = fs::path(exec_stack.back()).parent_path() / path;
+		}
+		std::error_code ec;
+		std::string const canonical_path = fs::weakly_canonical(path, ec).string();
+		std::string const& file_path = ec ? path.string() : canonical_path;
+
+		if (std::find(exec_stack.begin(), exec_stack.end(), file_path) != exec_stack.end())
+		{
+			ADRIA_LOG(WARNING, "Skipping exec of %s, it is already being executed", file_path.c_str());
+			return false;
+		}
+
+		std::ifstream ini_file(file_path);
+		if (!ini_file.is_open())
+		{
+			ADRIA_LOG(WARNING, "Could not open ini file %s", file_path.c_str());
+			return false;
+		}
+
+		exec_stack.push_back(file_path);
+		Bool result = true;
+		std::string line;
+		Uint32 line_number = 0;
+		while (std::getline(ini_file, line))
+		{
+			++line_number;
+			std::vector<ConsoleTokens> commands;
+			std::string error;
+			if (!TokenizeConsoleInput(line, commands, &error))
+			{
+				ADRIA_LOG(WARNING, "%s:%u: %s", file_path.c_str(), line_number, error.c_str());
+				result = false;
+				continue;
+			}
+			for (ConsoleTokens const& args : commands)
+			{
+				if (!ExecuteTokens(args))
+				{
+					ADRIA_LOG(WARNING, "%s:%u: could not execute %s", file_path.c_str(), line_number, args[0].c_str());
+					result = false;
+				}
+			}
+		}
+		exec_stack.pop_back();
+		return result;
+	}
+
+	Bool ConsoleManager::SaveConsoleVariables(std::string const& ini_path, Bool only_modified) const
+	{
+		std::vector<IConsoleVariable*> cvars = GetConsoleVariables();
+		//read only variables are owned by code and could not be loaded back
+		std::erase_if(cvars, [only_modified](IConsoleVariable* cvar)
+			{
+				return HasFlag(cvar->GetMetadata().flags, ConsoleVariableFlag::ReadOnly) || (only_modified && cvar->IsDefault());
+			});
+		std::sort(cvars.begin(), cvars.end(), [](IConsoleVariable* a, IConsoleVariable* b) { return strcmp(a->GetName(), b->GetName()) < 0; });
+
+		std::ofstream ini_file(ini_path);
+		if (!ini_file.is_open())
+		{
+			ADRIA_LOG(WARNING, "Could not open %s for writing console variables", ini_path.c_str());
+			return false;
+		}
+		for (IConsoleVariable* cvar : cvars)
+		{
+			ini_file << cvar->GetName() << ' ' << QuoteConsoleToken(GetIniValue(cvar)) << '\n';
+		}
+		return true;
+	}
+
+	Bool ConsoleManager::DiffConsoleVariables(std::string const& ini_path, std::vector<ConsoleVariableDiff>& diffs) const
+	{
+		std::ifstream ini_file(ini_path);
+		if (!ini_file.is_open())
+		{
+			ADRIA_LOG(WARNING, "Could not open %s for diffing console variables", ini_path.c_str());
+			return false;
+		}
+
+		std::unordered_map<std::string, std::string> baseline;
+		std::string line;
+		while (std::getline(ini_file, line))
+		{
+			std::vector<ConsoleTokens> commands;
+			if (!TokenizeConsoleInput(line, commands)) continue;
+			for (ConsoleTokens& args : commands)
+			{
+				if (args.size() < 2 || FindConsoleCommand(args[0])) continue;
+				if (!FindConsoleVariable(args[0]))
+				{
+					ADRIA_LOG(WARNING, "%s: unknown console variable %s", ini_path.c_str(), args[0].c_str());
+					continue;
+				}
+				baseline[std::move(args[0])] = std::move(args[1]);
+			}
+		}
 
+		diffs.clear();
+		for (IConsoleVariable* cvar : GetConsoleVariables())
+		{
+			std::string const name = cvar->GetName();
+			if (auto it = baseline.find(name); it != baseline.end())
+			{
+				if (!cvar->Equals(it->second.c_str()))
+				{
+					diffs.push_back(ConsoleVariableDiff{ .name = name, .live_value = GetIniValue(cvar), .baseline_value = it->second, .in_baseline = true });
+				}
+			}
+			else if (!cvar->IsDefault())
+			{
+				diffs.push_back(ConsoleVariableDiff{ .name = name, .live_value = GetIniValue(cvar), .baseline_value = cvar->GetDefaultString(), .in_baseline = false });
+			}
+		}
+		std::sort(diffs.begin(), diffs.end(), [](ConsoleVariableDiff const& a, ConsoleVariableDiff const& b) { return a.name < b.name; });
+		return true;
+	}
+
+	void ConsoleManager::ResetConsoleVariables()
+	{
+		for (IConsoleVariable* cvar : GetConsoleVariables())
+		{
+			if (!HasFlag(cvar->GetMetadata().flags, ConsoleVariableFlag::ReadOnly)) cvar->Reset();
+		}
+	}
+
+	Bool ConsoleManager::ExecuteTokens(ConsoleTokens const& args)
+	{
 		IConsoleObject* object = FindConsoleObject(args[0]);
 		if (!object) return false;
 
 		if (IConsoleVariable* cvar = object->AsVariable())
 		{
 			if (args.size() == 1) return false;
-			return cvar->Set(args[1].c_str());
+
+			ConsoleVariableFlag const flags = cvar->GetMetadata().flags;
+			if (HasFlag(flags, ConsoleVariableFlag::ReadOnly))
+			{
+				ADRIA_LOG(WARNING, "%s is read only", cvar->GetName());
+				return false;
+			}
+			if (HasFlag(flags, ConsoleVariableFlag::Cheat) && !AllowCheats.Get())
+			{
+				ADRIA_LOG(WARNING, "%s is a cheat, set cvar.AllowCheats to change it", cvar->GetName());
+				return false;
+			}
+			if (!cvar->Set(args[1].c_str())) return false;
+			if (HasFlag(flags, ConsoleVariableFlag::RequiresRestart))
+			{
+				ADRIA_LOG(INFO, "%s takes effect after a restart", cvar->GetName());
+			}
+			return true;
 		}
 		else if (IConsoleCommand* ccommand = object->AsCommand())
 		{
@@ -593,12 +977,78 @@ namespace adria
 		return false;
 	}
 
+	std::string ConsoleManager::GetIniValue(IConsoleVariable* cvar)
+	{
+		//shortest representation that parses back to the same float
+		if (cvar->IsFloat()) return std::format("{}", cvar->GetFloat());
+		return cvar->GetString();
+	}
+
 	IConsoleObject* ConsoleManager::AddObject(Char const* name, IConsoleObject* obj)
 	{
+		std::lock_guard<std::mutex> lock(objects_mutex);
 		ADRIA_ASSERT(!console_objects.contains(name));
 		console_objects[name] = obj;
+		name_index.Insert(name);
 		return obj;
 	}
 
-}
+	static AutoConsoleCommand ExecCommand("exec", " Executes the commands of an ini file. Arguments are: [file name]",
+		ConsoleCommandWithArgsDelegate::CreateLambda([](std::span<Char const*> args)
+			{
+				if (args.empty())
+				{
+					ADRIA_LOG(WARNING, "exec expects an ini file name");
+					return;
+				}
+				fs::path ini_path(args[0]);
+				g_ConsoleManager.ProcessIniFile(ini_path.is_relative() && !g_ConsoleManager.IsExecutingIniFile() ? paths::IniDir + args[0] : args[0]);
+			}));
+
+	static AutoConsoleCommand SaveCVarsCommand("cvar.save", " Saves console variables that differ from their defaults to an ini file. Optional arguments are: [file name, all]",
+		ConsoleCommandWithArgsDelegate::CreateLambda([](std::span<Char const*> args)
+			{
+				std::string ini_file = !args.empty() ? args[0] : "saved_cvars.ini";
+				Bool const save_all = args.size() > 1 && strcmp(args[1], "all") == 0;
+				if (g_ConsoleManager.SaveConsoleVariables(paths::IniDir + ini_file, !save_all))
+				{
+					ADRIA_LOG(INFO, "Console variables saved to %s", ini_file.c_str());
+				}
+			}));
+
+	static AutoConsoleCommand DiffCVarsCommand("cvar.diff", " Lists console variables whose live value differs from an ini file. Arguments are: [file name]",
+		ConsoleCommandWithArgsDelegate::CreateLambda([](std::span<Char const*> args)
+			{
+				if (args.empty())
+				{
+					ADRIA_LOG(WARNING, "cvar.diff expects an ini file name");
+					return;
+				}
+				std::vector<ConsoleVariableDiff> diffs;
+				if (!g_ConsoleManager.DiffConsoleVariables(paths::IniDir + args[0], diffs)) return;
+
+				for (ConsoleVariableDiff const& diff : diffs)
+				{
+					ADRIA_LOG(INFO, "%s %s (%s %s)", diff.name.c_str(), diff.live_value.c_str(), diff.in_baseline ? "ini" : "default", diff.baseline_value.c_str());
+				}
+				ADRIA_LOG(INFO, "%llu console variables differ from %s", (Uint64)diffs.size(), args[0]);
+			}));
 
+	static AutoConsoleCommand ResetCVarsCommand("cvar.reset", " Resets console variables to their defaults. Optional arguments are: [variable name]",
+		ConsoleCommandWithArgsDelegate::CreateLambda([](std::span<Char const*> args)
+			{
+				if (args.empty())
+				{
+					g_ConsoleManager.ResetConsoleVariables();
+					return;
+				}
+				if (IConsoleVariable* cvar = g_ConsoleManager.FindConsoleVariable(args[0]))
+				{
+					cvar->Reset();
+				}
+				else
+				{
+					ADRIA_LOG(WARNING, "Unknown console variable %s", args[0]);
+				}
+			}));
+}
@@ -1,13 +1,24 @@
 #pragma once
 #include "IConsoleManager.h"
+#include "ConsoleTokenizer.h"
+#include "ConsoleNameIndex.h"
 #include "Utilities/Singleton.h"
 
 namespace adria
 {
 
+	//console variable writes from any thread are queued and applied in ApplyPendingChanges, once per frame,
+	//so every reader sees the same values during a frame. change notifications are delivered at that point
 	class ConsoleManager : public IConsoleManager, public Singleton<ConsoleManager>
 	{
 		friend class Singleton<ConsoleManager>;
+
+		struct PendingWrite
+		{
+			IConsoleVariable* cvar;
+			std::function<Bool()> apply;
+		};
+
 	public:
 		ConsoleManager() {}
 		~ConsoleManager();
@@ -33,14 +44,43 @@ namespace adria
 		virtual IConsoleCommand* FindConsoleCommand(std::string const& name) const override;
 		virtual IConsoleObject* FindConsoleObject(std::string const& name) const override;
 		virtual void ForAllObjects(ConsoleObjectDelegate const&) const override;
+		//name queries go through a sorted index kept up to date on register and unregister
+		void FindConsoleObjectNames(std::string_view prefix, std::vector<std::string>& names, Uint32 max_results = 0) const;
+		void SearchConsoleObjects(std::string_view query, std::vector<ConsoleNameMatch>& matches, Uint32 max_results = 0) const;
 
 		virtual Bool ProcessInput(std::string const& cmd) override;
+		//executes every line of an ini file, nested exec commands that would form a cycle are skipped
+		virtual Bool ProcessIniFile(std::string const& ini_path) override;
+		Bool IsExecutingIniFile() const { return !exec_stack.empty(); }
+
+		//writes "name value" lines sorted by name, by default only variables that differ from their default
+		virtual Bool SaveConsoleVariables(std::string const& ini_path, Bool only_modified = true) const override;
+		//compares live values against an ini baseline, variables missing from the ini are expected to be at their default
+		virtual Bool DiffConsoleVariables(std::string const& ini_path, std::vector<ConsoleVariableDiff>& diffs) const override;
+		virtual void ResetConsoleVariables() override;
+
+		void QueueWrite(IConsoleVariable* cvar, std::function<Bool()>&& apply);
+		void ApplyPendingChanges();
+		std::vector<IConsoleVariable*> GetChangedVariables() const;
 
 	private:
+		mutable std::mutex objects_mutex;
 		std::unordered_map<std::string, IConsoleObject*> console_objects;
+		ConsoleNameIndex name_index;
+		std::vector<std::string> exec_stack;
+
+		//guards the queue and the variables changed by the last sync, unregistering can happen on any thread
+		mutable std::mutex pending_writes_mutex;
+		std::vector<PendingWrite> pending_writes;
+		std::vector<IConsoleVariable*> changed_variables;
+		Bool frame_sync_started = false;
 
 	private:
 		IConsoleObject* AddObject(Char const* name, IConsoleObject* obj);
+		Bool ExecuteTokens(ConsoleTokens const& args);
+		void DiscardPendingWrites(IConsoleObject* console_obj);
+		std::vector<IConsoleVariable*> GetConsoleVariables() const;
+		static std::string GetIniValue(IConsoleVariable* cvar);
 	};
 	#define g_ConsoleManager ConsoleManager::Get()
 
@@ -138,6 +178,11 @@ namespace adria
 		TAutoConsoleVariable(Char const* name, std::type_identity_t<T> default_value, Char const* help) : AutoConsoleVariable(name, default_value, help) {}
 		TAutoConsoleVariable(Char const* name, std::type_identity_t<T> default_value, Char const* help, ConsoleVariableDelegate const& callback)
 			: AutoConsoleVariable(name, default_value, help, callback) {}
+		TAutoConsoleVariable(Char const* name, std::type_identity_t<T> default_value, Char const* help, ConsoleVariableMetadata const& metadata)
+			: AutoConsoleVariable(name, default_value, help)
+		{
+			AsVariable()->SetMetadata(metadata);
+		}
 
 		T Get() const
 		{
@@ -146,13 +191,6 @@ namespace adria
 			if constexpr (std::is_same_v<T, Float>) return AsVariable()->GetFloat();
 			if constexpr (std::is_same_v<T, std::string>) return AsVariable()->GetString();
 		}
-		T* GetPtr()
-		{
-			if constexpr (std::is_same_v<T, Bool>) return AsVariable()->GetBoolPtr();
-			if constexpr (std::is_same_v<T, Int>) return  AsVariable()->GetIntPtr();
-			if constexpr (std::is_same_v<T, Float>) return AsVariable()->GetFloatPtr();
-			if constexpr (std::is_same_v<T, std::string>) return AsVariable()->GetStringPtr();
-		}
 
 	private:
 	};
@@ -162,7 +200,7 @@ namespace adria
 	template <Uint32 N>
 	TAutoConsoleVariable(Char const* name, const Char(&)[N], Char const* help, ConsoleVariableDelegate const& callback) -> TAutoConsoleVariable<std::string>;
 
-	class AutoConsoleVariableRef : private AutoConsoleObject
+	class AutoConsoleVariableRef : public AutoConsoleObject
 	{
 	public:
 		AutoConsoleVariableRef(Char const* name, Int& ref_value, Char const* help)
@@ -236,13 +274,6 @@ namespace adria
 			if constexpr (std::is_same_v<T, Float>) return AsVariable()->GetFloat();
 			if constexpr (std::is_same_v<T, std::string>) return AsVariable()->GetString();
 		}
-		T* GetPtr() const
-		{
-			if constexpr (std::is_same_v<T, Bool>) return AsVariable()->GetBoolPtr();
-			if constexpr (std::is_same_v<T, Int>) return  AsVariable()->GetIntPtr();
-			if constexpr (std::is_same_v<T, Float>) return AsVariable()->GetFloatPtr();
-			if constexpr (std::is_same_v<T, std::string>) return AsVariable()->GetStringPtr();
-		}
 
 	private:
 	};
@@ -0,0 +1,127 @@
+#include "ConsoleNameIndex.h"
+
+namespace adria
+{
+	namespace
+	{
+		Bool IsSegmentStart(std::string_view key, Uint64 pos)
+		{
+			return pos == 0 || key[pos - 1] == '.' || key[pos - 1] == '_';
+		}
+	}
+
+	void ConsoleNameIndex::Insert(std::string_view name)
+	{
+		std::string key = ToKey(name);
+		auto it = std::lower_bound(entries.begin(), entries.end(), key, [](Entry const& entry, std::string const& key) { return entry.key < key; });
+		//names differing only in case share a key, any of them can be the duplicate
+		for (auto same_key = it; same_key != entries.end() && same_key->key == key; ++same_key)
+		{
+			if (same_key->name == name) return;
+		}
+		entries.insert(it, Entry{ .key = std::move(key), .name = std::string(name) });
+	}
+
+	void ConsoleNameIndex::Erase(std::string_view name)
+	{
+		std::string const key = ToKey(name);
+		auto it = std::lower_bound(entries.begin(), entries.end(), key, [](Entry const& entry, std::string const& key) { return entry.key < key; });
+		for (; it != entries.end() && it->key == key; ++it)
+		{
+			if (it->name == name)
+			{
+				entries.erase(it);
+				return;
+			}
+		}
+	}
+
+	void ConsoleNameIndex::FindPrefix(std::string_view prefix, std::vector<std::string>& names, Uint32 max_results) const
+	{
+		names.clear();
+		std::string const key = ToKey(prefix);
+		auto it = std::lower_bound(entries.begin(), entries.end(), key, [](Entry const& entry, std::string const& key) { return entry.key < key; });
+		for (; it != entries.end() && it->key.starts_with(key); ++it)
+		{
+			if (max_results && names.size() == max_results) break;
+			names.push_back(it->name);
+		}
+	}
+
+	void ConsoleNameIndex::Search(std::string_view query, std::vector<ConsoleNameMatch>& matches, Uint32 max_results) const
+	{
+		matches.clear();
+		std::string const query_key = ToKey(query);
+		if (query_key.empty()) return;
+
+		for (Entry const& entry : entries)
+		{
+			std::string_view const key = entry.key;
+			Int const length_penalty = (Int)(key.size() - query_key.size());
+			if (key == query_key)
+			{
+				matches.push_back(ConsoleNameMatch{ .name = entry.name, .type = ConsoleNameMatchType::Exact, .score = 0 });
+			}
+			else if (key.starts_with(query_key))
+			{
+				matches.push_back(ConsoleNameMatch{ .name = entry.name, .type = ConsoleNameMatchType::Prefix, .score = -length_penalty });
+			}
+			else if (Uint64 pos = key.find(query_key); pos != std::string_view::npos)
+			{
+				//"r.ssao.radius" ranks "radius" above "adius"
+				Int const segment_bonus = IsSegmentStart(key, pos) ? 1000 : 0;
+				matches.push_back(ConsoleNameMatch{ .name = entry.name, .type = ConsoleNameMatchType::Substring, .score = segment_bonus - (Int)pos - length_penalty });
+			}
+			else if (Int score = 0; FuzzyScore(key, query_key, score))
+			{
+				matches.push_back(ConsoleNameMatch{ .name = entry.name, .type = ConsoleNameMatchType::Fuzzy, .score = score });
+			}
+		}
+
+		auto Ranking = [](ConsoleNameMatch const& a, ConsoleNameMatch const& b)
+			{
+				if (a.type != b.type) return a.type < b.type;
+				if (a.score != b.score) return a.score > b.score;
+				return a.name < b.name;
+			};
+		if (max_results && matches.size() > max_results)
+		{
+			std::partial_sort(matches.begin(), matches.begin() + max_results, matches.end(), Ranking);
+			matches.resize(max_results);
+		}
+		else
+		{
+			std::sort(matches.begin(), matches.end(), Ranking);
+		}
+	}
+
+	std::string ConsoleNameIndex::ToKey(std::string_view name)
+	{
+		std::string key(name);
+		for (Char& c : key) c = (Char)tolower((unsigned char)c);
+		return key;
+	}
+
+	//greedy subsequence match, consecutive characters and characters starting a name segment score higher, skipped characters lower
+	Bool ConsoleNameIndex::FuzzyScore(std::string_view key, std::string_view query, Int& score)
+	{
+		score = 0;
+		Uint64 key_pos = 0;
+		Uint64 last_match = std::string_view::npos;
+		for (Char c : query)
+		{
+			Uint64 const match = key.find(c, key_pos);
+			if (match == std::string_view::npos) return false;
+
+			score += 10;
+			if (last_match != std::string_view::npos && match == last_match + 1) score += 15;
+			if (IsSegmentStart(key, match)) score += 20;
+			score -= (Int)(match - key_pos);
+
+			last_match = match;
+			key_pos = match + 1;
+		}
+		score -= (Int)(key.size() - key_pos);
+		return true;
+	}
+}
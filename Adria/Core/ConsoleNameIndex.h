@@ -0,0 +1,50 @@
+#pragma once
+
+namespace adria
+{
+	enum class ConsoleNameMatchType : Uint8
+	{
+		Exact,
+		Prefix,
+		Substring,
+		Fuzzy
+	};
+
+	struct ConsoleNameMatch
+	{
+		std::string name;
+		ConsoleNameMatchType type;
+		Int score;
+	};
+
+	//case insensitive, sorted index of console object names.
+	//prefix queries are a binary search, substring and fuzzy subsequence queries scan the lowercase names
+	class ConsoleNameIndex
+	{
+		struct Entry
+		{
+			std::string key;
+			std::string name;
+		};
+
+	public:
+		ConsoleNameIndex() = default;
+
+		void Insert(std::string_view name);
+		void Erase(std::string_view name);
+		void Clear() { entries.clear(); }
+		Uint64 Size() const { return entries.size(); }
+
+		//names starting with prefix in alphabetical order, max_results of 0 returns all of them
+		void FindPrefix(std::string_view prefix, std::vector<std::string>& names, Uint32 max_results = 0) const;
+		//exact, prefix, substring and subsequence matches ranked in that order, within a type by score
+		void Search(std::string_view query, std::vector<ConsoleNameMatch>& matches, Uint32 max_results = 0) const;
+
+	private:
+		std::vector<Entry> entries;
+
+	private:
+		static std::string ToKey(std::string_view name);
+		static Bool FuzzyScore(std::string_view key, std::string_view query, Int& score);
+	};
+}
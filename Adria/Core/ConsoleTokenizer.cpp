@@ -0,0 +1,106 @@
+#include "ConsoleTokenizer.h"
+
+namespace adria
+{
+	namespace
+	{
+		Bool IsSpace(Char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+		}
+		Bool IsCommentStart(std::string_view input, Uint64 pos)
+		{
+			return input[pos] == '#' || (input[pos] == '/' && pos + 1 < input.size() && input[pos + 1] == '/');
+		}
+	}
+
+	Bool TokenizeConsoleInput(std::string_view input, std::vector<ConsoleTokens>& commands, std::string* error)
+	{
+		ConsoleTokens tokens;
+		auto EndCommand = [&]()
+			{
+				if (!tokens.empty()) commands.push_back(std::move(tokens));
+				tokens.clear();
+			};
+
+		Uint64 pos = 0;
+		while (pos < input.size())
+		{
+			Char const c = input[pos];
+			if (IsSpace(c))
+			{
+				++pos;
+				continue;
+			}
+			if (c == ';')
+			{
+				EndCommand();
+				++pos;
+				continue;
+			}
+			if (IsCommentStart(input, pos))
+			{
+				break;
+			}
+
+			std::string token;
+			if (c == '"')
+			{
+				Uint64 const quote_pos = pos++;
+				Bool closed = false;
+				while (pos < input.size())
+				{
+					Char const q = input[pos];
+					if (q == '"')
+					{
+						closed = true;
+						++pos;
+						break;
+					}
+					if (q == '\\' && pos + 1 < input.size() && (input[pos + 1] == '"' || input[pos + 1] == '\\'))
+					{
+						token += input[pos + 1];
+						pos += 2;
+						continue;
+					}
+					token += q;
+					++pos;
+				}
+				if (!closed)
+				{
+					if (error) *error = std::format("unterminated quote at column {}", quote_pos + 1);
+					return false;
+				}
+			}
+			else
+			{
+				while (pos < input.size() && !IsSpace(input[pos]) && input[pos] != ';' && input[pos] != '"')
+				{
+					token += input[pos++];
+				}
+			}
+			tokens.push_back(std::move(token));
+		}
+		EndCommand();
+		return true;
+	}
+
+	std::string QuoteConsoleToken(std::string const& token)
+	{
+		Bool needs_quotes = token.empty() || token[0] == '#' || token.starts_with("//");
+		for (Char c : token)
+		{
+			if (IsSpace(c) || c == ';' || c == '"') needs_quotes = true;
+		}
+		if (!needs_quotes) return token;
+
+		std::string quoted = "\"";
+		for (Char c : token)
+		{
+			if (c == '"' || c == '\\') quoted += '\\';
+			quoted += c;
+		}
+		quoted += '"';
+		return quoted;
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+namespace adria
+{
+	using ConsoleTokens = std::vector<std::string>;
+
+	//splits console input into commands and their tokens.
+	//whitespace separates tokens, ';' separates commands and '#' or '//' at the start of a token comments out the rest of the input.
+	//double quotes group a token, inside them \" and \\ are escapes and other backslashes are kept as is.
+	//returns false and fills error for an unterminated quote
+	Bool TokenizeConsoleInput(std::string_view input, std::vector<ConsoleTokens>& commands, std::string* error = nullptr);
+
+	//quotes and escapes a token if it would not survive tokenization as is
+	std::string QuoteConsoleToken(std::string const& token);
+}
@@ -7,7 +7,9 @@
 #include "Platform/Input.h"
 #include "Graphics/GfxDevice.h"
 #include "Graphics/GfxCommandList.h"
+#include "Graphics/GfxProfiler.h"
 #include "Rendering/Renderer.h"
+#include "Rendering/CameraPathController.h"
 #include "Rendering/SceneConfig.h"
 #include "Rendering/ShaderManager.h"
 #include "Utilities/ThreadPool.h"
@@ -28,6 +30,7 @@ namespace adria
 		g_TextureManager.Initialize(gfx.get());
 		renderer = std::make_unique<Renderer>(reg, gfx.get(), window->Width(), window->Height());
 		scene_loader = std::make_unique<SceneLoader>(reg, gfx.get());
+		camera_path_controller = std::make_unique<CameraPathController>();
 
 		InputEvents& input_events = g_Input.GetInputEvents();
 		input_events.window_resized_event.AddMember(&GfxDevice::OnResize, *gfx);
@@ -50,6 +53,16 @@ namespace adria
 
 		input_events.window_resized_event.AddMember(&Camera::OnResize, *camera);
 		input_events.scroll_mouse_event.AddMember(&Camera::Zoom, *camera);
+
+		if (std::string const& benchmark_path = CommandLineOptions::GetBenchmarkPath(); !benchmark_path.empty())
+		{
+			CameraBenchmarkDesc benchmark_desc{};
+			benchmark_desc.path_file = benchmark_path;
+			benchmark_desc.csv_file = CommandLineOptions::GetBenchmarkCsv();
+			benchmark_desc.frame_count = (Uint32)std::max(CommandLineOptions::GetBenchmarkFrames(), 0);
+			benchmark_desc.warmup_frames = (Uint32)std::max(CommandLineOptions::GetBenchmarkWarmupFrames(), 0);
+			if (!camera_path_controller->StartBenchmark(benchmark_desc)) window->Quit(1);
+		}
 	}
 
 	Engine::~Engine()
@@ -69,8 +82,11 @@ namespace adria
 	{
 		ZoneScopedN("Engine::Run");
 		static Timer timer;
-		Float const dt = timer.MarkInSeconds();
+		Float dt = timer.MarkInSeconds();
+		//benchmark frames are simulated with a fixed timestep so every run renders the same frames
+		if (camera_path_controller->IsBenchmarkRunning()) dt = camera_path_controller->BeginBenchmarkFrame(dt);
 		g_Input.Tick();
+		g_ConsoleManager.ApplyPendingChanges();
 		Update(dt);
 		Render(dt);
 		FrameMarkNamed("EngineFrame");
@@ -84,6 +100,8 @@ namespace adria
 			g_TextureManager.Clear();
 			reg.clear();
 			ProcessCVarIniFile(scene_request->ini_file);
+			//the new scene is initialized with the ini values right away instead of at the next frame
+			g_ConsoleManager.ApplyPendingChanges();
 			gfx->SetRenderingNotStarted();
 			InitializeScene(*scene_request);
 			scene_request = std::nullopt;
@@ -95,7 +113,7 @@ namespace adria
 		ZoneScopedN("Engine::Update");
 		HandleSceneRequest();
 		renderer->NewFrame(camera.get());
-		camera->Update(dt);
+		if (!camera_path_controller->Update(*camera, dt)) camera->Update(dt);
 		gfx->Update();
 		
 	}
@@ -103,9 +121,22 @@ namespace adria
 	{
 		ZoneScopedN("Engine::Render");
 		gfx->BeginFrame();
+		Timer benchmark_timer;
 		renderer->Update(dt);
 		renderer->Render();
+
+		Bool benchmark_finished = false;
+		if (camera_path_controller->IsBenchmarkRunning())
+		{
+			std::optional<Float> gpu_ms;
+			if (GfxProfilerTree const* profiler_tree = g_GfxProfiler.GetProfilerTree(); profiler_tree && profiler_tree->GetRoot())
+			{
+				gpu_ms = profiler_tree->GetRoot()->GetData().time;
+			}
+			benchmark_finished = camera_path_controller->EndBenchmarkFrame(benchmark_timer.ElapsedInSeconds() * 1000.0f, gpu_ms);
+		}
 		gfx->EndFrame();
+		if (benchmark_finished) window->Quit(0);
 	}
 
 	void Engine::SetViewportData(ViewportData* _viewport_data)
@@ -139,6 +170,7 @@ namespace adria
 		GfxCommandList* cmd_list = gfx->GetLatestGraphicsCommandList();
 		cmd_list->Begin();
 
+		scene_ini_file = config.ini_file;
 		camera = std::make_unique<Camera>(config.camera_params);
 		camera->SetAspectRatio((Float)window->Width() / window->Height());
 		scene_loader->LoadSkybox(config.skybox_params);
@@ -160,19 +192,16 @@ namespace adria
 		gfx->WaitForGPU();
 	}
 
+	Bool Engine::SaveScene(std::string const& scene_file) const
+	{
+		SceneConfig scene_config{};
+		scene_config.ini_file = scene_ini_file;
+		ExtractSceneConfig(reg, *camera, scene_config);
+		return WriteSceneConfig(scene_config, scene_file);
+	}
+
 	void Engine::ProcessCVarIniFile(std::string const& ini_file)
 	{
-		std::string cvar_ini_path = paths::IniDir + ini_file;
-		std::ifstream cvar_ini_file(cvar_ini_path);
-		if (!cvar_ini_file.is_open()) 
-		{
-			return;
-		}
-		std::string line;
-		while (std::getline(cvar_ini_file, line))
-		{
-			if (line.empty() || line[0] == '#') continue;
-			g_ConsoleManager.ProcessInput(line);
-		}
+		g_ConsoleManager.ProcessIniFile(paths::IniDir + ini_file);
 	}
 }
@@ -14,6 +14,7 @@ namespace adria
 	struct EditorEvents;
 	class ImGuiManager;
 	class Camera;
+	class CameraPathController;
 
 	class Engine
 	{
@@ -34,14 +35,17 @@ namespace adria
 		Window* window = nullptr;
 		entt::registry reg;
 		std::unique_ptr<Camera> camera;
+		std::unique_ptr<CameraPathController> camera_path_controller;
 		std::unique_ptr<GfxDevice> gfx;
 		std::unique_ptr<Renderer> renderer;
 		std::unique_ptr<SceneLoader> scene_loader;
 		ViewportData viewport_data;
 		std::optional<SceneConfig> scene_request;
+		std::string scene_ini_file;
 
 	private:
 		void InitializeScene(SceneConfig const&);
+		Bool SaveScene(std::string const& scene_file) const;
 		void ProcessCVarIniFile(std::string const&);
 
 		void NewSceneRequest(SceneConfig const& scene_cfg)
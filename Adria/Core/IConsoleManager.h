@@ -1,6 +1,7 @@
 #pragma once
 #include <type_traits>
 #include "Utilities/Delegate.h"
+#include "Utilities/Enum.h"
 
 namespace adria
 {
@@ -31,6 +32,24 @@ namespace adria
 		}
 	};
 
+	enum class ConsoleVariableFlag : Uint32
+	{
+		None			= 0,
+		ReadOnly		= BIT(0),	//cannot be set from the console or ini files
+		Cheat			= BIT(1),	//can be set from the console only while cheats are enabled
+		RequiresRestart = BIT(2),	//new values take effect after a restart
+	};
+	ENABLE_ENUM_BIT_OPERATORS(ConsoleVariableFlag);
+
+	struct ConsoleVariableMetadata
+	{
+		std::optional<Float> min_value;
+		std::optional<Float> max_value;
+		//names of the values 0..n-1 of an int variable, the variable can be set and is printed by name
+		std::vector<std::string> enum_names;
+		ConsoleVariableFlag flags = ConsoleVariableFlag::None;
+	};
+
 	DECLARE_DELEGATE(ConsoleVariableDelegate, IConsoleVariable*)
 	DECLARE_MULTICAST_DELEGATE(ConsoleVariableMulticastDelegate, IConsoleVariable*)
 	class IConsoleVariable : public IConsoleObject
@@ -46,16 +65,21 @@ namespace adria
 		virtual Bool IsFloat() const { return false; }
 		virtual Bool IsString() const { return false; }
 
-		virtual Int* GetIntPtr() { return nullptr; }
-		virtual Float* GetFloatPtr() { return nullptr; }
-		virtual Bool* GetBoolPtr() { return nullptr; }
-		virtual std::string* GetStringPtr() { return nullptr; }
-
 		virtual Int GetInt() const = 0;
 		virtual Float GetFloat() const = 0;
 		virtual Bool GetBool() const = 0;
 		virtual std::string GetString() const = 0;
 
+		virtual std::string GetDefaultString() const = 0;
+		virtual Bool IsDefault() const = 0;
+		virtual Bool Equals(Char const* value) const = 0;
+		virtual void Reset() = 0;
+
+		virtual void SetMetadata(ConsoleVariableMetadata const& metadata) = 0;
+		virtual ConsoleVariableMetadata const& GetMetadata() const = 0;
+		//describes the accepted values, e.g. "<None|SSR|RTR>" or "[1, 8]", followed by the flags
+		virtual std::string GetValueHint() const = 0;
+
 		virtual void AddOnChanged(ConsoleVariableDelegate const&) = 0;
 		virtual ConsoleVariableMulticastDelegate& OnChangedDelegate() = 0;
 	};
@@ -68,6 +92,14 @@ namespace adria
 		virtual Bool Execute(std::span<Char const*> args) = 0;
 	};
 
+	struct ConsoleVariableDiff
+	{
+		std::string name;
+		std::string live_value;
+		std::string baseline_value;
+		Bool in_baseline = false;
+	};
+
 	class IConsoleManager
 	{
 	public:
@@ -94,6 +126,11 @@ namespace adria
 		virtual void ForAllObjects(ConsoleObjectDelegate const&) const = 0;
 
 		virtual Bool ProcessInput(std::string const& cmd) = 0;
+		virtual Bool ProcessIniFile(std::string const& ini_path) = 0;
+
+		virtual Bool SaveConsoleVariables(std::string const& ini_path, Bool only_modified = true) const = 0;
+		virtual Bool DiffConsoleVariables(std::string const& ini_path, std::vector<ConsoleVariableDiff>& diffs) const = 0;
+		virtual void ResetConsoleVariables() = 0;
 
 
 	protected:
@@ -39,6 +39,8 @@ namespace adria
 
 	std::string const paths::ScenesDir = SavedDir + "Scenes/";
 
+	std::string const paths::CameraPathsDir = SavedDir + "CameraPaths/";
+
 	std::string const paths::AftermathDir = SavedDir + "Aftermath/";
 
 	std::string const paths::NsightPerfReportDir = SavedDir + "NsightPerfReport/";
@@ -24,6 +24,7 @@ namespace adria::paths
 	extern std::string const ShaderPDBDir;
 	extern std::string const IniDir;
 	extern std::string const ScenesDir;
+	extern std::string const CameraPathsDir;
 	extern std::string const AftermathDir;
 	extern std::string const NsightPerfReportDir;
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "ImGuiManager.h"
 #include "EditorSink.h"
 #include "EditorConsole.h"
+#include "EditorHistory.h"
 #include "Core/Engine.h"
 #include "Core/Paths.h"
 #include "Platform/Input.h"
@@ -32,8 +33,16 @@ namespace fs = std::filesystem;
 
 namespace adria
 {
+	ADRIA_LOG_CHANNEL(Editor);
+
 	extern Bool g_DumpRenderGraph;
 
+	template<>
+	struct EditorSnapshotHeapSize<Tag>
+	{
+		static Uint64 Get(Tag const& tag) { return tag.name.capacity(); }
+	};
+
 	struct ProfilerState
 	{
 		Bool  show_average = false;
@@ -66,6 +75,7 @@ namespace adria
 		engine->RegisterEditorEventCallbacks(editor_events);
 
 		console = std::make_unique<EditorConsole>();
+		history = std::make_unique<EditorHistory>();
 		ray_tracing_supported = gfx->GetCapabilities().SupportsRayTracing();
 		selected_entity = entt::null;
 		SetStyle_Default();
@@ -75,6 +85,7 @@ namespace adria
 	void Editor::Shutdown()
 	{
 		gui.reset();
+		history.reset();
 		engine.reset();
 		console.reset();
 	}
@@ -179,6 +190,14 @@ namespace adria
 			show_basic_console = !show_basic_console;
 		}
 
+		//text fields handle ctrl+z themselves
+		Bool const ctrl_down = g_Input.GetKey(KeyCode::CtrlLeft) || g_Input.GetKey(KeyCode::CtrlRight);
+		if (ctrl_down && !ImGui::GetIO().WantTextInput)
+		{
+			if (g_Input.IsKeyDown(KeyCode::Z)) Undo();
+			else if (g_Input.IsKeyDown(KeyCode::Y)) Redo();
+		}
+
 		if (gui->IsVisible())
 		{
 			engine->camera->Enable(scene_focused);
@@ -188,6 +207,20 @@ namespace adria
 			engine->camera->Enable(true);
 		}
 	}
+	void Editor::Undo()
+	{
+		if (history->Undo(engine->reg))
+		{
+			editor_events.light_changed_event.Broadcast();
+		}
+	}
+	void Editor::Redo()
+	{
+		if (history->Redo(engine->reg))
+		{
+			editor_events.light_changed_event.Broadcast();
+		}
+	}
 	void Editor::MenuBar()
 	{
 		if (ImGui::BeginMainMenuBar())
@@ -204,11 +237,31 @@ namespace adria
 						SceneConfig scene_config{};
 						if (ParseSceneConfig(file_path, scene_config, false))
 						{
+							history->Clear();
 							engine->NewSceneRequest(scene_config);
 						}
 						free(file_path);
 					}
 				}
+				if (ImGui::MenuItem(ICON_FA_FLOPPY_DISK" Save Scene"))
+				{
+					nfdchar_t* file_path = NULL;
+					const nfdchar_t* filter_list = "json";
+					nfdresult_t result = NFD_SaveDialog(filter_list, NULL, &file_path);
+					if (result == NFD_OKAY)
+					{
+						std::string scene_file = file_path;
+						if (!scene_file.ends_with(".json")) scene_file += ".json";
+						if (engine->SaveScene(scene_file)) ADRIA_LOG(INFO, "Scene saved to %s", scene_file.c_str());
+						free(file_path);
+					}
+				}
+				ImGui::EndMenu();
+			}
+			if (ImGui::BeginMenu(ICON_FA_PEN" Edit"))
+			{
+				if (ImGui::MenuItem(ICON_FA_ROTATE_LEFT" Undo", "Ctrl+Z", false, history->CanUndo())) Undo();
+				if (ImGui::MenuItem(ICON_FA_ROTATE_RIGHT" Redo", "Ctrl+Y", false, history->CanRedo())) Redo();
 				ImGui::EndMenu();
 			}
 			if (ImGui::BeginMenu(ICON_FA_WINDOW_MAXIMIZE " Windows"))
@@ -499,6 +552,8 @@ namespace adria
 			GfxDevice* gfx = engine->gfx.get();
 			if (selected_entity != entt::null)
 			{
+				//every edit of this frame is recorded as one history entry
+				history->BeginGroup();
 				Tag* tag = engine->reg.try_get<Tag>(selected_entity);
 				if (tag)
 				{
@@ -507,7 +562,9 @@ namespace adria
 					std::strncpy(buffer, tag->name.c_str(), sizeof(buffer));
 					if (ImGui::InputText("##Tag", buffer, sizeof(buffer)))
 					{
+						Tag const tag_before = *tag;
 						tag->name = std::string(buffer);
+						history->Record(selected_entity, tag_before, *tag);
 					}
 				}
 
@@ -518,6 +575,12 @@ namespace adria
 					else if (light->type == LightType::Spot)	{ ImGui::Text("Spot Light"); }
 					else if (light->type == LightType::Point)	{ ImGui::Text("Point Light"); }
 
+					Light const light_before = *light;
+					Material* light_material = engine->reg.try_get<Material>(selected_entity);
+					Transform* light_transform = engine->reg.try_get<Transform>(selected_entity);
+					std::optional<Material> material_before = light_material ? std::optional<Material>(*light_material) : std::nullopt;
+					std::optional<Transform> transform_before = light_transform ? std::optional<Transform>(*light_transform) : std::nullopt;
+
 					Bool changed = false;
 					Float color[3] = { light->color.x, light->color.y, light->color.z };
 					changed |= ImGui::ColorEdit3("Light Color", color);
@@ -525,10 +588,9 @@ namespace adria
 
 					changed |= ImGui::SliderFloat("Light Intensity", &light->intensity, 0.0f, 50.0f);
 
-					if (engine->reg.all_of<Material>(selected_entity))
+					if (light_material)
 					{
-						Material& material = engine->reg.get<Material>(selected_entity);
-						memcpy(material.albedo_color, color, 3 * sizeof(Float));
+						memcpy(light_material->albedo_color, color, 3 * sizeof(Float));
 					}
 
 					if (light->type == LightType::Directional || light->type == LightType::Spot)
@@ -561,13 +623,13 @@ namespace adria
 						changed |= ImGui::SliderFloat("Range", &light->range, 50.0f, 1000.0f);
 					}
 
-					if (engine->reg.all_of<Transform>(selected_entity))
+					if (light_transform)
 					{
-						Transform& tr = engine->reg.get<Transform>(selected_entity);
 						Vector3 translation(light->position.x, light->position.y, light->position.z);
-						tr.current_transform = Matrix::CreateTranslation(translation);
+						light_transform->current_transform = Matrix::CreateTranslation(translation);
 					}
-					ImGui::Checkbox("Active", &light->active);
+					Bool edited = changed;
+					edited |= ImGui::Checkbox("Active", &light->active);
 					if (light->active && changed)
 					{
 						editor_events.light_changed_event.Broadcast();
@@ -576,7 +638,7 @@ namespace adria
 					if (light->type == LightType::Directional)
 					{
 						static Int current_shadow_type = light->casts_shadows;
-						ImGui::Combo("Shadow Technique", &current_shadow_type, "None\0Shadow Map\0Ray Traced Shadows\0", 3);
+						edited |= ImGui::Combo("Shadow Technique", &current_shadow_type, "None\0Shadow Map\0Ray Traced Shadows\0", 3);
 						if (!ray_tracing_supported && current_shadow_type == 2) current_shadow_type = 1;
 
 						light->casts_shadows = (current_shadow_type == 1);
@@ -584,37 +646,46 @@ namespace adria
 					}
 					else
 					{
-						ImGui::Checkbox("Casts Shadows", &light->casts_shadows);
+						edited |= ImGui::Checkbox("Casts Shadows", &light->casts_shadows);
 					}
 
 					if (light->casts_shadows)
 					{
 						if (light->type == LightType::Directional)
 						{
-							ImGui::Checkbox("Use Cascades", &light->use_cascades);
+							edited |= ImGui::Checkbox("Use Cascades", &light->use_cascades);
 						}
 					}
 
-					ImGui::Checkbox("God Rays", &light->god_rays);
+					edited |= ImGui::Checkbox("God Rays", &light->god_rays);
 					if (light->god_rays)
 					{
-						ImGui::SliderFloat("God Rays Decay", &light->godrays_decay, 0.0f, 1.0f);
-						ImGui::SliderFloat("God Rays Weight", &light->godrays_weight, 0.0f, 1.0f);
-						ImGui::SliderFloat("God Rays Density", &light->godrays_density, 0.1f, 2.0f);
-						ImGui::SliderFloat("God Rays Exposure", &light->godrays_exposure, 0.1f, 10.0f);
+						edited |= ImGui::SliderFloat("God Rays Decay", &light->godrays_decay, 0.0f, 1.0f);
+						edited |= ImGui::SliderFloat("God Rays Weight", &light->godrays_weight, 0.0f, 1.0f);
+						edited |= ImGui::SliderFloat("God Rays Density", &light->godrays_density, 0.1f, 2.0f);
+						edited |= ImGui::SliderFloat("God Rays Exposure", &light->godrays_exposure, 0.1f, 10.0f);
 					}
 
-					ImGui::Checkbox("Volumetric Lighting", &light->volumetric);
+					edited |= ImGui::Checkbox("Volumetric Lighting", &light->volumetric);
 					if (light->volumetric)
 					{
-						ImGui::SliderFloat("Volumetric lighting Strength", &light->volumetric_strength, 0.0f, 0.1f);
+						edited |= ImGui::SliderFloat("Volumetric lighting Strength", &light->volumetric_strength, 0.0f, 0.1f);
+					}
+					edited |= ImGui::Checkbox("Lens Flare", &light->lens_flare);
+
+					if (edited)
+					{
+						history->Record(selected_entity, light_before, *light);
+						if (material_before) history->Record(selected_entity, *material_before, *light_material);
+						if (transform_before) history->Record(selected_entity, *transform_before, *light_transform);
 					}
-					ImGui::Checkbox("Lens Flare", &light->lens_flare);
 				}
 
 				Material* material = engine->reg.try_get<Material>(selected_entity);
 				if (material && ImGui::CollapsingHeader("Material"))
 				{
+					Material const material_before = *material;
+					Bool edited = false;
 					ImGui::Text("Albedo Texture");
 					if (material->albedo_texture != INVALID_TEXTURE_HANDLE)
 					{
@@ -628,6 +699,7 @@ namespace adria
 					if (ImGui::Button("Remove"))
 					{
 						material->albedo_texture = INVALID_TEXTURE_HANDLE;
+						edited = true;
 					}
 					if (ImGui::Button("Select"))
 					{
@@ -637,6 +709,7 @@ namespace adria
 						if (result == NFD_OKAY)
 						{
 							material->albedo_texture = g_TextureManager.LoadTexture(file_path);
+							edited = true;
 							free(file_path);
 						}
 					}
@@ -656,6 +729,7 @@ namespace adria
 					if (ImGui::Button("Remove"))
 					{
 						material->metallic_roughness_texture = INVALID_TEXTURE_HANDLE;
+						edited = true;
 					}
 					if (ImGui::Button("Select"))
 					{
@@ -665,6 +739,7 @@ namespace adria
 						if (result == NFD_OKAY)
 						{
 							material->metallic_roughness_texture = g_TextureManager.LoadTexture(file_path);
+							edited = true;
 							free(file_path);
 						}
 					}
@@ -683,6 +758,7 @@ namespace adria
 					if (ImGui::Button("Remove"))
 					{
 						material->emissive_texture = INVALID_TEXTURE_HANDLE;
+						edited = true;
 					}
 					if (ImGui::Button("Select"))
 					{
@@ -692,15 +768,20 @@ namespace adria
 						if (result == NFD_OKAY)
 						{
 							material->emissive_texture = g_TextureManager.LoadTexture(file_path);
+							edited = true;
 							free(file_path);
 						}
 					}
 					ImGui::PopID();
 
-					ImGui::ColorEdit3("Base Color", material->albedo_color);
-					ImGui::SliderFloat("Metallic Factor", &material->metallic_factor, 0.0f, 1.0f);
-					ImGui::SliderFloat("Roughness Factor", &material->roughness_factor, 0.0f, 1.0f);
-					ImGui::SliderFloat("Emissive Factor", &material->emissive_factor, 0.0f, 32.0f);
+					edited |= ImGui::ColorEdit3("Base Color", material->albedo_color);
+					edited |= ImGui::SliderFloat("Metallic Factor", &material->metallic_factor, 0.0f, 1.0f);
+					edited |= ImGui::SliderFloat("Roughness Factor", &material->roughness_factor, 0.0f, 1.0f);
+					edited |= ImGui::SliderFloat("Emissive Factor", &material->emissive_factor, 0.0f, 32.0f);
+					if (edited)
+					{
+						history->Record(selected_entity, material_before, *material);
+					}
 				}
 
 				Transform* transform = engine->reg.try_get<Transform>(selected_entity);
@@ -712,18 +793,25 @@ namespace adria
 					Quaternion rotation;
 					Matrix(tr.m[0]).Decompose(scale, rotation, translation);
 					Bool change = ImGui::InputFloat3("Translation", &translation.x);
-					change &= ImGui::InputFloat3("Rotation", &rotation.x);
-					change &= ImGui::InputFloat3("Scale", &scale.x);
+					change |= ImGui::InputFloat3("Rotation", &rotation.x);
+					change |= ImGui::InputFloat3("Scale", &scale.x);
 					
-					Matrix scale_matrix = Matrix::CreateScale(scale);
-					Matrix rotation_matrix = Matrix::CreateFromQuaternion(rotation);
-					Matrix translation_matrix = Matrix::CreateTranslation(translation);
-					transform->current_transform = translation_matrix * rotation_matrix * scale_matrix;
+					if (change)
+					{
+						Transform const transform_before = *transform;
+						Matrix scale_matrix = Matrix::CreateScale(scale);
+						Matrix rotation_matrix = Matrix::CreateFromQuaternion(rotation);
+						Matrix translation_matrix = Matrix::CreateTranslation(translation);
+						transform->current_transform = translation_matrix * rotation_matrix * scale_matrix;
+						history->Record(selected_entity, transform_before, *transform);
+					}
 				}
 
 				Decal* decal = engine->reg.try_get<Decal>(selected_entity);
 				if (decal && ImGui::CollapsingHeader("Decal"))
 				{
+					Decal const decal_before = *decal;
+					Bool edited = false;
 					ImGui::Text("Decal Albedo Texture");
 					GfxDescriptor tex_handle = g_TextureManager.GetSRV(decal->albedo_decal_texture);
 					GfxDescriptor dst_descriptor = gui->AllocateDescriptorsGPU();
@@ -734,6 +822,7 @@ namespace adria
 					if (ImGui::Button("Remove"))
 					{
 						decal->albedo_decal_texture = INVALID_TEXTURE_HANDLE;
+						edited = true;
 					}
 					if (ImGui::Button("Select"))
 					{
@@ -743,6 +832,7 @@ namespace adria
 						if (result == NFD_OKAY)
 						{
 							decal->albedo_decal_texture = g_TextureManager.LoadTexture(file_path);
+							edited = true;
 							free(file_path);
 						}
 					}
@@ -755,7 +845,11 @@ namespace adria
 					ImGui::Image((ImTextureID)static_cast<D3D12_GPU_DESCRIPTOR_HANDLE>(dst_descriptor).ptr, ImVec2(48.0f, 48.0f));
 
 					ImGui::PushID(5);
-					if (ImGui::Button("Remove")) decal->normal_decal_texture = INVALID_TEXTURE_HANDLE;
+					if (ImGui::Button("Remove"))
+					{
+						decal->normal_decal_texture = INVALID_TEXTURE_HANDLE;
+						edited = true;
+					}
 					if (ImGui::Button("Select"))
 					{
 						nfdchar_t* file_path = NULL;
@@ -764,17 +858,23 @@ namespace adria
 						if (result == NFD_OKAY)
 						{
 							decal->normal_decal_texture = g_TextureManager.LoadTexture(file_path);
+							edited = true;
 							free(file_path);
 						}
 					}
 					ImGui::PopID();
-					ImGui::Checkbox("Modify GBuffer Normals", &decal->modify_gbuffer_normals);
+					edited |= ImGui::Checkbox("Modify GBuffer Normals", &decal->modify_gbuffer_normals);
+					if (edited)
+					{
+						history->Record(selected_entity, decal_before, *decal);
+					}
 				}
 
 				Skybox* skybox = engine->reg.try_get<Skybox>(selected_entity);
 				if (skybox && ImGui::CollapsingHeader("Skybox"))
 				{
-					ImGui::Checkbox("Active", &skybox->active);
+					Skybox const skybox_before = *skybox;
+					Bool edited = ImGui::Checkbox("Active", &skybox->active);
 					if (ImGui::Button("Select"))
 					{
 						nfdchar_t* file_path = NULL;
@@ -783,13 +883,25 @@ namespace adria
 						if (result == NFD_OKAY)
 						{
 							skybox->cubemap_texture = g_TextureManager.LoadTexture(file_path);
+							edited = true;
 							free(file_path);
 						}
 					}
+					if (edited)
+					{
+						history->Record(selected_entity, skybox_before, *skybox);
+					}
 				}
+				history->EndGroup();
 			}
 		}
 		ImGui::End();
+
+		//a slider drag keeps its widget active, edits are merged into one history entry until it is released
+		if (!ImGui::IsAnyItemActive())
+		{
+			history->BreakMerge();
+		}
 	}
 	void Editor::Camera()
 	{
@@ -16,6 +16,7 @@ namespace adria
 	class RenderGraph;
 	class EditorSink;
 	class EditorConsole;
+	class EditorHistory;
 	struct Material;
 
 	struct EditorInitParams
@@ -73,6 +74,7 @@ namespace adria
 
 		std::unique_ptr<EditorConsole> console;
 		EditorSink* editor_sink;
+		std::unique_ptr<EditorHistory> history;
 
 		Bool scene_focused = false;
 		entt::entity selected_entity;
@@ -94,6 +96,8 @@ namespace adria
 		~Editor();
 
 		void HandleInput();
+		void Undo();
+		void Redo();
 		void MenuBar();
 		void AddEntities();
 		void ListEntities();
@@ -32,12 +32,6 @@ namespace adria
 		CommandDescriptions.push_back("Shows the previous commands used");
 		Commands.push_back("clear");
 		CommandDescriptions.push_back("Clear the history");
-		g_ConsoleManager.ForAllObjects(ConsoleObjectDelegate::CreateLambda([&](IConsoleObject* const cobj)
-			{
-				Commands.push_back(cobj->GetName());
-				CommandDescriptions.push_back(cobj->GetHelp());
-			}
-		));
 		AutoScroll = true;
 		ScrollToBottom = false;
 	}
@@ -228,6 +222,12 @@ namespace adria
 		{
 			AddLog("Commands:");
 			for (Int i = 0; i < Commands.Size; i++) AddLog("- %s : %s", Commands[i], CommandDescriptions[i]);
+			std::vector<std::string> names;
+			g_ConsoleManager.FindConsoleObjectNames("", names);
+			for (std::string const& name : names)
+			{
+				if (IConsoleObject* cobj = g_ConsoleManager.FindConsoleObject(name)) AddLog("- %s : %s", name.c_str(), cobj->GetHelp());
+			}
 		}
 		else if (Stricmp(cmd, "history") == 0)
 		{
@@ -258,29 +258,74 @@ namespace adria
 				word_start--;
 			}
 
-			ImVector<Char const*> candidates;
-			for (Int i = 0; i < Commands.Size; i++)
-				if (Strnicmp(Commands[i], word_start, (int)(word_end - word_start)) == 0)
-					candidates.push_back(Commands[i]);
+			//the word after a variable name completes against the variable's enum names, if it has any
+			IConsoleVariable* value_cvar = nullptr;
+			Char const* name_end = word_start;
+			while (name_end > data->Buf && (name_end[-1] == ' ' || name_end[-1] == '\t')) name_end--;
+			if (name_end != word_start)
+			{
+				Char const* name_start = name_end;
+				while (name_start > data->Buf && name_start[-1] != ' ' && name_start[-1] != '\t' && name_start[-1] != ';') name_start--;
+				value_cvar = g_ConsoleManager.FindConsoleVariable(std::string(name_start, name_end));
+			}
+
+			std::string_view const word(word_start, word_end - word_start);
+			std::vector<std::string> candidates;
+			if (value_cvar)
+			{
+				std::vector<std::string> const& enum_names = value_cvar->GetMetadata().enum_names;
+				if (enum_names.empty())
+				{
+					AddLog("%s %s : %s\n", value_cvar->GetName(), value_cvar->GetString().c_str(), value_cvar->GetValueHint().c_str());
+					break;
+				}
+				for (std::string const& enum_name : enum_names)
+					if (Strnicmp(enum_name.c_str(), word_start, (int)word.size()) == 0)
+						candidates.push_back(enum_name);
+			}
+			else
+			{
+				if (word.empty()) break;
+				for (Int i = 0; i < Commands.Size; i++)
+					if (Strnicmp(Commands[i], word_start, (int)word.size()) == 0)
+						candidates.push_back(Commands[i]);
+				std::vector<std::string> names;
+				g_ConsoleManager.FindConsoleObjectNames(word, names);
+				candidates.insert(candidates.end(), names.begin(), names.end());
+			}
 
-			if (candidates.Size == 0)
+			if (candidates.empty())
 			{
-				AddLog("No match for \"%.*s\"!\n", (int)(word_end - word_start), word_start);
+				std::vector<ConsoleNameMatch> matches;
+				if (!value_cvar) g_ConsoleManager.SearchConsoleObjects(word, matches, 8);
+				if (matches.empty())
+				{
+					AddLog("No match for \"%.*s\"!\n", (int)word.size(), word_start);
+				}
+				else
+				{
+					AddLog("No prefix match for \"%.*s\", did you mean:\n", (int)word.size(), word_start);
+					for (ConsoleNameMatch const& match : matches) AddLog("- %s\n", match.name.c_str());
+				}
 			}
-			else if (candidates.Size == 1)
+			else if (candidates.size() == 1)
 			{
-				data->DeleteChars((int)(word_start - data->Buf), (int)(word_end - word_start));
-				data->InsertChars(data->CursorPos, candidates[0]);
+				data->DeleteChars((int)(word_start - data->Buf), (int)word.size());
+				data->InsertChars(data->CursorPos, candidates[0].c_str());
 				data->InsertChars(data->CursorPos, " ");
+				if (IConsoleVariable* cvar = value_cvar ? nullptr : g_ConsoleManager.FindConsoleVariable(candidates[0]))
+				{
+					AddLog("%s %s : %s\n", cvar->GetName(), cvar->GetString().c_str(), cvar->GetValueHint().c_str());
+				}
 			}
-			else if (candidates.Size != Commands.Size)
+			else
 			{
-				Int match_len = (int)(word_end - word_start);
+				Uint64 match_len = word.size();
 				for (;;)
 				{
 					Int c = 0;
 					Bool all_candidates_matches = true;
-					for (Int i = 0; i < candidates.Size && all_candidates_matches; i++)
+					for (Uint64 i = 0; i < candidates.size() && all_candidates_matches; i++)
 						if (i == 0)
 							c = toupper(candidates[i][match_len]);
 						else if (c == 0 || c != toupper(candidates[i][match_len]))
@@ -292,14 +337,18 @@ namespace adria
 
 				if (match_len > 0)
 				{
-					data->DeleteChars((int)(word_start - data->Buf), (int)(word_end - word_start));
-					data->InsertChars(data->CursorPos, candidates[0], candidates[0] + match_len);
+					data->DeleteChars((int)(word_start - data->Buf), (int)word.size());
+					data->InsertChars(data->CursorPos, candidates[0].c_str(), candidates[0].c_str() + match_len);
 				}
 
 				// List matches
 				AddLog("Possible matches:\n");
-				for (Int i = 0; i < candidates.Size; i++)
-					AddLog("- %s\n", candidates[i]);
+				for (std::string const& candidate : candidates)
+				{
+					IConsoleVariable* cvar = value_cvar ? nullptr : g_ConsoleManager.FindConsoleVariable(candidate);
+					if (cvar) AddLog("- %s %s\n", candidate.c_str(), cvar->GetValueHint().c_str());
+					else AddLog("- %s\n", candidate.c_str());
+				}
 			}
 
 			break;
@@ -0,0 +1,180 @@
+#include "EditorHistory.h"
+
+namespace adria
+{
+	std::unique_ptr<IEditorCommand> EditorCommandGroup::Release()
+	{
+		ADRIA_ASSERT(commands.size() == 1);
+		std::unique_ptr<IEditorCommand> command = std::move(commands.front());
+		commands.clear();
+		return command;
+	}
+
+	void EditorCommandGroup::Undo(entt::registry& reg)
+	{
+		for (auto it = commands.rbegin(); it != commands.rend(); ++it)
+		{
+			(*it)->Undo(reg);
+		}
+	}
+
+	void EditorCommandGroup::Redo(entt::registry& reg)
+	{
+		for (std::unique_ptr<IEditorCommand>& command : commands)
+		{
+			command->Redo(reg);
+		}
+	}
+
+	Bool EditorCommandGroup::CanMerge(IEditorCommand const& next) const
+	{
+		EditorCommandGroup const* next_group = dynamic_cast<EditorCommandGroup const*>(&next);
+		if (!next_group || next_group->commands.size() != commands.size())
+		{
+			return false;
+		}
+		for (Uint64 i = 0; i < commands.size(); ++i)
+		{
+			if (!commands[i]->CanMerge(*next_group->commands[i])) return false;
+		}
+		return true;
+	}
+
+	void EditorCommandGroup::Merge(IEditorCommand&& next)
+	{
+		EditorCommandGroup& next_group = static_cast<EditorCommandGroup&>(next);
+		for (Uint64 i = 0; i < commands.size(); ++i)
+		{
+			commands[i]->Merge(std::move(*next_group.commands[i]));
+		}
+	}
+
+	Uint64 EditorCommandGroup::GetSize() const
+	{
+		Uint64 size = sizeof(*this) + commands.capacity() * sizeof(std::unique_ptr<IEditorCommand>);
+		for (std::unique_ptr<IEditorCommand> const& command : commands)
+		{
+			size += command->GetSize();
+		}
+		return size;
+	}
+
+	EditorHistory::EditorHistory(Uint64 byte_budget) : byte_budget(byte_budget) {}
+	EditorHistory::~EditorHistory() = default;
+
+	void EditorHistory::Push(std::unique_ptr<IEditorCommand>&& command)
+	{
+		ADRIA_ASSERT(command != nullptr);
+		if (pending_group)
+		{
+			pending_group->Add(std::move(command));
+			return;
+		}
+		Commit(std::move(command));
+	}
+
+	void EditorHistory::BeginGroup()
+	{
+		ADRIA_ASSERT_MSG(!pending_group, "Editor history groups cannot be nested");
+		pending_group = std::make_unique<EditorCommandGroup>();
+	}
+
+	void EditorHistory::EndGroup()
+	{
+		ADRIA_ASSERT(pending_group != nullptr);
+		std::unique_ptr<EditorCommandGroup> group = std::move(pending_group);
+		if (group->Empty())
+		{
+			return;
+		}
+		if (group->Count() == 1)
+		{
+			Commit(group->Release());
+		}
+		else
+		{
+			Commit(std::move(group));
+		}
+	}
+
+	Bool EditorHistory::Undo(entt::registry& reg)
+	{
+		merge_allowed = false;
+		if (undo_stack.empty())
+		{
+			return false;
+		}
+		std::unique_ptr<IEditorCommand> command = std::move(undo_stack.back());
+		undo_stack.pop_back();
+		command->Undo(reg);
+		redo_stack.push_back(std::move(command));
+		return true;
+	}
+
+	Bool EditorHistory::Redo(entt::registry& reg)
+	{
+		merge_allowed = false;
+		if (redo_stack.empty())
+		{
+			return false;
+		}
+		std::unique_ptr<IEditorCommand> command = std::move(redo_stack.back());
+		redo_stack.pop_back();
+		command->Redo(reg);
+		undo_stack.push_back(std::move(command));
+		return true;
+	}
+
+	void EditorHistory::Clear()
+	{
+		undo_stack.clear();
+		redo_stack.clear();
+		pending_group.reset();
+		used_bytes = 0;
+		merge_allowed = false;
+	}
+
+	void EditorHistory::SetByteBudget(Uint64 budget)
+	{
+		byte_budget = budget;
+		EnforceBudget();
+	}
+
+	void EditorHistory::Commit(std::unique_ptr<IEditorCommand>&& command)
+	{
+		ClearRedo();
+		if (merge_allowed && !undo_stack.empty() && undo_stack.back()->CanMerge(*command))
+		{
+			IEditorCommand& top = *undo_stack.back();
+			used_bytes -= top.GetSize();
+			top.Merge(std::move(*command));
+			used_bytes += top.GetSize();
+		}
+		else
+		{
+			used_bytes += command->GetSize();
+			undo_stack.push_back(std::move(command));
+		}
+		merge_allowed = true;
+		EnforceBudget();
+	}
+
+	void EditorHistory::ClearRedo()
+	{
+		for (std::unique_ptr<IEditorCommand> const& command : redo_stack)
+		{
+			used_bytes -= command->GetSize();
+		}
+		redo_stack.clear();
+	}
+
+	void EditorHistory::EnforceBudget()
+	{
+		//the latest command is always kept, even if it alone exceeds the budget
+		while (used_bytes > byte_budget && undo_stack.size() > 1)
+		{
+			used_bytes -= undo_stack.front()->GetSize();
+			undo_stack.pop_front();
+		}
+	}
+}
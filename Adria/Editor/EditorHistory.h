@@ -0,0 +1,140 @@
+#pragma once
+#include "entt/entity/registry.hpp"
+
+namespace adria
+{
+	class IEditorCommand
+	{
+	public:
+		virtual ~IEditorCommand() = default;
+
+		virtual void Undo(entt::registry& reg) = 0;
+		virtual void Redo(entt::registry& reg) = 0;
+
+		//merging folds a later command into this one, e.g. every frame of a slider drag
+		virtual Bool CanMerge(IEditorCommand const& next) const { return false; }
+		virtual void Merge(IEditorCommand&& next) {}
+
+		virtual Uint64 GetSize() const = 0;
+	};
+
+	//heap memory owned by a component snapshot, counted against the history budget.
+	//specialize for components that hold strings or containers
+	template<typename T>
+	struct EditorSnapshotHeapSize
+	{
+		static Uint64 Get(T const&) { return 0; }
+	};
+
+	//before and after snapshot of one component, entities that were destroyed since the edit are skipped
+	template<typename T>
+	class ComponentEditCommand final : public IEditorCommand
+	{
+	public:
+		ComponentEditCommand(entt::entity entity, T const& before, T const& after)
+			: entity(entity), before(before), after(after) {}
+
+		virtual void Undo(entt::registry& reg) override { Apply(reg, before); }
+		virtual void Redo(entt::registry& reg) override { Apply(reg, after); }
+
+		virtual Bool CanMerge(IEditorCommand const& next) const override
+		{
+			ComponentEditCommand const* next_edit = dynamic_cast<ComponentEditCommand const*>(&next);
+			return next_edit && next_edit->entity == entity;
+		}
+		virtual void Merge(IEditorCommand&& next) override
+		{
+			after = static_cast<ComponentEditCommand&&>(next).after;
+		}
+
+		virtual Uint64 GetSize() const override
+		{
+			return sizeof(*this) + EditorSnapshotHeapSize<T>::Get(before) + EditorSnapshotHeapSize<T>::Get(after);
+		}
+
+	private:
+		entt::entity entity;
+		T before;
+		T after;
+
+	private:
+		void Apply(entt::registry& reg, T const& snapshot)
+		{
+			if (reg.valid(entity) && reg.all_of<T>(entity))
+			{
+				reg.replace<T>(entity, snapshot);
+			}
+		}
+	};
+
+	//commands recorded together, e.g. a light edit that also moves the light's transform
+	class EditorCommandGroup final : public IEditorCommand
+	{
+	public:
+		EditorCommandGroup() = default;
+
+		void Add(std::unique_ptr<IEditorCommand>&& command) { commands.push_back(std::move(command)); }
+		Bool Empty() const { return commands.empty(); }
+		Uint64 Count() const { return commands.size(); }
+		//hands out the only command of a single command group
+		std::unique_ptr<IEditorCommand> Release();
+
+		virtual void Undo(entt::registry& reg) override;
+		virtual void Redo(entt::registry& reg) override;
+		virtual Bool CanMerge(IEditorCommand const& next) const override;
+		virtual void Merge(IEditorCommand&& next) override;
+		virtual Uint64 GetSize() const override;
+
+	private:
+		std::vector<std::unique_ptr<IEditorCommand>> commands;
+	};
+
+	//undo/redo stack of editor commands, the oldest commands are dropped once the byte budget is exceeded.
+	//consecutive mergeable commands are folded together until BreakMerge is called
+	class EditorHistory
+	{
+	public:
+		static constexpr Uint64 DEFAULT_BYTE_BUDGET = 8 * 1024 * 1024;
+
+		explicit EditorHistory(Uint64 byte_budget = DEFAULT_BYTE_BUDGET);
+		ADRIA_NONCOPYABLE_NONMOVABLE(EditorHistory)
+		~EditorHistory();
+
+		void Push(std::unique_ptr<IEditorCommand>&& command);
+		template<typename T>
+		void Record(entt::entity entity, T const& before, T const& after)
+		{
+			Push(std::make_unique<ComponentEditCommand<T>>(entity, before, after));
+		}
+
+		//commands pushed between BeginGroup and EndGroup are undone and redone as one
+		void BeginGroup();
+		void EndGroup();
+		void BreakMerge() { merge_allowed = false; }
+
+		Bool Undo(entt::registry& reg);
+		Bool Redo(entt::registry& reg);
+		void Clear();
+
+		Bool CanUndo() const { return !undo_stack.empty(); }
+		Bool CanRedo() const { return !redo_stack.empty(); }
+		Uint64 GetUndoCount() const { return undo_stack.size(); }
+		Uint64 GetRedoCount() const { return redo_stack.size(); }
+		Uint64 GetUsedBytes() const { return used_bytes; }
+		Uint64 GetByteBudget() const { return byte_budget; }
+		void SetByteBudget(Uint64 budget);
+
+	private:
+		Uint64 byte_budget;
+		Uint64 used_bytes = 0;
+		std::deque<std::unique_ptr<IEditorCommand>> undo_stack;
+		std::vector<std::unique_ptr<IEditorCommand>> redo_stack;
+		std::unique_ptr<EditorCommandGroup> pending_group;
+		Bool merge_allowed = false;
+
+	private:
+		void Commit(std::unique_ptr<IEditorCommand>&& command);
+		void ClearRedo();
+		void EnforceBudget();
+	};
+}
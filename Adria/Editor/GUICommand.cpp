@@ -1,5 +1,6 @@
 #include "GUICommand.h"
 #include "Editor.h"
+#include "Core/IConsoleManager.h"
 
 namespace adria
 {
@@ -13,5 +14,55 @@ namespace adria
 		g_Editor.AddDebugTexture(GUITexture{ .name = name, .gfx_texture = gfx_texture });
 	}
 
+	Bool GUI_Checkbox(Char const* label, IConsoleVariable& cvar)
+	{
+		Bool value = cvar.GetBool();
+		if (!ImGui::Checkbox(label, &value)) return false;
+		cvar.Set(value);
+		return true;
+	}
+
+	Bool GUI_SliderFloat(Char const* label, IConsoleVariable& cvar, Float min, Float max, Char const* format)
+	{
+		Float value = cvar.GetFloat();
+		if (!ImGui::SliderFloat(label, &value, min, max, format)) return false;
+		cvar.Set(value);
+		return true;
+	}
+
+	Bool GUI_SliderInt(Char const* label, IConsoleVariable& cvar, Int min, Int max)
+	{
+		Int value = cvar.GetInt();
+		if (!ImGui::SliderInt(label, &value, min, max)) return false;
+		cvar.Set(value);
+		return true;
+	}
+
+	Bool GUI_Combo(Char const* label, IConsoleVariable& cvar, Char const* items_separated_by_zeros, Int popup_max_height_in_items)
+	{
+		Int value = cvar.GetInt();
+		if (!ImGui::Combo(label, &value, items_separated_by_zeros, popup_max_height_in_items)) return false;
+		cvar.Set(value);
+		return true;
+	}
+
+	Bool GUI_ListBox(Char const* label, IConsoleVariable& cvar, Char const* const items[], Int items_count)
+	{
+		Int value = cvar.GetInt();
+		if (!ImGui::ListBox(label, &value, items, items_count)) return false;
+		cvar.Set(value);
+		return true;
+	}
+
+	Bool GUI_DragFloatRange2(Char const* label, IConsoleVariable& min_cvar, IConsoleVariable& max_cvar, Float speed, Float min, Float max)
+	{
+		Float min_value = min_cvar.GetFloat();
+		Float max_value = max_cvar.GetFloat();
+		if (!ImGui::DragFloatRange2(label, &min_value, &max_value, speed, min, max)) return false;
+		min_cvar.Set(min_value);
+		max_cvar.Set(max_value);
+		return true;
+	}
+
 }
 
@@ -52,4 +52,15 @@ namespace adria
 		GfxTexture* gfx_texture;
 	};
 	void GUI_DebugTexture(Char const* name, GfxTexture* gfx_texture);
+
+	//console variable widgets edit a copy of the value and write it back with Set, so the edit goes through the
+	//same clamping and per frame write queue as the console. they return true if the value was edited this frame,
+	//the variable itself only changes at the next frame sync point
+	class IConsoleVariable;
+	Bool GUI_Checkbox(Char const* label, IConsoleVariable& cvar);
+	Bool GUI_SliderFloat(Char const* label, IConsoleVariable& cvar, Float min, Float max, Char const* format = "%.3f");
+	Bool GUI_SliderInt(Char const* label, IConsoleVariable& cvar, Int min, Int max);
+	Bool GUI_Combo(Char const* label, IConsoleVariable& cvar, Char const* items_separated_by_zeros, Int popup_max_height_in_items = -1);
+	Bool GUI_ListBox(Char const* label, IConsoleVariable& cvar, Char const* const items[], Int items_count);
+	Bool GUI_DragFloatRange2(Char const* label, IConsoleVariable& min_cvar, IConsoleVariable& max_cvar, Float speed, Float min, Float max);
 }
\ No newline at end of file
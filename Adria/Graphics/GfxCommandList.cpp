@@ -364,7 +364,9 @@ namespace adria
 	{
 		if (use_legacy_barriers)
 		{
-			if (flags_before == GfxResourceState::ComputeUAV && flags_after == GfxResourceState::ComputeUAV)
+			Bool const uav_barrier = flags_before == GfxResourceState::ComputeUAV && flags_after == GfxResourceState::ComputeUAV;
+			Bool const as_barrier  = HasAnyFlag(flags_before, GfxResourceState::AllAS) && HasAnyFlag(flags_after, GfxResourceState::AllAS);
+			if (uav_barrier || as_barrier)
 			{
 				D3D12_RESOURCE_BARRIER barrier{};
 				barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
@@ -406,7 +408,9 @@ namespace adria
 	{
 		if (use_legacy_barriers)
 		{
-			if (flags_before == GfxResourceState::ComputeUAV && flags_after == GfxResourceState::ComputeUAV)
+			Bool const uav_barrier = flags_before == GfxResourceState::ComputeUAV && flags_after == GfxResourceState::ComputeUAV;
+			Bool const as_barrier  = HasAnyFlag(flags_before, GfxResourceState::AllAS) && HasAnyFlag(flags_after, GfxResourceState::AllAS);
+			if (uav_barrier || as_barrier)
 			{
 				D3D12_RESOURCE_BARRIER barrier{};
 				barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
@@ -443,7 +447,9 @@ namespace adria
 	{
 		if (use_legacy_barriers)
 		{
-			if (flags_before == GfxResourceState::ComputeUAV && flags_after == GfxResourceState::ComputeUAV)
+			Bool const uav_barrier = flags_before == GfxResourceState::ComputeUAV && flags_after == GfxResourceState::ComputeUAV;
+			Bool const as_barrier  = HasAnyFlag(flags_before, GfxResourceState::AllAS) && HasAnyFlag(flags_after, GfxResourceState::AllAS);
+			if (uav_barrier || as_barrier)
 			{
 				D3D12_RESOURCE_BARRIER barrier{};
 				barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
@@ -1,5 +1,6 @@
 #pragma once
 #include "GfxDescriptorAllocatorBase.h"
+#include "Utilities/TLSFOffsetAllocator.h"
 
 namespace adria
 {
@@ -12,21 +13,14 @@ namespace adria
 
 	class GfxDescriptorAllocator : public GfxDescriptorAllocatorBase
 	{
-		struct GfxDescriptorRange
-		{
-			GfxDescriptor begin;
-			GfxDescriptor end;
-		};
-
 	public:
 		GfxDescriptorAllocator(GfxDevice* gfx_device, GfxDescriptorAllocatorDesc const& desc);
 		~GfxDescriptorAllocator();
 
-		ADRIA_NODISCARD GfxDescriptor AllocateDescriptor();
+		ADRIA_NODISCARD GfxDescriptor AllocateDescriptor(Uint32 count = 1);
 		void FreeDescriptor(GfxDescriptor handle);
 
 	private:
-		GfxDescriptor tail_descriptor;
-		std::list<GfxDescriptorRange> free_descriptor_ranges;
+		TLSFOffsetAllocator index_allocator;
 	};
-}
\ No newline at end of file
+}
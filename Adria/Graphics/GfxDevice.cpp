@@ -651,6 +651,10 @@ namespace adria
 	{
 		return std::make_unique<GfxRayTracingBLAS>(this, geometries, flags);
 	}
+	std::unique_ptr<GfxRayTracingBLAS> GfxDevice::CreateRayTracingBLAS(GfxRayTracingBLAS const& source, Uint64 compacted_size)
+	{
+		return std::make_unique<GfxRayTracingBLAS>(this, source, compacted_size);
+	}
 
 	GfxDescriptor GfxDevice::CreateBufferView(GfxBuffer const* buffer, GfxSubresourceType view_type, GfxBufferDescriptorDesc const& view_desc, GfxBuffer const* uav_counter)
 	{
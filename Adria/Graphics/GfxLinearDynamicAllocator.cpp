@@ -1,106 +1,192 @@
 #include "GfxLinearDynamicAllocator.h"
-#include "GfxBuffer.h"
-#include "GfxDevice.h"
 
 namespace adria
 {
-	GfxLinearDynamicAllocator::GfxLinearDynamicAllocator(GfxDevice* gfx, Uint64 page_size, Uint64 page_count)
-		: gfx(gfx), page_size(page_size), current_page(0), used_page_count_history{}
+	namespace
 	{
-		alloc_pages.reserve(page_count);
-		while (alloc_pages.size() < page_count) alloc_pages.emplace_back(gfx, page_size);
+		class CpuMemoryPage final : public IGfxLinearAllocatorPage
+		{
+		public:
+			explicit CpuMemoryPage(Uint64 page_size) : memory(std::make_unique<Uint8[]>(page_size)), size(page_size) {}
+
+			virtual GfxBuffer* GetBuffer() const override { return nullptr; }
+			virtual Uint8* GetCpuAddress() const override { return memory.get(); }
+			virtual Uint64 GetGpuAddress() const override { return reinterpret_cast<Uint64>(memory.get()); }
+			virtual Uint64 GetSize() const override { return size; }
+
+		private:
+			std::unique_ptr<Uint8[]> memory;
+			Uint64 size;
+		};
+
+		std::atomic<Uint64> next_allocator_id = 1;
+	}
+
+	std::unique_ptr<IGfxLinearAllocatorPage> CreateCpuMemoryPage(Uint64 page_size)
+	{
+		return std::make_unique<CpuMemoryPage>(page_size);
+	}
+
+	GfxLinearDynamicAllocator::GfxLinearDynamicAllocator(GfxLinearAllocatorPageFactory page_factory, Uint64 page_size, Uint64 page_count)
+		: page_factory(std::move(page_factory)), page_size(page_size), chunk_size(std::min(page_size, MAX_CHUNK_SIZE)),
+		  min_page_count(std::max<Uint64>(page_count, 1)), allocator_id(next_allocator_id.fetch_add(1)), used_page_count_history{}
+	{
+		alloc_pages.reserve(min_page_count);
+		while (alloc_pages.size() < min_page_count) alloc_pages.push_back(std::make_unique<GfxAllocationPage>(this->page_factory(page_size)));
+		current_page.store(alloc_pages.front().get());
 	}
 	GfxLinearDynamicAllocator::~GfxLinearDynamicAllocator() = default;
 
 	GfxDynamicAllocation GfxLinearDynamicAllocator::Allocate(Uint64 size_in_bytes, Uint64 alignment)
 	{
-		alignment = std::max(alignment, 1ull);
+		alignment = std::max<Uint64>(alignment, 1);
+		Uint64 const padded_size = size_in_bytes + alignment - 1;
 
-		GfxAllocationPage* last_page = &alloc_pages[current_page]; // Use pointer to allow changing page
-		Uint64 current_page_offset = last_page->linear_offset_allocator.Top(); 
+		//large allocations claim their own range instead of going through the thread's chunk
+		if (padded_size > chunk_size)
+		{
+			GfxAllocationPage* page = nullptr;
+			Uint64 offset = 0;
+			if (!ClaimRange(padded_size, page, offset))
+			{
+				page = AllocateOversizedPage(padded_size);
+				offset = 0;
+			}
+			Uint64 const base_gpu_address = page->backing->GetGpuAddress();
+			Uint64 const aligned_offset = AlignUp(base_gpu_address + offset, alignment) - base_gpu_address;
+			return MakeAllocation(page, aligned_offset, size_in_bytes);
+		}
+
+		ThreadCache& cache = GetThreadCache();
+		for (Uint32 attempt = 0; attempt < 2; ++attempt)
+		{
+			if (cache.page)
+			{
+				Uint64 const base_gpu_address = cache.page->backing->GetGpuAddress();
+				Uint64 const aligned_offset = AlignUp(base_gpu_address + cache.offset, alignment) - base_gpu_address;
+				if (aligned_offset + size_in_bytes <= cache.end)
+				{
+					cache.offset = aligned_offset + size_in_bytes;
+					return MakeAllocation(cache.page, aligned_offset, size_in_bytes);
+				}
+			}
 
-		Uint64 base_gpu_address = last_page->buffer->GetGpuAddress();
-		Uint64 current_gpu_address = base_gpu_address + current_page_offset;
-		Uint64 aligned_gpu_address = AlignUp(current_gpu_address, alignment);
-		Uint64 padding = aligned_gpu_address - current_gpu_address;
-		Uint64 total_allocation_size = padding + size_in_bytes;
+			Uint64 chunk_offset = 0;
+			Bool const claimed = ClaimRange(chunk_size, cache.page, chunk_offset);
+			ADRIA_ASSERT(claimed);
+			cache.offset = chunk_offset;
+			cache.end = chunk_offset + chunk_size;
+		}
+		ADRIA_UNREACHABLE();
+		return GfxDynamicAllocation{};
+	}
+
+	void GfxLinearDynamicAllocator::Clear()
+	{
+		std::lock_guard<std::mutex> guard(alloc_mutex);
 
-		Uint64 allocated_page_offset = INVALID_ALLOC_OFFSET;
+		Uint64 const used_page_count = current_page_index + (alloc_pages[current_page_index]->top.load() > 0 ? 1 : 0);
+		used_page_count_history[history_index++ % PAGE_COUNT_HISTORY_SIZE] = used_page_count;
+
+		Uint64 max_used_page_count = min_page_count;
+		for (Uint32 i = 0; i < PAGE_COUNT_HISTORY_SIZE; ++i)
+		{
+			max_used_page_count = std::max(max_used_page_count, used_page_count_history[i]);
+		}
+		if (alloc_pages.size() > max_used_page_count)
 		{
-			std::lock_guard<std::mutex> guard(alloc_mutex);
-			allocated_page_offset = last_page->linear_offset_allocator.Allocate(total_allocation_size, 1);
+			alloc_pages.resize(max_used_page_count);
 		}
 
-		if (allocated_page_offset != INVALID_ALLOC_OFFSET)
+		for (std::unique_ptr<GfxAllocationPage>& page : alloc_pages)
 		{
-			Uint64 final_data_offset = allocated_page_offset + padding;
-
-			GfxDynamicAllocation allocation{};
-			allocation.buffer = last_page->buffer.get();
-			allocation.cpu_address = reinterpret_cast<Uint8*>(last_page->cpu_address) + final_data_offset;
-			allocation.gpu_address = base_gpu_address + final_data_offset;
-			allocation.offset = final_data_offset; 
-			allocation.size = size_in_bytes; 
-
-			ADRIA_ASSERT_MSG(allocation.gpu_address % alignment == 0, "Dynamic allocation final GPU address is misaligned!");
-			ADRIA_ASSERT_MSG(final_data_offset + size_in_bytes <= last_page->linear_offset_allocator.MaxSize(), "Dynamic allocation exceeds page bounds!");
-			return allocation;
+			page->top.store(0);
 		}
-		else 
+		oversized_pages.clear();
+		current_page_index = 0;
+		current_page.store(alloc_pages.front().get());
+		generation.fetch_add(1);
+	}
+
+	Uint64 GfxLinearDynamicAllocator::GetPageCount() const
+	{
+		std::lock_guard<std::mutex> guard(alloc_mutex);
+		return alloc_pages.size();
+	}
+
+	GfxLinearDynamicAllocator::ThreadCache& GfxLinearDynamicAllocator::GetThreadCache()
+	{
+		//a thread can record with several allocators (one per backbuffer), evicting a slot only wastes the rest of its chunk
+		static constexpr Uint32 THREAD_CACHE_SLOTS = 8;
+		thread_local std::array<ThreadCache, THREAD_CACHE_SLOTS> thread_caches{};
+		thread_local Uint32 next_slot = 0;
+
+		Uint64 const current_generation = generation.load(std::memory_order_relaxed);
+		for (ThreadCache& cache : thread_caches)
 		{
-			++current_page;
-			if (current_page >= alloc_pages.size())
+			if (cache.allocator_id != allocator_id) continue;
+			if (cache.generation != current_generation)
 			{
-				Uint64 required_page_size = AlignUp(size_in_bytes, alignment);
-				Uint64 new_page_size = std::max(page_size, std::max(size_in_bytes, required_page_size)); 
-				alloc_pages.emplace_back(gfx, new_page_size);
+				cache = ThreadCache{ .allocator_id = allocator_id, .generation = current_generation };
 			}
-			return Allocate(size_in_bytes, alignment); 
+			return cache;
 		}
+
+		ThreadCache& cache = thread_caches[next_slot++ % THREAD_CACHE_SLOTS];
+		cache = ThreadCache{ .allocator_id = allocator_id, .generation = current_generation };
+		return cache;
 	}
-	void GfxLinearDynamicAllocator::Clear()
+
+	Bool GfxLinearDynamicAllocator::ClaimRange(Uint64 size, GfxAllocationPage*& page, Uint64& offset)
 	{
+		if (size > page_size) return false;
+		while (true)
 		{
-			std::lock_guard<std::mutex> guard(alloc_mutex);
-			for (GfxAllocationPage& page : alloc_pages)
+			GfxAllocationPage* claim_page = current_page.load(std::memory_order_acquire);
+			Uint64 const claim_offset = claim_page->top.fetch_add(size, std::memory_order_relaxed);
+			if (claim_offset + size <= claim_page->backing->GetSize())
 			{
-				page.linear_offset_allocator.Clear();
+				page = claim_page;
+				offset = claim_offset;
+				return true;
 			}
+			AdvancePage(claim_page);
 		}
-		
-		Uint32 i = gfx->GetFrameIndex() % PAGE_COUNT_HISTORY_SIZE;
-		used_page_count_history[i] = current_page;
+	}
 
-		Uint64 max_used_page_count = 0;
-		for (Uint32 j = 0; j < PAGE_COUNT_HISTORY_SIZE; ++j)
-		{
-			max_used_page_count = std::max(max_used_page_count, used_page_count_history[j]);
-		}
+	void GfxLinearDynamicAllocator::AdvancePage(GfxAllocationPage* exhausted_page)
+	{
+		std::lock_guard<std::mutex> guard(alloc_mutex);
+		if (current_page.load(std::memory_order_relaxed) != exhausted_page) return;
 
-		if (max_used_page_count < alloc_pages.size())
+		++current_page_index;
+		if (current_page_index >= alloc_pages.size())
 		{
-			while (alloc_pages.size() == max_used_page_count)
-			{
-				alloc_pages.pop_back();
-			}
+			alloc_pages.push_back(std::make_unique<GfxAllocationPage>(page_factory(page_size)));
 		}
-		current_page = 0;
+		current_page.store(alloc_pages[current_page_index].get(), std::memory_order_release);
 	}
 
-	GfxLinearDynamicAllocator::GfxAllocationPage::GfxAllocationPage(GfxDevice* gfx, Uint64 page_size) : linear_offset_allocator(page_size)
+	GfxLinearDynamicAllocator::GfxAllocationPage* GfxLinearDynamicAllocator::AllocateOversizedPage(Uint64 size)
 	{
-		GfxBufferDesc desc{};
-		desc.size = page_size;
-		desc.resource_usage = GfxResourceUsage::Upload;
-		desc.bind_flags = GfxBindFlag::ShaderResource;
-
-		buffer = gfx->CreateBuffer(desc);
-		ADRIA_ASSERT(buffer->IsMapped());
-		cpu_address = buffer->GetMappedData();
-		buffer->SetName("LinearDynamicAllocatorPage");
+		std::unique_ptr<GfxAllocationPage> page = std::make_unique<GfxAllocationPage>(page_factory(size));
+		page->top.store(size);
+
+		std::lock_guard<std::mutex> guard(alloc_mutex);
+		return oversized_pages.emplace_back(std::move(page)).get();
 	}
-	GfxLinearDynamicAllocator::GfxAllocationPage::GfxAllocationPage(GfxAllocationPage&&) = default;
 
-	GfxLinearDynamicAllocator::GfxAllocationPage::~GfxAllocationPage() = default;
+	GfxDynamicAllocation GfxLinearDynamicAllocator::MakeAllocation(GfxAllocationPage* page, Uint64 offset, Uint64 size) const
+	{
+		IGfxLinearAllocatorPage const& backing = *page->backing;
 
-}
\ No newline at end of file
+		GfxDynamicAllocation allocation{};
+		allocation.buffer = backing.GetBuffer();
+		allocation.cpu_address = backing.GetCpuAddress() + offset;
+		allocation.gpu_address = backing.GetGpuAddress() + offset;
+		allocation.offset = offset;
+		allocation.size = size;
+		ADRIA_ASSERT_MSG(offset + size <= backing.GetSize(), "Dynamic allocation exceeds page bounds!");
+		return allocation;
+	}
+}
@@ -1,31 +1,57 @@
 #pragma once
 #include "GfxDynamicAllocation.h"
-#include "Utilities/LinearOffsetAllocator.h"
 
 namespace adria
 {
 	class GfxBuffer;
 	class GfxDevice;
 
-	class GfxAllocationPage;
-	
+	//memory backing one page of the linear allocator, lets tests run the allocator on plain cpu memory
+	class IGfxLinearAllocatorPage
+	{
+	public:
+		virtual ~IGfxLinearAllocatorPage() = default;
+		virtual GfxBuffer* GetBuffer() const = 0;
+		virtual Uint8* GetCpuAddress() const = 0;
+		virtual Uint64 GetGpuAddress() const = 0;
+		virtual Uint64 GetSize() const = 0;
+	};
+	using GfxLinearAllocatorPageFactory = std::function<std::unique_ptr<IGfxLinearAllocatorPage>(Uint64)>;
+
+	std::unique_ptr<IGfxLinearAllocatorPage> CreateGfxUploadPage(GfxDevice* gfx, Uint64 page_size);
+	std::unique_ptr<IGfxLinearAllocatorPage> CreateCpuMemoryPage(Uint64 page_size);
+
+	//threads carve small chunks out of the current page with a single atomic add and suballocate
+	//from their chunk without synchronization, the mutex is only taken when a page runs out.
+	//Clear must not overlap with Allocate, it is called once the gpu is done with the allocations.
 	class GfxLinearDynamicAllocator
 	{
 		static constexpr Uint32 PAGE_COUNT_HISTORY_SIZE = 8;
+		static constexpr Uint64 MAX_CHUNK_SIZE = 64 * 1024;
+
 		struct GfxAllocationPage
 		{
-			std::unique_ptr<GfxBuffer> buffer;
-			LinearOffsetAllocator linear_offset_allocator;
-			void* cpu_address;
+			std::unique_ptr<IGfxLinearAllocatorPage> backing;
+			std::atomic<Uint64> top = 0;
 
-			GfxAllocationPage(GfxDevice* gfx, Uint64 page_size);
-			GfxAllocationPage(GfxAllocationPage&&);
-			~GfxAllocationPage();
+			explicit GfxAllocationPage(std::unique_ptr<IGfxLinearAllocatorPage>&& backing) : backing(std::move(backing)) {}
+		};
+
+		struct ThreadCache
+		{
+			Uint64 allocator_id = 0;
+			Uint64 generation = 0;
+			GfxAllocationPage* page = nullptr;
+			Uint64 offset = 0;
+			Uint64 end = 0;
 		};
 
 	public:
 		GfxLinearDynamicAllocator(GfxDevice* gfx, Uint64 page_size, Uint64 page_count = 1);
+		GfxLinearDynamicAllocator(GfxLinearAllocatorPageFactory page_factory, Uint64 page_size, Uint64 page_count = 1);
+		ADRIA_NONCOPYABLE_NONMOVABLE(GfxLinearDynamicAllocator)
 		~GfxLinearDynamicAllocator();
+
 		GfxDynamicAllocation Allocate(Uint64 size_in_bytes, Uint64 alignment = 0);
 
 		template<typename T>
@@ -35,12 +61,30 @@ namespace adria
 		}
 		void Clear();
 
+		Uint64 GetPageCount() const;
+
 	private:
-		GfxDevice* gfx;
-		std::mutex alloc_mutex;
-		std::vector<GfxAllocationPage> alloc_pages;
+		GfxLinearAllocatorPageFactory page_factory;
 		Uint64 const page_size;
-		Uint64 current_page;
+		Uint64 const chunk_size;
+		Uint64 const min_page_count;
+		Uint64 const allocator_id;
+
+		mutable std::mutex alloc_mutex;
+		std::vector<std::unique_ptr<GfxAllocationPage>> alloc_pages;
+		std::vector<std::unique_ptr<GfxAllocationPage>> oversized_pages;
+		std::atomic<GfxAllocationPage*> current_page = nullptr;
+		Uint64 current_page_index = 0;
+		std::atomic<Uint64> generation = 1;
+
 		Uint64 used_page_count_history[PAGE_COUNT_HISTORY_SIZE];
+		Uint64 history_index = 0;
+
+	private:
+		ThreadCache& GetThreadCache();
+		Bool ClaimRange(Uint64 size, GfxAllocationPage*& page, Uint64& offset);
+		void AdvancePage(GfxAllocationPage* exhausted_page);
+		GfxAllocationPage* AllocateOversizedPage(Uint64 size);
+		GfxDynamicAllocation MakeAllocation(GfxAllocationPage* page, Uint64 offset, Uint64 size) const;
 	};
-}
\ No newline at end of file
+}
@@ -87,7 +87,7 @@ namespace adria
 		result_buffer_desc.misc_flags = GfxBufferMiscFlag::AccelStruct;
 		result_buffer_desc.stride = 4;
 		result_buffer = gfx->CreateBuffer(result_buffer_desc);
-		scratch_buffer->SetName("result buffer");
+		result_buffer->SetName("result buffer");
 
 		D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC blas_desc{};
 		blas_desc.Inputs = inputs;
@@ -98,6 +98,22 @@ namespace adria
 		cmd_list->GetNative()->BuildRaytracingAccelerationStructure(&blas_desc, 0, nullptr);
 	}
 
+	GfxRayTracingBLAS::GfxRayTracingBLAS(GfxDevice* gfx, GfxRayTracingBLAS const& source, Uint64 compacted_size)
+	{
+		ADRIA_ASSERT(compacted_size > 0 && compacted_size <= source.GetSize());
+
+		GfxBufferDesc result_buffer_desc{};
+		result_buffer_desc.bind_flags = GfxBindFlag::UnorderedAccess | GfxBindFlag::ShaderResource;
+		result_buffer_desc.size = compacted_size;
+		result_buffer_desc.misc_flags = GfxBufferMiscFlag::AccelStruct;
+		result_buffer_desc.stride = 4;
+		result_buffer = gfx->CreateBuffer(result_buffer_desc);
+		result_buffer->SetName("compacted result buffer");
+
+		GfxCommandList* cmd_list = gfx->GetGraphicsCommandList();
+		cmd_list->GetNative()->CopyRaytracingAccelerationStructure(result_buffer->GetGpuAddress(), source.GetGpuAddress(), D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_COMPACT);
+	}
+
 	GfxRayTracingBLAS::~GfxRayTracingBLAS() = default;
 
 	Uint64 GfxRayTracingBLAS::GetGpuAddress() const
@@ -105,6 +121,26 @@ namespace adria
 		return result_buffer->GetGpuAddress();
 	}
 
+	Uint64 GfxRayTracingBLAS::GetSize() const
+	{
+		return result_buffer->GetSize();
+	}
+
+	void EmitRayTracingBLASCompactedSizes(GfxCommandList* cmd_list, std::span<GfxRayTracingBLAS const*> blases, GfxBuffer const& postbuild_buffer)
+	{
+		ADRIA_ASSERT(postbuild_buffer.GetSize() >= blases.size() * sizeof(Uint64));
+		std::vector<D3D12_GPU_VIRTUAL_ADDRESS> blas_addresses; blas_addresses.reserve(blases.size());
+		for (GfxRayTracingBLAS const* blas : blases)
+		{
+			blas_addresses.push_back(blas->GetGpuAddress());
+		}
+
+		D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC postbuild_desc{};
+		postbuild_desc.InfoType = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE;
+		postbuild_desc.DestBuffer = postbuild_buffer.GetGpuAddress();
+		cmd_list->GetNative()->EmitRaytracingAccelerationStructurePostbuildInfo(&postbuild_desc, (Uint32)blas_addresses.size(), blas_addresses.data());
+	}
+
 	GfxRayTracingTLAS::GfxRayTracingTLAS(GfxDevice* gfx, std::span<GfxRayTracingInstance> instances, GfxRayTracingASFlags flags)
 	{
 		D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS inputs{};
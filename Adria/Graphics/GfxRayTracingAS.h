@@ -6,6 +6,7 @@ namespace adria
 {
 	class GfxBuffer;
 	class GfxDevice;
+	class GfxCommandList;
 	class GfxRayTracingBLAS;
 
 	enum GfxRayTracingASFlagBit : Uint32
@@ -51,9 +52,11 @@ namespace adria
 	{
 	public:
 		GfxRayTracingBLAS(GfxDevice* gfx, std::span<GfxRayTracingGeometry> geometries, GfxRayTracingASFlags flags);
+		GfxRayTracingBLAS(GfxDevice* gfx, GfxRayTracingBLAS const& source, Uint64 compacted_size);
 		~GfxRayTracingBLAS();
 
 		Uint64 GetGpuAddress() const;
+		Uint64 GetSize() const;
 		GfxBuffer const& GetBuffer() const { return *result_buffer; }
 		GfxBuffer const& operator*() const { return *result_buffer; }
 
@@ -63,6 +66,9 @@ namespace adria
 	};
 
 
+	//writes the compacted size of each BLAS as Uint64 into postbuild_buffer, which has to be in the unordered access state
+	void EmitRayTracingBLASCompactedSizes(GfxCommandList* cmd_list, std::span<GfxRayTracingBLAS const*> blases, GfxBuffer const& postbuild_buffer);
+
 	struct GfxRayTracingInstance
 	{
 		GfxRayTracingBLAS* blas;
@@ -284,7 +284,27 @@ namespace adria
 	}
 	inline constexpr std::string ConvertBarrierFlagsToString(GfxResourceState flags)
 	{
+		using enum GfxResourceState;
 		std::string resource_state_string = "";
+		if (HasFlag(flags, Present))			resource_state_string += "Present|";
+		if (HasFlag(flags, RTV))				resource_state_string += "RTV|";
+		if (HasFlag(flags, DSV))				resource_state_string += "DSV|";
+		if (HasFlag(flags, DSV_ReadOnly))		resource_state_string += "DSV_ReadOnly|";
+		if (HasFlag(flags, VertexSRV))			resource_state_string += "VertexSRV|";
+		if (HasFlag(flags, PixelSRV))			resource_state_string += "PixelSRV|";
+		if (HasFlag(flags, ComputeSRV))			resource_state_string += "ComputeSRV|";
+		if (HasFlag(flags, VertexUAV))			resource_state_string += "VertexUAV|";
+		if (HasFlag(flags, PixelUAV))			resource_state_string += "PixelUAV|";
+		if (HasFlag(flags, ComputeUAV))			resource_state_string += "ComputeUAV|";
+		if (HasFlag(flags, ClearUAV))			resource_state_string += "ClearUAV|";
+		if (HasFlag(flags, CopyDst))			resource_state_string += "CopyDst|";
+		if (HasFlag(flags, CopySrc))			resource_state_string += "CopySrc|";
+		if (HasFlag(flags, ShadingRate))		resource_state_string += "ShadingRate|";
+		if (HasFlag(flags, IndexBuffer))		resource_state_string += "IndexBuffer|";
+		if (HasFlag(flags, IndirectArgs))		resource_state_string += "IndirectArgs|";
+		if (HasFlag(flags, ASRead))				resource_state_string += "ASRead|";
+		if (HasFlag(flags, ASWrite))			resource_state_string += "ASWrite|";
+		if (HasFlag(flags, Discard))			resource_state_string += "Discard|";
 		if (!resource_state_string.empty()) resource_state_string.pop_back();
 		return resource_state_string.empty() ? "Common" : resource_state_string;
 	}
@@ -0,0 +1,495 @@
+#include "GfxShaderCache.h"
+
+namespace fs = std::filesystem;
+
+namespace adria
+{
+	ADRIA_LOG_CHANNEL(ShaderCompiler);
+
+	namespace
+	{
+		constexpr Uint32 ARCHIVE_MAGIC = 0x41435341; //'ASCA'
+		constexpr Uint32 RECORD_MAGIC  = 0x52435341; //'ASCR'
+		constexpr Uint32 INDEX_MAGIC   = 0x49435341; //'ASCI'
+		constexpr Uint32 CACHE_VERSION = 1;
+
+		struct ArchiveHeader
+		{
+			Uint32 magic;
+			Uint32 version;
+			Uint32 session;
+			Uint32 padding;
+		};
+
+		struct RecordHeader
+		{
+			Uint32 magic;
+			Uint32 padding;
+			Uint64 key_low;
+			Uint64 key_high;
+			Uint64 payload_size;
+			Uint64 payload_crc;
+		};
+
+		struct IndexHeader
+		{
+			Uint32 magic;
+			Uint32 version;
+			Uint64 archive_size;
+			Uint64 dead_size;
+			Uint64 entry_count;
+		};
+
+		struct IndexRecord
+		{
+			Uint64 key_low;
+			Uint64 key_high;
+			Uint64 offset;
+			Uint64 size;
+			Uint32 last_used_session;
+			Uint32 padding;
+		};
+
+		std::string GetIndexPath(std::string const& archive_path)
+		{
+			return archive_path + ".index";
+		}
+		std::string GetTempPath(std::string const& path)
+		{
+			return path + ".tmp";
+		}
+
+		Bool ReplaceFile(std::string const& temp_path, std::string const& path)
+		{
+			std::error_code ec;
+			fs::rename(temp_path, path, ec);
+			if (ec)
+			{
+				fs::remove(temp_path, ec);
+				return false;
+			}
+			return true;
+		}
+
+		template<typename T>
+		void WritePod(std::vector<Uint8>& buffer, T const& value)
+		{
+			Uint8 const* bytes = reinterpret_cast<Uint8 const*>(&value);
+			buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+		}
+
+		class PayloadReader
+		{
+		public:
+			explicit PayloadReader(std::span<Uint8 const> payload) : payload(payload) {}
+
+			template<typename T>
+			Bool Read(T& value)
+			{
+				return ReadBytes(&value, sizeof(T));
+			}
+			Bool ReadBytes(void* dst, Uint64 size)
+			{
+				if (size > payload.size() - offset) return false;
+				memcpy(dst, payload.data() + offset, size);
+				offset += size;
+				return true;
+			}
+			Uint64 Remaining() const { return payload.size() - offset; }
+
+		private:
+			std::span<Uint8 const> payload;
+			Uint64 offset = 0;
+		};
+
+		void SerializeEntry(GfxShaderCacheEntry const& entry, std::vector<Uint8>& payload)
+		{
+			WritePod(payload, entry.shader_hash);
+			WritePod(payload, (Uint32)entry.includes.size());
+			for (std::string const& include : entry.includes)
+			{
+				WritePod(payload, (Uint32)include.size());
+				payload.insert(payload.end(), include.begin(), include.end());
+			}
+			WritePod(payload, (Uint64)entry.binary.size());
+			payload.insert(payload.end(), entry.binary.begin(), entry.binary.end());
+		}
+
+		Bool DeserializeEntry(std::span<Uint8 const> payload, GfxShaderCacheEntry& entry)
+		{
+			PayloadReader reader(payload);
+			if (!reader.Read(entry.shader_hash)) return false;
+
+			Uint32 include_count = 0;
+			if (!reader.Read(include_count)) return false;
+			entry.includes.clear();
+			entry.includes.reserve(include_count);
+			for (Uint32 i = 0; i < include_count; ++i)
+			{
+				Uint32 length = 0;
+				if (!reader.Read(length) || length > reader.Remaining()) return false;
+				std::string& include = entry.includes.emplace_back(length, '\0');
+				reader.ReadBytes(include.data(), length);
+			}
+
+			Uint64 binary_size = 0;
+			if (!reader.Read(binary_size) || binary_size != reader.Remaining()) return false;
+			entry.binary.resize(binary_size);
+			return reader.ReadBytes(entry.binary.data(), binary_size);
+		}
+	}
+
+	GfxShaderCache::~GfxShaderCache()
+	{
+		Close();
+	}
+
+	Bool GfxShaderCache::Open(std::string const& _archive_path)
+	{
+		Close();
+		std::lock_guard lock(cache_mutex);
+		archive_path = _archive_path;
+
+		if (!fs::exists(archive_path) && !CreateArchive()) return false;
+		archive.open(archive_path, std::ios::in | std::ios::out | std::ios::binary);
+		if (!archive.is_open())
+		{
+			ADRIA_LOG(WARNING, "Could not open shader cache archive %s", archive_path.c_str());
+			return false;
+		}
+
+		ArchiveHeader header{};
+		archive.read(reinterpret_cast<Char*>(&header), sizeof(header));
+		if (!archive || header.magic != ARCHIVE_MAGIC || header.version != CACHE_VERSION)
+		{
+			ADRIA_LOG(INFO, "Shader cache archive %s is invalid or outdated, recreating it", archive_path.c_str());
+			archive.close();
+			if (!CreateArchive()) return false;
+			archive.open(archive_path, std::ios::in | std::ios::out | std::ios::binary);
+			if (!archive.is_open()) return false;
+			header = ArchiveHeader{ .magic = ARCHIVE_MAGIC, .version = CACHE_VERSION };
+		}
+
+		session = header.session + 1;
+		header.session = session;
+		archive.seekp(0);
+		archive.write(reinterpret_cast<Char const*>(&header), sizeof(header));
+		archive.flush();
+
+		archive_size = fs::file_size(archive_path);
+		if (!LoadIndex())
+		{
+			ADRIA_LOG(INFO, "Shader cache index for %s is missing or stale, rebuilding it", archive_path.c_str());
+			RebuildIndexImpl();
+		}
+		return true;
+	}
+
+	void GfxShaderCache::Close()
+	{
+		if (!IsOpen()) return;
+
+		Uint64 const stale_size = GetStaleSize();
+		if (stale_size > 0 && stale_size * 4 > archive_size)
+		{
+			Compact();
+		}
+
+		std::lock_guard lock(cache_mutex);
+		archive.close();
+		SaveIndex();
+		index.clear();
+		archive_size = 0;
+		dead_size = 0;
+	}
+
+	Bool GfxShaderCache::Load(GfxShaderCacheKey const& key, GfxShaderCacheEntry& entry)
+	{
+		std::lock_guard lock(cache_mutex);
+		if (!IsOpen()) return false;
+
+		auto it = index.find(key);
+		if (it == index.end()) return false;
+
+		IndexEntry& index_entry = it->second;
+		GfxShaderCacheKey record_key{};
+		std::vector<Uint8> payload;
+		if (!ReadRecord(index_entry.offset, record_key, payload) || record_key != key || !DeserializeEntry(payload, entry))
+		{
+			ADRIA_LOG(WARNING, "Corrupted shader cache record at offset %llu, dropping it", index_entry.offset);
+			dead_size += index_entry.size;
+			index.erase(it);
+			return false;
+		}
+		index_entry.last_used_session = session;
+		return true;
+	}
+
+	Bool GfxShaderCache::Store(GfxShaderCacheKey const& key, GfxShaderCacheEntry const& entry)
+	{
+		std::lock_guard lock(cache_mutex);
+		if (!IsOpen()) return false;
+
+		std::vector<Uint8> record(sizeof(RecordHeader));
+		SerializeEntry(entry, record);
+
+		Uint64 const payload_size = record.size() - sizeof(RecordHeader);
+		RecordHeader header
+		{
+			.magic = RECORD_MAGIC,
+			.key_low = key.low,
+			.key_high = key.high,
+			.payload_size = payload_size,
+			.payload_crc = crc64(reinterpret_cast<Char const*>(record.data() + sizeof(RecordHeader)), payload_size)
+		};
+		memcpy(record.data(), &header, sizeof(header));
+
+		//the record is appended with a single write, a torn write is detected by the crc and discarded on the next index rebuild
+		archive.clear();
+		archive.seekp(0, std::ios::end);
+		Uint64 const offset = archive.tellp();
+		archive.write(reinterpret_cast<Char const*>(record.data()), record.size());
+		archive.flush();
+		if (!archive)
+		{
+			ADRIA_LOG(WARNING, "Failed to append to shader cache archive %s", archive_path.c_str());
+			archive.clear();
+			return false;
+		}
+
+		if (auto it = index.find(key); it != index.end())
+		{
+			dead_size += it->second.size;
+		}
+		index[key] = IndexEntry{ .offset = offset, .size = record.size(), .last_used_session = session };
+		archive_size = offset + record.size();
+		return true;
+	}
+
+	Bool GfxShaderCache::Compact()
+	{
+		std::lock_guard lock(cache_mutex);
+		if (!IsOpen()) return false;
+
+		std::string const temp_path = GetTempPath(archive_path);
+		std::ofstream compacted(temp_path, std::ios::binary | std::ios::trunc);
+		if (!compacted.is_open()) return false;
+
+		ArchiveHeader header{ .magic = ARCHIVE_MAGIC, .version = CACHE_VERSION, .session = session };
+		compacted.write(reinterpret_cast<Char const*>(&header), sizeof(header));
+
+		std::vector<std::pair<GfxShaderCacheKey, IndexEntry>> live_entries;
+		live_entries.reserve(index.size());
+		for (auto const& [key, entry] : index)
+		{
+			if (!IsEvictable(entry)) live_entries.emplace_back(key, entry);
+		}
+		std::sort(live_entries.begin(), live_entries.end(), [](auto const& a, auto const& b) { return a.second.offset < b.second.offset; });
+
+		std::unordered_map<GfxShaderCacheKey, IndexEntry, Hash128Hasher> compacted_index;
+		compacted_index.reserve(live_entries.size());
+		std::vector<Char> record;
+		Uint64 offset = sizeof(header);
+		for (auto const& [key, entry] : live_entries)
+		{
+			record.resize(entry.size);
+			archive.clear();
+			archive.seekg(entry.offset);
+			archive.read(record.data(), entry.size);
+			if (!archive) continue;
+
+			compacted.write(record.data(), entry.size);
+			compacted_index[key] = IndexEntry{ .offset = offset, .size = entry.size, .last_used_session = entry.last_used_session };
+			offset += entry.size;
+		}
+		compacted.close();
+		if (!compacted)
+		{
+			std::error_code ec;
+			fs::remove(temp_path, ec);
+			return false;
+		}
+
+		archive.close();
+		Bool const replaced = ReplaceFile(temp_path, archive_path);
+		archive.open(archive_path, std::ios::in | std::ios::out | std::ios::binary);
+		if (!replaced) return false;
+
+		ADRIA_LOG(INFO, "Compacted shader cache archive from %llu to %llu bytes", archive_size, offset);
+		index = std::move(compacted_index);
+		archive_size = offset;
+		dead_size = 0;
+		return SaveIndex();
+	}
+
+	Bool GfxShaderCache::RebuildIndex()
+	{
+		std::lock_guard lock(cache_mutex);
+		if (!IsOpen()) return false;
+		return RebuildIndexImpl();
+	}
+
+	Uint64 GfxShaderCache::GetStaleSize() const
+	{
+		std::lock_guard lock(cache_mutex);
+		Uint64 stale_size = dead_size;
+		for (auto const& [key, entry] : index)
+		{
+			if (IsEvictable(entry)) stale_size += entry.size;
+		}
+		return stale_size;
+	}
+
+	Bool GfxShaderCache::CreateArchive()
+	{
+		std::string const temp_path = GetTempPath(archive_path);
+		{
+			std::ofstream os(temp_path, std::ios::binary | std::ios::trunc);
+			if (!os.is_open()) return false;
+			ArchiveHeader header{ .magic = ARCHIVE_MAGIC, .version = CACHE_VERSION, .session = 0 };
+			os.write(reinterpret_cast<Char const*>(&header), sizeof(header));
+			if (!os) return false;
+		}
+		std::error_code ec;
+		fs::remove(GetIndexPath(archive_path), ec);
+		return ReplaceFile(temp_path, archive_path);
+	}
+
+	Bool GfxShaderCache::LoadIndex()
+	{
+		index.clear();
+		dead_size = 0;
+
+		std::ifstream is(GetIndexPath(archive_path), std::ios::binary);
+		if (!is.is_open()) return false;
+
+		IndexHeader header{};
+		is.read(reinterpret_cast<Char*>(&header), sizeof(header));
+		if (!is || header.magic != INDEX_MAGIC || header.version != CACHE_VERSION || header.archive_size != archive_size)
+		{
+			return false;
+		}
+
+		std::vector<IndexRecord> records(header.entry_count);
+		is.read(reinterpret_cast<Char*>(records.data()), records.size() * sizeof(IndexRecord));
+		Uint64 stored_crc = 0;
+		is.read(reinterpret_cast<Char*>(&stored_crc), sizeof(stored_crc));
+		if (!is || stored_crc != crc64(reinterpret_cast<Char const*>(records.data()), records.size() * sizeof(IndexRecord)))
+		{
+			return false;
+		}
+
+		index.reserve(records.size());
+		for (IndexRecord const& record : records)
+		{
+			if (record.offset < sizeof(ArchiveHeader) || record.offset + record.size > archive_size)
+			{
+				index.clear();
+				return false;
+			}
+			index[GfxShaderCacheKey{ record.key_low, record.key_high }] = IndexEntry{ .offset = record.offset, .size = record.size, .last_used_session = record.last_used_session };
+		}
+		dead_size = header.dead_size;
+		return true;
+	}
+
+	Bool GfxShaderCache::SaveIndex() const
+	{
+		std::vector<IndexRecord> records;
+		records.reserve(index.size());
+		for (auto const& [key, entry] : index)
+		{
+			records.push_back(IndexRecord{ .key_low = key.low, .key_high = key.high, .offset = entry.offset, .size = entry.size, .last_used_session = entry.last_used_session });
+		}
+
+		IndexHeader header{ .magic = INDEX_MAGIC, .version = CACHE_VERSION, .archive_size = archive_size, .dead_size = dead_size, .entry_count = records.size() };
+		Uint64 const crc = crc64(reinterpret_cast<Char const*>(records.data()), records.size() * sizeof(IndexRecord));
+
+		std::string const index_path = GetIndexPath(archive_path);
+		std::string const temp_path = GetTempPath(index_path);
+		{
+			std::ofstream os(temp_path, std::ios::binary | std::ios::trunc);
+			if (!os.is_open()) return false;
+			os.write(reinterpret_cast<Char const*>(&header), sizeof(header));
+			os.write(reinterpret_cast<Char const*>(records.data()), records.size() * sizeof(IndexRecord));
+			os.write(reinterpret_cast<Char const*>(&crc), sizeof(crc));
+			if (!os) return false;
+		}
+		return ReplaceFile(temp_path, index_path);
+	}
+
+	Bool GfxShaderCache::RebuildIndexImpl()
+	{
+		index.clear();
+		dead_size = 0;
+
+		GfxShaderCacheKey key{};
+		std::vector<Uint8> payload;
+		Uint64 offset = sizeof(ArchiveHeader);
+		Uint64 valid_end = offset;
+		while (offset + sizeof(RecordHeader) <= archive_size)
+		{
+			if (ReadRecord(offset, key, payload))
+			{
+				Uint64 const record_size = sizeof(RecordHeader) + payload.size();
+				if (auto it = index.find(key); it != index.end())
+				{
+					dead_size += it->second.size;
+				}
+				index[key] = IndexEntry{ .offset = offset, .size = record_size, .last_used_session = session };
+				offset += record_size;
+				valid_end = offset;
+				continue;
+			}
+
+			//resynchronize on the next record magic, everything skipped is garbage that the next compaction removes
+			Uint64 next_offset = offset + 1;
+			Uint32 magic = 0;
+			while (next_offset + sizeof(RecordHeader) <= archive_size)
+			{
+				archive.clear();
+				archive.seekg(next_offset);
+				archive.read(reinterpret_cast<Char*>(&magic), sizeof(magic));
+				if (archive && magic == RECORD_MAGIC) break;
+				++next_offset;
+			}
+			dead_size += next_offset - offset;
+			offset = next_offset;
+		}
+
+		//drop a torn record at the end of the archive so new records are appended after valid data
+		if (valid_end < archive_size)
+		{
+			dead_size -= std::min(dead_size, archive_size - valid_end);
+			archive.close();
+			std::error_code ec;
+			fs::resize_file(archive_path, valid_end, ec);
+			archive.open(archive_path, std::ios::in | std::ios::out | std::ios::binary);
+			if (!ec) archive_size = valid_end;
+		}
+		return SaveIndex();
+	}
+
+	Bool GfxShaderCache::ReadRecord(Uint64 offset, GfxShaderCacheKey& key, std::vector<Uint8>& payload)
+	{
+		RecordHeader header{};
+		archive.clear();
+		archive.seekg(offset);
+		archive.read(reinterpret_cast<Char*>(&header), sizeof(header));
+		if (!archive || header.magic != RECORD_MAGIC) return false;
+		if (header.payload_size > archive_size - offset - sizeof(RecordHeader)) return false;
+
+		payload.resize(header.payload_size);
+		archive.read(reinterpret_cast<Char*>(payload.data()), header.payload_size);
+		if (!archive) return false;
+		if (crc64(reinterpret_cast<Char const*>(payload.data()), payload.size()) != header.payload_crc) return false;
+
+		key = GfxShaderCacheKey{ header.key_low, header.key_high };
+		return true;
+	}
+
+	Bool GfxShaderCache::IsEvictable(IndexEntry const& entry) const
+	{
+		return session - entry.last_used_session > UnusedSessionsBeforeEviction;
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "Utilities/Hash.h"
+
+namespace adria
+{
+	using GfxShaderCacheKey = Hash128;
+
+	struct GfxShaderCacheEntry
+	{
+		Uint64 shader_hash[2] = {};
+		std::vector<std::string> includes;
+		std::vector<Uint8> binary;
+	};
+
+	//Single append-only archive of compiled shaders. Records are content addressed by a 128-bit key,
+	//the index is persisted next to the archive and rebuilt by scanning the records if it is missing or stale.
+	class GfxShaderCache
+	{
+		struct IndexEntry
+		{
+			Uint64 offset;
+			Uint64 size;
+			Uint32 last_used_session;
+		};
+
+	public:
+		static constexpr Uint32 UnusedSessionsBeforeEviction = 8;
+
+	public:
+		GfxShaderCache() = default;
+		ADRIA_NONCOPYABLE_NONMOVABLE(GfxShaderCache)
+		~GfxShaderCache();
+
+		Bool Open(std::string const& archive_path);
+		void Close();
+		Bool IsOpen() const { return archive.is_open(); }
+
+		Bool Load(GfxShaderCacheKey const& key, GfxShaderCacheEntry& entry);
+		Bool Store(GfxShaderCacheKey const& key, GfxShaderCacheEntry const& entry);
+
+		Bool Compact();
+		Bool RebuildIndex();
+
+		Uint64 GetEntryCount() const { return index.size(); }
+		Uint64 GetArchiveSize() const { return archive_size; }
+		Uint64 GetStaleSize() const;
+
+	private:
+		std::string archive_path;
+		std::fstream archive;
+		Uint64 archive_size = 0;
+		Uint64 dead_size = 0;
+		Uint32 session = 0;
+		std::unordered_map<GfxShaderCacheKey, IndexEntry, Hash128Hasher> index;
+		mutable std::mutex cache_mutex;
+
+	private:
+		Bool CreateArchive();
+		Bool LoadIndex();
+		Bool SaveIndex() const;
+		Bool RebuildIndexImpl();
+		Bool ReadRecord(Uint64 offset, GfxShaderCacheKey& key, std::vector<Uint8>& payload);
+		Bool IsEvictable(IndexEntry const& entry) const;
+	};
+}
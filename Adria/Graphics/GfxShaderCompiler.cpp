@@ -1,9 +1,7 @@
 #include <d3dcompiler.h>
 #include "dxcapi.h"
-#include "cereal/archives/binary.hpp"
-#include "cereal/types/string.hpp"
-#include "cereal/types/vector.hpp"
 #include "GfxShaderCompiler.h"
+#include "GfxShaderCache.h"
 #include "GfxDefines.h"
 #include "Core/Paths.h"
 #include "Core/FatalAssert.h"
@@ -28,6 +26,8 @@ namespace adria
 		Ref<IDxcUtils> utils = nullptr;
 		Ref<IDxcIncludeHandler> include_handler = nullptr;
 		DynamicLibrary dxcompiler;
+		GfxShaderCache shader_cache;
+		std::string compiler_version;
 	}
 	class GfxIncludeHandler : public IDxcIncludeHandler
 	{
@@ -156,52 +156,68 @@ namespace adria
 
 	namespace GfxShaderCompiler
 	{
-		static Bool CheckCache(Char const* cache_path, GfxShaderCompileInput const& input, GfxShaderCompileOutput& output)
+		//caches from before the archive stored a .bin and .meta file per permutation
+		static void RemoveLegacyCacheFiles()
 		{
-			std::string cache_binary(cache_path); cache_binary += ".bin";
-			std::string cache_metadata(cache_path); cache_metadata += ".meta";
-
-			if (!FileExists(cache_binary) || !FileExists(cache_metadata)) return false;
-			if (GetFileLastWriteTime(cache_binary) < GetFileLastWriteTime(input.file)) return false;
+			std::error_code ec;
+			for (auto const& entry : std::filesystem::directory_iterator(paths::ShaderCacheDir, ec))
+			{
+				std::filesystem::path const& path = entry.path();
+				if (entry.is_regular_file() && (path.extension() == ".bin" || path.extension() == ".meta"))
+				{
+					std::filesystem::remove(path, ec);
+				}
+			}
+		}
 
-			std::ifstream is(cache_metadata, std::ios::binary);
-			cereal::BinaryInputArchive metadata_archive(is);
+		static std::string GetCompilerVersion()
+		{
+			Ref<IDxcVersionInfo> version_info;
+			if (FAILED(compiler->QueryInterface(IID_PPV_ARGS(version_info.GetAddressOf())))) return "dxc";
+
+			Uint32 major = 0, minor = 0;
+			version_info->GetVersion(&major, &minor);
+			Uint32 commit_count = 0;
+			Ref<IDxcVersionInfo2> version_info2;
+			if (SUCCEEDED(version_info.As(&version_info2)))
+			{
+				Char* commit_hash = nullptr;
+				version_info2->GetCommitInfo(&commit_count, &commit_hash);
+				if (commit_hash) CoTaskMemFree(commit_hash);
+			}
+			return std::format("dxc {}.{}.{}", major, minor, commit_count);
+		}
 
-			metadata_archive(output.shader_hash);
-			metadata_archive(output.includes);
-			Uint64 binary_size = 0;
-			metadata_archive(binary_size);
+		static GfxShaderCacheKey GetCacheKey(std::string_view preprocessed_source, std::vector<Wchar const*> const& compile_args)
+		{
+			std::string key_data(preprocessed_source);
+			key_data += '\0';
+			key_data += compiler_version;
+			for (Wchar const* arg : compile_args)
+			{
+				key_data += '\0';
+				key_data += ToString(arg);
+			}
+			return murmur3_128(key_data.data(), key_data.size());
+		}
 
-			//check if the one of the includes was modified after the cache binary was generated
-			for (std::string const& include : output.includes)
+		static Bool PreprocessShader(DxcBuffer const& source_buffer, std::vector<Wchar const*> compile_args, std::string& preprocessed_source)
+		{
+			compile_args.push_back(L"-P");
+			GfxIncludeHandler preprocess_include_handler{};
+			Ref<IDxcResult> result;
+			if (FAILED(compiler->Compile(&source_buffer, compile_args.data(), (Uint32)compile_args.size(), &preprocess_include_handler, IID_PPV_ARGS(result.GetAddressOf()))))
 			{
-				if (GetFileLastWriteTime(cache_binary) < GetFileLastWriteTime(include)) 
-					return false;
+				return false;
 			}
 
-			std::ifstream is2(cache_binary, std::ios::binary);
-			cereal::BinaryInputArchive binary_archive(is2);
+			HRESULT status = S_OK;
+			if (FAILED(result->GetStatus(&status)) || FAILED(status)) return false;
 
-			std::unique_ptr<Char[]> binary_data(new Char[binary_size]);
-			binary_archive.loadBinary(binary_data.get(), binary_size);
-			output.shader.SetShaderData(binary_data.get(), binary_size);
-			output.shader.SetDesc(input);
-			return true;
-		}
-		static Bool SaveToCache(Char const* cache_path, GfxShaderCompileOutput const& output)
-		{
-			std::string cache_metadata(cache_path); cache_metadata += ".meta";
-			std::ofstream os(cache_metadata, std::ios::binary);
-			cereal::BinaryOutputArchive metadata_archive(os);
-			metadata_archive(output.shader_hash);
-			metadata_archive(output.includes);
-			metadata_archive(output.shader.GetSize());
-
-			std::string cache_binary(cache_path); cache_binary += ".bin";
-			std::ofstream os2(cache_binary, std::ios::binary);
-			cereal::BinaryOutputArchive binary_archive(os2);
-			binary_archive.saveBinary(output.shader.GetData(), output.shader.GetSize());
+			Ref<IDxcBlobUtf8> hlsl;
+			if (FAILED(result->GetOutput(DXC_OUT_HLSL, IID_PPV_ARGS(hlsl.GetAddressOf()), nullptr)) || !hlsl) return false;
 
+			preprocessed_source.assign(hlsl->GetStringPointer(), hlsl->GetStringLength());
 			return true;
 		}
 
@@ -218,9 +234,15 @@ namespace adria
 			GFX_CHECK_HR(PFN_DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(utils.GetAddressOf())));
 
 			std::filesystem::create_directory(paths::ShaderPDBDir);
+			std::filesystem::create_directories(paths::ShaderCacheDir);
+			RemoveLegacyCacheFiles();
+
+			compiler_version = GetCompilerVersion();
+			shader_cache.Open(paths::ShaderCacheDir + "ShaderCache.archive");
 		}
 		void Destroy()
 		{
+			shader_cache.Close();
 			include_handler.Reset();
 			compiler.Reset();
 			library.Reset();
@@ -228,21 +250,6 @@ namespace adria
 		}
 		Bool CompileShader(GfxShaderCompileInput const& input, GfxShaderCompileOutput& output)
 		{
-			std::string define_key;
-			for (GfxShaderDefine const& define : input.defines)
-			{
-				define_key += define.name;
-				define_key += define.value;
-			}
-			Uint64 define_hash = crc64(define_key.c_str(), define_key.size());
-			std::string build_string = input.flags & GfxShaderCompilerFlag_Debug ? "debug" : "release";
-			Char cache_path[256];
-			sprintf_s(cache_path, "%s%s_%s_%llx_%s", paths::ShaderCacheDir.c_str(), GetFilenameWithoutExtension(input.file).c_str(),
-												     input.entry_point.c_str(), define_hash, build_string.c_str());
-
-			if (CheckCache(cache_path, input, output)) return true;
-			ADRIA_LOG(INFO, "Shader '%s.%s' not found in cache. Compiling...", input.file.c_str(), input.entry_point.c_str());
-
 			compile:
 			Uint32 code_page = CP_UTF8;
 			Ref<IDxcBlobEncoding> source_blob;
@@ -302,8 +309,26 @@ namespace adria
 			source_buffer.Ptr = source_blob->GetBufferPointer();
 			source_buffer.Size = source_blob->GetBufferSize();
 			source_buffer.Encoding = DXC_CP_ACP;
-			GfxIncludeHandler custom_include_handler{};
 
+			GfxShaderCacheKey cache_key{};
+			std::string preprocessed_source;
+			Bool const cacheable = PreprocessShader(source_buffer, compile_args, preprocessed_source);
+			if (cacheable)
+			{
+				cache_key = GetCacheKey(preprocessed_source, compile_args);
+				GfxShaderCacheEntry cache_entry{};
+				if (shader_cache.Load(cache_key, cache_entry))
+				{
+					memcpy(output.shader_hash, cache_entry.shader_hash, sizeof(output.shader_hash));
+					output.includes = std::move(cache_entry.includes);
+					output.shader.SetShaderData(cache_entry.binary.data(), cache_entry.binary.size());
+					output.shader.SetDesc(input);
+					return true;
+				}
+			}
+			ADRIA_LOG(INFO, "Shader '%s.%s' not found in cache. Compiling...", input.file.c_str(), input.entry_point.c_str());
+
+			GfxIncludeHandler custom_include_handler{};
 			Ref<IDxcResult> result;
 			hr = compiler->Compile(
 				&source_buffer,
@@ -361,7 +386,14 @@ namespace adria
 			output.shader.SetShaderData(blob->GetBufferPointer(), blob->GetBufferSize());
 			output.includes = std::move(custom_include_handler.include_files);
 			output.includes.push_back(input.file);
-			SaveToCache(cache_path, output);
+			if (cacheable)
+			{
+				GfxShaderCacheEntry cache_entry{};
+				memcpy(cache_entry.shader_hash, output.shader_hash, sizeof(output.shader_hash));
+				cache_entry.includes = output.includes;
+				cache_entry.binary.assign((Uint8 const*)blob->GetBufferPointer(), (Uint8 const*)blob->GetBufferPointer() + blob->GetBufferSize());
+				shader_cache.Store(cache_key, cache_entry);
+			}
 			return true;
 		}
 		void ReadBlobFromFile(std::string const& filename, GfxShaderBlob& blob)
@@ -0,0 +1,43 @@
+#include "GfxLinearDynamicAllocator.h"
+#include "GfxBuffer.h"
+#include "GfxDevice.h"
+
+namespace adria
+{
+	namespace
+	{
+		class GfxUploadPage final : public IGfxLinearAllocatorPage
+		{
+		public:
+			GfxUploadPage(GfxDevice* gfx, Uint64 page_size)
+			{
+				GfxBufferDesc desc{};
+				desc.size = page_size;
+				desc.resource_usage = GfxResourceUsage::Upload;
+				desc.bind_flags = GfxBindFlag::ShaderResource;
+
+				buffer = gfx->CreateBuffer(desc);
+				ADRIA_ASSERT(buffer->IsMapped());
+				buffer->SetName("LinearDynamicAllocatorPage");
+			}
+
+			virtual GfxBuffer* GetBuffer() const override { return buffer.get(); }
+			virtual Uint8* GetCpuAddress() const override { return buffer->GetMappedData<Uint8>(); }
+			virtual Uint64 GetGpuAddress() const override { return buffer->GetGpuAddress(); }
+			virtual Uint64 GetSize() const override { return buffer->GetSize(); }
+
+		private:
+			std::unique_ptr<GfxBuffer> buffer;
+		};
+	}
+
+	std::unique_ptr<IGfxLinearAllocatorPage> CreateGfxUploadPage(GfxDevice* gfx, Uint64 page_size)
+	{
+		return std::make_unique<GfxUploadPage>(gfx, page_size);
+	}
+
+	GfxLinearDynamicAllocator::GfxLinearDynamicAllocator(GfxDevice* gfx, Uint64 page_size, Uint64 page_count)
+		: GfxLinearDynamicAllocator([gfx](Uint64 size) { return CreateGfxUploadPage(gfx, size); }, page_size, page_count)
+	{
+	}
+}
@@ -0,0 +1,90 @@
+#include "BoundingVolumeUtil.h"
+#include "Utilities/ThreadPool.h"
+
+using namespace DirectX;
+
+namespace adria
+{
+	namespace
+	{
+		//below this the pass is memory bound on one core and the task overhead outweighs the split
+		constexpr Uint64 ParallelMinPoints = 1 << 17;
+
+		XMVECTOR LoadPosition(Uint8 const* data)
+		{
+			return XMLoadFloat3(reinterpret_cast<XMFLOAT3 const*>(data));
+		}
+
+		std::pair<XMVECTOR, XMVECTOR> MinMaxPoints(Uint8 const* data, Uint64 count, Uint64 stride)
+		{
+			//two independent accumulator pairs hide the latency of the min/max dependency chain
+			XMVECTOR min0 = LoadPosition(data), max0 = min0;
+			XMVECTOR min1 = min0, max1 = min0;
+			Uint64 i = 1;
+			for (; i + 1 < count; i += 2)
+			{
+				XMVECTOR const p0 = LoadPosition(data + i * stride);
+				XMVECTOR const p1 = LoadPosition(data + (i + 1) * stride);
+				min0 = XMVectorMin(min0, p0);
+				max0 = XMVectorMax(max0, p0);
+				min1 = XMVectorMin(min1, p1);
+				max1 = XMVectorMax(max1, p1);
+			}
+			if (i < count)
+			{
+				XMVECTOR const p = LoadPosition(data + i * stride);
+				min0 = XMVectorMin(min0, p);
+				max0 = XMVectorMax(max0, p);
+			}
+			return { XMVectorMin(min0, min1), XMVectorMax(max0, max1) };
+		}
+	}
+
+	BoundingBox AABBFromPoints(Float const* positions, Uint64 count, Uint64 stride)
+	{
+		if (count == 0) return BoundingBox(Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 0.0f));
+
+		Uint8 const* data = reinterpret_cast<Uint8 const*>(positions);
+		std::pair<XMVECTOR, XMVECTOR> extremes;
+		Uint64 const chunk_count = std::min<Uint64>(count / ParallelMinPoints, std::max(std::thread::hardware_concurrency(), 1u));
+		if (chunk_count <= 1)
+		{
+			extremes = MinMaxPoints(data, count, stride);
+		}
+		else
+		{
+			Uint64 const chunk_size = (count + chunk_count - 1) / chunk_count;
+			std::vector<std::future<std::pair<XMVECTOR, XMVECTOR>>> chunk_futures;
+			chunk_futures.reserve(chunk_count - 1);
+			for (Uint64 chunk = 1; chunk < chunk_count; ++chunk)
+			{
+				Uint64 const chunk_begin = chunk * chunk_size;
+				Uint64 const chunk_points = std::min(chunk_size, count - chunk_begin);
+				chunk_futures.push_back(g_ThreadPool.Submit(MinMaxPoints, data + chunk_begin * stride, chunk_points, stride));
+			}
+			extremes = MinMaxPoints(data, chunk_size, stride);
+			for (auto& chunk_future : chunk_futures)
+			{
+				auto const [chunk_min, chunk_max] = chunk_future.get();
+				extremes.first = XMVectorMin(extremes.first, chunk_min);
+				extremes.second = XMVectorMax(extremes.second, chunk_max);
+			}
+		}
+
+		Vector3 lower_left, upper_right;
+		XMStoreFloat3(&lower_left, extremes.first);
+		XMStoreFloat3(&upper_right, extremes.second);
+		Vector3 center((lower_left.x + upper_right.x) * 0.5f, (lower_left.y + upper_right.y) * 0.5f, (lower_left.z + upper_right.z) * 0.5f);
+		Vector3 extents(upper_right.x - center.x, upper_right.y - center.y, upper_right.z - center.z);
+		return BoundingBox(center, extents);
+	}
+
+	BoundingSphere SphereFromPoints(Float const* positions, Uint64 count, Uint64 stride)
+	{
+		if (count == 0) return BoundingSphere(Vector3(0.0f, 0.0f, 0.0f), 0.0f);
+
+		BoundingSphere sphere;
+		BoundingSphere::CreateFromPoints(sphere, count, reinterpret_cast<XMFLOAT3 const*>(positions), stride);
+		return sphere;
+	}
+}
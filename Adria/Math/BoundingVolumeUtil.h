@@ -10,35 +10,29 @@ namespace adria
         {v.position.z} -> std::convertible_to<Float>;
     };
 
+    //positions are three consecutive floats, stride bytes apart. the min/max reduction is a single simd pass,
+    //split over the thread pool for large inputs so don't call it with those from thread pool tasks.
+    //an empty input gives an empty box at the origin
+    BoundingBox AABBFromPoints(Float const* positions, Uint64 count, Uint64 stride);
+    //ritter sphere: starts from the most distant pair of axis extremes and grows to cover every point
+    BoundingSphere SphereFromPoints(Float const* positions, Uint64 count, Uint64 stride);
+
     template<typename IteratorT> requires HasPosition<std::iter_value_t<IteratorT>>
     BoundingBox AABBFromRange(IteratorT begin, IteratorT end)
     {
         using V = typename std::iterator_traits<IteratorT>::value_type;
-
-        auto x_extremes = std::minmax_element(begin, end,
-            [](V const& lhs, V const& rhs) 
-            {
-                return lhs.position.x < rhs.position.x;
-            });
-
-        auto y_extremes = std::minmax_element(begin, end,
-            [](V const& lhs, V const& rhs) 
-            {
-                return lhs.position.y < rhs.position.y;
-            });
-
-        auto z_extremes = std::minmax_element(begin, end,
-            [](V const& lhs, V const& rhs) 
-            {
-                return lhs.position.z < rhs.position.z;
-            });
-
-        Vector3 lower_left(x_extremes.first->position.x, y_extremes.first->position.y, z_extremes.first->position.z);
-        Vector3 upper_right(x_extremes.second->position.x, y_extremes.second->position.y, z_extremes.second->position.z);
-        Vector3 center((lower_left.x + upper_right.x) * 0.5f, (lower_left.y + upper_right.y) * 0.5f, (lower_left.z + upper_right.z) * 0.5f);
-        Vector3 extents(upper_right.x - center.x, upper_right.y - center.y, upper_right.z - center.z);
-
-        return BoundingBox(center, extents);
+        if constexpr (std::contiguous_iterator<IteratorT> && std::is_same_v<std::remove_cvref_t<decltype(std::declval<V>().position.x)>, Float>)
+        {
+            if (begin == end) return AABBFromPoints(nullptr, 0, sizeof(V));
+            return AABBFromPoints(&std::to_address(begin)->position.x, (Uint64)(end - begin), sizeof(V));
+        }
+        else
+        {
+            std::vector<Vector3> positions;
+            positions.reserve(std::distance(begin, end));
+            for (auto it = begin; it != end; ++it) positions.emplace_back(it->position.x, it->position.y, it->position.z);
+            return AABBFromPoints(reinterpret_cast<Float const*>(positions.data()), positions.size(), sizeof(Vector3));
+        }
     }
 
     template<typename V>
@@ -47,33 +41,20 @@ namespace adria
         return AABBFromRange(vertices.begin(), vertices.end());
     }
 
-	static BoundingBox AABBFromPositions(std::vector<Vector3> const& positions)
+	inline BoundingBox AABBFromPositions(std::vector<Vector3> const& positions)
 	{
-        auto begin = positions.begin();
-        auto end = positions.end();
-		auto x_extremes = std::minmax_element(begin, end,
-			[](auto const& lhs, auto const& rhs) 
-            {
-				return lhs.x < rhs.x;
-			});
-
-		auto y_extremes = std::minmax_element(begin, end,
-			[](auto const& lhs, auto const& rhs) 
-            {
-				return lhs.y < rhs.y;
-			});
-
-		auto z_extremes = std::minmax_element(begin, end,
-			[](auto const& lhs, auto const& rhs) 
-            {
-				return lhs.z < rhs.z;
-			});
+        return AABBFromPoints(reinterpret_cast<Float const*>(positions.data()), positions.size(), sizeof(Vector3));
+	}
 
-		Vector3 lower_left(x_extremes.first->x, y_extremes.first->y, z_extremes.first->z);
-		Vector3 upper_right(x_extremes.second->x, y_extremes.second->y, z_extremes.second->z);
-        Vector3 center((lower_left.x + upper_right.x) * 0.5f, (lower_left.y + upper_right.y) * 0.5f, (lower_left.z + upper_right.z) * 0.5f);
-		Vector3 extents(upper_right.x - center.x, upper_right.y - center.y, upper_right.z - center.z);
+    template<typename V> requires HasPosition<V>
+    BoundingSphere SphereFromVertices(std::vector<V> const& vertices)
+    {
+        if (vertices.empty()) return SphereFromPoints(nullptr, 0, sizeof(V));
+        return SphereFromPoints(&vertices.front().position.x, vertices.size(), sizeof(V));
+    }
 
-		return BoundingBox(center, extents);
-	}
-}
\ No newline at end of file
+    inline BoundingSphere SphereFromPositions(std::vector<Vector3> const& positions)
+    {
+        return SphereFromPoints(reinterpret_cast<Float const*>(positions.data()), positions.size(), sizeof(Vector3));
+    }
+}
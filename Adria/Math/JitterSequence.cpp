@@ -0,0 +1,111 @@
+#include "JitterSequence.h"
+#include "Halton.h"
+#include <random>
+
+namespace adria
+{
+	Char const* GetJitterSequenceTypeName(JitterSequenceType type)
+	{
+		switch (type)
+		{
+		case JitterSequenceType::Halton: return "Halton";
+		case JitterSequenceType::R2: return "R2";
+		case JitterSequenceType::BlueNoise: return "BlueNoise";
+		}
+		return "Invalid";
+	}
+
+	Uint32 GetUpscalerJitterPhaseCount(Uint32 render_width, Uint32 display_width, Uint32 base_phase_count)
+	{
+		if (render_width == 0 || display_width <= render_width) return base_phase_count;
+		Float const upscale_ratio = (Float)display_width / render_width;
+		return (Uint32)(base_phase_count * upscale_ratio * upscale_ratio);
+	}
+
+	std::vector<Vector2> GenerateHaltonJitter(Uint32 count)
+	{
+		constexpr Halton generator;
+		std::vector<Vector2> offsets(count);
+		for (Uint32 i = 0; i < count; ++i)
+		{
+			offsets[i] = Vector2(generator(i + 1, 2) - 0.5f, generator(i + 1, 3) - 0.5f);
+		}
+		return offsets;
+	}
+
+	std::vector<Vector2> GenerateR2Jitter(Uint32 count)
+	{
+		//additive recurrence with the plastic number, see Roberts, "The Unreasonable Effectiveness of Quasirandom Sequences"
+		constexpr Float64 g = 1.32471795724474602596;
+		constexpr Float64 a1 = 1.0 / g;
+		constexpr Float64 a2 = 1.0 / (g * g);
+		std::vector<Vector2> offsets(count);
+		for (Uint32 i = 0; i < count; ++i)
+		{
+			Float64 const x = 0.5 + a1 * (i + 1);
+			Float64 const y = 0.5 + a2 * (i + 1);
+			offsets[i] = Vector2((Float)(x - std::floor(x)) - 0.5f, (Float)(y - std::floor(y)) - 0.5f);
+		}
+		return offsets;
+	}
+
+	std::vector<Vector2> GenerateBlueNoiseJitter(Uint32 count, Uint32 seed)
+	{
+		static constexpr Uint32 CandidatesPerSample = 16;
+
+		//raw engine output instead of std distributions, those produce different values on different standard libraries
+		std::mt19937 rng(seed);
+		auto Random = [&rng]() { return (Float)(rng() >> 8) / (Float)(1u << 24); };
+		auto ToroidalDistanceSq = [](Vector2 const& a, Vector2 const& b)
+			{
+				Float dx = std::abs(a.x - b.x);
+				Float dy = std::abs(a.y - b.y);
+				dx = std::min(dx, 1.0f - dx);
+				dy = std::min(dy, 1.0f - dy);
+				return dx * dx + dy * dy;
+			};
+
+		std::vector<Vector2> points;
+		points.reserve(count);
+		for (Uint32 i = 0; i < count; ++i)
+		{
+			Vector2 best_candidate(Random(), Random());
+			Float best_distance = -1.0f;
+			Uint32 const candidate_count = i == 0 ? 1 : CandidatesPerSample * i;
+			for (Uint32 c = 0; c < candidate_count; ++c)
+			{
+				Vector2 const candidate = c == 0 ? best_candidate : Vector2(Random(), Random());
+				Float closest = FLT_MAX;
+				for (Vector2 const& point : points)
+				{
+					closest = std::min(closest, ToroidalDistanceSq(candidate, point));
+				}
+				if (closest > best_distance)
+				{
+					best_distance = closest;
+					best_candidate = candidate;
+				}
+			}
+			points.push_back(best_candidate);
+		}
+
+		for (Vector2& point : points) point -= Vector2(0.5f, 0.5f);
+		return points;
+	}
+
+	void JitterSequence::SetDesc(JitterSequenceDesc const& _desc)
+	{
+		if (_desc == desc) return;
+
+		desc = _desc;
+		desc.phase_count = std::max(desc.phase_count, 1u);
+		switch (desc.type)
+		{
+		case JitterSequenceType::R2: offsets = GenerateR2Jitter(desc.phase_count); break;
+		case JitterSequenceType::BlueNoise: offsets = GenerateBlueNoiseJitter(desc.phase_count); break;
+		case JitterSequenceType::Halton:
+		default:
+			offsets = GenerateHaltonJitter(desc.phase_count);
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+namespace adria
+{
+	enum class JitterSequenceType : Uint8
+	{
+		Halton,
+		R2,
+		BlueNoise
+	};
+	Char const* GetJitterSequenceTypeName(JitterSequenceType type);
+
+	struct JitterSequenceDesc
+	{
+		JitterSequenceType type = JitterSequenceType::Halton;
+		Uint32 phase_count = 16;
+
+		Bool operator==(JitterSequenceDesc const&) const = default;
+	};
+
+	//upscalers want base_phase_count * (display / render)^2 phases so that every display pixel receives samples
+	Uint32 GetUpscalerJitterPhaseCount(Uint32 render_width, Uint32 display_width, Uint32 base_phase_count = 8);
+
+	//the generators return subpixel offsets in [-0.5, 0.5)
+	std::vector<Vector2> GenerateHaltonJitter(Uint32 count);
+	std::vector<Vector2> GenerateR2Jitter(Uint32 count);
+	//best candidate sampling on the torus, every prefix of the set is evenly spread. deterministic for a given seed
+	std::vector<Vector2> GenerateBlueNoiseJitter(Uint32 count, Uint32 seed = 0);
+
+	class JitterSequence
+	{
+	public:
+		JitterSequence() { SetDesc(JitterSequenceDesc{}); }
+
+		//regenerates the offsets only if the desc changed
+		void SetDesc(JitterSequenceDesc const& desc);
+		JitterSequenceDesc const& GetDesc() const { return desc; }
+		Uint32 GetPhaseCount() const { return (Uint32)offsets.size(); }
+
+		Vector2 operator[](Uint64 frame_index) const
+		{
+			return offsets[frame_index % offsets.size()];
+		}
+
+	private:
+		JitterSequenceDesc desc{ .phase_count = 0 };
+		std::vector<Vector2> offsets;
+	};
+}
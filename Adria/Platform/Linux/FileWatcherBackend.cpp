@@ -0,0 +1,122 @@
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include "Utilities/FileWatcher.h"
+
+namespace fs = std::filesystem;
+
+namespace adria
+{
+	ADRIA_LOG_CHANNEL(Platform);
+
+	namespace
+	{
+		class InotifyFileWatcherBackend final : public IFileWatcherBackend
+		{
+			static constexpr Uint32 WatchMask = IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_DELETE_SELF;
+
+			struct WatchedDirectory
+			{
+				std::string path;
+				Bool recursive;
+			};
+
+		public:
+			InotifyFileWatcherBackend() : inotify_fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) {}
+			virtual ~InotifyFileWatcherBackend() override
+			{
+				if (inotify_fd >= 0) close(inotify_fd);
+			}
+
+			Bool IsValid() const { return inotify_fd >= 0; }
+
+			virtual Bool AddPathToWatch(std::string const& path, Bool recursive) override
+			{
+				if (!AddWatch(path, recursive)) return false;
+				if (recursive)
+				{
+					std::error_code ec;
+					for (auto& entry : fs::recursive_directory_iterator(path, ec))
+					{
+						if (entry.is_directory() && !AddWatch(entry.path().string(), recursive)) return false;
+					}
+				}
+				return true;
+			}
+
+			virtual void PollChanges(std::vector<std::string>& changed_files) override
+			{
+				alignas(inotify_event) Char buffer[16 * 1024];
+				while (true)
+				{
+					ssize_t const length = read(inotify_fd, buffer, sizeof(buffer));
+					if (length <= 0)
+					{
+						if (length < 0 && errno != EAGAIN && errno != EINTR)
+						{
+							ADRIA_LOG(WARNING, "Reading inotify events failed with errno %d", errno);
+						}
+						break;
+					}
+
+					for (Char const* current = buffer; current < buffer + length;)
+					{
+						inotify_event const* event = reinterpret_cast<inotify_event const*>(current);
+						current += sizeof(inotify_event) + event->len;
+						ProcessEvent(*event, changed_files);
+					}
+				}
+			}
+
+		private:
+			Int inotify_fd;
+			std::unordered_map<Int, WatchedDirectory> watched_directories;
+
+		private:
+			Bool AddWatch(std::string const& path, Bool recursive)
+			{
+				Int const wd = inotify_add_watch(inotify_fd, path.c_str(), WatchMask);
+				if (wd < 0)
+				{
+					ADRIA_LOG(WARNING, "inotify_add_watch failed for %s with errno %d", path.c_str(), errno);
+					return false;
+				}
+				watched_directories[wd] = WatchedDirectory{ .path = path, .recursive = recursive };
+				return true;
+			}
+
+			void ProcessEvent(inotify_event const& event, std::vector<std::string>& changed_files)
+			{
+				if (event.mask & IN_Q_OVERFLOW)
+				{
+					ADRIA_LOG(WARNING, "inotify event queue overflowed, some changes were missed");
+					return;
+				}
+				if (event.mask & IN_IGNORED)
+				{
+					watched_directories.erase(event.wd);
+					return;
+				}
+
+				auto it = watched_directories.find(event.wd);
+				if (it == watched_directories.end() || event.len == 0) return;
+
+				WatchedDirectory const directory = it->second;
+				std::string const path = (fs::path(directory.path) / event.name).string();
+				if (event.mask & IN_ISDIR)
+				{
+					if (directory.recursive && (event.mask & (IN_CREATE | IN_MOVED_TO))) AddPathToWatch(path, true);
+					return;
+				}
+				changed_files.push_back(path);
+			}
+		};
+	}
+
+	std::unique_ptr<IFileWatcherBackend> CreatePlatformFileWatcherBackend()
+	{
+		std::unique_ptr<InotifyFileWatcherBackend> backend = std::make_unique<InotifyFileWatcherBackend>();
+		if (!backend->IsValid()) return nullptr;
+		return backend;
+	}
+}
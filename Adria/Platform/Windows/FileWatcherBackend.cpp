@@ -0,0 +1,115 @@
+#include "Windows.h"
+#include "Utilities/FileWatcher.h"
+#include "Utilities/StringConversions.h"
+
+namespace adria
+{
+	ADRIA_LOG_CHANNEL(Platform);
+
+	namespace
+	{
+		class Win32FileWatcherBackend final : public IFileWatcherBackend
+		{
+			static constexpr Uint32 NotifyBufferSize = 64 * 1024;
+			static constexpr DWORD NotifyFilter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_CREATION;
+
+			struct WatchedDirectory
+			{
+				std::string path;
+				Bool recursive = true;
+				HANDLE handle = INVALID_HANDLE_VALUE;
+				OVERLAPPED overlapped{};
+				alignas(DWORD) Uint8 buffer[NotifyBufferSize];
+			};
+
+		public:
+			virtual ~Win32FileWatcherBackend() override
+			{
+				for (std::unique_ptr<WatchedDirectory>& directory : directories)
+				{
+					CancelIoEx(directory->handle, &directory->overlapped);
+					DWORD bytes_transferred = 0;
+					GetOverlappedResult(directory->handle, &directory->overlapped, &bytes_transferred, TRUE);
+					CloseHandle(directory->overlapped.hEvent);
+					CloseHandle(directory->handle);
+				}
+			}
+
+			virtual Bool AddPathToWatch(std::string const& path, Bool recursive) override
+			{
+				std::wstring const wide_path = ToWideString(path);
+				HANDLE handle = CreateFileW(wide_path.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+											nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+				if (handle == INVALID_HANDLE_VALUE) return false;
+
+				std::unique_ptr<WatchedDirectory> directory = std::make_unique<WatchedDirectory>();
+				directory->path = path;
+				directory->recursive = recursive;
+				directory->handle = handle;
+				directory->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+				if (!directory->overlapped.hEvent || !IssueRead(*directory))
+				{
+					if (directory->overlapped.hEvent) CloseHandle(directory->overlapped.hEvent);
+					CloseHandle(handle);
+					return false;
+				}
+				directories.push_back(std::move(directory));
+				return true;
+			}
+
+			virtual void PollChanges(std::vector<std::string>& changed_files) override
+			{
+				for (std::unique_ptr<WatchedDirectory>& directory : directories)
+				{
+					DWORD bytes_transferred = 0;
+					if (!GetOverlappedResult(directory->handle, &directory->overlapped, &bytes_transferred, FALSE))
+					{
+						continue;
+					}
+
+					if (bytes_transferred == 0)
+					{
+						ADRIA_LOG(WARNING, "File change notifications for %s overflowed, some changes were missed", directory->path.c_str());
+					}
+					else
+					{
+						ParseNotifications(*directory, changed_files);
+					}
+					ResetEvent(directory->overlapped.hEvent);
+					IssueRead(*directory);
+				}
+			}
+
+		private:
+			std::vector<std::unique_ptr<WatchedDirectory>> directories;
+
+		private:
+			static Bool IssueRead(WatchedDirectory& directory)
+			{
+				return ReadDirectoryChangesW(directory.handle, directory.buffer, NotifyBufferSize, directory.recursive,
+											 NotifyFilter, nullptr, &directory.overlapped, nullptr);
+			}
+
+			static void ParseNotifications(WatchedDirectory const& directory, std::vector<std::string>& changed_files)
+			{
+				Uint8 const* current = directory.buffer;
+				while (true)
+				{
+					FILE_NOTIFY_INFORMATION const* info = reinterpret_cast<FILE_NOTIFY_INFORMATION const*>(current);
+					if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+					{
+						std::wstring const relative_path(info->FileName, info->FileNameLength / sizeof(WCHAR));
+						changed_files.push_back((std::filesystem::path(directory.path) / relative_path).string());
+					}
+					if (info->NextEntryOffset == 0) break;
+					current += info->NextEntryOffset;
+				}
+			}
+		};
+	}
+
+	std::unique_ptr<IFileWatcherBackend> CreatePlatformFileWatcherBackend()
+	{
+		return std::make_unique<Win32FileWatcherBackend>();
+	}
+}
@@ -0,0 +1,29 @@
+#include "Windows.h"
+#include "Utilities/StringConversions.h"
+
+namespace adria
+{
+	//utf-8 <-> utf-16 goes through the win32 api, the rest of the string helpers are platform independent
+	std::wstring ToWideString(std::string const& str)
+	{
+		Int num_chars = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), (Int)str.length(), NULL, 0);
+		std::wstring wstr;
+		if (num_chars)
+		{
+			wstr.resize(num_chars);
+			MultiByteToWideChar(CP_UTF8, 0, str.c_str(), (Int)str.length(), &wstr[0], num_chars);
+		}
+		return wstr;
+	}
+	std::string ToString(std::wstring const& wstr)
+	{
+		Int num_chars = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), (Int)wstr.length(), NULL, 0, NULL, NULL);
+		std::string str;
+		if (num_chars > 0)
+		{
+			str.resize(num_chars);
+			WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), (Int)wstr.length(), &str[0], num_chars, NULL, NULL);
+		}
+		return str;
+	}
+}
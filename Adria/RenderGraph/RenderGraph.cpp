@@ -1,18 +1,11 @@
 #include "RenderGraph.h"
 #include "Graphics/GfxCommandList.h"
-#include "Graphics/GfxRenderPass.h"
-#include "Graphics/GfxScopedEvent.h"
 #include "Graphics/GfxTracyProfiler.h"
 #include "Core/Paths.h"
 #include "Core/ConsoleManager.h"
 #include "Utilities/StringConversions.h"
 #include "Utilities/PathHelpers.h"
-
-#if GFX_MULTITHREADED
-#define RG_MULTITHREADED 1
-#else
-#define RG_MULTITHREADED 0
-#endif
+#include "Utilities/Json.h"
 
 namespace adria
 {
@@ -128,6 +121,7 @@ namespace adria
 	void RenderGraph::Compile()
 	{
 		ZoneScopedN("RenderGraph::Compile");
+		use_async_compute = GFX_ASYNC_COMPUTE && RGAsyncCompute.Get();
 		BuildAdjacencyLists();
 		TopologicalSort();
 		if (g_UseDependencyLevels)
@@ -155,45 +149,11 @@ namespace adria
 
 		if (g_DumpRenderGraph)
 		{
+			DumpJson("rendergraph.json");
 			Dump("rendergraph.gv");
 		}
 	}
 
-	void RenderGraph::Execute()
-	{
-		ZoneScopedN("RenderGraph::Execute");
-#if RG_MULTITHREADED
-		Execute_Multithreaded();
-#else
-		Execute_Singlethreaded();
-#endif
-	}
-
-	void RenderGraph::Execute_Singlethreaded()
-	{
-		pool.Tick();
-
-		RenderGraphExecutionContext exec_ctx{};
-		exec_ctx.gfx = gfx;
-		exec_ctx.graphics_cmd_list = gfx->GetGraphicsCommandList();
-		exec_ctx.compute_cmd_list = gfx->GetComputeCommandList();
-		exec_ctx.graphics_fence = &gfx->GetGraphicsFence();
-		exec_ctx.compute_fence = &gfx->GetComputeFence();
-		exec_ctx.graphics_fence_value = gfx->GetGraphicsFenceValue();
-		exec_ctx.compute_fence_value = gfx->GetComputeFenceValue();
-
-		for (Uint64 i = 0; i < dependency_levels.size(); ++i)
-		{
-			DependencyLevel& dependency_level = dependency_levels[i];
-			dependency_level.Execute(exec_ctx);
-		}
-	}
-
-	void RenderGraph::Execute_Multithreaded()
-	{
-		ADRIA_ASSERT_MSG(false, "Not yet implemented!");
-	}
-
 	void RenderGraph::AddExportBufferCopyPass(RGResourceName export_buffer, GfxBuffer* buffer)
 	{
 #if RG_DEBUG
@@ -475,7 +435,7 @@ namespace adria
 				textures[i]->last_used_by->texture_destroys.insert(RGTextureId(i));
 			}
 
-			if (textures[i]->imported)
+			if (textures[i]->imported && gfx)
 			{
 				CreateTextureViews(RGTextureId(i));
 			}
@@ -487,7 +447,7 @@ namespace adria
 				buffers[i]->last_used_by->buffer_destroys.insert(RGBufferId(i));
 			}
 
-			if (buffers[i]->imported)
+			if (buffers[i]->imported && gfx)
 			{
 				CreateBufferViews(RGBufferId(i));
 			}
@@ -510,7 +470,7 @@ namespace adria
 	void RenderGraph::ResolveAsync()
 	{
 #if GFX_ASYNC_COMPUTE
-		if (!RGAsyncCompute.Get())
+		if (!use_async_compute)
 		{
 			return;
 		}
@@ -1168,362 +1128,88 @@ namespace adria
 				buffer_state_map[resource] |= state;
 			}
 		}
-	}
-
-	void RenderGraph::DependencyLevel::Execute(RenderGraphExecutionContext const& exec_ctx)
-	{
-		PreExecute(exec_ctx.graphics_cmd_list);
-		for (auto& pass : passes)
-		{
-			if (pass->IsCulled())
-			{
-				continue;
-			}
-
-#if GFX_ASYNC_COMPUTE
-			GfxCommandList* cmd_list = pass->type == RGPassType::AsyncCompute && RGAsyncCompute.Get() ? exec_ctx.compute_cmd_list : exec_ctx.graphics_cmd_list;
-#else
-			GfxCommandList* cmd_list = exec_ctx.graphics_cmd_list;
-#endif
-			if (pass->wait_value != UINT64_MAX)
-			{
-				cmd_list->End();
-				cmd_list->Submit();
-				cmd_list->Begin();
-				if (pass->type == RGPassType::AsyncCompute)
-				{
-					cmd_list->Wait(*exec_ctx.graphics_fence, exec_ctx.graphics_fence_value + pass->wait_value);
-				}
-				else
-				{
-					cmd_list->Wait(*exec_ctx.compute_fence, exec_ctx.compute_fence_value + pass->wait_value);
-				}
-			}
-
-			for (Uint32 event_idx : pass->events_to_start)
-			{
-				cmd_list->BeginEvent(rg.events[event_idx].name, GfxEventColor(0x5E, 0xC4, 0xFF));
-			}
-
-			RenderGraphContext render_graph_ctx(rg, *pass, cmd_list);
-			if (pass->type == RGPassType::Graphics)
-			{
-				GfxRenderPassDesc render_pass_desc{};
-				render_pass_desc.flags = GfxRenderPassFlagBit_None;
-				render_pass_desc.rtv_attachments.reserve(pass->render_targets_info.size());
-				for (auto const& render_target_info : pass->render_targets_info)
-				{
-					GfxColorAttachmentDesc rtv_desc{};
-
-					RGLoadAccessOp load_access = RGLoadAccessOp::NoAccess;
-					RGStoreAccessOp store_access = RGStoreAccessOp::NoAccess;
-					SplitAccessOp(render_target_info.render_target_access, load_access, store_access);
-
-					switch (load_access)
-					{
-					case RGLoadAccessOp::Clear:
-						rtv_desc.beginning_access = GfxLoadAccessOp::Clear;
-						break;
-					case RGLoadAccessOp::Discard:
-						rtv_desc.beginning_access = GfxLoadAccessOp::Discard;
-						break;
-					case RGLoadAccessOp::Preserve:
-						rtv_desc.beginning_access = GfxLoadAccessOp::Preserve;
-						break;
-					case RGLoadAccessOp::NoAccess:
-						rtv_desc.beginning_access = GfxLoadAccessOp::NoAccess;
-						break;
-					default:
-						ADRIA_ASSERT_MSG(false, "Invalid Load Access!");
-					}
-
-					switch (store_access)
-					{
-					case RGStoreAccessOp::Resolve:
-						rtv_desc.ending_access = GfxStoreAccessOp::Resolve;
-						break;
-					case RGStoreAccessOp::Discard:
-						rtv_desc.ending_access = GfxStoreAccessOp::Discard;
-						break;
-					case RGStoreAccessOp::Preserve:
-						rtv_desc.ending_access = GfxStoreAccessOp::Preserve;
-						break;
-					case RGStoreAccessOp::NoAccess:
-						rtv_desc.ending_access = GfxStoreAccessOp::NoAccess;
-						break;
-					default:
-						ADRIA_ASSERT_MSG(false, "Invalid Store Access!");
-					}
-
-					RGTextureId rt_texture = render_target_info.render_target_handle.GetResourceId();
-					GfxTexture* texture = rg.GetTexture(rt_texture);
-
-					GfxTextureDesc const& desc = texture->GetDesc();
-					GfxClearValue const& clear_value = desc.clear_value;
-					if (clear_value.active_member != GfxClearValue::GfxActiveMember::None)
-					{
-						ADRIA_ASSERT_MSG(clear_value.active_member == GfxClearValue::GfxActiveMember::Color, "Invalid Clear Value for Render Target");
-						rtv_desc.clear_value = desc.clear_value;
-						rtv_desc.clear_value.format = desc.format;
-					}
-					else if(rtv_desc.beginning_access == GfxLoadAccessOp::Clear)
-					{
-						rtv_desc.clear_value.format = desc.format;
-						rtv_desc.clear_value = GfxClearValue(0.0f, 0.0f, 0.0f, 0.0f);
-					}
-
-					rtv_desc.cpu_handle = rg.GetRenderTarget(render_target_info.render_target_handle);
-					render_pass_desc.rtv_attachments.push_back(rtv_desc);
-				}
-
-				if (pass->depth_stencil.has_value())
-				{
-					auto const& depth_stencil_info = pass->depth_stencil.value();
-					if (depth_stencil_info.depth_read_only)
-					{
-						render_pass_desc.flags |= GfxRenderPassFlagBit_ReadOnlyDepth;
-					}
-					
-					GfxDepthAttachmentDesc dsv_desc{};
-					RGLoadAccessOp load_access = RGLoadAccessOp::NoAccess;
-					RGStoreAccessOp store_access = RGStoreAccessOp::NoAccess;
-					SplitAccessOp(depth_stencil_info.depth_access, load_access, store_access);
-
-					switch (load_access)
-					{
-					case RGLoadAccessOp::Clear:
-						dsv_desc.depth_beginning_access = GfxLoadAccessOp::Clear;
-						break;
-					case RGLoadAccessOp::Discard:
-						dsv_desc.depth_beginning_access = GfxLoadAccessOp::Discard;
-						break;
-					case RGLoadAccessOp::Preserve:
-						dsv_desc.depth_beginning_access = GfxLoadAccessOp::Preserve;
-						break;
-					case RGLoadAccessOp::NoAccess:
-						dsv_desc.depth_beginning_access = GfxLoadAccessOp::NoAccess;
-						break;
-					default:
-						ADRIA_ASSERT_MSG(false, "Invalid Load Access!");
-					}
-
-					switch (store_access)
-					{
-					case RGStoreAccessOp::Resolve:
-						dsv_desc.depth_ending_access = GfxStoreAccessOp::Resolve;
-						break;
-					case RGStoreAccessOp::Discard:
-						dsv_desc.depth_ending_access = GfxStoreAccessOp::Discard;
-						break;
-					case RGStoreAccessOp::Preserve:
-						dsv_desc.depth_ending_access = GfxStoreAccessOp::Preserve;
-						break;
-					case RGStoreAccessOp::NoAccess:
-						dsv_desc.depth_ending_access = GfxStoreAccessOp::NoAccess;
-						break;
-					default:
-						ADRIA_ASSERT_MSG(false, "Invalid Store Access!");
-					}
-
-					RGTextureId ds_texture = depth_stencil_info.depth_stencil_handle.GetResourceId();
-					GfxTexture* texture = rg.GetTexture(ds_texture);
-
-					GfxTextureDesc const& desc = texture->GetDesc();
-					if (desc.clear_value.active_member != GfxClearValue::GfxActiveMember::None)
-					{
-						ADRIA_ASSERT_MSG(desc.clear_value.active_member == GfxClearValue::GfxActiveMember::DepthStencil, "Invalid Clear Value for Depth Stencil");
-						dsv_desc.clear_value = desc.clear_value;
-						dsv_desc.clear_value.format = desc.format;
-					}
-					else if (dsv_desc.depth_beginning_access == GfxLoadAccessOp::Clear)
-					{
-						dsv_desc.clear_value.format = desc.format;
-						dsv_desc.clear_value = GfxClearValue(0.0f, 0);
-					}
-
-					dsv_desc.cpu_handle = rg.GetDepthStencil(depth_stencil_info.depth_stencil_handle);
-
-					ADRIA_TODO("Add Stencil Support");
-					render_pass_desc.dsv_attachment = dsv_desc;
-				}
-				ADRIA_ASSERT_MSG((pass->viewport_width != 0 && pass->viewport_height != 0), "Viewport Width/Height is 0! The call to builder.SetViewport is probably missing...");
-				render_pass_desc.width = pass->viewport_width;
-				render_pass_desc.height = pass->viewport_height;
-				render_pass_desc.legacy = pass->UseLegacyRenderPasses();
-
-				ZoneTransientN(__tracy, pass->name.c_str(), true);
-				AdriaGfxScopedEvent(cmd_list, pass->name.c_str());
-				TracyGfxProfileScope(cmd_list->GetNative(), pass->name.c_str());
-				cmd_list->SetContext(GfxCommandList::Context::Graphics);
-				cmd_list->BeginRenderPass(render_pass_desc);
-				pass->Execute(render_graph_ctx);
-				cmd_list->EndRenderPass();
-			}
-			else
-			{
-				ZoneTransientN(__tracy, pass->name.c_str(), true);
-				AdriaGfxScopedEvent(cmd_list, pass->name.c_str());
-				TracyGfxProfileScope(cmd_list->GetNative(), pass->name.c_str());
-				cmd_list->SetContext(GfxCommandList::Context::Compute);
-				pass->Execute(render_graph_ctx);
-			}
-
-			for (Uint32 i = 0; i < pass->num_events_to_end; ++i)
-			{
-				cmd_list->EndEvent();
-			}
-
-			if (pass->signal_value != UINT64_MAX)
-			{
-				cmd_list->End();
-				if (pass->type == RGPassType::AsyncCompute)
-				{
-					cmd_list->Signal(*exec_ctx.compute_fence, exec_ctx.compute_fence_value + pass->signal_value);
-					exec_ctx.gfx->SetComputeFenceValue(exec_ctx.compute_fence_value + pass->signal_value);
-				}
-				else
-				{
-					cmd_list->Signal(*exec_ctx.graphics_fence, exec_ctx.graphics_fence_value + pass->signal_value);
-					exec_ctx.gfx->SetGraphicsFenceValue(exec_ctx.graphics_fence_value + pass->signal_value);
-				}
-				cmd_list->Submit();
-				cmd_list->Begin();
-			}
-		} 
-		PostExecute(exec_ctx.graphics_cmd_list);
-	}
-
-	void RenderGraph::DependencyLevel::PreExecute(GfxCommandList* cmd_list)
-	{
-		for (RGTextureId tex_id : texture_creates)
-		{
-			RGTexture* rg_texture = rg.GetRGTexture(tex_id);
-			if (!rg_texture->imported)
-			{
-				rg_texture->resource = rg.pool.AllocateTexture(rg_texture->desc);
-			}
-			rg.CreateTextureViews(tex_id);
-			rg_texture->SetName();
-		}
-		for (RGBufferId buf_id : buffer_creates)
-		{
-			RGBuffer* rg_buffer = rg.GetRGBuffer(buf_id);
-			if (!rg_buffer->imported)
-			{
-				rg_buffer->resource = rg.pool.AllocateBuffer(rg_buffer->desc);
-			}
-			rg.CreateBufferViews(buf_id);
-			rg_buffer->SetName();
-		}
 
+		//levels are set up in order so the state maps of the previous levels are final
 		for (auto const& [tex_id, state] : texture_state_map)
 		{
 			RGTexture* rg_texture = rg.GetRGTexture(tex_id);
-			GfxTexture* texture = rg_texture->resource;
+			GfxResourceState const initial_state = rg_texture->desc.initial_state;
 			if (texture_creates.contains(tex_id))
 			{
-				if (!HasFlag(texture->GetDesc().initial_state, state))
+				if (!HasAnyFlag(initial_state, state))
 				{
-					cmd_list->TextureBarrier(*texture, texture->GetDesc().initial_state, state);
+					texture_begin_transitions.push_back({ tex_id, initial_state, state });
 				}
 				continue;
 			}
-			Bool found = false;
-			for (Int32 j = (Int32)level_index - 1; j >= 0; --j)
+			std::optional<GfxResourceState> prev_state;
+			for (Int32 j = (Int32)level_index - 1; j >= 0 && !prev_state; --j)
 			{
-				auto& prev_dependency_level = rg.dependency_levels[j];
-				if (prev_dependency_level.texture_state_map.contains(tex_id))
-				{
-					GfxResourceState prev_state = prev_dependency_level.texture_state_map[tex_id];
-					if (prev_state != state)
-					{
-						cmd_list->TextureBarrier(*texture, prev_state, state);
-					}
-					found = true;
-					break;
-				}
+				auto const& prev_state_map = rg.dependency_levels[j].texture_state_map;
+				if (auto it = prev_state_map.find(tex_id); it != prev_state_map.end()) prev_state = it->second;
 			}
-			if (!found && rg_texture->imported)
+			if (!prev_state && rg_texture->imported)
 			{
-				GfxResourceState prev_state = rg_texture->desc.initial_state;
-				if (prev_state != state)
-				{
-					cmd_list->TextureBarrier(*texture, prev_state, state);
-				}
+				prev_state = initial_state;
+			}
+			if (prev_state && *prev_state != state)
+			{
+				texture_begin_transitions.push_back({ tex_id, *prev_state, state });
 			}
 		}
 		for (auto const& [buf_id, state] : buffer_state_map)
 		{
 			RGBuffer* rg_buffer = rg.GetRGBuffer(buf_id);
-			GfxBuffer* buffer = rg_buffer->resource;
 			if (buffer_creates.contains(buf_id))
 			{
 				if (state != GfxResourceState::Common)
 				{
-					cmd_list->BufferBarrier(*buffer, GfxResourceState::Common, state);
+					buffer_begin_transitions.push_back({ buf_id, GfxResourceState::Common, state });
 				}
 				continue;
 			}
-			Bool found = false;
-			for (Int32 j = (Int32)level_index - 1; j >= 0; --j)
+			std::optional<GfxResourceState> prev_state;
+			for (Int32 j = (Int32)level_index - 1; j >= 0 && !prev_state; --j)
 			{
-				auto& prev_dependency_level = rg.dependency_levels[j];
-				if (prev_dependency_level.buffer_state_map.contains(buf_id))
-				{
-					GfxResourceState prev_state = prev_dependency_level.buffer_state_map[buf_id];
-					if (prev_state != state)
-					{
-						cmd_list->BufferBarrier(*buffer, prev_state, state);
-					}
-					found = true;
-					break;
-				}
+				auto const& prev_state_map = rg.dependency_levels[j].buffer_state_map;
+				if (auto it = prev_state_map.find(buf_id); it != prev_state_map.end()) prev_state = it->second;
 			}
-			if (!found && rg_buffer->imported)
+			if (!prev_state && rg_buffer->imported)
 			{
-				if (GfxResourceState::Common != state)
-				{
-					cmd_list->BufferBarrier(*buffer, GfxResourceState::Common, state);
-				}
+				prev_state = GfxResourceState::Common;
+			}
+			if (prev_state && *prev_state != state)
+			{
+				buffer_begin_transitions.push_back({ buf_id, *prev_state, state });
 			}
 		}
-		cmd_list->FlushBarriers();
-	}
 
-	void RenderGraph::DependencyLevel::PostExecute(GfxCommandList* cmd_list)
-	{
 		for (RGTextureId tex_id : texture_destroys)
 		{
-			RGTexture* rg_texture = rg.GetRGTexture(tex_id);
-			GfxTexture* texture = rg_texture->resource;
-			GfxResourceState initial_state = texture->GetDesc().initial_state;
 			ADRIA_ASSERT(texture_state_map.contains(tex_id));
-			GfxResourceState state = texture_state_map[tex_id];
+			GfxResourceState const initial_state = rg.GetRGTexture(tex_id)->desc.initial_state;
+			GfxResourceState const state = texture_state_map[tex_id];
 			if (initial_state != state)
 			{
-				cmd_list->TextureBarrier(*texture, state, initial_state);
-			}
-			if (!rg_texture->imported)
-			{
-				rg.pool.ReleaseTexture(rg_texture->resource);
+				texture_end_transitions.push_back({ tex_id, state, initial_state });
 			}
 		}
 		for (RGBufferId buf_id : buffer_destroys)
 		{
-			RGBuffer* rg_buffer = rg.GetRGBuffer(buf_id);
-			GfxBuffer* buffer = rg_buffer->resource;
 			ADRIA_ASSERT(buffer_state_map.contains(buf_id));
-			GfxResourceState state = buffer_state_map[buf_id];
+			GfxResourceState const state = buffer_state_map[buf_id];
 			if (state != GfxResourceState::Common)
 			{
-				cmd_list->BufferBarrier(*buffer, state, GfxResourceState::Common);
-			}
-			if (!rg_buffer->imported)
-			{
-				rg.pool.ReleaseBuffer(rg_buffer->resource);
+				buffer_end_transitions.push_back({ buf_id, state, GfxResourceState::Common });
 			}
 		}
-		cmd_list->FlushBarriers();
+
+		//the order of the barriers doesn't matter, sorting keeps the exported graph stable
+		auto ByResource = [](auto const& lhs, auto const& rhs) { return lhs.resource.id < rhs.resource.id; };
+		std::sort(texture_begin_transitions.begin(), texture_begin_transitions.end(), ByResource);
+		std::sort(texture_end_transitions.begin(), texture_end_transitions.end(), ByResource);
+		std::sort(buffer_begin_transitions.begin(), buffer_begin_transitions.end(), ByResource);
+		std::sort(buffer_end_transitions.begin(), buffer_end_transitions.end(), ByResource);
 	}
 
 	void RenderGraph::PushEvent(Char const* name)
@@ -1700,6 +1386,234 @@ namespace adria
 		system(cmd.c_str());
 	}
 
+	void RenderGraph::DumpJson(Char const* json_file_name)
+	{
+		//only compile time data is exported so graphs compiled without a device can be inspected too
+		auto PassFlagsToJson = [](RGPassFlags flags)
+			{
+				json flag_array = json::array();
+				if (HasFlag(flags, RGPassFlags::ForceNoCull))	   flag_array.push_back("ForceNoCull");
+				if (HasFlag(flags, RGPassFlags::LegacyRenderPass)) flag_array.push_back("LegacyRenderPass");
+				return flag_array;
+			};
+		auto GetPassQueue = [this](RGPassBase const* pass)
+			{
+				return pass->type == RGPassType::AsyncCompute && use_async_compute ? "Compute" : "Graphics";
+			};
+		auto DescriptorTypeToString = [](RGDescriptorType type)
+			{
+				switch (type)
+				{
+				case RGDescriptorType::ReadOnly: return "ReadOnly";
+				case RGDescriptorType::ReadWrite: return "ReadWrite";
+				case RGDescriptorType::RenderTarget: return "RenderTarget";
+				case RGDescriptorType::DepthStencil: return "DepthStencil";
+				}
+				return "Invalid";
+			};
+		auto GetTextureMemorySize = [](GfxTextureDesc const& desc)
+			{
+				Uint32 const height = std::max(desc.height, 1u);
+				Uint32 const depth = desc.type == GfxTextureType_3D ? std::max(desc.depth, 1u) : 1u;
+				Uint32 const mip_levels = desc.mip_levels != 0 ? desc.mip_levels : (Uint32)std::bit_width(std::max({ desc.width, height, depth }));
+				return GetTextureByteSize(desc.format, desc.width, height, depth, mip_levels) * std::max(desc.array_size, 1u) * std::max(desc.sample_count, 1u);
+			};
+		auto SortedIds = []<typename IdType>(std::unordered_set<IdType> const& id_set)
+			{
+				std::vector<Uint64> ids;
+				ids.reserve(id_set.size());
+				for (IdType id : id_set) ids.push_back(id.id);
+				std::sort(ids.begin(), ids.end());
+				return ids;
+			};
+		auto OptionalValue = [](Uint64 value) { return value != UINT64_MAX ? json(value) : json(nullptr); };
+
+		std::vector<Uint64> execution_indices(passes.size(), UINT64_MAX);
+		std::vector<Uint32> pass_levels(passes.size(), 0);
+		std::vector<std::pair<Uint64, Uint64>> texture_uses(textures.size(), { UINT64_MAX, UINT64_MAX });
+		std::vector<std::pair<Uint64, Uint64>> buffer_uses(buffers.size(), { UINT64_MAX, UINT64_MAX });
+		Uint64 execution_index = 0;
+		for (DependencyLevel const& dependency_level : dependency_levels)
+		{
+			for (RGPassBase* pass : dependency_level.passes)
+			{
+				pass_levels[pass->id] = dependency_level.level_index;
+				if (pass->IsCulled())
+				{
+					continue;
+				}
+				execution_indices[pass->id] = execution_index++;
+				for (auto const& [tex_id, state] : pass->texture_state_map)
+				{
+					auto& [first_use, last_use] = texture_uses[tex_id.id];
+					if (first_use == UINT64_MAX) first_use = pass->id;
+					last_use = pass->id;
+				}
+				for (auto const& [buf_id, state] : pass->buffer_state_map)
+				{
+					auto& [first_use, last_use] = buffer_uses[buf_id.id];
+					if (first_use == UINT64_MAX) first_use = pass->id;
+					last_use = pass->id;
+				}
+			}
+		}
+
+		json pass_array = json::array();
+		for (RGPassBase* pass : passes)
+		{
+			std::vector<Uint64> dependencies = adjacency_lists[pass->id];
+			std::sort(dependencies.begin(), dependencies.end());
+			pass_array.push_back({
+				{ "id", pass->id },
+				{ "name", pass->name },
+				{ "type", RGPassTypeToString(pass->type) },
+				{ "flags", PassFlagsToJson(pass->flags) },
+				{ "culled", pass->IsCulled() },
+				{ "ref_count", pass->ref_count },
+				{ "dependency_level", pass_levels[pass->id] },
+				{ "execution_index", OptionalValue(execution_indices[pass->id]) },
+				{ "queue", GetPassQueue(pass) },
+				{ "successors", std::move(dependencies) },
+				{ "texture_reads", SortedIds(pass->texture_reads) },
+				{ "texture_writes", SortedIds(pass->texture_writes) },
+				{ "texture_creates", SortedIds(pass->texture_creates) },
+				{ "texture_destroys", SortedIds(pass->texture_destroys) },
+				{ "buffer_reads", SortedIds(pass->buffer_reads) },
+				{ "buffer_writes", SortedIds(pass->buffer_writes) },
+				{ "buffer_creates", SortedIds(pass->buffer_creates) },
+				{ "buffer_destroys", SortedIds(pass->buffer_destroys) },
+				{ "wait_value", OptionalValue(pass->wait_value) },
+				{ "signal_value", OptionalValue(pass->signal_value) }
+			});
+		}
+
+		auto LifetimeToJson = [&](std::pair<Uint64, Uint64> const& uses)
+			{
+				if (uses.first == UINT64_MAX) return json(nullptr);
+				return json{ { "first_use", uses.first }, { "last_use", uses.second },
+							 { "begin", execution_indices[uses.first] }, { "end", execution_indices[uses.second] } };
+			};
+
+		json texture_array = json::array();
+		for (auto const& texture : textures)
+		{
+			GfxTextureDesc const& desc = texture->desc;
+			json views = json::array();
+			if (auto it = texture_view_desc_map.find(RGTextureId(texture->id)); it != texture_view_desc_map.end())
+			{
+				for (auto const& [view_desc, type] : it->second)
+				{
+					views.push_back({
+						{ "type", DescriptorTypeToString(type) },
+						{ "first_mip", view_desc.first_mip }, { "mip_count", view_desc.mip_count },
+						{ "first_slice", view_desc.first_slice }, { "slice_count", view_desc.slice_count }
+					});
+				}
+			}
+			texture_array.push_back({
+				{ "id", texture->id },
+				{ "name", texture->name },
+				{ "imported", texture->imported },
+				{ "ref_count", texture->ref_count },
+				{ "writer", texture->writer ? json(texture->writer->id) : json(nullptr) },
+				{ "desc", {
+					{ "type", GfxTextureTypeToString(desc.type) },
+					{ "width", desc.width }, { "height", desc.height }, { "depth", desc.depth },
+					{ "array_size", desc.array_size }, { "mip_levels", desc.mip_levels }, { "sample_count", desc.sample_count },
+					{ "format", GfxFormatToString(desc.format) },
+					{ "initial_state", ConvertBarrierFlagsToString(desc.initial_state) }
+				} },
+				{ "size", GetTextureMemorySize(desc) },
+				{ "views", std::move(views) },
+				{ "lifetime", LifetimeToJson(texture_uses[texture->id]) }
+			});
+		}
+
+		json buffer_array = json::array();
+		for (auto const& buffer : buffers)
+		{
+			GfxBufferDesc const& desc = buffer->desc;
+			json views = json::array();
+			if (auto it = buffer_view_desc_map.find(RGBufferId(buffer->id)); it != buffer_view_desc_map.end())
+			{
+				for (auto const& [view_desc, type] : it->second)
+				{
+					views.push_back({ { "type", DescriptorTypeToString(type) }, { "offset", view_desc.offset }, { "size", view_desc.size } });
+				}
+			}
+			buffer_array.push_back({
+				{ "id", buffer->id },
+				{ "name", buffer->name },
+				{ "imported", buffer->imported },
+				{ "ref_count", buffer->ref_count },
+				{ "writer", buffer->writer ? json(buffer->writer->id) : json(nullptr) },
+				{ "desc", {
+					{ "size", desc.size }, { "stride", desc.stride },
+					{ "format", GfxFormatToString(desc.format) }
+				} },
+				{ "size", desc.size },
+				{ "views", std::move(views) },
+				{ "lifetime", LifetimeToJson(buffer_uses[buffer->id]) }
+			});
+		}
+
+		//the transitions DependencyLevel::Setup computed, PreExecute records the Begin ones and PostExecute the End ones
+		auto BarrierToJson = [](Char const* resource_type, RGResourceId resource_id, Char const* resource_name, GfxResourceState before, GfxResourceState after, Char const* stage)
+			{
+				return json{
+					{ "resource_type", resource_type },
+					{ "resource", resource_id.id },
+					{ "name", resource_name },
+					{ "before", ConvertBarrierFlagsToString(before) },
+					{ "after", ConvertBarrierFlagsToString(after) },
+					{ "stage", stage }
+				};
+			};
+
+		json level_array = json::array();
+		for (DependencyLevel const& dependency_level : dependency_levels)
+		{
+			std::vector<Uint64> level_passes;
+			for (RGPassBase* pass : dependency_level.passes) level_passes.push_back(pass->id);
+			json barrier_array = json::array();
+			for (auto const& transition : dependency_level.texture_begin_transitions)
+			{
+				barrier_array.push_back(BarrierToJson("Texture", transition.resource, GetRGTexture(transition.resource)->name, transition.before, transition.after, "Begin"));
+			}
+			for (auto const& transition : dependency_level.buffer_begin_transitions)
+			{
+				barrier_array.push_back(BarrierToJson("Buffer", transition.resource, GetRGBuffer(transition.resource)->name, transition.before, transition.after, "Begin"));
+			}
+			for (auto const& transition : dependency_level.texture_end_transitions)
+			{
+				barrier_array.push_back(BarrierToJson("Texture", transition.resource, GetRGTexture(transition.resource)->name, transition.before, transition.after, "End"));
+			}
+			for (auto const& transition : dependency_level.buffer_end_transitions)
+			{
+				barrier_array.push_back(BarrierToJson("Buffer", transition.resource, GetRGBuffer(transition.resource)->name, transition.before, transition.after, "End"));
+			}
+			level_array.push_back({ { "index", dependency_level.level_index }, { "passes", std::move(level_passes) }, { "barriers", std::move(barrier_array) } });
+		}
+
+		json render_graph = {
+			{ "version", 2 },
+			{ "culling", RGCullPasses.Get() },
+			{ "dependency_levels", std::move(level_array) },
+			{ "passes", std::move(pass_array) },
+			{ "textures", std::move(texture_array) },
+			{ "buffers", std::move(buffer_array) }
+		};
+
+		std::string absolute_json_path = std::filesystem::path(json_file_name).is_absolute() ? json_file_name : paths::RenderGraphDir + json_file_name;
+		std::ofstream json_file(absolute_json_path);
+		if (!json_file)
+		{
+			ADRIA_LOG(WARNING, "Could not open %s for writing the render graph!", absolute_json_path.c_str());
+			return;
+		}
+		json_file << render_graph.dump(4);
+	}
+
 	void RenderGraph::DumpDebugData()
 	{
 		std::string render_graph_data = "";
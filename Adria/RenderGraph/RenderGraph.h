@@ -27,6 +27,17 @@ namespace adria
 		class DependencyLevel
 		{
 			friend RenderGraph;
+
+			template<typename ResourceIdType>
+			struct ResourceTransition
+			{
+				ResourceIdType resource;
+				GfxResourceState before;
+				GfxResourceState after;
+			};
+			using TextureTransition = ResourceTransition<RGTextureId>;
+			using BufferTransition = ResourceTransition<RGBufferId>;
+
 		public:
 
 			DependencyLevel(RenderGraph& rg, Uint32 level_index) : rg(rg), level_index(level_index) {}
@@ -50,6 +61,12 @@ namespace adria
 			std::unordered_set<RGBufferId> buffer_destroys;
 			std::unordered_map<RGBufferId, GfxResourceState> buffer_state_map;
 
+			//computed in Setup, recorded before the passes of the level and after the last use of the resources it destroys
+			std::vector<TextureTransition> texture_begin_transitions;
+			std::vector<TextureTransition> texture_end_transitions;
+			std::vector<BufferTransition>  buffer_begin_transitions;
+			std::vector<BufferTransition>  buffer_end_transitions;
+
 		private:
 			void PreExecute(GfxCommandList*);
 			void PostExecute(GfxCommandList*);
@@ -95,12 +112,15 @@ namespace adria
 		void PopEvent();
 
 		void Dump(Char const* graph_file_name);
+		//passes, resources, lifetimes and barriers of the compiled graph, Tools/analyze_rendergraph.py reads it
+		void DumpJson(Char const* json_file_name);
 		void DumpDebugData();
 
 	private:
 		RGResourcePool& pool;
 		GfxDevice* gfx;
 		RGAllocator allocator;
+		Bool use_async_compute = false;
 		RGBlackboard blackboard;
 
 		std::vector<RGPassBase*> passes;
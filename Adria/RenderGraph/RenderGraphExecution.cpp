@@ -0,0 +1,336 @@
+#include "RenderGraph.h"
+#include "Graphics/GfxCommandList.h"
+#include "Graphics/GfxRenderPass.h"
+#include "Graphics/GfxScopedEvent.h"
+#include "Graphics/GfxTracyProfiler.h"
+
+#if GFX_MULTITHREADED
+#define RG_MULTITHREADED 1
+#else
+#define RG_MULTITHREADED 0
+#endif
+
+namespace adria
+{
+	void RenderGraph::Execute()
+	{
+		ZoneScopedN("RenderGraph::Execute");
+#if RG_MULTITHREADED
+		Execute_Multithreaded();
+#else
+		Execute_Singlethreaded();
+#endif
+	}
+
+	void RenderGraph::Execute_Singlethreaded()
+	{
+		pool.Tick();
+
+		RenderGraphExecutionContext exec_ctx{};
+		exec_ctx.gfx = gfx;
+		exec_ctx.graphics_cmd_list = gfx->GetGraphicsCommandList();
+		exec_ctx.compute_cmd_list = gfx->GetComputeCommandList();
+		exec_ctx.graphics_fence = &gfx->GetGraphicsFence();
+		exec_ctx.compute_fence = &gfx->GetComputeFence();
+		exec_ctx.graphics_fence_value = gfx->GetGraphicsFenceValue();
+		exec_ctx.compute_fence_value = gfx->GetComputeFenceValue();
+
+		for (Uint64 i = 0; i < dependency_levels.size(); ++i)
+		{
+			DependencyLevel& dependency_level = dependency_levels[i];
+			dependency_level.Execute(exec_ctx);
+		}
+	}
+
+	void RenderGraph::Execute_Multithreaded()
+	{
+		ADRIA_ASSERT_MSG(false, "Not yet implemented!");
+	}
+
+	void RenderGraph::DependencyLevel::Execute(RenderGraphExecutionContext const& exec_ctx)
+	{
+		PreExecute(exec_ctx.graphics_cmd_list);
+		for (auto& pass : passes)
+		{
+			if (pass->IsCulled())
+			{
+				continue;
+			}
+
+#if GFX_ASYNC_COMPUTE
+			GfxCommandList* cmd_list = pass->type == RGPassType::AsyncCompute && rg.use_async_compute ? exec_ctx.compute_cmd_list : exec_ctx.graphics_cmd_list;
+#else
+			GfxCommandList* cmd_list = exec_ctx.graphics_cmd_list;
+#endif
+			if (pass->wait_value != UINT64_MAX)
+			{
+				cmd_list->End();
+				cmd_list->Submit();
+				cmd_list->Begin();
+				if (pass->type == RGPassType::AsyncCompute)
+				{
+					cmd_list->Wait(*exec_ctx.graphics_fence, exec_ctx.graphics_fence_value + pass->wait_value);
+				}
+				else
+				{
+					cmd_list->Wait(*exec_ctx.compute_fence, exec_ctx.compute_fence_value + pass->wait_value);
+				}
+			}
+
+			for (Uint32 event_idx : pass->events_to_start)
+			{
+				cmd_list->BeginEvent(rg.events[event_idx].name, GfxEventColor(0x5E, 0xC4, 0xFF));
+			}
+
+			RenderGraphContext render_graph_ctx(rg, *pass, cmd_list);
+			if (pass->type == RGPassType::Graphics)
+			{
+				GfxRenderPassDesc render_pass_desc{};
+				render_pass_desc.flags = GfxRenderPassFlagBit_None;
+				render_pass_desc.rtv_attachments.reserve(pass->render_targets_info.size());
+				for (auto const& render_target_info : pass->render_targets_info)
+				{
+					GfxColorAttachmentDesc rtv_desc{};
+
+					RGLoadAccessOp load_access = RGLoadAccessOp::NoAccess;
+					RGStoreAccessOp store_access = RGStoreAccessOp::NoAccess;
+					SplitAccessOp(render_target_info.render_target_access, load_access, store_access);
+
+					switch (load_access)
+					{
+					case RGLoadAccessOp::Clear:
+						rtv_desc.beginning_access = GfxLoadAccessOp::Clear;
+						break;
+					case RGLoadAccessOp::Discard:
+						rtv_desc.beginning_access = GfxLoadAccessOp::Discard;
+						break;
+					case RGLoadAccessOp::Preserve:
+						rtv_desc.beginning_access = GfxLoadAccessOp::Preserve;
+						break;
+					case RGLoadAccessOp::NoAccess:
+						rtv_desc.beginning_access = GfxLoadAccessOp::NoAccess;
+						break;
+					default:
+						ADRIA_ASSERT_MSG(false, "Invalid Load Access!");
+					}
+
+					switch (store_access)
+					{
+					case RGStoreAccessOp::Resolve:
+						rtv_desc.ending_access = GfxStoreAccessOp::Resolve;
+						break;
+					case RGStoreAccessOp::Discard:
+						rtv_desc.ending_access = GfxStoreAccessOp::Discard;
+						break;
+					case RGStoreAccessOp::Preserve:
+						rtv_desc.ending_access = GfxStoreAccessOp::Preserve;
+						break;
+					case RGStoreAccessOp::NoAccess:
+						rtv_desc.ending_access = GfxStoreAccessOp::NoAccess;
+						break;
+					default:
+						ADRIA_ASSERT_MSG(false, "Invalid Store Access!");
+					}
+
+					RGTextureId rt_texture = render_target_info.render_target_handle.GetResourceId();
+					GfxTexture* texture = rg.GetTexture(rt_texture);
+
+					GfxTextureDesc const& desc = texture->GetDesc();
+					GfxClearValue const& clear_value = desc.clear_value;
+					if (clear_value.active_member != GfxClearValue::GfxActiveMember::None)
+					{
+						ADRIA_ASSERT_MSG(clear_value.active_member == GfxClearValue::GfxActiveMember::Color, "Invalid Clear Value for Render Target");
+						rtv_desc.clear_value = desc.clear_value;
+						rtv_desc.clear_value.format = desc.format;
+					}
+					else if(rtv_desc.beginning_access == GfxLoadAccessOp::Clear)
+					{
+						rtv_desc.clear_value.format = desc.format;
+						rtv_desc.clear_value = GfxClearValue(0.0f, 0.0f, 0.0f, 0.0f);
+					}
+
+					rtv_desc.cpu_handle = rg.GetRenderTarget(render_target_info.render_target_handle);
+					render_pass_desc.rtv_attachments.push_back(rtv_desc);
+				}
+
+				if (pass->depth_stencil.has_value())
+				{
+					auto const& depth_stencil_info = pass->depth_stencil.value();
+					if (depth_stencil_info.depth_read_only)
+					{
+						render_pass_desc.flags |= GfxRenderPassFlagBit_ReadOnlyDepth;
+					}
+					
+					GfxDepthAttachmentDesc dsv_desc{};
+					RGLoadAccessOp load_access = RGLoadAccessOp::NoAccess;
+					RGStoreAccessOp store_access = RGStoreAccessOp::NoAccess;
+					SplitAccessOp(depth_stencil_info.depth_access, load_access, store_access);
+
+					switch (load_access)
+					{
+					case RGLoadAccessOp::Clear:
+						dsv_desc.depth_beginning_access = GfxLoadAccessOp::Clear;
+						break;
+					case RGLoadAccessOp::Discard:
+						dsv_desc.depth_beginning_access = GfxLoadAccessOp::Discard;
+						break;
+					case RGLoadAccessOp::Preserve:
+						dsv_desc.depth_beginning_access = GfxLoadAccessOp::Preserve;
+						break;
+					case RGLoadAccessOp::NoAccess:
+						dsv_desc.depth_beginning_access = GfxLoadAccessOp::NoAccess;
+						break;
+					default:
+						ADRIA_ASSERT_MSG(false, "Invalid Load Access!");
+					}
+
+					switch (store_access)
+					{
+					case RGStoreAccessOp::Resolve:
+						dsv_desc.depth_ending_access = GfxStoreAccessOp::Resolve;
+						break;
+					case RGStoreAccessOp::Discard:
+						dsv_desc.depth_ending_access = GfxStoreAccessOp::Discard;
+						break;
+					case RGStoreAccessOp::Preserve:
+						dsv_desc.depth_ending_access = GfxStoreAccessOp::Preserve;
+						break;
+					case RGStoreAccessOp::NoAccess:
+						dsv_desc.depth_ending_access = GfxStoreAccessOp::NoAccess;
+						break;
+					default:
+						ADRIA_ASSERT_MSG(false, "Invalid Store Access!");
+					}
+
+					RGTextureId ds_texture = depth_stencil_info.depth_stencil_handle.GetResourceId();
+					GfxTexture* texture = rg.GetTexture(ds_texture);
+
+					GfxTextureDesc const& desc = texture->GetDesc();
+					if (desc.clear_value.active_member != GfxClearValue::GfxActiveMember::None)
+					{
+						ADRIA_ASSERT_MSG(desc.clear_value.active_member == GfxClearValue::GfxActiveMember::DepthStencil, "Invalid Clear Value for Depth Stencil");
+						dsv_desc.clear_value = desc.clear_value;
+						dsv_desc.clear_value.format = desc.format;
+					}
+					else if (dsv_desc.depth_beginning_access == GfxLoadAccessOp::Clear)
+					{
+						dsv_desc.clear_value.format = desc.format;
+						dsv_desc.clear_value = GfxClearValue(0.0f, 0);
+					}
+
+					dsv_desc.cpu_handle = rg.GetDepthStencil(depth_stencil_info.depth_stencil_handle);
+
+					ADRIA_TODO("Add Stencil Support");
+					render_pass_desc.dsv_attachment = dsv_desc;
+				}
+				ADRIA_ASSERT_MSG((pass->viewport_width != 0 && pass->viewport_height != 0), "Viewport Width/Height is 0! The call to builder.SetViewport is probably missing...");
+				render_pass_desc.width = pass->viewport_width;
+				render_pass_desc.height = pass->viewport_height;
+				render_pass_desc.legacy = pass->UseLegacyRenderPasses();
+
+				ZoneTransientN(__tracy, pass->name.c_str(), true);
+				AdriaGfxScopedEvent(cmd_list, pass->name.c_str());
+				TracyGfxProfileScope(cmd_list->GetNative(), pass->name.c_str());
+				cmd_list->SetContext(GfxCommandList::Context::Graphics);
+				cmd_list->BeginRenderPass(render_pass_desc);
+				pass->Execute(render_graph_ctx);
+				cmd_list->EndRenderPass();
+			}
+			else
+			{
+				ZoneTransientN(__tracy, pass->name.c_str(), true);
+				AdriaGfxScopedEvent(cmd_list, pass->name.c_str());
+				TracyGfxProfileScope(cmd_list->GetNative(), pass->name.c_str());
+				cmd_list->SetContext(GfxCommandList::Context::Compute);
+				pass->Execute(render_graph_ctx);
+			}
+
+			for (Uint32 i = 0; i < pass->num_events_to_end; ++i)
+			{
+				cmd_list->EndEvent();
+			}
+
+			if (pass->signal_value != UINT64_MAX)
+			{
+				cmd_list->End();
+				if (pass->type == RGPassType::AsyncCompute)
+				{
+					cmd_list->Signal(*exec_ctx.compute_fence, exec_ctx.compute_fence_value + pass->signal_value);
+					exec_ctx.gfx->SetComputeFenceValue(exec_ctx.compute_fence_value + pass->signal_value);
+				}
+				else
+				{
+					cmd_list->Signal(*exec_ctx.graphics_fence, exec_ctx.graphics_fence_value + pass->signal_value);
+					exec_ctx.gfx->SetGraphicsFenceValue(exec_ctx.graphics_fence_value + pass->signal_value);
+				}
+				cmd_list->Submit();
+				cmd_list->Begin();
+			}
+		} 
+		PostExecute(exec_ctx.graphics_cmd_list);
+	}
+
+	void RenderGraph::DependencyLevel::PreExecute(GfxCommandList* cmd_list)
+	{
+		for (RGTextureId tex_id : texture_creates)
+		{
+			RGTexture* rg_texture = rg.GetRGTexture(tex_id);
+			if (!rg_texture->imported)
+			{
+				rg_texture->resource = rg.pool.AllocateTexture(rg_texture->desc);
+			}
+			rg.CreateTextureViews(tex_id);
+			rg_texture->SetName();
+		}
+		for (RGBufferId buf_id : buffer_creates)
+		{
+			RGBuffer* rg_buffer = rg.GetRGBuffer(buf_id);
+			if (!rg_buffer->imported)
+			{
+				rg_buffer->resource = rg.pool.AllocateBuffer(rg_buffer->desc);
+			}
+			rg.CreateBufferViews(buf_id);
+			rg_buffer->SetName();
+		}
+
+		for (TextureTransition const& transition : texture_begin_transitions)
+		{
+			cmd_list->TextureBarrier(*rg.GetTexture(transition.resource), transition.before, transition.after);
+		}
+		for (BufferTransition const& transition : buffer_begin_transitions)
+		{
+			cmd_list->BufferBarrier(*rg.GetBuffer(transition.resource), transition.before, transition.after);
+		}
+		cmd_list->FlushBarriers();
+	}
+
+	void RenderGraph::DependencyLevel::PostExecute(GfxCommandList* cmd_list)
+	{
+		for (TextureTransition const& transition : texture_end_transitions)
+		{
+			cmd_list->TextureBarrier(*rg.GetTexture(transition.resource), transition.before, transition.after);
+		}
+		for (BufferTransition const& transition : buffer_end_transitions)
+		{
+			cmd_list->BufferBarrier(*rg.GetBuffer(transition.resource), transition.before, transition.after);
+		}
+		cmd_list->FlushBarriers();
+
+		for (RGTextureId tex_id : texture_destroys)
+		{
+			RGTexture* rg_texture = rg.GetRGTexture(tex_id);
+			if (!rg_texture->imported)
+			{
+				rg.pool.ReleaseTexture(rg_texture->resource);
+			}
+		}
+		for (RGBufferId buf_id : buffer_destroys)
+		{
+			RGBuffer* rg_buffer = rg.GetRGBuffer(buf_id);
+			if (!rg_buffer->imported)
+			{
+				rg.pool.ReleaseBuffer(rg_buffer->resource);
+			}
+		}
+	}
+}
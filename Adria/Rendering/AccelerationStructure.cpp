@@ -3,22 +3,43 @@
 #include "Graphics/GfxBuffer.h"
 #include "Graphics/GfxDevice.h"
 #include "Graphics/GfxCommandList.h"
+#include "Core/ConsoleManager.h"
 
 namespace adria
 {
+	ADRIA_LOG_CHANNEL(Renderer);
+
+	static TAutoConsoleVariable<Bool> RayTracingMergeStaticGeometry("r.RayTracing.MergeStaticGeometry", false, "Merge consecutive submesh instances sharing a transform into one BLAS");
+	static TAutoConsoleVariable<Bool> RayTracingCompactBLAS("r.RayTracing.CompactBLAS", false, "Compact bottom level acceleration structures after they are built");
+
+	std::vector<BLASGroup> GroupSubMeshInstances(std::span<SubMeshInstance const> instances, Bool merge, Uint32 max_geometries_per_blas)
+	{
+		std::vector<BLASGroup> groups;
+		for (Uint32 i = 0; i < (Uint32)instances.size(); ++i)
+		{
+			if (merge && !groups.empty())
+			{
+				BLASGroup& group = groups.back();
+				Bool const same_transform = instances[group.first_instance].world_transform == instances[i].world_transform;
+				if (same_transform && group.instance_count < max_geometries_per_blas)
+				{
+					++group.instance_count;
+					continue;
+				}
+			}
+			groups.push_back(BLASGroup{ .first_instance = i, .instance_count = 1 });
+		}
+		return groups;
+	}
 
 	AccelerationStructure::AccelerationStructure(GfxDevice* gfx) : gfx(gfx)
 	{
 		build_fence.Create(gfx, "Build Fence");
-		++build_fence_value;
 	}
 
-	void AccelerationStructure::AddInstance(Mesh const& mesh)
+	void AccelerationStructure::AddInstance(Mesh const& mesh, Uint32 base_instance_id)
 	{
-		GfxLinearDynamicAllocator* dynamic_allocator = gfx->GetDynamicAllocator();
-		blases.resize(mesh.instances.size());
-		Uint32 instance_id = 0;
-
+		Uint32 const geometry_offset = (Uint32)rt_geometries.size();
 		GfxBuffer* geometry_buffer = g_GeometryBufferCache.GetGeometryBuffer(mesh.geometry_buffer_handle);
 		for (SubMeshInstance const& instance : mesh.instances)
 		{
@@ -37,31 +58,75 @@ namespace adria
 			rt_geometry.index_count = submesh.indices_count;
 			rt_geometry.index_format = GfxFormat::R32_UINT;
 			rt_geometry.opaque = material.alpha_mode == MaterialAlphaMode::Opaque;
+		}
+
+		std::vector<BLASGroup> const groups = GroupSubMeshInstances(mesh.instances, RayTracingMergeStaticGeometry.Get(), MaxGeometriesPerBLAS);
+		for (BLASGroup const& group : groups)
+		{
+			rt_instance_blas_indices.push_back((Uint32)blas_groups.size());
+			blas_groups.push_back(BLASGroup{ .first_instance = geometry_offset + group.first_instance, .instance_count = group.instance_count });
 
+			//shaders address the instance buffer with InstanceID() + GeometryIndex()
 			GfxRayTracingInstance& rt_instance = rt_instances.emplace_back();
 			rt_instance.flags = GfxRayTracingInstanceFlag_None;
-			rt_instance.instance_id = instance_id++; //#todo temporary
+			rt_instance.instance_id = base_instance_id + group.first_instance;
 			rt_instance.instance_mask = 0xff;
-			const auto T = XMMatrixTranspose(instance.world_transform);
+			const auto T = XMMatrixTranspose(mesh.instances[group.first_instance].world_transform);
 			memcpy(rt_instance.transform, &T, sizeof(T));
 		}
 	}
 
 	void AccelerationStructure::Build()
 	{
-		if (blases.empty()) return;
-		BuildBottomLevels();
-		for(auto& rt_instance : rt_instances) rt_instance.blas = blases[rt_instance.instance_id].get();
+		if (blas_groups.empty()) return;
+
+		Bool const compact = RayTracingCompactBLAS.Get();
+		BuildBottomLevels(compact);
 		BuildTopLevel();
-		tlas_srv = gfx->CreateBufferSRV(&tlas->GetBuffer());
+
+		GfxCommandList* cmd_list = gfx->GetGraphicsCommandList();
+		++build_fence_value;
+		cmd_list->Signal(build_fence, build_fence_value);
+		compaction_state = compact ? CompactionState::WaitingForSizes : CompactionState::None;
+
+		stats = AccelerationStructureStats{};
+		stats.instance_count = (Uint32)rt_instances.size();
+		stats.blas_count = (Uint32)blases.size();
+		for (auto const& blas : blases) stats.blas_size += blas->GetSize();
+	}
+
+	void AccelerationStructure::Update()
+	{
+		if (compaction_state == CompactionState::WaitingForSizes && build_fence.IsCompleted(build_fence_value))
+		{
+			CompactBottomLevels();
+		}
+		ReleaseRetiredStructures();
 	}
 
 	void AccelerationStructure::Clear()
 	{
+		if (!blases.empty() || tlas)
+		{
+			//the postbuild buffers are still written by the gpu while the compacted sizes are pending
+			std::vector<std::unique_ptr<GfxBuffer>> postbuild_buffers;
+			if (postbuild_buffer) postbuild_buffers.push_back(std::move(postbuild_buffer));
+			if (postbuild_readback_buffer) postbuild_buffers.push_back(std::move(postbuild_readback_buffer));
+
+			++build_fence_value;
+			gfx->GetGraphicsCommandList()->Signal(build_fence, build_fence_value);
+			retired_structures.push_back(RetiredStructures{ .blases = std::move(blases), .tlas = std::move(tlas), .buffers = std::move(postbuild_buffers), .fence_value = build_fence_value });
+		}
 		blases.clear();
+		blas_groups.clear();
 		rt_geometries.clear();
 		rt_instances.clear();
+		rt_instance_blas_indices.clear();
 		tlas = nullptr;
+		postbuild_buffer = nullptr;
+		postbuild_readback_buffer = nullptr;
+		compaction_state = CompactionState::None;
+		stats = AccelerationStructureStats{};
 	}
 
 	Int32 AccelerationStructure::GetTLASIndex() const
@@ -71,38 +136,86 @@ namespace adria
 		return (Int32)tlas_srv_gpu.GetIndex();
 	}
 
-	void AccelerationStructure::BuildBottomLevels()
+	void AccelerationStructure::BuildBottomLevels(Bool allow_compaction)
 	{
 		GfxCommandList* cmd_list = gfx->GetGraphicsCommandList();
 
+		GfxRayTracingASFlags flags = GfxRayTracingASFlag_PreferFastTrace;
+		if (allow_compaction) flags |= GfxRayTracingASFlag_AllowCompaction;
+
 		std::span<GfxRayTracingGeometry> geometry_span(rt_geometries);
+		blases.resize(blas_groups.size());
 		for (Uint64 i = 0; i < blases.size(); ++i)
 		{
-			blases[i] = gfx->CreateRayTracingBLAS(geometry_span.subspan(i, 1), GfxRayTracingASFlag_PreferFastTrace);
+			blases[i] = gfx->CreateRayTracingBLAS(geometry_span.subspan(blas_groups[i].first_instance, blas_groups[i].instance_count), flags);
+		}
+		cmd_list->GlobalBarrier(GfxResourceState::ASWrite, GfxResourceState::ASRead);
+		cmd_list->FlushBarriers();
+
+		if (allow_compaction)
+		{
+			Uint64 const postbuild_size = blases.size() * sizeof(Uint64);
+
+			GfxBufferDesc postbuild_desc{};
+			postbuild_desc.size = postbuild_size;
+			postbuild_desc.bind_flags = GfxBindFlag::UnorderedAccess;
+			postbuild_buffer = gfx->CreateBuffer(postbuild_desc);
+			postbuild_readback_buffer = gfx->CreateBuffer(ReadBackBufferDesc(postbuild_size));
+
+			std::vector<GfxRayTracingBLAS const*> blas_pointers; blas_pointers.reserve(blases.size());
+			for (auto const& blas : blases) blas_pointers.push_back(blas.get());
+			EmitRayTracingBLASCompactedSizes(cmd_list, blas_pointers, *postbuild_buffer);
+
+			cmd_list->BufferBarrier(*postbuild_buffer, GfxResourceState::ComputeUAV, GfxResourceState::CopySrc);
+			cmd_list->FlushBarriers();
+			cmd_list->CopyBuffer(*postbuild_readback_buffer, *postbuild_buffer);
 		}
-		cmd_list->Signal(build_fence, build_fence_value);
-		cmd_list->End();
-		cmd_list->Submit();
 	}
 
 	void AccelerationStructure::BuildTopLevel()
 	{
-		GfxCommandList* cmd_list = gfx->GetGraphicsCommandList();
-		cmd_list->Begin();
+		for (Uint64 i = 0; i < rt_instances.size(); ++i)
+		{
+			rt_instances[i].blas = blases[rt_instance_blas_indices[i]].get();
+		}
+		tlas = gfx->CreateRayTracingTLAS(rt_instances, GfxRayTracingASFlag_PreferFastTrace);
+		tlas_srv = gfx->CreateBufferSRV(&tlas->GetBuffer());
+	}
 
-		build_fence.Wait(build_fence_value);
-		++build_fence_value;
+	void AccelerationStructure::CompactBottomLevels()
+	{
+		GfxCommandList* cmd_list = gfx->GetGraphicsCommandList();
+		Uint64 const* compacted_sizes = postbuild_readback_buffer->GetMappedData<Uint64>();
 
-		tlas = gfx->CreateRayTracingTLAS(rt_instances, GfxRayTracingASFlag_PreferFastTrace);
+		std::vector<std::unique_ptr<GfxRayTracingBLAS>> compacted_blases(blases.size());
+		stats.compacted_blas_size = 0;
+		for (Uint64 i = 0; i < blases.size(); ++i)
+		{
+			compacted_blases[i] = gfx->CreateRayTracingBLAS(*blases[i], compacted_sizes[i]);
+			stats.compacted_blas_size += compacted_blases[i]->GetSize();
+		}
+		cmd_list->GlobalBarrier(GfxResourceState::ASWrite, GfxResourceState::ASRead);
+		cmd_list->FlushBarriers();
 
+		//the previous frames can still reference the uncompacted structures, keep them alive until the copies complete
+		++build_fence_value;
+		retired_structures.push_back(RetiredStructures{ .blases = std::move(blases), .tlas = std::move(tlas), .fence_value = build_fence_value });
+		blases = std::move(compacted_blases);
+		BuildTopLevel();
 		cmd_list->Signal(build_fence, build_fence_value);
-		cmd_list->End();
-		cmd_list->Submit();
 
-		build_fence.Wait(build_fence_value);
-		++build_fence_value;
+		postbuild_buffer = nullptr;
+		postbuild_readback_buffer = nullptr;
+		compaction_state = CompactionState::Compacted;
+		stats.compacted = true;
+		ADRIA_LOG(INFO, "Compacted %u BLASes from %llu to %llu bytes", stats.blas_count, stats.blas_size, stats.compacted_blas_size);
+	}
 
-		cmd_list->Begin();
+	void AccelerationStructure::ReleaseRetiredStructures()
+	{
+		std::erase_if(retired_structures, [this](RetiredStructures const& retired)
+		{
+			return build_fence.IsCompleted(retired.fence_value);
+		});
 	}
 }
-
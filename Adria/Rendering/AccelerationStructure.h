@@ -8,32 +8,82 @@ namespace adria
 	class GfxDevice;
 	class GfxBuffer;
 	struct Mesh;
+	struct SubMeshInstance;
+
+	//a run of consecutive submesh instances that end up as the geometries of one BLAS
+	struct BLASGroup
+	{
+		Uint32 first_instance;
+		Uint32 instance_count;
+	};
+
+	//merges consecutive instances with the same world transform, since InstanceID() + GeometryIndex() has to
+	//address the scene instance buffer, only consecutive instances can share a BLAS
+	std::vector<BLASGroup> GroupSubMeshInstances(std::span<SubMeshInstance const> instances, Bool merge, Uint32 max_geometries_per_blas);
+
+	struct AccelerationStructureStats
+	{
+		Uint32 instance_count = 0;
+		Uint32 blas_count = 0;
+		Uint64 blas_size = 0;
+		Uint64 compacted_blas_size = 0;
+		Bool   compacted = false;
+	};
 
 	class AccelerationStructure
 	{
+		static constexpr Uint32 MaxGeometriesPerBLAS = 64;
+
+		struct RetiredStructures
+		{
+			std::vector<std::unique_ptr<GfxRayTracingBLAS>> blases;
+			std::unique_ptr<GfxRayTracingTLAS> tlas;
+			std::vector<std::unique_ptr<GfxBuffer>> buffers;
+			Uint64 fence_value;
+		};
+
+		enum class CompactionState : Uint8
+		{
+			None,
+			WaitingForSizes,
+			Compacted
+		};
+
 	public:
 		explicit AccelerationStructure(GfxDevice* gfx);
 
-		void AddInstance(Mesh const& mesh);
+		void AddInstance(Mesh const& mesh, Uint32 base_instance_id);
 		void Build();
+		void Update();
 		void Clear();
 
 		Int32 GetTLASIndex() const;
+		AccelerationStructureStats const& GetStats() const { return stats; }
 
 	private:
 		GfxDevice* gfx;
 		std::vector<GfxRayTracingGeometry> rt_geometries;
+		std::vector<BLASGroup> blas_groups;
 		std::vector<std::unique_ptr<GfxRayTracingBLAS>> blases;
 
 		std::vector<GfxRayTracingInstance> rt_instances;
+		std::vector<Uint32> rt_instance_blas_indices;
 		std::unique_ptr<GfxRayTracingTLAS> tlas;
 		GfxDescriptor tlas_srv;
 
+		std::unique_ptr<GfxBuffer> postbuild_buffer;
+		std::unique_ptr<GfxBuffer> postbuild_readback_buffer;
+		CompactionState compaction_state = CompactionState::None;
+		std::vector<RetiredStructures> retired_structures;
+		AccelerationStructureStats stats;
+
 		GfxFence build_fence;
 		Uint64 build_fence_value = 0;
 
 	private:
-		void BuildBottomLevels();
+		void BuildBottomLevels(Bool allow_compaction);
 		void BuildTopLevel();
+		void CompactBottomLevels();
+		void ReleaseRetiredStructures();
 	};
-}
\ No newline at end of file
+}
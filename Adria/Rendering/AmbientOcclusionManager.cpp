@@ -15,7 +15,7 @@ namespace adria
 		AmbientOcclusionType_RTAO
 	};
 
-	static TAutoConsoleVariable<Int>  AmbientOcclusion("r.AmbientOcclusion", AmbientOcclusionType_SSAO, "0 - No AO, 1 - SSAO, 2 - HBAO, 3 - NNAO, 4 - CACAO, 5 - RTAO");
+	static TAutoConsoleVariable<Int>  AmbientOcclusion("r.AmbientOcclusion", AmbientOcclusionType_SSAO, "0 - No AO, 1 - SSAO, 2 - HBAO, 3 - NNAO, 4 - CACAO, 5 - RTAO", ConsoleVariableMetadata{ .enum_names = { "None", "SSAO", "HBAO", "NNAO", "CACAO", "RTAO" } });
 
 	AmbientOcclusionManager::AmbientOcclusionManager(GfxDevice* gfx, Uint32 width, Uint32 height)
 		: gfx(gfx), ssao_pass(gfx, width, height), hbao_pass(gfx, width, height), nnao_pass(gfx, width, height),
@@ -59,9 +59,11 @@ namespace adria
 	{
 		QueueGUI([&]()
 			{
-				if (ImGui::Combo("Ambient Occlusion Type", AmbientOcclusion.GetPtr(), "None\0SSAO\0HBAO\0NNAO\0CACAO\0RTAO\0", 6))
+				Int ambient_occlusion = AmbientOcclusion.Get();
+				if (ImGui::Combo("Ambient Occlusion Type", &ambient_occlusion, "None\0SSAO\0HBAO\0NNAO\0CACAO\0RTAO\0", 6))
 				{
-					if (!gfx->GetCapabilities().SupportsRayTracing() && AmbientOcclusion.Get() == 4) AmbientOcclusion->Set(AmbientOcclusionType_SSAO);
+					if (!gfx->GetCapabilities().SupportsRayTracing() && ambient_occlusion == 4) ambient_occlusion = AmbientOcclusionType_SSAO;
+					AmbientOcclusion->Set(ambient_occlusion);
 				}
 			}, GUICommandGroup_PostProcessing, GUICommandSubGroup_AO);
 
@@ -178,11 +178,11 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx("Automatic Exposure", 0))
 				{
-					ImGui::Checkbox("Enable", AutoExposure.GetPtr());
+					GUI_Checkbox("Enable", *AutoExposure);
 					if (AutoExposure.Get())
 					{
-						ImGui::DragFloatRange2("Log Luminance", MinLogLuminance.GetPtr(), MaxLogLuminance.GetPtr(), 1.0f, -100, 50);
-						ImGui::SliderFloat("Adaption Speed", AdaptionSpeed.GetPtr(), 0.01f, 5.0f);
+						GUI_DragFloatRange2("Log Luminance", *MinLogLuminance, *MaxLogLuminance, 1.0f, -100, 50);
+						GUI_SliderFloat("Adaption Speed", *AdaptionSpeed, 0.01f, 5.0f);
 						ImGui::Checkbox("Histogram", &show_histogram);
 						if (show_histogram)
 						{
@@ -11,6 +11,7 @@ namespace adria
 		Float						camera_aspect_ratio;
 		Float						camera_near;
 		Float						camera_far;
+		Bool						camera_infinite_far;
 		Float						camera_jitter_x;
 		Float						camera_jitter_y;
 		Float						camera_position[4];
@@ -61,12 +61,12 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx("Bloom", 0))
 				{
-					ImGui::Checkbox("Enable", Bloom.GetPtr());
+					GUI_Checkbox("Enable", *Bloom);
 					if (Bloom.Get())
 					{
-						ImGui::SliderFloat("Bloom Radius", BloomRadius.GetPtr(), 0.0f, 1.0f);
-						ImGui::SliderFloat("Bloom Intensity", BloomIntensity.GetPtr(), 0.0f, 8.0f);
-						ImGui::SliderFloat("Bloom Blend Factor", BloomBlendFactor.GetPtr(), 0.0f, 1.0f);
+						GUI_SliderFloat("Bloom Radius", *BloomRadius, 0.0f, 1.0f);
+						GUI_SliderFloat("Bloom Intensity", *BloomIntensity, 0.0f, 8.0f);
+						GUI_SliderFloat("Bloom Blend Factor", *BloomBlendFactor, 0.0f, 1.0f);
 					}
 					ImGui::TreePop();
 					ImGui::Separator();
@@ -99,11 +99,11 @@ namespace adria
 		QueueGUI([&]() {
 			if (ImGui::TreeNodeEx("CRT Filter", 0))
 			{
-				ImGui::Checkbox("Enable CRT", CRT.GetPtr());
+				GUI_Checkbox("Enable CRT", *CRT);
 				if (CRT.Get())
 				{
-					ImGui::SliderFloat("Hard Scan", CRTHardScan.GetPtr(), -16.0f, -8.0f);
-					ImGui::SliderFloat("Pixel Hardness", CRTPixelHardness.GetPtr(), -4.0f, -2.0f);
+					GUI_SliderFloat("Hard Scan", *CRTHardScan, -16.0f, -8.0f);
+					GUI_SliderFloat("Pixel Hardness", *CRTPixelHardness, -4.0f, -2.0f);
 
 					auto SnapToValidWarp = [](Float value)
 					{
@@ -121,13 +121,15 @@ namespace adria
 						}
 						return closest;
 					};
-					if (ImGui::SliderFloat("Warp X", CRTWarpX.GetPtr(), 0.0f, 1.0f / 8.0f, "%.4f")) 
+					Float warp_x = CRTWarpX.Get();
+					if (ImGui::SliderFloat("Warp X", &warp_x, 0.0f, 1.0f / 8.0f, "%.4f")) 
 					{
-						CRTWarpX.AsVariable()->Set(SnapToValidWarp(CRTWarpX.Get()));
+						CRTWarpX->Set(SnapToValidWarp(warp_x));
 					}
-					if (ImGui::SliderFloat("Warp Y", CRTWarpY.GetPtr(), 0.0f, 1.0f / 8.0f, "%.4f"))
+					Float warp_y = CRTWarpY.Get();
+					if (ImGui::SliderFloat("Warp Y", &warp_y, 0.0f, 1.0f / 8.0f, "%.4f"))
 					{
-						CRTWarpY.AsVariable()->Set(SnapToValidWarp(CRTWarpY.Get()));
+						CRTWarpY->Set(SnapToValidWarp(warp_y));
 					}
 					
 				}
@@ -1,7 +1,6 @@
 #include "Camera.h"
 #include "Platform/Input.h"
 #include "Math/Constants.h"
-#include "Math/Halton.h"
 
 using namespace DirectX;
 
@@ -25,15 +24,6 @@ namespace adria
 		return Vector3::Transform(Vector3::Forward, orientation);
 	}
 
-	Vector2 Camera::Jitter(Uint32 frame_index) const
-	{
-		Vector2 jitter{};
-		constexpr HaltonSequence<16, 2> x;
-		constexpr HaltonSequence<16, 3> y;
-		jitter.x = x[frame_index % 16] - 0.5f;
-		jitter.y = y[frame_index % 16] - 0.5f;
-		return jitter;
-	}
 	Float Camera::Near() const
 	{
 		return near_plane;
@@ -50,6 +40,10 @@ namespace adria
 	{
 		return aspect_ratio;
 	}
+	DepthLinearization Camera::GetDepthLinearization() const
+	{
+		return ComputeDepthLinearization(far_plane, near_plane, infinite_far);
+	}
 
 	void Camera::Update(Float dt)
 	{
@@ -88,8 +82,7 @@ namespace adria
 			changed = true;
 		}
 		
-		Matrix view_inverse = Matrix::CreateFromQuaternion(orientation) * Matrix::CreateTranslation(position);
-		view_inverse.Invert(view_matrix);
+		UpdateViewMatrix();
 		SetProjectionMatrix(fov, aspect_ratio, near_plane, far_plane);
 	}
 	void Camera::Zoom(Int32 increment)
@@ -123,6 +116,15 @@ namespace adria
 	void Camera::SetPosition(Vector3 const& pos)
 	{
 		position = pos;
+		UpdateViewMatrix();
+		changed = true;
+	}
+	void Camera::SetOrientation(Quaternion const& q)
+	{
+		orientation = q;
+		orientation.Normalize();
+		UpdateViewMatrix();
+		changed = true;
 	}
 
 	Matrix Camera::View() const
@@ -139,13 +141,19 @@ namespace adria
 	}
 	BoundingFrustum Camera::Frustum() const
 	{
-		BoundingFrustum frustum(Proj());
-		if (frustum.Far < frustum.Near) std::swap(frustum.Far, frustum.Near);
+		//culling, shadows and everything else that needs a bounded volume stop at the scene far plane
+		BoundingFrustum frustum = CreateViewFrustum(fov, aspect_ratio, far_plane, near_plane);
 		frustum.Transform(frustum, view_matrix.Invert());
 		return frustum;
 	}
+	void Camera::UpdateViewMatrix()
+	{
+		Matrix view_inverse = Matrix::CreateFromQuaternion(orientation) * Matrix::CreateTranslation(position);
+		view_inverse.Invert(view_matrix);
+	}
 	void Camera::SetProjectionMatrix(Float fov, Float aspect, Float zn, Float zf)
 	{
-		projection_matrix = XMMatrixPerspectiveFovLH(fov, aspect, zn, zf);
+		infinite_far = UseInfiniteFarPlane();
+		projection_matrix = CreateReverseZProjection(fov, aspect, zf, zn, infinite_far);
 	}
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include "DepthProjection.h"
 
 namespace adria
 {
@@ -26,15 +27,22 @@ namespace adria
 		{
 			return position;
 		}
+		Quaternion Orientation() const
+		{
+			return orientation;
+		}
 		Vector3 Forward() const;
 
-		Vector2 Jitter(Uint32 frame_index) const;
+		//the planes in depth order: Near() is the plane at depth 0, which is the far plane of reverse-z
 		Float Near() const;
 		Float Far() const;
+		Bool IsInfiniteFar() const { return infinite_far; }
+		DepthLinearization GetDepthLinearization() const;
 		Float Fov() const;
 		Float AspectRatio() const;
 
 		void SetPosition(Vector3 const& pos);
+		void SetOrientation(Quaternion const& q);
 		void SetNearAndFar(Float n, Float f);
 		void SetAspectRatio(Float ar);
 		void SetFov(Float fov);
@@ -57,10 +65,12 @@ namespace adria
 		Float fov;
 		Float aspect_ratio;
 		Float near_plane, far_plane;
+		Bool  infinite_far = false;
 		Bool  enabled;
 		Bool  changed;
 
 	private:
+		void UpdateViewMatrix();
 		void SetProjectionMatrix(Float fov, Float aspect, Float zn, Float zf);
 	};
 
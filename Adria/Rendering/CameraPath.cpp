@@ -0,0 +1,161 @@
+#include "CameraPath.h"
+#include "Utilities/Json.h"
+
+namespace adria
+{
+	ADRIA_LOG_CHANNEL(Renderer);
+
+	namespace
+	{
+		//tangent at key i of the Catmull-Rom spline through (times, values), one sided at the ends
+		template<typename T>
+		T CatmullRomTangent(std::vector<CameraKeyframe> const& keyframes, Uint64 i, T CameraKeyframe::* member)
+		{
+			Uint64 const prev = i > 0 ? i - 1 : i;
+			Uint64 const next = i + 1 < keyframes.size() ? i + 1 : i;
+			Float const dt = keyframes[next].time - keyframes[prev].time;
+			if (dt <= 0.0f) return keyframes[i].*member * 0.0f;
+			return (keyframes[next].*member - keyframes[prev].*member) * (1.0f / dt);
+		}
+
+		template<typename T>
+		T Hermite(T const& p0, T const& m0, T const& p1, T const& m1, Float segment_duration, Float t)
+		{
+			Float const t2 = t * t;
+			Float const t3 = t2 * t;
+			Float const h00 = 2.0f * t3 - 3.0f * t2 + 1.0f;
+			Float const h10 = t3 - 2.0f * t2 + t;
+			Float const h01 = -2.0f * t3 + 3.0f * t2;
+			Float const h11 = t3 - t2;
+			return p0 * h00 + m0 * (h10 * segment_duration) + p1 * h01 + m1 * (h11 * segment_duration);
+		}
+
+		Bool ReadFloats(json const& array, Float* values, Uint32 count)
+		{
+			if (!array.is_array() || array.size() != count) return false;
+			for (Uint32 i = 0; i < count; ++i)
+			{
+				if (!array[i].is_number()) return false;
+				values[i] = array[i].get<Float>();
+			}
+			return true;
+		}
+	}
+
+	void CameraPath::AddKeyframe(CameraKeyframe const& keyframe)
+	{
+		auto it = std::lower_bound(keyframes.begin(), keyframes.end(), keyframe.time, [](CameraKeyframe const& k, Float time) { return k.time < time; });
+		if (it != keyframes.end() && it->time == keyframe.time) *it = keyframe;
+		else keyframes.insert(it, keyframe);
+	}
+
+	CameraKeyframe CameraPath::Sample(Float time) const
+	{
+		ADRIA_ASSERT(!keyframes.empty());
+		if (keyframes.size() == 1 || time <= keyframes.front().time) return keyframes.front();
+		if (time >= keyframes.back().time) return keyframes.back();
+
+		auto next_it = std::upper_bound(keyframes.begin(), keyframes.end(), time, [](Float time, CameraKeyframe const& k) { return time < k.time; });
+		Uint64 const i1 = next_it - keyframes.begin();
+		Uint64 const i0 = i1 - 1;
+		CameraKeyframe const& k0 = keyframes[i0];
+		CameraKeyframe const& k1 = keyframes[i1];
+		Float const segment_duration = k1.time - k0.time;
+		Float const t = (time - k0.time) / segment_duration;
+
+		CameraKeyframe sample{};
+		sample.time = time;
+		sample.position = Hermite(k0.position, CatmullRomTangent(keyframes, i0, &CameraKeyframe::position),
+								  k1.position, CatmullRomTangent(keyframes, i1, &CameraKeyframe::position), segment_duration, t);
+		sample.fov = Hermite(k0.fov, CatmullRomTangent(keyframes, i0, &CameraKeyframe::fov),
+							 k1.fov, CatmullRomTangent(keyframes, i1, &CameraKeyframe::fov), segment_duration, t);
+
+		Quaternion q1 = k1.orientation;
+		if (k0.orientation.Dot(q1) < 0.0f) q1 = -q1;
+		sample.orientation = Quaternion::Slerp(k0.orientation, q1, t);
+		sample.orientation.Normalize();
+		return sample;
+	}
+
+	std::string CameraPath::Serialize() const
+	{
+		json keyframes_json = json::array();
+		for (CameraKeyframe const& keyframe : keyframes)
+		{
+			keyframes_json.push_back({
+				{ "time", keyframe.time },
+				{ "position", { keyframe.position.x, keyframe.position.y, keyframe.position.z } },
+				{ "orientation", { keyframe.orientation.x, keyframe.orientation.y, keyframe.orientation.z, keyframe.orientation.w } },
+				{ "fov", keyframe.fov }
+			});
+		}
+		json path_json = json::object();
+		path_json["keyframes"] = std::move(keyframes_json);
+		return path_json.dump(1, '\t');
+	}
+
+	Bool CameraPath::Deserialize(std::string const& path_text)
+	{
+		json path_json;
+		try
+		{
+			path_json = json::parse(path_text);
+		}
+		catch (json::parse_error const&)
+		{
+			return false;
+		}
+		if (!path_json.is_object()) return false;
+		json const& keyframes_json = path_json.value("keyframes", json::array());
+		if (!keyframes_json.is_array()) return false;
+
+		CameraPath path;
+		for (json const& keyframe_json : keyframes_json)
+		{
+			if (!keyframe_json.is_object()) return false;
+			json const& time = keyframe_json.value("time", json());
+			json const& fov = keyframe_json.value("fov", json());
+			if (!time.is_number() || !fov.is_number()) return false;
+
+			CameraKeyframe keyframe{};
+			keyframe.time = time.get<Float>();
+			keyframe.fov = fov.get<Float>();
+			if (!ReadFloats(keyframe_json.value("position", json()), &keyframe.position.x, 3)) return false;
+			if (!ReadFloats(keyframe_json.value("orientation", json()), &keyframe.orientation.x, 4)) return false;
+			if (keyframe.orientation.LengthSquared() < 1e-6f) return false;
+			keyframe.orientation.Normalize();
+			path.AddKeyframe(keyframe);
+		}
+		keyframes = std::move(path.keyframes);
+		return true;
+	}
+
+	Bool CameraPath::Save(std::string const& path_file) const
+	{
+		std::ofstream path_stream(path_file);
+		if (!path_stream.is_open())
+		{
+			ADRIA_LOG(ERROR, "Cannot open %s for writing the camera path!", path_file.c_str());
+			return false;
+		}
+		path_stream << Serialize();
+		return path_stream.good();
+	}
+
+	Bool CameraPath::Load(std::string const& path_file)
+	{
+		std::ifstream path_stream(path_file);
+		if (!path_stream.is_open())
+		{
+			ADRIA_LOG(ERROR, "Cannot open camera path %s!", path_file.c_str());
+			return false;
+		}
+		std::string const path_text((std::istreambuf_iterator<Char>(path_stream)), std::istreambuf_iterator<Char>());
+		if (!Deserialize(path_text))
+		{
+			ADRIA_LOG(ERROR, "%s is not a valid camera path!", path_file.c_str());
+			return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+namespace adria
+{
+	struct CameraKeyframe
+	{
+		Float time;
+		Vector3 position;
+		Quaternion orientation;
+		Float fov;
+	};
+
+	//keyframed camera animation for repeatable benchmark and capture runs.
+	//position and fov follow a Catmull-Rom spline through the keyframes, evaluated as hermite segments with tangents from the
+	//neighbouring keyframes so unevenly spaced keyframes keep a continuous velocity. orientation is slerped along the shortest arc
+	class CameraPath
+	{
+	public:
+		//keyframes are kept sorted by time, a keyframe at an existing time replaces it
+		void AddKeyframe(CameraKeyframe const& keyframe);
+		void Clear() { keyframes.clear(); }
+
+		std::vector<CameraKeyframe> const& GetKeyframes() const { return keyframes; }
+		Bool IsEmpty() const { return keyframes.empty(); }
+		Float GetStartTime() const { return keyframes.empty() ? 0.0f : keyframes.front().time; }
+		Float GetEndTime() const { return keyframes.empty() ? 0.0f : keyframes.back().time; }
+		Float GetDuration() const { return GetEndTime() - GetStartTime(); }
+
+		//time is clamped to the first and last keyframe
+		CameraKeyframe Sample(Float time) const;
+
+		std::string Serialize() const;
+		//returns false and leaves the path unchanged if the json is not a valid path
+		Bool Deserialize(std::string const& path_json);
+		Bool Save(std::string const& path_file) const;
+		Bool Load(std::string const& path_file);
+
+	private:
+		std::vector<CameraKeyframe> keyframes;
+	};
+}
@@ -0,0 +1,295 @@
+#include "CameraPathController.h"
+#include "Camera.h"
+#include "Core/Paths.h"
+#include "Graphics/GfxDefines.h"
+
+namespace adria
+{
+	ADRIA_LOG_CHANNEL(Renderer);
+
+	static TAutoConsoleVariable<Float> KeyInterval("camera.path.KeyInterval", 1.0f, "Seconds between keyframes added while recording or with camera.path.key",
+		ConsoleVariableMetadata{ .min_value = 0.01f });
+	static TAutoConsoleVariable<Float> PlaybackRate("camera.path.PlaybackRate", 60.0f, "Frames per second of path time, playback advances the path by 1/rate every frame",
+		ConsoleVariableMetadata{ .min_value = 1.0f });
+	static TAutoConsoleVariable<Bool> PlaybackLoop("camera.path.Loop", false, "Restart the path when playback reaches its end");
+
+	namespace
+	{
+		//relative names go to the camera paths folder, json is the default extension
+		std::string GetPathFile(std::string const& name)
+		{
+			std::filesystem::path path_file(name);
+			if (!path_file.has_extension()) path_file.replace_extension(".json");
+			if (path_file.is_relative()) path_file = std::filesystem::path(paths::CameraPathsDir) / path_file;
+			return path_file.string();
+		}
+	}
+
+	CameraPathController::CameraPathController()
+		: key_command("camera.path.key", " Adds the current camera as a keyframe at the end of the camera path",
+			ConsoleCommandDelegate::CreateMember(&CameraPathController::OnKeyCommand, *this)),
+		  record_command("camera.path.record", " Starts recording a new camera path, or stops the recording",
+			ConsoleCommandDelegate::CreateMember(&CameraPathController::OnRecordCommand, *this)),
+		  play_command("camera.path.play", " Plays the camera path from the start",
+			ConsoleCommandDelegate::CreateMember(&CameraPathController::OnPlayCommand, *this)),
+		  stop_command("camera.path.stop", " Stops camera path recording or playback",
+			ConsoleCommandDelegate::CreateMember(&CameraPathController::OnStopCommand, *this)),
+		  clear_command("camera.path.clear", " Removes all keyframes of the camera path",
+			ConsoleCommandDelegate::CreateMember(&CameraPathController::OnClearCommand, *this)),
+		  save_command("camera.path.save", " Saves the camera path. Arguments are: [file name]",
+			ConsoleCommandWithArgsDelegate::CreateMember(&CameraPathController::OnSaveCommand, *this)),
+		  load_command("camera.path.load", " Loads a camera path. Arguments are: [file name]",
+			ConsoleCommandWithArgsDelegate::CreateMember(&CameraPathController::OnLoadCommand, *this))
+	{
+	}
+
+	CameraPathController::~CameraPathController() = default;
+
+	Bool CameraPathController::Update(Camera& camera, Float dt)
+	{
+		if (key_requested)
+		{
+			key_requested = false;
+			Float const time = path.IsEmpty() ? 0.0f : path.GetEndTime() + KeyInterval.Get();
+			path.AddKeyframe(CaptureKeyframe(camera, time));
+			ADRIA_LOG(INFO, "Camera path keyframe %llu added at %.2fs", path.GetKeyframes().size() - 1, time);
+		}
+
+		switch (state)
+		{
+		case State::Recording:
+		{
+			record_time += dt;
+			if (record_time >= next_record_key_time)
+			{
+				path.AddKeyframe(CaptureKeyframe(camera, record_time));
+				next_record_key_time = record_time + KeyInterval.Get();
+			}
+			return false;
+		}
+		case State::Playing:
+		{
+			Bool const loop = PlaybackLoop.Get();
+			Float const time = GetPlaybackTime(playback_frame++, loop);
+			ApplyKeyframe(camera, path.Sample(time));
+			if (!loop && time >= path.GetEndTime())
+			{
+				ADRIA_LOG(INFO, "Camera path playback finished");
+				state = State::Idle;
+			}
+			return true;
+		}
+		case State::Benchmark:
+		{
+			Uint64 const measured_frame = benchmark_frame >= benchmark_desc.warmup_frames ? benchmark_frame - benchmark_desc.warmup_frames : 0;
+			Float const time = GetPlaybackTime(std::min<Uint64>(measured_frame, benchmark_desc.frame_count - 1), true);
+			if (measured_frame < benchmark_frames.size() && benchmark_frame >= benchmark_desc.warmup_frames)
+			{
+				benchmark_frames[measured_frame].path_time = time - path.GetStartTime();
+			}
+			ApplyKeyframe(camera, path.Sample(time));
+			return true;
+		}
+		}
+		return false;
+	}
+
+	Bool CameraPathController::StartBenchmark(CameraBenchmarkDesc const& desc)
+	{
+		if (desc.frame_count == 0)
+		{
+			ADRIA_LOG(ERROR, "Camera benchmark needs at least one frame!");
+			return false;
+		}
+		std::string const path_file = GetPathFile(desc.path_file);
+		if (!path.Load(path_file)) return false;
+		if (path.IsEmpty())
+		{
+			ADRIA_LOG(ERROR, "Camera path %s has no keyframes!", path_file.c_str());
+			return false;
+		}
+
+		benchmark_desc = desc;
+		benchmark_frames.assign(desc.frame_count, BenchmarkFrame{});
+		benchmark_frame = 0;
+		state = State::Benchmark;
+		ADRIA_LOG(INFO, "Camera benchmark started: %s, %u frames after %u warmup frames", path_file.c_str(), desc.frame_count, desc.warmup_frames);
+		return true;
+	}
+
+	Float CameraPathController::BeginBenchmarkFrame(Float dt)
+	{
+		//dt measures the previous frame from start to start, present included
+		Uint64 const warmup_frames = benchmark_desc.warmup_frames;
+		if (benchmark_frame > warmup_frames && benchmark_frame - 1 - warmup_frames < benchmark_frames.size())
+		{
+			benchmark_frames[benchmark_frame - 1 - warmup_frames].frame_ms = dt * 1000.0f;
+		}
+		return 1.0f / PlaybackRate.Get();
+	}
+
+	Bool CameraPathController::EndBenchmarkFrame(Float cpu_ms, std::optional<Float> gpu_ms)
+	{
+		if (state != State::Benchmark) return false;
+
+		Uint64 const warmup_frames = benchmark_desc.warmup_frames;
+		if (benchmark_frame >= warmup_frames && benchmark_frame - warmup_frames < benchmark_frames.size())
+		{
+			benchmark_frames[benchmark_frame - warmup_frames].cpu_ms = cpu_ms;
+		}
+		if (gpu_ms && benchmark_frame >= warmup_frames + GFX_BACKBUFFER_COUNT)
+		{
+			Uint64 const gpu_frame = benchmark_frame - GFX_BACKBUFFER_COUNT - warmup_frames;
+			if (gpu_frame < benchmark_frames.size()) benchmark_frames[gpu_frame].gpu_ms = *gpu_ms;
+		}
+
+		//the last frames only collect the gpu timings and frame time of the measured ones
+		++benchmark_frame;
+		if (benchmark_frame < warmup_frames + benchmark_frames.size() + GFX_BACKBUFFER_COUNT) return false;
+
+		state = State::Idle;
+		WriteBenchmarkCsv();
+		return true;
+	}
+
+	void CameraPathController::OnKeyCommand()
+	{
+		key_requested = true;
+	}
+
+	void CameraPathController::OnRecordCommand()
+	{
+		if (state == State::Benchmark) return;
+		if (state == State::Recording)
+		{
+			state = State::Idle;
+			key_requested = true;
+			ADRIA_LOG(INFO, "Camera path recording stopped");
+			return;
+		}
+		path.Clear();
+		record_time = 0.0f;
+		next_record_key_time = 0.0f;
+		state = State::Recording;
+		ADRIA_LOG(INFO, "Camera path recording started");
+	}
+
+	void CameraPathController::OnPlayCommand()
+	{
+		if (state == State::Benchmark) return;
+		if (path.IsEmpty())
+		{
+			ADRIA_LOG(WARNING, "camera.path.play: the camera path is empty");
+			return;
+		}
+		playback_frame = 0;
+		state = State::Playing;
+	}
+
+	void CameraPathController::OnStopCommand()
+	{
+		if (state == State::Benchmark) return;
+		state = State::Idle;
+	}
+
+	void CameraPathController::OnClearCommand()
+	{
+		if (state == State::Benchmark) return;
+		path.Clear();
+		if (state == State::Playing) state = State::Idle;
+	}
+
+	void CameraPathController::OnSaveCommand(std::span<Char const*> args)
+	{
+		if (args.empty())
+		{
+			ADRIA_LOG(WARNING, "camera.path.save: missing file name");
+			return;
+		}
+		std::string const path_file = GetPathFile(args[0]);
+		std::filesystem::create_directories(std::filesystem::path(path_file).parent_path());
+		if (path.Save(path_file)) ADRIA_LOG(INFO, "Camera path saved to %s", path_file.c_str());
+	}
+
+	void CameraPathController::OnLoadCommand(std::span<Char const*> args)
+	{
+		if (args.empty())
+		{
+			ADRIA_LOG(WARNING, "camera.path.load: missing file name");
+			return;
+		}
+		if (state == State::Benchmark) return;
+		std::string const path_file = GetPathFile(args[0]);
+		if (path.Load(path_file))
+		{
+			state = State::Idle;
+			ADRIA_LOG(INFO, "Camera path %s loaded, %llu keyframes", path_file.c_str(), path.GetKeyframes().size());
+		}
+	}
+
+	Float CameraPathController::GetPlaybackTime(Uint64 frame, Bool loop) const
+	{
+		Float64 elapsed = frame / (Float64)PlaybackRate.Get();
+		Float64 const duration = path.GetDuration();
+		if (loop && duration > 0.0) elapsed = std::fmod(elapsed, duration);
+		return path.GetStartTime() + (Float)std::min(elapsed, duration);
+	}
+
+	void CameraPathController::ApplyKeyframe(Camera& camera, CameraKeyframe const& keyframe) const
+	{
+		camera.SetPosition(keyframe.position);
+		camera.SetOrientation(keyframe.orientation);
+		if (camera.Fov() != keyframe.fov) camera.SetFov(keyframe.fov);
+	}
+
+	CameraKeyframe CameraPathController::CaptureKeyframe(Camera const& camera, Float time) const
+	{
+		return CameraKeyframe{ .time = time, .position = camera.Position(), .orientation = camera.Orientation(), .fov = camera.Fov() };
+	}
+
+	Bool CameraPathController::WriteBenchmarkCsv() const
+	{
+		std::string csv_file = benchmark_desc.csv_file;
+		if (csv_file.empty()) csv_file = paths::LogDir + "benchmark.csv";
+		std::filesystem::path const csv_dir = std::filesystem::path(csv_file).parent_path();
+		if (!csv_dir.empty()) std::filesystem::create_directories(csv_dir);
+
+		std::ofstream csv(csv_file);
+		if (!csv.is_open())
+		{
+			ADRIA_LOG(ERROR, "Cannot open %s for writing the benchmark results!", csv_file.c_str());
+			return false;
+		}
+
+		//timings that were not available, e.g. gpu timings with profiling disabled, are left empty
+		auto WriteTiming = [&csv](Float ms)
+			{
+				csv << ',';
+				if (ms >= 0.0f) csv << ms;
+			};
+		csv << "frame,path_time,frame_ms,cpu_ms,gpu_ms\n";
+		Float64 cpu_total = 0.0, gpu_total = 0.0;
+		Uint64 gpu_count = 0;
+		for (Uint64 i = 0; i < benchmark_frames.size(); ++i)
+		{
+			BenchmarkFrame const& frame = benchmark_frames[i];
+			csv << i << ',' << frame.path_time;
+			WriteTiming(frame.frame_ms);
+			WriteTiming(frame.cpu_ms);
+			WriteTiming(frame.gpu_ms);
+			csv << '\n';
+			cpu_total += frame.cpu_ms;
+			if (frame.gpu_ms >= 0.0f)
+			{
+				gpu_total += frame.gpu_ms;
+				++gpu_count;
+			}
+		}
+
+		Float64 const frame_count = (Float64)benchmark_frames.size();
+		ADRIA_LOG(INFO, "Camera benchmark finished, results written to %s", csv_file.c_str());
+		ADRIA_LOG(INFO, "Average cpu time: %.3f ms", cpu_total / frame_count);
+		if (gpu_count > 0) ADRIA_LOG(INFO, "Average gpu time: %.3f ms", gpu_total / gpu_count);
+		return csv.good();
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "CameraPath.h"
+#include "Core/ConsoleManager.h"
+
+namespace adria
+{
+	class Camera;
+
+	struct CameraBenchmarkDesc
+	{
+		std::string path_file;
+		std::string csv_file;
+		Uint32 frame_count = 1000;
+		Uint32 warmup_frames = 60;	//rendered at the start of the path before measuring
+	};
+
+	//records, plays and benchmarks camera paths. console commands only queue requests, the camera is touched in Update
+	//since it is recreated on every scene load. playback advances the path by a fixed timestep per frame so every run
+	//renders the same camera for the same frame index, regardless of frame rate
+	class CameraPathController
+	{
+		enum class State : Uint8
+		{
+			Idle,
+			Recording,
+			Playing,
+			Benchmark
+		};
+
+		struct BenchmarkFrame
+		{
+			Float path_time = 0.0f;
+			Float frame_ms = -1.0f;
+			Float cpu_ms = -1.0f;
+			Float gpu_ms = -1.0f;
+		};
+
+	public:
+		CameraPathController();
+		ADRIA_NONCOPYABLE_NONMOVABLE(CameraPathController)
+		~CameraPathController();
+
+		//returns true if the path drives the camera this frame and camera input should be skipped
+		Bool Update(Camera& camera, Float dt);
+
+		Bool StartBenchmark(CameraBenchmarkDesc const& desc);
+		Bool IsBenchmarkRunning() const { return state == State::Benchmark; }
+		//call at the start of a benchmark frame with the measured frame time, returns the fixed timestep to simulate the frame with
+		Float BeginBenchmarkFrame(Float dt);
+		//call once the frame's gpu work is recorded, before it is submitted. cpu_ms is the time spent recording the frame,
+		//gpu_ms is what the gpu profiler reports this frame, which is the frame GFX_BACKBUFFER_COUNT frames back.
+		//returns true once the benchmark is done and the csv is written
+		Bool EndBenchmarkFrame(Float cpu_ms, std::optional<Float> gpu_ms);
+
+		CameraPath const& GetPath() const { return path; }
+
+	private:
+		CameraPath path;
+		State state = State::Idle;
+		Bool key_requested = false;
+		Float record_time = 0.0f;
+		Float next_record_key_time = 0.0f;
+		Uint64 playback_frame = 0;
+
+		CameraBenchmarkDesc benchmark_desc;
+		std::vector<BenchmarkFrame> benchmark_frames;
+		Uint64 benchmark_frame = 0;
+
+		AutoConsoleCommand key_command;
+		AutoConsoleCommand record_command;
+		AutoConsoleCommand play_command;
+		AutoConsoleCommand stop_command;
+		AutoConsoleCommand clear_command;
+		AutoConsoleCommand save_command;
+		AutoConsoleCommand load_command;
+
+	private:
+		void OnKeyCommand();
+		void OnRecordCommand();
+		void OnPlayCommand();
+		void OnStopCommand();
+		void OnClearCommand();
+		void OnSaveCommand(std::span<Char const*> args);
+		void OnLoadCommand(std::span<Char const*> args);
+
+		Float GetPlaybackTime(Uint64 frame, Bool loop) const;
+		void ApplyKeyframe(Camera& camera, CameraKeyframe const& keyframe) const;
+		CameraKeyframe CaptureKeyframe(Camera const& camera, Float time) const;
+		Bool WriteBenchmarkCsv() const;
+	};
+}
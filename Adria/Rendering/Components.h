@@ -11,6 +11,7 @@
 namespace adria
 {
 	class GfxCommandList;
+	class TerrainLOD;
 
 	enum class LightType : Int32
 	{
@@ -150,6 +151,12 @@ namespace adria
 		std::string name = "name tag";
 	};
 
+	struct COMPONENT TerrainChunk
+	{
+		std::shared_ptr<TerrainLOD> terrain;	//shared by all the chunks of one grid
+		Uint32 chunk_index;
+	};
+
 	struct COMPONENT RayTracing {};
 	struct COMPONENT Ocean {};
 	struct COMPONENT Transparent {};
@@ -1,5 +1,6 @@
 #include "DDGIPass.h"
 #include "BlackboardData.h"
+#include "DepthProjection.h"
 #include "Components.h"
 #include "ShaderStructs.h"
 #include "ShaderManager.h"
@@ -356,7 +357,7 @@ namespace adria
 			{
 				if (ImGui::TreeNode("DDGI"))
 				{
-					ImGui::Checkbox("Enable", DDGI.GetPtr());
+					GUI_Checkbox("Enable", *DDGI);
 					if (DDGI.Get())
 					{
 						ImGui::Checkbox("Visualize DDGI", &visualize);
@@ -433,7 +434,7 @@ namespace adria
 		gfx_pso_desc.PS = PS_DDGIVisualize;
 		gfx_pso_desc.depth_state.depth_enable = true;
 		gfx_pso_desc.depth_state.depth_write_mask = GfxDepthWriteMask::All;
-		gfx_pso_desc.depth_state.depth_func = GfxComparisonFunc::GreaterEqual;
+		gfx_pso_desc.depth_state.depth_func = DepthTestFunc;
 		gfx_pso_desc.num_render_targets = 1u;
 		gfx_pso_desc.rtv_formats[0] = GfxFormat::R16G16B16A16_FLOAT;
 		gfx_pso_desc.dsv_format = GfxFormat::D32_FLOAT;
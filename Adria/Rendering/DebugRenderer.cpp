@@ -1,5 +1,6 @@
 #include "DebugRenderer.h"
 #include "BlackboardData.h"
+#include "DepthProjection.h"
 #include "ShaderManager.h"
 #include "Graphics/GfxDynamicAllocation.h"
 #include "Graphics/GfxReflection.h"
@@ -329,7 +330,7 @@ namespace adria
 		gfx_pso_desc.dsv_format = GfxFormat::D32_FLOAT;
 		gfx_pso_desc.depth_state.depth_enable = true;
 		gfx_pso_desc.depth_state.depth_write_mask = GfxDepthWriteMask::All;
-		gfx_pso_desc.depth_state.depth_func = GfxComparisonFunc::GreaterEqual;
+		gfx_pso_desc.depth_state.depth_func = DepthTestFunc;
 		gfx_pso_desc.rasterizer_state.cull_mode = GfxCullMode::None;
 		gfx_pso_desc.rasterizer_state.fill_mode = GfxFillMode::Wireframe;
 		gfx_pso_desc.topology_type = GfxPrimitiveTopologyType::Line;
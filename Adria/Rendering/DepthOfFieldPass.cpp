@@ -95,12 +95,12 @@ namespace adria
 			{
 				if (ImGui::TreeNode("Custom Depth Of Field"))
 				{
-					ImGui::SliderFloat("Max Circle of Confusion", MaxCircleOfConfusion.GetPtr(), 0.005f, 0.02f);
-					ImGui::SliderFloat("Focal Length", FocalLength.GetPtr(), 10.0f, 300.0f);
-					ImGui::SliderFloat("Focus Distance", FocusDistance.GetPtr(), 0.1f, 1000.0f);
-					ImGui::SliderFloat("FStop", FStop.GetPtr(), 1.0f, 8.0f);
-					ImGui::SliderFloat("Alpha Interpolation", AlphaInterpolation.GetPtr(), 0.00f, 1.0f);
-					ImGui::Checkbox("Karis Inverse", BokehKarisInverse.GetPtr());
+					GUI_SliderFloat("Max Circle of Confusion", *MaxCircleOfConfusion, 0.005f, 0.02f);
+					GUI_SliderFloat("Focal Length", *FocalLength, 10.0f, 300.0f);
+					GUI_SliderFloat("Focus Distance", *FocusDistance, 0.1f, 1000.0f);
+					GUI_SliderFloat("FStop", *FStop, 1.0f, 8.0f);
+					GUI_SliderFloat("Alpha Interpolation", *AlphaInterpolation, 0.00f, 1.0f);
+					GUI_Checkbox("Karis Inverse", *BokehKarisInverse);
 					ImGui::TreePop();
 					ImGui::Separator();
 				}
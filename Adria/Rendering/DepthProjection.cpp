@@ -0,0 +1,44 @@
+#include "DepthProjection.h"
+#include "Core/ConsoleManager.h"
+
+namespace adria
+{
+	static TAutoConsoleVariable<Bool> InfiniteFarPlane("r.InfiniteFarPlane", false, "Camera projection puts the far plane at infinity, the scene far plane then only limits cpu culling, shadows and fog");
+
+	Bool UseInfiniteFarPlane()
+	{
+		return InfiniteFarPlane.Get();
+	}
+
+	Matrix CreateReverseZProjection(Float fov, Float aspect_ratio, Float near_plane, Float far_plane, Bool infinite_far)
+	{
+		if (!infinite_far)
+		{
+			//swapping the planes of a standard projection maps the near plane to 1 and the far plane to 0
+			return DirectX::XMMatrixPerspectiveFovLH(fov, aspect_ratio, far_plane, near_plane);
+		}
+
+		//limit of the above for an infinite far plane: depth = near_plane / view_z, exact in the depth buffer
+		Float const y_scale = 1.0f / std::tan(0.5f * fov);
+		Float const x_scale = y_scale / aspect_ratio;
+		return Matrix(
+			x_scale, 0.0f,    0.0f,       0.0f,
+			0.0f,    y_scale, 0.0f,       0.0f,
+			0.0f,    0.0f,    0.0f,       1.0f,
+			0.0f,    0.0f,    near_plane, 0.0f);
+	}
+
+	DepthLinearization ComputeDepthLinearization(Float near_plane, Float far_plane, Bool infinite_far)
+	{
+		if (infinite_far) return DepthLinearization{ .scale = 1.0f / near_plane, .bias = 0.0f };
+		return DepthLinearization{ .scale = 1.0f / near_plane - 1.0f / far_plane, .bias = 1.0f / far_plane };
+	}
+
+	BoundingFrustum CreateViewFrustum(Float fov, Float aspect_ratio, Float near_plane, Float far_plane)
+	{
+		BoundingFrustum frustum(CreateReverseZProjection(fov, aspect_ratio, near_plane, far_plane, false));
+		//reverse-z puts the near plane at depth 1, so the frustum comes out with its planes swapped
+		if (frustum.Far < frustum.Near) std::swap(frustum.Far, frustum.Near);
+		return frustum;
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "Graphics/GfxStates.h"
+
+namespace adria
+{
+	//camera depth is reverse-z: the near plane is at depth 1 and the far plane at depth 0, or at infinity if r.InfiniteFarPlane is set.
+	//passes that clear or depth test camera depth take the values from here
+	inline constexpr Float DepthClearValue = 0.0f;
+	inline constexpr GfxComparisonFunc DepthTestFunc = GfxComparisonFunc::GreaterEqual;
+
+	Bool UseInfiniteFarPlane();
+
+	//view space depth is 1 / (depth * scale + bias), for an infinite far plane the bias is 0
+	struct DepthLinearization
+	{
+		Float scale;
+		Float bias;
+	};
+
+	Matrix CreateReverseZProjection(Float fov, Float aspect_ratio, Float near_plane, Float far_plane, Bool infinite_far);
+	DepthLinearization ComputeDepthLinearization(Float near_plane, Float far_plane, Bool infinite_far);
+	//view space frustum for culling, it always ends at far_plane even if the projection is infinite
+	BoundingFrustum CreateViewFrustum(Float fov, Float aspect_ratio, Float near_plane, Float far_plane);
+
+	inline Float LinearizeDepth(Float depth, DepthLinearization const& linearization)
+	{
+		return 1.0f / (depth * linearization.scale + linearization.bias);
+	}
+	inline Float DelinearizeDepth(Float view_depth, DepthLinearization const& linearization)
+	{
+		return (1.0f / view_depth - linearization.bias) / linearization.scale;
+	}
+}
@@ -111,7 +111,7 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx("Exponential Height Fog", 0))
 				{
-					ImGui::Checkbox("Enable Fog", Fog.GetPtr());
+					GUI_Checkbox("Enable Fog", *Fog);
 					if (Fog.Get())
 					{
 						ImGui::SliderFloat("Fog Falloff", &params.fog_falloff, 0.0001f, 10.0f);
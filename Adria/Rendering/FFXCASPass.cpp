@@ -85,7 +85,7 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx(name_version, ImGuiTreeNodeFlags_None))
 				{
-					ImGui::Checkbox("Enable", CAS.GetPtr());
+					GUI_Checkbox("Enable", *CAS);
 					if (CAS.Get())
 					{
 						ImGui::SliderFloat("Sharpness", &sharpness, 0.0f, 1.0f, "%.2f");
@@ -98,7 +98,7 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx(name_version, ImGuiTreeNodeFlags_None))
 				{
-					ImGui::Checkbox("Enable", FFXDepthOfField.GetPtr());
+					GUI_Checkbox("Enable", *FFXDepthOfField);
 					if (FFXDepthOfField.Get())
 					{
 						ImGui::SliderFloat("Aperture", &aperture, 0.0f, 0.1f, "%.2f");
@@ -172,21 +172,21 @@ namespace adria
 			{
 				if (ImGui::TreeNode("Variable Rate Shading"))
 				{
-					ImGui::Checkbox("Enable", VariableRateShading.GetPtr());
+					GUI_Checkbox("Enable", *VariableRateShading);
 					if (VariableRateShading.Get())
 					{
-						if (ImGui::Combo("Shading Rate", VariableRateShadingMode.GetPtr(), "1x1\0 1x2\0 2x1\0 2x2\0 2x4\0 4x2\0 4x4\0", 7))
+						if (GUI_Combo("Shading Rate", *VariableRateShadingMode, "1x1\0 1x2\0 2x1\0 2x2\0 2x4\0 4x2\0 4x4\0", 7))
 						{
 							//#todo verify support
 						}
-						ImGui::Combo("Shading Rate Combiner", VariableRateShadingCombiner.GetPtr(), "Passthrough\0 Override\0 Min\0 Max\0 Sum\0", 5);
-						ImGui::Checkbox("Shading Rate Image", VariableRateShadingImage.GetPtr());
+						GUI_Combo("Shading Rate Combiner", *VariableRateShadingCombiner, "Passthrough\0 Override\0 Min\0 Max\0 Sum\0", 5);
+						GUI_Checkbox("Shading Rate Image", *VariableRateShadingImage);
 
 						if (VariableRateShadingImage.Get())
 						{
-							ImGui::SliderFloat("Threshold", VariableRateShadingThreshold.GetPtr(), 0.0f, 0.1f);
-							ImGui::SliderFloat("Motion Factor", VariableRateShadingMotionFactor.GetPtr(), 0.0f, 0.1f);
-							ImGui::Checkbox("Draw Overlay", VariableRateShadingOverlay.GetPtr());
+							GUI_SliderFloat("Threshold", *VariableRateShadingThreshold, 0.0f, 0.1f);
+							GUI_SliderFloat("Motion Factor", *VariableRateShadingMotionFactor, 0.0f, 0.1f);
+							GUI_Checkbox("Draw Overlay", *VariableRateShadingOverlay);
 						}
 					}
 					ImGui::TreePop();
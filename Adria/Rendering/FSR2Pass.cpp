@@ -47,14 +47,18 @@ namespace adria
 
 	void FSR2Pass::AddPass(RenderGraph& rg, PostProcessor* postprocessor)
 	{
+		FrameBlackboardData const& frame_data = rg.GetBlackboard().Get<FrameBlackboardData>();
+		if (frame_data.camera_infinite_far != infinite_depth)
+		{
+			infinite_depth = frame_data.camera_infinite_far;
+			recreate_context = true;
+		}
 		if (recreate_context)
 		{
 			DestroyContext();
 			CreateContext();
 		}
 
-		FrameBlackboardData const& frame_data = rg.GetBlackboard().Get<FrameBlackboardData>();
-
 		struct FSR2PassData
 		{
 			RGTextureReadOnlyId input;
@@ -108,8 +112,9 @@ namespace adria
 				dispatch_desc.preExposure = 1.0f;
 				dispatch_desc.renderSize.width = render_width;
 				dispatch_desc.renderSize.height = render_height;
-				dispatch_desc.cameraFar = frame_data.camera_far;
-				dispatch_desc.cameraNear = frame_data.camera_near;
+				//the camera planes are stored in depth order, fsr sorts them and with infinite depth only uses the smaller one
+				dispatch_desc.cameraFar = frame_data.camera_infinite_far ? FLT_MAX : frame_data.camera_far;
+				dispatch_desc.cameraNear = frame_data.camera_infinite_far ? std::min(frame_data.camera_near, frame_data.camera_far) : frame_data.camera_near;
 				dispatch_desc.cameraFovAngleVertical = frame_data.camera_fov;
 
 				FfxErrorCode error_code = ffxFsr2ContextDispatch(&fsr2_context, &dispatch_desc);
@@ -126,6 +131,12 @@ namespace adria
 		return true;
 	}
 
+	JitterSequenceDesc FSR2Pass::GetJitterSequenceDesc(Uint32 render_width, Uint32 display_width) const
+	{
+		//the sdk rounds the phase count up, use its count so the sequence matches what the context expects
+		return JitterSequenceDesc{ .type = JitterSequenceType::Halton, .phase_count = (Uint32)ffxFsr2GetJitterPhaseCount((Int32)render_width, (Int32)display_width) };
+	}
+
 	void FSR2Pass::GUI()
 	{
 		QueueGUI([&]()
@@ -162,6 +173,7 @@ namespace adria
 		fsr2_context_desc.displaySize.width = display_width;
 		fsr2_context_desc.displaySize.height = display_height;
 		fsr2_context_desc.flags = FFX_FSR2_ENABLE_HIGH_DYNAMIC_RANGE | FFX_FSR2_ENABLE_AUTO_EXPOSURE | FFX_FSR2_ENABLE_DEPTH_INVERTED;
+		if (infinite_depth) fsr2_context_desc.flags |= FFX_FSR2_ENABLE_DEPTH_INFINITE;
 
 		FfxErrorCode error_code = ffxFsr2ContextCreate(&fsr2_context, &fsr2_context_desc);
 		ADRIA_ASSERT(error_code == FFX_OK);
@@ -23,6 +23,7 @@ namespace adria
 		virtual void AddPass(RenderGraph&, PostProcessor*) override;
 		virtual Bool IsEnabled(PostProcessor const*) const override;
 		virtual void GUI() override;
+		virtual JitterSequenceDesc GetJitterSequenceDesc(Uint32 render_width, Uint32 display_width) const override;
 
 	private:
 		Char name_version[16] = {};
@@ -34,6 +35,7 @@ namespace adria
 		FfxFsr2ContextDescription fsr2_context_desc{};
 		FfxFsr2Context fsr2_context{};
 		Bool recreate_context = true;
+		Bool infinite_depth = false;
 
 		FfxFsr2QualityMode fsr2_quality_mode = FFX_FSR2_QUALITY_MODE_QUALITY;
 		Float custom_upscale_ratio = 1.0f;
@@ -25,6 +25,7 @@ namespace adria
 		virtual void AddPass(RenderGraph&, PostProcessor*) override;
 		virtual Bool IsEnabled(PostProcessor const*) const override;
 		virtual void GUI() override;
+		virtual JitterSequenceDesc GetJitterSequenceDesc(Uint32 render_width, Uint32 display_width) const override;
 
 	private:
 		Char name_version[16] = {};
@@ -36,6 +37,7 @@ namespace adria
 		FfxFsr3ContextDescription fsr3_context_desc{};
 		FfxFsr3Context fsr3_context{};
 		Bool recreate_context = true;
+		Bool infinite_depth = false;
 
 		FfxFsr3QualityMode fsr3_quality_mode = FFX_FSR3_QUALITY_MODE_QUALITY;
 		Float custom_upscale_ratio = 1.0f;
@@ -72,7 +72,7 @@ namespace adria
 	{
 		QueueGUI([&]()
 			{
-				ImGui::Checkbox("FXAA", FXAA.GetPtr());
+				GUI_Checkbox("FXAA", *FXAA);
 			}, GUICommandGroup_PostProcessing, GUICommandSubGroup_Antialiasing);
 	}
 
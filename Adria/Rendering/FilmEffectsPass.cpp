@@ -107,7 +107,7 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx("Film Effects", ImGuiTreeNodeFlags_None))
 				{
-					ImGui::Checkbox("Enable Film Effects", FilmEffects.GetPtr());
+					GUI_Checkbox("Enable Film Effects", *FilmEffects);
 					if (FilmEffects.Get())
 					{
 						ImGui::Checkbox("Lens Distortion", &lens_distortion_enabled);
@@ -0,0 +1,182 @@
+#include "FrameCapture.h"
+#include "Graphics/GfxDevice.h"
+#include "Graphics/GfxBuffer.h"
+#include "Graphics/GfxCommandList.h"
+#include "RenderGraph/RenderGraph.h"
+#include "Core/Paths.h"
+#include "Utilities/Align.h"
+#include "Utilities/ThreadPool.h"
+#include "Utilities/StringConversions.h"
+
+namespace adria
+{
+	ADRIA_LOG_CHANNEL(Renderer);
+
+	static TAutoConsoleVariable<Int> CaptureFileType("r.Capture.FileType", (Int)FileType::PNG, "File type of screenshots and captures of the final image: 0 - PNG, 1 - JPG, 2 - HDR, 3 - TGA, 4 - BMP",
+		ConsoleVariableMetadata{ .enum_names = { "PNG", "JPG", "HDR", "TGA", "BMP" } });
+
+	static std::optional<ImageDataFormat> GetImageDataFormat(GfxFormat format)
+	{
+		switch (format)
+		{
+		case GfxFormat::R8G8B8A8_UNORM:
+		case GfxFormat::R8G8B8A8_UNORM_SRGB:	return ImageDataFormat::RGBA8;
+		case GfxFormat::R16G16B16A16_FLOAT:		return ImageDataFormat::RGBA16F;
+		case GfxFormat::R32G32B32A32_FLOAT:		return ImageDataFormat::RGBA32F;
+		}
+		return std::nullopt;
+	}
+
+	FrameCapture::FrameCapture(GfxDevice* gfx) : gfx(gfx),
+		capture_command("r.Capture", " Captures frames to the screenshots folder. Optional arguments are: [name, frame count, hdr]",
+			ConsoleCommandWithArgsDelegate::CreateMember(&FrameCapture::OnCaptureCommand, *this))
+	{
+		fence.Create(gfx, "Frame Capture Fence");
+	}
+
+	FrameCapture::~FrameCapture()
+	{
+		WriteCompletedReadbacks(true);
+		for (std::future<void>& pending_write : pending_writes) pending_write.wait();
+	}
+
+	void FrameCapture::Request(FrameCaptureDesc const& desc)
+	{
+		if (desc.frame_count == 0) return;
+		requests.push(desc);
+	}
+
+	void FrameCapture::AddCapturePass(RenderGraph& rg)
+	{
+		WriteCompletedReadbacks(false);
+		if (requests.empty()) return;
+
+		FrameCaptureDesc const& request = requests.front();
+		RGResourceName source_name = RG_NAME(FinalTexture);
+		if (request.source == FrameCaptureSource::HDR)
+		{
+			if (rg.IsTextureDeclared(RG_NAME(HDR_RenderTarget))) source_name = RG_NAME(HDR_RenderTarget);
+			else ADRIA_LOG(WARNING, "HDR capture requested but the current lighting path has no HDR target, capturing the final image");
+		}
+
+		RGTextureDesc const source_desc = rg.GetTextureDesc(source_name);
+		std::optional<ImageDataFormat> data_format = GetImageDataFormat(source_desc.format);
+		if (!data_format)
+		{
+			ADRIA_LOG(WARNING, "Capture source format is not supported, dropping capture %s", request.name.c_str());
+			requests.pop();
+			captured_frames = 0;
+			return;
+		}
+
+		//rows of the copy are padded to the texture data pitch alignment, see GfxCommandList::CopyTextureToBuffer
+		std::unique_ptr<Readback> readback = std::make_unique<Readback>();
+		readback->row_pitch = (Uint32)AlignUp(GetRowPitch(source_desc.format, source_desc.width), D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
+		readback->width = source_desc.width;
+		readback->height = source_desc.height;
+		readback->data_format = *data_format;
+		readback->file_type = request.source == FrameCaptureSource::HDR ? FileType::HDR : request.file_type;
+		readback->fence_value = ++fence_value;
+
+		std::string file_name = request.name;
+		if (request.frame_count > 1)
+		{
+			Char frame_suffix[16];
+			snprintf(frame_suffix, sizeof(frame_suffix), "_%04u", captured_frames);
+			file_name += frame_suffix;
+		}
+		readback->path = paths::ScreenshotsDir + file_name + GetFileTypeExtension(readback->file_type);
+
+		GfxBufferDesc readback_desc{};
+		readback_desc.size = (Uint64)readback->row_pitch * readback->height;
+		readback_desc.resource_usage = GfxResourceUsage::Readback;
+		readback->buffer = gfx->CreateBuffer(readback_desc);
+		rg.ImportBuffer(RG_NAME(FrameCaptureBuffer), readback->buffer.get());
+
+		struct FrameCapturePassData
+		{
+			RGBufferCopyDstId  dst;
+			RGTextureCopySrcId src;
+		};
+		Uint64 const capture_fence_value = readback->fence_value;
+		rg.AddPass<FrameCapturePassData>("Frame Capture Pass",
+			[=](FrameCapturePassData& data, RenderGraphBuilder& builder)
+			{
+				data.dst = builder.WriteCopyDstBuffer(RG_NAME(FrameCaptureBuffer));
+				data.src = builder.ReadCopySrcTexture(source_name);
+			},
+			[=](FrameCapturePassData const& data, RenderGraphContext& ctx)
+			{
+				GfxCommandList* cmd_list = ctx.GetCommandList();
+				GfxTexture const& src_texture = ctx.GetCopySrcTexture(data.src);
+				GfxBuffer& dst_buffer = ctx.GetCopyDstBuffer(data.dst);
+				cmd_list->CopyTextureToBuffer(dst_buffer, 0, src_texture, 0, 0);
+				cmd_list->Signal(fence, capture_fence_value);
+			}, RGPassType::Copy, RGPassFlags::ForceNoCull);
+
+		readbacks.push_back(std::move(readback));
+		if (++captured_frames == request.frame_count)
+		{
+			requests.pop();
+			captured_frames = 0;
+		}
+	}
+
+	void FrameCapture::OnCaptureCommand(std::span<Char const*> args)
+	{
+		FrameCaptureDesc desc{};
+		desc.name = args.size() > 0 ? args[0] : "adria_capture";
+		desc.file_type = (FileType)std::clamp(CaptureFileType.Get(), 0, (Int)FileType::BMP);
+		if (args.size() > 1)
+		{
+			Int frame_count = 0;
+			if (!FromCString(args[1], frame_count) || frame_count <= 0)
+			{
+				ADRIA_LOG(WARNING, "r.Capture: invalid frame count %s", args[1]);
+				return;
+			}
+			desc.frame_count = (Uint32)frame_count;
+		}
+		if (args.size() > 2)
+		{
+			Bool hdr = false;
+			if (!FromCString(args[2], hdr))
+			{
+				ADRIA_LOG(WARNING, "r.Capture: invalid hdr flag %s", args[2]);
+				return;
+			}
+			desc.source = hdr ? FrameCaptureSource::HDR : FrameCaptureSource::Final;
+		}
+		Request(desc);
+	}
+
+	void FrameCapture::WriteCompletedReadbacks(Bool wait)
+	{
+		std::erase_if(pending_writes, [](std::future<void> const& pending_write) { return pending_write.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+
+		Uint64 const completed_value = fence.GetCompletedValue();
+		for (std::unique_ptr<Readback>& readback : readbacks)
+		{
+			if (readback->fence_value > completed_value)
+			{
+				if (!wait) continue;
+				fence.Wait(readback->fence_value);
+			}
+
+			std::shared_ptr<Readback> completed_readback = std::move(readback);
+			pending_writes.push_back(g_ThreadPool.Submit([completed_readback]()
+				{
+					Readback const& rb = *completed_readback;
+					if (WriteImageToFile(rb.file_type, rb.path, rb.width, rb.height, rb.buffer->GetMappedData(), rb.row_pitch, rb.data_format))
+					{
+						ADRIA_LOG(INFO, "Capture saved to %s", rb.path.c_str());
+					}
+					else
+					{
+						ADRIA_LOG(WARNING, "Failed to write capture %s", rb.path.c_str());
+					}
+				}));
+		}
+		std::erase(readbacks, nullptr);
+	}
+}
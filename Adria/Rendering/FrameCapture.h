@@ -0,0 +1,67 @@
+#pragma once
+#include "Graphics/GfxFence.h"
+#include "Core/ConsoleManager.h"
+#include "Utilities/ImageWrite.h"
+
+namespace adria
+{
+	class GfxDevice;
+	class GfxBuffer;
+	class RenderGraph;
+
+	enum class FrameCaptureSource : Uint8
+	{
+		Final,	//tonemapped output at display resolution
+		HDR		//pre-tonemap lighting target at render resolution
+	};
+
+	struct FrameCaptureDesc
+	{
+		std::string name;
+		FrameCaptureSource source = FrameCaptureSource::Final;
+		FileType file_type = FileType::PNG;
+		Uint32 frame_count = 1;	//captures of more than one frame are numbered, name_0000, name_0001...
+	};
+
+	//queue of screenshots and frame sequences. every captured frame is copied to its own readback buffer,
+	//once the gpu is done with the copy the image is written to the screenshots folder on the thread pool
+	class FrameCapture
+	{
+		struct Readback
+		{
+			std::unique_ptr<GfxBuffer> buffer;
+			Uint64 fence_value;
+			std::string path;
+			FileType file_type;
+			ImageDataFormat data_format;
+			Uint32 width;
+			Uint32 height;
+			Uint32 row_pitch;
+		};
+
+	public:
+		explicit FrameCapture(GfxDevice* gfx);
+		ADRIA_NONCOPYABLE_NONMOVABLE(FrameCapture)
+		~FrameCapture();
+
+		void Request(FrameCaptureDesc const& desc);
+		Bool IsCapturing() const { return !requests.empty(); }
+
+		//call once per frame after the frame's final texture is written
+		void AddCapturePass(RenderGraph& rg);
+
+	private:
+		GfxDevice* gfx;
+		GfxFence fence;
+		Uint64 fence_value = 0;
+		std::queue<FrameCaptureDesc> requests;
+		Uint32 captured_frames = 0;
+		std::vector<std::unique_ptr<Readback>> readbacks;
+		std::vector<std::future<void>> pending_writes;
+		AutoConsoleCommand capture_command;
+
+	private:
+		void OnCaptureCommand(std::span<Char const*> args);
+		void WriteCompletedReadbacks(Bool wait);
+	};
+}
@@ -2,6 +2,7 @@
 #include "ShaderStructs.h"
 #include "Components.h"
 #include "BlackboardData.h"
+#include "DepthProjection.h"
 #include "ShaderManager.h"
 #include "RendererDebugViewPass.h"
 #include "Graphics/GfxReflection.h"
@@ -50,7 +51,7 @@ namespace adria
 				depth_desc.width = width;
 				depth_desc.height = height;
 				depth_desc.format = GfxFormat::R32_TYPELESS;
-				depth_desc.clear_value = GfxClearValue(0.0f, 0);
+				depth_desc.clear_value = GfxClearValue(DepthClearValue, 0);
 				builder.DeclareTexture(RG_NAME(DepthStencil), depth_desc);
 				builder.WriteDepthStencil(RG_NAME(DepthStencil), RGLoadStoreAccessOp::Clear_Preserve);
 				builder.SetViewport(width, height);
@@ -114,7 +115,7 @@ namespace adria
 		gbuffer_pso_desc.PS = PS_GBuffer;
 		gbuffer_pso_desc.depth_state.depth_enable = true;
 		gbuffer_pso_desc.depth_state.depth_write_mask = GfxDepthWriteMask::All;
-		gbuffer_pso_desc.depth_state.depth_func = GfxComparisonFunc::GreaterEqual;
+		gbuffer_pso_desc.depth_state.depth_func = DepthTestFunc;
 		gbuffer_pso_desc.num_render_targets = 4u;
 		gbuffer_pso_desc.rtv_formats[0] = GfxFormat::R8G8B8A8_UNORM;
 		gbuffer_pso_desc.rtv_formats[1] = GfxFormat::R8G8B8A8_UNORM;
@@ -2,6 +2,7 @@
 #include "ShaderStructs.h"
 #include "Components.h"
 #include "BlackboardData.h"
+#include "DepthProjection.h"
 #include "ShaderManager.h"
 #include "RendererDebugViewPass.h"
 #include "RenderGraph/RenderGraph.h"
@@ -79,7 +80,7 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx("GPU Driven Rendering", ImGuiTreeNodeFlags_None))
 				{
-					ImGui::Checkbox("Enable", GpuDrivenRendering.GetPtr());
+					GUI_Checkbox("Enable", *GpuDrivenRendering);
 					if (GpuDrivenRendering.Get())
 					{
 						ImGui::Checkbox("Occlusion Cull", &occlusion_culling);
@@ -169,7 +170,7 @@ namespace adria
 		mesh_pso_desc.PS = PS_DrawMeshlets;
 		mesh_pso_desc.depth_state.depth_enable = true;
 		mesh_pso_desc.depth_state.depth_write_mask = GfxDepthWriteMask::All;
-		mesh_pso_desc.depth_state.depth_func = GfxComparisonFunc::GreaterEqual;
+		mesh_pso_desc.depth_state.depth_func = DepthTestFunc;
 		mesh_pso_desc.num_render_targets = 4u;
 		mesh_pso_desc.rtv_formats[0] = GfxFormat::R8G8B8A8_UNORM;
 		mesh_pso_desc.rtv_formats[1] = GfxFormat::R8G8B8A8_UNORM;
@@ -544,7 +545,7 @@ namespace adria
 				depth_desc.width = width;
 				depth_desc.height = height;
 				depth_desc.format = GfxFormat::D32_FLOAT;
-				depth_desc.clear_value = GfxClearValue(0.0f, 0);
+				depth_desc.clear_value = GfxClearValue(DepthClearValue, 0);
 				builder.DeclareTexture(RG_NAME(DepthStencil), depth_desc);
 				builder.WriteDepthStencil(RG_NAME(DepthStencil), RGLoadStoreAccessOp::Clear_Preserve);
 				builder.SetViewport(width, height);
@@ -5,86 +5,17 @@
 #include "Graphics/GfxCommandList.h"
 #include "RenderGraph/RenderGraph.h"
 #include "Core/FatalAssert.h"
-#include "Utilities/BufferReader.h"
+#include "Core/ConsoleManager.h"
+#include "ShaderManager.h"
 #endif
+#include "Core/Paths.h"
 
 namespace adria
 {
-#if GFX_SHADER_ASSERT
-	enum GpuAssertType : Uint32
-	{
-		GpuAssertType_Invalid,
-		GpuAssertType_Generic,
-		GpuAssertType_IndexOutOfBounds
-	};
-
-	struct GpuAssertHeader
-	{
-		Uint32 type;
-		Uint32 arg_count;
-	};
-
-	struct GpuAssertArgs1
-	{
-		Uint32 arg0;
-	};
-	struct GpuAssertArgs2
-	{
-		Uint32 arg0, arg1;
-	};
-	struct GpuAssertArgs3
-	{
-		Uint32 arg0, arg1, arg2;
-	};
-	struct GpuAssertArgs4
-	{
-		Uint32 arg0, arg1, arg2, arg3;
-	};
+	ADRIA_LOG_CHANNEL(Renderer);
 
-	std::string GetAssertArgs(BufferReader& reader, Uint32 arg_count)
-	{
-		switch (arg_count)
-		{
-		case 0: return "";
-		case 1:
-		{
-			GpuAssertArgs1 args = *reader.Consume<GpuAssertArgs1>();
-			return std::to_string(args.arg0);
-		}
-		case 2:
-		{
-			GpuAssertArgs2 args = *reader.Consume<GpuAssertArgs2>();
-			return "(" + std::to_string(args.arg0) + "," + std::to_string(args.arg1) + ")";
-		}
-		case 3:
-		{
-			GpuAssertArgs3 args = *reader.Consume<GpuAssertArgs3>();
-			return "(" + std::to_string(args.arg0) + "," + std::to_string(args.arg1) + "," + std::to_string(args.arg2) + ")";
-		}
-		case 4:
-		{
-			GpuAssertArgs4 args = *reader.Consume<GpuAssertArgs4>();
-			return "(" + std::to_string(args.arg0) + "," + std::to_string(args.arg1) + "," + std::to_string(args.arg2) + "," + std::to_string(args.arg3) + ")";
-		}
-		}
-		ADRIA_UNREACHABLE();
-		return "";
-	}
-	static std::string GetAssertMessage(BufferReader& reader, Uint32 arg_count, GpuAssertType type)
-	{
-		switch (type)
-		{
-		case GpuAssertType_Generic:
-		{
-			return "Generic Gpu Assert:" + GetAssertArgs(reader, arg_count);
-		}
-		case GpuAssertType_IndexOutOfBounds:
-			ADRIA_ASSERT(arg_count == 2);
-			return "IndexOutOfBounds Gpu Assert:" + GetAssertArgs(reader, arg_count);
-		}
-		ADRIA_UNREACHABLE();
-		return "";
-	}
+#if GFX_SHADER_ASSERT
+	static TAutoConsoleVariable<Bool> FatalGpuAsserts("r.GpuAssert.Fatal", true, "Whether the first failure of a gpu assert site triggers a fatal assert");
 
 	GpuAssert::GpuAssert(GfxDevice* gfx) : GpuDebugFeature(gfx, RG_NAME(GpuAssertBuffer)) {}
 	Int32 GpuAssert::GetAssertBufferIndex() { return GetBufferIndex(); }
@@ -92,16 +23,42 @@ namespace adria
 	void GpuAssert::AddAssertPass(RenderGraph& rg) { return GpuDebugFeature::AddFeaturePass(rg, "Copy Assert Buffer Pass"); }
 	void GpuAssert::ProcessBufferData(GfxBuffer& old_readback_buffer)
 	{
-		static constexpr Uint32 MaxGpuAssertArgs = 4;
-		BufferReader assert_reader(old_readback_buffer.GetMappedData<Uint8>() + sizeof(Uint32), (Uint32)old_readback_buffer.GetSize() - sizeof(Uint32));
-		while (assert_reader.HasMoreData(sizeof(GpuAssertHeader)))
+		records.clear();
+		std::span<Uint8 const> buffer_data(old_readback_buffer.GetMappedData<Uint8>(), old_readback_buffer.GetSize());
+		GpuAssertDecodeStats const decode_stats = DecodeGpuAssertBuffer(buffer_data, records);
+		if (decode_stats.truncated) ADRIA_LOG(WARNING, "GpuAssert buffer overflowed, the last failures of the frame were dropped");
+		if (decode_stats.corrupt) ADRIA_LOG(WARNING, "GpuAssert buffer contains a corrupt record, skipping the rest of the frame");
+
+		std::vector<Uint64> const new_sites = aggregator.Add(records, gfx->GetFrameIndex());
+		for (Uint64 site_idx : new_sites)
 		{
-			GpuAssertHeader const* header = assert_reader.Consume<GpuAssertHeader>();
-			if (header->type == GpuAssertType_Invalid || header->arg_count > MaxGpuAssertArgs) break;
+			GpuAssertSite const& site = aggregator.GetSites()[site_idx];
+			std::string args;
+			if (!site.samples.empty())
+			{
+				GpuAssertRecord const& sample = site.samples.front();
+				for (Uint32 i = 0; i < sample.arg_count; ++i)
+				{
+					args += (i == 0 ? "" : ",") + std::to_string(sample.args[i]);
+				}
+			}
+			std::string const shader_name = ShaderManager::GetShaderName((ShaderID)site.shader_id);
+			ADRIA_LOG(ERROR, "%s Gpu Assert in %s, line %u: (%s)", GetGpuAssertTypeName(site.type), shader_name.c_str(), site.line, args.c_str());
+			assert_failed_event.Broadcast(site);
+			ADRIA_FATAL_ASSERT(!FatalGpuAsserts.Get(), "%s Gpu Assert in %s, line %u: (%s)", GetGpuAssertTypeName(site.type), shader_name.c_str(), site.line, args.c_str());
+		}
+	}
 
-			std::string assert_msg = GetAssertMessage(assert_reader, header->arg_count, (GpuAssertType)header->type);
-			ADRIA_FATAL_ASSERT(false, assert_msg.c_str());
+	Bool GpuAssert::WriteReport(std::string const& report_path) const
+	{
+		std::ofstream report_file(report_path);
+		if (!report_file.is_open())
+		{
+			ADRIA_LOG(WARNING, "Could not open %s for writing the gpu assert report", report_path.c_str());
+			return false;
 		}
+		report_file << aggregator.ToJson([](Uint32 shader_id) { return ShaderManager::GetShaderName((ShaderID)shader_id); });
+		return true;
 	}
 #else
 	GpuAssert::GpuAssert(GfxDevice* gfx) : GpuDebugFeature(gfx, RG_NAME(AssertBuffer)) {}
@@ -109,7 +66,14 @@ namespace adria
 	void GpuAssert::AddClearPass(RenderGraph& rg) {}
 	void GpuAssert::AddAssertPass(RenderGraph& rg) {}
 	void GpuAssert::ProcessBufferData(GfxBuffer&) {}
+	Bool GpuAssert::WriteReport(std::string const&) const { return false; }
 #endif
-	GpuAssert::~GpuAssert() = default;
+	GpuAssert::~GpuAssert()
+	{
+		if (aggregator.GetFailureCount() > 0)
+		{
+			WriteReport(paths::LogDir + "GpuAsserts.json");
+		}
+	}
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 #include "GpuDebugFeature.h"
+#include "GpuAssertDecoder.h"
+#include "Utilities/Delegate.h"
 
 namespace adria
 {
@@ -7,18 +9,30 @@ namespace adria
 	class GfxBuffer;
 	class RenderGraph;
 
+	DECLARE_MULTICAST_DELEGATE(GpuAssertFailedEvent, GpuAssertSite const&)
+
+	//failures are aggregated per assert site for the whole run and written to a json report on shutdown
 	class GpuAssert : public GpuDebugFeature
 	{
 	public:
 		explicit GpuAssert(GfxDevice* gfx);
-		ADRIA_NONCOPYABLE(GpuAssert)
-		ADRIA_DEFAULT_MOVABLE(GpuAssert)
+		ADRIA_NONCOPYABLE_NONMOVABLE(GpuAssert)
 		~GpuAssert();
 
 		Int32 GetAssertBufferIndex();
 		void AddClearPass(RenderGraph& rg);
 		void AddAssertPass(RenderGraph& rg);
 
+		//broadcast the first time an assert site fails, e.g. for a test harness to abort the run
+		GpuAssertFailedEvent& GetAssertFailedEvent() { return assert_failed_event; }
+		GpuAssertAggregator const& GetAggregator() const { return aggregator; }
+		Bool WriteReport(std::string const& report_path) const;
+
+	private:
+		GpuAssertAggregator aggregator;
+		std::vector<GpuAssertRecord> records;
+		GpuAssertFailedEvent assert_failed_event;
+
 	private:
 		virtual void ProcessBufferData(GfxBuffer&) override;
 	};
@@ -0,0 +1,135 @@
+#include "GpuAssertDecoder.h"
+#include "Utilities/Json.h"
+
+namespace adria
+{
+	namespace
+	{
+		struct GpuAssertHeader
+		{
+			Uint32 type;
+			Uint32 arg_count;
+			Uint32 shader_id;
+			Uint32 line;
+		};
+
+		Uint64 GetSiteKey(GpuAssertRecord const& record)
+		{
+			//line and type fit in 24 and 8 bits for any real shader
+			return ((Uint64)record.shader_id << 32) | ((Uint64)(record.line & 0xFFFFFF) << 8) | (record.type & 0xFF);
+		}
+	}
+
+	Char const* GetGpuAssertTypeName(Uint32 type)
+	{
+		switch (type)
+		{
+		case GpuAssertType_Generic: return "Generic";
+		case GpuAssertType_IndexOutOfBounds: return "IndexOutOfBounds";
+		}
+		return "Invalid";
+	}
+
+	GpuAssertDecodeStats DecodeGpuAssertBuffer(std::span<Uint8 const> data, std::vector<GpuAssertRecord>& records)
+	{
+		GpuAssertDecodeStats stats{};
+		if (data.size() < sizeof(Uint32)) return stats;
+
+		Uint32 written_bytes;
+		memcpy(&written_bytes, data.data(), sizeof(Uint32));
+		Uint64 const available_bytes = data.size() - sizeof(Uint32);
+		Uint64 const end = sizeof(Uint32) + std::min<Uint64>(written_bytes, available_bytes);
+		stats.truncated = written_bytes > available_bytes;
+
+		Uint64 offset = sizeof(Uint32);
+		while (offset + sizeof(GpuAssertHeader) <= end)
+		{
+			GpuAssertHeader header;
+			memcpy(&header, data.data() + offset, sizeof(GpuAssertHeader));
+			if (header.type == GpuAssertType_Invalid || header.type >= GpuAssertType_Count || header.arg_count > GpuAssertMaxArgs)
+			{
+				stats.corrupt = true;
+				break;
+			}
+
+			Uint64 const args_size = header.arg_count * sizeof(Uint32);
+			Uint64 const record_end = offset + sizeof(GpuAssertHeader) + args_size;
+			if (record_end > end)
+			{
+				stats.truncated = true;
+				break;
+			}
+
+			GpuAssertRecord record{};
+			record.type = header.type;
+			record.shader_id = header.shader_id;
+			record.line = header.line;
+			record.arg_count = header.arg_count;
+			memcpy(record.args, data.data() + offset + sizeof(GpuAssertHeader), args_size);
+			records.push_back(record);
+			++stats.record_count;
+			offset = record_end;
+		}
+		return stats;
+	}
+
+	std::vector<Uint64> GpuAssertAggregator::Add(std::span<GpuAssertRecord const> records, Uint64 frame)
+	{
+		std::vector<Uint64> new_sites;
+		for (GpuAssertRecord const& record : records)
+		{
+			++failure_count;
+			auto [it, inserted] = site_indices.try_emplace(GetSiteKey(record), sites.size());
+			if (inserted)
+			{
+				sites.push_back(GpuAssertSite{ .shader_id = record.shader_id, .line = record.line, .type = record.type, .count = 0, .first_frame = frame });
+				new_sites.push_back(it->second);
+			}
+			GpuAssertSite& site = sites[it->second];
+			++site.count;
+			site.last_frame = frame;
+			if (site.samples.size() < max_samples_per_site) site.samples.push_back(record);
+		}
+		return new_sites;
+	}
+
+	void GpuAssertAggregator::Clear()
+	{
+		failure_count = 0;
+		sites.clear();
+		site_indices.clear();
+	}
+
+	std::string GpuAssertAggregator::ToJson(std::function<std::string(Uint32)> const& shader_name) const
+	{
+		std::vector<GpuAssertSite const*> sorted_sites;
+		sorted_sites.reserve(sites.size());
+		for (GpuAssertSite const& site : sites) sorted_sites.push_back(&site);
+		std::stable_sort(sorted_sites.begin(), sorted_sites.end(), [](GpuAssertSite const* a, GpuAssertSite const* b) { return a->count > b->count; });
+
+		json report = json::object();
+		report["failure_count"] = failure_count;
+		report["site_count"] = sites.size();
+		json site_array = json::array();
+		for (GpuAssertSite const* site : sorted_sites)
+		{
+			json samples = json::array();
+			for (GpuAssertRecord const& sample : site->samples)
+			{
+				samples.push_back(std::vector<Uint32>(sample.args, sample.args + sample.arg_count));
+			}
+			site_array.push_back({
+				{ "shader", shader_name ? shader_name(site->shader_id) : std::to_string(site->shader_id) },
+				{ "shader_id", site->shader_id },
+				{ "line", site->line },
+				{ "type", GetGpuAssertTypeName(site->type) },
+				{ "count", site->count },
+				{ "first_frame", site->first_frame },
+				{ "last_frame", site->last_frame },
+				{ "samples", std::move(samples) }
+			});
+		}
+		report["sites"] = std::move(site_array);
+		return report.dump(4);
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+namespace adria
+{
+	//keep in sync with GpuAssert.hlsli
+	enum GpuAssertType : Uint32
+	{
+		GpuAssertType_Invalid,
+		GpuAssertType_Generic,
+		GpuAssertType_IndexOutOfBounds,
+		GpuAssertType_Count
+	};
+	Char const* GetGpuAssertTypeName(Uint32 type);
+
+	static constexpr Uint32 GpuAssertMaxArgs = 4;
+
+	struct GpuAssertRecord
+	{
+		Uint32 type;
+		Uint32 shader_id;	//ShaderID the failing shader was compiled for
+		Uint32 line;
+		Uint32 arg_count;
+		Uint32 args[GpuAssertMaxArgs];
+	};
+
+	struct GpuAssertDecodeStats
+	{
+		Uint32 record_count = 0;
+		Bool truncated = false;
+		Bool corrupt = false;
+	};
+
+	//decodes the contents of the assert buffer: a Uint32 byte count written by the gpu followed by the records.
+	//never reads outside of data, whatever its contents
+	GpuAssertDecodeStats DecodeGpuAssertBuffer(std::span<Uint8 const> data, std::vector<GpuAssertRecord>& records);
+
+	//one assert call site: shader, line and assert type
+	struct GpuAssertSite
+	{
+		Uint32 shader_id;
+		Uint32 line;
+		Uint32 type;
+		Uint64 count;
+		Uint64 first_frame;
+		Uint64 last_frame;
+		std::vector<GpuAssertRecord> samples;
+	};
+
+	//accumulates failures per site over the whole run, keeping the argument payloads of the first few failures of each site
+	class GpuAssertAggregator
+	{
+	public:
+		//every site keeps at least one sample, the first failure of a site is reported with its arguments
+		explicit GpuAssertAggregator(Uint32 max_samples_per_site = 4) : max_samples_per_site(std::max(max_samples_per_site, 1u)) {}
+
+		//returns the indices of the sites that failed for the first time
+		std::vector<Uint64> Add(std::span<GpuAssertRecord const> records, Uint64 frame);
+		void Clear();
+
+		std::vector<GpuAssertSite> const& GetSites() const { return sites; }
+		Uint64 GetFailureCount() const { return failure_count; }
+
+		//sites are sorted by failure count, shader_name turns shader ids into readable names
+		std::string ToJson(std::function<std::string(Uint32)> const& shader_name) const;
+
+	private:
+		Uint32 max_samples_per_site;
+		Uint64 failure_count = 0;
+		std::vector<GpuAssertSite> sites;
+		std::unordered_map<Uint64, Uint64> site_indices;
+	};
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "GpuDebugFeature.h"
+#include "GpuPrintfDecoder.h"
 
 namespace adria
 {
@@ -19,6 +20,12 @@ namespace adria
 		void AddClearPass(RenderGraph& rg);
 		void AddPrintPass(RenderGraph& rg);
 
+	private:
+		std::unique_ptr<GpuPrintfFormatTable> formats;
+		std::vector<GpuPrintfRecord> records;
+		std::vector<GpuPrintfLine> lines;
+		std::vector<GpuPrintfFormatStats> format_stats;
+
 	private:
 		virtual void ProcessBufferData(GfxBuffer&) override;
 	};
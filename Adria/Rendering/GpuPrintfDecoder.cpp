@@ -0,0 +1,233 @@
+#include "GpuPrintfDecoder.h"
+
+namespace adria
+{
+	namespace
+	{
+		struct GpuPrintfHeader
+		{
+			Uint32 num_bytes;
+			Uint32 string_size;
+			Uint32 num_args;
+		};
+
+		//arg codes come in groups of uint, int and float, each with 1 to 4 components
+		Uint32 GetComponentCount(GpuPrintfArgCode code)
+		{
+			return code % 4 + 1;
+		}
+
+		template<typename T>
+		T ReadAt(std::span<Uint8 const> data, Uint64 offset)
+		{
+			T value;
+			memcpy(&value, data.data() + offset, sizeof(T));
+			return value;
+		}
+
+		void AppendComponent(std::string& out, GpuPrintfArgCode code, Uint32 bits)
+		{
+			Char buffer[64];
+			Int length = 0;
+			if (code < GpuPrintfArg_Int)
+			{
+				length = snprintf(buffer, sizeof(buffer), "%u", bits);
+			}
+			else if (code < GpuPrintfArg_Float)
+			{
+				length = snprintf(buffer, sizeof(buffer), "%d", (Int32)bits);
+			}
+			else
+			{
+				Float value;
+				memcpy(&value, &bits, sizeof(Float));
+				length = snprintf(buffer, sizeof(buffer), "%f", value);
+			}
+			out.append(buffer, std::clamp(length, 0, (Int)sizeof(buffer) - 1));
+		}
+
+		void AppendArg(std::string& out, GpuPrintfArg const& arg)
+		{
+			Uint32 const component_count = GetComponentCount(arg.code);
+			if (component_count == 1)
+			{
+				AppendComponent(out, arg.code, arg.data[0]);
+				return;
+			}
+			out += '(';
+			for (Uint32 i = 0; i < component_count; ++i)
+			{
+				if (i > 0) out += ',';
+				AppendComponent(out, arg.code, arg.data[i]);
+			}
+			out += ')';
+		}
+
+		struct GpuPrintfRecordHash
+		{
+			Uint64 operator()(GpuPrintfRecord const& record) const
+			{
+				return std::hash<std::string_view>{}(std::string_view(reinterpret_cast<Char const*>(&record), sizeof(GpuPrintfRecord)));
+			}
+		};
+	}
+
+	Uint32 GpuPrintfFormatTable::Intern(std::string_view format)
+	{
+		if (auto it = ids.find(format); it != ids.end()) return it->second;
+
+		Uint32 const id = (Uint32)formats.size();
+		std::string const& stored = formats.emplace_back(format);
+		ids.emplace(std::string_view(stored), id);
+		return id;
+	}
+
+	GpuPrintfDecodeStats DecodeGpuPrintfBuffer(std::span<Uint8 const> data, GpuPrintfFormatTable& formats, std::vector<GpuPrintfRecord>& records)
+	{
+		GpuPrintfDecodeStats stats{};
+		if (data.size() < sizeof(Uint32)) return stats;
+
+		//the gpu keeps incrementing the byte count after the buffer is full, the writes past the end are dropped
+		Uint64 const written_bytes = ReadAt<Uint32>(data, 0);
+		Uint64 const available_bytes = data.size() - sizeof(Uint32);
+		Uint64 const end = sizeof(Uint32) + std::min(written_bytes, available_bytes);
+		stats.truncated = written_bytes > available_bytes;
+
+		Uint64 offset = sizeof(Uint32);
+		while (offset + sizeof(GpuPrintfHeader) <= end)
+		{
+			GpuPrintfHeader const header = ReadAt<GpuPrintfHeader>(data, offset);
+			if (header.num_bytes == 0 || header.string_size == 0 || header.string_size > header.num_bytes || header.num_args > GpuPrintfMaxArgs)
+			{
+				stats.corrupt = true;
+				break;
+			}
+
+			Uint64 const record_begin = offset + sizeof(GpuPrintfHeader);
+			Uint64 const record_end = record_begin + header.num_bytes;
+			if (record_end > end)
+			{
+				stats.truncated = true;
+				break;
+			}
+
+			//the string size counts the null terminator of the shader literal
+			std::string_view format(reinterpret_cast<Char const*>(data.data() + record_begin), header.string_size);
+			format = format.substr(0, format.find('\0'));
+			if (format.empty())
+			{
+				stats.corrupt = true;
+				break;
+			}
+
+			GpuPrintfRecord record{};
+			record.arg_count = header.num_args;
+			Bool valid_args = true;
+			Uint64 arg_offset = record_begin + header.string_size;
+			for (Uint32 arg_idx = 0; arg_idx < header.num_args; ++arg_idx)
+			{
+				if (arg_offset >= record_end || data[arg_offset] >= GpuPrintfArg_Count)
+				{
+					valid_args = false;
+					break;
+				}
+				GpuPrintfArgCode const code = (GpuPrintfArgCode)data[arg_offset];
+				Uint32 const arg_size = GetComponentCount(code) * sizeof(Uint32);
+				if (arg_offset + 1 + arg_size > record_end)
+				{
+					valid_args = false;
+					break;
+				}
+				record.args[arg_idx].code = code;
+				memcpy(record.args[arg_idx].data, data.data() + arg_offset + 1, arg_size);
+				arg_offset += 1 + arg_size;
+			}
+			if (!valid_args)
+			{
+				stats.corrupt = true;
+				break;
+			}
+
+			record.format_id = formats.Intern(format);
+			records.push_back(record);
+			++stats.record_count;
+			offset = record_end;
+		}
+		return stats;
+	}
+
+	std::string FormatGpuPrintfRecord(GpuPrintfRecord const& record, std::string_view format)
+	{
+		std::string out;
+		out.reserve(format.size() + record.arg_count * 16);
+		for (Uint64 i = 0; i < format.size(); ++i)
+		{
+			if (format[i] == '{' && i + 2 < format.size() && format[i + 2] == '}' && format[i + 1] >= '0' && format[i + 1] < '0' + (Char)record.arg_count)
+			{
+				AppendArg(out, record.args[format[i + 1] - '0']);
+				i += 2;
+				continue;
+			}
+			out += format[i];
+		}
+		return out;
+	}
+
+	Bool GpuPrintfFilter::Passes(GpuPrintfRecord const& record) const
+	{
+		if (!IsActive()) return true;
+		if (record.arg_count == 0) return false;
+
+		GpuPrintfArg const& id_arg = record.args[0];
+		Bool const is_id = id_arg.code == GpuPrintfArg_Uint2 || id_arg.code == GpuPrintfArg_Uint3 ||
+						   id_arg.code == GpuPrintfArg_Int2 || id_arg.code == GpuPrintfArg_Int3;
+		if (!is_id) return false;
+
+		Uint32 const component_count = GetComponentCount(id_arg.code);
+		for (Uint32 i = 0; i < 3; ++i)
+		{
+			if (id[i] < 0) continue;
+			if (i >= component_count || id_arg.data[i] != (Uint32)id[i]) return false;
+		}
+		return true;
+	}
+
+	void AggregateGpuPrintfRecords(std::span<GpuPrintfRecord const> records, GpuPrintfFilter const& filter, Uint32 max_lines_per_format,
+								   std::vector<GpuPrintfLine>& lines, std::vector<GpuPrintfFormatStats>& format_stats)
+	{
+		lines.clear();
+		format_stats.clear();
+
+		std::unordered_map<GpuPrintfRecord, Uint64, GpuPrintfRecordHash> line_indices;
+		std::unordered_map<Uint32, Uint64> stats_indices;
+		std::vector<Uint32> distinct_line_counts;
+		for (GpuPrintfRecord const& record : records)
+		{
+			if (!filter.Passes(record)) continue;
+
+			auto [stats_it, new_format] = stats_indices.try_emplace(record.format_id, format_stats.size());
+			if (new_format)
+			{
+				format_stats.push_back(GpuPrintfFormatStats{ .format_id = record.format_id, .record_count = 0, .suppressed_count = 0 });
+				distinct_line_counts.push_back(0);
+			}
+			GpuPrintfFormatStats& stats = format_stats[stats_it->second];
+			++stats.record_count;
+
+			if (auto line_it = line_indices.find(record); line_it != line_indices.end())
+			{
+				++lines[line_it->second].repeat_count;
+				continue;
+			}
+			Uint32& distinct_lines = distinct_line_counts[stats_it->second];
+			if (distinct_lines >= max_lines_per_format)
+			{
+				++stats.suppressed_count;
+				continue;
+			}
+			++distinct_lines;
+			line_indices.emplace(record, lines.size());
+			lines.push_back(GpuPrintfLine{ .record = record, .repeat_count = 1 });
+		}
+	}
+}
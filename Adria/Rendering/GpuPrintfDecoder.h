@@ -0,0 +1,102 @@
+#pragma once
+
+namespace adria
+{
+	//keep in sync with ArgCode in GpuPrintf.hlsli
+	enum GpuPrintfArgCode : Uint32
+	{
+		GpuPrintfArg_Uint = 0,
+		GpuPrintfArg_Uint2,
+		GpuPrintfArg_Uint3,
+		GpuPrintfArg_Uint4,
+		GpuPrintfArg_Int,
+		GpuPrintfArg_Int2,
+		GpuPrintfArg_Int3,
+		GpuPrintfArg_Int4,
+		GpuPrintfArg_Float,
+		GpuPrintfArg_Float2,
+		GpuPrintfArg_Float3,
+		GpuPrintfArg_Float4,
+		GpuPrintfArg_Count
+	};
+
+	static constexpr Uint32 GpuPrintfMaxArgs = 4;
+
+	struct GpuPrintfArg
+	{
+		GpuPrintfArgCode code;
+		Uint32 data[4];
+	};
+
+	//a decoded record, the format string is referenced by its id in a GpuPrintfFormatTable.
+	//the struct has no padding and unused arguments are zeroed so records can be hashed and compared bytewise
+	struct GpuPrintfRecord
+	{
+		Uint32 format_id;
+		Uint32 arg_count;
+		GpuPrintfArg args[GpuPrintfMaxArgs];
+
+		Bool operator==(GpuPrintfRecord const& other) const
+		{
+			return memcmp(this, &other, sizeof(GpuPrintfRecord)) == 0;
+		}
+	};
+
+	//format strings are interned once, records only carry their ids
+	class GpuPrintfFormatTable
+	{
+	public:
+		GpuPrintfFormatTable() = default;
+		ADRIA_NONCOPYABLE_NONMOVABLE(GpuPrintfFormatTable)
+
+		Uint32 Intern(std::string_view format);
+		std::string const& Get(Uint32 id) const { return formats[id]; }
+		Uint64 Size() const { return formats.size(); }
+
+	private:
+		std::deque<std::string> formats;
+		std::unordered_map<std::string_view, Uint32> ids;
+	};
+
+	struct GpuPrintfDecodeStats
+	{
+		Uint32 record_count = 0;
+		Bool truncated = false;	//the gpu wrote more than the buffer holds, the last records were cut off
+		Bool corrupt = false;	//a record header or argument was invalid, decoding stopped there
+	};
+
+	//decodes the contents of the printf buffer: a Uint32 byte count written by the gpu followed by the records.
+	//never reads outside of data, whatever its contents
+	GpuPrintfDecodeStats DecodeGpuPrintfBuffer(std::span<Uint8 const> data, GpuPrintfFormatTable& formats, std::vector<GpuPrintfRecord>& records);
+
+	//replaces {0} to {3} in the format with the record's arguments
+	std::string FormatGpuPrintfRecord(GpuPrintfRecord const& record, std::string_view format);
+
+	//records pass the filter if their first argument is a uint2/int2 or uint3/int3 whose components match the filter's,
+	//so shaders opt in by printing their pixel or thread id first. negative components match anything
+	struct GpuPrintfFilter
+	{
+		Int32 id[3] = { -1, -1, -1 };
+
+		Bool IsActive() const { return id[0] >= 0 || id[1] >= 0 || id[2] >= 0; }
+		Bool Passes(GpuPrintfRecord const& record) const;
+	};
+
+	struct GpuPrintfLine
+	{
+		GpuPrintfRecord record;
+		Uint32 repeat_count;
+	};
+
+	struct GpuPrintfFormatStats
+	{
+		Uint32 format_id;
+		Uint32 record_count;
+		Uint32 suppressed_count;
+	};
+
+	//folds identical records into one line with a repeat count and keeps at most max_lines_per_format distinct lines per format.
+	//lines keep the order in which they were first seen
+	void AggregateGpuPrintfRecords(std::span<GpuPrintfRecord const> records, GpuPrintfFilter const& filter, Uint32 max_lines_per_format,
+								   std::vector<GpuPrintfLine>& lines, std::vector<GpuPrintfFormatStats>& format_stats);
+}
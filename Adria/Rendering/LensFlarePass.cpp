@@ -17,7 +17,7 @@ namespace adria
 {
 	ADRIA_LOG_CHANNEL(PostProcessor);
 
-	static TAutoConsoleVariable<Int> LensFlare("r.LensFlare.Type", 0, "0 - procedural, 1 - texture-based");
+	static TAutoConsoleVariable<Int> LensFlare("r.LensFlare.Type", 0, "0 - procedural, 1 - texture-based", ConsoleVariableMetadata{ .enum_names = { "Procedural", "TextureBased" } });
 	enum LensFlareType : Uint8
 	{
 		LensFlareType_Procedural,
@@ -94,7 +94,7 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx("Lens Flare", ImGuiTreeNodeFlags_None))
 				{
-					ImGui::Combo("Lens Flare Type", LensFlare.GetPtr(), "Procedural\0Texture-based\0", 2);
+					GUI_Combo("Lens Flare Type", *LensFlare, "Procedural\0Texture-based\0", 2);
 					ImGui::TreePop();
 				}
 			}, GUICommandGroup_PostProcessing
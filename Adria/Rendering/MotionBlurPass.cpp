@@ -92,7 +92,7 @@ namespace adria
 			{
 				if (ImGui::TreeNode("Motion Blur"))
 				{
-					ImGui::Checkbox("Enable", MotionBlur.GetPtr());
+					GUI_Checkbox("Enable", *MotionBlur);
 					ImGui::TreePop();
 				}
 			}, GUICommandGroup_PostProcessing);
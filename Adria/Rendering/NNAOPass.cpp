@@ -96,8 +96,8 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx("NNAO", ImGuiTreeNodeFlags_None))
 				{
-					ImGui::SliderFloat("Power",  NNAOPower.GetPtr(), 1.0f, 16.0f);
-					ImGui::SliderFloat("Radius", NNAORadius.GetPtr(), 0.5f, 4.0f);
+					GUI_SliderFloat("Power",  *NNAOPower, 1.0f, 16.0f);
+					GUI_SliderFloat("Radius", *NNAORadius, 0.5f, 4.0f);
 					ImGui::TreePop();
 					ImGui::Separator();
 				}
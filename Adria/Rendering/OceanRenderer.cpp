@@ -2,6 +2,7 @@
 #include "ShaderStructs.h"
 #include "Components.h"
 #include "BlackboardData.h"
+#include "DepthProjection.h"
 #include "ShaderManager.h"
 #include "TextureManager.h"
 #include "Core/Paths.h"
@@ -392,14 +393,16 @@ namespace adria
 					ImGui::SliderFloat("Choppiness", &ocean_choppiness, 0.0f, 10.0f);
 					ocean_color_changed = ImGui::ColorEdit3("Ocean Color", ocean_color);
 					recreate_initial_spectrum = ImGui::SliderFloat2("Wind Direction", wind_direction, 0.0f, 50.0f);
-					if (ImGui::SliderFloat("Height", OceanHeight.GetPtr(), -100.0f, 100.0f))
+					Float ocean_height = OceanHeight.Get();
+					if (ImGui::SliderFloat("Height", &ocean_height, -100.0f, 100.0f))
 					{
+						OceanHeight->Set(ocean_height);
 						auto ocean_view = reg.view<Ocean, Transform>();
 						for (entt::entity e : ocean_view)
 						{
 							Transform& transform = ocean_view.get<Transform>(e);
 							Vector3 const& current_translation = transform.current_transform.Translation();
-							Vector3 new_translation(current_translation.x, OceanHeight.Get(), current_translation.z);
+							Vector3 new_translation(current_translation.x, ocean_height, current_translation.z);
 							transform.current_transform.Translation(new_translation);
 						}
 					}
@@ -458,7 +461,7 @@ namespace adria
 		gfx_pso_desc.rasterizer_state.cull_mode = GfxCullMode::None;
 		gfx_pso_desc.depth_state.depth_enable = true;
 		gfx_pso_desc.depth_state.depth_write_mask = GfxDepthWriteMask::All;
-		gfx_pso_desc.depth_state.depth_func = GfxComparisonFunc::GreaterEqual;
+		gfx_pso_desc.depth_state.depth_func = DepthTestFunc;
 		gfx_pso_desc.num_render_targets = 1;
 		gfx_pso_desc.rtv_formats[0] = GfxFormat::R16G16B16A16_FLOAT;
 		gfx_pso_desc.dsv_format = GfxFormat::D32_FLOAT;
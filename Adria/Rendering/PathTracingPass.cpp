@@ -1,5 +1,6 @@
 #include "PathTracingPass.h"
 #include "BlackboardData.h"
+#include "DepthProjection.h"
 #include "ShaderManager.h"
 #include "Components.h"
 #include "SVGFDenoiserPass.h"
@@ -22,8 +23,8 @@ namespace adria
 		DenoiserType_SVGF
 	};
 	static TAutoConsoleVariable<Bool> AccumulateRadiance("r.PathTracing.AccumulateRadiance", true, "Should we accumulate radiance in path tracer or no");
-	static TAutoConsoleVariable<Int> MaxBounces("r.PathTracing.MaxBounces", 3, "Maximum number of bounces in a path tracer");
-	static TAutoConsoleVariable<Int> Denoiser("r.PathTracing.Denoiser", DenoiserType_None, "What denoiser will path tracer use: 0 - None, 1 - SVGF");
+	static TAutoConsoleVariable<Int> MaxBounces("r.PathTracing.MaxBounces", 3, "Maximum number of bounces in a path tracer", ConsoleVariableMetadata{ .min_value = 1.0f, .max_value = 8.0f });
+	static TAutoConsoleVariable<Int> Denoiser("r.PathTracing.Denoiser", DenoiserType_None, "What denoiser will path tracer use: 0 - None, 1 - SVGF", ConsoleVariableMetadata{ .enum_names = { "None", "SVGF" } });
 
 	PathTracingPass::PathTracingPass(entt::registry& reg, GfxDevice* gfx, Uint32 width, Uint32 height)
 		: reg(reg), gfx(gfx), width(width), height(height)
@@ -99,12 +100,12 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx("Path Tracing Settings", ImGuiTreeNodeFlags_None))
 				{
-					ImGui::SliderInt("Max Bounces", MaxBounces.GetPtr(), 1, 8);
+					GUI_SliderInt("Max Bounces", *MaxBounces, 1, 8);
 					if (!denoiser_active)
 					{
-						ImGui::Checkbox("Accumulate Radiance", AccumulateRadiance.GetPtr());
+						GUI_Checkbox("Accumulate Radiance", *AccumulateRadiance);
 					}
-					ImGui::Combo("Denoiser Type", Denoiser.GetPtr(), "None\0SVGF\0", 2);
+					GUI_Combo("Denoiser Type", *Denoiser, "None\0SVGF\0", 2);
 
 					ImGui::TreePop();
 					ImGui::Separator();
@@ -131,7 +132,7 @@ namespace adria
 		pt_gbuffer_pso_desc.PS = PS_PT_GBuffer;
 		pt_gbuffer_pso_desc.depth_state.depth_enable = true;
 		pt_gbuffer_pso_desc.depth_state.depth_write_mask = GfxDepthWriteMask::All;
-		pt_gbuffer_pso_desc.depth_state.depth_func = GfxComparisonFunc::GreaterEqual;
+		pt_gbuffer_pso_desc.depth_state.depth_func = DepthTestFunc;
 		pt_gbuffer_pso_desc.num_render_targets = 3u;
 		pt_gbuffer_pso_desc.rtv_formats[0] = GfxFormat::R32G32B32A32_FLOAT;
 		pt_gbuffer_pso_desc.rtv_formats[1] = GfxFormat::R16G16B16A16_FLOAT;
@@ -216,7 +217,7 @@ namespace adria
 				depth_desc.width = width;
 				depth_desc.height = height;
 				depth_desc.format = GfxFormat::R32_TYPELESS;
-				depth_desc.clear_value = GfxClearValue(0.0f, 0);
+				depth_desc.clear_value = GfxClearValue(DepthClearValue, 0);
 				builder.DeclareTexture(RG_NAME(PT_DepthStencil), depth_desc);
 				builder.WriteDepthStencil(RG_NAME(PT_DepthStencil), RGLoadStoreAccessOp::Clear_Preserve);
 				builder.SetViewport(width, height);
@@ -25,6 +25,8 @@
 #include "ToneMapPass.h"
 #include "RenderGraph/RenderGraph.h"
 #include "Graphics/GfxPipelineStatePermutations.h"
+#include "Math/JitterSequence.h"
+#include "Core/ConsoleManager.h"
 #include "Editor/GUICommand.h"
 #include "entt/entity/registry.hpp"
 
@@ -32,6 +34,10 @@ using namespace DirectX;
 
 namespace adria
 {
+	static TAutoConsoleVariable<Int> JitterSequenceOverride("r.JitterSequence", 0, "0 - Default of the active upscaler or TAA, 1 - Halton, 2 - R2, 3 - Blue Noise",
+		ConsoleVariableMetadata{ .enum_names = { "Default", "Halton", "R2", "BlueNoise" } });
+	static TAutoConsoleVariable<Int> JitterPhaseCountOverride("r.JitterPhaseCount", 0, "Number of jitter phases, 0 uses the default of the active upscaler or TAA",
+		ConsoleVariableMetadata{ .min_value = 0.0f, .max_value = 256.0f });
 
 	PostProcessor::PostProcessor(GfxDevice* gfx, entt::registry& reg, Uint32 width, Uint32 height)
 		: gfx(gfx), reg(reg), display_width(width), display_height(height), render_width(width), render_height(height),
@@ -174,6 +180,24 @@ namespace adria
 		return HasTAA() || (HasUpscaler() && GetPostEffect<UpscalerPassGroup>()->NeedsJitter());
 	}
 
+	JitterSequenceDesc PostProcessor::GetJitterSequenceDesc() const
+	{
+		JitterSequenceDesc desc{};
+		if (HasUpscaler())
+		{
+			desc = GetPostEffect<UpscalerPassGroup>()->GetJitterSequenceDesc(render_width);
+		}
+		if (JitterSequenceOverride.Get() > 0)
+		{
+			desc.type = static_cast<JitterSequenceType>(JitterSequenceOverride.Get() - 1);
+		}
+		if (JitterPhaseCountOverride.Get() > 0)
+		{
+			desc.phase_count = (Uint32)JitterPhaseCountOverride.Get();
+		}
+		return desc;
+	}
+
 	Bool PostProcessor::NeedsVelocityBuffer() const
 	{
 		return HasTAA() || HasUpscaler() || post_effects[PostEffectType_Clouds]->IsEnabled(this) || post_effects[PostEffectType_MotionBlur]->IsEnabled(this);
@@ -13,6 +13,7 @@ namespace adria
 	class PostEffect;
 	struct Light;
 	class RainEvent;
+	struct JitterSequenceDesc;
 
 	enum AmbientOcclusionType : Uint8;
 	enum class UpscalerType : Uint8;
@@ -65,6 +66,7 @@ namespace adria
 		void OnSceneInitialized();
 
 		Bool NeedsJitter() const;
+		JitterSequenceDesc GetJitterSequenceDesc() const;
 		Bool NeedsVelocityBuffer() const;
 		Bool NeedsHistoryBuffer() const;
 		Bool HasUpscaler() const;
@@ -56,10 +56,7 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx("Rain Settings", 0))
 				{
-					if (ImGui::Checkbox("Enable", Rain.GetPtr()))
-					{
-						OnRainEnabled(Rain.Get());
-					}
+					GUI_Checkbox("Enable", *Rain);
 					if (Rain.Get())
 					{
 						ImGui::Checkbox("Pause simulation", &pause_simulation);
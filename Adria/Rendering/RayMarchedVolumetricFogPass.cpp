@@ -6,6 +6,7 @@
 #include "Graphics/GfxPipelineState.h"
 #include "RenderGraph/RenderGraph.h"
 #include "Core/ConsoleManager.h"
+#include "Editor/GUICommand.h"
 
 using namespace DirectX;
 
@@ -18,8 +19,8 @@ namespace adria
 		RayMarchedVolumetricFogResolution_Quarter = 2
 	};
 
-	static TAutoConsoleVariable<Int>  RayMarchedVolumetricFogRes("r.VolumetricFog.RayMarching.Resolution", RayMarchedVolumetricFogResolution_Full, "Specifies in what resolution is ray marched volumetric fog computed: 0 - Full, 1 - Half, 2 - Quarter");
-	static TAutoConsoleVariable<Int>  RayMarchedVolumetricFogSampleCount("r.VolumetricFog.RayMarching.SampleCount", 16, "How many samples should ray marched volumetric fog use in ray march");
+	static TAutoConsoleVariable<Int>  RayMarchedVolumetricFogRes("r.VolumetricFog.RayMarching.Resolution", RayMarchedVolumetricFogResolution_Full, "Specifies in what resolution is ray marched volumetric fog computed: 0 - Full, 1 - Half, 2 - Quarter", ConsoleVariableMetadata{ .enum_names = { "Full", "Half", "Quarter" } });
+	static TAutoConsoleVariable<Int>  RayMarchedVolumetricFogSampleCount("r.VolumetricFog.RayMarching.SampleCount", 16, "How many samples should ray marched volumetric fog use in ray march", ConsoleVariableMetadata{ .min_value = 1.0f, .max_value = 64.0f });
 	static TAutoConsoleVariable<Bool> RayMarchedVolumetricFogUsePCF("r.VolumetricFog.RayMarching.UsePCF", false, "Should the ray marched volumetric fog use PCF when calculating shadow factors");
 
 	RayMarchedVolumetricFogPass::RayMarchedVolumetricFogPass(GfxDevice* gfx, Uint32 w, Uint32 h) : gfx(gfx), width(w), height(h), copy_to_texture_pass(gfx, w, h)
@@ -94,12 +95,12 @@ namespace adria
 	{
 		if (ImGui::TreeNodeEx("Ray Marched Volumetric Fog ", ImGuiTreeNodeFlags_None))
 		{
-			if (ImGui::Combo("Resolution", RayMarchedVolumetricFogRes.GetPtr(), "Full\0Half\0Quarter\0", 3))
+			if (GUI_Combo("Resolution", *RayMarchedVolumetricFogRes, "Full\0Half\0Quarter\0", 3))
 			{
 				OnResize(width, height);
 			}
-			ImGui::SliderInt("Sample Count", RayMarchedVolumetricFogSampleCount.GetPtr(), 1, 64);
-			ImGui::Checkbox("Use PCF", RayMarchedVolumetricFogUsePCF.GetPtr());
+			GUI_SliderInt("Sample Count", *RayMarchedVolumetricFogSampleCount, 1, 64);
+			GUI_Checkbox("Use PCF", *RayMarchedVolumetricFogUsePCF);
 			ImGui::TreePop();
 			ImGui::Separator();
 		}
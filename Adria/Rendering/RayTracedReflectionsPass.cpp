@@ -112,7 +112,7 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx("Ray Traced Reflection", ImGuiTreeNodeFlags_None))
 				{
-					ImGui::Checkbox("Enable RTR", RTR.GetPtr());
+					GUI_Checkbox("Enable RTR", *RTR);
 					if (RTR.Get())
 					{
 						ImGui::SliderFloat("Roughness scale", &reflection_roughness_scale, 0.0f, 0.25f);
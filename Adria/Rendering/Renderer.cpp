@@ -6,6 +6,7 @@
 #include "SkyModel.h"
 #include "TextureManager.h"
 #include "DebugRenderer.h"
+#include "TerrainLOD.h"
 
 #include "Editor/GUICommand.h"
 #include "Editor/Editor.h"
@@ -18,7 +19,6 @@
 #include "RenderGraph/RenderGraph.h"
 #include "Utilities/ThreadPool.h"
 #include "Utilities/Random.h"
-#include "Utilities/ImageWrite.h"
 #include "Math/Constants.h"
 #include "Core/Paths.h"
 #include "Core/ConsoleManager.h"
@@ -31,7 +31,8 @@ namespace adria
 {
 	ADRIA_LOG_CHANNEL(Renderer);
 
-	static TAutoConsoleVariable<Int>  LightingPathType("r.LightingPath", 0, "0 - Deferred, 1 - Tiled Deferred, 2 - Clustered Deferred, 3 - Path Tracing");
+	static TAutoConsoleVariable<Int>  LightingPathType("r.LightingPath", 0, "0 - Deferred, 1 - Tiled Deferred, 2 - Clustered Deferred, 3 - Path Tracing", ConsoleVariableMetadata{ .enum_names = { "Deferred", "TiledDeferred", "ClusteredDeferred", "PathTracing" } });
+	static TAutoConsoleVariable<Float> TerrainLODError("r.TerrainLODError", 2.0f, "Largest screen space error of the terrain chunks, in pixels", ConsoleVariableMetadata{ .min_value = 0.0f });
 
 	Renderer::Renderer(entt::registry& reg, GfxDevice* gfx, Uint32 width, Uint32 height) : reg(reg), gfx(gfx), resource_pool(gfx),
 		accel_structure(gfx), camera(nullptr), display_width(width), display_height(height), render_width(width), render_height(height),
@@ -44,7 +45,7 @@ namespace adria
 		shadow_renderer(reg, gfx, width, height), renderer_debug_view_pass(gfx, width, height),
 		path_tracer(reg, gfx, width, height), ddgi(gfx, reg, width, height), restir_di(gfx, width, height), gpu_printf(gfx), gpu_assert(gfx),
 		transparent_pass(reg, gfx, width, height), ray_tracing_supported(gfx->GetCapabilities().SupportsRayTracing()), 
-		volumetric_fog_manager(gfx, reg, width, height)
+		volumetric_fog_manager(gfx, reg, width, height), frame_capture(gfx)
 	{
 		g_DebugRenderer.Initialize(gfx, width, height);
 		g_GfxProfiler.Initialize(gfx);
@@ -52,7 +53,6 @@ namespace adria
 		CreateDisplaySizeDependentResources();
 		CreateRenderSizeDependentResources();
 		RegisterEventListeners();
-		screenshot_fence.Create(gfx, "Screenshot Fence");
 		frame_cbuffer.SetName("FrameCBuffer");
 	}
 
@@ -90,10 +90,12 @@ namespace adria
 	}
 	void Renderer::Update(Float dt)
 	{
+		if (ray_tracing_supported) accel_structure.Update();
 		shadow_renderer.SetupShadows(camera);
 		UpdateSceneBuffers();
 		UpdateFrameConstants(dt);
 		CameraFrustumCulling();
+		UpdateTerrainLOD();
 	}
 	void Renderer::Render()
 	{
@@ -165,14 +167,15 @@ namespace adria
 	}
 	void Renderer::OnTakeScreenshot(Char const* filename)
 	{
-		screenshot_name = filename;
-		if (screenshot_name.empty())
+		FrameCaptureDesc screenshot_desc{};
+		screenshot_desc.name = filename;
+		if (screenshot_desc.name.empty())
 		{
 			static Uint32 screenshot_index = 0;
-			screenshot_name = "adria_screenshot";
-			screenshot_name += std::to_string(screenshot_index++);
+			screenshot_desc.name = "adria_screenshot";
+			screenshot_desc.name += std::to_string(screenshot_index++);
 		}
-		take_screenshot = true;
+		frame_capture.Request(screenshot_desc);
 	}
 
 	void Renderer::OnLightChanged()
@@ -229,11 +232,15 @@ namespace adria
 		if (reg.view<RayTracing>().size() == 0) return;
 
 		accel_structure.Clear();
-		auto ray_tracing_view = reg.view<Mesh, RayTracing>();
-		for (entt::entity entity : ray_tracing_view)
+		Uint32 base_instance_id = 0;
+		for (entt::entity entity : reg.view<Mesh>())
 		{
-			Mesh const& mesh = ray_tracing_view.get<Mesh>(entity);
-			accel_structure.AddInstance(mesh);
+			Mesh const& mesh = reg.get<Mesh>(entity);
+			if (reg.all_of<RayTracing>(entity))
+			{
+				accel_structure.AddInstance(mesh, base_instance_id);
+			}
+			base_instance_id += (Uint32)mesh.instances.size();
 		}
 		accel_structure.Build();
 	}
@@ -390,7 +397,8 @@ namespace adria
 		camera_jitter = Vector2(0.0f, 0.0f);
 		if (postprocessor.NeedsJitter() || lighting_path == LightingPath::PathTracing)
 		{
-			camera_jitter = camera->Jitter(gfx->GetFrameIndex());
+			jitter_sequence.SetDesc(postprocessor.GetJitterSequenceDesc());
+			camera_jitter = jitter_sequence[gfx->GetFrameIndex()];
 		}
 		if (camera->IsChanged())
 		{
@@ -399,6 +407,9 @@ namespace adria
 
 		frame_cbuf_data.camera_near = camera->Near();
 		frame_cbuf_data.camera_far = camera->Far();
+		DepthLinearization const depth_linearization = camera->GetDepthLinearization();
+		frame_cbuf_data.depth_linearization_scale = depth_linearization.scale;
+		frame_cbuf_data.depth_linearization_bias = depth_linearization.bias;
 		frame_cbuf_data.camera_position = camera->Position();
 		frame_cbuf_data.camera_forward = camera->Forward();
 		frame_cbuf_data.view = camera->View();
@@ -482,6 +493,27 @@ namespace adria
 		}
 	}
 
+	void Renderer::UpdateTerrainLOD()
+	{
+		Float const projection_scale = TerrainLOD::GetProjectionScale(camera->Fov(), (Float)render_height);
+		TerrainLOD* selected_terrain = nullptr;
+		auto terrain_view = reg.view<TerrainChunk, SubMesh>();
+		for (entt::entity e : terrain_view)
+		{
+			auto [terrain_chunk, submesh] = terrain_view.get<TerrainChunk, SubMesh>(e);
+			//chunks of one grid share the terrain, select its lods once
+			if (terrain_chunk.terrain.get() != selected_terrain)
+			{
+				selected_terrain = terrain_chunk.terrain.get();
+				selected_terrain->SelectLODs(camera->Position(), projection_scale, TerrainLODError.Get());
+			}
+			TerrainChunkLOD const& chunk_lod = selected_terrain->GetSelectedLODs()[terrain_chunk.chunk_index];
+			TerrainIndexRange const index_range = selected_terrain->GetIndexRange(chunk_lod.lod, chunk_lod.stitch_mask);
+			submesh.start_index_location = index_range.offset;
+			submesh.indices_count = index_range.count;
+		}
+	}
+
 	void Renderer::RenderImpl(RenderGraph& render_graph)
 	{
 		ZoneScopedN("Renderer::RenderImpl");
@@ -501,6 +533,7 @@ namespace adria
 			frame_data.camera_aspect_ratio = camera->AspectRatio();
 			frame_data.camera_near = camera->Near();
 			frame_data.camera_far = camera->Far();
+			frame_data.camera_infinite_far = camera->IsInfiniteFar();
 			frame_data.camera_jitter_x = camera_jitter.x;
 			frame_data.camera_jitter_y = camera_jitter.y;
 			frame_data.delta_time = frame_cbuf_data.delta_time;
@@ -521,10 +554,7 @@ namespace adria
 		{
 			Render_Deferred(render_graph);
 		}
-		if (take_screenshot)
-		{
-			TakeScreenshot(render_graph);
-		}
+		frame_capture.AddCapturePass(render_graph);
 		gpu_printf.AddPrintPass(render_graph);
 		gpu_assert.AddAssertPass(render_graph);
 
@@ -720,52 +750,5 @@ namespace adria
 			}, RGPassType::Copy, RGPassFlags::ForceNoCull);
 	}
 
-	void Renderer::TakeScreenshot(RenderGraph& rg)
-	{
-		ADRIA_ASSERT(take_screenshot);
-
-		std::string absolute_screenshot_path = paths::ScreenshotsDir + screenshot_name + ".png";
-		ADRIA_LOG(INFO, "Taking screenshot: %s.png...", screenshot_name.c_str());
-		if (!screenshot_buffer)
-		{	
-			GfxBufferDesc screenshot_desc{};
-			screenshot_desc.size = gfx->GetLinearBufferSize(final_texture.get()); 
-			screenshot_desc.resource_usage = GfxResourceUsage::Readback;
-			screenshot_buffer = gfx->CreateBuffer(screenshot_desc);
-		}
-		rg.ImportBuffer(RG_NAME(ScreenshotBuffer), screenshot_buffer.get());
-
-		struct ScreenshotPassData
-		{
-			RGBufferCopyDstId  dst;
-			RGTextureCopySrcId src;
-		};
-		rg.AddPass<ScreenshotPassData>("Screenshot Pass",
-			[=](ScreenshotPassData& data, RenderGraphBuilder& builder)
-			{
-				data.dst = builder.WriteCopyDstBuffer(RG_NAME(ScreenshotBuffer));
-				data.src = builder.ReadCopySrcTexture(RG_NAME(FinalTexture));
-			},
-			[=](ScreenshotPassData const& data, RenderGraphContext& ctx)
-			{
-				GfxCommandList* cmd_list = ctx.GetCommandList();
-				GfxTexture const& src_texture = ctx.GetCopySrcTexture(data.src);
-				GfxBuffer& dst_buffer = ctx.GetCopyDstBuffer(data.dst);
-				cmd_list->CopyTextureToBuffer(dst_buffer, 0, src_texture, 0, 0);
-				cmd_list->Signal(screenshot_fence, screenshot_fence_value);
-			}, RGPassType::Copy, RGPassFlags::ForceNoCull);
-
-		g_ThreadPool.Submit([this](std::string_view name) 
-			{
-			screenshot_fence.Wait(screenshot_fence_value);
-			WriteImageToFile(FileType::PNG, name.data(), display_width, display_height, screenshot_buffer->GetMappedData(), display_width * 4);
-			screenshot_buffer.reset();
-			ADRIA_LOG(INFO, "Screenshot %s.png saved to screenshots folder!", screenshot_name.c_str());
-			screenshot_fence_value++;
-			}, absolute_screenshot_path);
-
-		take_screenshot = false;
-	}
-
 }
 
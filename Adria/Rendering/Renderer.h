@@ -14,6 +14,7 @@
 #include "ReSTIR_DI.h"
 #include "GpuPrintf.h"
 #include "GpuAssert.h"
+#include "FrameCapture.h"
 #include "HelperPasses.h"
 #include "PickingPass.h"
 #include "DecalsPass.h"
@@ -25,6 +26,7 @@
 #include "TransparentPass.h"
 #include "VolumetricFogManager.h"
 #include "RendererDebugViewPass.h"
+#include "Math/JitterSequence.h"
 #include "Graphics/GfxShaderCompiler.h"
 #include "Graphics/GfxConstantBuffer.h"
 #include "RenderGraph/RenderGraphResourcePool.h"
@@ -79,6 +81,7 @@ namespace adria
 
 		Camera const* camera;
 		Vector2 camera_jitter;
+		JitterSequence jitter_sequence;
 
 		Uint32 const backbuffer_count;
 		Uint32 backbuffer_index;
@@ -157,11 +160,7 @@ namespace adria
 		Vector3					 sun_direction;
 
 		//screenshot
-		Bool						take_screenshot = false;
-		std::string					screenshot_name = "";
-		GfxFence					screenshot_fence;
-		Uint64						screenshot_fence_value = 1;
-		std::unique_ptr<GfxBuffer>  screenshot_buffer;
+		FrameCapture				frame_capture;
 
 		//misc
 		ViewportData			 viewport_data;
@@ -176,6 +175,7 @@ namespace adria
 		void UpdateSceneBuffers();
 		void UpdateFrameConstants(Float dt);
 		void CameraFrustumCulling();
+		void UpdateTerrainLOD();
 
 		void RenderImpl(RenderGraph& rg);
 		void Render_Deferred(RenderGraph& rg);
@@ -183,6 +183,5 @@ namespace adria
 
 		void ClearTriangleOverdrawTexture(RenderGraph& rg);
 		void CopyToBackbuffer(RenderGraph& rg);
-		void TakeScreenshot(RenderGraph& rg);
 	};
 }
\ No newline at end of file
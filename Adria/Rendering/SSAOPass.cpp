@@ -24,7 +24,7 @@ namespace adria
 
 	static TAutoConsoleVariable<Float> SSAOPower("r.SSAO.Power", 1.5f, "Controls the power of SSAO");
 	static TAutoConsoleVariable<Float> SSAORadius("r.SSAO.Radius", 1.0f, "Controls the radius of SSAO");
-	static TAutoConsoleVariable<Int>   SSAOResolution("r.SSAO.Resolution", SSAOResolution_Full, "Sets the resolution mode for SSAO: 0 - Full resolution, 1 - Half resolution, 2 - Quarter resolution");
+	static TAutoConsoleVariable<Int>   SSAOResolution("r.SSAO.Resolution", SSAOResolution_Full, "Sets the resolution mode for SSAO: 0 - Full resolution, 1 - Half resolution, 2 - Quarter resolution", ConsoleVariableMetadata{ .enum_names = { "Full", "Half", "Quarter" } });
 
 	SSAOPass::SSAOPass(GfxDevice* gfx, Uint32 w, Uint32 h) : gfx(gfx), width(w), height(h), ssao_random_texture(nullptr), blur_pass(gfx)
 	{
@@ -121,13 +121,10 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx("SSAO", ImGuiTreeNodeFlags_None))
 				{
-					ImGui::SliderFloat("Power", SSAOPower.GetPtr(), 1.0f, 16.0f);
-					ImGui::SliderFloat("Radius", SSAORadius.GetPtr(), 0.5f, 4.0f);
+					GUI_SliderFloat("Power", *SSAOPower, 1.0f, 16.0f);
+					GUI_SliderFloat("Radius", *SSAORadius, 0.5f, 4.0f);
 
-					if (ImGui::Combo("SSAO Resolution", SSAOResolution.GetPtr(), "Full\0Half\0Quarter\0", 3))
-					{
-						OnResize(width, height);
-					}
+					GUI_Combo("SSAO Resolution", *SSAOResolution, "Full\0Half\0Quarter\0", 3);
 					ImGui::TreePop();
 					ImGui::Separator();
 				}
@@ -106,11 +106,11 @@ namespace adria
 		QueueGUI([&]() {
 			if (ImGui::TreeNodeEx("Screen-Space Reflections", 0))
 			{
-				ImGui::Checkbox("Enable SSR", SSR.GetPtr());
+				GUI_Checkbox("Enable SSR", *SSR);
 				if (SSR.Get())
 				{
-					ImGui::SliderFloat("Ray Step", SSRRayStep.GetPtr(), 1.0f, 3.0f);
-					ImGui::SliderFloat("Ray Hit Threshold", SSRRayHitThreshold.GetPtr(), 0.25f, 5.0f);
+					GUI_SliderFloat("Ray Step", *SSRRayStep, 1.0f, 3.0f);
+					GUI_SliderFloat("Ray Hit Threshold", *SSRRayHitThreshold, 0.25f, 5.0f);
 				}
 				ImGui::TreePop();
 				ImGui::Separator();
@@ -12,7 +12,7 @@
 namespace adria
 {
 	
-	static TAutoConsoleVariable<Int>   SVGF_AtrousIterations("r.SVGF.Atrous.Iterations", 4, "Number of a-trous filter iterations.");
+	static TAutoConsoleVariable<Int>   SVGF_AtrousIterations("r.SVGF.Atrous.Iterations", 4, "Number of a-trous filter iterations.", ConsoleVariableMetadata{ .min_value = 1.0f, .max_value = 8.0f });
 	static TAutoConsoleVariable<Float> SVGF_Alpha("r.SVGF.Alpha", 0.05f, "Temporal feedback factor for color.");
 	static TAutoConsoleVariable<Float> SVGF_MomentsAlpha("r.SVGF.Moments.Alpha", 0.1f, "Temporal feedback factor for moments.");
 	static TAutoConsoleVariable<Float> SVGF_PhiColor("r.SVGF.Phi.Color", 8.0f, "Edge-stopping function parameter for color.");
@@ -73,13 +73,13 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx("SVGF Settings", ImGuiTreeNodeFlags_None))
 				{
-					ImGui::SliderFloat("Temporal Alpha", SVGF_Alpha.GetPtr(), 0.0f, 1.0f);
-					ImGui::SliderFloat("Moments Alpha", SVGF_MomentsAlpha.GetPtr(), 0.0f, 1.0f);
-					ImGui::SliderInt("Atrous Iterations", SVGF_AtrousIterations.GetPtr(), 1, 8);
-					ImGui::SliderFloat("Phi Color", SVGF_PhiColor.GetPtr(), 1.0f, 64.0f);
-					ImGui::SliderFloat("Phi Normal", SVGF_PhiNormal.GetPtr(), 8.0f, 256.0f);
-					ImGui::SliderFloat("Phi Depth", SVGF_PhiDepth.GetPtr(), 0.001f, 0.2f, "%.3f");
-					ImGui::SliderFloat("Phi Albedo", SVGF_PhiAlbedo.GetPtr(), 1.0f, 16.0f);
+					GUI_SliderFloat("Temporal Alpha", *SVGF_Alpha, 0.0f, 1.0f);
+					GUI_SliderFloat("Moments Alpha", *SVGF_MomentsAlpha, 0.0f, 1.0f);
+					GUI_SliderInt("Atrous Iterations", *SVGF_AtrousIterations, 1, 8);
+					GUI_SliderFloat("Phi Color", *SVGF_PhiColor, 1.0f, 64.0f);
+					GUI_SliderFloat("Phi Normal", *SVGF_PhiNormal, 8.0f, 256.0f);
+					GUI_SliderFloat("Phi Depth", *SVGF_PhiDepth, 0.001f, 0.2f, "%.3f");
+					GUI_SliderFloat("Phi Albedo", *SVGF_PhiAlbedo, 1.0f, 16.0f);
 					ImGui::TreePop();
 				}
 			}, GUICommandGroup_Renderer, GUICommandSubGroup_None);
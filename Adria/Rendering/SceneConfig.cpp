@@ -1,149 +1,176 @@
 #include "SceneConfig.h"
+#include "SceneConfigFile.h"
 #include "Core/Paths.h"
 #include "Math/Constants.h"
-#include "Utilities/Json.h"
 #include "Utilities/PathHelpers.h"
 
-using json = nlohmann::json;
 using namespace DirectX;
 
 namespace adria
 {
 	ADRIA_LOG_CHANNEL(Scene);
 
-	Bool ParseSceneConfig(std::string const& scene_file, SceneConfig& config, Bool append_dir)
+	namespace
 	{
-		json models, lights, camera, skybox;
-		std::string ini_file;
-		try
+		std::string MakeRelativePath(std::string const& path, std::string const& dir)
 		{
-			std::string scene_file_full = append_dir ? paths::ScenesDir + scene_file : scene_file;
-			JsonParams scene_params = json::parse(std::ifstream(scene_file_full));
-			models = scene_params.FindJsonArray("models");
-			lights = scene_params.FindJsonArray("lights");
-			camera = scene_params.FindJson("camera");
-			skybox = scene_params.FindJson("skybox");
-			ini_file = scene_params.FindOr<std::string>("ini", "default_cvars.ini");
+			return path.starts_with(dir) ? path.substr(dir.size()) : path;
 		}
-		catch (json::parse_error const& e)
+
+		SceneFileFloat3 ToFloat3(Float const* values)
 		{
-			ADRIA_LOG(ERROR, "Scene json parsing error: %s! ", e.what());
-			return false;
+			return SceneFileFloat3{ values[0], values[1], values[2] };
 		}
 
-		for (auto&& model_json : models)
+		//inverse of the rotation * scale * translation composition done while parsing,
+		//rotation is XMMatrixRotationX * XMMatrixRotationY * XMMatrixRotationZ
+		void DecomposeModelMatrix(Matrix const& transform, SceneFileFloat3& translation, SceneFileFloat3& angles, SceneFileFloat3& scale)
 		{
-			JsonParams model_params(model_json);
+			translation[0] = transform.m[3][0];
+			translation[1] = transform.m[3][1];
+			translation[2] = transform.m[3][2];
+
+			for (Uint32 j = 0; j < 3; ++j)
+			{
+				scale[j] = std::sqrt(transform.m[0][j] * transform.m[0][j] + transform.m[1][j] * transform.m[1][j] + transform.m[2][j] * transform.m[2][j]);
+			}
+
+			//a mirroring transform needs one negative scale, flip the axis that stays closest to identity
+			Matrix linear = transform;
+			linear.m[3][0] = linear.m[3][1] = linear.m[3][2] = 0.0f;
+			if (linear.Determinant() < 0.0f)
+			{
+				Uint32 flipped_axis = 0;
+				for (Uint32 j = 1; j < 3; ++j)
+				{
+					if (transform.m[j][j] / scale[j] < transform.m[flipped_axis][flipped_axis] / scale[flipped_axis]) flipped_axis = j;
+				}
+				scale[flipped_axis] = -scale[flipped_axis];
+			}
+
+			Float rotation[3][3];
+			for (Uint32 i = 0; i < 3; ++i)
+			{
+				for (Uint32 j = 0; j < 3; ++j)
+				{
+					rotation[i][j] = scale[j] != 0.0f ? transform.m[i][j] / scale[j] : 0.0f;
+				}
+			}
+
+			Float const sin_y = std::clamp(-rotation[0][2], -1.0f, 1.0f);
+			Float const y = std::asin(sin_y);
+			Float x = 0.0f, z = 0.0f;
+			if (std::abs(sin_y) < 0.9999f)
+			{
+				x = std::atan2(rotation[1][2], rotation[2][2]);
+				z = std::atan2(rotation[0][1], rotation[0][0]);
+			}
+			else
+			{
+				x = std::atan2(rotation[1][0] * sin_y, rotation[1][1]);
+			}
+			angles[0] = XMConvertToDegrees(x);
+			angles[1] = XMConvertToDegrees(y);
+			angles[2] = XMConvertToDegrees(z);
+		}
 
-			std::string path;
-			if (!model_params.Find<std::string>("path", path))
+		Char const* LightTypeToString(LightType type)
+		{
+			switch (type)
 			{
-				ADRIA_LOG(WARNING, "Model doesn't have path field! Skipping this model...");
+			case LightType::Directional: return "directional";
+			case LightType::Point:		 return "point";
+			case LightType::Spot:		 return "spot";
 			}
-			path = paths::ModelsDir + path;
-			std::string tex_path = model_params.FindOr<std::string>("tex_path", GetParentPath(path) + "\\");
+			return "";
+		}
+	}
 
-			Float position[3] = { 0.0f, 0.0f, 0.0f };
-			model_params.FindArray("translation", position);
-			Matrix translation = XMMatrixTranslation(position[0], position[1], position[2]);
+	Bool ParseSceneConfig(std::string const& scene_file, SceneConfig& config, Bool append_dir, std::vector<SceneDiagnostic>* diagnostics)
+	{
+		std::string const scene_file_full = append_dir ? paths::ScenesDir + scene_file : scene_file;
+		SceneFile scene{};
+		std::vector<SceneDiagnostic> scene_diagnostics;
+		Bool const valid = ReadSceneFile(scene_file_full, scene, scene_diagnostics);
+		if (diagnostics) *diagnostics = std::move(scene_diagnostics);
+		if (!valid) return false;
+
+		for (SceneFileModel const& model : scene.models)
+		{
+			std::string path = paths::ModelsDir + model.path;
+			std::string tex_path = model.tex_path.value_or(GetParentPath(path) + "\\");
 
-			Float angles[3] = { 0.0f, 0.0f, 0.0f };
-			model_params.FindArray("rotation", angles);
+			Matrix translation = XMMatrixTranslation(model.translation[0], model.translation[1], model.translation[2]);
+			SceneFileFloat3 angles = model.rotation;
 			std::transform(std::begin(angles), std::end(angles), std::begin(angles), XMConvertToRadians);
 			Matrix rotation = XMMatrixRotationX(angles[0]) * XMMatrixRotationY(angles[1]) * XMMatrixRotationZ(angles[2]);
-
-			Float scale_factors[3] = { 1.0f, 1.0f, 1.0f };
-			model_params.FindArray("scale", scale_factors);
-			Matrix scale = XMMatrixScaling(scale_factors[0], scale_factors[1], scale_factors[2]);
+			Matrix scale = XMMatrixScaling(model.scale[0], model.scale[1], model.scale[2]);
 			Matrix transform = rotation * scale * translation;
 
-			Bool triangle_ccw = true;
-			model_params.Find<Bool>("use_ccw", triangle_ccw);
-			Bool force_mask = false;
-			model_params.Find<Bool>("force_alpha_mask", force_mask);
-			Bool load_model_lights = false;
-			model_params.Find<Bool>("load_model_lights", load_model_lights);
-			config.scene_models.emplace_back(path, tex_path, transform, triangle_ccw, force_mask, load_model_lights);
+			config.scene_models.emplace_back(path, tex_path, transform, model.use_ccw, model.force_alpha_mask, model.load_model_lights);
 		}
 
-		for (auto&& light_json : lights)
+		for (SceneFileLight const& scene_light : scene.lights)
 		{
-			JsonParams light_params(light_json);
-
-			std::string type;
-			if (!light_params.Find<std::string>("type", type))
-			{
-				ADRIA_LOG(WARNING, "Light doesn't have type field! Skipping this light...");
-			}
+			std::string const& type = scene_light.type;
 
 			LightParameters light{};
-			Float position[3] = { 0.0f, 0.0f, 0.0f };
-			light_params.FindArray("position", position);
+			SceneFileFloat3 const position = scene_light.position.value_or(SceneFileFloat3{ 0.0f, 0.0f, 0.0f });
 			light.light_data.position = Vector4(position[0], position[1], position[2], 1.0f);
 
-			Float direction[3] = { 0.0f, -1.0f, 0.0f };
-			if (light_params.FindArray("direction", direction))
+			if (scene_light.direction.has_value())
 			{
+				SceneFileFloat3 const& direction = *scene_light.direction;
 				light.light_data.direction = Vector4(direction[0], direction[1], direction[2], 0.0f);
 			}
-			else if (type == "directional")
+			else if (type == "directional" && scene_light.elevation.has_value() && scene_light.azimuth.has_value())
 			{
-				Float elevation, azimuth;
-				if (light_params.Find<Float>("elevation", elevation) && light_params.Find<Float>("azimuth", azimuth))
-				{
-					light.light_data.direction = -ConvertElevationAndAzimuthToDirection(elevation, azimuth);
-				}
+				light.light_data.direction = -ConvertElevationAndAzimuthToDirection(*scene_light.elevation, *scene_light.azimuth);
 			}
 
-			Float color[3] = { 1.0f, 1.0f, 1.0f };
-			if (light_params.FindArray("color", color))
+			if (scene_light.color.has_value())
 			{
+				SceneFileFloat3 const& color = *scene_light.color;
 				light.light_data.color = Vector4(color[0], color[1], color[2], 1.0f);
 			}
-			else if (type == "directional")
+			else if (type == "directional" && scene_light.temperature.has_value())
 			{
-				Float temperature;
-				if (light_params.Find<Float>("temperature", temperature))
-				{
-					light.light_data.color = ConvertTemperatureToColor(temperature);
-				}
+				light.light_data.color = ConvertTemperatureToColor(*scene_light.temperature);
 			}
 
-			light.light_data.intensity = light_params.FindOr<Float>("intensity", 1.0f);
-			light.light_data.range = light_params.FindOr<Float>("range", 100.0f);
+			light.light_data.intensity = scene_light.intensity;
+			light.light_data.range = scene_light.range;
 
-			light.light_data.outer_cosine = std::cos(XMConvertToRadians(light_params.FindOr<Float>("outer_angle", 45.0f)));
-			light.light_data.inner_cosine = std::cos(XMConvertToRadians(light_params.FindOr<Float>("outer_angle", 22.5f)));
+			light.light_data.outer_cosine = std::cos(XMConvertToRadians(scene_light.outer_angle));
+			light.light_data.inner_cosine = std::cos(XMConvertToRadians(scene_light.inner_angle));
 
-			light.light_data.casts_shadows = light_params.FindOr<Bool>("shadows", true);
-			light.light_data.use_cascades = light_params.FindOr<Bool>("cascades", false);
-			light.light_data.ray_traced_shadows = light_params.FindOr<Bool>("rts", false);
+			light.light_data.casts_shadows = scene_light.shadows;
+			light.light_data.use_cascades = scene_light.cascades;
+			light.light_data.ray_traced_shadows = scene_light.rts;
 
-			light.light_data.active = light_params.FindOr<Bool>("active", true);
-			light.light_data.volumetric = light_params.FindOr<Bool>("volumetric", false);
-			light.light_data.volumetric_strength = light_params.FindOr<Float>("volumetric_strength", 0.004f);
+			light.light_data.active = scene_light.active;
+			light.light_data.volumetric = scene_light.volumetric;
+			light.light_data.volumetric_strength = scene_light.volumetric_strength;
 
-			light.light_data.lens_flare = light_params.FindOr<Bool>("lens_flare", false);
-			light.light_data.god_rays = light_params.FindOr<Bool>("god_rays", false);
+			light.light_data.lens_flare = scene_light.lens_flare;
+			light.light_data.god_rays = scene_light.god_rays;
 
-			light.light_data.godrays_decay = light_params.FindOr<Float>("godrays_decay", 0.825f);
-			light.light_data.godrays_exposure = light_params.FindOr<Float>("godrays_exposure", 2.0f);
-			light.light_data.godrays_density = light_params.FindOr<Float>("godrays_density", 0.975f);
-			light.light_data.godrays_weight = light_params.FindOr<Float>("godrays_weight", 0.25f);
+			light.light_data.godrays_decay = scene_light.godrays_decay;
+			light.light_data.godrays_exposure = scene_light.godrays_exposure;
+			light.light_data.godrays_density = scene_light.godrays_density;
+			light.light_data.godrays_weight = scene_light.godrays_weight;
 
 			light.mesh_type = LightMesh::NoMesh;
-			std::string mesh = light_params.FindOr<std::string>("mesh", "");
-			if (mesh == "sphere")
+			if (scene_light.mesh == "sphere")
 			{
 				light.mesh_type = LightMesh::Sphere;
 			}
-			else if (mesh == "quad")
+			else if (scene_light.mesh == "quad")
 			{
 				light.mesh_type = LightMesh::Quad;
 			}
-			light.mesh_size = light_params.FindOr<Uint32>("size", 100u);
-			light.light_texture = light_params.FindOr<std::string>("texture", "");
-			if (light.light_texture.has_value() && light.light_texture->empty()) light.light_texture = std::nullopt;
+			light.mesh_size = scene_light.size;
+			if (!scene_light.texture.empty()) light.light_texture = scene_light.texture;
 
 			if (type == "directional")
 			{
@@ -157,57 +184,104 @@ namespace adria
 			{
 				light.light_data.type = LightType::Spot;
 			}
-			else
-			{
-				ADRIA_LOG(WARNING, "Light has invalid type %s! Skipping this light...", type.c_str());
-			}
 
 			config.scene_lights.push_back(std::move(light));
 		}
 
-		JsonParams camera_params(camera);
-		config.camera_params.near_plane = camera_params.FindOr<Float>("near", 1.0f);
-		config.camera_params.far_plane = camera_params.FindOr<Float>("far", 3000.0f);
-		config.camera_params.fov = XMConvertToRadians(camera_params.FindOr<Float>("fov", 90.0f));
+		config.camera_params.near_plane = scene.camera.near_plane;
+		config.camera_params.far_plane = scene.camera.far_plane;
+		config.camera_params.fov = XMConvertToRadians(scene.camera.fov);
+		config.camera_params.position = Vector3(scene.camera.position.data());
+		config.camera_params.look_at = Vector3(scene.camera.look_at.data());
+
+		if (scene.skybox_textures.size() == 1)
+		{
+			config.skybox_params.cubemap = paths::TexturesDir + scene.skybox_textures[0];
+		}
+		else if (scene.skybox_textures.size() == 6)
+		{
+			for (Uint32 i = 0; i < 6; ++i)
+			{
+				config.skybox_params.cubemap_textures[i] = paths::TexturesDir + scene.skybox_textures[i];
+			}
+		}
+		else
+		{
+			ADRIA_LOG(WARNING, "Skybox texture not found or is incorrectly specified!  \
+							Size of texture array has to be either 1 or 6! Fallback to the default one...");
+			config.skybox_params.cubemap = paths::TexturesDir + "Skybox/sunsetcube1024.dds";
+		}
+		config.ini_file = scene.ini;
 
-		Float position[3] = { 0.0f, 0.0f, 0.0f };
-		camera_params.FindArray("position", position);
-		config.camera_params.position = Vector3(position);
+		return true;
+	}
 
-		Float look_at[3] = { 0.0f, 0.0f, 10.0f };
-		camera_params.FindArray("look_at", look_at);
-		config.camera_params.look_at = Vector3(look_at);
+	Bool WriteSceneConfig(SceneConfig const& config, std::string const& scene_file)
+	{
+		SceneFile scene{};
+		scene.ini = config.ini_file;
 
-		JsonParams skybox_params(skybox);
-		std::vector<std::string> skybox_textures;
+		scene.camera.position = ToFloat3(&config.camera_params.position.x);
+		scene.camera.look_at = ToFloat3(&config.camera_params.look_at.x);
+		scene.camera.fov = XMConvertToDegrees(config.camera_params.fov);
+		scene.camera.near_plane = config.camera_params.near_plane;
+		scene.camera.far_plane = config.camera_params.far_plane;
 
-		std::string cubemap[1];
-		if (skybox_params.FindArray("texture", cubemap))
+		if (config.skybox_params.cubemap.has_value())
 		{
-			config.skybox_params.cubemap = paths::TexturesDir + cubemap[0];
+			scene.skybox_textures.push_back(MakeRelativePath(*config.skybox_params.cubemap, paths::TexturesDir));
 		}
 		else
 		{
-			std::string cubemap[6];
-			if (skybox_params.FindArray("texture", cubemap))
+			for (std::string const& face : config.skybox_params.cubemap_textures) scene.skybox_textures.push_back(MakeRelativePath(face, paths::TexturesDir));
+		}
+
+		for (ModelParameters const& model : config.scene_models)
+		{
+			SceneFileModel& scene_model = scene.models.emplace_back();
+			scene_model.path = MakeRelativePath(model.model_path, paths::ModelsDir);
+			if (model.textures_path != GetParentPath(model.model_path) + "\\")
 			{
-				for (std::string& cubemap_face : cubemap)
-				{
-					cubemap_face = paths::TexturesDir + cubemap_face;
-				}
-				config.skybox_params.cubemap_textures = std::to_array(cubemap);
+				scene_model.tex_path = model.textures_path;
 			}
-			else
+			DecomposeModelMatrix(model.model_matrix, scene_model.translation, scene_model.rotation, scene_model.scale);
+			scene_model.use_ccw = model.triangle_ccw;
+			scene_model.force_alpha_mask = model.force_mask_alpha_usage;
+			scene_model.load_model_lights = model.load_model_lights;
+		}
+
+		for (LightParameters const& light : config.scene_lights)
+		{
+			Light const& data = light.light_data;
+			SceneFileLight& scene_light = scene.lights.emplace_back();
+			scene_light.type = LightTypeToString(data.type);
+			if (data.type != LightType::Directional) scene_light.position = ToFloat3(&data.position.x);
+			if (data.type != LightType::Point) scene_light.direction = ToFloat3(&data.direction.x);
+			scene_light.color = ToFloat3(&data.color.x);
+			scene_light.intensity = data.intensity;
+			scene_light.range = data.range;
+			scene_light.outer_angle = XMConvertToDegrees(std::acos(std::clamp(data.outer_cosine, -1.0f, 1.0f)));
+			scene_light.inner_angle = XMConvertToDegrees(std::acos(std::clamp(data.inner_cosine, -1.0f, 1.0f)));
+			scene_light.shadows = data.casts_shadows;
+			scene_light.cascades = data.use_cascades;
+			scene_light.rts = data.ray_traced_shadows;
+			scene_light.active = data.active;
+			scene_light.volumetric = data.volumetric;
+			scene_light.volumetric_strength = data.volumetric_strength;
+			scene_light.lens_flare = data.lens_flare;
+			scene_light.god_rays = data.god_rays;
+			scene_light.godrays_decay = data.godrays_decay;
+			scene_light.godrays_exposure = data.godrays_exposure;
+			scene_light.godrays_density = data.godrays_density;
+			scene_light.godrays_weight = data.godrays_weight;
+			//lights without a mesh keep the default size, the schema rejects a size of 0
+			if (light.mesh_type != LightMesh::NoMesh)
 			{
-				ADRIA_LOG(WARNING, "Skybox texture not found or is incorrectly specified!  \
-								Size of texture array has to be either 1 or 6! Fallback to the default one...");
-				config.skybox_params.cubemap = paths::TexturesDir + "Skybox/sunsetcube1024.dds";
+				scene_light.mesh = light.mesh_type == LightMesh::Quad ? "quad" : "sphere";
+				scene_light.size = light.mesh_size;
 			}
+			scene_light.texture = light.light_texture.value_or("");
 		}
-		config.ini_file = ini_file;
-
-		return true;
+		return WriteSceneFile(scene, scene_file);
 	}
-
 }
-
@@ -1,6 +1,7 @@
 #pragma once
 #include "SceneLoader.h"
 #include "Camera.h"
+#include "SceneConfigSchema.h"
 
 namespace adria
 {
@@ -13,5 +14,9 @@ namespace adria
 		std::string		 ini_file;
 	};
 
-	Bool ParseSceneConfig(std::string const& scene_file, SceneConfig& scene_config, Bool append_dir = true);
-}
\ No newline at end of file
+	Bool ParseSceneConfig(std::string const& scene_file, SceneConfig& scene_config, Bool append_dir = true, std::vector<SceneDiagnostic>* diagnostics = nullptr);
+	Bool WriteSceneConfig(SceneConfig const& scene_config, std::string const& scene_file);
+
+	//rebuilds models, lights, skybox and camera of a scene config from the live registry
+	void ExtractSceneConfig(entt::registry const& reg, Camera const& camera, SceneConfig& scene_config);
+}
@@ -0,0 +1,35 @@
+#include "SceneConfig.h"
+
+namespace adria
+{
+	void ExtractSceneConfig(entt::registry const& reg, Camera const& camera, SceneConfig& config)
+	{
+		config.scene_models.clear();
+		auto model_view = reg.view<ModelParameters const>();
+		for (entt::entity entity : model_view)
+		{
+			config.scene_models.push_back(model_view.get<ModelParameters const>(entity));
+		}
+
+		config.scene_lights.clear();
+		auto light_view = reg.view<LightParameters const, Light const>();
+		for (entt::entity entity : light_view)
+		{
+			auto const& [light_params, light] = light_view.get<LightParameters const, Light const>(entity);
+			LightParameters& scene_light = config.scene_lights.emplace_back(light_params);
+			scene_light.light_data = light;
+		}
+
+		auto skybox_view = reg.view<SkyboxParameters const>();
+		for (entt::entity entity : skybox_view)
+		{
+			config.skybox_params = skybox_view.get<SkyboxParameters const>(entity);
+		}
+
+		config.camera_params.position = camera.Position();
+		config.camera_params.look_at = camera.Position() + camera.Forward();
+		config.camera_params.fov = camera.Fov();
+		config.camera_params.near_plane = std::min(camera.Near(), camera.Far());
+		config.camera_params.far_plane = std::max(camera.Near(), camera.Far());
+	}
+}
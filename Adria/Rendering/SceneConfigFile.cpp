@@ -0,0 +1,214 @@
+#include "SceneConfigFile.h"
+
+namespace adria
+{
+	ADRIA_LOG_CHANNEL(Scene);
+
+	namespace
+	{
+		std::optional<SceneFileFloat3> FindFloat3(JsonParams& params, std::string const& name)
+		{
+			Float values[3];
+			if (!params.FindArray(name, values)) return std::nullopt;
+			return SceneFileFloat3{ values[0], values[1], values[2] };
+		}
+
+		std::optional<Float> FindFloat(JsonParams& params, std::string const& name)
+		{
+			Float value;
+			if (!params.Find<Float>(name, value)) return std::nullopt;
+			return value;
+		}
+
+		SceneFileModel ReadModel(JsonParams& model_params)
+		{
+			SceneFileModel model{};
+			model.path = model_params.FindOr<std::string>("path", "");
+			std::string tex_path;
+			if (model_params.Find<std::string>("tex_path", tex_path)) model.tex_path = tex_path;
+			model.translation = FindFloat3(model_params, "translation").value_or(model.translation);
+			model.rotation = FindFloat3(model_params, "rotation").value_or(model.rotation);
+			model.scale = FindFloat3(model_params, "scale").value_or(model.scale);
+			model_params.Find<Bool>("use_ccw", model.use_ccw);
+			model_params.Find<Bool>("force_alpha_mask", model.force_alpha_mask);
+			model_params.Find<Bool>("load_model_lights", model.load_model_lights);
+			return model;
+		}
+
+		SceneFileLight ReadLight(JsonParams& light_params)
+		{
+			SceneFileLight light{};
+			light.type = light_params.FindOr<std::string>("type", "");
+			light.position = FindFloat3(light_params, "position");
+			light.direction = FindFloat3(light_params, "direction");
+			light.color = FindFloat3(light_params, "color");
+			light.elevation = FindFloat(light_params, "elevation");
+			light.azimuth = FindFloat(light_params, "azimuth");
+			light.temperature = FindFloat(light_params, "temperature");
+			light.intensity = light_params.FindOr<Float>("intensity", light.intensity);
+			light.range = light_params.FindOr<Float>("range", light.range);
+			light.outer_angle = light_params.FindOr<Float>("outer_angle", light.outer_angle);
+			light.inner_angle = light_params.FindOr<Float>("inner_angle", light.inner_angle);
+			light.shadows = light_params.FindOr<Bool>("shadows", light.shadows);
+			light.cascades = light_params.FindOr<Bool>("cascades", light.cascades);
+			light.rts = light_params.FindOr<Bool>("rts", light.rts);
+			light.active = light_params.FindOr<Bool>("active", light.active);
+			light.volumetric = light_params.FindOr<Bool>("volumetric", light.volumetric);
+			light.volumetric_strength = light_params.FindOr<Float>("volumetric_strength", light.volumetric_strength);
+			light.lens_flare = light_params.FindOr<Bool>("lens_flare", light.lens_flare);
+			light.god_rays = light_params.FindOr<Bool>("god_rays", light.god_rays);
+			light.godrays_decay = light_params.FindOr<Float>("godrays_decay", light.godrays_decay);
+			light.godrays_exposure = light_params.FindOr<Float>("godrays_exposure", light.godrays_exposure);
+			light.godrays_density = light_params.FindOr<Float>("godrays_density", light.godrays_density);
+			light.godrays_weight = light_params.FindOr<Float>("godrays_weight", light.godrays_weight);
+			light.mesh = light_params.FindOr<std::string>("mesh", "");
+			light.size = light_params.FindOr<Uint32>("size", light.size);
+			light.texture = light_params.FindOr<std::string>("texture", "");
+			return light;
+		}
+
+		template<typename T>
+		void WriteOptional(json& object, Char const* name, std::optional<T> const& value)
+		{
+			if (value.has_value()) object[name] = *value;
+		}
+	}
+
+	Bool ReadSceneFile(std::string const& scene_file, SceneFile& scene, std::vector<SceneDiagnostic>& diagnostics)
+	{
+		std::ifstream scene_stream(scene_file);
+		if (!scene_stream.is_open())
+		{
+			ADRIA_LOG(ERROR, "Cannot open scene file %s!", scene_file.c_str());
+			return false;
+		}
+		std::string const scene_text((std::istreambuf_iterator<Char>(scene_stream)), std::istreambuf_iterator<Char>());
+
+		diagnostics.clear();
+		json scene_json;
+		Bool valid = true;
+		try
+		{
+			scene_json = json::parse(scene_text);
+			valid = ValidateSceneJson(scene_json, scene_text, scene_file, diagnostics);
+		}
+		catch (json::parse_error const& e)
+		{
+			SceneDiagnostic& diagnostic = diagnostics.emplace_back();
+			diagnostic.file = scene_file;
+			diagnostic.message = e.what();
+			GetLineAndColumn(scene_text, e.byte > 0 ? e.byte - 1 : 0, diagnostic.line, diagnostic.column);
+			valid = false;
+		}
+
+		for (SceneDiagnostic const& diagnostic : diagnostics)
+		{
+			if (diagnostic.error) ADRIA_LOG(ERROR, "%s", diagnostic.ToString().c_str());
+			else ADRIA_LOG(WARNING, "%s", diagnostic.ToString().c_str());
+		}
+		if (!valid) return false;
+
+		JsonParams scene_params(scene_json);
+		json models = scene_params.FindJsonArray("models");
+		json lights = scene_params.FindJsonArray("lights");
+		json camera = scene_params.FindJson("camera");
+		json skybox = scene_params.FindJson("skybox");
+		scene.ini = scene_params.FindOr<std::string>("ini", "default_cvars.ini");
+
+		for (auto&& model_json : models)
+		{
+			JsonParams model_params(model_json);
+			scene.models.push_back(ReadModel(model_params));
+		}
+		for (auto&& light_json : lights)
+		{
+			JsonParams light_params(light_json);
+			scene.lights.push_back(ReadLight(light_params));
+		}
+
+		JsonParams camera_params(camera);
+		scene.camera.near_plane = camera_params.FindOr<Float>("near", scene.camera.near_plane);
+		scene.camera.far_plane = camera_params.FindOr<Float>("far", scene.camera.far_plane);
+		scene.camera.fov = camera_params.FindOr<Float>("fov", scene.camera.fov);
+		scene.camera.position = FindFloat3(camera_params, "position").value_or(scene.camera.position);
+		scene.camera.look_at = FindFloat3(camera_params, "look_at").value_or(scene.camera.look_at);
+
+		JsonParams skybox_params(skybox);
+		if (!skybox_params.FindDynamicArray("texture", scene.skybox_textures)) scene.skybox_textures.clear();
+		return true;
+	}
+
+	Bool WriteSceneFile(SceneFile const& scene, std::string const& scene_file)
+	{
+		json scene_json = json::object();
+		scene_json["ini"] = scene.ini;
+
+		json camera_json = json::object();
+		camera_json["position"] = scene.camera.position;
+		camera_json["look_at"] = scene.camera.look_at;
+		camera_json["fov"] = scene.camera.fov;
+		camera_json["near"] = scene.camera.near_plane;
+		camera_json["far"] = scene.camera.far_plane;
+		scene_json["camera"] = std::move(camera_json);
+		scene_json["skybox"] = json{ { "texture", scene.skybox_textures } };
+
+		json models_json = json::array();
+		for (SceneFileModel const& model : scene.models)
+		{
+			json model_json = json::object();
+			model_json["path"] = model.path;
+			WriteOptional(model_json, "tex_path", model.tex_path);
+			model_json["translation"] = model.translation;
+			model_json["rotation"] = model.rotation;
+			model_json["scale"] = model.scale;
+			model_json["use_ccw"] = model.use_ccw;
+			model_json["force_alpha_mask"] = model.force_alpha_mask;
+			model_json["load_model_lights"] = model.load_model_lights;
+			models_json.push_back(std::move(model_json));
+		}
+		scene_json["models"] = std::move(models_json);
+
+		json lights_json = json::array();
+		for (SceneFileLight const& light : scene.lights)
+		{
+			json light_json = json::object();
+			light_json["type"] = light.type;
+			WriteOptional(light_json, "position", light.position);
+			WriteOptional(light_json, "direction", light.direction);
+			WriteOptional(light_json, "elevation", light.elevation);
+			WriteOptional(light_json, "azimuth", light.azimuth);
+			WriteOptional(light_json, "color", light.color);
+			WriteOptional(light_json, "temperature", light.temperature);
+			light_json["intensity"] = light.intensity;
+			light_json["range"] = light.range;
+			light_json["outer_angle"] = light.outer_angle;
+			light_json["inner_angle"] = light.inner_angle;
+			light_json["shadows"] = light.shadows;
+			light_json["cascades"] = light.cascades;
+			light_json["rts"] = light.rts;
+			light_json["active"] = light.active;
+			light_json["volumetric"] = light.volumetric;
+			light_json["volumetric_strength"] = light.volumetric_strength;
+			light_json["lens_flare"] = light.lens_flare;
+			light_json["god_rays"] = light.god_rays;
+			light_json["godrays_decay"] = light.godrays_decay;
+			light_json["godrays_exposure"] = light.godrays_exposure;
+			light_json["godrays_density"] = light.godrays_density;
+			light_json["godrays_weight"] = light.godrays_weight;
+			light_json["mesh"] = light.mesh;
+			light_json["size"] = light.size;
+			light_json["texture"] = light.texture;
+			lights_json.push_back(std::move(light_json));
+		}
+		scene_json["lights"] = std::move(lights_json);
+
+		std::ofstream scene_stream(scene_file);
+		if (!scene_stream.is_open())
+		{
+			ADRIA_LOG(ERROR, "Cannot open %s for writing the scene!", scene_file.c_str());
+			return false;
+		}
+		scene_stream << scene_json.dump(1, '\t');
+		return scene_stream.good();
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "SceneConfigSchema.h"
+
+namespace adria
+{
+	using SceneFileFloat3 = std::array<Float, 3>;
+
+	//the scene json with the values as they are stored in the file: angles in degrees, paths relative to the models and textures folders.
+	//SceneConfig converts it to and from the math types of the renderer, so reading and writing it doesn't need them
+	struct SceneFileModel
+	{
+		std::string path;
+		std::optional<std::string> tex_path;
+		SceneFileFloat3 translation = { 0.0f, 0.0f, 0.0f };
+		SceneFileFloat3 rotation = { 0.0f, 0.0f, 0.0f };
+		SceneFileFloat3 scale = { 1.0f, 1.0f, 1.0f };
+		Bool use_ccw = true;
+		Bool force_alpha_mask = false;
+		Bool load_model_lights = false;
+
+		Bool operator==(SceneFileModel const&) const = default;
+	};
+
+	struct SceneFileLight
+	{
+		std::string type;
+		std::optional<SceneFileFloat3> position;
+		std::optional<SceneFileFloat3> direction;
+		std::optional<SceneFileFloat3> color;
+		//directional lights can give elevation and azimuth instead of a direction and a temperature instead of a color
+		std::optional<Float> elevation;
+		std::optional<Float> azimuth;
+		std::optional<Float> temperature;
+		Float intensity = 1.0f;
+		Float range = 100.0f;
+		Float outer_angle = 45.0f;
+		Float inner_angle = 22.5f;
+		Bool shadows = true;
+		Bool cascades = false;
+		Bool rts = false;
+		Bool active = true;
+		Bool volumetric = false;
+		Float volumetric_strength = 0.004f;
+		Bool lens_flare = false;
+		Bool god_rays = false;
+		Float godrays_decay = 0.825f;
+		Float godrays_exposure = 2.0f;
+		Float godrays_density = 0.975f;
+		Float godrays_weight = 0.25f;
+		std::string mesh;
+		Uint32 size = 100;
+		std::string texture;
+
+		Bool operator==(SceneFileLight const&) const = default;
+	};
+
+	struct SceneFileCamera
+	{
+		SceneFileFloat3 position = { 0.0f, 0.0f, 0.0f };
+		SceneFileFloat3 look_at = { 0.0f, 0.0f, 10.0f };
+		Float fov = 90.0f;
+		Float near_plane = 1.0f;
+		Float far_plane = 3000.0f;
+
+		Bool operator==(SceneFileCamera const&) const = default;
+	};
+
+	struct SceneFile
+	{
+		std::vector<SceneFileModel> models;
+		std::vector<SceneFileLight> lights;
+		SceneFileCamera camera;
+		std::vector<std::string> skybox_textures;
+		std::string ini = "default_cvars.ini";
+
+		Bool operator==(SceneFile const&) const = default;
+	};
+
+	//parses and validates the scene json, the schema errors and warnings are logged and returned in diagnostics
+	Bool ReadSceneFile(std::string const& scene_file, SceneFile& scene, std::vector<SceneDiagnostic>& diagnostics);
+	Bool WriteSceneFile(SceneFile const& scene, std::string const& scene_file);
+}
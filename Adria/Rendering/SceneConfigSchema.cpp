@@ -0,0 +1,477 @@
+#include <numeric>
+#include <cstring>
+#include "SceneConfigSchema.h"
+
+namespace adria
+{
+	namespace
+	{
+		enum class SceneFieldType : Uint8
+		{
+			Bool,
+			Number,
+			Unsigned,
+			String,
+			Float3,
+			StringArray,
+			Object,
+			Array
+		};
+
+		struct SceneField
+		{
+			Char const* name;
+			SceneFieldType type;
+			Bool required = false;
+			json default_value = nullptr;
+			Float min_value = std::numeric_limits<Float>::lowest();
+			Float max_value = std::numeric_limits<Float>::max();
+			std::vector<std::string> allowed_values = {};
+		};
+
+		std::vector<SceneField> const& GetRootSchema()
+		{
+			static std::vector<SceneField> const schema =
+			{
+				{ .name = "ini",	.type = SceneFieldType::String, .default_value = "default_cvars.ini" },
+				{ .name = "camera", .type = SceneFieldType::Object },
+				{ .name = "skybox", .type = SceneFieldType::Object },
+				{ .name = "models", .type = SceneFieldType::Array },
+				{ .name = "lights", .type = SceneFieldType::Array },
+			};
+			return schema;
+		}
+
+		std::vector<SceneField> const& GetCameraSchema()
+		{
+			static std::vector<SceneField> const schema =
+			{
+				{ .name = "position", .type = SceneFieldType::Float3 },
+				{ .name = "look_at",  .type = SceneFieldType::Float3 },
+				{ .name = "fov",	  .type = SceneFieldType::Number, .default_value = 90.0f, .min_value = 1.0f, .max_value = 179.0f },
+				{ .name = "near",	  .type = SceneFieldType::Number, .default_value = 1.0f, .min_value = 1e-4f },
+				{ .name = "far",	  .type = SceneFieldType::Number, .default_value = 3000.0f, .min_value = 1e-4f },
+			};
+			return schema;
+		}
+
+		std::vector<SceneField> const& GetSkyboxSchema()
+		{
+			static std::vector<SceneField> const schema =
+			{
+				{ .name = "texture", .type = SceneFieldType::StringArray },
+			};
+			return schema;
+		}
+
+		std::vector<SceneField> const& GetModelSchema()
+		{
+			static std::vector<SceneField> const schema =
+			{
+				{ .name = "path",			   .type = SceneFieldType::String, .required = true },
+				{ .name = "tex_path",		   .type = SceneFieldType::String },
+				{ .name = "translation",	   .type = SceneFieldType::Float3 },
+				{ .name = "rotation",		   .type = SceneFieldType::Float3 },
+				{ .name = "scale",			   .type = SceneFieldType::Float3 },
+				{ .name = "use_ccw",		   .type = SceneFieldType::Bool, .default_value = true },
+				{ .name = "force_alpha_mask",  .type = SceneFieldType::Bool, .default_value = false },
+				{ .name = "load_model_lights", .type = SceneFieldType::Bool, .default_value = false },
+			};
+			return schema;
+		}
+
+		std::vector<SceneField> const& GetLightSchema()
+		{
+			static std::vector<SceneField> const schema =
+			{
+				{ .name = "type",				 .type = SceneFieldType::String, .required = true, .allowed_values = { "directional", "point", "spot" } },
+				{ .name = "position",			 .type = SceneFieldType::Float3 },
+				{ .name = "direction",			 .type = SceneFieldType::Float3 },
+				{ .name = "elevation",			 .type = SceneFieldType::Number, .min_value = -90.0f, .max_value = 90.0f },
+				{ .name = "azimuth",			 .type = SceneFieldType::Number, .min_value = -360.0f, .max_value = 360.0f },
+				{ .name = "color",				 .type = SceneFieldType::Float3 },
+				{ .name = "temperature",		 .type = SceneFieldType::Number, .min_value = 1000.0f, .max_value = 15000.0f },
+				{ .name = "intensity",			 .type = SceneFieldType::Number, .default_value = 1.0f, .min_value = 0.0f },
+				{ .name = "range",				 .type = SceneFieldType::Number, .default_value = 100.0f, .min_value = 0.0f },
+				{ .name = "outer_angle",		 .type = SceneFieldType::Number, .default_value = 45.0f, .min_value = 0.0f, .max_value = 90.0f },
+				{ .name = "inner_angle",		 .type = SceneFieldType::Number, .default_value = 22.5f, .min_value = 0.0f, .max_value = 90.0f },
+				{ .name = "shadows",			 .type = SceneFieldType::Bool, .default_value = true },
+				{ .name = "cascades",			 .type = SceneFieldType::Bool, .default_value = false },
+				{ .name = "rts",				 .type = SceneFieldType::Bool, .default_value = false },
+				{ .name = "active",				 .type = SceneFieldType::Bool, .default_value = true },
+				{ .name = "volumetric",			 .type = SceneFieldType::Bool, .default_value = false },
+				{ .name = "volumetric_strength", .type = SceneFieldType::Number, .default_value = 0.004f, .min_value = 0.0f },
+				{ .name = "lens_flare",			 .type = SceneFieldType::Bool, .default_value = false },
+				{ .name = "god_rays",			 .type = SceneFieldType::Bool, .default_value = false },
+				{ .name = "godrays_decay",		 .type = SceneFieldType::Number, .default_value = 0.825f, .min_value = 0.0f },
+				{ .name = "godrays_exposure",	 .type = SceneFieldType::Number, .default_value = 2.0f, .min_value = 0.0f },
+				{ .name = "godrays_density",	 .type = SceneFieldType::Number, .default_value = 0.975f, .min_value = 0.0f },
+				{ .name = "godrays_weight",		 .type = SceneFieldType::Number, .default_value = 0.25f, .min_value = 0.0f },
+				{ .name = "mesh",				 .type = SceneFieldType::String, .default_value = "", .allowed_values = { "", "quad", "sphere" } },
+				{ .name = "size",				 .type = SceneFieldType::Unsigned, .default_value = 100u, .min_value = 1.0f },
+				{ .name = "texture",			 .type = SceneFieldType::String, .default_value = "" },
+			};
+			return schema;
+		}
+
+		Char const* GetFieldTypeName(SceneFieldType type)
+		{
+			switch (type)
+			{
+			case SceneFieldType::Bool:		  return "a boolean";
+			case SceneFieldType::Number:	  return "a number";
+			case SceneFieldType::Unsigned:	  return "a non-negative integer";
+			case SceneFieldType::String:	  return "a string";
+			case SceneFieldType::Float3:	  return "an array of 3 numbers";
+			case SceneFieldType::StringArray: return "an array of strings";
+			case SceneFieldType::Object:	  return "an object";
+			case SceneFieldType::Array:		  return "an array";
+			}
+			return "";
+		}
+
+		Uint64 EditDistance(std::string_view a, std::string_view b)
+		{
+			std::vector<Uint64> row(b.size() + 1);
+			std::iota(row.begin(), row.end(), 0);
+			for (Uint64 i = 1; i <= a.size(); ++i)
+			{
+				Uint64 diagonal = row[0];
+				row[0] = i;
+				for (Uint64 j = 1; j <= b.size(); ++j)
+				{
+					Uint64 const above = row[j];
+					row[j] = std::min({ row[j] + 1, row[j - 1] + 1, diagonal + (a[i - 1] != b[j - 1]) });
+					diagonal = above;
+				}
+			}
+			return row[b.size()];
+		}
+
+		//nlohmann json doesn't keep source positions, so the text is scanned once more
+		//and the offset of every value is recorded by its json pointer, members point at their key
+		class JsonPositionIndex
+		{
+		public:
+			explicit JsonPositionIndex(std::string_view text) : text(text)
+			{
+				ScanValue("");
+			}
+
+			Uint64 Find(std::string pointer) const
+			{
+				while (true)
+				{
+					if (auto it = offsets.find(pointer); it != offsets.end()) return it->second;
+					if (pointer.empty()) return 0;
+					pointer.erase(pointer.rfind('/'));
+				}
+			}
+
+		private:
+			std::string_view text;
+			Uint64 pos = 0;
+			std::unordered_map<std::string, Uint64> offsets;
+
+		private:
+			Bool AtEnd() const { return pos >= text.size(); }
+
+			void SkipWhitespace()
+			{
+				while (!AtEnd() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+			}
+
+			std::string ScanString()
+			{
+				std::string value;
+				++pos;
+				while (!AtEnd() && text[pos] != '"')
+				{
+					if (text[pos] == '\\' && pos + 1 < text.size()) value += text[pos++];
+					value += text[pos++];
+				}
+				++pos;
+				return value;
+			}
+
+			static std::string EscapeToken(std::string const& token)
+			{
+				std::string escaped;
+				for (Char c : token)
+				{
+					if (c == '~') escaped += "~0";
+					else if (c == '/') escaped += "~1";
+					else escaped += c;
+				}
+				return escaped;
+			}
+
+			void ScanValue(std::string const& pointer)
+			{
+				SkipWhitespace();
+				offsets.try_emplace(pointer, pos);
+				if (AtEnd()) return;
+
+				Char const c = text[pos];
+				if (c == '{' || c == '[')
+				{
+					Bool const is_object = c == '{';
+					Char const closing = is_object ? '}' : ']';
+					++pos;
+					SkipWhitespace();
+					Uint64 index = 0;
+					while (!AtEnd() && text[pos] != closing)
+					{
+						std::string child = pointer + "/";
+						if (is_object)
+						{
+							Uint64 const key_offset = pos;
+							child += EscapeToken(ScanString());
+							offsets[child] = key_offset;
+							SkipWhitespace();
+							++pos;
+						}
+						else
+						{
+							child += std::to_string(index++);
+						}
+						ScanValue(child);
+						SkipWhitespace();
+						if (!AtEnd() && text[pos] == ',')
+						{
+							++pos;
+							SkipWhitespace();
+						}
+					}
+					++pos;
+				}
+				else if (c == '"')
+				{
+					ScanString();
+				}
+				else
+				{
+					while (!AtEnd() && !std::strchr(",]} \t\r\n", text[pos])) ++pos;
+				}
+			}
+		};
+
+		class SceneValidator
+		{
+		public:
+			SceneValidator(std::string_view text, std::string const& file, std::vector<SceneDiagnostic>& diagnostics)
+				: text(text), file(file), diagnostics(diagnostics), positions(text)
+			{}
+
+			Bool ValidateObject(json& object, std::string const& pointer, std::vector<SceneField> const& schema)
+			{
+				if (!object.is_object())
+				{
+					Report(pointer, true, "expected an object");
+					return false;
+				}
+
+				Bool valid = true;
+				for (auto const& [key, value] : object.items())
+				{
+					if (std::none_of(schema.begin(), schema.end(), [&key](SceneField const& field) { return key == field.name; }))
+					{
+						std::string message = "unknown key '" + key + "'";
+						if (Char const* suggestion = FindClosestField(key, schema)) message += ", did you mean '" + std::string(suggestion) + "'?";
+						Report(pointer + "/" + key, false, message);
+					}
+				}
+
+				for (SceneField const& field : schema)
+				{
+					if (!object.contains(field.name))
+					{
+						if (field.required)
+						{
+							Report(pointer, true, std::string("missing required key '") + field.name + "'");
+							valid = false;
+						}
+						else if (!field.default_value.is_null())
+						{
+							object[field.name] = field.default_value;
+						}
+						continue;
+					}
+					valid &= ValidateField(object[field.name], pointer + "/" + field.name, field);
+				}
+				return valid;
+			}
+
+			void Report(std::string const& pointer, Bool error, std::string const& message)
+			{
+				SceneDiagnostic& diagnostic = diagnostics.emplace_back();
+				diagnostic.file = file;
+				diagnostic.error = error;
+				diagnostic.message = message;
+				GetLineAndColumn(text, positions.Find(pointer), diagnostic.line, diagnostic.column);
+			}
+
+		private:
+			std::string_view text;
+			std::string const& file;
+			std::vector<SceneDiagnostic>& diagnostics;
+			JsonPositionIndex positions;
+
+		private:
+			Bool ValidateField(json& value, std::string const& pointer, SceneField const& field)
+			{
+				Bool type_matches = false;
+				switch (field.type)
+				{
+				case SceneFieldType::Bool:		  type_matches = value.is_boolean(); break;
+				case SceneFieldType::Number:	  type_matches = value.is_number(); break;
+				case SceneFieldType::Unsigned:	  type_matches = value.is_number_unsigned(); break;
+				case SceneFieldType::String:	  type_matches = value.is_string(); break;
+				case SceneFieldType::Object:	  type_matches = value.is_object(); break;
+				case SceneFieldType::Array:		  type_matches = value.is_array(); break;
+				case SceneFieldType::Float3:
+					type_matches = value.is_array() && value.size() == 3 && std::all_of(value.begin(), value.end(), [](json const& v) { return v.is_number(); });
+					break;
+				case SceneFieldType::StringArray:
+					type_matches = value.is_array() && std::all_of(value.begin(), value.end(), [](json const& v) { return v.is_string(); });
+					break;
+				}
+				if (!type_matches)
+				{
+					Report(pointer, true, std::string("'") + field.name + "' must be " + GetFieldTypeName(field.type));
+					return false;
+				}
+
+				//integers are accepted where numbers are expected, the parser reads them as floats
+				if (field.type == SceneFieldType::Number)
+				{
+					value = value.get<Float>();
+				}
+				else if (field.type == SceneFieldType::Float3)
+				{
+					for (json& component : value) component = component.get<Float>();
+				}
+
+				if (field.type == SceneFieldType::Number || field.type == SceneFieldType::Unsigned)
+				{
+					Float const number = value.get<Float>();
+					if (number < field.min_value || number > field.max_value)
+					{
+						std::string range = "[" + (field.min_value == std::numeric_limits<Float>::lowest() ? std::string("-inf") : std::format("{}", field.min_value)) +
+											", " + (field.max_value == std::numeric_limits<Float>::max() ? std::string("inf") : std::format("{}", field.max_value)) + "]";
+						Report(pointer, true, std::format("'{}' must be in range {}, got {}", field.name, range, number));
+						return false;
+					}
+				}
+
+				if (field.type == SceneFieldType::String && !field.allowed_values.empty())
+				{
+					std::string const& string_value = value.get_ref<std::string const&>();
+					if (std::find(field.allowed_values.begin(), field.allowed_values.end(), string_value) == field.allowed_values.end())
+					{
+						std::string allowed;
+						for (std::string const& allowed_value : field.allowed_values)
+						{
+							if (!allowed.empty()) allowed += ", ";
+							allowed += "'" + allowed_value + "'";
+						}
+						Report(pointer, true, std::format("'{}' has invalid value '{}', expected one of {}", field.name, string_value, allowed));
+						return false;
+					}
+				}
+				return true;
+			}
+
+			static Char const* FindClosestField(std::string const& key, std::vector<SceneField> const& schema)
+			{
+				Char const* closest = nullptr;
+				Uint64 closest_distance = 3;
+				for (SceneField const& field : schema)
+				{
+					Uint64 const distance = EditDistance(key, field.name);
+					if (distance < closest_distance)
+					{
+						closest_distance = distance;
+						closest = field.name;
+					}
+				}
+				return closest;
+			}
+		};
+
+		template<typename ValidateEntryFn>
+		void ValidateEntries(SceneValidator& validator, json& entries, Char const* array_name, Char const* entry_name, ValidateEntryFn&& validate_entry)
+		{
+			std::vector<Uint64> invalid_entries;
+			for (Uint64 i = 0; i < entries.size(); ++i)
+			{
+				std::string const pointer = std::format("/{}/{}", array_name, i);
+				if (!validate_entry(entries[i], pointer))
+				{
+					validator.Report(pointer, false, std::format("skipping invalid {} {}", entry_name, i));
+					invalid_entries.push_back(i);
+				}
+			}
+			for (auto it = invalid_entries.rbegin(); it != invalid_entries.rend(); ++it)
+			{
+				entries.erase(*it);
+			}
+		}
+	}
+
+	std::string SceneDiagnostic::ToString() const
+	{
+		return std::format("{}:{}:{}: {}: {}", file, line, column, error ? "error" : "warning", message);
+	}
+
+	Bool ValidateSceneJson(json& scene_json, std::string_view scene_text, std::string const& scene_file, std::vector<SceneDiagnostic>& diagnostics)
+	{
+		SceneValidator validator(scene_text, scene_file, diagnostics);
+		if (!validator.ValidateObject(scene_json, "", GetRootSchema())) return false;
+
+		if (!scene_json.contains("camera")) scene_json["camera"] = json::object();
+		if (!scene_json.contains("skybox")) scene_json["skybox"] = json::object();
+		if (!scene_json.contains("models")) scene_json["models"] = json::array();
+		if (!scene_json.contains("lights")) scene_json["lights"] = json::array();
+
+		Bool valid = validator.ValidateObject(scene_json["camera"], "/camera", GetCameraSchema());
+		valid &= validator.ValidateObject(scene_json["skybox"], "/skybox", GetSkyboxSchema());
+		ValidateEntries(validator, scene_json["models"], "models", "model", [&validator](json& model, std::string const& pointer)
+		{
+			return validator.ValidateObject(model, pointer, GetModelSchema());
+		});
+		ValidateEntries(validator, scene_json["lights"], "lights", "light", [&validator](json& light, std::string const& pointer)
+		{
+			Bool const has_inner_angle = light.is_object() && light.contains("inner_angle");
+			if (!validator.ValidateObject(light, pointer, GetLightSchema())) return false;
+			//the default inner angle must not turn a narrow spot light with only an outer angle into an invalid one
+			if (!has_inner_angle)
+			{
+				light["inner_angle"] = std::min(light["inner_angle"].get<Float>(), light["outer_angle"].get<Float>());
+			}
+			else if (light["inner_angle"].get<Float>() > light["outer_angle"].get<Float>())
+			{
+				validator.Report(pointer + "/inner_angle", true, "'inner_angle' must not be larger than 'outer_angle'");
+				return false;
+			}
+			return true;
+		});
+		return valid;
+	}
+
+	void GetLineAndColumn(std::string_view text, Uint64 offset, Uint32& line, Uint32& column)
+	{
+		offset = std::min<Uint64>(offset, text.size());
+		line = 1;
+		Uint64 line_start = 0;
+		for (Uint64 i = 0; i < offset; ++i)
+		{
+			if (text[i] == '\n')
+			{
+				++line;
+				line_start = i + 1;
+			}
+		}
+		column = static_cast<Uint32>(offset - line_start + 1);
+	}
+}
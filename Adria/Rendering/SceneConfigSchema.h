@@ -0,0 +1,24 @@
+#pragma once
+#include "Utilities/Json.h"
+
+namespace adria
+{
+	struct SceneDiagnostic
+	{
+		std::string file;
+		Uint32 line = 0;
+		Uint32 column = 0;
+		Bool error = true;
+		std::string message;
+
+		std::string ToString() const;
+	};
+
+	//checks the scene json against the scene schema: field types, ranges, allowed values and unknown keys.
+	//missing optional fields are filled with their defaults, invalid models and lights are removed.
+	//returns false if the scene itself (root, camera or skybox) is invalid
+	Bool ValidateSceneJson(json& scene_json, std::string_view scene_text, std::string const& scene_file, std::vector<SceneDiagnostic>& diagnostics);
+
+	//maps a byte offset of the scene text to a 1-based line and column
+	void GetLineAndColumn(std::string_view text, Uint64 offset, Uint32& line, Uint32& column);
+}
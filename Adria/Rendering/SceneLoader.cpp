@@ -13,6 +13,7 @@
 #include "Utilities/StringConversions.h"
 #include "Utilities/PathHelpers.h"
 #include "Utilities/Heightmap.h"
+#include "TerrainLOD.h"
 
 
 using namespace DirectX;
@@ -45,6 +46,7 @@ namespace adria
 
         reg.emplace<Skybox>(skybox, sky);
         reg.emplace<Tag>(skybox, "Skybox");
+        reg.emplace<SkyboxParameters>(skybox, params);
         return skybox;
 
     }
@@ -141,16 +143,14 @@ namespace adria
             reg.emplace<Tag>(light, "Point Light");
             break;
         }
+        reg.emplace<LightParameters>(light, params);
         return light;
     }
 
 	std::vector<entt::entity> SceneLoader::LoadGrid(GridParameters const& params)
 	{
-		if (params.heightmap)
-		{
-			ADRIA_ASSERT(params.heightmap->Depth() == params.tile_count_z + 1);
-			ADRIA_ASSERT(params.heightmap->Width() == params.tile_count_x + 1);
-		}
+		//heightmaps that don't match the grid, like the ones loaded from files, are resampled
+		Bool const resample_heightmap = params.heightmap && (params.heightmap->Width() != params.tile_count_x + 1 || params.heightmap->Depth() != params.tile_count_z + 1);
 
 		std::vector<entt::entity> chunks;
 		std::vector<TexturedNormalVertex> vertices{};
@@ -162,7 +162,11 @@ namespace adria
 			for (Uint64 i = 0; i <= params.tile_count_x; i++)
 			{
 				TexturedNormalVertex vertex{};
-				Float height = params.heightmap ? params.heightmap->HeightAt(i, j) : 0.0f;
+				Float height = 0.0f;
+				if (params.heightmap)
+				{
+					height = resample_heightmap ? params.heightmap->SampleHeight((Float)i / params.tile_count_x, (Float)j / params.tile_count_z) : params.heightmap->HeightAt(i, j);
+				}
 
 				vertex.position = Vector3(
 					(i * params.tile_size_x) - offset_x,
@@ -178,7 +182,101 @@ namespace adria
 			}
 		}
 
-		if (!params.split_to_chunks)
+		Bool use_terrain_lod = params.split_to_chunks && params.terrain_lod;
+		if (use_terrain_lod)
+		{
+			Uint64 const chunk_tile_count = params.chunk_count_x;
+			Bool const power_of_two = chunk_tile_count > 0 && (chunk_tile_count & (chunk_tile_count - 1)) == 0;
+			if (!power_of_two || params.chunk_count_z != chunk_tile_count || params.tile_count_x % chunk_tile_count != 0 || params.tile_count_z % chunk_tile_count != 0)
+			{
+				ADRIA_LOG(WARNING, "Terrain LOD needs square power of two chunks that divide the grid, loading the grid without LOD");
+				use_terrain_lod = false;
+			}
+		}
+
+		if (use_terrain_lod)
+		{
+			Uint64 const row_pitch = params.tile_count_x + 1;
+			std::vector<Uint32> indices{};
+			indices.reserve(params.tile_count_x * params.tile_count_z * 6);
+			for (Uint64 j = 0; j < params.tile_count_z; ++j)
+			{
+				for (Uint64 i = 0; i < params.tile_count_x; ++i)
+				{
+					Uint32 const i1 = static_cast<Uint32>(j * row_pitch + i);
+					Uint32 const i2 = i1 + 1;
+					Uint32 const i3 = static_cast<Uint32>(i1 + row_pitch);
+					Uint32 const i4 = i3 + 1;
+					indices.insert(indices.end(), { i1, i3, i2, i2, i3, i4 });
+				}
+			}
+			//normals are computed on the whole grid so they match across the chunk borders
+			ComputeNormals(params.normal_type, vertices, indices);
+
+			std::vector<Float> heights(vertices.size());
+			for (Uint64 k = 0; k < vertices.size(); ++k) heights[k] = vertices[k].position.y;
+
+			TerrainLODDesc terrain_desc{
+				.chunk_tile_count = static_cast<Uint32>(params.chunk_count_x),
+				.chunk_count_x = static_cast<Uint32>(params.tile_count_x / params.chunk_count_x),
+				.chunk_count_z = static_cast<Uint32>(params.tile_count_z / params.chunk_count_z),
+				.tile_size_x = params.tile_size_x,
+				.tile_size_z = params.tile_size_z,
+				.origin = Vector3(-offset_x, 0.0f, -offset_z)
+			};
+			std::shared_ptr<TerrainLOD> terrain = std::make_shared<TerrainLOD>(terrain_desc, heights);
+
+			//each chunk gets its own block of vertices so the shared index lists can address them with base_vertex_location
+			Uint32 const chunk_tile_count = terrain_desc.chunk_tile_count;
+			std::vector<TexturedNormalVertex> chunk_vertices{};
+			chunk_vertices.reserve(terrain->GetChunkCount() * terrain->GetChunkVertexCount());
+			for (Uint32 chunk_z = 0; chunk_z < terrain_desc.chunk_count_z; ++chunk_z)
+			{
+				for (Uint32 chunk_x = 0; chunk_x < terrain_desc.chunk_count_x; ++chunk_x)
+				{
+					for (Uint64 k = 0; k <= chunk_tile_count; ++k)
+					{
+						auto row_begin = vertices.begin() + (chunk_z * chunk_tile_count + k) * row_pitch + chunk_x * chunk_tile_count;
+						chunk_vertices.insert(chunk_vertices.end(), row_begin, row_begin + chunk_tile_count + 1);
+					}
+				}
+			}
+
+			GfxBufferDesc vb_desc{
+				.size = chunk_vertices.size() * sizeof(TexturedNormalVertex),
+				.bind_flags = GfxBindFlag::None,
+				.stride = sizeof(TexturedNormalVertex)
+			};
+
+			GfxBufferDesc ib_desc{
+				.size = terrain->GetIndices().size() * sizeof(Uint32),
+				.bind_flags = GfxBindFlag::None,
+				.stride = sizeof(Uint32),
+				.format = GfxFormat::R32_UINT
+			};
+
+			std::shared_ptr<GfxBuffer> vb = std::make_shared<GfxBuffer>(gfx, vb_desc, chunk_vertices.data());
+			std::shared_ptr<GfxBuffer> ib = std::make_shared<GfxBuffer>(gfx, ib_desc, terrain->GetIndices().data());
+
+			TerrainIndexRange const full_resolution_range = terrain->GetIndexRange(0, TerrainEdge_None);
+			for (Uint32 chunk_index = 0; chunk_index < terrain->GetChunkCount(); ++chunk_index)
+			{
+				entt::entity chunk = reg.create();
+
+				SubMesh submesh{};
+				submesh.vertex_buffer = vb;
+				submesh.index_buffer = ib;
+				submesh.indices_count = full_resolution_range.count;
+				submesh.start_index_location = full_resolution_range.offset;
+				submesh.base_vertex_location = static_cast<Int32>(chunk_index * terrain->GetChunkVertexCount());
+				submesh.bounding_box = terrain->GetChunkBoundingBox(chunk_index);
+				reg.emplace<SubMesh>(chunk, submesh);
+				reg.emplace<Transform>(chunk);
+				reg.emplace<TerrainChunk>(chunk, terrain, chunk_index);
+				chunks.push_back(chunk);
+			}
+		}
+		else if (!params.split_to_chunks)
 		{
 			std::vector<Uint32> indices{};
 			Uint32 i1 = 0;
@@ -397,14 +495,16 @@ namespace adria
 			else return ModelFormat::Unknown;
 		};
 
+		entt::entity model = entt::null;
 		ModelFormat format = GetModelFormat(params.model_path);
 		switch (format)
 		{
-		case ModelFormat::GLTF: return LoadModel_GLTF(params);
-		case ModelFormat::OBJ:  return LoadModel_OBJ(params);
+		case ModelFormat::GLTF: model = LoadModel_GLTF(params); break;
+		case ModelFormat::OBJ:  model = LoadModel_OBJ(params); break;
 		case ModelFormat::Unknown: ADRIA_ASSERT_MSG(false, "Unknown model format!");
 		}
-		return entt::null;
+		if (model != entt::null) reg.emplace<ModelParameters>(model, params);
+		return model;
 	}
 
 	entt::entity SceneLoader::LoadModel_GLTF(ModelParameters const& params)
@@ -735,7 +835,9 @@ namespace adria
 				params.model_matrix.Decompose(scale, rotation, translation);
 				light_params.light_data.range *= (scale.x + scale.y + scale.z) / 3;
 
-				LoadLight(light_params);
+				//lights of a model are recreated when the model is loaded, they are not saved with the scene
+				entt::entity light = LoadLight(light_params);
+				reg.remove<LightParameters>(light);
 			}
 		}
 
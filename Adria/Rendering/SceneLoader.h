@@ -39,6 +39,9 @@ namespace adria
 		Uint64 chunk_count_x;
 		Uint64 chunk_count_z;
 		Bool split_to_chunks = false;
+		//chunks get one index list per lod, picked every frame from the camera distance. needs split_to_chunks with
+		//chunk_count_x == chunk_count_z a power of two, each chunk then gets its own copy of its vertices
+		Bool terrain_lod = false;
 		NormalCalculation normal_type = NormalCalculation::None;
 		std::unique_ptr<Heightmap> heightmap;
 	};
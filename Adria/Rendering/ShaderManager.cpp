@@ -627,6 +627,9 @@ namespace adria
 			shader_desc.file = paths::ShaderDir + GetShaderSource(shader);
 			shader_desc.flags = GetShaderCompilerFlags();
 			shader_desc.defines = shader.GetDefines();
+#if GFX_SHADER_ASSERT
+			shader_desc.defines.push_back(GfxShaderDefine{ .name = "GPU_ASSERT_SHADER_ID", .value = std::to_string((Uint32)shader.GetShaderID()) });
+#endif
 
 			GfxShaderCompileOutput output;
 			Bool compile_result = GfxShaderCompiler::CompileShader(shader_desc, output);
@@ -657,7 +660,6 @@ namespace adria
 		file_watcher = std::make_unique<FileWatcher>();
 		file_watcher->AddPathToWatch(paths::ShaderDir);
 		std::ignore = file_watcher->GetFileModifiedEvent().AddStatic(OnShaderFileChanged);
-		fs::create_directory(paths::ShaderCacheDir);
 		if (CommandLineOptions::GetShaderDebug())
 		{
 			OptimizeShaders->Set(false);
@@ -681,6 +683,12 @@ namespace adria
 		return shader_map[shader_key];
 	}
 
+	std::string ShaderManager::GetShaderName(ShaderID shader)
+	{
+		if (shader == ShaderID_Invalid || shader >= ShaderId_Count) return "Unknown";
+		return GetShaderSource(shader) + ":" + GetEntryPoint(shader);
+	}
+
 	ShaderRecompiledEvent& ShaderManager::GetShaderRecompiledEvent()
 	{
 		return shader_recompiled_event;
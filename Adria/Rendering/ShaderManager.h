@@ -143,6 +143,8 @@ namespace adria
 		static ShaderRecompiledEvent& GetShaderRecompiledEvent();
 		static LibraryRecompiledEvent& GetLibraryRecompiledEvent();
 		static GfxShader const& GetGfxShader(GfxShaderKey const& shader_key);
+		//source file and entry point, e.g. "Tonemap.hlsl:TonemapCS"
+		static std::string GetShaderName(ShaderID shader);
 	};
 	#define SM_GetGfxShader(key) ShaderManager::GetGfxShader(key)
 }
\ No newline at end of file
@@ -62,6 +62,8 @@ namespace adria
 		Int32  sheenE_idx;
 		Int32  triangle_overdraw_idx;
 		Float  rain_total_time;
+		Float  depth_linearization_scale;
+		Float  depth_linearization_bias;
 	};
 
 	struct LightGPU
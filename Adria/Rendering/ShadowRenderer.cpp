@@ -231,8 +231,8 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx("Shadow Settings", ImGuiTreeNodeFlags_None))
 				{
-					ImGui::SliderFloat("Cascades Split Lambda", CascadesSplitLambda.GetPtr(), 0.0f, 1.0f);
-					ImGui::SliderFloat("Far Plane Factor", ShadowFarFactor.GetPtr(), 0.1f, 4.0f);
+					GUI_SliderFloat("Cascades Split Lambda", *CascadesSplitLambda, 0.0f, 1.0f);
+					GUI_SliderFloat("Far Plane Factor", *ShadowFarFactor, 0.1f, 4.0f);
 
 					ImGui::TreePop();
 					ImGui::Separator();
@@ -3,6 +3,7 @@
 #include "Components.h"
 #include "TextureManager.h"
 #include "BlackboardData.h"
+#include "DepthProjection.h"
 #include "ShaderManager.h"
 #include "Graphics/GfxPipelineState.h"
 #include "Graphics/GfxReflection.h"
@@ -218,7 +219,7 @@ namespace adria
 		gfx_pso_desc.rasterizer_state.cull_mode = GfxCullMode::None;
 		gfx_pso_desc.depth_state.depth_enable = true;
 		gfx_pso_desc.depth_state.depth_write_mask = GfxDepthWriteMask::Zero;
-		gfx_pso_desc.depth_state.depth_func = GfxComparisonFunc::GreaterEqual;
+		gfx_pso_desc.depth_state.depth_func = DepthTestFunc;
 		gfx_pso_desc.num_render_targets = 1;
 		gfx_pso_desc.rtv_formats[0] = GfxFormat::R16G16B16A16_FLOAT;
 		gfx_pso_desc.dsv_format = GfxFormat::D32_FLOAT;
@@ -2,6 +2,7 @@
 #include "ShaderManager.h"
 #include "Components.h"
 #include "BlackboardData.h"
+#include "DepthProjection.h"
 #include "PostProcessor.h"
 #include "Graphics/GfxReflection.h"
 #include "Graphics/GfxPipelineState.h"
@@ -89,7 +90,7 @@ namespace adria
 		gfx_pso_desc.blend_state.render_target[0].blend_op = GfxBlendOp::Add;
 		gfx_pso_desc.depth_state.depth_enable = true;
 		gfx_pso_desc.depth_state.depth_write_mask = GfxDepthWriteMask::Zero;
-		gfx_pso_desc.depth_state.depth_func = GfxComparisonFunc::GreaterEqual;
+		gfx_pso_desc.depth_state.depth_func = DepthTestFunc;
 		gfx_pso_desc.num_render_targets = 1;
 		gfx_pso_desc.rtv_formats[0] = GfxFormat::R16G16B16A16_FLOAT;
 		gfx_pso_desc.dsv_format = GfxFormat::D32_FLOAT;
@@ -91,7 +91,7 @@ namespace adria
 	{
 		QueueGUI([&]()
 			{
-				ImGui::Checkbox("TAA", TAA.GetPtr());
+				GUI_Checkbox("TAA", *TAA);
 			}, GUICommandGroup_PostProcessing, GUICommandSubGroup_Antialiasing);
 	}
 
@@ -0,0 +1,199 @@
+#include "TerrainLOD.h"
+
+namespace adria
+{
+	void GenerateTerrainChunkIndices(Uint32 chunk_tile_count, Uint32 lod, Uint32 stitch_mask, std::vector<Uint32>& indices)
+	{
+		Uint32 const n = chunk_tile_count;
+		Uint32 const step = 1u << lod;
+		ADRIA_ASSERT(step <= n && n % step == 0);
+		//the coarsest lod is a single quad, no neighbor can be coarser than that
+		if (step == n) stitch_mask = TerrainEdge_None;
+
+		auto GetVertex = [&](Uint32 x, Uint32 z)
+			{
+				if (x == 0 && (stitch_mask & TerrainEdge_NegativeX) && (z / step) % 2 == 1) z -= step;
+				else if (x == n && (stitch_mask & TerrainEdge_PositiveX) && (z / step) % 2 == 1) z -= step;
+				if (z == 0 && (stitch_mask & TerrainEdge_NegativeZ) && (x / step) % 2 == 1) x -= step;
+				else if (z == n && (stitch_mask & TerrainEdge_PositiveZ) && (x / step) % 2 == 1) x -= step;
+				return z * (n + 1) + x;
+			};
+		auto AddTriangle = [&](Uint32 i1, Uint32 i2, Uint32 i3)
+			{
+				//triangles that lost an edge to the collapse are covered by their neighbors
+				if (i1 == i2 || i2 == i3 || i1 == i3) return;
+				indices.push_back(i1);
+				indices.push_back(i2);
+				indices.push_back(i3);
+			};
+
+		for (Uint32 z = 0; z < n; z += step)
+		{
+			for (Uint32 x = 0; x < n; x += step)
+			{
+				Uint32 const i1 = GetVertex(x, z);
+				Uint32 const i2 = GetVertex(x + step, z);
+				Uint32 const i3 = GetVertex(x, z + step);
+				Uint32 const i4 = GetVertex(x + step, z + step);
+				//with both edges of the far corner collapsed, i1 would lie on the i2-i3 diagonal, so split that quad along the other one
+				Bool const flip_diagonal = x + step == n && z + step == n && (stitch_mask & TerrainEdge_PositiveX) && (stitch_mask & TerrainEdge_PositiveZ);
+				if (flip_diagonal)
+				{
+					AddTriangle(i1, i3, i4);
+					AddTriangle(i1, i4, i2);
+				}
+				else
+				{
+					AddTriangle(i1, i3, i2);
+					AddTriangle(i2, i3, i4);
+				}
+			}
+		}
+	}
+
+	TerrainLOD::TerrainLOD(TerrainLODDesc const& _desc, std::span<Float const> heights) : desc(_desc)
+	{
+		ADRIA_ASSERT(desc.chunk_tile_count > 0 && (desc.chunk_tile_count & (desc.chunk_tile_count - 1)) == 0);
+		ADRIA_ASSERT(heights.size() == (Uint64)(desc.chunk_count_x * desc.chunk_tile_count + 1) * (desc.chunk_count_z * desc.chunk_tile_count + 1));
+
+		lod_count = 1;
+		while ((1u << (lod_count - 1)) < desc.chunk_tile_count) ++lod_count;
+
+		index_ranges.resize(lod_count * TerrainStitchMaskCount);
+		for (Uint32 lod = 0; lod < lod_count; ++lod)
+		{
+			for (Uint32 stitch_mask = 0; stitch_mask < TerrainStitchMaskCount; ++stitch_mask)
+			{
+				TerrainIndexRange& range = index_ranges[lod * TerrainStitchMaskCount + stitch_mask];
+				range.offset = (Uint32)indices.size();
+				GenerateTerrainChunkIndices(desc.chunk_tile_count, lod, stitch_mask, indices);
+				range.count = (Uint32)indices.size() - range.offset;
+			}
+		}
+		ComputeChunkErrors(heights);
+		selected_lods.resize(GetChunkCount(), TerrainChunkLOD{ .lod = 0, .stitch_mask = TerrainEdge_None });
+	}
+
+	TerrainIndexRange TerrainLOD::GetIndexRange(Uint32 lod, Uint32 stitch_mask) const
+	{
+		ADRIA_ASSERT(lod < lod_count && stitch_mask < TerrainStitchMaskCount);
+		return index_ranges[lod * TerrainStitchMaskCount + stitch_mask];
+	}
+
+	std::vector<TerrainChunkLOD> const& TerrainLOD::SelectLODs(Vector3 const& camera_position, Float projection_scale, Float max_screen_error)
+	{
+		Uint32 const chunk_count_x = desc.chunk_count_x;
+		Uint32 const chunk_count_z = desc.chunk_count_z;
+		for (Uint32 chunk = 0; chunk < GetChunkCount(); ++chunk)
+		{
+			BoundingBox const& bounding_box = chunk_bounding_boxes[chunk];
+			Vector3 const offset(
+				std::max(std::abs(camera_position.x - bounding_box.Center.x) - bounding_box.Extents.x, 0.0f),
+				std::max(std::abs(camera_position.y - bounding_box.Center.y) - bounding_box.Extents.y, 0.0f),
+				std::max(std::abs(camera_position.z - bounding_box.Center.z) - bounding_box.Extents.z, 0.0f));
+			Float const distance = offset.Length();
+
+			//error * projection_scale / distance <= max_screen_error, without dividing by a zero distance
+			Uint32 lod = 0;
+			while (lod + 1 < lod_count && GetGeometricError(chunk, lod + 1) * projection_scale <= max_screen_error * distance) ++lod;
+			selected_lods[chunk] = TerrainChunkLOD{ .lod = lod, .stitch_mask = TerrainEdge_None };
+		}
+
+		//refining a chunk never breaks its error bound, so lower lods until every neighbor is at most one lod finer
+		auto ForEachNeighbor = [&](Uint32 chunk, auto&& f)
+			{
+				Uint32 const x = chunk % chunk_count_x, z = chunk / chunk_count_x;
+				if (x > 0) f(chunk - 1, TerrainEdge_NegativeX);
+				if (x + 1 < chunk_count_x) f(chunk + 1, TerrainEdge_PositiveX);
+				if (z > 0) f(chunk - chunk_count_x, TerrainEdge_NegativeZ);
+				if (z + 1 < chunk_count_z) f(chunk + chunk_count_x, TerrainEdge_PositiveZ);
+			};
+		Bool changed = true;
+		while (changed)
+		{
+			changed = false;
+			for (Uint32 chunk = 0; chunk < GetChunkCount(); ++chunk)
+			{
+				ForEachNeighbor(chunk, [&](Uint32 neighbor, TerrainEdge)
+					{
+						if (selected_lods[chunk].lod > selected_lods[neighbor].lod + 1)
+						{
+							selected_lods[chunk].lod = selected_lods[neighbor].lod + 1;
+							changed = true;
+						}
+					});
+			}
+		}
+
+		for (Uint32 chunk = 0; chunk < GetChunkCount(); ++chunk)
+		{
+			ForEachNeighbor(chunk, [&](Uint32 neighbor, TerrainEdge edge)
+				{
+					if (selected_lods[neighbor].lod > selected_lods[chunk].lod) selected_lods[chunk].stitch_mask |= edge;
+				});
+		}
+		return selected_lods;
+	}
+
+	Float TerrainLOD::GetProjectionScale(Float fov_y, Float viewport_height)
+	{
+		return viewport_height / (2.0f * std::tan(fov_y * 0.5f));
+	}
+
+	void TerrainLOD::ComputeChunkErrors(std::span<Float const> heights)
+	{
+		Uint32 const n = desc.chunk_tile_count;
+		Uint64 const row_pitch = (Uint64)desc.chunk_count_x * n + 1;
+		chunk_bounding_boxes.resize(GetChunkCount());
+		geometric_errors.resize(GetChunkCount() * lod_count);
+
+		for (Uint32 chunk_z = 0; chunk_z < desc.chunk_count_z; ++chunk_z)
+		{
+			for (Uint32 chunk_x = 0; chunk_x < desc.chunk_count_x; ++chunk_x)
+			{
+				Uint32 const chunk = chunk_z * desc.chunk_count_x + chunk_x;
+				Float const* chunk_heights = heights.data() + (Uint64)chunk_z * n * row_pitch + (Uint64)chunk_x * n;
+				auto HeightAt = [&](Uint32 x, Uint32 z) { return chunk_heights[z * row_pitch + x]; };
+
+				Float min_height = FLT_MAX, max_height = -FLT_MAX;
+				for (Uint32 z = 0; z <= n; ++z)
+				{
+					for (Uint32 x = 0; x <= n; ++x)
+					{
+						min_height = std::min(min_height, HeightAt(x, z));
+						max_height = std::max(max_height, HeightAt(x, z));
+					}
+				}
+				Vector3 const min_corner(desc.origin.x + chunk_x * n * desc.tile_size_x, desc.origin.y + min_height, desc.origin.z + chunk_z * n * desc.tile_size_z);
+				Vector3 const max_corner(min_corner.x + n * desc.tile_size_x, desc.origin.y + max_height, min_corner.z + n * desc.tile_size_z);
+				BoundingBox::CreateFromPoints(chunk_bounding_boxes[chunk], min_corner, max_corner);
+
+				//interpolates the unstitched triangles of the lod, split along the i2-i3 diagonal like GenerateTerrainChunkIndices does
+				Float previous_error = 0.0f;
+				geometric_errors[chunk * lod_count] = 0.0f;
+				for (Uint32 lod = 1; lod < lod_count; ++lod)
+				{
+					Uint32 const step = 1u << lod;
+					Float const inv_step = 1.0f / step;
+					Float error = previous_error;
+					for (Uint32 z = 0; z <= n; ++z)
+					{
+						for (Uint32 x = 0; x <= n; ++x)
+						{
+							Uint32 const cell_x = std::min(x / step * step, n - step);
+							Uint32 const cell_z = std::min(z / step * step, n - step);
+							Float const fx = (x - cell_x) * inv_step;
+							Float const fz = (z - cell_z) * inv_step;
+							Float const h1 = HeightAt(cell_x, cell_z), h2 = HeightAt(cell_x + step, cell_z);
+							Float const h3 = HeightAt(cell_x, cell_z + step), h4 = HeightAt(cell_x + step, cell_z + step);
+							Float const interpolated = fx + fz <= 1.0f ? h1 + fx * (h2 - h1) + fz * (h3 - h1) : h4 + (1.0f - fx) * (h3 - h4) + (1.0f - fz) * (h2 - h4);
+							error = std::max(error, std::abs(HeightAt(x, z) - interpolated));
+						}
+					}
+					geometric_errors[chunk * lod_count + lod] = error;
+					previous_error = error;
+				}
+			}
+		}
+	}
+}
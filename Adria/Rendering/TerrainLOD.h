@@ -0,0 +1,82 @@
+#pragma once
+
+namespace adria
+{
+	//bits of a chunk's stitch mask, a set bit means the neighbor on that side is drawn with the next coarser lod
+	enum TerrainEdge : Uint32
+	{
+		TerrainEdge_None = 0,
+		TerrainEdge_NegativeX = 1 << 0,
+		TerrainEdge_PositiveX = 1 << 1,
+		TerrainEdge_NegativeZ = 1 << 2,
+		TerrainEdge_PositiveZ = 1 << 3,
+		TerrainEdge_All = 0xF
+	};
+	static constexpr Uint32 TerrainStitchMaskCount = 16;
+
+	struct TerrainChunkLOD
+	{
+		Uint32 lod;
+		Uint32 stitch_mask;
+	};
+
+	struct TerrainIndexRange
+	{
+		Uint32 offset;
+		Uint32 count;
+	};
+
+	struct TerrainLODDesc
+	{
+		Uint32 chunk_tile_count;	//tiles along each side of a chunk, power of two
+		Uint32 chunk_count_x;
+		Uint32 chunk_count_z;
+		Float tile_size_x;
+		Float tile_size_z;
+		Vector3 origin;				//position of the first vertex of the grid
+	};
+
+	//triangle list of one chunk at the given lod. indices address the (chunk_tile_count + 1)^2 vertices of the chunk, row major with x fastest.
+	//vertices of a stitched edge that the coarser neighbor doesn't have are collapsed onto the previous vertex, so both chunks share the same edge segments
+	void GenerateTerrainChunkIndices(Uint32 chunk_tile_count, Uint32 lod, Uint32 stitch_mask, std::vector<Uint32>& indices);
+
+	//geomipmapping over a grid of square chunks. lod n skips every 2^n - 1 vertices, the index lists of every lod and stitch mask
+	//are packed in one buffer shared by all the chunks. doesn't touch the device
+	class TerrainLOD
+	{
+	public:
+		//heights of the (chunk_count_x * chunk_tile_count + 1) x (chunk_count_z * chunk_tile_count + 1) vertices of the grid, row major
+		TerrainLOD(TerrainLODDesc const& desc, std::span<Float const> heights);
+
+		Uint32 GetLODCount() const { return lod_count; }
+		Uint32 GetChunkCount() const { return desc.chunk_count_x * desc.chunk_count_z; }
+		Uint32 GetChunkVertexCount() const { return (desc.chunk_tile_count + 1) * (desc.chunk_tile_count + 1); }
+		TerrainLODDesc const& GetDesc() const { return desc; }
+
+		std::vector<Uint32> const& GetIndices() const { return indices; }
+		TerrainIndexRange GetIndexRange(Uint32 lod, Uint32 stitch_mask) const;
+		BoundingBox const& GetChunkBoundingBox(Uint32 chunk) const { return chunk_bounding_boxes[chunk]; }
+		//largest height difference between the full resolution chunk and the chunk drawn with the given lod
+		Float GetGeometricError(Uint32 chunk, Uint32 lod) const { return geometric_errors[chunk * lod_count + lod]; }
+
+		//picks the coarsest lod of every chunk whose geometric error projects to at most max_screen_error pixels, then refines chunks
+		//until neighbors differ by at most one lod, which the stitched index lists can close without cracks
+		std::vector<TerrainChunkLOD> const& SelectLODs(Vector3 const& camera_position, Float projection_scale, Float max_screen_error);
+		std::vector<TerrainChunkLOD> const& GetSelectedLODs() const { return selected_lods; }
+
+		//pixels covered by one world unit at distance one
+		static Float GetProjectionScale(Float fov_y, Float viewport_height);
+
+	private:
+		TerrainLODDesc desc;
+		Uint32 lod_count = 0;
+		std::vector<Uint32> indices;
+		std::vector<TerrainIndexRange> index_ranges;
+		std::vector<BoundingBox> chunk_bounding_boxes;
+		std::vector<Float> geometric_errors;
+		std::vector<TerrainChunkLOD> selected_lods;
+
+	private:
+		void ComputeChunkErrors(std::span<Float const> heights);
+	};
+}
@@ -25,7 +25,7 @@ namespace adria
 		ToneMapOperator_ACES
 	};
 
-	static TAutoConsoleVariable<Int>   TonemapOperator("r.Tonemap.Operator", ToneMapOperator_TonyMcMapface, "0 - None, 1 - Reinhard, 2 - Hable, 3 - Linear, 4 - TonyMcMapface, 5 - AgX");
+	static TAutoConsoleVariable<Int>   TonemapOperator("r.Tonemap.Operator", ToneMapOperator_TonyMcMapface, "0 - None, 1 - Reinhard, 2 - Hable, 3 - Linear, 4 - TonyMcMapface, 5 - AgX, 6 - ACES", ConsoleVariableMetadata{ .enum_names = { "None", "Reinhard", "Hable", "Linear", "TonyMcMapface", "AgX", "ACES" } });
 	static TAutoConsoleVariable<Float> TonemapExposure("r.Tonemap.Exposure", 1.0f, "Tonemap exposure applied in addition to exposure from AutoExposure pass");
 	
 	ToneMapPass::ToneMapPass(GfxDevice* gfx, Uint32 w, Uint32 h) : gfx(gfx), width(w), height(h)
@@ -156,9 +156,9 @@ namespace adria
 			{
 				if (ImGui::TreeNode("Tone Mapping"))
 				{
-					ImGui::SliderFloat("Exposure", TonemapExposure.GetPtr(), 0.01f, 10.0f);
+					GUI_SliderFloat("Exposure", *TonemapExposure, 0.01f, 10.0f);
 					static Char const* const operators[] = { "None", "Reinhard", "Hable", "Linear", "Tony McMapface", "AgX", "ACES" };
-					ImGui::ListBox("Tone Map Operator", TonemapOperator.GetPtr(), operators, IM_ARRAYSIZE(operators));
+					GUI_ListBox("Tone Map Operator", *TonemapOperator, operators, IM_ARRAYSIZE(operators));
 					ImGui::TreePop();
 					ImGui::Separator();
 				}
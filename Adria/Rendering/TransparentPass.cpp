@@ -2,6 +2,7 @@
 #include "ShaderStructs.h"
 #include "Components.h"
 #include "BlackboardData.h"
+#include "DepthProjection.h"
 #include "ShaderManager.h"
 #include "RendererDebugViewPass.h"
 #include "Graphics/GfxReflection.h"
@@ -142,13 +143,10 @@ namespace adria
 		{
 		if (ImGui::TreeNode("Transparent Settings"))
 		{
-			if (ImGui::Checkbox("Enable Transparent Pass", EnableTransparent.GetPtr()))
-			{
-				transparent_changed.Broadcast(EnableTransparent.Get());
-			}
+			GUI_Checkbox("Enable Transparent Pass", *EnableTransparent);
 			if (EnableTransparent.Get())
 			{
-				ImGui::Checkbox("Enable Reflections", EnableTransparentReflections.GetPtr());
+				GUI_Checkbox("Enable Reflections", *EnableTransparentReflections);
 			}
 			ImGui::TreePop();
 		}}, GUICommandGroup_Renderer);
@@ -163,7 +161,7 @@ namespace adria
 		transparent_pso_desc.PS = PS_Transparent;
 		transparent_pso_desc.depth_state.depth_enable = true;
 		transparent_pso_desc.depth_state.depth_write_mask = GfxDepthWriteMask::Zero;
-		transparent_pso_desc.depth_state.depth_func = GfxComparisonFunc::GreaterEqual;
+		transparent_pso_desc.depth_state.depth_func = DepthTestFunc;
 		transparent_pso_desc.rasterizer_state.cull_mode = GfxCullMode::None;
 		transparent_pso_desc.num_render_targets = 1u;
 		transparent_pso_desc.rtv_formats[0] = GfxFormat::R16G16B16A16_FLOAT;
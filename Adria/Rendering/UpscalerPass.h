@@ -1,5 +1,6 @@
 #pragma once
 #include "PostEffect.h"
+#include "Math/JitterSequence.h"
 #include "Utilities/Delegate.h"
 
 namespace adria
@@ -10,6 +11,12 @@ namespace adria
 	public:
 		RenderResolutionChanged& GetRenderResolutionChangedEvent() { return render_resolution_changed_event; }
 
+		//the dlss and xess guides ask for a halton sequence of at least 8 * (display / render)^2 phases, fsr uses the count of its sdk
+		virtual JitterSequenceDesc GetJitterSequenceDesc(Uint32 render_width, Uint32 display_width) const
+		{
+			return JitterSequenceDesc{ .type = JitterSequenceType::Halton, .phase_count = GetUpscalerJitterPhaseCount(render_width, display_width) };
+		}
+
 	private:
 		RenderResolutionChanged render_resolution_changed_event;
 
@@ -11,7 +11,7 @@ namespace adria
 {
 	ADRIA_LOG_CHANNEL(PostProcessor);
 
-	static TAutoConsoleVariable<Int>  Upscaler("r.Upscaler", 0, "0 - No Upscaler, 1 - FSR2, 2 - FSR3, 3 - XeSS2, 4 - DLSS3, 5 - DirectML");
+	static TAutoConsoleVariable<Int>  Upscaler("r.Upscaler", 0, "0 - No Upscaler, 1 - FSR2, 2 - FSR3, 3 - XeSS2, 4 - DLSS3, 5 - DirectML", ConsoleVariableMetadata{ .enum_names = { "None", "FSR2", "FSR3", "XeSS2", "DLSS3", "DirectML" } });
 	
 	enum class UpscalerType : Uint8
 	{
@@ -75,6 +75,11 @@ namespace adria
 		return true;
 	}
 
+	JitterSequenceDesc UpscalerPassGroup::GetJitterSequenceDesc(Uint32 render_width) const
+	{
+		return post_effects[(Uint32)upscaler_type]->GetJitterSequenceDesc(render_width, display_width);
+	}
+
 	void UpscalerPassGroup::GroupGUI()
 	{
 		QueueGUI([&]()
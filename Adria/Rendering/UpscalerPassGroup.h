@@ -21,6 +21,7 @@ namespace adria
 			upscaler_disabled_event.Add(delegate);
 		}
 		Bool NeedsJitter() const;
+		JitterSequenceDesc GetJitterSequenceDesc(Uint32 render_width) const;
 
 	private:
 		UpscalerType upscaler_type;
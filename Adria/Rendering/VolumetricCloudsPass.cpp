@@ -109,10 +109,10 @@ namespace adria
 			{
 				if (ImGui::TreeNodeEx("Volumetric Clouds", 0))
 				{
-					ImGui::Checkbox("Enable Volumetric Clouds", Clouds.GetPtr());
+					GUI_Checkbox("Enable Volumetric Clouds", *Clouds);
 					if (Clouds.Get())
 					{
-						ImGui::Checkbox("Temporal Reprojection", TemporalReprojection.GetPtr());
+						GUI_Checkbox("Temporal Reprojection", *TemporalReprojection);
 						should_generate_textures |= ImGui::SliderInt("Shape Noise Frequency", &params.shape_noise_frequency, 1, 10);
 						should_generate_textures |= ImGui::SliderInt("Shape Noise Resolution", &params.shape_noise_resolution, 32, 256);
 						should_generate_textures |= ImGui::SliderInt("Detail Noise Frequency", &params.detail_noise_frequency, 1, 10);
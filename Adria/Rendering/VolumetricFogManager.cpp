@@ -13,7 +13,7 @@ namespace adria
 		FogVolume
 	};
 
-	static TAutoConsoleVariable<Int>  VolumetricFogPath("r.VolumetricPath", 1, "0 - None, 1 - 2D Raymarching, 2 - Fog Volume");
+	static TAutoConsoleVariable<Int>  VolumetricFogPath("r.VolumetricPath", 1, "0 - None, 1 - 2D Raymarching, 2 - Fog Volume", ConsoleVariableMetadata{ .enum_names = { "None", "Raymarching", "FogVolume" } });
 
 	VolumetricFogManager::VolumetricFogManager(GfxDevice* gfx, entt::registry& reg, Uint32 w, Uint32 h) : reg(reg), ray_marched_volumetric_fog_pass(gfx, w, h), fog_volumes_pass(gfx, reg, w, h)
 	{
@@ -47,10 +47,7 @@ namespace adria
 		{
 		if (ImGui::TreeNode("Volumetric Settings"))
 		{
-			if (ImGui::Combo("Volumetric Fog Type", VolumetricFogPath.GetPtr(), "None\0 Raymarching\0Fog Volume\0", 3))
-			{
-				volumetric_fog_type = static_cast<VolumetricFogType>(VolumetricFogPath.Get());
-			}
+			GUI_Combo("Volumetric Fog Type", *VolumetricFogPath, "None\0 Raymarching\0Fog Volume\0", 3);
 			switch (volumetric_fog_type)
 			{
 			case VolumetricFogType::Raymarching: ray_marched_volumetric_fog_pass.GUI(); break;
@@ -53,6 +53,7 @@ struct FrameCBuffer
 	int    sheenEIdx;
 	int    triangleOverdrawIdx;
 	float  rainTotalTime;
+	float2 depthLinearization;
 };
 ConstantBuffer<FrameCBuffer> FrameCB  : register(b0);
 
@@ -109,14 +110,15 @@ static float3 ViewToWindow(float3 view)
 	return proj.xyz;
 }
 
+//reverse-z depth with a finite or infinite far plane, see DepthProjection.h
 static float DelinearizeDepth(float linearZ)
 {
-    return (linearZ * FrameCB.cameraFar - FrameCB.cameraNear * FrameCB.cameraFar) / (linearZ * (FrameCB.cameraFar - FrameCB.cameraNear));
+    return (rcp(linearZ) - FrameCB.depthLinearization.y) / FrameCB.depthLinearization.x;
 }
 
 static float LinearizeDepth(float z)
 {
-    return FrameCB.cameraNear * FrameCB.cameraFar / (FrameCB.cameraFar - z * (FrameCB.cameraFar - FrameCB.cameraNear));
+    return rcp(z * FrameCB.depthLinearization.x + FrameCB.depthLinearization.y);
 }
 
 static uint2 FullScreenPosition(uint2 halfScreenPos)
@@ -60,7 +60,7 @@ void DDGI_ClosestHit(inout DDGIPayload payload, in HitAttributes attribs)
 	StructuredBuffer<DDGIVolume> ddgiVolumeBuffer = ResourceDescriptorHeap[FrameCB.ddgiVolumesIdx];
 	DDGIVolume ddgiVolume = ddgiVolumeBuffer[0];
 
-	Instance instanceData = GetInstanceData(InstanceIndex());
+	Instance instanceData = GetInstanceData(InstanceID() + GeometryIndex());
 	Mesh meshData = GetMeshData(instanceData.meshIndex);
 	Material materialData = GetMaterialData(instanceData.materialIdx);
 	VertexData vertex = LoadVertexData(meshData, PrimitiveIndex(), attribs.barycentrics);
@@ -3,6 +3,12 @@
 
 #include "CommonResources.hlsli"
 
+//set by the shader manager to the ShaderID of the shader being compiled
+#ifndef GPU_ASSERT_SHADER_ID
+#define GPU_ASSERT_SHADER_ID 0
+#endif
+
+//keep in sync with GpuAssertDecoder.h
 enum GpuAssertType
 {
 	GpuAssertType_Invalid,
@@ -14,6 +20,8 @@ struct GpuAssertHeader
 {
     uint Type;
 	uint NumArgs;
+	uint ShaderId;
+	uint Line;
 };  
 
 struct GpuAssertContext
@@ -24,13 +32,15 @@ struct GpuAssertContext
     uint ByteCount;
     uint Type;
     uint ArgCount;
+    uint Line;
 
-    void Init()
+    void Init(uint line)
     {
         for(uint i = 0; i < BufferSize; ++i) InternalBuffer[i] = 0;
         ByteCount = 0;
         Type = GpuAssertType_Invalid;
         ArgCount = 0;
+        Line = line;
     }
 
     uint CurrBufferIndex()
@@ -79,8 +89,7 @@ struct GpuAssertContext
     void Commit()
     {
         if(FrameCB.assertBufferIdx < 0) return;
-        if(ByteCount < 2) return;  
-        ByteCount = ((ByteCount + 3) / 4) * 4;
+        if(Type == GpuAssertType_Invalid) return;
 
         RWByteAddressBuffer assertBuffer = ResourceDescriptorHeap[FrameCB.assertBufferIdx];
         const uint numBytesToWrite = ByteCount + sizeof(GpuAssertHeader);
@@ -91,6 +100,8 @@ struct GpuAssertContext
         GpuAssertHeader header;
         header.Type = Type;
         header.NumArgs = ArgCount;
+        header.ShaderId = GPU_ASSERT_SHADER_ID;
+        header.Line = Line;
 
         assertBuffer.Store<GpuAssertHeader>(offset, header);
         offset += sizeof(GpuAssertHeader);
@@ -105,7 +116,7 @@ do \
     if(!condition) \
     {              \
         GpuAssertContext gpuAssertContext;      \
-        gpuAssertContext.Init();                \
+        gpuAssertContext.Init(__LINE__);        \
         gpuAssertContext.Assert(GpuAssertType_Generic, __VA_ARGS__);    \
         gpuAssertContext.Commit();              \
     }                                           \
@@ -117,7 +128,7 @@ do \
     if(!condition) \
     {              \
         GpuAssertContext gpuAssertContext;      \
-        gpuAssertContext.Init();                \
+        gpuAssertContext.Init(__LINE__);        \
         gpuAssertContext.Assert(type, __VA_ARGS__);    \
         gpuAssertContext.Commit();              \
     }                                           \
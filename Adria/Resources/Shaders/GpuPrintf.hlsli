@@ -108,6 +108,7 @@ template<typename T> uint CharToUint(in T c)
     return 0;
 }
 
+//keep in sync with GpuPrintfArgCode in GpuPrintfDecoder.h
 enum ArgCode
 {
     DebugPrint_Uint = 0,
@@ -80,7 +80,7 @@ void RTR_Miss(inout RTR_Payload payloadData)
 [shader("closesthit")]
 void RTR_ClosestHitPrimaryRay(inout RTR_Payload payloadData, in HitAttributes attribs)
 {
-	Instance instanceData = GetInstanceData(InstanceIndex());
+	Instance instanceData = GetInstanceData(InstanceID() + GeometryIndex());
 	Mesh meshData = GetMeshData(instanceData.meshIndex);
 	Material materialData = GetMaterialData(instanceData.materialIdx);
 
@@ -86,7 +86,7 @@ bool TraceRay(RayDesc ray, out HitInfo hitInfo)
 
     while (q.Proceed())
     {
-		uint instanceIndex = q.CandidateInstanceID();
+		uint instanceIndex = q.CandidateInstanceID() + q.CandidateGeometryIndex();
 		uint triangleId = q.CandidatePrimitiveIndex();
 		Instance instanceData = GetInstanceData(instanceIndex);
 		Mesh meshData = GetMeshData(instanceData.meshIndex);
@@ -114,7 +114,7 @@ bool TraceRay(RayDesc ray, out HitInfo hitInfo)
 
     hitInfo.barycentricCoordinates = q.CommittedTriangleBarycentrics();
     hitInfo.primitiveIndex = q.CommittedPrimitiveIndex();
-    hitInfo.instanceIndex = q.CommittedInstanceIndex();
+    hitInfo.instanceIndex = q.CommittedInstanceID() + q.CommittedGeometryIndex();
     hitInfo.objectToWorldMatrix = q.CommittedObjectToWorld3x4();
     hitInfo.worldToObjectMatrix = q.CommittedWorldToObject3x4();
     hitInfo.hitT = q.CommittedRayT();
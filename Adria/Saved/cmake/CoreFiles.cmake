@@ -0,0 +1,21 @@
+# This file is auto-generated by a Python script. DO NOT EDIT MANUALLY.
+
+set(ADRIA_CORE_SOURCES
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/CommandLineOptions.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/CommandLineOptions.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/ConsoleManager.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/ConsoleManager.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/ConsoleNameIndex.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/ConsoleNameIndex.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/ConsoleTokenizer.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/ConsoleTokenizer.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/Defines.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/Engine.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/Engine.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/FatalAssert.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/FatalAssert.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/IConsoleManager.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/Paths.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/Paths.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Core/Types.h"
+)
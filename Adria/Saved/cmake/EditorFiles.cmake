@@ -0,0 +1,17 @@
+# This file is auto-generated by a Python script. DO NOT EDIT MANUALLY.
+
+set(ADRIA_EDITOR_SOURCES
+    "${CMAKE_CURRENT_SOURCE_DIR}/Editor/Editor.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Editor/Editor.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Editor/EditorConsole.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Editor/EditorConsole.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Editor/EditorEvents.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Editor/EditorHistory.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Editor/EditorHistory.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Editor/EditorSink.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Editor/EditorSink.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Editor/GUICommand.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Editor/GUICommand.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Editor/ImGuiManager.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Editor/ImGuiManager.h"
+)
@@ -16,6 +16,7 @@ set(ADRIA_GRAPHICS_SOURCES
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxCommon.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxCommon.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxConstantBuffer.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxDefines.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxDescriptor.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxDescriptorAllocator.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxDescriptorAllocator.h"
@@ -30,7 +31,6 @@ set(ADRIA_GRAPHICS_SOURCES
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxInputLayout.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxLinearDynamicAllocator.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxLinearDynamicAllocator.h"
-    "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxMacros.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxNsightAftermathGpuCrashTracker.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxNsightAftermathGpuCrashTracker.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxNsightPerfManager.cpp"
@@ -62,6 +62,8 @@ set(ADRIA_GRAPHICS_SOURCES
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxScopedEvent.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxScopedEvent.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxShader.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxShaderCache.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxShaderCache.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxShaderCompiler.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxShaderCompiler.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxShaderEnums.h"
@@ -77,5 +79,6 @@ set(ADRIA_GRAPHICS_SOURCES
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxTexture.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxTracyProfiler.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxTracyProfiler.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxUploadPage.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Graphics/GfxVertexFormat.h"
 )
@@ -0,0 +1,14 @@
+# This file is auto-generated by a Python script. DO NOT EDIT MANUALLY.
+
+set(ADRIA_LOGGING_SOURCES
+    "${CMAKE_CURRENT_SOURCE_DIR}/Logging/CallbackSink.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Logging/CallbackSink.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Logging/ConsoleSink.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Logging/ConsoleSink.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Logging/FileSink.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Logging/FileSink.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Logging/Log.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Logging/Log.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Logging/Windows/DebuggerSink.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Logging/Windows/DebuggerSink.h"
+)
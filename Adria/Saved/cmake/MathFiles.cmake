@@ -0,0 +1,15 @@
+# This file is auto-generated by a Python script. DO NOT EDIT MANUALLY.
+
+set(ADRIA_MATH_SOURCES
+    "${CMAKE_CURRENT_SOURCE_DIR}/Math/BoundingVolumeUtil.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Math/BoundingVolumeUtil.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Math/Constants.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Math/Halton.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Math/JitterSequence.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Math/JitterSequence.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Math/MathCommon.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Math/MathTypes.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Math/NormalsUtil.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Math/Packing.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Math/Packing.h"
+)
@@ -0,0 +1,13 @@
+# This file is auto-generated by a Python script. DO NOT EDIT MANUALLY.
+
+set(ADRIA_PLATFORM_SOURCES
+    "${CMAKE_CURRENT_SOURCE_DIR}/Platform/Input.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Platform/Linux/FileWatcherBackend.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Platform/Window.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Platform/Windows/FileWatcherBackend.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Platform/Windows/Input.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Platform/Windows/WideStringConversions.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Platform/Windows/Window.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Platform/Windows/Windows.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Platform/Windows/main.cpp"
+)
@@ -0,0 +1,19 @@
+# This file is auto-generated by a Python script. DO NOT EDIT MANUALLY.
+
+set(ADRIA_RENDERGRAPH_SOURCES
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraph.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraph.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraphAllocator.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraphBlackboard.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraphBuilder.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraphBuilder.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraphContext.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraphContext.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraphEvent.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraphEvent.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraphExecution.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraphPass.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraphResourceId.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraphResourceName.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/RenderGraph/RenderGraphResourcePool.h"
+)
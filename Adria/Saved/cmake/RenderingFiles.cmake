@@ -16,6 +16,10 @@ set(ADRIA_RENDERING_SOURCES
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/CRTFilterPass.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/Camera.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/Camera.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/CameraPath.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/CameraPath.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/CameraPathController.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/CameraPathController.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/ClusteredDeferredLightingPass.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/ClusteredDeferredLightingPass.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/Components.cpp"
@@ -34,6 +38,8 @@ set(ADRIA_RENDERING_SOURCES
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/DepthOfFieldPass.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/DepthOfFieldPassGroup.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/DepthOfFieldPassGroup.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/DepthProjection.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/DepthProjection.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/DirectMLPassBase.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/DirectMLPassBase.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/DirectMLUpscalerPass.cpp"
@@ -60,6 +66,8 @@ set(ADRIA_RENDERING_SOURCES
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/FilmEffectsPass.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/FogVolumesPass.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/FogVolumesPass.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/FrameCapture.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/FrameCapture.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/GBufferPass.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/GBufferPass.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/GPUDebugFeature.cpp"
@@ -72,8 +80,12 @@ set(ADRIA_RENDERING_SOURCES
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/GodRaysPass.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/GpuAssert.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/GpuAssert.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/GpuAssertDecoder.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/GpuAssertDecoder.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/GpuPrintf.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/GpuPrintf.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/GpuPrintfDecoder.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/GpuPrintfDecoder.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/HBAOPass.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/HBAOPass.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/HelperPasses.cpp"
@@ -128,6 +140,11 @@ set(ADRIA_RENDERING_SOURCES
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/SVGFDenoiserPass.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/SceneConfig.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/SceneConfig.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/SceneConfigExtract.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/SceneConfigFile.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/SceneConfigFile.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/SceneConfigSchema.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/SceneConfigSchema.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/SceneLoader.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/SceneLoader.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/ShaderManager.cpp"
@@ -143,6 +160,8 @@ set(ADRIA_RENDERING_SOURCES
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/SunPass.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/TAAPass.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/TAAPass.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/TerrainLOD.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/TerrainLOD.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/TextureHandle.h"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/TextureManager.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/Rendering/TextureManager.h"
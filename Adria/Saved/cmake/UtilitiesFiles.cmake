@@ -0,0 +1,44 @@
+# This file is auto-generated by a Python script. DO NOT EDIT MANUALLY.
+
+set(ADRIA_UTILITIES_SOURCES
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Align.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/BufferReader.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/CLIParser.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/CLIParser.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/ConcurrentQueue.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Delegate.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/DynamicLibrary.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/DynamicLibrary.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Enum.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/FileWatcher.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/FileWatcher.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/FloatCompressor.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/HardwareBreakpoint.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Hash.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Heightmap.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Heightmap.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/HosekDataRGB.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Image.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Image.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/ImageWrite.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/ImageWrite.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Json.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/LinearAllocator.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/LinearOffsetAllocator.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/MemoryLeakDetector.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/PathHelpers.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/PathHelpers.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Random.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Ref.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Releasable.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/RingBuffer.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/RingOffsetAllocator.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Singleton.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/StringConversions.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/StringConversions.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/TLSFOffsetAllocator.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/TemplatesUtil.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/ThreadPool.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Timer.h"
+    "${CMAKE_CURRENT_SOURCE_DIR}/Utilities/Tree.h"
+)
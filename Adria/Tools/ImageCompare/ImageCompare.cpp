@@ -0,0 +1,190 @@
+#include "ImageMetrics.h"
+#include "Utilities/Image.h"
+#include "Utilities/ImageWrite.h"
+#include "Utilities/PathHelpers.h"
+
+using namespace adria;
+
+namespace
+{
+	enum ExitCode : Int
+	{
+		ExitCode_Pass = 0,
+		ExitCode_ThresholdExceeded = 1,
+		ExitCode_Error = 2
+	};
+
+	struct Thresholds
+	{
+		std::optional<Float> max_rmse;
+		std::optional<Float> min_psnr;
+		std::optional<Float> min_ssim;
+		std::optional<Float> max_flip;
+	};
+
+	void PrintUsage()
+	{
+		printf(
+			"Usage: ImageCompare <reference> <test> [options]\n"
+			"  --heatmap <file>   write the per pixel flip error as a heatmap (png, jpg, tga, bmp or hdr)\n"
+			"  --ppd <value>      pixels per degree of the observer, default 67\n"
+			"  --max-rmse <value> fail if the rmse is above value\n"
+			"  --min-psnr <value> fail if the psnr in dB is below value\n"
+			"  --min-ssim <value> fail if the mean ssim is below value\n"
+			"  --max-flip <value> fail if the mean flip error is above value\n"
+			"Exit code is 0 if all thresholds pass, 1 if one is exceeded and 2 on errors.\n");
+	}
+
+	Bool ParseFloat(Char const* text, Float& value)
+	{
+		Char* end = nullptr;
+		value = std::strtof(text, &end);
+		return end != text && *end == '\0';
+	}
+
+	std::optional<FileType> GetHeatmapFileType(std::string const& path)
+	{
+		std::string extension = GetExtension(path);
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](Char c) { return (Char)std::tolower(c); });
+		if (extension == ".png") return FileType::PNG;
+		if (extension == ".jpg" || extension == ".jpeg") return FileType::JPG;
+		if (extension == ".tga") return FileType::TGA;
+		if (extension == ".bmp") return FileType::BMP;
+		if (extension == ".hdr") return FileType::HDR;
+		return std::nullopt;
+	}
+
+	Bool LoadImageRGB(std::string const& path, ImageRGB& rgb)
+	{
+		if (!FileExists(path))
+		{
+			fprintf(stderr, "%s does not exist\n", path.c_str());
+			return false;
+		}
+		if (GetExtension(path).empty())
+		{
+			fprintf(stderr, "%s has no extension, the image format cannot be determined\n", path.c_str());
+			return false;
+		}
+		Image image(path);
+		if (image.Width() == 0 || image.Height() == 0)
+		{
+			fprintf(stderr, "Failed to load %s\n", path.c_str());
+			return false;
+		}
+		if (!ConvertToImageRGB(image, rgb))
+		{
+			fprintf(stderr, "%s has a pixel format the comparison does not support (e.g. block compressed)\n", path.c_str());
+			return false;
+		}
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> positional;
+	std::string heatmap_path;
+	Float pixels_per_degree = 67.0f;
+	Thresholds thresholds;
+	for (Int i = 1; i < argc; ++i)
+	{
+		std::string_view const arg = argv[i];
+		if (arg == "-h" || arg == "--help")
+		{
+			PrintUsage();
+			return ExitCode_Pass;
+		}
+		if (!arg.starts_with("--"))
+		{
+			positional.emplace_back(arg);
+			continue;
+		}
+		if (i + 1 >= argc)
+		{
+			fprintf(stderr, "Missing value for %s\n", argv[i]);
+			return ExitCode_Error;
+		}
+
+		Char const* value = argv[++i];
+		if (arg == "--heatmap")
+		{
+			heatmap_path = value;
+			continue;
+		}
+
+		Float number = 0.0f;
+		if (!ParseFloat(value, number))
+		{
+			fprintf(stderr, "Invalid value %s for %s\n", value, argv[i - 1]);
+			return ExitCode_Error;
+		}
+		if (arg == "--ppd" && number > 0.0f) pixels_per_degree = number;
+		else if (arg == "--max-rmse") thresholds.max_rmse = number;
+		else if (arg == "--min-psnr") thresholds.min_psnr = number;
+		else if (arg == "--min-ssim") thresholds.min_ssim = number;
+		else if (arg == "--max-flip") thresholds.max_flip = number;
+		else
+		{
+			fprintf(stderr, "Unknown option %s\n", argv[i - 1]);
+			PrintUsage();
+			return ExitCode_Error;
+		}
+	}
+	if (positional.size() != 2)
+	{
+		PrintUsage();
+		return ExitCode_Error;
+	}
+
+	std::optional<FileType> heatmap_file_type;
+	if (!heatmap_path.empty())
+	{
+		heatmap_file_type = GetHeatmapFileType(heatmap_path);
+		if (!heatmap_file_type)
+		{
+			fprintf(stderr, "Unsupported heatmap file type %s\n", heatmap_path.c_str());
+			return ExitCode_Error;
+		}
+	}
+
+	ImageRGB reference, test;
+	if (!LoadImageRGB(positional[0], reference) || !LoadImageRGB(positional[1], test)) return ExitCode_Error;
+
+	ImageCompareResult result{};
+	if (!CompareImages(reference, test, result, pixels_per_degree))
+	{
+		fprintf(stderr, "Image sizes differ: %ux%u and %ux%u\n", reference.width, reference.height, test.width, test.height);
+		return ExitCode_Error;
+	}
+
+	ImageMetrics const& metrics = result.metrics;
+	printf("rmse: %.6f\n", metrics.rmse);
+	printf("psnr: %.3f dB\n", metrics.psnr);
+	printf("ssim: %.6f\n", metrics.ssim);
+	printf("flip: %.6f (max %.6f)\n", metrics.flip_mean, metrics.flip_max);
+
+	if (heatmap_file_type)
+	{
+		std::vector<Uint8> heatmap;
+		CreateErrorHeatmap(result.flip_error, heatmap);
+		if (!WriteImageToFile(*heatmap_file_type, heatmap_path, reference.width, reference.height, heatmap.data(), reference.width * 4))
+		{
+			fprintf(stderr, "Failed to write %s\n", heatmap_path.c_str());
+			return ExitCode_Error;
+		}
+	}
+
+	Bool passed = true;
+	auto Check = [&](Bool ok, Char const* name, Float value, Char const* comparison, std::optional<Float> threshold)
+		{
+			if (ok) return;
+			printf("FAILED: %s %.6f %s %.6f\n", name, value, comparison, *threshold);
+			passed = false;
+		};
+	if (thresholds.max_rmse) Check(metrics.rmse <= *thresholds.max_rmse, "rmse", metrics.rmse, ">", thresholds.max_rmse);
+	if (thresholds.min_psnr) Check(metrics.psnr >= *thresholds.min_psnr, "psnr", metrics.psnr, "<", thresholds.min_psnr);
+	if (thresholds.min_ssim) Check(metrics.ssim >= *thresholds.min_ssim, "ssim", metrics.ssim, "<", thresholds.min_ssim);
+	if (thresholds.max_flip) Check(metrics.flip_mean <= *thresholds.max_flip, "flip", metrics.flip_mean, ">", thresholds.max_flip);
+	return passed ? ExitCode_Pass : ExitCode_ThresholdExceeded;
+}
@@ -0,0 +1,441 @@
+#include "ImageMetrics.h"
+#include "Utilities/Image.h"
+#include "Utilities/FloatCompressor.h"
+
+namespace adria
+{
+	namespace
+	{
+		using Plane = std::vector<Float>;
+
+		constexpr Float PI = 3.14159265358979f;
+
+		//convolves with kernel_x along rows and kernel_y along columns, both of odd size, clamping at the borders
+		void ConvolveSeparable(Plane const& src, Uint32 width, Uint32 height, std::span<Float const> kernel_x, std::span<Float const> kernel_y, Plane& dst)
+		{
+			Int const radius_x = (Int)kernel_x.size() / 2;
+			Int const radius_y = (Int)kernel_y.size() / 2;
+			Plane tmp(src.size());
+			for (Uint32 y = 0; y < height; ++y)
+			{
+				Float const* src_row = src.data() + (Uint64)y * width;
+				for (Uint32 x = 0; x < width; ++x)
+				{
+					Float sum = 0.0f;
+					for (Int k = -radius_x; k <= radius_x; ++k)
+					{
+						Int const sx = std::clamp((Int)x + k, 0, (Int)width - 1);
+						sum += kernel_x[k + radius_x] * src_row[sx];
+					}
+					tmp[(Uint64)y * width + x] = sum;
+				}
+			}
+			dst.resize(src.size());
+			for (Uint32 y = 0; y < height; ++y)
+			{
+				for (Uint32 x = 0; x < width; ++x)
+				{
+					Float sum = 0.0f;
+					for (Int k = -radius_y; k <= radius_y; ++k)
+					{
+						Int const sy = std::clamp((Int)y + k, 0, (Int)height - 1);
+						sum += kernel_y[k + radius_y] * tmp[(Uint64)sy * width + x];
+					}
+					dst[(Uint64)y * width + x] = sum;
+				}
+			}
+		}
+
+		std::vector<Float> GaussianKernel(Float sigma, Int radius)
+		{
+			std::vector<Float> kernel(2 * radius + 1);
+			Float sum = 0.0f;
+			for (Int x = -radius; x <= radius; ++x)
+			{
+				kernel[x + radius] = std::exp(-(Float)(x * x) / (2.0f * sigma * sigma));
+				sum += kernel[x + radius];
+			}
+			for (Float& weight : kernel) weight /= sum;
+			return kernel;
+		}
+
+		Float Luminance(Float const* rgb)
+		{
+			return 0.2126f * rgb[0] + 0.7152f * rgb[1] + 0.0722f * rgb[2];
+		}
+
+		Float SRGBToLinear(Float value)
+		{
+			return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+		}
+
+		struct Float3
+		{
+			Float x, y, z;
+		};
+
+		//D65, the xyz of linear rgb (1, 1, 1)
+		constexpr Float3 ReferenceWhite = { 0.950428545f, 1.0f, 1.088900371f };
+
+		Float3 LinearRGBToXYZ(Float3 c)
+		{
+			return {
+				0.4124564f * c.x + 0.3575761f * c.y + 0.1804375f * c.z,
+				0.2126729f * c.x + 0.7151522f * c.y + 0.0721750f * c.z,
+				0.0193339f * c.x + 0.1191920f * c.y + 0.9503041f * c.z };
+		}
+		Float3 XYZToLinearRGB(Float3 c)
+		{
+			return {
+				 3.2404542f * c.x - 1.5371385f * c.y - 0.4985314f * c.z,
+				-0.9692660f * c.x + 1.8760108f * c.y + 0.0415560f * c.z,
+				 0.0556434f * c.x - 0.2040259f * c.y + 1.0572252f * c.z };
+		}
+		Float3 XYZToYCxCz(Float3 c)
+		{
+			Float const y = c.y / ReferenceWhite.y;
+			return { 116.0f * y - 16.0f, 500.0f * (c.x / ReferenceWhite.x - y), 200.0f * (y - c.z / ReferenceWhite.z) };
+		}
+		Float3 YCxCzToXYZ(Float3 c)
+		{
+			Float const y = (c.x + 16.0f) / 116.0f;
+			return { (c.y / 500.0f + y) * ReferenceWhite.x, y * ReferenceWhite.y, (y - c.z / 200.0f) * ReferenceWhite.z };
+		}
+		Float3 XYZToLab(Float3 c)
+		{
+			auto F = [](Float t)
+				{
+					constexpr Float delta = 6.0f / 29.0f;
+					return t > delta * delta * delta ? std::cbrt(t) : t / (3.0f * delta * delta) + 4.0f / 29.0f;
+				};
+			Float const fx = F(c.x / ReferenceWhite.x);
+			Float const fy = F(c.y / ReferenceWhite.y);
+			Float const fz = F(c.z / ReferenceWhite.z);
+			return { 116.0f * fy - 16.0f, 500.0f * (fx - fy), 200.0f * (fy - fz) };
+		}
+		//lab with the chroma scaled by lightness, following the Hunt effect
+		Float3 LinearRGBToHuntLab(Float3 c)
+		{
+			Float3 const lab = XYZToLab(LinearRGBToXYZ(c));
+			return { lab.x, 0.01f * lab.x * lab.y, 0.01f * lab.x * lab.z };
+		}
+		Float HyAB(Float3 a, Float3 b)
+		{
+			Float const da = a.y - b.y;
+			Float const db = a.z - b.z;
+			return std::abs(a.x - b.x) + std::sqrt(da * da + db * db);
+		}
+
+		//contrast sensitivity of one opponent channel as a sum of two gaussians
+		struct CSFParameters
+		{
+			Float a1, b1, a2, b2;
+		};
+		constexpr CSFParameters CSFAchromatic = { 1.0f, 0.0047f, 0.0f, 1e-5f };
+		constexpr CSFParameters CSFRedGreen = { 1.0f, 0.0053f, 0.0f, 1e-5f };
+		constexpr CSFParameters CSFBlueYellow = { 34.1f, 0.04f, 13.5f, 0.025f };
+
+		//every gaussian of the csf is separable, the filter is their weighted sum
+		void ApplyCSF(Plane const& src, Uint32 width, Uint32 height, CSFParameters const& csf, Float pixels_per_degree, Plane& dst)
+		{
+			Int const radius = (Int)std::ceil(3.0f * std::sqrt(0.04f / (2.0f * PI * PI)) * pixels_per_degree);
+			Float const delta = 1.0f / pixels_per_degree;
+
+			Float const a[2] = { csf.a1, csf.a2 };
+			Float const b[2] = { csf.b1, csf.b2 };
+			std::vector<Float> kernels[2];
+			Float masses[2] = {};
+			for (Uint32 i = 0; i < 2; ++i)
+			{
+				kernels[i].resize(2 * radius + 1);
+				Float sum = 0.0f;
+				for (Int x = -radius; x <= radius; ++x)
+				{
+					Float const d = x * delta;
+					kernels[i][x + radius] = std::exp(-PI * PI * d * d / b[i]);
+					sum += kernels[i][x + radius];
+				}
+				for (Float& weight : kernels[i]) weight /= sum;
+				masses[i] = a[i] * std::sqrt(PI / b[i]) * sum * sum;
+			}
+
+			ConvolveSeparable(src, width, height, kernels[0], kernels[0], dst);
+			if (masses[1] > 0.0f)
+			{
+				Plane second;
+				ConvolveSeparable(src, width, height, kernels[1], kernels[1], second);
+				Float const total = masses[0] + masses[1];
+				for (Uint64 i = 0; i < dst.size(); ++i) dst[i] = (masses[0] * dst[i] + masses[1] * second[i]) / total;
+			}
+		}
+
+		//positive weights sum to 1 and negative weights to -1
+		void NormalizeSigned(std::vector<Float>& kernel)
+		{
+			Float positive = 0.0f, negative = 0.0f;
+			for (Float weight : kernel) (weight > 0.0f ? positive : negative) += weight;
+			for (Float& weight : kernel)
+			{
+				if (weight > 0.0f) weight /= positive;
+				else if (weight < 0.0f) weight /= -negative;
+			}
+		}
+
+		void DetectFeatures(Plane const& gray, Uint32 width, Uint32 height, Float pixels_per_degree, Plane& edges, Plane& points)
+		{
+			Float const sigma = 0.5f * 0.082f * pixels_per_degree;
+			Int const radius = (Int)std::ceil(3.0f * sigma);
+			std::vector<Float> const gaussian = GaussianKernel(sigma, radius);
+			std::vector<Float> edge_kernel(gaussian.size()), point_kernel(gaussian.size());
+			for (Int x = -radius; x <= radius; ++x)
+			{
+				edge_kernel[x + radius] = -x * gaussian[x + radius];
+				point_kernel[x + radius] = ((Float)(x * x) / (sigma * sigma) - 1.0f) * gaussian[x + radius];
+			}
+			NormalizeSigned(edge_kernel);
+			NormalizeSigned(point_kernel);
+
+			auto Magnitude = [&](std::vector<Float> const& kernel, Plane& magnitude)
+				{
+					Plane dx, dy;
+					ConvolveSeparable(gray, width, height, kernel, gaussian, dx);
+					ConvolveSeparable(gray, width, height, gaussian, kernel, dy);
+					magnitude.resize(gray.size());
+					for (Uint64 i = 0; i < gray.size(); ++i) magnitude[i] = std::sqrt(dx[i] * dx[i] + dy[i] * dy[i]);
+				};
+			Magnitude(edge_kernel, edges);
+			Magnitude(point_kernel, points);
+		}
+
+		struct FlipImage
+		{
+			Plane hunt_lab[3];
+			Plane edges;
+			Plane points;
+		};
+
+		void PrepareFlipImage(ImageRGB const& image, Float pixels_per_degree, FlipImage& flip_image)
+		{
+			Uint64 const pixel_count = (Uint64)image.width * image.height;
+			Plane ycxcz[3];
+			for (Plane& channel : ycxcz) channel.resize(pixel_count);
+			for (Uint64 i = 0; i < pixel_count; ++i)
+			{
+				Float const* rgb = &image.pixels[i * 3];
+				Float3 linear;
+				if (image.is_hdr) linear = { std::clamp(rgb[0], 0.0f, 1.0f), std::clamp(rgb[1], 0.0f, 1.0f), std::clamp(rgb[2], 0.0f, 1.0f) };
+				else linear = { SRGBToLinear(rgb[0]), SRGBToLinear(rgb[1]), SRGBToLinear(rgb[2]) };
+				Float3 const c = XYZToYCxCz(LinearRGBToXYZ(linear));
+				ycxcz[0][i] = c.x;
+				ycxcz[1][i] = c.y;
+				ycxcz[2][i] = c.z;
+			}
+
+			Plane gray(pixel_count);
+			for (Uint64 i = 0; i < pixel_count; ++i) gray[i] = (ycxcz[0][i] + 16.0f) / 116.0f;
+			DetectFeatures(gray, image.width, image.height, pixels_per_degree, flip_image.edges, flip_image.points);
+
+			Plane filtered[3];
+			ApplyCSF(ycxcz[0], image.width, image.height, CSFAchromatic, pixels_per_degree, filtered[0]);
+			ApplyCSF(ycxcz[1], image.width, image.height, CSFRedGreen, pixels_per_degree, filtered[1]);
+			ApplyCSF(ycxcz[2], image.width, image.height, CSFBlueYellow, pixels_per_degree, filtered[2]);
+
+			for (Plane& channel : flip_image.hunt_lab) channel.resize(pixel_count);
+			for (Uint64 i = 0; i < pixel_count; ++i)
+			{
+				Float3 rgb = XYZToLinearRGB(YCxCzToXYZ({ filtered[0][i], filtered[1][i], filtered[2][i] }));
+				rgb = { std::clamp(rgb.x, 0.0f, 1.0f), std::clamp(rgb.y, 0.0f, 1.0f), std::clamp(rgb.z, 0.0f, 1.0f) };
+				Float3 const lab = LinearRGBToHuntLab(rgb);
+				flip_image.hunt_lab[0][i] = lab.x;
+				flip_image.hunt_lab[1][i] = lab.y;
+				flip_image.hunt_lab[2][i] = lab.z;
+			}
+		}
+
+		void ComputeFlip(ImageRGB const& reference, ImageRGB const& test, Float pixels_per_degree, std::vector<Float>& error)
+		{
+			constexpr Float qc = 0.7f;
+			constexpr Float qf = 0.5f;
+			constexpr Float pc = 0.4f;
+			constexpr Float pt = 0.95f;
+
+			FlipImage flip_reference, flip_test;
+			PrepareFlipImage(reference, pixels_per_degree, flip_reference);
+			PrepareFlipImage(test, pixels_per_degree, flip_test);
+
+			Float const max_color_error = std::pow(HyAB(LinearRGBToHuntLab({ 0.0f, 1.0f, 0.0f }), LinearRGBToHuntLab({ 0.0f, 0.0f, 1.0f })), qc);
+			Float const color_threshold = pc * max_color_error;
+
+			Uint64 const pixel_count = (Uint64)reference.width * reference.height;
+			error.resize(pixel_count);
+			for (Uint64 i = 0; i < pixel_count; ++i)
+			{
+				Float3 const lab_reference = { flip_reference.hunt_lab[0][i], flip_reference.hunt_lab[1][i], flip_reference.hunt_lab[2][i] };
+				Float3 const lab_test = { flip_test.hunt_lab[0][i], flip_test.hunt_lab[1][i], flip_test.hunt_lab[2][i] };
+				Float color_error = std::pow(HyAB(lab_reference, lab_test), qc);
+				//compress large color differences into the top of the range
+				if (color_error < color_threshold) color_error *= pt / color_threshold;
+				else color_error = pt + (color_error - color_threshold) / (max_color_error - color_threshold) * (1.0f - pt);
+
+				Float const edge_difference = std::abs(flip_reference.edges[i] - flip_test.edges[i]);
+				Float const point_difference = std::abs(flip_reference.points[i] - flip_test.points[i]);
+				Float const feature_error = std::pow(std::max(edge_difference, point_difference) / std::sqrt(2.0f), qf);
+
+				error[i] = std::clamp(std::pow(color_error, 1.0f - feature_error), 0.0f, 1.0f);
+			}
+		}
+
+		Float ComputeSSIM(ImageRGB const& reference, ImageRGB const& test, Float peak)
+		{
+			Uint64 const pixel_count = (Uint64)reference.width * reference.height;
+			Plane x(pixel_count), y(pixel_count), xx(pixel_count), yy(pixel_count), xy(pixel_count);
+			Float64 x_sum = 0.0, y_sum = 0.0;
+			for (Uint64 i = 0; i < pixel_count; ++i)
+			{
+				x[i] = Luminance(&reference.pixels[i * 3]);
+				y[i] = Luminance(&test.pixels[i * 3]);
+				x_sum += x[i];
+				y_sum += y[i];
+			}
+			//the second moments are taken around the image means, E[x^2] - E[x]^2 in floats cancels badly next to c2
+			Float const x_mean = (Float)(x_sum / pixel_count);
+			Float const y_mean = (Float)(y_sum / pixel_count);
+			for (Uint64 i = 0; i < pixel_count; ++i)
+			{
+				Float const dx = x[i] - x_mean;
+				Float const dy = y[i] - y_mean;
+				xx[i] = dx * dx;
+				yy[i] = dy * dy;
+				xy[i] = dx * dy;
+			}
+
+			std::vector<Float> const window = GaussianKernel(1.5f, 5);
+			Plane mu_x, mu_y, sigma_xx, sigma_yy, sigma_xy;
+			ConvolveSeparable(x, reference.width, reference.height, window, window, mu_x);
+			ConvolveSeparable(y, reference.width, reference.height, window, window, mu_y);
+			ConvolveSeparable(xx, reference.width, reference.height, window, window, sigma_xx);
+			ConvolveSeparable(yy, reference.width, reference.height, window, window, sigma_yy);
+			ConvolveSeparable(xy, reference.width, reference.height, window, window, sigma_xy);
+
+			Float const c1 = (0.01f * peak) * (0.01f * peak);
+			Float const c2 = (0.03f * peak) * (0.03f * peak);
+			Float64 ssim_sum = 0.0;
+			for (Uint64 i = 0; i < pixel_count; ++i)
+			{
+				Float const mx = mu_x[i], my = mu_y[i];
+				Float const dx = mx - x_mean, dy = my - y_mean;
+				Float const vx = sigma_xx[i] - dx * dx;
+				Float const vy = sigma_yy[i] - dy * dy;
+				Float const cxy = sigma_xy[i] - dx * dy;
+				ssim_sum += ((2.0f * mx * my + c1) * (2.0f * cxy + c2)) / ((mx * mx + my * my + c1) * (vx + vy + c2));
+			}
+			return (Float)(ssim_sum / pixel_count);
+		}
+	}
+
+	Bool ConvertToImageRGB(Image const& image, ImageRGB& rgb)
+	{
+		rgb.width = image.Width();
+		rgb.height = image.Height();
+		Uint64 const pixel_count = (Uint64)rgb.width * rgb.height;
+		rgb.pixels.resize(pixel_count * 3);
+
+		auto Convert = [&]<typename T>(Bool is_hdr, auto&& ToFloat)
+			{
+				rgb.is_hdr = is_hdr;
+				T const* data = image.Data<T>();
+				for (Uint64 i = 0; i < pixel_count; ++i)
+				{
+					for (Uint32 c = 0; c < 3; ++c) rgb.pixels[i * 3 + c] = ToFloat(data[i * 4 + c]);
+				}
+			};
+
+		switch (image.Format())
+		{
+		case GfxFormat::R8G8B8A8_UNORM:
+			Convert.operator()<Uint8>(false, [](Uint8 v) { return v / 255.0f; });
+			return true;
+		case GfxFormat::B8G8R8A8_UNORM:
+			Convert.operator()<Uint8>(false, [](Uint8 v) { return v / 255.0f; });
+			for (Uint64 i = 0; i < pixel_count; ++i) std::swap(rgb.pixels[i * 3], rgb.pixels[i * 3 + 2]);
+			return true;
+		case GfxFormat::R16G16B16A16_UNORM:
+			Convert.operator()<Uint16>(false, [](Uint16 v) { return v / 65535.0f; });
+			return true;
+		case GfxFormat::R16G16B16A16_FLOAT:
+			Convert.operator()<Uint16>(true, [](Uint16 v) { return FloatCompressor::Decompress(v); });
+			return true;
+		case GfxFormat::R32G32B32A32_FLOAT:
+			Convert.operator()<Float>(true, [](Float v) { return v; });
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	Bool CompareImages(ImageRGB const& reference, ImageRGB const& test, ImageCompareResult& result, Float pixels_per_degree)
+	{
+		if (reference.width != test.width || reference.height != test.height || reference.pixels.empty()) return false;
+
+		Float peak = 1.0f;
+		if (reference.is_hdr || test.is_hdr)
+		{
+			Float const max_value = *std::max_element(reference.pixels.begin(), reference.pixels.end());
+			if (max_value > 0.0f) peak = max_value;
+		}
+
+		Float64 squared_error = 0.0;
+		for (Uint64 i = 0; i < reference.pixels.size(); ++i)
+		{
+			Float64 const difference = (Float64)reference.pixels[i] - test.pixels[i];
+			squared_error += difference * difference;
+		}
+		ImageMetrics& metrics = result.metrics;
+		metrics.rmse = (Float)std::sqrt(squared_error / reference.pixels.size());
+		metrics.psnr = metrics.rmse > 0.0f ? 20.0f * std::log10(peak / metrics.rmse) : std::numeric_limits<Float>::infinity();
+		metrics.ssim = ComputeSSIM(reference, test, peak);
+
+		ComputeFlip(reference, test, pixels_per_degree, result.flip_error);
+		Float64 flip_sum = 0.0;
+		metrics.flip_max = 0.0f;
+		for (Float error : result.flip_error)
+		{
+			flip_sum += error;
+			metrics.flip_max = std::max(metrics.flip_max, error);
+		}
+		metrics.flip_mean = (Float)(flip_sum / result.flip_error.size());
+		return true;
+	}
+
+	void CreateErrorHeatmap(std::span<Float const> error, std::vector<Uint8>& rgba8)
+	{
+		//samples of the magma colormap
+		static constexpr Float Colormap[][3] =
+		{
+			{ 0.001f, 0.000f, 0.014f },
+			{ 0.113f, 0.065f, 0.277f },
+			{ 0.316f, 0.071f, 0.485f },
+			{ 0.512f, 0.128f, 0.504f },
+			{ 0.716f, 0.215f, 0.475f },
+			{ 0.904f, 0.315f, 0.409f },
+			{ 0.986f, 0.537f, 0.382f },
+			{ 0.996f, 0.756f, 0.522f },
+			{ 0.987f, 0.991f, 0.750f },
+		};
+		constexpr Uint32 segment_count = (Uint32)std::size(Colormap) - 1;
+
+		rgba8.resize(error.size() * 4);
+		for (Uint64 i = 0; i < error.size(); ++i)
+		{
+			Float const t = std::clamp(error[i], 0.0f, 1.0f) * segment_count;
+			Uint32 const segment = std::min((Uint32)t, segment_count - 1);
+			Float const f = t - segment;
+			for (Uint32 c = 0; c < 3; ++c)
+			{
+				Float const value = Colormap[segment][c] + (Colormap[segment + 1][c] - Colormap[segment][c]) * f;
+				rgba8[i * 4 + c] = (Uint8)(value * 255.0f + 0.5f);
+			}
+			rgba8[i * 4 + 3] = 255;
+		}
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+namespace adria
+{
+	class Image;
+
+	//three floats per pixel, display encoded for ldr sources and linear for hdr ones
+	struct ImageRGB
+	{
+		Uint32 width = 0;
+		Uint32 height = 0;
+		Bool is_hdr = false;
+		std::vector<Float> pixels;
+	};
+	//fails for block compressed and other formats the comparison does not decode
+	Bool ConvertToImageRGB(Image const& image, ImageRGB& rgb);
+
+	struct ImageMetrics
+	{
+		Float rmse = 0.0f;
+		Float psnr = 0.0f;		//in dB, infinite for identical images
+		Float ssim = 1.0f;		//mean ssim of the luminance
+		Float flip_mean = 0.0f;
+		Float flip_max = 0.0f;
+	};
+
+	struct ImageCompareResult
+	{
+		ImageMetrics metrics;
+		std::vector<Float> flip_error;	//per pixel error in [0, 1]
+	};
+
+	//pixels_per_degree is the number of pixels per degree of visual angle of the observer, the default is a 0.7m wide 4K display seen from 0.7m.
+	//flip follows ldr-flip (Andersson et al. 2020), hdr images are clamped to [0, 1] before the flip pass
+	Bool CompareImages(ImageRGB const& reference, ImageRGB const& test, ImageCompareResult& result, Float pixels_per_degree = 67.0f);
+
+	//maps errors in [0, 1] to an 8 bit rgba heatmap
+	void CreateErrorHeatmap(std::span<Float const> error, std::vector<Uint8>& rgba8);
+}
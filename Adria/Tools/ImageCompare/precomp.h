@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <limits>
+
+#include <vector>
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <algorithm>
+#include <filesystem>
+
+#include <dxgiformat.h>
+
+#include "Core/Types.h"
+#include "Core/Defines.h"
@@ -0,0 +1,251 @@
+#include "NullGfxDevice.h"
+#include "Rendering/AccelerationStructure.h"
+#include "Rendering/Components.h"
+#include "Core/ConsoleManager.h"
+
+using namespace adria;
+
+namespace
+{
+	//the positions offset of every submesh encodes the scene instance it belongs to
+	constexpr Uint32 PositionsOffsetPerInstance = 16;
+
+	Uint32 GetSceneInstance(GfxRayTracingGeometry const& geometry)
+	{
+		return geometry.vertex_buffer_offset / PositionsOffsetPerInstance;
+	}
+
+	Mesh MakeMesh(std::vector<Matrix> const& transforms, Uint32 base_instance_id)
+	{
+		Mesh mesh{};
+		mesh.geometry_buffer_handle = ArcGeometryBufferHandle(0);
+		mesh.materials.emplace_back();
+		for (Uint32 i = 0; i < (Uint32)transforms.size(); ++i)
+		{
+			SubMeshGPU submesh{};
+			submesh.positions_offset = (base_instance_id + i) * PositionsOffsetPerInstance;
+			submesh.vertices_count = 3;
+			submesh.indices_count = 3;
+			submesh.material_index = 0;
+			mesh.submeshes.push_back(submesh);
+			mesh.instances.push_back(SubMeshInstance{ .parent = entt::null, .submesh_index = i, .world_transform = transforms[i] });
+		}
+		return mesh;
+	}
+
+	//sets a console variable for the duration of a test
+	class ScopedConsoleVariable
+	{
+	public:
+		ScopedConsoleVariable(Char const* name, Bool value) : cvar(g_ConsoleManager.FindConsoleVariable(name))
+		{
+			Apply(value);
+		}
+		ADRIA_NONCOPYABLE_NONMOVABLE(ScopedConsoleVariable)
+		~ScopedConsoleVariable()
+		{
+			Apply(false);
+		}
+
+	private:
+		IConsoleVariable* cvar;
+
+	private:
+		void Apply(Bool value)
+		{
+			cvar->Set(value);
+			g_ConsoleManager.ApplyPendingChanges();
+		}
+	};
+
+	Uint64 CountLiveBLASes(Bool compacted)
+	{
+		Uint64 count = 0;
+		for (auto const& [blas, record] : test::GetNullGfxDeviceRecord().live_blases) count += record.compacted == compacted;
+		return count;
+	}
+}
+
+ADRIA_TEST(AccelerationStructure, GroupsConsecutiveInstancesWithTheSameTransform)
+{
+	Matrix const a = Matrix::CreateTranslation(1.0f, 0.0f, 0.0f);
+	Matrix const b = Matrix::CreateTranslation(0.0f, 2.0f, 0.0f);
+	std::vector<SubMeshInstance> const instances = MakeMesh({ a, a, b, b, b, a }, 0).instances;
+
+	std::vector<BLASGroup> const merged = GroupSubMeshInstances(instances, true, 64);
+	ASSERT_EQ(merged.size(), 3u);
+	EXPECT_EQ(merged[0].first_instance, 0u);
+	EXPECT_EQ(merged[0].instance_count, 2u);
+	EXPECT_EQ(merged[1].first_instance, 2u);
+	EXPECT_EQ(merged[1].instance_count, 3u);
+	EXPECT_EQ(merged[2].first_instance, 5u);
+	EXPECT_EQ(merged[2].instance_count, 1u);
+
+	//the last instance shares the transform of the first ones but is not next to them
+	std::vector<BLASGroup> const unmerged = GroupSubMeshInstances(instances, false, 64);
+	ASSERT_EQ(unmerged.size(), instances.size());
+	for (Uint32 i = 0; i < (Uint32)unmerged.size(); ++i)
+	{
+		EXPECT_EQ(unmerged[i].first_instance, i);
+		EXPECT_EQ(unmerged[i].instance_count, 1u);
+	}
+
+	std::vector<BLASGroup> const capped = GroupSubMeshInstances(instances, true, 2);
+	ASSERT_EQ(capped.size(), 4u);
+	EXPECT_EQ(capped[1].instance_count, 2u);
+	EXPECT_EQ(capped[2].first_instance, 4u);
+	EXPECT_EQ(capped[2].instance_count, 1u);
+}
+
+ADRIA_TEST(AccelerationStructure, GroupsNeverSpanMeshes)
+{
+	test::ResetNullGfxDeviceRecord();
+	ScopedConsoleVariable merge("r.RayTracing.MergeStaticGeometry", true);
+
+	Matrix const identity = Matrix::Identity;
+	Mesh const first_mesh = MakeMesh({ identity, identity, identity }, 0);
+	Mesh const second_mesh = MakeMesh({ identity, identity }, 3);
+
+	AccelerationStructure acceleration_structure(nullptr);
+	acceleration_structure.AddInstance(first_mesh, 0);
+	acceleration_structure.AddInstance(second_mesh, 3);
+	acceleration_structure.Build();
+
+	AccelerationStructureStats const& stats = acceleration_structure.GetStats();
+	EXPECT_EQ(stats.blas_count, 2u);
+	EXPECT_EQ(stats.instance_count, 2u);
+
+	test::NullGfxDeviceRecord const& record = test::GetNullGfxDeviceRecord();
+	ASSERT_EQ(record.tlas_instances.size(), 2u);
+	EXPECT_EQ(record.tlas_instances[0].instance_id, 0u);
+	EXPECT_EQ(record.tlas_instances[1].instance_id, 3u);
+	EXPECT_EQ(record.live_blases.at(record.tlas_instances[0].blas).geometries.size(), 3u);
+	EXPECT_EQ(record.live_blases.at(record.tlas_instances[1].blas).geometries.size(), 2u);
+}
+
+ADRIA_TEST(AccelerationStructure, InstanceIdPlusGeometryIndexAddressesTheSceneInstance)
+{
+	Matrix const a = Matrix::CreateTranslation(1.0f, 0.0f, 0.0f);
+	Matrix const b = Matrix::CreateTranslation(0.0f, 2.0f, 0.0f);
+	Mesh const first_mesh = MakeMesh({ a, a, b, b, b, a }, 0);
+	Mesh const second_mesh = MakeMesh({ b, b, a }, 6);
+
+	for (Bool merge_static_geometry : { false, true })
+	{
+		test::ResetNullGfxDeviceRecord();
+		ScopedConsoleVariable merge("r.RayTracing.MergeStaticGeometry", merge_static_geometry);
+
+		AccelerationStructure acceleration_structure(nullptr);
+		acceleration_structure.AddInstance(first_mesh, 0);
+		acceleration_structure.AddInstance(second_mesh, 6);
+		acceleration_structure.Build();
+
+		test::NullGfxDeviceRecord const& record = test::GetNullGfxDeviceRecord();
+		EXPECT_EQ(record.tlas_instances.size(), merge_static_geometry ? 5u : 9u);
+
+		//every scene instance is reached by exactly one InstanceID() + GeometryIndex() pair
+		std::vector<Uint32> hit_counts(9, 0);
+		for (test::NullGfxDeviceRecord::TLASInstanceRecord const& instance : record.tlas_instances)
+		{
+			std::vector<GfxRayTracingGeometry> const& geometries = record.live_blases.at(instance.blas).geometries;
+			for (Uint32 geometry_index = 0; geometry_index < (Uint32)geometries.size(); ++geometry_index)
+			{
+				Uint32 const scene_instance = instance.instance_id + geometry_index;
+				EXPECT_EQ(GetSceneInstance(geometries[geometry_index]), scene_instance);
+				if (scene_instance < hit_counts.size()) ++hit_counts[scene_instance];
+			}
+		}
+		for (Uint32 hit_count : hit_counts) EXPECT_EQ(hit_count, 1u);
+	}
+}
+
+ADRIA_TEST(AccelerationStructure, CompactionTotalsAndRetirement)
+{
+	test::ResetNullGfxDeviceRecord();
+	ScopedConsoleVariable compact("r.RayTracing.CompactBLAS", true);
+
+	Matrix const identity = Matrix::Identity;
+	Mesh const mesh = MakeMesh({ identity, identity, identity, identity }, 0);
+	{
+		AccelerationStructure acceleration_structure(nullptr);
+		acceleration_structure.AddInstance(mesh, 0);
+		acceleration_structure.Build();
+
+		AccelerationStructureStats const& stats = acceleration_structure.GetStats();
+		EXPECT_EQ(stats.blas_count, 4u);
+		EXPECT_EQ(stats.blas_size, 4 * test::NullBLASSizePerGeometry);
+		EXPECT_EQ(stats.compacted_blas_size, 0u);
+		EXPECT_FALSE(stats.compacted);
+
+		//the compacted sizes are only read back once the build fence completed
+		acceleration_structure.Update();
+		EXPECT_FALSE(stats.compacted);
+		EXPECT_EQ(CountLiveBLASes(true), 0u);
+
+		test::CompleteNullGfxDeviceWork();
+		acceleration_structure.Update();
+		EXPECT_TRUE(stats.compacted);
+		EXPECT_EQ(stats.blas_size, 4 * test::NullBLASSizePerGeometry);
+		EXPECT_EQ(stats.compacted_blas_size, stats.blas_size / 2);
+		EXPECT_EQ(CountLiveBLASes(true), 4u);
+
+		//the uncompacted structures and their scratch buffers stay alive until the copies complete
+		EXPECT_EQ(CountLiveBLASes(false), 4u);
+		Int64 const live_buffer_count = test::GetNullGfxDeviceRecord().live_buffer_count;
+		acceleration_structure.Update();
+		EXPECT_EQ(CountLiveBLASes(false), 4u);
+
+		test::CompleteNullGfxDeviceWork();
+		acceleration_structure.Update();
+		EXPECT_EQ(CountLiveBLASes(false), 0u);
+		//a result and a scratch buffer per uncompacted BLAS plus the two buffers of the old TLAS
+		EXPECT_EQ(test::GetNullGfxDeviceRecord().live_buffer_count, live_buffer_count - 2 * 4 - 2);
+	}
+	EXPECT_EQ(test::GetNullGfxDeviceRecord().live_buffer_count, 0);
+}
+
+ADRIA_TEST(AccelerationStructure, UncompactedBuildKeepsItsSize)
+{
+	test::ResetNullGfxDeviceRecord();
+
+	Matrix const identity = Matrix::Identity;
+	AccelerationStructure acceleration_structure(nullptr);
+	acceleration_structure.AddInstance(MakeMesh({ identity, identity }, 0), 0);
+	acceleration_structure.Build();
+
+	test::CompleteNullGfxDeviceWork();
+	acceleration_structure.Update();
+	AccelerationStructureStats const& stats = acceleration_structure.GetStats();
+	EXPECT_FALSE(stats.compacted);
+	EXPECT_EQ(stats.blas_size, 2 * test::NullBLASSizePerGeometry);
+	EXPECT_EQ(stats.compacted_blas_size, 0u);
+	EXPECT_EQ(CountLiveBLASes(true), 0u);
+	EXPECT_EQ(CountLiveBLASes(false), 2u);
+}
+
+ADRIA_TEST(AccelerationStructure, ClearRetiresStructuresUntilTheFenceCompletes)
+{
+	test::ResetNullGfxDeviceRecord();
+	ScopedConsoleVariable compact("r.RayTracing.CompactBLAS", true);
+
+	Matrix const identity = Matrix::Identity;
+	AccelerationStructure acceleration_structure(nullptr);
+	acceleration_structure.AddInstance(MakeMesh({ identity, identity, identity }, 0), 0);
+	acceleration_structure.Build();
+
+	//cleared while the compacted sizes are pending, so the postbuild buffers are still in flight too
+	Int64 const live_buffer_count = test::GetNullGfxDeviceRecord().live_buffer_count;
+	acceleration_structure.Clear();
+	EXPECT_EQ(acceleration_structure.GetStats().blas_count, 0u);
+	EXPECT_EQ(CountLiveBLASes(false), 3u);
+	EXPECT_EQ(test::GetNullGfxDeviceRecord().live_buffer_count, live_buffer_count);
+
+	acceleration_structure.Update();
+	EXPECT_EQ(CountLiveBLASes(false), 3u);
+
+	test::CompleteNullGfxDeviceWork();
+	acceleration_structure.Update();
+	EXPECT_EQ(CountLiveBLASes(false), 0u);
+	EXPECT_EQ(CountLiveBLASes(true), 0u);
+	EXPECT_EQ(test::GetNullGfxDeviceRecord().live_buffer_count, 0);
+}
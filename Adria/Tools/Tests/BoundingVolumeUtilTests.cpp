@@ -0,0 +1,136 @@
+#include "Math/BoundingVolumeUtil.h"
+#include "Utilities/ThreadPool.h"
+
+using namespace adria;
+
+namespace
+{
+	//the position sits after other attributes so the strided loads are exercised
+	struct TestVertex
+	{
+		Float uv[2];
+		Vector3 position;
+		Uint32 id;
+	};
+
+	//the three minmax_element passes AABBFromRange and AABBFromPositions used before the single pass reduction
+	template<typename IteratorT, typename GetPosition>
+	BoundingBox ReferenceAABB(IteratorT begin, IteratorT end, GetPosition&& get_position)
+	{
+		auto x_extremes = std::minmax_element(begin, end, [&](auto const& lhs, auto const& rhs) { return get_position(lhs).x < get_position(rhs).x; });
+		auto y_extremes = std::minmax_element(begin, end, [&](auto const& lhs, auto const& rhs) { return get_position(lhs).y < get_position(rhs).y; });
+		auto z_extremes = std::minmax_element(begin, end, [&](auto const& lhs, auto const& rhs) { return get_position(lhs).z < get_position(rhs).z; });
+
+		Vector3 lower_left(get_position(*x_extremes.first).x, get_position(*y_extremes.first).y, get_position(*z_extremes.first).z);
+		Vector3 upper_right(get_position(*x_extremes.second).x, get_position(*y_extremes.second).y, get_position(*z_extremes.second).z);
+		Vector3 center((lower_left.x + upper_right.x) * 0.5f, (lower_left.y + upper_right.y) * 0.5f, (lower_left.z + upper_right.z) * 0.5f);
+		Vector3 extents(upper_right.x - center.x, upper_right.y - center.y, upper_right.z - center.z);
+		return BoundingBox(center, extents);
+	}
+
+	std::vector<TestVertex> MakeVertices(Uint64 count, Uint32 seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<Float> distribution(-1000.0f, 1000.0f);
+		std::vector<TestVertex> vertices(count);
+		for (Uint64 i = 0; i < count; ++i)
+		{
+			vertices[i].position = Vector3(distribution(rng), distribution(rng) * 0.01f, distribution(rng) + 5000.0f);
+			vertices[i].id = (Uint32)i;
+		}
+		return vertices;
+	}
+
+	//bit-exact, the new code must not change any stored bounds
+	void ExpectSameBox(BoundingBox const& a, BoundingBox const& b)
+	{
+		EXPECT_EQ(memcmp(&a.Center, &b.Center, sizeof(a.Center)), 0);
+		EXPECT_EQ(memcmp(&a.Extents, &b.Extents, sizeof(a.Extents)), 0);
+	}
+
+	class ThreadPoolScope
+	{
+	public:
+		ThreadPoolScope() { g_ThreadPool.Initialize(); }
+		~ThreadPoolScope() { g_ThreadPool.Shutdown(); }
+	};
+
+	constexpr Uint64 PointCounts[] = { 1, 2, 3, 4, 5, 17, 1000, 65536, (1 << 17) - 1, (1 << 17) * 2 + 1, (1 << 17) * 5 + 7 };
+}
+
+ADRIA_TEST(BoundingVolumeUtil, MatchesThreePassReference)
+{
+	//large inputs are reduced on the thread pool
+	ThreadPoolScope thread_pool;
+	for (Uint64 count : PointCounts)
+	{
+		std::vector<TestVertex> const vertices = MakeVertices(count, (Uint32)count);
+		BoundingBox const reference = ReferenceAABB(vertices.begin(), vertices.end(), [](TestVertex const& v) { return v.position; });
+		ExpectSameBox(AABBFromVertices(vertices), reference);
+		ExpectSameBox(AABBFromRange(vertices.begin(), vertices.end()), reference);
+
+		std::vector<Vector3> positions(count);
+		for (Uint64 i = 0; i < count; ++i) positions[i] = vertices[i].position;
+		ExpectSameBox(AABBFromPositions(positions), ReferenceAABB(positions.begin(), positions.end(), [](Vector3 const& p) { return p; }));
+	}
+}
+
+ADRIA_TEST(BoundingVolumeUtil, NonContiguousRanges)
+{
+	std::vector<TestVertex> const vertices = MakeVertices(999, 3);
+	std::list<TestVertex> const vertex_list(vertices.begin(), vertices.end());
+	BoundingBox const reference = ReferenceAABB(vertices.begin(), vertices.end(), [](TestVertex const& v) { return v.position; });
+	ExpectSameBox(AABBFromRange(vertex_list.begin(), vertex_list.end()), reference);
+
+	//a sub range only covers its own points
+	std::vector<TestVertex> const tail(vertices.begin() + 500, vertices.end());
+	ExpectSameBox(AABBFromRange(vertices.begin() + 500, vertices.end()), ReferenceAABB(tail.begin(), tail.end(), [](TestVertex const& v) { return v.position; }));
+}
+
+ADRIA_TEST(BoundingVolumeUtil, EmptyAndDegenerateInputs)
+{
+	BoundingBox const empty = AABBFromPositions({});
+	EXPECT_EQ(empty.Center.x, 0.0f);
+	EXPECT_EQ(empty.Extents.x, 0.0f);
+	EXPECT_EQ(SphereFromPositions({}).Radius, 0.0f);
+
+	std::vector<Vector3> const single = { Vector3(1.0f, -2.0f, 3.0f) };
+	BoundingBox const point_box = AABBFromPositions(single);
+	EXPECT_EQ(point_box.Center.y, -2.0f);
+	EXPECT_EQ(point_box.Extents.y, 0.0f);
+
+	//negative zero and infinities keep the old results too
+	std::vector<Vector3> const special = { Vector3(-0.0f, 1.0f, -1e30f), Vector3(0.0f, -std::numeric_limits<Float>::infinity(), 1e30f), Vector3(2.0f, 3.0f, 0.0f) };
+	ExpectSameBox(AABBFromPositions(special), ReferenceAABB(special.begin(), special.end(), [](Vector3 const& p) { return p; }));
+}
+
+ADRIA_TEST(BoundingVolumeUtil, SphereContainsEveryPoint)
+{
+	for (Uint64 count : { 1ull, 2ull, 10ull, 10000ull })
+	{
+		std::vector<TestVertex> const vertices = MakeVertices(count, 11 + (Uint32)count);
+		BoundingSphere const sphere = SphereFromVertices(vertices);
+		for (TestVertex const& vertex : vertices)
+		{
+			Float const distance = Vector3::Distance(Vector3(sphere.Center), vertex.position);
+			EXPECT_LE(distance, sphere.Radius * (1.0f + 1e-5f) + 1e-4f);
+		}
+		//ritter spheres are within about 20% of the optimal one, which is never larger than the sphere around the box
+		BoundingBox const box = AABBFromVertices(vertices);
+		EXPECT_LE(sphere.Radius, Vector3(box.Extents).Length() * 1.2f + 1e-4f);
+	}
+}
+
+ADRIA_BENCHMARK(BoundingVolumeUtil, FiveMillionPoints)
+{
+	ThreadPoolScope thread_pool;
+	std::vector<TestVertex> const vertices = MakeVertices(5'000'000, 1);
+
+	BoundingBox box;
+	Float64 const reference_ms = test::MeasureMilliseconds([&]() { box = ReferenceAABB(vertices.begin(), vertices.end(), [](TestVertex const& v) { return v.position; }); });
+	Float64 const single_pass_ms = test::MeasureMilliseconds([&]() { box = AABBFromVertices(vertices); });
+	Float64 const sphere_ms = test::MeasureMilliseconds([&]() { SphereFromVertices(vertices); });
+	test::ReportBenchmark("three pass minmax_element", reference_ms);
+	test::ReportBenchmark("AABBFromVertices", single_pass_ms, std::to_string(reference_ms / single_pass_ms) + "x");
+	test::ReportBenchmark("SphereFromVertices", sphere_ms);
+}
@@ -0,0 +1,204 @@
+#include "Rendering/CameraPath.h"
+
+using namespace adria;
+
+namespace
+{
+	CameraKeyframe MakeKeyframe(Float time, Vector3 const& position, Float yaw = 0.0f, Float fov = 60.0f)
+	{
+		return CameraKeyframe{ .time = time, .position = position, .orientation = Quaternion::CreateFromYawPitchRoll(yaw, 0.0f, 0.0f), .fov = fov };
+	}
+
+	void ExpectNear(Vector3 const& a, Vector3 const& b, Float tolerance)
+	{
+		EXPECT_NEAR(a.x, b.x, tolerance);
+		EXPECT_NEAR(a.y, b.y, tolerance);
+		EXPECT_NEAR(a.z, b.z, tolerance);
+	}
+
+	//q and -q are the same rotation
+	void ExpectSameRotation(Quaternion const& a, Quaternion const& b, Float tolerance)
+	{
+		EXPECT_NEAR(std::abs(a.Dot(b)), 1.0f, tolerance);
+	}
+
+	void ExpectSameKeyframes(CameraPath const& a, CameraPath const& b)
+	{
+		ASSERT_EQ(a.GetKeyframes().size(), b.GetKeyframes().size());
+		for (Uint64 i = 0; i < a.GetKeyframes().size(); ++i)
+		{
+			CameraKeyframe const& ka = a.GetKeyframes()[i];
+			CameraKeyframe const& kb = b.GetKeyframes()[i];
+			EXPECT_EQ(ka.time, kb.time);
+			EXPECT_EQ(ka.fov, kb.fov);
+			ExpectNear(ka.position, kb.position, 0.0f);
+			ExpectSameRotation(ka.orientation, kb.orientation, 1e-6f);
+		}
+	}
+}
+
+ADRIA_TEST(CameraPath, KeyframesStaySorted)
+{
+	CameraPath path;
+	EXPECT_TRUE(path.IsEmpty());
+	EXPECT_EQ(path.GetDuration(), 0.0f);
+
+	path.AddKeyframe(MakeKeyframe(2.0f, Vector3(2, 0, 0)));
+	path.AddKeyframe(MakeKeyframe(0.5f, Vector3(0, 0, 0)));
+	path.AddKeyframe(MakeKeyframe(1.0f, Vector3(1, 0, 0)));
+	//a keyframe at an existing time replaces it
+	path.AddKeyframe(MakeKeyframe(1.0f, Vector3(5, 0, 0)));
+
+	ASSERT_EQ(path.GetKeyframes().size(), 3u);
+	EXPECT_EQ(path.GetKeyframes()[0].time, 0.5f);
+	EXPECT_EQ(path.GetKeyframes()[1].time, 1.0f);
+	EXPECT_EQ(path.GetKeyframes()[1].position.x, 5.0f);
+	EXPECT_EQ(path.GetKeyframes()[2].time, 2.0f);
+	EXPECT_EQ(path.GetStartTime(), 0.5f);
+	EXPECT_EQ(path.GetEndTime(), 2.0f);
+	EXPECT_EQ(path.GetDuration(), 1.5f);
+
+	path.Clear();
+	EXPECT_TRUE(path.IsEmpty());
+}
+
+ADRIA_TEST(CameraPath, SampleHitsKeyframesAndClamps)
+{
+	CameraPath path;
+	path.AddKeyframe(MakeKeyframe(0.0f, Vector3(0, 1, 0), 0.0f, 60.0f));
+	path.AddKeyframe(MakeKeyframe(1.0f, Vector3(4, 3, -2), 0.5f, 45.0f));
+	path.AddKeyframe(MakeKeyframe(3.0f, Vector3(-1, 0, 7), 1.0f, 70.0f));
+
+	for (CameraKeyframe const& keyframe : path.GetKeyframes())
+	{
+		CameraKeyframe const sample = path.Sample(keyframe.time);
+		ExpectNear(sample.position, keyframe.position, 1e-5f);
+		EXPECT_NEAR(sample.fov, keyframe.fov, 1e-4f);
+		ExpectSameRotation(sample.orientation, keyframe.orientation, 1e-5f);
+	}
+
+	CameraKeyframe const before = path.Sample(-10.0f);
+	ExpectNear(before.position, Vector3(0, 1, 0), 0.0f);
+	CameraKeyframe const after = path.Sample(10.0f);
+	ExpectNear(after.position, Vector3(-1, 0, 7), 0.0f);
+	EXPECT_EQ(after.fov, 70.0f);
+
+	CameraPath single;
+	single.AddKeyframe(MakeKeyframe(2.0f, Vector3(1, 2, 3)));
+	ExpectNear(single.Sample(0.0f).position, Vector3(1, 2, 3), 0.0f);
+	ExpectNear(single.Sample(5.0f).position, Vector3(1, 2, 3), 0.0f);
+}
+
+ADRIA_TEST(CameraPath, ConstantVelocityIsReproduced)
+{
+	//the Catmull-Rom tangents of keys on a line are the line's slope, so the spline is the line itself even for uneven spacing
+	Vector3 const origin(1, -2, 3);
+	Vector3 const velocity(2, 0.5f, -1);
+	Float const times[] = { 0.0f, 0.3f, 1.0f, 2.5f, 2.75f, 4.0f };
+	CameraPath path;
+	for (Float time : times) path.AddKeyframe(MakeKeyframe(time, origin + velocity * time, 0.0f, 50.0f + 4.0f * time));
+
+	for (Float time = 0.0f; time <= 4.0f; time += 0.05f)
+	{
+		CameraKeyframe const sample = path.Sample(time);
+		ExpectNear(sample.position, origin + velocity * time, 1e-4f);
+		EXPECT_NEAR(sample.fov, 50.0f + 4.0f * time, 1e-3f);
+	}
+}
+
+ADRIA_TEST(CameraPath, VelocityIsContinuousAtKeyframes)
+{
+	CameraPath path;
+	path.AddKeyframe(MakeKeyframe(0.0f, Vector3(0, 0, 0)));
+	path.AddKeyframe(MakeKeyframe(0.5f, Vector3(1, 2, 0)));
+	path.AddKeyframe(MakeKeyframe(3.0f, Vector3(4, 0, 1)));
+	path.AddKeyframe(MakeKeyframe(3.5f, Vector3(6, 1, 1)));
+
+	//one sided differences on both sides of the interior keys agree
+	Float const h = 2e-4f;
+	for (Uint64 i = 1; i + 1 < path.GetKeyframes().size(); ++i)
+	{
+		Float const time = path.GetKeyframes()[i].time;
+		Vector3 const key_position = path.Sample(time).position;
+		Vector3 const left_velocity = (key_position - path.Sample(time - h).position) / h;
+		Vector3 const right_velocity = (path.Sample(time + h).position - key_position) / h;
+		ExpectNear(left_velocity, right_velocity, 0.05f);
+	}
+}
+
+ADRIA_TEST(CameraPath, OrientationTakesTheShortestArc)
+{
+	CameraPath path;
+	path.AddKeyframe(MakeKeyframe(0.0f, Vector3::Zero, 0.0f));
+	path.AddKeyframe(MakeKeyframe(1.0f, Vector3::Zero, pi_div_2<Float>));
+
+	CameraKeyframe const halfway = path.Sample(0.5f);
+	ExpectSameRotation(halfway.orientation, Quaternion::CreateFromYawPitchRoll(pi_div_4<Float>, 0.0f, 0.0f), 1e-5f);
+	EXPECT_NEAR(halfway.orientation.Length(), 1.0f, 1e-5f);
+
+	//the same rotation stored with the opposite sign does not send the camera the long way around
+	CameraKeyframe flipped = path.GetKeyframes()[1];
+	flipped.orientation = -flipped.orientation;
+	path.AddKeyframe(flipped);
+	ExpectSameRotation(path.Sample(0.5f).orientation, halfway.orientation, 1e-5f);
+}
+
+ADRIA_TEST(CameraPath, SerializationRoundTrip)
+{
+	CameraPath path;
+	path.AddKeyframe(MakeKeyframe(0.0f, Vector3(0.1f, 1.0f / 3.0f, -7.25f), 0.3f, 60.0f));
+	path.AddKeyframe(MakeKeyframe(1.7f, Vector3(12.5f, 0.0f, 3.0f), -1.2f, 47.5f));
+	path.AddKeyframe(MakeKeyframe(4.2f, Vector3(-3.0f, 2.0f, 1e-3f), 2.9f, 90.0f));
+
+	CameraPath loaded;
+	ASSERT_TRUE(loaded.Deserialize(path.Serialize()));
+	ExpectSameKeyframes(path, loaded);
+
+	test::TempDirectory temp_directory;
+	std::string const path_file = temp_directory.GetFilePath("path.json");
+	ASSERT_TRUE(path.Save(path_file));
+	CameraPath file_loaded;
+	ASSERT_TRUE(file_loaded.Load(path_file));
+	ExpectSameKeyframes(path, file_loaded);
+
+	//keyframes are sorted and orientations normalized on load
+	ASSERT_TRUE(loaded.Deserialize(R"({"keyframes": [
+		{"time": 2, "position": [1, 0, 0], "orientation": [0, 0, 0, 2], "fov": 30},
+		{"time": 1, "position": [0, 0, 0], "orientation": [0, 0, 0, 1], "fov": 60}]})"));
+	ASSERT_EQ(loaded.GetKeyframes().size(), 2u);
+	EXPECT_EQ(loaded.GetKeyframes()[0].time, 1.0f);
+	EXPECT_NEAR(loaded.GetKeyframes()[1].orientation.w, 1.0f, 1e-6f);
+
+	ASSERT_TRUE(loaded.Deserialize("{}"));
+	EXPECT_TRUE(loaded.IsEmpty());
+}
+
+ADRIA_TEST(CameraPath, InvalidJsonLeavesPathUnchanged)
+{
+	CameraPath path;
+	path.AddKeyframe(MakeKeyframe(0.0f, Vector3(1, 2, 3)));
+
+	Char const* invalid_paths[] =
+	{
+		"not json",
+		"[]",
+		R"({"keyframes": {}})",
+		R"({"keyframes": [1]})",
+		R"({"keyframes": [{"position": [0, 0, 0], "orientation": [0, 0, 0, 1], "fov": 60}]})",
+		R"({"keyframes": [{"time": 0, "position": [0, 0], "orientation": [0, 0, 0, 1], "fov": 60}]})",
+		R"({"keyframes": [{"time": 0, "position": [0, 0, "x"], "orientation": [0, 0, 0, 1], "fov": 60}]})",
+		R"({"keyframes": [{"time": 0, "position": [0, 0, 0], "orientation": [0, 0, 0, 0], "fov": 60}]})",
+		R"({"keyframes": [{"time": 0, "position": [0, 0, 0], "orientation": [0, 0, 0, 1]}]})",
+	};
+	for (Char const* invalid_path : invalid_paths)
+	{
+		EXPECT_FALSE(path.Deserialize(invalid_path));
+		ASSERT_EQ(path.GetKeyframes().size(), 1u);
+		EXPECT_EQ(path.GetKeyframes()[0].position.x, 1.0f);
+	}
+
+	test::TempDirectory temp_directory;
+	test::LogCapture log_capture;
+	EXPECT_FALSE(path.Load(temp_directory.GetFilePath("missing.json")));
+	EXPECT_TRUE(log_capture.Contains("missing.json"));
+}
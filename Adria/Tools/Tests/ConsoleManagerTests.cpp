@@ -0,0 +1,439 @@
+#include "Core/ConsoleManager.h"
+
+using namespace adria;
+
+namespace
+{
+	std::vector<std::string> ReadLines(std::string const& path)
+	{
+		std::vector<std::string> lines;
+		std::ifstream is(path);
+		for (std::string line; std::getline(is, line);)
+		{
+			if (!line.empty()) lines.push_back(line);
+		}
+		return lines;
+	}
+
+	//only the lines of the variables a test registered, the rest of the binary registers its own
+	std::vector<std::string> FilterLines(std::vector<std::string> const& lines, std::string_view prefix)
+	{
+		std::vector<std::string> filtered;
+		for (std::string const& line : lines)
+		{
+			if (line.starts_with(prefix)) filtered.push_back(line);
+		}
+		return filtered;
+	}
+
+	void WriteText(std::string const& path, std::string_view text)
+	{
+		std::ofstream os(path);
+		os << text;
+	}
+
+	//writes are queued once the first frame started, the frame sync point makes them visible
+	template<typename T, typename V>
+	void SetNow(TAutoConsoleVariable<T>& cvar, V value)
+	{
+		cvar->Set(value);
+		g_ConsoleManager.ApplyPendingChanges();
+	}
+}
+
+ADRIA_TEST(ConsoleManager, SaveWritesModifiedVariablesSorted)
+{
+	TAutoConsoleVariable<Int> b("test.save.b", 1, "");
+	TAutoConsoleVariable<Float> a("test.save.a", 0.5f, "");
+	TAutoConsoleVariable<std::string> c("test.save.c", "x", "");
+	TAutoConsoleVariable<Int> mode("test.save.mode", 0, "", ConsoleVariableMetadata{ .enum_names = { "Off", "Low", "High" } });
+	TAutoConsoleVariable<Int> read_only("test.save.read_only", 0, "", ConsoleVariableMetadata{ .flags = ConsoleVariableFlag::ReadOnly });
+
+	SetNow(a, 0.25f);
+	SetNow(c, "hello world");
+	SetNow(mode, 2);
+	SetNow(read_only, 5);
+	EXPECT_EQ(read_only.Get(), 5);
+
+	test::TempDirectory dir;
+	std::string const modified_path = dir.GetFilePath("modified.ini");
+	ASSERT_TRUE(g_ConsoleManager.SaveConsoleVariables(modified_path));
+	std::vector<std::string> const lines = ReadLines(modified_path);
+	EXPECT_TRUE(std::is_sorted(lines.begin(), lines.end()));
+
+	//defaults and read only variables are left out, strings are quoted and enums are saved by name
+	std::vector<std::string> const modified = FilterLines(lines, "test.save.");
+	ASSERT_EQ(modified.size(), 3u);
+	EXPECT_EQ(modified[0], "test.save.a 0.25");
+	EXPECT_EQ(modified[1], "test.save.c \"hello world\"");
+	EXPECT_EQ(modified[2], "test.save.mode High");
+
+	std::string const all_path = dir.GetFilePath("all.ini");
+	ASSERT_TRUE(g_ConsoleManager.SaveConsoleVariables(all_path, false));
+	std::vector<std::string> const all = FilterLines(ReadLines(all_path), "test.save.");
+	ASSERT_EQ(all.size(), 4u);
+	EXPECT_EQ(all[1], "test.save.b 1");
+
+	EXPECT_FALSE(g_ConsoleManager.SaveConsoleVariables(dir.GetFilePath("missing/dir.ini")));
+}
+
+ADRIA_TEST(ConsoleManager, DiffAgainstBaseline)
+{
+	TAutoConsoleVariable<Int> a("test.diff.a", 1, "");
+	TAutoConsoleVariable<Int> b("test.diff.b", 1, "");
+	TAutoConsoleVariable<Bool> c("test.diff.c", false, "");
+	TAutoConsoleVariable<Float> d("test.diff.d", 1.0f, "");
+	SetNow(a, 2);
+	SetNow(c, true);
+
+	test::TempDirectory dir;
+	std::string const ini_path = dir.GetFilePath("baseline.ini");
+	WriteText(ini_path, "test.diff.a 2\ntest.diff.b 3 // comment\ntest.diff.unknown 4\n\nexec other.ini\n");
+
+	test::LogCapture log;
+	std::vector<ConsoleVariableDiff> diffs;
+	ASSERT_TRUE(g_ConsoleManager.DiffConsoleVariables(ini_path, diffs));
+	EXPECT_TRUE(log.Contains("unknown console variable test.diff.unknown"));
+
+	std::erase_if(diffs, [](ConsoleVariableDiff const& diff) { return !diff.name.starts_with("test.diff."); });
+	//a matches the ini and d is at its default, b differs from the ini and c from its default
+	ASSERT_EQ(diffs.size(), 2u);
+	EXPECT_EQ(diffs[0].name, "test.diff.b");
+	EXPECT_EQ(diffs[0].live_value, "1");
+	EXPECT_EQ(diffs[0].baseline_value, "3");
+	EXPECT_TRUE(diffs[0].in_baseline);
+	EXPECT_EQ(diffs[1].name, "test.diff.c");
+	EXPECT_EQ(diffs[1].live_value, "true");
+	EXPECT_EQ(diffs[1].baseline_value, "false");
+	EXPECT_FALSE(diffs[1].in_baseline);
+
+	EXPECT_FALSE(g_ConsoleManager.DiffConsoleVariables(dir.GetFilePath("missing.ini"), diffs));
+}
+
+ADRIA_TEST(ConsoleManager, ResetRestoresDefaults)
+{
+	TAutoConsoleVariable<Int> a("test.reset.a", 3, "");
+	TAutoConsoleVariable<std::string> b("test.reset.b", "default", "");
+	TAutoConsoleVariable<Float> read_only("test.reset.read_only", 1.0f, "", ConsoleVariableMetadata{ .flags = ConsoleVariableFlag::ReadOnly });
+	SetNow(a, 7);
+	SetNow(b, "changed");
+	SetNow(read_only, 2.0f);
+
+	g_ConsoleManager.ResetConsoleVariables();
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(a.Get(), 3);
+	EXPECT_EQ(b.Get(), "default");
+	EXPECT_TRUE(a->IsDefault());
+	//read only variables are owned by code
+	EXPECT_EQ(read_only.Get(), 2.0f);
+
+	SetNow(a, 8);
+	EXPECT_TRUE(g_ConsoleManager.ProcessInput("cvar.reset test.reset.a"));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(a.Get(), 3);
+}
+
+ADRIA_TEST(ConsoleManager, SaveResetExecRoundTrip)
+{
+	TAutoConsoleVariable<Int> quality("test.roundtrip.quality", 0, "", ConsoleVariableMetadata{ .enum_names = { "Low", "Medium", "High" } });
+	TAutoConsoleVariable<Float> scale("test.roundtrip.scale", 1.0f, "");
+	TAutoConsoleVariable<Bool> enabled("test.roundtrip.enabled", false, "");
+	TAutoConsoleVariable<std::string> path("test.roundtrip.path", "", "");
+	SetNow(quality, 1);
+	SetNow(scale, 0.1f);
+	SetNow(enabled, true);
+	SetNow(path, "C:\\some dir\\\"quoted\".ini");
+
+	test::TempDirectory dir;
+	std::string const ini_path = dir.GetFilePath("roundtrip.ini");
+	ASSERT_TRUE(g_ConsoleManager.SaveConsoleVariables(ini_path));
+
+	g_ConsoleManager.ResetConsoleVariables();
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(quality.Get(), 0);
+	EXPECT_EQ(path.Get(), "");
+
+	EXPECT_TRUE(g_ConsoleManager.ProcessIniFile(ini_path));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(quality.Get(), 1);
+	//floats are written with the shortest representation that parses back exactly
+	EXPECT_EQ(scale.Get(), 0.1f);
+	EXPECT_TRUE(enabled.Get());
+	EXPECT_EQ(path.Get(), "C:\\some dir\\\"quoted\".ini");
+
+	std::vector<ConsoleVariableDiff> diffs;
+	ASSERT_TRUE(g_ConsoleManager.DiffConsoleVariables(ini_path, diffs));
+	EXPECT_TRUE(std::none_of(diffs.begin(), diffs.end(), [](ConsoleVariableDiff const& diff) { return diff.name.starts_with("test.roundtrip."); }));
+}
+
+ADRIA_TEST(ConsoleManager, ProcessInputRunsEveryCommand)
+{
+	TAutoConsoleVariable<Int> a("test.input.a", 0, "");
+	TAutoConsoleVariable<std::string> b("test.input.b", "", "");
+	EXPECT_TRUE(g_ConsoleManager.ProcessInput("test.input.a 4; test.input.b \"x; y\" // comment"));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(a.Get(), 4);
+	EXPECT_EQ(b.Get(), "x; y");
+
+	//a failing command doesn't stop the rest of the line
+	EXPECT_FALSE(g_ConsoleManager.ProcessInput("test.input.missing 1; test.input.a 5"));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(a.Get(), 5);
+
+	test::LogCapture log;
+	EXPECT_FALSE(g_ConsoleManager.ProcessInput("test.input.b \"open"));
+	EXPECT_TRUE(log.Contains("unterminated quote"));
+	EXPECT_FALSE(g_ConsoleManager.ProcessInput("# only a comment"));
+}
+
+ADRIA_TEST(ConsoleManager, IniFileReportsBadLines)
+{
+	TAutoConsoleVariable<Int> a("test.ini.a", 0, "");
+	TAutoConsoleVariable<Int> b("test.ini.b", 0, "");
+	TAutoConsoleVariable<Int> c("test.ini.c", 0, "");
+
+	test::TempDirectory dir;
+	std::string const ini_path = dir.GetFilePath("settings.ini");
+	WriteText(ini_path, "# settings\ntest.ini.a 1\ntest.ini.b \"2\n\ntest.ini.unknown 3\ntest.ini.c 3 ; test.ini.a 4 // last wins\n");
+
+	test::LogCapture log;
+	EXPECT_FALSE(g_ConsoleManager.ProcessIniFile(ini_path));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_TRUE(log.Contains("settings.ini:3: unterminated quote"));
+	EXPECT_TRUE(log.Contains("settings.ini:5: could not execute test.ini.unknown"));
+	EXPECT_EQ(a.Get(), 4);
+	EXPECT_EQ(b.Get(), 0);
+	EXPECT_EQ(c.Get(), 3);
+	EXPECT_FALSE(g_ConsoleManager.IsExecutingIniFile());
+
+	EXPECT_FALSE(g_ConsoleManager.ProcessIniFile(dir.GetFilePath("missing.ini")));
+	EXPECT_TRUE(log.Contains("Could not open ini file"));
+}
+
+ADRIA_TEST(ConsoleManager, NestedExecResolvesRelativePaths)
+{
+	TAutoConsoleVariable<Int> outer("test.exec.outer", 0, "");
+	TAutoConsoleVariable<Int> inner("test.exec.inner", 0, "");
+
+	test::TempDirectory dir;
+	std::filesystem::create_directories(dir.GetFilePath("presets"));
+	WriteText(dir.GetFilePath("main.ini"), "exec presets/high.ini\ntest.exec.outer 1\n");
+	WriteText(dir.GetFilePath("presets/high.ini"), "exec \"common settings.ini\"\ntest.exec.inner 2\n");
+	WriteText(dir.GetFilePath("presets/common settings.ini"), "test.exec.inner 1\ntest.exec.outer 5\n");
+
+	EXPECT_TRUE(g_ConsoleManager.ProcessIniFile(dir.GetFilePath("main.ini")));
+	g_ConsoleManager.ApplyPendingChanges();
+	//lines run in file order, so the includes are overridden by what follows them
+	EXPECT_EQ(outer.Get(), 1);
+	EXPECT_EQ(inner.Get(), 2);
+}
+
+ADRIA_TEST(ConsoleManager, ExecCyclesAreSkipped)
+{
+	TAutoConsoleVariable<Int> count("test.cycle.count", 0, "");
+	TAutoConsoleVariable<Int> b("test.cycle.b", 0, "");
+
+	test::TempDirectory dir;
+	WriteText(dir.GetFilePath("a.ini"), "test.cycle.count 1\nexec b.ini\nexec a.ini\n");
+	WriteText(dir.GetFilePath("b.ini"), "exec ./a.ini\ntest.cycle.b 1\n");
+
+	test::LogCapture log;
+	EXPECT_TRUE(g_ConsoleManager.ProcessIniFile(dir.GetFilePath("a.ini")));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_TRUE(log.Contains("it is already being executed"));
+	EXPECT_EQ(b.Get(), 1);
+	EXPECT_FALSE(g_ConsoleManager.IsExecutingIniFile());
+
+	//a file executing itself directly is skipped as well
+	WriteText(dir.GetFilePath("self.ini"), "exec self.ini\ntest.cycle.count 2\n");
+	EXPECT_TRUE(g_ConsoleManager.ProcessIniFile(dir.GetFilePath("self.ini")));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(count.Get(), 2);
+}
+
+ADRIA_TEST(ConsoleManager, ConcurrentWritesAreAppliedAtFrameSync)
+{
+	static constexpr Uint32 FrameCount = 300;
+	static constexpr Uint32 WriterCount = 3;
+	static constexpr Uint32 ReaderCount = 3;
+
+	TAutoConsoleVariable<Int> counter("test.stress.counter", 0, "");
+	TAutoConsoleVariable<Float> mirror("test.stress.mirror", 0.0f, "");
+	TAutoConsoleVariable<std::string> text("test.stress.text", "a", "");
+	static Int ref_value = 0;
+	TAutoConsoleVariableRef<Int> ref("test.stress.ref", ref_value, "");
+	g_ConsoleManager.ApplyPendingChanges();
+
+	//odd while the sync point runs, a read between two equal even values happened inside one frame
+	std::atomic<Uint32> frame_sequence = 0;
+	std::atomic<Bool> done = false;
+	std::atomic<Uint32> torn_strings = 0;
+	std::atomic<Uint32> mid_frame_changes = 0;
+	std::atomic<Uint64> reads = 0;
+
+	std::vector<std::thread> threads;
+	for (Uint32 w = 0; w < WriterCount; ++w)
+	{
+		threads.emplace_back([&, w]()
+			{
+				std::mt19937 rng(w + 1);
+				while (!done.load())
+				{
+					Int const value = (Int)(rng() % 100000);
+					counter->Set(value);
+					mirror->Set((Float)value);
+					ref->Set(value);
+					text->Set(std::string(1 + rng() % 64, (Char)('a' + rng() % 26)).c_str());
+				}
+			});
+	}
+	for (Uint32 r = 0; r < ReaderCount; ++r)
+	{
+		threads.emplace_back([&]()
+			{
+				while (!done.load())
+				{
+					Uint32 const sequence = frame_sequence.load();
+					if (sequence % 2 == 1) continue;
+					Int const first_counter = counter.Get();
+					Int const first_ref = ref.Get();
+					std::string const first_text = text.Get();
+					Bool stable = true;
+					for (Uint32 i = 0; i < 16; ++i)
+					{
+						std::string const current_text = text.Get();
+						if (current_text.find_first_not_of(current_text[0]) != std::string::npos) ++torn_strings;
+						if (counter.Get() != first_counter || ref.Get() != first_ref || current_text != first_text) stable = false;
+					}
+					if (frame_sequence.load() != sequence) continue;
+					if (!stable) ++mid_frame_changes;
+					++reads;
+				}
+			});
+	}
+
+	//registering, unregistering and querying the changed variables race the sync point
+	threads.emplace_back([&]()
+		{
+			for (Uint32 i = 0; !done.load(); ++i)
+			{
+				std::string const name = "test.stress.temp" + std::to_string(i % 4);
+				TAutoConsoleVariable<Int> temp(name.c_str(), 0, "");
+				std::ignore = g_ConsoleManager.GetChangedVariables();
+			}
+		});
+
+	Uint32 changed_frames = 0;
+	for (Uint32 frame = 0; frame < FrameCount; ++frame)
+	{
+		frame_sequence.fetch_add(1);
+		g_ConsoleManager.ApplyPendingChanges();
+		frame_sequence.fetch_add(1);
+		if (!g_ConsoleManager.GetChangedVariables().empty()) ++changed_frames;
+		std::this_thread::sleep_for(std::chrono::microseconds(200));
+	}
+	done.store(true);
+	for (std::thread& thread : threads) thread.join();
+	g_ConsoleManager.ApplyPendingChanges();
+
+	EXPECT_EQ(torn_strings.load(), 0u);
+	EXPECT_EQ(mid_frame_changes.load(), 0u);
+	EXPECT_GT(reads.load(), 0u);
+	EXPECT_GT(changed_frames, 0u);
+	//the referenced global is only written at the sync point
+	EXPECT_EQ(ref.Get(), ref_value);
+}
+
+ADRIA_TEST(ConsoleManager, RangesAreClamped)
+{
+	TAutoConsoleVariable<Float> ratio("test.range.ratio", 0.5f, "", ConsoleVariableMetadata{ .min_value = 0.0f, .max_value = 1.5f });
+	TAutoConsoleVariable<Int> count("test.range.count", 4, "", ConsoleVariableMetadata{ .min_value = 1.0f, .max_value = 8.0f });
+	TAutoConsoleVariable<Int> lower("test.range.lower", 0, "", ConsoleVariableMetadata{ .min_value = 0.0f });
+	EXPECT_EQ(ratio->GetValueHint(), "[0, 1.5]");
+	EXPECT_EQ(lower->GetValueHint(), "[0, inf]");
+
+	test::LogCapture log;
+	EXPECT_TRUE(ratio->Set(2.0f));
+	EXPECT_TRUE(count->Set("-3"));
+	EXPECT_TRUE(lower->Set(1000000));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(ratio.Get(), 1.5f);
+	EXPECT_EQ(count.Get(), 1);
+	EXPECT_EQ(lower.Get(), 1000000);
+	EXPECT_TRUE(log.Contains("test.range.count: -3 is outside of [1, 8], clamped to 1"));
+
+	//values that don't parse are rejected and leave the variable alone
+	EXPECT_FALSE(count->Set("many"));
+	EXPECT_FALSE(g_ConsoleManager.ProcessInput("test.range.ratio abc"));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(count.Get(), 1);
+	EXPECT_EQ(ratio.Get(), 1.5f);
+}
+
+ADRIA_TEST(ConsoleManager, EnumNames)
+{
+	TAutoConsoleVariable<Int> quality("test.enum.quality", 0, "", ConsoleVariableMetadata{ .enum_names = { "Low", "Medium", "High" } });
+	EXPECT_EQ(quality->GetValueHint(), "<Low|Medium|High>");
+	EXPECT_EQ(quality->GetString(), "Low");
+
+	//names are case insensitive and numbers still work
+	EXPECT_TRUE(g_ConsoleManager.ProcessInput("test.enum.quality hIGH"));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(quality.Get(), 2);
+	EXPECT_EQ(quality->GetString(), "High");
+	EXPECT_TRUE(quality->Set("1"));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(quality.Get(), 1);
+	EXPECT_TRUE(quality->Equals("medium"));
+
+	//values outside of the named range are rejected instead of clamped
+	test::LogCapture log;
+	EXPECT_FALSE(quality->Set(3));
+	EXPECT_FALSE(quality->Set(-1));
+	EXPECT_FALSE(g_ConsoleManager.ProcessInput("test.enum.quality Ultra"));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(quality.Get(), 1);
+	EXPECT_TRUE(log.Contains("test.enum.quality: 3 is not a valid value, expected <Low|Medium|High>"));
+}
+
+ADRIA_TEST(ConsoleManager, ReadOnlyAndCheatFlags)
+{
+	TAutoConsoleVariable<Int> read_only("test.flags.read_only", 1, "", ConsoleVariableMetadata{ .flags = ConsoleVariableFlag::ReadOnly });
+	TAutoConsoleVariable<Bool> cheat("test.flags.cheat", false, "", ConsoleVariableMetadata{ .flags = ConsoleVariableFlag::Cheat });
+	TAutoConsoleVariable<Int> restart("test.flags.restart", 0, "", ConsoleVariableMetadata{ .min_value = 0.0f, .max_value = 2.0f, .flags = ConsoleVariableFlag::RequiresRestart });
+	EXPECT_EQ(read_only->GetValueHint(), "read only");
+	EXPECT_EQ(cheat->GetValueHint(), "<true|false> cheat");
+	EXPECT_EQ(restart->GetValueHint(), "[0, 2] requires restart");
+
+	IConsoleVariable* allow_cheats = g_ConsoleManager.FindConsoleVariable("cvar.AllowCheats");
+	ASSERT_TRUE(allow_cheats != nullptr);
+	ASSERT_FALSE(allow_cheats->GetBool());
+
+	test::LogCapture log;
+	//the console can't change read only variables, code still can
+	EXPECT_FALSE(g_ConsoleManager.ProcessInput("test.flags.read_only 2"));
+	EXPECT_TRUE(log.Contains("test.flags.read_only is read only"));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(read_only.Get(), 1);
+	EXPECT_TRUE(read_only->Set(3));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(read_only.Get(), 3);
+
+	EXPECT_FALSE(g_ConsoleManager.ProcessInput("test.flags.cheat true"));
+	EXPECT_TRUE(log.Contains("test.flags.cheat is a cheat"));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_FALSE(cheat.Get());
+
+	EXPECT_TRUE(g_ConsoleManager.ProcessInput("cvar.AllowCheats true"));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_TRUE(g_ConsoleManager.ProcessInput("test.flags.cheat true"));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_TRUE(cheat.Get());
+	allow_cheats->Reset();
+	g_ConsoleManager.ApplyPendingChanges();
+
+	EXPECT_TRUE(g_ConsoleManager.ProcessInput("test.flags.restart 1"));
+	EXPECT_TRUE(log.Contains("test.flags.restart takes effect after a restart"));
+	g_ConsoleManager.ApplyPendingChanges();
+	EXPECT_EQ(restart.Get(), 1);
+}
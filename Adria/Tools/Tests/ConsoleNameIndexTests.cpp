@@ -0,0 +1,193 @@
+#include "Core/ConsoleNameIndex.h"
+
+using namespace adria;
+
+namespace
+{
+	ConsoleNameIndex MakeIndex(std::initializer_list<Char const*> names)
+	{
+		ConsoleNameIndex index;
+		for (Char const* name : names) index.Insert(name);
+		return index;
+	}
+
+	std::vector<std::string> SearchNames(ConsoleNameIndex const& index, std::string_view query, Uint32 max_results = 0)
+	{
+		std::vector<ConsoleNameMatch> matches;
+		index.Search(query, matches, max_results);
+		std::vector<std::string> names;
+		for (ConsoleNameMatch const& match : matches) names.push_back(match.name);
+		return names;
+	}
+
+	//names shaped like the engine's, "r.<system>.<setting>" with a few systems holding most of the variables
+	std::vector<std::string> MakeNames(Uint32 count)
+	{
+		static Char const* const prefixes[] = { "r.", "cvar.", "g.", "editor.", "vr." };
+		static Char const* const systems[] = { "SSAO", "HBAO", "Shadows", "VolumetricFog", "Bloom", "TAA", "Upscaler", "Reflections", "DDGI", "PathTracing" };
+		static Char const* const settings[] = { "Radius", "Power", "Enable", "SampleCount", "Resolution", "Intensity", "Debug", "Quality" };
+		std::mt19937 rng(3);
+		std::vector<std::string> names;
+		names.reserve(count);
+		for (Uint32 i = 0; i < count; ++i)
+		{
+			names.push_back(std::string(prefixes[rng() % 5]) + systems[rng() % 10] + "." + settings[rng() % 8] + std::to_string(i));
+		}
+		return names;
+	}
+}
+
+ADRIA_TEST(ConsoleNameIndex, PrefixIsCaseInsensitiveAndSorted)
+{
+	ConsoleNameIndex const index = MakeIndex({ "r.SSAO.Radius", "r.Bloom", "r.ssao.Power", "cvar.save", "r.SSR", "r.SSAO" });
+	EXPECT_EQ(index.Size(), 6u);
+
+	std::vector<std::string> names;
+	index.FindPrefix("R.ssao", names);
+	EXPECT_EQ(names, (std::vector<std::string>{ "r.SSAO", "r.ssao.Power", "r.SSAO.Radius" }));
+
+	index.FindPrefix("r.", names, 2);
+	EXPECT_EQ(names, (std::vector<std::string>{ "r.Bloom", "r.SSAO" }));
+
+	index.FindPrefix("", names);
+	EXPECT_EQ(names.size(), 6u);
+	index.FindPrefix("x", names);
+	EXPECT_TRUE(names.empty());
+	index.FindPrefix("r.SSAO.Radius.More", names);
+	EXPECT_TRUE(names.empty());
+}
+
+ADRIA_TEST(ConsoleNameIndex, InsertAndErase)
+{
+	ConsoleNameIndex index = MakeIndex({ "r.Fog", "r.fog" });
+	//names that only differ in case are separate entries, duplicates are ignored
+	index.Insert("r.Fog");
+	EXPECT_EQ(index.Size(), 2u);
+
+	index.Erase("r.FOG");
+	EXPECT_EQ(index.Size(), 2u);
+	index.Erase("r.fog");
+	std::vector<std::string> names;
+	index.FindPrefix("r.", names);
+	EXPECT_EQ(names, (std::vector<std::string>{ "r.Fog" }));
+
+	index.Erase("r.Fog");
+	index.Erase("r.Fog");
+	EXPECT_EQ(index.Size(), 0u);
+	index.Insert("r.Bloom");
+	index.Clear();
+	EXPECT_EQ(index.Size(), 0u);
+}
+
+ADRIA_TEST(ConsoleNameIndex, SearchRanksMatchTypes)
+{
+	ConsoleNameIndex const index = MakeIndex({ "r.SSAO.Radius", "r.SSAO", "r.SSAO.Resolution", "r.HBAO.Radius", "r.Reflections", "r.Shadows.Cascades" });
+
+	std::vector<ConsoleNameMatch> matches;
+	index.Search("r.ssao", matches);
+	ASSERT_EQ(matches.size(), 3u);
+	EXPECT_EQ(matches[0].name, "r.SSAO");
+	EXPECT_EQ(matches[0].type, ConsoleNameMatchType::Exact);
+	//shorter completions of the prefix come first
+	EXPECT_EQ(matches[1].name, "r.SSAO.Radius");
+	EXPECT_EQ(matches[1].type, ConsoleNameMatchType::Prefix);
+	EXPECT_EQ(matches[2].name, "r.SSAO.Resolution");
+
+	//substrings starting a name segment rank above the ones inside a segment
+	EXPECT_EQ(SearchNames(index, "radius"), (std::vector<std::string>{ "r.HBAO.Radius", "r.SSAO.Radius" }));
+	index.Search("adius", matches);
+	ASSERT_EQ(matches.size(), 2u);
+	EXPECT_EQ(matches[0].type, ConsoleNameMatchType::Substring);
+	index.Search("radius", matches);
+	Int const segment_score = matches[0].score;
+	index.Search("adius", matches);
+	EXPECT_GT(segment_score, matches[0].score);
+
+	//subsequences are the last resort
+	index.Search("shcas", matches);
+	ASSERT_EQ(matches.size(), 1u);
+	EXPECT_EQ(matches[0].name, "r.Shadows.Cascades");
+	EXPECT_EQ(matches[0].type, ConsoleNameMatchType::Fuzzy);
+
+	EXPECT_TRUE(SearchNames(index, "").empty());
+	EXPECT_TRUE(SearchNames(index, "zzz").empty());
+}
+
+ADRIA_TEST(ConsoleNameIndex, FuzzyPrefersSegmentStarts)
+{
+	ConsoleNameIndex const index = MakeIndex({ "r.ViewFrustumScale", "r.VolumetricFog.SampleCount", "r.FXAA.SubpixelCount", "r.Fog.Volume.Scattering" });
+	std::vector<ConsoleNameMatch> matches;
+	index.Search("vfsc", matches);
+	ASSERT_EQ(matches.size(), 2u);
+	EXPECT_EQ(matches[0].type, ConsoleNameMatchType::Fuzzy);
+	EXPECT_EQ(matches[0].name, "r.VolumetricFog.SampleCount");
+	EXPECT_EQ(SearchNames(index, "fsc"), (std::vector<std::string>{ "r.Fog.Volume.Scattering", "r.FXAA.SubpixelCount", "r.VolumetricFog.SampleCount", "r.ViewFrustumScale" }));
+}
+
+ADRIA_TEST(ConsoleNameIndex, MaxResultsKeepsTheBestMatches)
+{
+	std::vector<std::string> const names = MakeNames(2000);
+	ConsoleNameIndex index;
+	for (std::string const& name : names) index.Insert(name);
+
+	for (Char const* query : { "r.ssao", "radius", "rssr", "bloom.int" })
+	{
+		std::vector<ConsoleNameMatch> all, top;
+		index.Search(query, all);
+		index.Search(query, top, 10);
+		Uint64 const expected_count = std::min<Uint64>(10, all.size());
+		ASSERT_EQ(top.size(), expected_count);
+		for (Uint64 i = 0; i < top.size(); ++i) EXPECT_EQ(top[i].name, all[i].name);
+	}
+}
+
+ADRIA_BENCHMARK(ConsoleNameIndex, TenThousandNames)
+{
+	static constexpr Uint32 NameCount = 10000;
+	std::vector<std::string> const names = MakeNames(NameCount);
+	ConsoleNameIndex index;
+	Float64 const insert_ms = test::MeasureMilliseconds([&]()
+		{
+			index.Clear();
+			for (std::string const& name : names) index.Insert(name);
+		});
+
+	static Char const* const queries[] = { "r.s", "r.ssao.r", "editor.", "radius", "vfsc", "pathtracing.quality1" };
+	std::vector<std::string> prefix_names;
+	Float64 const prefix_ms = test::MeasureMilliseconds([&]()
+		{
+			for (Uint32 i = 0; i < 100; ++i)
+			{
+				for (Char const* query : queries) index.FindPrefix(query, prefix_names, 32);
+			}
+		});
+	//the linear scan over all names the console completion used before
+	Float64 const scan_ms = test::MeasureMilliseconds([&]()
+		{
+			for (Uint32 i = 0; i < 100; ++i)
+			{
+				for (std::string_view query : queries)
+				{
+					prefix_names.clear();
+					for (std::string const& name : names)
+					{
+						if (name.size() >= query.size() && std::equal(query.begin(), query.end(), name.begin(), [](Char a, Char b) { return tolower(a) == tolower(b); }))
+						{
+							prefix_names.push_back(name);
+						}
+					}
+				}
+			}
+		});
+	std::vector<ConsoleNameMatch> matches;
+	Float64 const search_ms = test::MeasureMilliseconds([&]()
+		{
+			for (Char const* query : queries) index.Search(query, matches, 32);
+		});
+
+	std::string const details = std::to_string(NameCount) + " names";
+	test::ReportBenchmark("insert", insert_ms, details);
+	test::ReportBenchmark("prefix x600", prefix_ms, details);
+	test::ReportBenchmark("linear prefix scan x600", scan_ms, details);
+	test::ReportBenchmark("ranked search x6", search_ms, details);
+}
@@ -0,0 +1,92 @@
+#include "Core/ConsoleTokenizer.h"
+
+using namespace adria;
+
+namespace
+{
+	std::vector<ConsoleTokens> Tokenize(std::string_view input)
+	{
+		std::vector<ConsoleTokens> commands;
+		std::string error;
+		EXPECT_TRUE(TokenizeConsoleInput(input, commands, &error));
+		EXPECT_TRUE(error.empty());
+		return commands;
+	}
+}
+
+ADRIA_TEST(ConsoleTokenizer, SplitsOnWhitespace)
+{
+	std::vector<ConsoleTokens> const commands = Tokenize("  r.Fog \t 1\r\n");
+	ASSERT_EQ(commands.size(), 1u);
+	ASSERT_EQ(commands[0].size(), 2u);
+	EXPECT_EQ(commands[0][0], "r.Fog");
+	EXPECT_EQ(commands[0][1], "1");
+
+	EXPECT_TRUE(Tokenize("").empty());
+	EXPECT_TRUE(Tokenize(" \t ").empty());
+}
+
+ADRIA_TEST(ConsoleTokenizer, SemicolonSeparatesCommands)
+{
+	std::vector<ConsoleTokens> const commands = Tokenize("r.A 1;r.B 2 ; ;; r.C");
+	ASSERT_EQ(commands.size(), 3u);
+	EXPECT_EQ(commands[0], (ConsoleTokens{ "r.A", "1" }));
+	EXPECT_EQ(commands[1], (ConsoleTokens{ "r.B", "2" }));
+	EXPECT_EQ(commands[2], (ConsoleTokens{ "r.C" }));
+
+	//a quoted semicolon is part of the token
+	std::vector<ConsoleTokens> const quoted = Tokenize("r.Name \"a;b\"; r.D 4");
+	ASSERT_EQ(quoted.size(), 2u);
+	EXPECT_EQ(quoted[0][1], "a;b");
+}
+
+ADRIA_TEST(ConsoleTokenizer, Comments)
+{
+	EXPECT_TRUE(Tokenize("# whole line").empty());
+	EXPECT_TRUE(Tokenize("   // whole line").empty());
+	EXPECT_EQ(Tokenize("r.A 1 # rest; r.B 2"), (std::vector<ConsoleTokens>{ { "r.A", "1" } }));
+	EXPECT_EQ(Tokenize("r.A 1; r.B 2 // rest"), (std::vector<ConsoleTokens>{ { "r.A", "1" }, { "r.B", "2" } }));
+
+	//only the start of a token starts a comment
+	EXPECT_EQ(Tokenize("url http://host/a#b"), (std::vector<ConsoleTokens>{ { "url", "http://host/a#b" } }));
+	EXPECT_EQ(Tokenize("r.Name \"# not a comment\""), (std::vector<ConsoleTokens>{ { "r.Name", "# not a comment" } }));
+}
+
+ADRIA_TEST(ConsoleTokenizer, QuotesAndEscapes)
+{
+	EXPECT_EQ(Tokenize("exec \"my file.ini\""), (std::vector<ConsoleTokens>{ { "exec", "my file.ini" } }));
+	EXPECT_EQ(Tokenize("r.Name \"\""), (std::vector<ConsoleTokens>{ { "r.Name", "" } }));
+	EXPECT_EQ(Tokenize(R"(r.Name "say \"hi\"")"), (std::vector<ConsoleTokens>{ { "r.Name", "say \"hi\"" } }));
+	EXPECT_EQ(Tokenize(R"(r.Name "a\\b")"), (std::vector<ConsoleTokens>{ { "r.Name", "a\\b" } }));
+	//other backslashes are kept, so windows paths don't need escaping
+	EXPECT_EQ(Tokenize(R"(r.Path "C:\dir\file.ini")"), (std::vector<ConsoleTokens>{ { "r.Path", "C:\\dir\\file.ini" } }));
+	EXPECT_EQ(Tokenize(R"(r.Path C:\dir\file.ini)"), (std::vector<ConsoleTokens>{ { "r.Path", "C:\\dir\\file.ini" } }));
+	//a quote ends an unquoted token
+	EXPECT_EQ(Tokenize("a\"b c\""), (std::vector<ConsoleTokens>{ { "a", "b c" } }));
+}
+
+ADRIA_TEST(ConsoleTokenizer, UnterminatedQuote)
+{
+	std::vector<ConsoleTokens> commands;
+	std::string error;
+	EXPECT_FALSE(TokenizeConsoleInput("r.A 1; r.Name \"abc", commands, &error));
+	EXPECT_EQ(error, "unterminated quote at column 15");
+	EXPECT_FALSE(TokenizeConsoleInput(R"(r.Name "abc\")", commands));
+}
+
+ADRIA_TEST(ConsoleTokenizer, QuoteRoundTrip)
+{
+	EXPECT_EQ(QuoteConsoleToken("plain"), "plain");
+	EXPECT_EQ(QuoteConsoleToken("C:\\dir"), "C:\\dir");
+	EXPECT_EQ(QuoteConsoleToken("two words"), "\"two words\"");
+	EXPECT_EQ(QuoteConsoleToken(""), "\"\"");
+
+	std::vector<std::string> const tokens = { "", "two words", "a;b", "#hash", "//slashes", "say \"hi\"", "back\\slash \\\"", "tab\there", "C:\\dir\\" };
+	for (std::string const& token : tokens)
+	{
+		std::vector<ConsoleTokens> const commands = Tokenize("r.Name " + QuoteConsoleToken(token));
+		ASSERT_EQ(commands.size(), 1u);
+		ASSERT_EQ(commands[0].size(), 2u);
+		EXPECT_EQ(commands[0][1], token);
+	}
+}
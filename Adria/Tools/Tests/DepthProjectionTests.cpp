@@ -0,0 +1,93 @@
+#include "Rendering/DepthProjection.h"
+
+using namespace adria;
+
+namespace
+{
+	constexpr Float Fov = pi_div_4<Float>;
+	constexpr Float AspectRatio = 16.0f / 9.0f;
+	constexpr Float NearPlane = 0.1f;
+	constexpr Float FarPlane = 1000.0f;
+	constexpr Float ViewDepths[] = { 0.1f, 0.25f, 1.0f, 7.5f, 100.0f, 640.0f, 1000.0f };
+
+	Float ProjectDepth(Matrix const& projection, Float view_depth)
+	{
+		Vector4 const clip = Vector4::Transform(Vector4(0.0f, 0.0f, view_depth, 1.0f), projection);
+		return clip.z / clip.w;
+	}
+}
+
+ADRIA_TEST(DepthProjection, ReverseZMapsNearToOne)
+{
+	Matrix const projection = CreateReverseZProjection(Fov, AspectRatio, NearPlane, FarPlane, false);
+	EXPECT_NEAR(ProjectDepth(projection, NearPlane), 1.0f, 1e-6f);
+	EXPECT_NEAR(ProjectDepth(projection, FarPlane), 0.0f, 1e-6f);
+	EXPECT_EQ(DepthClearValue, 0.0f);
+
+	//depth decreases with distance
+	Float previous_depth = 2.0f;
+	for (Float view_depth : ViewDepths)
+	{
+		Float const depth = ProjectDepth(projection, view_depth);
+		EXPECT_LT(depth, previous_depth);
+		previous_depth = depth;
+	}
+}
+
+ADRIA_TEST(DepthProjection, InfiniteIsTheLimitOfFinite)
+{
+	Matrix const infinite = CreateReverseZProjection(Fov, AspectRatio, NearPlane, FarPlane, true);
+	Matrix const very_far = CreateReverseZProjection(Fov, AspectRatio, NearPlane, 1e7f, false);
+	for (Uint32 row = 0; row < 4; ++row)
+	{
+		for (Uint32 column = 0; column < 4; ++column)
+		{
+			EXPECT_NEAR(infinite.m[row][column], very_far.m[row][column], 1e-6f);
+		}
+	}
+
+	//depth is near / view depth, it never reaches 0 so nothing behind the scene far plane is clipped
+	EXPECT_NEAR(ProjectDepth(infinite, NearPlane), 1.0f, 1e-6f);
+	for (Float view_depth : { 10.0f, 1e4f, 1e8f, 1e20f })
+	{
+		Float const depth = ProjectDepth(infinite, view_depth);
+		EXPECT_GT(depth, 0.0f);
+		EXPECT_NEAR(depth, NearPlane / view_depth, 1e-6f * NearPlane / view_depth);
+	}
+}
+
+ADRIA_TEST(DepthProjection, LinearizationRoundTrip)
+{
+	for (Bool infinite_far : { false, true })
+	{
+		Matrix const projection = CreateReverseZProjection(Fov, AspectRatio, NearPlane, FarPlane, infinite_far);
+		DepthLinearization const linearization = ComputeDepthLinearization(NearPlane, FarPlane, infinite_far);
+		if (infinite_far) EXPECT_EQ(linearization.bias, 0.0f);
+
+		for (Float view_depth : ViewDepths)
+		{
+			Float const depth = ProjectDepth(projection, view_depth);
+			EXPECT_NEAR(LinearizeDepth(depth, linearization), view_depth, 1e-4f * view_depth);
+			EXPECT_NEAR(DelinearizeDepth(view_depth, linearization), depth, 1e-6f);
+			EXPECT_NEAR(LinearizeDepth(DelinearizeDepth(view_depth, linearization), linearization), view_depth, 1e-4f * view_depth);
+		}
+	}
+}
+
+ADRIA_TEST(DepthProjection, ViewFrustumIsBounded)
+{
+	BoundingFrustum const frustum = CreateViewFrustum(Fov, AspectRatio, NearPlane, FarPlane);
+	EXPECT_NEAR(frustum.Near, NearPlane, 1e-4f);
+	EXPECT_NEAR(frustum.Far, FarPlane, 1e-1f);
+
+	Float const mid_depth = 50.0f;
+	Float const half_height = std::tan(0.5f * Fov) * mid_depth;
+	Float const half_width = half_height * AspectRatio;
+	EXPECT_EQ(frustum.Contains(Vector3(0.0f, 0.0f, mid_depth)), DirectX::CONTAINS);
+	EXPECT_EQ(frustum.Contains(Vector3(0.99f * half_width, 0.99f * half_height, mid_depth)), DirectX::CONTAINS);
+	EXPECT_EQ(frustum.Contains(Vector3(1.01f * half_width, 0.0f, mid_depth)), DirectX::DISJOINT);
+	EXPECT_EQ(frustum.Contains(Vector3(0.0f, 1.01f * half_height, mid_depth)), DirectX::DISJOINT);
+	EXPECT_EQ(frustum.Contains(Vector3(0.0f, 0.0f, 0.5f * NearPlane)), DirectX::DISJOINT);
+	EXPECT_EQ(frustum.Contains(Vector3(0.0f, 0.0f, 1.01f * FarPlane)), DirectX::DISJOINT);
+	EXPECT_EQ(frustum.Contains(Vector3(0.0f, 0.0f, -mid_depth)), DirectX::DISJOINT);
+}
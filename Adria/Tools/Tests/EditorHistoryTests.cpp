@@ -0,0 +1,170 @@
+#include "Editor/EditorHistory.h"
+
+using namespace adria;
+
+namespace
+{
+	struct TestPosition
+	{
+		Float x = 0.0f;
+		Float y = 0.0f;
+	};
+
+	struct TestName
+	{
+		std::string name;
+	};
+}
+
+namespace adria
+{
+	template<>
+	struct EditorSnapshotHeapSize<TestName>
+	{
+		static Uint64 Get(TestName const& component) { return component.name.capacity(); }
+	};
+}
+
+namespace
+{
+	//applies an edit to the registry and records it like the editor's property widgets do
+	template<typename T, typename F>
+	void Edit(entt::registry& reg, EditorHistory& history, entt::entity entity, F&& edit)
+	{
+		T& component = reg.get<T>(entity);
+		T const before = component;
+		edit(component);
+		history.Record(entity, before, component);
+	}
+}
+
+ADRIA_TEST(EditorHistory, UndoRedoRestoresRegistry)
+{
+	entt::registry reg;
+	entt::entity const entity = reg.create();
+	reg.emplace<TestPosition>(entity, TestPosition{ 1.0f, 2.0f });
+
+	EditorHistory history;
+	Edit<TestPosition>(reg, history, entity, [](TestPosition& p) { p.x = 5.0f; });
+	history.BreakMerge();
+	Edit<TestPosition>(reg, history, entity, [](TestPosition& p) { p.y = 7.0f; });
+	EXPECT_EQ(history.GetUndoCount(), 2u);
+
+	ASSERT_TRUE(history.Undo(reg));
+	EXPECT_EQ(reg.get<TestPosition>(entity).x, 5.0f);
+	EXPECT_EQ(reg.get<TestPosition>(entity).y, 2.0f);
+	ASSERT_TRUE(history.Undo(reg));
+	EXPECT_EQ(reg.get<TestPosition>(entity).x, 1.0f);
+	EXPECT_FALSE(history.Undo(reg));
+
+	ASSERT_TRUE(history.Redo(reg));
+	ASSERT_TRUE(history.Redo(reg));
+	EXPECT_EQ(reg.get<TestPosition>(entity).x, 5.0f);
+	EXPECT_EQ(reg.get<TestPosition>(entity).y, 7.0f);
+	EXPECT_FALSE(history.Redo(reg));
+
+	//a new edit after an undo drops the redo stack
+	ASSERT_TRUE(history.Undo(reg));
+	Edit<TestPosition>(reg, history, entity, [](TestPosition& p) { p.x = -1.0f; });
+	EXPECT_FALSE(history.CanRedo());
+}
+
+ADRIA_TEST(EditorHistory, DragIsMergedUntilBreak)
+{
+	entt::registry reg;
+	entt::entity const entity = reg.create();
+	reg.emplace<TestPosition>(entity);
+
+	EditorHistory history;
+	for (Uint32 i = 1; i <= 10; ++i)
+	{
+		Edit<TestPosition>(reg, history, entity, [i](TestPosition& p) { p.x = (Float)i; });
+	}
+	EXPECT_EQ(history.GetUndoCount(), 1u);
+	history.BreakMerge();
+	Edit<TestPosition>(reg, history, entity, [](TestPosition& p) { p.x = 20.0f; });
+	EXPECT_EQ(history.GetUndoCount(), 2u);
+
+	history.Undo(reg);
+	EXPECT_EQ(reg.get<TestPosition>(entity).x, 10.0f);
+	history.Undo(reg);
+	EXPECT_EQ(reg.get<TestPosition>(entity).x, 0.0f);
+}
+
+ADRIA_TEST(EditorHistory, GroupIsUndoneAsOne)
+{
+	entt::registry reg;
+	entt::entity const entity = reg.create();
+	reg.emplace<TestPosition>(entity);
+	reg.emplace<TestName>(entity, TestName{ "light" });
+
+	EditorHistory history;
+	history.BeginGroup();
+	Edit<TestPosition>(reg, history, entity, [](TestPosition& p) { p.y = 3.0f; });
+	Edit<TestName>(reg, history, entity, [](TestName& n) { n.name = "spot light"; });
+	history.EndGroup();
+	EXPECT_EQ(history.GetUndoCount(), 1u);
+
+	history.Undo(reg);
+	EXPECT_EQ(reg.get<TestPosition>(entity).y, 0.0f);
+	EXPECT_EQ(reg.get<TestName>(entity).name, "light");
+	history.Redo(reg);
+	EXPECT_EQ(reg.get<TestPosition>(entity).y, 3.0f);
+	EXPECT_EQ(reg.get<TestName>(entity).name, "spot light");
+
+	//an empty group records nothing
+	history.BeginGroup();
+	history.EndGroup();
+	EXPECT_EQ(history.GetUndoCount(), 1u);
+}
+
+ADRIA_TEST(EditorHistory, DestroyedEntityIsSkipped)
+{
+	entt::registry reg;
+	entt::entity const entity = reg.create();
+	reg.emplace<TestPosition>(entity);
+	entt::entity const other = reg.create();
+	reg.emplace<TestPosition>(other);
+
+	EditorHistory history;
+	history.BeginGroup();
+	Edit<TestPosition>(reg, history, entity, [](TestPosition& p) { p.x = 1.0f; });
+	Edit<TestPosition>(reg, history, other, [](TestPosition& p) { p.x = 2.0f; });
+	history.EndGroup();
+
+	reg.destroy(entity);
+	EXPECT_TRUE(history.Undo(reg));
+	EXPECT_EQ(reg.get<TestPosition>(other).x, 0.0f);
+}
+
+ADRIA_TEST(EditorHistory, BudgetCountsHeapMemory)
+{
+	entt::registry reg;
+	entt::entity const entity = reg.create();
+	reg.emplace<TestName>(entity);
+
+	EditorHistory history;
+	std::string const long_name(4096, 'a');
+	Edit<TestName>(reg, history, entity, [&](TestName& n) { n.name = long_name; });
+	//the after snapshot alone owns the 4 KB string
+	EXPECT_GE(history.GetUsedBytes(), long_name.size());
+
+	//each edit below owns two copies of the string, so only a few of them fit in the budget
+	history.SetByteBudget(32 * 1024);
+	for (Uint32 i = 0; i < 16; ++i)
+	{
+		history.BreakMerge();
+		Edit<TestName>(reg, history, entity, [i](TestName& n) { n.name[0] = (Char)('b' + i); });
+	}
+	EXPECT_LE(history.GetUsedBytes(), history.GetByteBudget());
+	EXPECT_LT(history.GetUndoCount(), 5u);
+	EXPECT_GT(history.GetUndoCount(), 1u);
+
+	//undone commands are released when a new edit clears the redo stack, only the new one is left
+	while (history.Undo(reg)) {}
+	history.BreakMerge();
+	Edit<TestName>(reg, history, entity, [](TestName& n) { n.name = "short"; });
+	EXPECT_EQ(history.GetUndoCount(), 1u);
+	EXPECT_GE(history.GetUsedBytes(), long_name.size());
+	EXPECT_LT(history.GetUsedBytes(), 2 * long_name.size());
+}
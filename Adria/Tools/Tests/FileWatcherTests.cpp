@@ -0,0 +1,169 @@
+#include "Utilities/FileWatcher.h"
+
+using namespace adria;
+
+namespace
+{
+	constexpr std::chrono::milliseconds DebounceInterval{ 50 };
+
+	struct ChangeCounter
+	{
+		std::map<std::string, Uint32> counts;
+
+		void Attach(FileWatcher& watcher)
+		{
+			std::ignore = watcher.GetFileModifiedEvent().AddLambda([this](std::string const& file) { ++counts[std::filesystem::path(file).filename().string()]; });
+		}
+		Uint32 Count(std::string const& file_name) const
+		{
+			auto it = counts.find(file_name);
+			return it != counts.end() ? it->second : 0;
+		}
+		Uint32 Total() const
+		{
+			Uint32 total = 0;
+			for (auto const& [file, count] : counts) total += count;
+			return total;
+		}
+	};
+
+	void WriteFile(std::string const& path, std::string_view contents)
+	{
+		std::ofstream os(path, std::ios::binary | std::ios::trunc);
+		os << contents;
+	}
+
+	//keeps checking for several debounce intervals so every pending change is either reported or dropped
+	void Settle(FileWatcher& watcher)
+	{
+		auto const end = std::chrono::steady_clock::now() + DebounceInterval * 4;
+		while (std::chrono::steady_clock::now() < end)
+		{
+			watcher.CheckWatchedFiles();
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+		watcher.CheckWatchedFiles();
+	}
+
+	//the mtime based polling backend needs the clock to move between writes
+	void WaitForNewWriteTime()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+}
+
+#if ADRIA_PLATFORM_LINUX
+ADRIA_TEST(FileWatcher, NativeBackendIsAvailable)
+{
+	EXPECT_TRUE(CreatePlatformFileWatcherBackend() != nullptr);
+}
+#endif
+
+ADRIA_TEST(FileWatcher, SaveSequenceIsReportedOnce)
+{
+	test::TempDirectory dir;
+	WriteFile(dir.GetFilePath("Lighting.hlsl"), "float4 main() : SV_Target { return 0; }");
+	WriteFile(dir.GetFilePath("Common.hlsli"), "#pragma once");
+
+	FileWatcher watcher(false, DebounceInterval);
+	ChangeCounter counter;
+	counter.Attach(watcher);
+	watcher.AddPathToWatch(dir.GetPath());
+	Settle(watcher);
+	EXPECT_EQ(counter.Total(), 0u);
+
+	//an editor save: write a temp file, rename it over the original and touch it
+	std::string const temp_path = dir.GetFilePath("Lighting.hlsl.tmp");
+	WriteFile(temp_path, "float4 main() : SV_Target { return 1; }");
+	std::filesystem::rename(temp_path, dir.GetFilePath("Lighting.hlsl"));
+	{
+		std::ofstream os(dir.GetFilePath("Lighting.hlsl"), std::ios::binary | std::ios::app);
+		os << "\n";
+	}
+	Settle(watcher);
+	EXPECT_EQ(counter.Count("Lighting.hlsl"), 1u);
+	EXPECT_EQ(counter.Count("Common.hlsli"), 0u);
+	//the temp file was renamed away before the interval expired
+	EXPECT_EQ(counter.Count("Lighting.hlsl.tmp"), 0u);
+
+	//a later change is reported again
+	WriteFile(dir.GetFilePath("Lighting.hlsl"), "float4 main() : SV_Target { return 2; }");
+	Settle(watcher);
+	EXPECT_EQ(counter.Count("Lighting.hlsl"), 2u);
+	EXPECT_EQ(counter.Total(), 2u);
+}
+
+ADRIA_TEST(FileWatcher, RapidWritesAreCoalesced)
+{
+	test::TempDirectory dir;
+	WriteFile(dir.GetFilePath("Shader.hlsl"), "0");
+
+	FileWatcher watcher(false, DebounceInterval);
+	ChangeCounter counter;
+	counter.Attach(watcher);
+	watcher.AddPathToWatch(dir.GetPath());
+
+	for (Uint32 i = 0; i < 10; ++i)
+	{
+		WriteFile(dir.GetFilePath("Shader.hlsl"), std::to_string(i));
+		watcher.CheckWatchedFiles();
+	}
+	Settle(watcher);
+	EXPECT_EQ(counter.Count("Shader.hlsl"), 1u);
+}
+
+ADRIA_TEST(FileWatcher, FileDeletedBeforeDebounceIsNotReported)
+{
+	test::TempDirectory dir;
+	FileWatcher watcher(false, DebounceInterval);
+	ChangeCounter counter;
+	counter.Attach(watcher);
+	watcher.AddPathToWatch(dir.GetPath());
+
+	WriteFile(dir.GetFilePath("Scratch.hlsl"), "scratch");
+	watcher.CheckWatchedFiles();
+	std::filesystem::remove(dir.GetFilePath("Scratch.hlsl"));
+	Settle(watcher);
+	EXPECT_EQ(counter.Total(), 0u);
+}
+
+ADRIA_TEST(FileWatcher, NewSubdirectoriesAreWatched)
+{
+	test::TempDirectory dir;
+	FileWatcher watcher(false, DebounceInterval);
+	ChangeCounter counter;
+	counter.Attach(watcher);
+	watcher.AddPathToWatch(dir.GetPath(), true);
+
+	std::filesystem::create_directories(dir.GetFilePath("Lighting/Shadows"));
+	watcher.CheckWatchedFiles();
+	WriteFile(dir.GetFilePath("Lighting/Shadows/Cascades.hlsli"), "#pragma once");
+	Settle(watcher);
+	EXPECT_EQ(counter.Count("Cascades.hlsli"), 1u);
+	EXPECT_EQ(counter.Total(), 1u);
+}
+
+ADRIA_TEST(FileWatcher, PollingBackendReportsEachChangeOnce)
+{
+	test::TempDirectory dir;
+	WriteFile(dir.GetFilePath("Polled.hlsl"), "0");
+	WriteFile(dir.GetFilePath("Untouched.hlsl"), "0");
+
+	FileWatcher watcher(true, DebounceInterval);
+	ChangeCounter counter;
+	counter.Attach(watcher);
+	watcher.AddPathToWatch(dir.GetPath());
+	Settle(watcher);
+	EXPECT_EQ(counter.Total(), 0u);
+
+	WaitForNewWriteTime();
+	WriteFile(dir.GetFilePath("Polled.hlsl"), "1");
+	Settle(watcher);
+	EXPECT_EQ(counter.Count("Polled.hlsl"), 1u);
+
+	WaitForNewWriteTime();
+	WriteFile(dir.GetFilePath("Polled.hlsl"), "2");
+	Settle(watcher);
+	EXPECT_EQ(counter.Count("Polled.hlsl"), 2u);
+	EXPECT_EQ(counter.Count("Untouched.hlsl"), 0u);
+}
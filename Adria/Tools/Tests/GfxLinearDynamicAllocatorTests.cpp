@@ -0,0 +1,175 @@
+#include "Graphics/GfxLinearDynamicAllocator.h"
+
+using namespace adria;
+
+namespace
+{
+	constexpr Uint64 PageSize = 256 * 1024;
+
+	struct RecordedAllocation
+	{
+		Uint8* cpu_address;
+		Uint64 gpu_address;
+		Uint64 size;
+		Uint64 alignment;
+		Uint8 pattern;
+	};
+
+	//small random sizes go through the thread chunks, every 64th one is larger than a chunk and every 256th one larger than a page
+	Uint64 GetAllocationSize(std::mt19937& rng, Uint32 i)
+	{
+		if (i % 256 == 255) return PageSize + rng() % 4096;
+		if (i % 64 == 63) return 64 * 1024 + rng() % 8192;
+		return 1 + rng() % 1024;
+	}
+
+	//each thread fills its allocations with its own pattern, so overlapping ranges show up as overwritten bytes after all threads joined
+	std::vector<RecordedAllocation> AllocateFromThreads(GfxLinearDynamicAllocator& allocator, Uint32 thread_count, Uint32 allocations_per_thread, Uint32 seed)
+	{
+		std::vector<std::vector<RecordedAllocation>> per_thread(thread_count);
+		std::vector<std::thread> threads;
+		for (Uint32 t = 0; t < thread_count; ++t)
+		{
+			threads.emplace_back([&, t]()
+				{
+					std::mt19937 rng(seed * 31 + t);
+					Uint8 const pattern = (Uint8)(t + 1);
+					for (Uint32 i = 0; i < allocations_per_thread; ++i)
+					{
+						Uint64 const size = GetAllocationSize(rng, i);
+						Uint64 const alignment = Uint64(1) << (rng() % 9);
+						GfxDynamicAllocation allocation = allocator.Allocate(size, alignment);
+						memset(allocation.cpu_address, pattern, size);
+						per_thread[t].push_back(RecordedAllocation{ (Uint8*)allocation.cpu_address, allocation.gpu_address, size, alignment, pattern });
+					}
+				});
+		}
+		for (std::thread& thread : threads) thread.join();
+
+		std::vector<RecordedAllocation> allocations;
+		for (std::vector<RecordedAllocation>& thread_allocations : per_thread)
+		{
+			allocations.insert(allocations.end(), thread_allocations.begin(), thread_allocations.end());
+		}
+		return allocations;
+	}
+
+	Bool HasPattern(RecordedAllocation const& allocation)
+	{
+		for (Uint64 i = 0; i < allocation.size; ++i)
+		{
+			if (allocation.cpu_address[i] != allocation.pattern) return false;
+		}
+		return true;
+	}
+}
+
+ADRIA_TEST(GfxLinearDynamicAllocator, ConcurrentAllocationsAreAlignedAndDisjoint)
+{
+	static constexpr Uint32 ThreadCount = 8;
+	static constexpr Uint32 AllocationsPerThread = 2000;
+
+	GfxLinearDynamicAllocator allocator(CreateCpuMemoryPage, PageSize);
+	std::vector<RecordedAllocation> allocations = AllocateFromThreads(allocator, ThreadCount, AllocationsPerThread, 1);
+	ASSERT_EQ(allocations.size(), (Uint64)ThreadCount * AllocationsPerThread);
+
+	Uint32 misaligned_count = 0;
+	Uint32 overwritten_count = 0;
+	for (RecordedAllocation const& allocation : allocations)
+	{
+		if (!IsAligned(allocation.gpu_address, allocation.alignment)) ++misaligned_count;
+		if (!HasPattern(allocation)) ++overwritten_count;
+	}
+	EXPECT_EQ(misaligned_count, 0u);
+	EXPECT_EQ(overwritten_count, 0u);
+
+	//the pattern check misses overlaps between allocations of the same thread, so compare the address ranges too
+	std::sort(allocations.begin(), allocations.end(), [](RecordedAllocation const& a, RecordedAllocation const& b) { return a.cpu_address < b.cpu_address; });
+	Uint32 overlap_count = 0;
+	for (Uint64 i = 1; i < allocations.size(); ++i)
+	{
+		if (allocations[i - 1].cpu_address + allocations[i - 1].size > allocations[i].cpu_address) ++overlap_count;
+	}
+	EXPECT_EQ(overlap_count, 0u);
+	EXPECT_GT(allocator.GetPageCount(), 1u);
+}
+
+ADRIA_TEST(GfxLinearDynamicAllocator, ClearReusesPagesAcrossFrames)
+{
+	GfxLinearDynamicAllocator allocator(CreateCpuMemoryPage, PageSize);
+	for (Uint32 frame = 0; frame < 4; ++frame)
+	{
+		std::vector<RecordedAllocation> allocations = AllocateFromThreads(allocator, 4, 500, frame + 10);
+		Uint32 overwritten_count = 0;
+		for (RecordedAllocation const& allocation : allocations)
+		{
+			if (!HasPattern(allocation)) ++overwritten_count;
+		}
+		EXPECT_EQ(overwritten_count, 0u);
+		allocator.Clear();
+	}
+
+	//a thread's cached chunk from the previous frame is not handed out again after Clear
+	GfxDynamicAllocation first = allocator.Allocate(16);
+	GfxDynamicAllocation second = allocator.Allocate(16);
+	EXPECT_EQ(first.offset, 0u);
+	EXPECT_EQ(second.offset, 16u);
+}
+
+ADRIA_TEST(GfxLinearDynamicAllocator, PageCountShrinksAfterHistoryWindow)
+{
+	GfxLinearDynamicAllocator allocator(CreateCpuMemoryPage, PageSize, 2);
+	EXPECT_EQ(allocator.GetPageCount(), 2u);
+
+	//one busy frame grows the allocator
+	for (Uint32 i = 0; i < 6; ++i) allocator.Allocate(PageSize / 2 + 1);
+	allocator.Clear();
+	Uint64 const grown_page_count = allocator.GetPageCount();
+	EXPECT_GT(grown_page_count, 2u);
+
+	//the grown pages are kept while the busy frame is in the history, then trimmed back to the minimum
+	for (Uint32 frame = 0; frame < 7; ++frame)
+	{
+		allocator.Allocate(64);
+		allocator.Clear();
+		EXPECT_EQ(allocator.GetPageCount(), grown_page_count);
+	}
+	allocator.Allocate(64);
+	allocator.Clear();
+	EXPECT_EQ(allocator.GetPageCount(), 2u);
+}
+
+ADRIA_TEST(GfxLinearDynamicAllocator, OversizedAllocationGetsOwnPage)
+{
+	GfxLinearDynamicAllocator allocator(CreateCpuMemoryPage, PageSize);
+	GfxDynamicAllocation small = allocator.Allocate(256, 256);
+	GfxDynamicAllocation large = allocator.Allocate(PageSize * 3, 256);
+	EXPECT_TRUE(IsAligned(large.gpu_address, 256));
+	EXPECT_EQ(large.size, PageSize * 3);
+	memset(large.cpu_address, 0xab, large.size);
+	EXPECT_EQ(*(Uint8*)small.cpu_address, 0);
+	//oversized pages live outside the page ring
+	EXPECT_EQ(allocator.GetPageCount(), 1u);
+}
+
+ADRIA_BENCHMARK(GfxLinearDynamicAllocator, ConcurrentSmallAllocations)
+{
+	static constexpr Uint32 AllocationsPerThread = 100000;
+	Uint32 const thread_count = std::max(std::thread::hardware_concurrency(), 2u);
+	GfxLinearDynamicAllocator allocator(CreateCpuMemoryPage, 4 * 1024 * 1024);
+
+	Float64 const ms = test::MeasureMilliseconds([&]()
+		{
+			std::vector<std::thread> threads;
+			for (Uint32 t = 0; t < thread_count; ++t)
+			{
+				threads.emplace_back([&]()
+					{
+						for (Uint32 i = 0; i < AllocationsPerThread; ++i) allocator.Allocate(64 + (i % 4) * 64, 256);
+					});
+			}
+			for (std::thread& thread : threads) thread.join();
+			allocator.Clear();
+		});
+	test::ReportBenchmark("GfxLinearDynamicAllocator.ConcurrentSmallAllocations", ms, std::to_string(thread_count) + " threads x " + std::to_string(AllocationsPerThread) + " allocations");
+}
@@ -0,0 +1,245 @@
+#include "Graphics/GfxShaderCache.h"
+
+using namespace adria;
+
+namespace
+{
+	GfxShaderCacheKey MakeKey(Uint32 i)
+	{
+		return murmur3_128(&i, sizeof(i));
+	}
+
+	GfxShaderCacheEntry MakeEntry(Uint32 i, Uint64 binary_size = 256)
+	{
+		GfxShaderCacheEntry entry{};
+		entry.shader_hash[0] = i;
+		entry.shader_hash[1] = ~(Uint64)i;
+		entry.includes = { "Common.hlsli", "Lighting/Shadows" + std::to_string(i) + ".hlsli" };
+		entry.binary.resize(binary_size);
+		for (Uint64 k = 0; k < binary_size; ++k) entry.binary[k] = (Uint8)(k * 31 + i);
+		return entry;
+	}
+
+	Bool EntriesEqual(GfxShaderCacheEntry const& a, GfxShaderCacheEntry const& b)
+	{
+		return a.shader_hash[0] == b.shader_hash[0] && a.shader_hash[1] == b.shader_hash[1] && a.includes == b.includes && a.binary == b.binary;
+	}
+
+	Uint64 GetFileSize(std::string const& path)
+	{
+		return std::filesystem::file_size(path);
+	}
+}
+
+ADRIA_TEST(GfxShaderCache, StoreAndLoad)
+{
+	test::TempDirectory dir;
+	std::string const archive_path = dir.GetFilePath("shaders.cache");
+	{
+		GfxShaderCache cache;
+		ASSERT_TRUE(cache.Open(archive_path));
+		for (Uint32 i = 0; i < 16; ++i) EXPECT_TRUE(cache.Store(MakeKey(i), MakeEntry(i)));
+		EXPECT_EQ(cache.GetEntryCount(), 16u);
+
+		GfxShaderCacheEntry entry{};
+		EXPECT_TRUE(cache.Load(MakeKey(3), entry));
+		EXPECT_TRUE(EntriesEqual(entry, MakeEntry(3)));
+		EXPECT_FALSE(cache.Load(MakeKey(100), entry));
+	}
+
+	//a second session reads the persisted index
+	test::LogCapture log;
+	GfxShaderCache cache;
+	ASSERT_TRUE(cache.Open(archive_path));
+	EXPECT_FALSE(log.Contains("rebuilding"));
+	EXPECT_EQ(cache.GetEntryCount(), 16u);
+	for (Uint32 i = 0; i < 16; ++i)
+	{
+		GfxShaderCacheEntry entry{};
+		EXPECT_TRUE(cache.Load(MakeKey(i), entry));
+		EXPECT_TRUE(EntriesEqual(entry, MakeEntry(i)));
+	}
+}
+
+ADRIA_TEST(GfxShaderCache, StoreReplacesEntry)
+{
+	test::TempDirectory dir;
+	GfxShaderCache cache;
+	ASSERT_TRUE(cache.Open(dir.GetFilePath("shaders.cache")));
+	EXPECT_TRUE(cache.Store(MakeKey(1), MakeEntry(1)));
+	EXPECT_TRUE(cache.Store(MakeKey(1), MakeEntry(2, 64)));
+	EXPECT_EQ(cache.GetEntryCount(), 1u);
+	EXPECT_GT(cache.GetStaleSize(), 0u);
+
+	GfxShaderCacheEntry entry{};
+	EXPECT_TRUE(cache.Load(MakeKey(1), entry));
+	EXPECT_TRUE(EntriesEqual(entry, MakeEntry(2, 64)));
+}
+
+ADRIA_TEST(GfxShaderCache, TornTailIsDropped)
+{
+	test::TempDirectory dir;
+	std::string const archive_path = dir.GetFilePath("shaders.cache");
+	{
+		GfxShaderCache cache;
+		ASSERT_TRUE(cache.Open(archive_path));
+		for (Uint32 i = 0; i < 4; ++i) EXPECT_TRUE(cache.Store(MakeKey(i), MakeEntry(i)));
+	}
+	Uint64 const complete_size = GetFileSize(archive_path);
+
+	//a crash in the middle of appending the fifth record, the index was never updated for it
+	{
+		GfxShaderCache cache;
+		ASSERT_TRUE(cache.Open(archive_path));
+		EXPECT_TRUE(cache.Store(MakeKey(4), MakeEntry(4)));
+	}
+	std::filesystem::resize_file(archive_path, complete_size + 100);
+	std::filesystem::remove(archive_path + ".index");
+
+	test::LogCapture log;
+	GfxShaderCache cache;
+	ASSERT_TRUE(cache.Open(archive_path));
+	EXPECT_TRUE(log.Contains("rebuilding"));
+	EXPECT_EQ(cache.GetEntryCount(), 4u);
+	EXPECT_EQ(cache.GetArchiveSize(), complete_size);
+	EXPECT_EQ(GetFileSize(archive_path), complete_size);
+
+	GfxShaderCacheEntry entry{};
+	EXPECT_FALSE(cache.Load(MakeKey(4), entry));
+	for (Uint32 i = 0; i < 4; ++i)
+	{
+		EXPECT_TRUE(cache.Load(MakeKey(i), entry));
+		EXPECT_TRUE(EntriesEqual(entry, MakeEntry(i)));
+	}
+
+	//new records go after the valid data
+	EXPECT_TRUE(cache.Store(MakeKey(4), MakeEntry(4)));
+	EXPECT_TRUE(cache.Load(MakeKey(4), entry));
+	EXPECT_TRUE(EntriesEqual(entry, MakeEntry(4)));
+}
+
+ADRIA_TEST(GfxShaderCache, RebuildIndexSkipsCorruptedRecord)
+{
+	test::TempDirectory dir;
+	std::string const archive_path = dir.GetFilePath("shaders.cache");
+	Uint64 second_record_offset = 0;
+	{
+		GfxShaderCache cache;
+		ASSERT_TRUE(cache.Open(archive_path));
+		EXPECT_TRUE(cache.Store(MakeKey(0), MakeEntry(0)));
+		second_record_offset = cache.GetArchiveSize();
+		EXPECT_TRUE(cache.Store(MakeKey(1), MakeEntry(1)));
+		EXPECT_TRUE(cache.Store(MakeKey(2), MakeEntry(2)));
+	}
+
+	//flip a byte in the payload of the second record, its crc no longer matches
+	{
+		std::fstream archive(archive_path, std::ios::in | std::ios::out | std::ios::binary);
+		archive.seekp(second_record_offset + 100);
+		archive.put('\x7f');
+	}
+	std::filesystem::remove(archive_path + ".index");
+
+	GfxShaderCache cache;
+	ASSERT_TRUE(cache.Open(archive_path));
+	EXPECT_EQ(cache.GetEntryCount(), 2u);
+	GfxShaderCacheEntry entry{};
+	EXPECT_TRUE(cache.Load(MakeKey(0), entry));
+	EXPECT_FALSE(cache.Load(MakeKey(1), entry));
+	EXPECT_TRUE(cache.Load(MakeKey(2), entry));
+	EXPECT_TRUE(EntriesEqual(entry, MakeEntry(2)));
+	EXPECT_GT(cache.GetStaleSize(), 0u);
+}
+
+ADRIA_TEST(GfxShaderCache, StaleIndexIsRebuilt)
+{
+	test::TempDirectory dir;
+	std::string const archive_path = dir.GetFilePath("shaders.cache");
+	std::string const index_path = archive_path + ".index";
+	std::string const old_index_path = dir.GetFilePath("old.index");
+	{
+		GfxShaderCache cache;
+		ASSERT_TRUE(cache.Open(archive_path));
+		EXPECT_TRUE(cache.Store(MakeKey(0), MakeEntry(0)));
+	}
+	std::filesystem::copy_file(index_path, old_index_path);
+	{
+		GfxShaderCache cache;
+		ASSERT_TRUE(cache.Open(archive_path));
+		EXPECT_TRUE(cache.Store(MakeKey(1), MakeEntry(1)));
+	}
+	//an index from an earlier session describes a shorter archive
+	std::filesystem::copy_file(old_index_path, index_path, std::filesystem::copy_options::overwrite_existing);
+
+	test::LogCapture log;
+	GfxShaderCache cache;
+	ASSERT_TRUE(cache.Open(archive_path));
+	EXPECT_TRUE(log.Contains("rebuilding"));
+	EXPECT_EQ(cache.GetEntryCount(), 2u);
+	GfxShaderCacheEntry entry{};
+	EXPECT_TRUE(cache.Load(MakeKey(1), entry));
+	EXPECT_TRUE(EntriesEqual(entry, MakeEntry(1)));
+}
+
+ADRIA_TEST(GfxShaderCache, InvalidArchiveIsRecreated)
+{
+	test::TempDirectory dir;
+	std::string const archive_path = dir.GetFilePath("shaders.cache");
+	{
+		std::ofstream os(archive_path, std::ios::binary);
+		os << "definitely not a shader cache";
+	}
+	GfxShaderCache cache;
+	ASSERT_TRUE(cache.Open(archive_path));
+	EXPECT_EQ(cache.GetEntryCount(), 0u);
+	EXPECT_TRUE(cache.Store(MakeKey(0), MakeEntry(0)));
+	GfxShaderCacheEntry entry{};
+	EXPECT_TRUE(cache.Load(MakeKey(0), entry));
+}
+
+ADRIA_TEST(GfxShaderCache, CompactionDropsUnusedAndReplacedRecords)
+{
+	static constexpr Uint32 UnusedKey = 50;
+	test::TempDirectory dir;
+	std::string const archive_path = dir.GetFilePath("shaders.cache");
+	{
+		GfxShaderCache cache;
+		ASSERT_TRUE(cache.Open(archive_path));
+		for (Uint32 i = 0; i < 10; ++i) EXPECT_TRUE(cache.Store(MakeKey(i), MakeEntry(i)));
+		EXPECT_TRUE(cache.Store(MakeKey(UnusedKey), MakeEntry(UnusedKey)));
+		EXPECT_TRUE(cache.Store(MakeKey(0), MakeEntry(100)));
+	}
+
+	//the unused key becomes evictable after enough sessions, the stale data stays small enough that Close doesn't compact on its own
+	for (Uint32 session = 0; session <= GfxShaderCache::UnusedSessionsBeforeEviction; ++session)
+	{
+		GfxShaderCache cache;
+		ASSERT_TRUE(cache.Open(archive_path));
+		GfxShaderCacheEntry entry{};
+		for (Uint32 i = 0; i < 10; ++i) EXPECT_TRUE(cache.Load(MakeKey(i), entry));
+	}
+
+	GfxShaderCache cache;
+	ASSERT_TRUE(cache.Open(archive_path));
+	Uint64 const size_before = cache.GetArchiveSize();
+	EXPECT_GT(cache.GetStaleSize(), 0u);
+	EXPECT_TRUE(cache.Compact());
+	EXPECT_LT(cache.GetArchiveSize(), size_before);
+	EXPECT_EQ(cache.GetArchiveSize(), GetFileSize(archive_path));
+	EXPECT_EQ(cache.GetEntryCount(), 10u);
+	EXPECT_EQ(cache.GetStaleSize(), 0u);
+
+	GfxShaderCacheEntry entry{};
+	EXPECT_TRUE(cache.Load(MakeKey(0), entry));
+	EXPECT_TRUE(EntriesEqual(entry, MakeEntry(100)));
+	EXPECT_FALSE(cache.Load(MakeKey(UnusedKey), entry));
+	cache.Close();
+
+	//the compacted archive and its index survive a reopen
+	test::LogCapture log;
+	ASSERT_TRUE(cache.Open(archive_path));
+	EXPECT_FALSE(log.Contains("rebuilding"));
+	EXPECT_EQ(cache.GetEntryCount(), 10u);
+	EXPECT_TRUE(cache.Load(MakeKey(0), entry));
+	EXPECT_TRUE(EntriesEqual(entry, MakeEntry(100)));
+}
@@ -0,0 +1,323 @@
+#include "Rendering/GpuAssertDecoder.h"
+#include "Utilities/Json.h"
+
+using namespace adria;
+
+namespace
+{
+	//builds the contents of the assert buffer the way GpuAssert.hlsli writes them
+	class AssertBufferBuilder
+	{
+	public:
+		AssertBufferBuilder() : bytes(sizeof(Uint32), 0) {}
+
+		void AddRecord(Uint32 type, Uint32 shader_id, Uint32 line, std::vector<Uint32> const& args = {})
+		{
+			AddRawRecord(type, (Uint32)args.size(), shader_id, line, args);
+		}
+
+		void AddRawRecord(Uint32 type, Uint32 arg_count, Uint32 shader_id, Uint32 line, std::vector<Uint32> const& args)
+		{
+			AppendWords({ type, arg_count, shader_id, line });
+			AppendWords(args);
+		}
+
+		Uint64 GetRecordBytes() const { return bytes.size() - sizeof(Uint32); }
+
+		//byte_count is what the gpu counter says was written, by default exactly the records that were added
+		std::vector<Uint8> Finish(std::optional<Uint32> byte_count = std::nullopt) const
+		{
+			std::vector<Uint8> result = bytes;
+			Uint32 const count = byte_count.value_or((Uint32)GetRecordBytes());
+			memcpy(result.data(), &count, sizeof(Uint32));
+			return result;
+		}
+
+	private:
+		std::vector<Uint8> bytes;
+
+		void AppendWords(std::vector<Uint32> const& words)
+		{
+			for (Uint32 word : words)
+			{
+				Uint8 word_bytes[sizeof(Uint32)];
+				memcpy(word_bytes, &word, sizeof(Uint32));
+				bytes.insert(bytes.end(), word_bytes, word_bytes + sizeof(Uint32));
+			}
+		}
+	};
+
+	//decodes a copy that is exactly as large as the span, so reads past the end hit the end of the allocation
+	GpuAssertDecodeStats Decode(std::span<Uint8 const> data, std::vector<GpuAssertRecord>& records)
+	{
+		std::vector<Uint8> const exact(data.begin(), data.end());
+		return DecodeGpuAssertBuffer(exact, records);
+	}
+
+	//decodes a synthetic readback and feeds it to the aggregator like GpuAssert::ProcessBufferData does
+	std::vector<Uint64> AddFrame(GpuAssertAggregator& aggregator, AssertBufferBuilder const& builder, Uint64 frame)
+	{
+		std::vector<GpuAssertRecord> records;
+		Decode(builder.Finish(), records);
+		return aggregator.Add(records, frame);
+	}
+}
+
+ADRIA_TEST(GpuAssertDecoder, DecodesRecords)
+{
+	AssertBufferBuilder builder;
+	builder.AddRecord(GpuAssertType_IndexOutOfBounds, 7, 120, { 64, 32 });
+	builder.AddRecord(GpuAssertType_Generic, 3, 15);
+	builder.AddRecord(GpuAssertType_Generic, 3, 16, { 1, 2, 3, 4 });
+
+	std::vector<GpuAssertRecord> records;
+	GpuAssertDecodeStats const stats = Decode(builder.Finish(), records);
+	EXPECT_EQ(stats.record_count, 3u);
+	EXPECT_FALSE(stats.truncated);
+	EXPECT_FALSE(stats.corrupt);
+	ASSERT_EQ(records.size(), 3u);
+
+	EXPECT_EQ(records[0].type, (Uint32)GpuAssertType_IndexOutOfBounds);
+	EXPECT_EQ(records[0].shader_id, 7u);
+	EXPECT_EQ(records[0].line, 120u);
+	EXPECT_EQ(records[0].arg_count, 2u);
+	EXPECT_EQ(records[0].args[0], 64u);
+	EXPECT_EQ(records[0].args[1], 32u);
+	EXPECT_EQ(records[0].args[2], 0u);
+	EXPECT_EQ(records[1].arg_count, 0u);
+	EXPECT_EQ(records[2].args[3], 4u);
+
+	EXPECT_EQ(std::string(GetGpuAssertTypeName(records[0].type)), "IndexOutOfBounds");
+	EXPECT_EQ(std::string(GetGpuAssertTypeName(GpuAssertType_Invalid)), "Invalid");
+	EXPECT_EQ(std::string(GetGpuAssertTypeName(1000)), "Invalid");
+}
+
+ADRIA_TEST(GpuAssertDecoder, EmptyAndShortBuffers)
+{
+	std::vector<GpuAssertRecord> records;
+	GpuAssertDecodeStats stats = Decode({}, records);
+	EXPECT_EQ(stats.record_count, 0u);
+	EXPECT_FALSE(stats.truncated);
+	EXPECT_FALSE(stats.corrupt);
+
+	std::vector<Uint8> const short_buffer = { 0xFF, 0xFF };
+	stats = Decode(short_buffer, records);
+	EXPECT_EQ(stats.record_count, 0u);
+	EXPECT_FALSE(stats.corrupt);
+
+	stats = Decode(AssertBufferBuilder{}.Finish(), records);
+	EXPECT_EQ(stats.record_count, 0u);
+	EXPECT_FALSE(stats.truncated);
+
+	//a count smaller than a record header decodes nothing
+	AssertBufferBuilder builder;
+	builder.AddRecord(GpuAssertType_Generic, 1, 1);
+	stats = Decode(builder.Finish(12), records);
+	EXPECT_EQ(stats.record_count, 0u);
+	EXPECT_FALSE(stats.truncated);
+	EXPECT_FALSE(stats.corrupt);
+	EXPECT_TRUE(records.empty());
+}
+
+ADRIA_TEST(GpuAssertDecoder, OverflowedBufferIsTruncated)
+{
+	AssertBufferBuilder builder;
+	builder.AddRecord(GpuAssertType_Generic, 1, 10, { 5 });
+	builder.AddRecord(GpuAssertType_Generic, 1, 11);
+
+	std::vector<GpuAssertRecord> records;
+	GpuAssertDecodeStats const stats = Decode(builder.Finish(1 << 20), records);
+	EXPECT_EQ(stats.record_count, 2u);
+	EXPECT_TRUE(stats.truncated);
+	EXPECT_FALSE(stats.corrupt);
+}
+
+ADRIA_TEST(GpuAssertDecoder, EveryPrefixDecodesTheWholeRecords)
+{
+	AssertBufferBuilder builder;
+	std::vector<Uint64> record_ends;
+	builder.AddRecord(GpuAssertType_IndexOutOfBounds, 2, 40, { 9, 8 });
+	record_ends.push_back(sizeof(Uint32) + builder.GetRecordBytes());
+	builder.AddRecord(GpuAssertType_Generic, 2, 41);
+	record_ends.push_back(sizeof(Uint32) + builder.GetRecordBytes());
+	builder.AddRecord(GpuAssertType_Generic, 5, 42, { 1, 2, 3, 4 });
+	record_ends.push_back(sizeof(Uint32) + builder.GetRecordBytes());
+	std::vector<Uint8> const buffer = builder.Finish();
+
+	for (Uint64 size = sizeof(Uint32); size <= buffer.size(); ++size)
+	{
+		std::vector<GpuAssertRecord> records;
+		GpuAssertDecodeStats const stats = Decode(std::span(buffer.data(), size), records);
+		Uint32 const complete_records = (Uint32)std::count_if(record_ends.begin(), record_ends.end(), [size](Uint64 end) { return end <= size; });
+		EXPECT_EQ(stats.record_count, complete_records);
+		EXPECT_EQ(records.size(), (Uint64)complete_records);
+		EXPECT_EQ(stats.truncated, size < buffer.size());
+		EXPECT_FALSE(stats.corrupt);
+	}
+}
+
+ADRIA_TEST(GpuAssertDecoder, CorruptHeaders)
+{
+	struct CorruptHeader
+	{
+		Uint32 type;
+		Uint32 arg_count;
+	};
+	CorruptHeader const corrupt_headers[] =
+	{
+		{ GpuAssertType_Invalid, 0 },		//zeroed memory
+		{ GpuAssertType_Count, 0 },			//unknown type
+		{ 0xFFFFFFFF, 1 },
+		{ GpuAssertType_Generic, GpuAssertMaxArgs + 1 },
+		{ GpuAssertType_Generic, 0xFFFFFFFF },
+	};
+	for (CorruptHeader const& header : corrupt_headers)
+	{
+		AssertBufferBuilder builder;
+		builder.AddRecord(GpuAssertType_Generic, 1, 10);
+		builder.AddRawRecord(header.type, header.arg_count, 1, 11, { 0, 0, 0, 0, 0 });
+		builder.AddRecord(GpuAssertType_Generic, 1, 12);
+
+		std::vector<GpuAssertRecord> records;
+		GpuAssertDecodeStats const stats = Decode(builder.Finish(), records);
+		//records before the corrupt one are kept
+		EXPECT_EQ(stats.record_count, 1u);
+		EXPECT_TRUE(stats.corrupt);
+		EXPECT_FALSE(stats.truncated);
+	}
+}
+
+ADRIA_TEST(GpuAssertDecoder, RandomBytesStayInBounds)
+{
+	AssertBufferBuilder builder;
+	for (Uint32 i = 0; i < 32; ++i)
+	{
+		builder.AddRecord(1 + i % 2, i, 100 + i, std::vector<Uint32>(i % 5, i));
+	}
+	std::vector<Uint8> const valid_buffer = builder.Finish();
+
+	std::mt19937 rng(7);
+	for (Uint32 iteration = 0; iteration < 2000; ++iteration)
+	{
+		std::vector<Uint8> buffer = valid_buffer;
+		Uint32 const flips = 1 + rng() % 8;
+		for (Uint32 i = 0; i < flips; ++i)
+		{
+			buffer[rng() % buffer.size()] = (Uint8)rng();
+		}
+		buffer.resize(rng() % (buffer.size() + 1));
+
+		std::vector<GpuAssertRecord> records;
+		GpuAssertDecodeStats const stats = Decode(buffer, records);
+		EXPECT_EQ(records.size(), (Uint64)stats.record_count);
+		for (GpuAssertRecord const& record : records)
+		{
+			EXPECT_LE(record.arg_count, GpuAssertMaxArgs);
+			EXPECT_GT(record.type, (Uint32)GpuAssertType_Invalid);
+			EXPECT_LT(record.type, (Uint32)GpuAssertType_Count);
+		}
+	}
+}
+
+ADRIA_TEST(GpuAssertAggregator, SitesAreCountedAcrossFrames)
+{
+	GpuAssertAggregator aggregator(2);
+
+	AssertBufferBuilder frame_0;
+	frame_0.AddRecord(GpuAssertType_IndexOutOfBounds, 4, 30, { 10, 8 });
+	frame_0.AddRecord(GpuAssertType_IndexOutOfBounds, 4, 30, { 11, 8 });
+	frame_0.AddRecord(GpuAssertType_Generic, 9, 12);
+	std::vector<Uint64> new_sites = AddFrame(aggregator, frame_0, 100);
+	EXPECT_EQ(new_sites, (std::vector<Uint64>{ 0, 1 }));
+
+	//same shader and line but a different type is another site
+	AssertBufferBuilder frame_1;
+	frame_1.AddRecord(GpuAssertType_IndexOutOfBounds, 4, 30, { 12, 8 });
+	frame_1.AddRecord(GpuAssertType_Generic, 4, 30);
+	new_sites = AddFrame(aggregator, frame_1, 101);
+	EXPECT_EQ(new_sites, (std::vector<Uint64>{ 2 }));
+
+	//a frame without failures changes nothing
+	new_sites = AddFrame(aggregator, AssertBufferBuilder{}, 102);
+	EXPECT_TRUE(new_sites.empty());
+
+	EXPECT_EQ(aggregator.GetFailureCount(), 5u);
+	std::vector<GpuAssertSite> const& sites = aggregator.GetSites();
+	ASSERT_EQ(sites.size(), 3u);
+
+	GpuAssertSite const& bounds_site = sites[0];
+	EXPECT_EQ(bounds_site.shader_id, 4u);
+	EXPECT_EQ(bounds_site.line, 30u);
+	EXPECT_EQ(bounds_site.type, (Uint32)GpuAssertType_IndexOutOfBounds);
+	EXPECT_EQ(bounds_site.count, 3u);
+	EXPECT_EQ(bounds_site.first_frame, 100u);
+	EXPECT_EQ(bounds_site.last_frame, 101u);
+	//only the first max_samples_per_site payloads are kept
+	ASSERT_EQ(bounds_site.samples.size(), 2u);
+	EXPECT_EQ(bounds_site.samples[0].args[0], 10u);
+	EXPECT_EQ(bounds_site.samples[1].args[0], 11u);
+
+	EXPECT_EQ(sites[1].count, 1u);
+	EXPECT_EQ(sites[1].first_frame, 100u);
+	EXPECT_EQ(sites[1].last_frame, 100u);
+	EXPECT_EQ(sites[2].type, (Uint32)GpuAssertType_Generic);
+	EXPECT_EQ(sites[2].first_frame, 101u);
+
+	aggregator.Clear();
+	EXPECT_EQ(aggregator.GetFailureCount(), 0u);
+	EXPECT_TRUE(aggregator.GetSites().empty());
+	//sites fail for the first time again after a clear
+	new_sites = AddFrame(aggregator, frame_1, 200);
+	EXPECT_EQ(new_sites, (std::vector<Uint64>{ 0, 1 }));
+}
+
+ADRIA_TEST(GpuAssertAggregator, ZeroSamplesKeepsTheFirstFailure)
+{
+	GpuAssertAggregator aggregator(0);
+	AssertBufferBuilder builder;
+	builder.AddRecord(GpuAssertType_Generic, 1, 5, { 42 });
+	builder.AddRecord(GpuAssertType_Generic, 1, 5, { 43 });
+
+	std::vector<Uint64> const new_sites = AddFrame(aggregator, builder, 10);
+	ASSERT_EQ(new_sites.size(), 1u);
+	GpuAssertSite const& site = aggregator.GetSites()[new_sites[0]];
+	EXPECT_EQ(site.count, 2u);
+	ASSERT_EQ(site.samples.size(), 1u);
+	EXPECT_EQ(site.samples[0].args[0], 42u);
+}
+
+ADRIA_TEST(GpuAssertAggregator, JsonReport)
+{
+	GpuAssertAggregator aggregator;
+	AssertBufferBuilder builder;
+	builder.AddRecord(GpuAssertType_Generic, 1, 5, { 42 });
+	builder.AddRecord(GpuAssertType_IndexOutOfBounds, 2, 7, { 3, 2 });
+	builder.AddRecord(GpuAssertType_IndexOutOfBounds, 2, 7, { 4, 2 });
+	AddFrame(aggregator, builder, 10);
+
+	json const report = json::parse(aggregator.ToJson([](Uint32 shader_id) { return "Shader" + std::to_string(shader_id); }));
+	EXPECT_EQ(report["failure_count"].get<Uint64>(), 3u);
+	EXPECT_EQ(report["site_count"].get<Uint64>(), 2u);
+	ASSERT_EQ(report["sites"].size(), 2u);
+
+	//the site that failed most comes first
+	json const& top_site = report["sites"][0];
+	EXPECT_EQ(top_site["shader"].get<std::string>(), "Shader2");
+	EXPECT_EQ(top_site["shader_id"].get<Uint32>(), 2u);
+	EXPECT_EQ(top_site["line"].get<Uint32>(), 7u);
+	EXPECT_EQ(top_site["type"].get<std::string>(), "IndexOutOfBounds");
+	EXPECT_EQ(top_site["count"].get<Uint64>(), 2u);
+	EXPECT_EQ(top_site["first_frame"].get<Uint64>(), 10u);
+	EXPECT_EQ(top_site["samples"].size(), 2u);
+	EXPECT_EQ(top_site["samples"][1].get<std::vector<Uint32>>(), (std::vector<Uint32>{ 4, 2 }));
+	EXPECT_EQ(report["sites"][1]["type"].get<std::string>(), "Generic");
+
+	//without a name callback the shader id is used
+	json const unnamed_report = json::parse(aggregator.ToJson(nullptr));
+	EXPECT_EQ(unnamed_report["sites"][1]["shader"].get<std::string>(), "1");
+
+	GpuAssertAggregator empty_aggregator;
+	json const empty_report = json::parse(empty_aggregator.ToJson(nullptr));
+	EXPECT_EQ(empty_report["failure_count"].get<Uint64>(), 0u);
+	EXPECT_TRUE(empty_report["sites"].empty());
+}
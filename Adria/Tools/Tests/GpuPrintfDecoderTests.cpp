@@ -0,0 +1,384 @@
+#include "Rendering/GpuPrintfDecoder.h"
+
+using namespace adria;
+
+namespace
+{
+	struct TestArg
+	{
+		GpuPrintfArgCode code;
+		std::vector<Uint32> components;
+	};
+
+	//builds the contents of the printf buffer the way GpuPrintf.hlsli writes them
+	class PrintfBufferBuilder
+	{
+	public:
+		PrintfBufferBuilder() : bytes(sizeof(Uint32), 0) {}
+
+		void AddRecord(std::string_view format, std::vector<TestArg> const& args = {})
+		{
+			std::vector<Uint8> payload(format.begin(), format.end());
+			payload.push_back(0);
+			Uint32 const string_size = (Uint32)payload.size();
+			for (TestArg const& arg : args)
+			{
+				payload.push_back((Uint8)arg.code);
+				AppendWords(payload, arg.components);
+			}
+			AddRawRecord((Uint32)payload.size(), string_size, (Uint32)args.size(), payload);
+		}
+
+		void AddRawRecord(Uint32 num_bytes, Uint32 string_size, Uint32 num_args, std::vector<Uint8> const& payload)
+		{
+			AppendWords(bytes, { num_bytes, string_size, num_args });
+			bytes.insert(bytes.end(), payload.begin(), payload.end());
+		}
+
+		Uint64 GetRecordBytes() const { return bytes.size() - sizeof(Uint32); }
+
+		//byte_count is what the gpu counter says was written, by default exactly the records that were added
+		std::vector<Uint8> Finish(std::optional<Uint32> byte_count = std::nullopt) const
+		{
+			std::vector<Uint8> result = bytes;
+			Uint32 const count = byte_count.value_or((Uint32)GetRecordBytes());
+			memcpy(result.data(), &count, sizeof(Uint32));
+			return result;
+		}
+
+	private:
+		std::vector<Uint8> bytes;
+
+		static void AppendWords(std::vector<Uint8>& out, std::vector<Uint32> const& words)
+		{
+			for (Uint32 word : words)
+			{
+				Uint8 word_bytes[sizeof(Uint32)];
+				memcpy(word_bytes, &word, sizeof(Uint32));
+				out.insert(out.end(), word_bytes, word_bytes + sizeof(Uint32));
+			}
+		}
+	};
+
+	Uint32 FloatBits(Float value)
+	{
+		Uint32 bits;
+		memcpy(&bits, &value, sizeof(Float));
+		return bits;
+	}
+
+	//decodes a copy that is exactly as large as the span, so reads past the end hit the end of the allocation
+	GpuPrintfDecodeStats Decode(std::span<Uint8 const> data, GpuPrintfFormatTable& formats, std::vector<GpuPrintfRecord>& records)
+	{
+		std::vector<Uint8> const exact(data.begin(), data.end());
+		return DecodeGpuPrintfBuffer(exact, formats, records);
+	}
+}
+
+ADRIA_TEST(GpuPrintfDecoder, DecodesRecords)
+{
+	PrintfBufferBuilder builder;
+	builder.AddRecord("pixel {0} value {1}", { { GpuPrintfArg_Uint2, { 3, 4 } }, { GpuPrintfArg_Float, { FloatBits(0.5f) } } });
+	builder.AddRecord("frame");
+	builder.AddRecord("pixel {0} value {1}", { { GpuPrintfArg_Uint2, { 5, 6 } }, { GpuPrintfArg_Float, { FloatBits(1.5f) } } });
+	builder.AddRecord("{0}", { { GpuPrintfArg_Int4, { (Uint32)-1, 2, (Uint32)-3, 4 } } });
+	std::vector<Uint8> const buffer = builder.Finish();
+
+	GpuPrintfFormatTable formats;
+	std::vector<GpuPrintfRecord> records;
+	GpuPrintfDecodeStats const stats = Decode(buffer, formats, records);
+	EXPECT_EQ(stats.record_count, 4u);
+	EXPECT_FALSE(stats.truncated);
+	EXPECT_FALSE(stats.corrupt);
+	ASSERT_EQ(records.size(), 4u);
+
+	//identical format strings share one id
+	EXPECT_EQ(formats.Size(), 3u);
+	EXPECT_EQ(records[0].format_id, records[2].format_id);
+	EXPECT_EQ(formats.Get(records[0].format_id), "pixel {0} value {1}");
+	EXPECT_EQ(formats.Get(records[1].format_id), "frame");
+
+	EXPECT_EQ(records[0].arg_count, 2u);
+	EXPECT_EQ(records[0].args[0].code, GpuPrintfArg_Uint2);
+	EXPECT_EQ(records[0].args[0].data[0], 3u);
+	EXPECT_EQ(records[0].args[0].data[1], 4u);
+	EXPECT_EQ(records[0].args[1].data[0], FloatBits(0.5f));
+	EXPECT_EQ(records[1].arg_count, 0u);
+	EXPECT_EQ(records[3].args[0].code, GpuPrintfArg_Int4);
+	EXPECT_EQ((Int32)records[3].args[0].data[2], -3);
+
+	//unused arguments stay zeroed so records compare bytewise
+	EXPECT_EQ(records[0].args[2].data[0], 0u);
+	EXPECT_EQ(records[1].args[0].code, GpuPrintfArg_Uint);
+}
+
+ADRIA_TEST(GpuPrintfDecoder, EmptyAndShortBuffers)
+{
+	GpuPrintfFormatTable formats;
+	std::vector<GpuPrintfRecord> records;
+
+	GpuPrintfDecodeStats stats = Decode({}, formats, records);
+	EXPECT_EQ(stats.record_count, 0u);
+	EXPECT_FALSE(stats.truncated);
+	EXPECT_FALSE(stats.corrupt);
+
+	std::vector<Uint8> const short_buffer = { 0xFF, 0xFF, 0xFF };
+	stats = Decode(short_buffer, formats, records);
+	EXPECT_EQ(stats.record_count, 0u);
+	EXPECT_FALSE(stats.corrupt);
+
+	//nothing was printed this frame
+	stats = Decode(PrintfBufferBuilder{}.Finish(), formats, records);
+	EXPECT_EQ(stats.record_count, 0u);
+	EXPECT_FALSE(stats.truncated);
+	EXPECT_FALSE(stats.corrupt);
+
+	//a count smaller than a record header decodes nothing
+	PrintfBufferBuilder builder;
+	builder.AddRecord("a");
+	stats = Decode(builder.Finish(8), formats, records);
+	EXPECT_EQ(stats.record_count, 0u);
+	EXPECT_FALSE(stats.truncated);
+	EXPECT_FALSE(stats.corrupt);
+	EXPECT_TRUE(records.empty());
+}
+
+ADRIA_TEST(GpuPrintfDecoder, OverflowedBufferIsTruncated)
+{
+	//the gpu counter keeps growing after the buffer is full
+	PrintfBufferBuilder builder;
+	builder.AddRecord("first {0}", { { GpuPrintfArg_Uint, { 1 } } });
+	builder.AddRecord("second {0}", { { GpuPrintfArg_Uint, { 2 } } });
+	std::vector<Uint8> const buffer = builder.Finish(100000);
+
+	GpuPrintfFormatTable formats;
+	std::vector<GpuPrintfRecord> records;
+	GpuPrintfDecodeStats const stats = Decode(buffer, formats, records);
+	EXPECT_EQ(stats.record_count, 2u);
+	EXPECT_TRUE(stats.truncated);
+	EXPECT_FALSE(stats.corrupt);
+}
+
+ADRIA_TEST(GpuPrintfDecoder, EveryPrefixDecodesTheWholeRecords)
+{
+	PrintfBufferBuilder builder;
+	std::vector<Uint64> record_ends;
+	builder.AddRecord("a {0} {1}", { { GpuPrintfArg_Float3, { 1, 2, 3 } }, { GpuPrintfArg_Int, { 7 } } });
+	record_ends.push_back(sizeof(Uint32) + builder.GetRecordBytes());
+	builder.AddRecord("bb");
+	record_ends.push_back(sizeof(Uint32) + builder.GetRecordBytes());
+	builder.AddRecord("{0}{1}{2}{3}", { { GpuPrintfArg_Uint, { 1 } }, { GpuPrintfArg_Uint2, { 1, 2 } }, { GpuPrintfArg_Uint3, { 1, 2, 3 } }, { GpuPrintfArg_Uint4, { 1, 2, 3, 4 } } });
+	record_ends.push_back(sizeof(Uint32) + builder.GetRecordBytes());
+	std::vector<Uint8> const buffer = builder.Finish();
+
+	//the readback can be cut anywhere, e.g. in the middle of a header, a string or an argument
+	for (Uint64 size = sizeof(Uint32); size <= buffer.size(); ++size)
+	{
+		GpuPrintfFormatTable formats;
+		std::vector<GpuPrintfRecord> records;
+		GpuPrintfDecodeStats const stats = Decode(std::span(buffer.data(), size), formats, records);
+		Uint32 const complete_records = (Uint32)std::count_if(record_ends.begin(), record_ends.end(), [size](Uint64 end) { return end <= size; });
+		EXPECT_EQ(stats.record_count, complete_records);
+		EXPECT_EQ(records.size(), (Uint64)complete_records);
+		EXPECT_EQ(stats.truncated, size < buffer.size());
+		EXPECT_FALSE(stats.corrupt);
+	}
+}
+
+ADRIA_TEST(GpuPrintfDecoder, CorruptHeaders)
+{
+	struct CorruptHeader
+	{
+		Uint32 num_bytes;
+		Uint32 string_size;
+		Uint32 num_args;
+	};
+	CorruptHeader const corrupt_headers[] =
+	{
+		{ 0, 0, 0 },						//empty record
+		{ 4, 0, 0 },						//no format string
+		{ 4, 8, 0 },						//string larger than the record
+		{ 8, 2, GpuPrintfMaxArgs + 1 },		//too many arguments
+	};
+	for (CorruptHeader const& header : corrupt_headers)
+	{
+		PrintfBufferBuilder builder;
+		builder.AddRecord("valid");
+		builder.AddRawRecord(header.num_bytes, header.string_size, header.num_args, std::vector<Uint8>(header.num_bytes, 'x'));
+		builder.AddRecord("never reached");
+
+		GpuPrintfFormatTable formats;
+		std::vector<GpuPrintfRecord> records;
+		GpuPrintfDecodeStats const stats = Decode(builder.Finish(), formats, records);
+		//records before the corrupt one are kept
+		EXPECT_EQ(stats.record_count, 1u);
+		EXPECT_TRUE(stats.corrupt);
+		EXPECT_FALSE(stats.truncated);
+		EXPECT_EQ(formats.Size(), 1u);
+	}
+}
+
+ADRIA_TEST(GpuPrintfDecoder, CorruptArguments)
+{
+	struct CorruptRecord
+	{
+		std::vector<Uint8> payload;
+		Uint32 string_size;
+		Uint32 num_args;
+	};
+	CorruptRecord const corrupt_records[] =
+	{
+		//unknown argument code
+		{ { 'a', 0, (Uint8)GpuPrintfArg_Count, 0, 0, 0, 0 }, 2, 1 },
+		//a float4 needs 16 bytes but the record ends after 4
+		{ { 'a', 0, (Uint8)GpuPrintfArg_Float4, 0, 0, 0, 0 }, 2, 1 },
+		//the string fills the whole record, the declared argument has no bytes left
+		{ { 'a', 'b', 'c', 0 }, 4, 1 },
+		//the format is empty once the terminator is found
+		{ { 0, 'a', 'b', 0 }, 4, 0 },
+	};
+	for (CorruptRecord const& corrupt_record : corrupt_records)
+	{
+		PrintfBufferBuilder builder;
+		builder.AddRecord("valid {0}", { { GpuPrintfArg_Uint, { 1 } } });
+		builder.AddRawRecord((Uint32)corrupt_record.payload.size(), corrupt_record.string_size, corrupt_record.num_args, corrupt_record.payload);
+
+		GpuPrintfFormatTable formats;
+		std::vector<GpuPrintfRecord> records;
+		GpuPrintfDecodeStats const stats = Decode(builder.Finish(), formats, records);
+		EXPECT_EQ(stats.record_count, 1u);
+		EXPECT_TRUE(stats.corrupt);
+		EXPECT_EQ(formats.Size(), 1u);
+	}
+}
+
+ADRIA_TEST(GpuPrintfDecoder, RandomBytesStayInBounds)
+{
+	PrintfBufferBuilder builder;
+	for (Uint32 i = 0; i < 16; ++i)
+	{
+		builder.AddRecord("record {0} {1}", { { GpuPrintfArg_Uint2, { i, i + 1 } }, { GpuPrintfArg_Float, { FloatBits((Float)i) } } });
+	}
+	std::vector<Uint8> const valid_buffer = builder.Finish();
+
+	std::mt19937 rng(42);
+	for (Uint32 iteration = 0; iteration < 2000; ++iteration)
+	{
+		std::vector<Uint8> buffer = valid_buffer;
+		Uint32 const flips = 1 + rng() % 8;
+		for (Uint32 i = 0; i < flips; ++i)
+		{
+			buffer[rng() % buffer.size()] = (Uint8)rng();
+		}
+		buffer.resize(rng() % (buffer.size() + 1));
+
+		GpuPrintfFormatTable formats;
+		std::vector<GpuPrintfRecord> records;
+		GpuPrintfDecodeStats const stats = Decode(buffer, formats, records);
+		EXPECT_EQ(records.size(), (Uint64)stats.record_count);
+		for (GpuPrintfRecord const& record : records)
+		{
+			EXPECT_LE(record.arg_count, GpuPrintfMaxArgs);
+			EXPECT_LT(record.format_id, (Uint32)formats.Size());
+		}
+	}
+}
+
+ADRIA_TEST(GpuPrintfDecoder, FormatsArguments)
+{
+	PrintfBufferBuilder builder;
+	builder.AddRecord("pixel {0} depth {1} count {2}", { { GpuPrintfArg_Uint2, { 3, 4 } }, { GpuPrintfArg_Float, { FloatBits(0.25f) } }, { GpuPrintfArg_Int, { (Uint32)-7 } } });
+	builder.AddRecord("{0} and {1} {x} {", { { GpuPrintfArg_Float3, { FloatBits(1.0f), FloatBits(-2.0f), FloatBits(0.5f) } } });
+
+	GpuPrintfFormatTable formats;
+	std::vector<GpuPrintfRecord> records;
+	Decode(builder.Finish(), formats, records);
+	ASSERT_EQ(records.size(), 2u);
+	EXPECT_EQ(FormatGpuPrintfRecord(records[0], formats.Get(records[0].format_id)), "pixel (3,4) depth 0.250000 count -7");
+	//placeholders without an argument are printed as they are
+	EXPECT_EQ(FormatGpuPrintfRecord(records[1], formats.Get(records[1].format_id)), "(1.000000,-2.000000,0.500000) and {1} {x} {");
+}
+
+ADRIA_TEST(GpuPrintfDecoder, FilterMatchesTheFirstArgument)
+{
+	PrintfBufferBuilder builder;
+	builder.AddRecord("{0}", { { GpuPrintfArg_Uint2, { 3, 4 } } });
+	builder.AddRecord("{0}", { { GpuPrintfArg_Uint2, { 3, 5 } } });
+	builder.AddRecord("{0}", { { GpuPrintfArg_Int3, { 3, 4, 1 } } });
+	builder.AddRecord("{0}", { { GpuPrintfArg_Float2, { 3, 4 } } });
+	builder.AddRecord("{0}", { { GpuPrintfArg_Uint4, { 3, 4, 1, 0 } } });
+	builder.AddRecord("no arguments");
+
+	GpuPrintfFormatTable formats;
+	std::vector<GpuPrintfRecord> records;
+	Decode(builder.Finish(), formats, records);
+	ASSERT_EQ(records.size(), 6u);
+
+	auto PassingRecords = [&records](GpuPrintfFilter const& filter)
+	{
+		std::vector<Bool> passes;
+		for (GpuPrintfRecord const& record : records) passes.push_back(filter.Passes(record));
+		return passes;
+	};
+
+	GpuPrintfFilter filter{};
+	EXPECT_FALSE(filter.IsActive());
+	EXPECT_EQ(PassingRecords(filter), (std::vector<Bool>{ true, true, true, true, true, true }));
+
+	filter.id[0] = 3;
+	filter.id[1] = 4;
+	EXPECT_TRUE(filter.IsActive());
+	EXPECT_EQ(PassingRecords(filter), (std::vector<Bool>{ true, false, true, false, false, false }));
+
+	//a third component never matches a two component id
+	filter.id[2] = 1;
+	EXPECT_EQ(PassingRecords(filter), (std::vector<Bool>{ false, false, true, false, false, false }));
+
+	filter.id[0] = -1;
+	filter.id[1] = -1;
+	EXPECT_EQ(PassingRecords(filter), (std::vector<Bool>{ false, false, true, false, false, false }));
+}
+
+ADRIA_TEST(GpuPrintfDecoder, AggregatesRepeatedRecords)
+{
+	//a synthetic readback of one frame where many threads print the same values
+	PrintfBufferBuilder builder;
+	for (Uint32 i = 0; i < 3; ++i) builder.AddRecord("value {0}", { { GpuPrintfArg_Uint, { 1 } } });
+	builder.AddRecord("value {0}", { { GpuPrintfArg_Uint, { 2 } } });
+	builder.AddRecord("other");
+	for (Uint32 i = 0; i < 2; ++i) builder.AddRecord("value {0}", { { GpuPrintfArg_Uint, { 3 } } });
+	builder.AddRecord("value {0}", { { GpuPrintfArg_Uint, { 2 } } });
+	builder.AddRecord("other");
+
+	GpuPrintfFormatTable formats;
+	std::vector<GpuPrintfRecord> records;
+	Decode(builder.Finish(), formats, records);
+	ASSERT_EQ(records.size(), 9u);
+
+	std::vector<GpuPrintfLine> lines;
+	std::vector<GpuPrintfFormatStats> format_stats;
+	AggregateGpuPrintfRecords(records, GpuPrintfFilter{}, 2, lines, format_stats);
+
+	//lines keep the order in which they were first seen, value 3 is over the limit of two lines per format
+	ASSERT_EQ(lines.size(), 3u);
+	EXPECT_EQ(FormatGpuPrintfRecord(lines[0].record, formats.Get(lines[0].record.format_id)), "value 1");
+	EXPECT_EQ(lines[0].repeat_count, 3u);
+	EXPECT_EQ(FormatGpuPrintfRecord(lines[1].record, formats.Get(lines[1].record.format_id)), "value 2");
+	EXPECT_EQ(lines[1].repeat_count, 2u);
+	EXPECT_EQ(formats.Get(lines[2].record.format_id), "other");
+	EXPECT_EQ(lines[2].repeat_count, 2u);
+
+	ASSERT_EQ(format_stats.size(), 2u);
+	EXPECT_EQ(formats.Get(format_stats[0].format_id), "value {0}");
+	EXPECT_EQ(format_stats[0].record_count, 7u);
+	EXPECT_EQ(format_stats[0].suppressed_count, 2u);
+	EXPECT_EQ(format_stats[1].record_count, 2u);
+	EXPECT_EQ(format_stats[1].suppressed_count, 0u);
+
+	//filtered out records are not counted, the outputs are reset on every call
+	GpuPrintfFilter filter{};
+	filter.id[0] = 0;
+	AggregateGpuPrintfRecords(records, filter, 2, lines, format_stats);
+	EXPECT_TRUE(lines.empty());
+	EXPECT_TRUE(format_stats.empty());
+}
@@ -0,0 +1,248 @@
+#include "Utilities/Heightmap.h"
+#include "Utilities/ThreadPool.h"
+#include "Cpp/FastNoiseLite.h"
+
+using namespace adria;
+
+namespace
+{
+	class ThreadPoolScope
+	{
+	public:
+		explicit ThreadPoolScope(Uint pool_size = 0) { g_ThreadPool.Initialize(pool_size); }
+		~ThreadPoolScope() { g_ThreadPool.Shutdown(); }
+	};
+
+	HeightmapDesc MakeDesc(Uint32 width, Uint32 depth, NoiseType noise_type = NoiseType::Perlin, FractalType fractal_type = FractalType::FBM)
+	{
+		HeightmapDesc desc{};
+		desc.width = width;
+		desc.depth = depth;
+		desc.max_height = 100;
+		desc.noise_type = noise_type;
+		desc.fractal_type = fractal_type;
+		desc.octaves = 4;
+		return desc;
+	}
+
+	//the noise of every sample computed in order on one thread, the settings mirror the heightmap constructor
+	std::vector<Float> GenerateReferenceNoise(HeightmapDesc const& desc)
+	{
+		FastNoiseLite noise{};
+		noise.SetFractalType(desc.fractal_type == FractalType::FBM ? FastNoiseLite::FractalType_FBm :
+							 desc.fractal_type == FractalType::Ridged ? FastNoiseLite::FractalType_Ridged :
+							 desc.fractal_type == FractalType::PingPong ? FastNoiseLite::FractalType_PingPong : FastNoiseLite::FractalType_None);
+		noise.SetSeed(desc.seed);
+		noise.SetNoiseType(desc.noise_type == NoiseType::OpenSimplex2 || desc.noise_type == NoiseType::Cellular ? FastNoiseLite::NoiseType_OpenSimplex2 :
+						   desc.noise_type == NoiseType::OpenSimplex2S ? FastNoiseLite::NoiseType_OpenSimplex2S :
+						   desc.noise_type == NoiseType::ValueCubic ? FastNoiseLite::NoiseType_ValueCubic :
+						   desc.noise_type == NoiseType::Value ? FastNoiseLite::NoiseType_Value : FastNoiseLite::NoiseType_Perlin);
+		noise.SetFractalOctaves(desc.octaves);
+		noise.SetFractalLacunarity(desc.lacunarity);
+		noise.SetFractalGain(desc.persistence);
+		noise.SetFrequency(0.1f);
+
+		std::vector<Float> heights((Uint64)desc.width * desc.depth);
+		for (Uint64 z = 0; z < desc.depth; ++z)
+		{
+			for (Uint64 x = 0; x < desc.width; ++x)
+			{
+				Float const xf = x * desc.noise_scale / desc.width;
+				Float const zf = z * desc.noise_scale / desc.depth;
+				heights[z * desc.width + x] = noise.GetNoise(xf, zf) * desc.max_height;
+			}
+		}
+		return heights;
+	}
+
+	//bit-exact, the work split must never show up in the result
+	Bool HasHeights(Heightmap const& heightmap, std::vector<Float> const& heights)
+	{
+		return heightmap.Width() * heightmap.Depth() == heights.size() && memcmp(heightmap.Data(), heights.data(), heights.size() * sizeof(Float)) == 0;
+	}
+
+	Float64 SumHeights(Heightmap const& heightmap)
+	{
+		return std::accumulate(heightmap.Data(), heightmap.Data() + heightmap.Width() * heightmap.Depth(), 0.0);
+	}
+
+	Float MaxSlope(Heightmap const& heightmap)
+	{
+		Float max_slope = 0.0f;
+		for (Uint64 z = 0; z < heightmap.Depth(); ++z)
+		{
+			for (Uint64 x = 0; x < heightmap.Width(); ++x)
+			{
+				if (x + 1 < heightmap.Width()) max_slope = std::max(max_slope, std::abs(heightmap.HeightAt(x + 1, z) - heightmap.HeightAt(x, z)));
+				if (z + 1 < heightmap.Depth()) max_slope = std::max(max_slope, std::abs(heightmap.HeightAt(x, z + 1) - heightmap.HeightAt(x, z)));
+			}
+		}
+		return max_slope;
+	}
+
+	void WriteRaw(std::string const& path, std::vector<Uint16> const& samples)
+	{
+		std::ofstream file(path, std::ios::binary);
+		for (Uint16 sample : samples)
+		{
+			Char const bytes[] = { (Char)(sample & 0xff), (Char)(sample >> 8) };
+			file.write(bytes, sizeof(bytes));
+		}
+	}
+
+	//the samples of Data/Heightmaps/Gray16.png, a 4x3 16 bit grayscale png
+	constexpr Uint16 Gray16Samples[] = { 0, 1, 256, 257, 1000, 32767, 32768, 40000, 65000, 65533, 65534, 65535 };
+}
+
+ADRIA_TEST(Heightmap, GeneratedMatchesSerialReference)
+{
+	ThreadPoolScope thread_pool;
+	//sizes that are not multiples of the tile size, smaller than one tile and with a single row of tiles
+	HeightmapDesc const descs[] =
+	{
+		MakeDesc(300, 200),
+		MakeDesc(1000, 77, NoiseType::OpenSimplex2, FractalType::Ridged),
+		MakeDesc(65, 513, NoiseType::ValueCubic, FractalType::PingPong),
+		MakeDesc(17, 9, NoiseType::Value, FractalType::None),
+	};
+	for (HeightmapDesc const& desc : descs)
+	{
+		Heightmap const heightmap(desc);
+		EXPECT_EQ(heightmap.Width(), (Uint64)desc.width);
+		EXPECT_EQ(heightmap.Depth(), (Uint64)desc.depth);
+		EXPECT_TRUE(HasHeights(heightmap, GenerateReferenceNoise(desc)));
+	}
+}
+
+ADRIA_TEST(Heightmap, DeterministicAcrossThreadCounts)
+{
+	HeightmapDesc desc = MakeDesc(640, 384);
+	desc.thermal_erosion = ThermalErosionDesc{ .iterations = 8 };
+	desc.hydraulic_erosion = HydraulicErosionDesc{ .droplet_count = 2000 };
+
+	std::vector<Float> reference;
+	for (Uint pool_size : { 1u, 2u, 0u })
+	{
+		ThreadPoolScope thread_pool(pool_size);
+		Heightmap const heightmap(desc);
+		if (reference.empty())
+		{
+			reference.assign(heightmap.Data(), heightmap.Data() + heightmap.Width() * heightmap.Depth());
+			continue;
+		}
+		EXPECT_TRUE(HasHeights(heightmap, reference));
+	}
+}
+
+ADRIA_TEST(Heightmap, ThermalErosionMovesMaterialDownhill)
+{
+	ThreadPoolScope thread_pool;
+	Heightmap heightmap(MakeDesc(256, 192));
+	Float64 const sum_before = SumHeights(heightmap);
+	Float const slope_before = MaxSlope(heightmap);
+
+	heightmap.ApplyThermalErosion(ThermalErosionDesc{ .iterations = 50, .talus = 0.002f });
+	//material only moves between neighbors so the total stays the same, and the steepest slopes flatten
+	EXPECT_NEAR(SumHeights(heightmap), sum_before, std::abs(sum_before) * 1e-4 + 1e-2);
+	EXPECT_LT(MaxSlope(heightmap), slope_before);
+}
+
+ADRIA_TEST(Heightmap, HydraulicErosionIsSeeded)
+{
+	ThreadPoolScope thread_pool;
+	HeightmapDesc const desc = MakeDesc(128, 128);
+	Heightmap first(desc), second(desc), other_seed(desc);
+	first.ApplyHydraulicErosion(HydraulicErosionDesc{ .droplet_count = 1000 });
+	second.ApplyHydraulicErosion(HydraulicErosionDesc{ .droplet_count = 1000 });
+	other_seed.ApplyHydraulicErosion(HydraulicErosionDesc{ .droplet_count = 1000, .seed = 7 });
+
+	std::vector<Float> const heights(first.Data(), first.Data() + first.Width() * first.Depth());
+	EXPECT_TRUE(HasHeights(second, heights));
+	EXPECT_FALSE(HasHeights(other_seed, heights));
+	EXPECT_FALSE(HasHeights(Heightmap(desc), heights));
+}
+
+ADRIA_TEST(Heightmap, Loads16BitPng)
+{
+	Heightmap const heightmap(ADRIA_TESTS_DATA_DIR "Heightmaps/Gray16.png", 200.0f);
+	ASSERT_EQ(heightmap.Width(), 4u);
+	ASSERT_EQ(heightmap.Depth(), 3u);
+	for (Uint64 i = 0; i < std::size(Gray16Samples); ++i)
+	{
+		//neighboring 16 bit values stay distinct, an 8 bit load would merge them
+		EXPECT_EQ(heightmap.Data()[i], Gray16Samples[i] / 65535.0f * 200.0f);
+	}
+	EXPECT_EQ(heightmap.HeightAt(3, 2), 200.0f);
+	EXPECT_EQ(heightmap.HeightAt(0, 0), 0.0f);
+}
+
+ADRIA_TEST(Heightmap, LoadsRaw)
+{
+	test::TempDirectory temp_directory;
+	std::vector<Uint16> samples(9);
+	for (Uint16 i = 0; i < samples.size(); ++i) samples[i] = (Uint16)(i * 8191 + 1);
+
+	//square by default
+	std::string const raw_path = temp_directory.GetFilePath("square.raw");
+	WriteRaw(raw_path, samples);
+	Heightmap const square(raw_path, 10.0f);
+	ASSERT_EQ(square.Width(), 3u);
+	ASSERT_EQ(square.Depth(), 3u);
+	for (Uint64 i = 0; i < samples.size(); ++i) EXPECT_EQ(square.Data()[i], samples[i] / 65535.0f * 10.0f);
+
+	//little endian, 0x0102 must not be read as 0x0201
+	std::vector<Uint16> const wide_samples = { 0x0102, 0, 0, 0, 0, 0, 0, 0xffff };
+	std::string const r16_path = temp_directory.GetFilePath("wide.r16");
+	WriteRaw(r16_path, wide_samples);
+	Heightmap const wide(r16_path, 1.0f, 4);
+	ASSERT_EQ(wide.Width(), 4u);
+	ASSERT_EQ(wide.Depth(), 2u);
+	EXPECT_EQ(wide.HeightAt(0, 0), 0x0102 / 65535.0f);
+	EXPECT_EQ(wide.HeightAt(3, 1), 1.0f);
+}
+
+ADRIA_TEST(Heightmap, InvalidFilesFallBackToFlat)
+{
+	test::TempDirectory temp_directory;
+	std::string const not_square_path = temp_directory.GetFilePath("not_square.raw");
+	WriteRaw(not_square_path, std::vector<Uint16>(6, 1000));
+	std::string const missing_path = temp_directory.GetFilePath("missing.png");
+
+	for (std::string const& path : { not_square_path, missing_path })
+	{
+		test::LogCapture log_capture;
+		Heightmap const heightmap(path, 10.0f);
+		EXPECT_TRUE(log_capture.Contains("Failed to load heightmap"));
+		ASSERT_EQ(heightmap.Width(), 2u);
+		ASSERT_EQ(heightmap.Depth(), 2u);
+		for (Uint64 i = 0; i < 4; ++i) EXPECT_EQ(heightmap.Data()[i], 0.0f);
+	}
+}
+
+ADRIA_TEST(Heightmap, SampleHeightIsBilinear)
+{
+	Heightmap const heightmap(ADRIA_TESTS_DATA_DIR "Heightmaps/Gray16.png", 1.0f);
+	EXPECT_EQ(heightmap.SampleHeight(0.0f, 0.0f), heightmap.HeightAt(0, 0));
+	EXPECT_EQ(heightmap.SampleHeight(1.0f, 1.0f), heightmap.HeightAt(3, 2));
+	EXPECT_EQ(heightmap.SampleHeight(2.0f, -1.0f), heightmap.HeightAt(3, 0));
+	//u = 0.5 is halfway between the samples 1 and 2, v = 0.25 halfway between the rows 0 and 1
+	Float const expected = 0.25f * (heightmap.HeightAt(1, 0) + heightmap.HeightAt(2, 0) + heightmap.HeightAt(1, 1) + heightmap.HeightAt(2, 1));
+	EXPECT_NEAR(heightmap.SampleHeight(0.5f, 0.25f), expected, 1e-6f);
+}
+
+ADRIA_BENCHMARK(Heightmap, Generation2048)
+{
+	ThreadPoolScope thread_pool;
+	HeightmapDesc const desc = MakeDesc(2048, 2048);
+
+	Float64 const reference_ms = test::MeasureMilliseconds([&]() { GenerateReferenceNoise(desc); }, 3);
+	Float64 const tiled_ms = test::MeasureMilliseconds([&]() { Heightmap heightmap(desc); }, 3);
+	test::ReportBenchmark("serial noise", reference_ms);
+	test::ReportBenchmark("tiled noise", tiled_ms, std::to_string(reference_ms / tiled_ms) + "x");
+
+	Heightmap heightmap(MakeDesc(1024, 1024));
+	Float64 const thermal_ms = test::MeasureMilliseconds([&]() { heightmap.ApplyThermalErosion(ThermalErosionDesc{ .iterations = 20 }); }, 3);
+	test::ReportBenchmark("thermal erosion 1024^2, 20 iterations", thermal_ms);
+	Float64 const hydraulic_ms = test::MeasureMilliseconds([&]() { heightmap.ApplyHydraulicErosion(HydraulicErosionDesc{ .droplet_count = 20000 }); }, 3);
+	test::ReportBenchmark("hydraulic erosion 1024^2, 20000 droplets", hydraulic_ms);
+}
@@ -0,0 +1,158 @@
+#include "Tools/ImageCompare/ImageMetrics.h"
+#include "Utilities/Image.h"
+
+using namespace adria;
+
+namespace
+{
+	ImageRGB MakeUniformImage(Uint32 width, Uint32 height, Float r, Float g, Float b, Bool is_hdr = false)
+	{
+		ImageRGB image{ .width = width, .height = height, .is_hdr = is_hdr };
+		image.pixels.resize((Uint64)width * height * 3);
+		for (Uint64 i = 0; i < image.pixels.size(); i += 3)
+		{
+			image.pixels[i + 0] = r;
+			image.pixels[i + 1] = g;
+			image.pixels[i + 2] = b;
+		}
+		return image;
+	}
+
+	//gray ramp with a few hard edges so the ssim and flip feature terms have something to see
+	ImageRGB MakePatternImage(Uint32 width, Uint32 height)
+	{
+		ImageRGB image{ .width = width, .height = height };
+		image.pixels.resize((Uint64)width * height * 3);
+		for (Uint32 y = 0; y < height; ++y)
+		{
+			for (Uint32 x = 0; x < width; ++x)
+			{
+				Float const ramp = 0.1f + 0.6f * x / (width - 1);
+				Float const value = ((x / 8 + y / 8) % 2) ? ramp : 1.0f - ramp;
+				Float* rgb = &image.pixels[((Uint64)y * width + x) * 3];
+				rgb[0] = rgb[1] = rgb[2] = value;
+			}
+		}
+		return image;
+	}
+}
+
+ADRIA_TEST(ImageMetrics, IdenticalImages)
+{
+	ImageRGB const image = MakePatternImage(32, 32);
+	ImageCompareResult result;
+	ASSERT_TRUE(CompareImages(image, image, result));
+	EXPECT_EQ(result.metrics.rmse, 0.0f);
+	EXPECT_TRUE(std::isinf(result.metrics.psnr));
+	EXPECT_NEAR(result.metrics.ssim, 1.0f, 1e-5f);
+	EXPECT_EQ(result.metrics.flip_mean, 0.0f);
+	EXPECT_EQ(result.metrics.flip_max, 0.0f);
+	EXPECT_EQ(result.flip_error.size(), 32u * 32u);
+}
+
+ADRIA_TEST(ImageMetrics, RmseAndPsnr)
+{
+	//only the red channel is off by 0.1: rmse = sqrt(0.01 / 3), psnr = 20 * log10(1 / rmse)
+	ImageRGB const reference = MakePatternImage(16, 16);
+	ImageRGB test = reference;
+	for (Uint64 i = 0; i < test.pixels.size(); i += 3) test.pixels[i] += 0.1f;
+
+	ImageCompareResult result;
+	ASSERT_TRUE(CompareImages(reference, test, result));
+	EXPECT_NEAR(result.metrics.rmse, 0.0577350f, 1e-5f);
+	EXPECT_NEAR(result.metrics.psnr, 24.7712f, 1e-3f);
+
+	//hdr images use the largest reference value as the peak: 20 * log10(4 / 0.4) = 20
+	ImageRGB hdr_reference = MakeUniformImage(8, 8, 2.0f, 2.0f, 2.0f, true);
+	hdr_reference.pixels[0] = 4.0f;
+	ImageRGB hdr_test = hdr_reference;
+	for (Float& value : hdr_test.pixels) value += 0.4f;
+	ASSERT_TRUE(CompareImages(hdr_reference, hdr_test, result));
+	EXPECT_NEAR(result.metrics.rmse, 0.4f, 1e-5f);
+	EXPECT_NEAR(result.metrics.psnr, 20.0f, 1e-3f);
+}
+
+ADRIA_TEST(ImageMetrics, SsimOfUniformImages)
+{
+	//without variance ssim reduces to (2 * a * b + c1) / (a^2 + b^2 + c1) with c1 = 0.01^2
+	ImageRGB const reference = MakeUniformImage(16, 16, 0.5f, 0.5f, 0.5f);
+	ImageRGB const test = MakeUniformImage(16, 16, 0.6f, 0.6f, 0.6f);
+	ImageCompareResult result;
+	ASSERT_TRUE(CompareImages(reference, test, result));
+	EXPECT_NEAR(result.metrics.ssim, 0.983609f, 1e-4f);
+	EXPECT_NEAR(result.metrics.rmse, 0.1f, 1e-5f);
+
+	//structure that does not match lowers ssim far more than a brightness offset
+	ImageRGB const pattern = MakePatternImage(32, 32);
+	ImageRGB inverted = pattern;
+	for (Float& value : inverted.pixels) value = 1.0f - value;
+	ASSERT_TRUE(CompareImages(pattern, inverted, result));
+	EXPECT_LT(result.metrics.ssim, 0.0f);
+}
+
+ADRIA_TEST(ImageMetrics, FlipOfUniformImages)
+{
+	//uniform images have no features, the error is the compressed HyAB color distance of the two colors in Hunt-adjusted Lab
+	struct FlipCase
+	{
+		Float reference[3];
+		Float test[3];
+		Float expected;
+	};
+	FlipCase const cases[] =
+	{
+		{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }, 0.967384f },
+		{ { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, 0.986662f },
+	};
+	for (FlipCase const& flip_case : cases)
+	{
+		ImageRGB const reference = MakeUniformImage(16, 16, flip_case.reference[0], flip_case.reference[1], flip_case.reference[2]);
+		ImageRGB const test = MakeUniformImage(16, 16, flip_case.test[0], flip_case.test[1], flip_case.test[2]);
+		ImageCompareResult result;
+		ASSERT_TRUE(CompareImages(reference, test, result));
+		EXPECT_NEAR(result.metrics.flip_mean, flip_case.expected, 1e-3f);
+		EXPECT_NEAR(result.metrics.flip_max, flip_case.expected, 1e-3f);
+	}
+
+	//a shifted edge is an error only around the edge
+	ImageRGB const reference = MakePatternImage(32, 32);
+	ImageRGB shifted = reference;
+	for (Uint32 y = 0; y < 32; ++y)
+	{
+		for (Uint32 x = 31; x > 0; --x)
+		{
+			std::copy_n(&reference.pixels[((Uint64)y * 32 + x - 1) * 3], 3, &shifted.pixels[((Uint64)y * 32 + x) * 3]);
+		}
+	}
+	ImageCompareResult result;
+	ASSERT_TRUE(CompareImages(reference, shifted, result));
+	EXPECT_GT(result.metrics.flip_max, 0.1f);
+	EXPECT_LT(result.metrics.flip_mean, result.metrics.flip_max);
+	for (Float error : result.flip_error)
+	{
+		EXPECT_GE(error, 0.0f);
+		EXPECT_LE(error, 1.0f);
+	}
+}
+
+ADRIA_TEST(ImageMetrics, InvalidInputs)
+{
+	ImageCompareResult result;
+	EXPECT_FALSE(CompareImages(MakeUniformImage(4, 4, 0, 0, 0), MakeUniformImage(4, 5, 0, 0, 0), result));
+	EXPECT_FALSE(CompareImages(ImageRGB{}, ImageRGB{}, result));
+
+	//formats the comparison does not decode are rejected
+	ImageRGB rgb;
+	EXPECT_FALSE(ConvertToImageRGB(Image(GfxFormat::BC1_UNORM), rgb));
+	EXPECT_FALSE(ConvertToImageRGB(Image(GfxFormat::UNKNOWN), rgb));
+	EXPECT_TRUE(ConvertToImageRGB(Image(GfxFormat::R16G16B16A16_FLOAT), rgb));
+	EXPECT_TRUE(rgb.is_hdr);
+}
+
+ADRIA_TEST(ImageMetrics, Heatmap)
+{
+	Float const errors[] = { 0.0f, 1.0f, 2.0f };
+	std::vector<Uint8> rgba8;
+	CreateErrorHeatmap(errors, rgba8);
+	EXPECT_EQ(rgba8, (std::vector<Uint8>{ 0, 0, 4, 255, 252, 253, 191, 255, 252, 253, 191, 255 }));
+}
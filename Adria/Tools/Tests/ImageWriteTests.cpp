@@ -0,0 +1,172 @@
+#include "Utilities/ImageWrite.h"
+#include "Utilities/FloatCompressor.h"
+#include "Utilities/Image.h"
+
+using namespace adria;
+
+namespace
+{
+	constexpr Uint32 RowPitchAlignment = 256;
+	constexpr Uint8 PaddingByte = 0xcd;
+
+	//rows padded to 256 bytes like a texture readback, the padding is filled with garbage
+	template<typename T>
+	std::vector<Uint8> MakePitchedImage(std::vector<T> const& pixels, Uint32 width, Uint32 height, Uint32& row_pitch)
+	{
+		Uint32 const row_size = (Uint32)(width * 4 * sizeof(T));
+		row_pitch = (row_size + RowPitchAlignment - 1) / RowPitchAlignment * RowPitchAlignment;
+
+		std::vector<Uint8> data((Uint64)row_pitch * height, PaddingByte);
+		for (Uint32 y = 0; y < height; ++y)
+		{
+			memcpy(data.data() + (Uint64)y * row_pitch, pixels.data() + (Uint64)y * width * 4, row_size);
+		}
+		return data;
+	}
+
+	std::vector<Uint8> MakeGradient(Uint32 width, Uint32 height)
+	{
+		std::vector<Uint8> pixels((Uint64)width * height * 4);
+		for (Uint32 y = 0; y < height; ++y)
+		{
+			for (Uint32 x = 0; x < width; ++x)
+			{
+				Uint8* pixel = &pixels[((Uint64)y * width + x) * 4];
+				pixel[0] = (Uint8)(x * 7);
+				pixel[1] = (Uint8)(y * 31);
+				pixel[2] = (Uint8)(x + y);
+				pixel[3] = (Uint8)(255 - x);
+			}
+		}
+		return pixels;
+	}
+
+	std::vector<Uint16> CompressToHalf(std::vector<Float> const& values)
+	{
+		std::vector<Uint16> halfs(values.size());
+		for (Uint64 i = 0; i < values.size(); ++i) halfs[i] = FloatCompressor::Compress(values[i]);
+		return halfs;
+	}
+}
+
+ADRIA_TEST(ImageWrite, UnpackSkipsRowPadding)
+{
+	Uint32 const width = 37, height = 5;
+	std::vector<Uint8> const pixels = MakeGradient(width, height);
+	Uint32 row_pitch = 0;
+	std::vector<Uint8> const data = MakePitchedImage(pixels, width, height, row_pitch);
+	EXPECT_GT(row_pitch, width * 4);
+
+	std::vector<Uint8> rgba8;
+	UnpackImageRows(data.data(), width, height, row_pitch, ImageDataFormat::RGBA8, rgba8);
+	EXPECT_TRUE(rgba8 == pixels);
+
+	std::vector<Float> rgba32f;
+	UnpackImageRows(data.data(), width, height, row_pitch, ImageDataFormat::RGBA8, rgba32f);
+	ASSERT_EQ(rgba32f.size(), pixels.size());
+	for (Uint64 i = 0; i < pixels.size(); ++i) EXPECT_EQ(rgba32f[i], pixels[i] / 255.0f);
+}
+
+ADRIA_TEST(ImageWrite, FloatsAreClampedToUnorm8)
+{
+	//one pixel per row, so every row has padding
+	std::vector<Float> const values = { -1.0f, 0.0f, 0.5f, 1.0f, 2.0f, 1000.0f, 0.25f, 0.75f };
+	std::vector<Uint8> const expected = { 0, 0, 128, 255, 255, 255, 64, 191 };
+	Uint32 const width = 1, height = 2;
+
+	Uint32 row_pitch = 0;
+	std::vector<Uint8> const rgba32f_data = MakePitchedImage(values, width, height, row_pitch);
+	std::vector<Uint8> rgba8;
+	UnpackImageRows(rgba32f_data.data(), width, height, row_pitch, ImageDataFormat::RGBA32F, rgba8);
+	EXPECT_TRUE(rgba8 == expected);
+
+	std::vector<Uint8> const rgba16f_data = MakePitchedImage(CompressToHalf(values), width, height, row_pitch);
+	UnpackImageRows(rgba16f_data.data(), width, height, row_pitch, ImageDataFormat::RGBA16F, rgba8);
+	EXPECT_TRUE(rgba8 == expected);
+
+	//the float unpack keeps the values, all of them are exact in half precision
+	std::vector<Float> rgba32f;
+	UnpackImageRows(rgba16f_data.data(), width, height, row_pitch, ImageDataFormat::RGBA16F, rgba32f);
+	EXPECT_TRUE(rgba32f == values);
+	UnpackImageRows(rgba32f_data.data(), width, height, row_pitch, ImageDataFormat::RGBA32F, rgba32f);
+	EXPECT_TRUE(rgba32f == values);
+
+	std::vector<Float> const special_values = { std::numeric_limits<Float>::quiet_NaN(), std::numeric_limits<Float>::infinity(), -std::numeric_limits<Float>::infinity(), 0.1f };
+	std::vector<Uint8> const special_data = MakePitchedImage(special_values, 1, 1, row_pitch);
+	UnpackImageRows(special_data.data(), 1, 1, row_pitch, ImageDataFormat::RGBA32F, rgba8);
+	ASSERT_EQ(rgba8.size(), 4u);
+	EXPECT_EQ(rgba8[0], 0);
+	EXPECT_EQ(rgba8[1], 255);
+	EXPECT_EQ(rgba8[2], 0);
+	EXPECT_EQ(rgba8[3], 26);
+}
+
+ADRIA_TEST(ImageWrite, PngRoundTripThroughRowPitch)
+{
+	test::TempDirectory temp_directory;
+	Uint32 const width = 45, height = 9;
+	std::vector<Uint8> const pixels = MakeGradient(width, height);
+	Uint32 row_pitch = 0;
+	std::vector<Uint8> const data = MakePitchedImage(pixels, width, height, row_pitch);
+
+	//png takes the row pitch as its stride, tga goes through a tightly packed copy
+	for (FileType type : { FileType::PNG, FileType::TGA })
+	{
+		std::string const path = temp_directory.GetFilePath(std::string("gradient") + GetFileTypeExtension(type));
+		ASSERT_TRUE(WriteImageToFile(type, path, width, height, data.data(), row_pitch));
+
+		Image const image(path);
+		ASSERT_EQ(image.Width(), width);
+		ASSERT_EQ(image.Height(), height);
+		EXPECT_FALSE(image.IsHDR());
+		EXPECT_TRUE(std::equal(pixels.begin(), pixels.end(), image.Data<Uint8>()));
+	}
+}
+
+ADRIA_TEST(ImageWrite, PngFromFloatsIsClamped)
+{
+	test::TempDirectory temp_directory;
+	std::vector<Float> const values = { -1.0f, 0.5f, 4.0f, 1.0f, 0.25f, 0.0f, 1.0f, 0.75f };
+	Uint32 const width = 2, height = 1;
+	Uint32 row_pitch = 0;
+	std::vector<Uint8> const data = MakePitchedImage(CompressToHalf(values), width, height, row_pitch);
+
+	std::string const path = temp_directory.GetFilePath("clamped.png");
+	ASSERT_TRUE(WriteImageToFile(FileType::PNG, path, width, height, data.data(), row_pitch, ImageDataFormat::RGBA16F));
+
+	Image const image(path);
+	ASSERT_EQ(image.Width(), width);
+	std::vector<Uint8> const expected = { 0, 128, 255, 255, 64, 0, 255, 191 };
+	EXPECT_TRUE(std::equal(expected.begin(), expected.end(), image.Data<Uint8>()));
+}
+
+ADRIA_TEST(ImageWrite, HdrKeepsValuesAboveOne)
+{
+	test::TempDirectory temp_directory;
+	Uint32 const width = 19, height = 3;
+	std::vector<Float> values((Uint64)width * height * 4);
+	for (Uint64 i = 0; i < values.size(); ++i) values[i] = (i % 4 == 3) ? 1.0f : 0.125f * (Float)(i % 97);
+
+	for (ImageDataFormat format : { ImageDataFormat::RGBA16F, ImageDataFormat::RGBA32F })
+	{
+		Uint32 row_pitch = 0;
+		std::vector<Uint8> const data = format == ImageDataFormat::RGBA16F ? MakePitchedImage(CompressToHalf(values), width, height, row_pitch) : MakePitchedImage(values, width, height, row_pitch);
+
+		std::string const path = temp_directory.GetFilePath("values.hdr");
+		ASSERT_TRUE(WriteImageToFile(FileType::HDR, path, width, height, data.data(), row_pitch, format));
+
+		Image const image(path);
+		ASSERT_TRUE(image.IsHDR());
+		ASSERT_EQ(image.Width(), width);
+		ASSERT_EQ(image.Height(), height);
+
+		//rgbe shares one exponent between the channels of a pixel, the error is relative to the largest one
+		Float const* loaded = image.Data<Float>();
+		for (Uint64 pixel = 0; pixel < (Uint64)width * height; ++pixel)
+		{
+			Float const* expected = &values[pixel * 4];
+			Float const tolerance = std::max({ expected[0], expected[1], expected[2] }) / 128.0f + 1e-6f;
+			for (Uint32 c = 0; c < 3; ++c) EXPECT_NEAR(loaded[pixel * 4 + c], expected[c], tolerance);
+		}
+	}
+}
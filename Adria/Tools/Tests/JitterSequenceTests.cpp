@@ -0,0 +1,197 @@
+#include "Math/JitterSequence.h"
+
+using namespace adria;
+
+namespace
+{
+	constexpr Uint32 PhaseCounts[] = { 8, 16, 32, 64 };
+
+	//star discrepancy of the offsets moved to [0, 1)^2, every anchored box with corners at the point coordinates is tested
+	//with the points on its border both included and excluded, which gives the exact value
+	Float64 StarDiscrepancy(std::vector<Vector2> const& offsets)
+	{
+		std::vector<Float64> xs{ 1.0 }, ys{ 1.0 };
+		for (Vector2 const& offset : offsets)
+		{
+			xs.push_back(offset.x + 0.5);
+			ys.push_back(offset.y + 0.5);
+		}
+
+		Float64 const count = (Float64)offsets.size();
+		Float64 discrepancy = 0.0;
+		for (Float64 x : xs)
+		{
+			for (Float64 y : ys)
+			{
+				Uint32 open_count = 0, closed_count = 0;
+				for (Vector2 const& offset : offsets)
+				{
+					Float64 const px = offset.x + 0.5, py = offset.y + 0.5;
+					if (px < x && py < y) ++open_count;
+					if (px <= x && py <= y) ++closed_count;
+				}
+				Float64 const area = x * y;
+				discrepancy = std::max(discrepancy, area - open_count / count);
+				discrepancy = std::max(discrepancy, closed_count / count - area);
+			}
+		}
+		return discrepancy;
+	}
+
+	Float MinToroidalDistance(std::vector<Vector2> const& offsets)
+	{
+		Float min_distance = FLT_MAX;
+		for (Uint64 i = 0; i < offsets.size(); ++i)
+		{
+			for (Uint64 j = i + 1; j < offsets.size(); ++j)
+			{
+				Float dx = std::abs(offsets[i].x - offsets[j].x);
+				Float dy = std::abs(offsets[i].y - offsets[j].y);
+				dx = std::min(dx, 1.0f - dx);
+				dy = std::min(dy, 1.0f - dy);
+				min_distance = std::min(min_distance, std::sqrt(dx * dx + dy * dy));
+			}
+		}
+		return min_distance;
+	}
+
+	std::vector<Vector2> GenerateRandomJitter(Uint32 count)
+	{
+		std::mt19937 rng(7);
+		auto Random = [&rng]() { return (Float)(rng() >> 8) / (Float)(1u << 24); };
+		std::vector<Vector2> offsets(count);
+		for (Vector2& offset : offsets) offset = Vector2(Random() - 0.5f, Random() - 0.5f);
+		return offsets;
+	}
+
+	std::vector<Vector2> Generate(JitterSequenceType type, Uint32 count)
+	{
+		switch (type)
+		{
+		case JitterSequenceType::R2: return GenerateR2Jitter(count);
+		case JitterSequenceType::BlueNoise: return GenerateBlueNoiseJitter(count);
+		case JitterSequenceType::Halton:
+		default:
+			return GenerateHaltonJitter(count);
+		}
+	}
+}
+
+ADRIA_TEST(JitterSequence, UpscalerPhaseCount)
+{
+	EXPECT_EQ(GetUpscalerJitterPhaseCount(1920, 1920), 8u);
+	EXPECT_EQ(GetUpscalerJitterPhaseCount(1280, 1920), 18u);
+	EXPECT_EQ(GetUpscalerJitterPhaseCount(960, 1920), 32u);
+	EXPECT_EQ(GetUpscalerJitterPhaseCount(640, 1920), 72u);
+	EXPECT_EQ(GetUpscalerJitterPhaseCount(960, 1920, 4), 16u);
+	//no upscaling or an unknown render resolution fall back to the base count
+	EXPECT_EQ(GetUpscalerJitterPhaseCount(1920, 1280), 8u);
+	EXPECT_EQ(GetUpscalerJitterPhaseCount(0, 1920), 8u);
+}
+
+ADRIA_TEST(JitterSequence, PhaseCountFollowsDesc)
+{
+	JitterSequence sequence;
+	EXPECT_EQ(sequence.GetPhaseCount(), JitterSequenceDesc{}.phase_count);
+
+	for (JitterSequenceType type : { JitterSequenceType::Halton, JitterSequenceType::R2, JitterSequenceType::BlueNoise })
+	{
+		for (Uint32 phase_count : PhaseCounts)
+		{
+			sequence.SetDesc(JitterSequenceDesc{ .type = type, .phase_count = phase_count });
+			EXPECT_EQ(sequence.GetPhaseCount(), phase_count);
+			EXPECT_TRUE(sequence.GetDesc().type == type);
+
+			//the sequence repeats after phase_count frames
+			std::vector<Vector2> const offsets = Generate(type, phase_count);
+			for (Uint64 frame = 0; frame < 2 * phase_count; ++frame)
+			{
+				Vector2 const offset = sequence[frame];
+				EXPECT_EQ(offset.x, offsets[frame % phase_count].x);
+				EXPECT_EQ(offset.y, offsets[frame % phase_count].y);
+			}
+		}
+	}
+
+	//a zero phase count still gives one phase
+	sequence.SetDesc(JitterSequenceDesc{ .type = JitterSequenceType::R2, .phase_count = 0 });
+	EXPECT_EQ(sequence.GetPhaseCount(), 1u);
+	EXPECT_EQ(sequence.GetDesc().phase_count, 1u);
+}
+
+ADRIA_TEST(JitterSequence, OffsetsAreSubpixel)
+{
+	for (JitterSequenceType type : { JitterSequenceType::Halton, JitterSequenceType::R2, JitterSequenceType::BlueNoise })
+	{
+		for (Vector2 const& offset : Generate(type, 256))
+		{
+			EXPECT_GE(offset.x, -0.5f);
+			EXPECT_LT(offset.x, 0.5f);
+			EXPECT_GE(offset.y, -0.5f);
+			EXPECT_LT(offset.y, 0.5f);
+		}
+	}
+}
+
+ADRIA_TEST(JitterSequence, HaltonKnownValues)
+{
+	//bases 2 and 3 starting at index 1
+	std::vector<Vector2> const offsets = GenerateHaltonJitter(4);
+	EXPECT_NEAR(offsets[0].x, 0.0f, 1e-6f);
+	EXPECT_NEAR(offsets[0].y, 1.0f / 3.0f - 0.5f, 1e-6f);
+	EXPECT_NEAR(offsets[1].x, -0.25f, 1e-6f);
+	EXPECT_NEAR(offsets[1].y, 2.0f / 3.0f - 0.5f, 1e-6f);
+	EXPECT_NEAR(offsets[2].x, 0.25f, 1e-6f);
+	EXPECT_NEAR(offsets[2].y, 1.0f / 9.0f - 0.5f, 1e-6f);
+	EXPECT_NEAR(offsets[3].x, -0.375f, 1e-6f);
+	EXPECT_NEAR(offsets[3].y, 4.0f / 9.0f - 0.5f, 1e-6f);
+}
+
+ADRIA_TEST(JitterSequence, LowDiscrepancy)
+{
+	//the quasirandom sequences stay below log(n)^2 / n
+	for (Uint32 phase_count : { 16u, 64u, 256u })
+	{
+		Float64 const log_bound = std::log((Float64)phase_count) * std::log((Float64)phase_count) / phase_count;
+		EXPECT_LT(StarDiscrepancy(GenerateHaltonJitter(phase_count)), log_bound);
+		EXPECT_LT(StarDiscrepancy(GenerateR2Jitter(phase_count)), log_bound);
+	}
+
+	//random points only converge with 1 / sqrt(n), once there are enough phases every sequence beats them
+	for (Uint32 phase_count : { 64u, 256u })
+	{
+		Float64 const random_discrepancy = StarDiscrepancy(GenerateRandomJitter(phase_count));
+		EXPECT_LT(StarDiscrepancy(GenerateHaltonJitter(phase_count)), random_discrepancy);
+		EXPECT_LT(StarDiscrepancy(GenerateR2Jitter(phase_count)), random_discrepancy);
+		EXPECT_LT(StarDiscrepancy(GenerateBlueNoiseJitter(phase_count)), random_discrepancy);
+	}
+}
+
+ADRIA_TEST(JitterSequence, BlueNoiseIsSpreadAndDeterministic)
+{
+	for (Uint32 phase_count : PhaseCounts)
+	{
+		std::vector<Vector2> const offsets = GenerateBlueNoiseJitter(phase_count);
+		std::vector<Vector2> const same_seed_offsets = GenerateBlueNoiseJitter(phase_count);
+		for (Uint32 i = 0; i < phase_count; ++i)
+		{
+			EXPECT_EQ(offsets[i].x, same_seed_offsets[i].x);
+			EXPECT_EQ(offsets[i].y, same_seed_offsets[i].y);
+		}
+		EXPECT_GT(MinToroidalDistance(offsets), MinToroidalDistance(GenerateRandomJitter(phase_count)));
+	}
+
+	std::vector<Vector2> const offsets = GenerateBlueNoiseJitter(16, 0);
+	std::vector<Vector2> const other_seed_offsets = GenerateBlueNoiseJitter(16, 1);
+	Bool differs = false;
+	for (Uint32 i = 0; i < 16; ++i) differs |= offsets[i].x != other_seed_offsets[i].x || offsets[i].y != other_seed_offsets[i].y;
+	EXPECT_TRUE(differs);
+
+	//every prefix of the set is evenly spread, so a shorter sequence is the start of a longer one
+	std::vector<Vector2> const longer_offsets = GenerateBlueNoiseJitter(32, 0);
+	for (Uint32 i = 0; i < 16; ++i)
+	{
+		EXPECT_EQ(offsets[i].x, longer_offsets[i].x);
+		EXPECT_EQ(offsets[i].y, longer_offsets[i].y);
+	}
+}
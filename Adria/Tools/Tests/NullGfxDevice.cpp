@@ -0,0 +1,137 @@
+#include "NullGfxDevice.h"
+#include "Graphics/GfxDevice.h"
+#include "Graphics/GfxBuffer.h"
+#include "Graphics/GfxTexture.h"
+#include "Graphics/GfxCommandList.h"
+#include "Rendering/GeometryBufferCache.h"
+
+//the device functions the compile side of the render graph and the acceleration structures link against,
+//they are called through a null device and command list and only record what they were asked to do
+namespace adria
+{
+	namespace test
+	{
+		NullGfxDeviceRecord& GetNullGfxDeviceRecord()
+		{
+			static NullGfxDeviceRecord record;
+			return record;
+		}
+
+		void ResetNullGfxDeviceRecord()
+		{
+			GetNullGfxDeviceRecord() = NullGfxDeviceRecord{};
+		}
+
+		void CompleteNullGfxDeviceWork()
+		{
+			NullGfxDeviceRecord& record = GetNullGfxDeviceRecord();
+			record.completed_fence_value = record.signaled_fence_value;
+		}
+	}
+
+	void GfxDevice::FreeDescriptorCPU(GfxDescriptor, GfxDescriptorHeapType) {}
+	GfxDescriptor GfxDevice::CreateBufferSRV(GfxBuffer const*, GfxBufferDescriptorDesc const*) { return {}; }
+	GfxDescriptor GfxDevice::CreateBufferUAV(GfxBuffer const*, GfxBufferDescriptorDesc const*) { return {}; }
+	GfxDescriptor GfxDevice::CreateBufferUAV(GfxBuffer const*, GfxBuffer const*, GfxBufferDescriptorDesc const*) { return {}; }
+	GfxDescriptor GfxDevice::CreateTextureSRV(GfxTexture const*, GfxTextureDescriptorDesc const*) { return {}; }
+	GfxDescriptor GfxDevice::CreateTextureUAV(GfxTexture const*, GfxTextureDescriptorDesc const*) { return {}; }
+	GfxDescriptor GfxDevice::CreateTextureRTV(GfxTexture const*, GfxTextureDescriptorDesc const*) { return {}; }
+	GfxDescriptor GfxDevice::CreateTextureDSV(GfxTexture const*, GfxTextureDescriptorDesc const*) { return {}; }
+
+	GfxDescriptor GfxDevice::AllocateDescriptorsGPU(Uint32) { return {}; }
+	void GfxDevice::CopyDescriptors(Uint32, GfxDescriptor, GfxDescriptor, GfxDescriptorHeapType) {}
+
+	GfxCommandList* GfxDevice::GetGraphicsCommandList() const { return nullptr; }
+	std::unique_ptr<GfxBuffer> GfxDevice::CreateBuffer(GfxBufferDesc const& desc) { return std::make_unique<GfxBuffer>(this, desc); }
+	std::unique_ptr<GfxRayTracingTLAS> GfxDevice::CreateRayTracingTLAS(std::span<GfxRayTracingInstance> instances, GfxRayTracingASFlags flags)
+	{
+		return std::make_unique<GfxRayTracingTLAS>(this, instances, flags);
+	}
+	std::unique_ptr<GfxRayTracingBLAS> GfxDevice::CreateRayTracingBLAS(std::span<GfxRayTracingGeometry> geometries, GfxRayTracingASFlags flags)
+	{
+		return std::make_unique<GfxRayTracingBLAS>(this, geometries, flags);
+	}
+	std::unique_ptr<GfxRayTracingBLAS> GfxDevice::CreateRayTracingBLAS(GfxRayTracingBLAS const& source, Uint64 compacted_size)
+	{
+		return std::make_unique<GfxRayTracingBLAS>(this, source, compacted_size);
+	}
+
+	void GfxTexture::SetName(Char const*) {}
+
+	//the contents live in cpu memory, so copies and readbacks of the null device still work
+	GfxBuffer::GfxBuffer(GfxDevice* gfx, GfxBufferDesc const& desc, GfxBufferData) : gfx(gfx), desc(desc)
+	{
+		mapped_data = new Uint8[desc.size]();
+		++test::GetNullGfxDeviceRecord().live_buffer_count;
+	}
+	GfxBuffer::~GfxBuffer()
+	{
+		delete[] static_cast<Uint8*>(mapped_data);
+		--test::GetNullGfxDeviceRecord().live_buffer_count;
+	}
+	GfxBufferDesc const& GfxBuffer::GetDesc() const { return desc; }
+	Uint64 GfxBuffer::GetSize() const { return desc.size; }
+	void GfxBuffer::SetName(Char const*) {}
+
+	void GfxCommandList::Signal(GfxFence&, Uint64 value) { test::GetNullGfxDeviceRecord().signaled_fence_value = value; }
+	void GfxCommandList::BufferBarrier(GfxBuffer const&, GfxResourceState, GfxResourceState) {}
+	void GfxCommandList::GlobalBarrier(GfxResourceState, GfxResourceState) {}
+	void GfxCommandList::FlushBarriers() {}
+	void GfxCommandList::CopyBuffer(GfxBuffer& dst, GfxBuffer const& src)
+	{
+		memcpy(dst.GetMappedData<Uint8>(), src.GetMappedData<Uint8>(), std::min(dst.GetSize(), src.GetSize()));
+	}
+	void GfxCommandList::CopyTexture(GfxTexture&, GfxTexture const&) {}
+
+	GfxFence::GfxFence() {}
+	GfxFence::~GfxFence() {}
+	Bool GfxFence::Create(GfxDevice*, Char const*) { return true; }
+	Bool GfxFence::IsCompleted(Uint64 value) { return value <= test::GetNullGfxDeviceRecord().completed_fence_value; }
+
+	GfxRayTracingBLAS::GfxRayTracingBLAS(GfxDevice* gfx, std::span<GfxRayTracingGeometry> geometries, GfxRayTracingASFlags)
+	{
+		GfxBufferDesc buffer_desc{};
+		buffer_desc.size = test::NullBLASSizePerGeometry * geometries.size();
+		scratch_buffer = gfx->CreateBuffer(buffer_desc);
+		result_buffer = gfx->CreateBuffer(buffer_desc);
+		test::GetNullGfxDeviceRecord().live_blases[this] = { .geometries = { geometries.begin(), geometries.end() }, .compacted = false };
+	}
+	GfxRayTracingBLAS::GfxRayTracingBLAS(GfxDevice* gfx, GfxRayTracingBLAS const& source, Uint64 compacted_size)
+	{
+		GfxBufferDesc buffer_desc{};
+		buffer_desc.size = compacted_size;
+		result_buffer = gfx->CreateBuffer(buffer_desc);
+		test::NullGfxDeviceRecord& record = test::GetNullGfxDeviceRecord();
+		record.live_blases[this] = { .geometries = record.live_blases[&source].geometries, .compacted = true };
+	}
+	GfxRayTracingBLAS::~GfxRayTracingBLAS()
+	{
+		test::GetNullGfxDeviceRecord().live_blases.erase(this);
+	}
+	Uint64 GfxRayTracingBLAS::GetSize() const { return result_buffer->GetSize(); }
+
+	void EmitRayTracingBLASCompactedSizes(GfxCommandList*, std::span<GfxRayTracingBLAS const*> blases, GfxBuffer const& postbuild_buffer)
+	{
+		Uint64* compacted_sizes = postbuild_buffer.GetMappedData<Uint64>();
+		for (Uint64 i = 0; i < blases.size(); ++i) compacted_sizes[i] = blases[i]->GetSize() / 2;
+	}
+
+	GfxRayTracingTLAS::GfxRayTracingTLAS(GfxDevice* gfx, std::span<GfxRayTracingInstance> instances, GfxRayTracingASFlags)
+	{
+		GfxBufferDesc buffer_desc{};
+		buffer_desc.size = 64 * instances.size();
+		scratch_buffer = gfx->CreateBuffer(buffer_desc);
+		result_buffer = gfx->CreateBuffer(buffer_desc);
+
+		test::NullGfxDeviceRecord& record = test::GetNullGfxDeviceRecord();
+		record.tlas_instances.clear();
+		for (GfxRayTracingInstance const& instance : instances)
+		{
+			record.tlas_instances.push_back({ .blas = instance.blas, .instance_id = instance.instance_id });
+		}
+	}
+	GfxRayTracingTLAS::~GfxRayTracingTLAS() = default;
+
+	GeometryBufferHandle::~GeometryBufferHandle() {}
+	GfxBuffer* GeometryBufferCache::GetGeometryBuffer(GeometryBufferHandle&) const { return nullptr; }
+}
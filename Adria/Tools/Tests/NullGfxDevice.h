@@ -0,0 +1,34 @@
+#pragma once
+#include "Graphics/GfxRayTracingAS.h"
+
+namespace adria::test
+{
+	//the null device sizes every BLAS by its geometry count and reports half of it as the compacted size
+	inline constexpr Uint64 NullBLASSizePerGeometry = 1024;
+
+	//what the device functions of NullGfxDevice.cpp were asked to do, the device itself is a null pointer
+	struct NullGfxDeviceRecord
+	{
+		struct BLASRecord
+		{
+			std::vector<GfxRayTracingGeometry> geometries;
+			Bool compacted = false;
+		};
+		struct TLASInstanceRecord
+		{
+			GfxRayTracingBLAS const* blas;
+			Uint32 instance_id;
+		};
+
+		std::unordered_map<GfxRayTracingBLAS const*, BLASRecord> live_blases;
+		std::vector<TLASInstanceRecord> tlas_instances;
+		Int64 live_buffer_count = 0;
+		Uint64 signaled_fence_value = 0;
+		Uint64 completed_fence_value = 0;
+	};
+
+	NullGfxDeviceRecord& GetNullGfxDeviceRecord();
+	void ResetNullGfxDeviceRecord();
+	//the gpu catches up with every fence value signaled so far
+	void CompleteNullGfxDeviceWork();
+}
@@ -0,0 +1,178 @@
+#include "RenderGraph/RenderGraph.h"
+#include "Utilities/Json.h"
+
+using namespace adria;
+
+namespace
+{
+	struct WritePassData
+	{
+		RGTextureReadWriteId output;
+		RGBufferReadWriteId counts;
+	};
+	struct ReadWritePassData
+	{
+		RGTextureReadOnlyId input;
+		RGTextureReadWriteId output;
+	};
+	struct ReadPassData
+	{
+		RGTextureReadOnlyId input;
+		RGBufferReadOnlyId counts;
+	};
+
+	RGTextureDesc MakeTextureDesc()
+	{
+		RGTextureDesc desc{};
+		desc.width = 64;
+		desc.height = 32;
+		desc.format = GfxFormat::R8G8B8A8_UNORM;
+		return desc;
+	}
+
+	//texture 0 is written by pass 0 and read by pass 1, texture 1 is written by pass 1 and read by pass 3,
+	//pass 2 writes texture 2 that nobody reads so it is culled, buffer 0 is written by pass 0 and read by pass 3
+	void AddTestPasses(RenderGraph& rg)
+	{
+		rg.AddPass<WritePassData>("Write Pass",
+			[=](WritePassData& data, RenderGraphBuilder& builder)
+			{
+				builder.DeclareTexture(RG_NAME(TextureA), MakeTextureDesc());
+				data.output = builder.WriteTexture(RG_NAME(TextureA));
+
+				RGBufferDesc buffer_desc{};
+				buffer_desc.stride = sizeof(Uint32);
+				buffer_desc.size = buffer_desc.stride * 256;
+				builder.DeclareBuffer(RG_NAME(CountsBuffer), buffer_desc);
+				data.counts = builder.WriteBuffer(RG_NAME(CountsBuffer));
+			},
+			[=](WritePassData const&, RenderGraphContext&) {}, RGPassType::Compute);
+
+		rg.AddPass<ReadWritePassData>("Read Write Pass",
+			[=](ReadWritePassData& data, RenderGraphBuilder& builder)
+			{
+				data.input = builder.ReadTexture(RG_NAME(TextureA));
+				builder.DeclareTexture(RG_NAME(TextureB), MakeTextureDesc());
+				data.output = builder.WriteTexture(RG_NAME(TextureB));
+			},
+			[=](ReadWritePassData const&, RenderGraphContext&) {}, RGPassType::Compute);
+
+		rg.AddPass<WritePassData>("Unused Pass",
+			[=](WritePassData& data, RenderGraphBuilder& builder)
+			{
+				builder.DeclareTexture(RG_NAME(TextureC), MakeTextureDesc());
+				data.output = builder.WriteTexture(RG_NAME(TextureC));
+			},
+			[=](WritePassData const&, RenderGraphContext&) {}, RGPassType::Compute);
+
+		rg.AddPass<ReadPassData>("Final Pass",
+			[=](ReadPassData& data, RenderGraphBuilder& builder)
+			{
+				data.input = builder.ReadTexture(RG_NAME(TextureB));
+				data.counts = builder.ReadBuffer(RG_NAME(CountsBuffer));
+			},
+			[=](ReadPassData const&, RenderGraphContext&) {}, RGPassType::Compute, RGPassFlags::ForceNoCull);
+	}
+
+	json CompileAndExport(test::TempDirectory const& temp_directory)
+	{
+		RGResourcePool pool(nullptr);
+		RenderGraph rg(pool);
+		AddTestPasses(rg);
+		rg.Compile();
+
+		std::string const json_path = temp_directory.GetFilePath("rendergraph.json");
+		rg.DumpJson(json_path.c_str());
+		std::ifstream json_file(json_path);
+		return json::parse(json_file, nullptr, false);
+	}
+
+	json const* FindLevelOfPass(json const& graph, Uint64 pass_id)
+	{
+		for (json const& level : graph["dependency_levels"])
+		{
+			for (json const& level_pass : level["passes"])
+			{
+				if (level_pass.get<Uint64>() == pass_id) return &level;
+			}
+		}
+		return nullptr;
+	}
+
+	Bool HasBarrier(json const& level, std::string const& resource_type, Uint64 resource, GfxResourceState before, GfxResourceState after, std::string const& stage)
+	{
+		for (json const& barrier : level["barriers"])
+		{
+			if (barrier["resource_type"] == resource_type && barrier["resource"] == resource && barrier["stage"] == stage &&
+				barrier["before"] == ConvertBarrierFlagsToString(before) && barrier["after"] == ConvertBarrierFlagsToString(after))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+ADRIA_TEST(RenderGraph, NullDeviceGraphIsExported)
+{
+	test::TempDirectory temp_directory;
+	json const graph = CompileAndExport(temp_directory);
+	ASSERT_FALSE(graph.is_discarded());
+	EXPECT_EQ(graph["version"].get<Int>(), 2);
+
+	json const& passes = graph["passes"];
+	ASSERT_EQ(passes.size(), 4u);
+	EXPECT_FALSE(passes[0]["culled"].get<Bool>());
+	EXPECT_FALSE(passes[1]["culled"].get<Bool>());
+	EXPECT_TRUE(passes[2]["culled"].get<Bool>());
+	EXPECT_FALSE(passes[3]["culled"].get<Bool>());
+	EXPECT_EQ(passes[0]["execution_index"].get<Uint64>(), 0u);
+	EXPECT_EQ(passes[1]["execution_index"].get<Uint64>(), 1u);
+	EXPECT_TRUE(passes[2]["execution_index"].is_null());
+	EXPECT_EQ(passes[3]["execution_index"].get<Uint64>(), 2u);
+	std::vector<Uint64> const write_pass_successors = { 1, 3 };
+	std::vector<Uint64> const read_write_pass_successors = { 3 };
+	EXPECT_EQ(passes[0]["successors"].get<std::vector<Uint64>>(), write_pass_successors);
+	EXPECT_EQ(passes[1]["successors"].get<std::vector<Uint64>>(), read_write_pass_successors);
+
+	json const& textures = graph["textures"];
+	ASSERT_EQ(textures.size(), 3u);
+	EXPECT_EQ(textures[0]["lifetime"]["first_use"].get<Uint64>(), 0u);
+	EXPECT_EQ(textures[0]["lifetime"]["last_use"].get<Uint64>(), 1u);
+	EXPECT_EQ(textures[1]["lifetime"]["first_use"].get<Uint64>(), 1u);
+	EXPECT_EQ(textures[1]["lifetime"]["last_use"].get<Uint64>(), 3u);
+	EXPECT_TRUE(textures[2]["lifetime"].is_null());
+	EXPECT_EQ(textures[0]["size"].get<Uint64>(), 64u * 32u * 4u);
+	ASSERT_EQ(graph["buffers"].size(), 1u);
+	EXPECT_EQ(graph["buffers"][0]["size"].get<Uint64>(), 1024u);
+}
+
+ADRIA_TEST(RenderGraph, ExportedBarriersAreTheRecordedTransitions)
+{
+	test::TempDirectory temp_directory;
+	json const graph = CompileAndExport(temp_directory);
+	ASSERT_FALSE(graph.is_discarded());
+
+	json const* write_level = FindLevelOfPass(graph, 0);
+	json const* read_write_level = FindLevelOfPass(graph, 1);
+	json const* final_level = FindLevelOfPass(graph, 3);
+	ASSERT_TRUE(write_level && read_write_level && final_level);
+
+	//the textures start in the state of their first use, only the buffer needs a transition after creation
+	ASSERT_EQ((*write_level)["barriers"].size(), 1u);
+	EXPECT_TRUE(HasBarrier(*write_level, "Buffer", 0, GfxResourceState::Common, GfxResourceState::ComputeUAV, "Begin"));
+
+	ASSERT_EQ((*read_write_level)["barriers"].size(), 2u);
+	EXPECT_TRUE(HasBarrier(*read_write_level, "Texture", 0, GfxResourceState::ComputeUAV, GfxResourceState::ComputeSRV, "Begin"));
+	EXPECT_TRUE(HasBarrier(*read_write_level, "Texture", 0, GfxResourceState::ComputeSRV, GfxResourceState::AllUAV, "End"));
+
+	ASSERT_EQ((*final_level)["barriers"].size(), 4u);
+	EXPECT_TRUE(HasBarrier(*final_level, "Texture", 1, GfxResourceState::ComputeUAV, GfxResourceState::ComputeSRV, "Begin"));
+	EXPECT_TRUE(HasBarrier(*final_level, "Buffer", 0, GfxResourceState::ComputeUAV, GfxResourceState::ComputeSRV, "Begin"));
+	EXPECT_TRUE(HasBarrier(*final_level, "Texture", 1, GfxResourceState::ComputeSRV, GfxResourceState::AllUAV, "End"));
+	EXPECT_TRUE(HasBarrier(*final_level, "Buffer", 0, GfxResourceState::ComputeSRV, GfxResourceState::Common, "End"));
+
+	Uint64 barrier_count = 0;
+	for (json const& level : graph["dependency_levels"]) barrier_count += level["barriers"].size();
+	EXPECT_EQ(barrier_count, 7u);
+}
@@ -0,0 +1,97 @@
+#include "Rendering/SceneConfigFile.h"
+#include "Core/Paths.h"
+
+using namespace adria;
+
+namespace
+{
+	std::vector<std::string> GetShippedScenes()
+	{
+		std::vector<std::string> scenes;
+		for (std::filesystem::directory_entry const& entry : std::filesystem::directory_iterator(paths::ScenesDir))
+		{
+			if (entry.path().extension() == ".json") scenes.push_back(entry.path().filename().string());
+		}
+		std::sort(scenes.begin(), scenes.end());
+		return scenes;
+	}
+
+	//writes the scene, reads it back and checks that nothing was lost and the schema accepts the file without warnings
+	void CheckRoundTrip(SceneFile const& scene, std::string const& written_path, std::string const& name)
+	{
+		EXPECT_TRUE(WriteSceneFile(scene, written_path));
+		SceneFile reread{};
+		std::vector<SceneDiagnostic> diagnostics;
+		if (!ReadSceneFile(written_path, reread, diagnostics))
+		{
+			test::ReportFailure(__FILE__, __LINE__, name + " doesn't parse after writing it");
+			return;
+		}
+		for (SceneDiagnostic const& diagnostic : diagnostics)
+		{
+			test::ReportFailure(__FILE__, __LINE__, name + ": " + diagnostic.ToString());
+		}
+		//floats are written with enough digits to read back the same value
+		if (!(reread == scene)) test::ReportFailure(__FILE__, __LINE__, name + " changed after writing it");
+	}
+}
+
+ADRIA_TEST(SceneConfigFile, ShippedScenesRoundTrip)
+{
+	std::vector<std::string> const scenes = GetShippedScenes();
+	ASSERT_FALSE(scenes.empty());
+
+	test::TempDirectory dir;
+	for (std::string const& scene : scenes)
+	{
+		SceneFile parsed{};
+		std::vector<SceneDiagnostic> diagnostics;
+		if (!ReadSceneFile(paths::ScenesDir + scene, parsed, diagnostics))
+		{
+			test::ReportFailure(__FILE__, __LINE__, scene + " doesn't parse");
+			continue;
+		}
+		CheckRoundTrip(parsed, dir.GetFilePath(scene), scene);
+	}
+}
+
+ADRIA_TEST(SceneConfigFile, OptionalFieldsRoundTrip)
+{
+	SceneFile scene{};
+	scene.ini = "custom_cvars.ini";
+	scene.camera.position = { 1.5f, 20.0f, -3.25f };
+	scene.camera.look_at = { 0.1f, 0.2f, 0.3f };
+	scene.camera.fov = 60.0f;
+	scene.camera.far_plane = 1000.0f;
+	scene.skybox_textures = { "px.dds", "nx.dds", "py.dds", "ny.dds", "pz.dds", "nz.dds" };
+
+	SceneFileModel& model = scene.models.emplace_back();
+	model.path = "Sponza/glTF/Sponza.gltf";
+	model.tex_path = "Sponza/textures/";
+	model.rotation = { 0.0f, 90.0f, 12.5f };
+	model.scale = { 0.01f, 0.01f, -0.01f };
+	model.use_ccw = false;
+	model.load_model_lights = true;
+
+	SceneFileLight& sun = scene.lights.emplace_back();
+	sun.type = "directional";
+	sun.elevation = 75.0f;
+	sun.azimuth = 120.0f;
+	sun.temperature = 5500.0f;
+	sun.cascades = true;
+	sun.god_rays = true;
+
+	SceneFileLight& spot = scene.lights.emplace_back();
+	spot.type = "spot";
+	spot.position = { 10.0f, 5.0f, 0.0f };
+	spot.direction = { 0.0f, -1.0f, 0.0f };
+	spot.color = { 1.0f, 0.5f, 0.25f };
+	spot.outer_angle = 30.0f;
+	spot.inner_angle = 15.0f;
+	spot.mesh = "quad";
+	spot.size = 20;
+	spot.texture = "flare.png";
+
+	test::TempDirectory dir;
+	CheckRoundTrip(scene, dir.GetFilePath("optional_fields.json"), "optional_fields.json");
+}
@@ -0,0 +1,118 @@
+#include "Rendering/SceneConfigSchema.h"
+
+using namespace adria;
+
+namespace
+{
+	std::string ReadText(std::string const& path)
+	{
+		std::ifstream is(path, std::ios::binary);
+		return std::string((std::istreambuf_iterator<Char>(is)), std::istreambuf_iterator<Char>());
+	}
+
+	std::vector<std::string> ReadLines(std::string const& path)
+	{
+		std::vector<std::string> lines;
+		std::ifstream is(path);
+		for (std::string line; std::getline(is, line);)
+		{
+			if (!line.empty() && line.back() == '\r') line.pop_back();
+			if (!line.empty()) lines.push_back(line);
+		}
+		return lines;
+	}
+
+	struct ValidationResult
+	{
+		Bool valid = false;
+		json scene_json;
+		std::vector<std::string> diagnostics;
+	};
+
+	//fixtures live in Data/Scenes, <name>.expected lists the diagnostics of <name>.json in the order they are reported
+	ValidationResult ValidateFixture(std::string const& name)
+	{
+		std::string const text = ReadText(ADRIA_TESTS_DATA_DIR "Scenes/" + name + ".json");
+		ValidationResult result{};
+		result.scene_json = json::parse(text);
+		std::vector<SceneDiagnostic> diagnostics;
+		result.valid = ValidateSceneJson(result.scene_json, text, name + ".json", diagnostics);
+		for (SceneDiagnostic const& diagnostic : diagnostics) result.diagnostics.push_back(diagnostic.ToString());
+		return result;
+	}
+
+	void ExpectDiagnostics(std::string const& name, ValidationResult const& result)
+	{
+		std::vector<std::string> const expected = ReadLines(ADRIA_TESTS_DATA_DIR "Scenes/" + name + ".expected");
+		EXPECT_EQ(result.diagnostics.size(), expected.size());
+		for (Uint64 i = 0; i < std::max(expected.size(), result.diagnostics.size()); ++i)
+		{
+			std::string const& actual_line = i < result.diagnostics.size() ? result.diagnostics[i] : std::string("<none>");
+			std::string const& expected_line = i < expected.size() ? expected[i] : std::string("<none>");
+			EXPECT_EQ(actual_line, expected_line);
+		}
+	}
+}
+
+ADRIA_TEST(SceneConfigSchema, UnknownKeysAreWarnings)
+{
+	ValidationResult const result = ValidateFixture("unknown_keys");
+	EXPECT_TRUE(result.valid);
+	ExpectDiagnostics("unknown_keys", result);
+	//defaults are filled in for the missing fields
+	EXPECT_EQ(result.scene_json["camera"]["fov"].get<Float>(), 90.0f);
+	EXPECT_EQ(result.scene_json["lights"][0]["intensity"].get<Float>(), 1.0f);
+}
+
+ADRIA_TEST(SceneConfigSchema, WrongTypesInvalidateScene)
+{
+	ValidationResult const result = ValidateFixture("wrong_types");
+	EXPECT_FALSE(result.valid);
+	ExpectDiagnostics("wrong_types", result);
+}
+
+ADRIA_TEST(SceneConfigSchema, InvalidEntriesAreSkipped)
+{
+	ValidationResult const result = ValidateFixture("invalid_entries");
+	EXPECT_TRUE(result.valid);
+	ExpectDiagnostics("invalid_entries", result);
+	ASSERT_EQ(result.scene_json["models"].size(), 1u);
+	EXPECT_EQ(result.scene_json["models"][0]["path"].get<std::string>(), "Sponza/glTF/Sponza.gltf");
+	ASSERT_EQ(result.scene_json["lights"].size(), 1u);
+	EXPECT_EQ(result.scene_json["lights"][0]["type"].get<std::string>(), "directional");
+}
+
+ADRIA_TEST(SceneConfigSchema, SpotAngles)
+{
+	ValidationResult const result = ValidateFixture("spot_angles");
+	EXPECT_TRUE(result.valid);
+	ExpectDiagnostics("spot_angles", result);
+
+	//a narrow spot light without an inner angle is valid, its inner angle is clamped to the outer one
+	json const& lights = result.scene_json["lights"];
+	ASSERT_EQ(lights.size(), 2u);
+	EXPECT_EQ(lights[0]["inner_angle"].get<Float>(), 15.0f);
+	EXPECT_EQ(lights[0]["outer_angle"].get<Float>(), 15.0f);
+	EXPECT_EQ(lights[1]["inner_angle"].get<Float>(), 10.0f);
+}
+
+ADRIA_TEST(SceneConfigSchema, RootMustBeObject)
+{
+	ValidationResult const result = ValidateFixture("not_an_object");
+	EXPECT_FALSE(result.valid);
+	ExpectDiagnostics("not_an_object", result);
+}
+
+ADRIA_TEST(SceneConfigSchema, LineAndColumn)
+{
+	std::string_view const text = "{\n\t\"a\": 1,\n\t\"b\": 2\n}";
+	Uint32 line = 0, column = 0;
+	GetLineAndColumn(text, 0, line, column);
+	EXPECT_EQ(line, 1u);
+	EXPECT_EQ(column, 1u);
+	GetLineAndColumn(text, text.find("\"b\""), line, column);
+	EXPECT_EQ(line, 3u);
+	EXPECT_EQ(column, 2u);
+	GetLineAndColumn(text, 1000, line, column);
+	EXPECT_EQ(line, 4u);
+}
@@ -0,0 +1,138 @@
+#include "Rendering/SceneConfig.h"
+#include "Core/Paths.h"
+
+using namespace adria;
+
+namespace
+{
+	class SceneComparer
+	{
+	public:
+		std::vector<std::string> const& GetMismatches() const { return mismatches; }
+
+		void Compare(SceneConfig const& a, SceneConfig const& b)
+		{
+			Check(a.ini_file == b.ini_file, "ini");
+			Check(a.skybox_params.cubemap == b.skybox_params.cubemap, "skybox cubemap");
+			Check(a.skybox_params.cubemap_textures == b.skybox_params.cubemap_textures, "skybox cubemap faces");
+
+			CheckNear(&a.camera_params.position.x, &b.camera_params.position.x, 3, "camera position");
+			CheckNear(&a.camera_params.look_at.x, &b.camera_params.look_at.x, 3, "camera look_at");
+			CheckNear(&a.camera_params.fov, &b.camera_params.fov, 1, "camera fov");
+			CheckNear(&a.camera_params.near_plane, &b.camera_params.near_plane, 1, "camera near");
+			CheckNear(&a.camera_params.far_plane, &b.camera_params.far_plane, 1, "camera far");
+
+			if (!Check(a.scene_models.size() == b.scene_models.size(), "model count")) return;
+			for (Uint64 i = 0; i < a.scene_models.size(); ++i)
+			{
+				ModelParameters const& ma = a.scene_models[i];
+				ModelParameters const& mb = b.scene_models[i];
+				std::string const prefix = "model " + std::to_string(i) + " ";
+				Check(ma.model_path == mb.model_path, prefix + "path");
+				Check(ma.textures_path == mb.textures_path, prefix + "tex_path");
+				Check(ma.triangle_ccw == mb.triangle_ccw && ma.force_mask_alpha_usage == mb.force_mask_alpha_usage && ma.load_model_lights == mb.load_model_lights, prefix + "flags");
+				CheckNear(&ma.model_matrix.m[0][0], &mb.model_matrix.m[0][0], 16, prefix + "matrix");
+			}
+
+			if (!Check(a.scene_lights.size() == b.scene_lights.size(), "light count")) return;
+			for (Uint64 i = 0; i < a.scene_lights.size(); ++i)
+			{
+				LightParameters const& la = a.scene_lights[i];
+				LightParameters const& lb = b.scene_lights[i];
+				Light const& da = la.light_data;
+				Light const& db = lb.light_data;
+				std::string const prefix = "light " + std::to_string(i) + " ";
+				Check(da.type == db.type, prefix + "type");
+				//a directional light has no position and a point light no direction, the writer drops them
+				if (da.type != LightType::Directional) CheckNear(&da.position.x, &db.position.x, 3, prefix + "position");
+				if (da.type != LightType::Point) CheckNear(&da.direction.x, &db.direction.x, 3, prefix + "direction");
+				CheckNear(&da.color.x, &db.color.x, 3, prefix + "color");
+				CheckNear(&da.intensity, &db.intensity, 1, prefix + "intensity");
+				CheckNear(&da.range, &db.range, 1, prefix + "range");
+				CheckNear(&da.outer_cosine, &db.outer_cosine, 1, prefix + "outer_angle");
+				CheckNear(&da.inner_cosine, &db.inner_cosine, 1, prefix + "inner_angle");
+				CheckNear(&da.volumetric_strength, &db.volumetric_strength, 1, prefix + "volumetric_strength");
+				CheckNear(&da.godrays_decay, &db.godrays_decay, 1, prefix + "godrays_decay");
+				CheckNear(&da.godrays_exposure, &db.godrays_exposure, 1, prefix + "godrays_exposure");
+				CheckNear(&da.godrays_density, &db.godrays_density, 1, prefix + "godrays_density");
+				CheckNear(&da.godrays_weight, &db.godrays_weight, 1, prefix + "godrays_weight");
+				Check(da.casts_shadows == db.casts_shadows && da.use_cascades == db.use_cascades && da.ray_traced_shadows == db.ray_traced_shadows &&
+					  da.active == db.active && da.volumetric == db.volumetric && da.lens_flare == db.lens_flare && da.god_rays == db.god_rays, prefix + "flags");
+				Check(la.mesh_type == lb.mesh_type, prefix + "mesh");
+				if (la.mesh_type != LightMesh::NoMesh) Check(la.mesh_size == lb.mesh_size, prefix + "size");
+				Check(la.light_texture == lb.light_texture, prefix + "texture");
+			}
+		}
+
+	private:
+		std::vector<std::string> mismatches;
+
+	private:
+		Bool Check(Bool condition, std::string const& what)
+		{
+			if (!condition) mismatches.push_back(what);
+			return condition;
+		}
+
+		//the model matrix goes through euler angles, so allow a small error relative to the magnitude
+		void CheckNear(Float const* a, Float const* b, Uint32 count, std::string const& what)
+		{
+			for (Uint32 i = 0; i < count; ++i)
+			{
+				Float const tolerance = 1e-4f * std::max(1.0f, std::abs(a[i]));
+				if (!(std::abs(a[i] - b[i]) <= tolerance))
+				{
+					mismatches.push_back(what + "[" + std::to_string(i) + "] " + std::to_string(a[i]) + " != " + std::to_string(b[i]));
+					return;
+				}
+			}
+		}
+	};
+
+	std::vector<std::string> GetShippedScenes()
+	{
+		std::vector<std::string> scenes;
+		for (std::filesystem::directory_entry const& entry : std::filesystem::directory_iterator(paths::ScenesDir))
+		{
+			if (entry.path().extension() == ".json") scenes.push_back(entry.path().filename().string());
+		}
+		std::sort(scenes.begin(), scenes.end());
+		return scenes;
+	}
+}
+
+ADRIA_TEST(SceneConfig, ShippedScenesRoundTrip)
+{
+	std::vector<std::string> const scenes = GetShippedScenes();
+	ASSERT_FALSE(scenes.empty());
+
+	test::TempDirectory dir;
+	for (std::string const& scene : scenes)
+	{
+		SceneConfig parsed{};
+		if (!ParseSceneConfig(scene, parsed))
+		{
+			test::ReportFailure(__FILE__, __LINE__, scene + " doesn't parse");
+			continue;
+		}
+
+		std::string const written_path = dir.GetFilePath(scene);
+		EXPECT_TRUE(WriteSceneConfig(parsed, written_path));
+		SceneConfig reparsed{};
+		std::vector<SceneDiagnostic> diagnostics;
+		if (!ParseSceneConfig(written_path, reparsed, false, &diagnostics))
+		{
+			test::ReportFailure(__FILE__, __LINE__, scene + " doesn't parse after writing it");
+			continue;
+		}
+		//the writer must produce a file the schema accepts without warnings
+		EXPECT_TRUE(diagnostics.empty());
+
+		SceneComparer comparer;
+		comparer.Compare(parsed, reparsed);
+		for (std::string const& mismatch : comparer.GetMismatches())
+		{
+			test::ReportFailure(__FILE__, __LINE__, scene + ": " + mismatch);
+		}
+	}
+}
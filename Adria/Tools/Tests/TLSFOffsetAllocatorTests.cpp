@@ -0,0 +1,285 @@
+#include "Utilities/TLSFOffsetAllocator.h"
+
+using namespace adria;
+
+namespace
+{
+	//free ranges keyed by offset, merged on every free. slow but obviously correct
+	class ReferenceAllocator
+	{
+	public:
+		explicit ReferenceAllocator(Uint32 max_size)
+		{
+			if (max_size > 0) free_ranges[0] = max_size;
+		}
+
+		Bool CanAllocate(Uint32 size) const
+		{
+			return size > 0 && LargestFreeBlock() >= size;
+		}
+
+		//marks [offset, offset + size) as used, fails if any part of it is not free
+		Bool Claim(Uint64 offset, Uint32 size)
+		{
+			auto it = free_ranges.upper_bound((Uint32)offset);
+			if (it == free_ranges.begin()) return false;
+			--it;
+			Uint32 const range_offset = it->first, range_size = it->second;
+			if (offset + size > (Uint64)range_offset + range_size) return false;
+
+			free_ranges.erase(it);
+			if (offset > range_offset) free_ranges[range_offset] = (Uint32)offset - range_offset;
+			Uint32 const end = (Uint32)offset + size;
+			if (end < range_offset + range_size) free_ranges[end] = range_offset + range_size - end;
+			return true;
+		}
+
+		void Release(Uint32 offset, Uint32 size)
+		{
+			auto [it, inserted] = free_ranges.emplace(offset, size);
+			ADRIA_ASSERT(inserted);
+			auto next = std::next(it);
+			if (next != free_ranges.end() && offset + size == next->first)
+			{
+				it->second += next->second;
+				free_ranges.erase(next);
+			}
+			if (it != free_ranges.begin())
+			{
+				auto prev = std::prev(it);
+				if (prev->first + prev->second == offset)
+				{
+					prev->second += it->second;
+					free_ranges.erase(it);
+				}
+			}
+		}
+
+		Uint32 FreeSize() const
+		{
+			Uint32 total = 0;
+			for (auto const& [offset, size] : free_ranges) total += size;
+			return total;
+		}
+		Uint32 LargestFreeBlock() const
+		{
+			Uint32 largest = 0;
+			for (auto const& [offset, size] : free_ranges) largest = std::max(largest, size);
+			return largest;
+		}
+
+	private:
+		std::map<Uint32, Uint32> free_ranges;
+	};
+
+	struct LiveAllocation
+	{
+		Uint32 offset;
+		Uint32 size;
+	};
+
+	//mostly small descriptor ranges with the occasional large table, like the view heap sees while streaming
+	Uint32 GetRandomSize(std::mt19937& rng)
+	{
+		Uint32 const r = rng() % 100;
+		if (r < 70) return 1 + rng() % 8;
+		if (r < 95) return 1 + rng() % 128;
+		return 1 + rng() % 2048;
+	}
+
+	//the first-fit std::list the descriptor allocator used before, kept as the benchmark baseline
+	class ListOffsetAllocator
+	{
+		struct Range
+		{
+			Uint32 offset;
+			Uint32 size;
+		};
+
+	public:
+		explicit ListOffsetAllocator(Uint32 max_size) { free_ranges.push_back(Range{ 0, max_size }); }
+
+		Uint64 Allocate(Uint32 size)
+		{
+			for (auto it = free_ranges.begin(); it != free_ranges.end(); ++it)
+			{
+				if (it->size < size) continue;
+				Uint32 const offset = it->offset;
+				it->offset += size;
+				it->size -= size;
+				if (it->size == 0) free_ranges.erase(it);
+				return offset;
+			}
+			return INVALID_ALLOC_OFFSET;
+		}
+
+		void Free(Uint32 offset, Uint32 size)
+		{
+			auto it = std::find_if(free_ranges.begin(), free_ranges.end(), [offset](Range const& range) { return range.offset > offset; });
+			it = free_ranges.insert(it, Range{ offset, size });
+			auto next = std::next(it);
+			if (next != free_ranges.end() && it->offset + it->size == next->offset)
+			{
+				it->size += next->size;
+				free_ranges.erase(next);
+			}
+			if (it != free_ranges.begin())
+			{
+				auto prev = std::prev(it);
+				if (prev->offset + prev->size == it->offset)
+				{
+					prev->size += it->size;
+					free_ranges.erase(it);
+				}
+			}
+		}
+
+	private:
+		std::list<Range> free_ranges;
+	};
+
+	//allocates and frees in random order until live_target allocations are alive, then keeps churning at that level
+	template<typename AllocateFn, typename FreeFn>
+	void Churn(Uint32 seed, Uint32 operation_count, Uint32 live_target, AllocateFn&& allocate, FreeFn&& free)
+	{
+		std::mt19937 rng(seed);
+		std::vector<LiveAllocation> live;
+		for (Uint32 i = 0; i < operation_count; ++i)
+		{
+			if (!live.empty() && (live.size() >= live_target || rng() % 3 == 0))
+			{
+				Uint32 const victim = rng() % live.size();
+				free(live[victim].offset, live[victim].size);
+				live[victim] = live.back();
+				live.pop_back();
+			}
+			else
+			{
+				Uint32 const size = GetRandomSize(rng);
+				Uint64 const offset = allocate(size);
+				if (offset != INVALID_ALLOC_OFFSET) live.push_back(LiveAllocation{ (Uint32)offset, size });
+			}
+		}
+		for (LiveAllocation const& allocation : live) free(allocation.offset, allocation.size);
+	}
+}
+
+ADRIA_TEST(TLSFOffsetAllocator, SplitsAndCoalesces)
+{
+	TLSFOffsetAllocator allocator(1024);
+	Uint64 const a = allocator.Allocate(100);
+	Uint64 const b = allocator.Allocate(200);
+	Uint64 const c = allocator.Allocate(300);
+	ASSERT_TRUE(a != INVALID_ALLOC_OFFSET && b != INVALID_ALLOC_OFFSET && c != INVALID_ALLOC_OFFSET);
+	EXPECT_EQ(allocator.UsedSize(), 600u);
+
+	//freeing the middle block leaves a hole, freeing its neighbors merges everything back
+	allocator.Free(b);
+	EXPECT_EQ(allocator.LargestFreeBlock(), 424u);
+	allocator.Free(a);
+	allocator.Free(c);
+	EXPECT_TRUE(allocator.Empty());
+	EXPECT_EQ(allocator.LargestFreeBlock(), 1024u);
+	EXPECT_EQ(allocator.Allocate(1024), 0u);
+	EXPECT_TRUE(allocator.Full());
+}
+
+ADRIA_TEST(TLSFOffsetAllocator, RejectsImpossibleRequests)
+{
+	TLSFOffsetAllocator allocator(64);
+	EXPECT_EQ(allocator.Allocate(0), INVALID_ALLOC_OFFSET);
+	EXPECT_EQ(allocator.Allocate(65), INVALID_ALLOC_OFFSET);
+	EXPECT_EQ(allocator.Allocate(UINT32_MAX), INVALID_ALLOC_OFFSET);
+
+	TLSFOffsetAllocator empty(0);
+	EXPECT_EQ(empty.Allocate(1), INVALID_ALLOC_OFFSET);
+	EXPECT_EQ(empty.LargestFreeBlock(), 0u);
+}
+
+ADRIA_TEST(TLSFOffsetAllocator, ExactFitInRoundedDownBin)
+{
+	//a free block of 17 shares its bin with size 16, the rounded up search for 17 starts one bin higher and must fall back to it
+	TLSFOffsetAllocator allocator(32);
+	Uint64 const a = allocator.Allocate(17);
+	Uint64 const b = allocator.Allocate(15);
+	ASSERT_EQ(allocator.FreeSize(), 0u);
+	allocator.Free(a);
+	EXPECT_EQ(allocator.Allocate(17), a);
+	allocator.Free(b);
+}
+
+ADRIA_TEST(TLSFOffsetAllocator, MatchesReferenceModel)
+{
+	static constexpr Uint32 MaxSize = 16384;
+	static constexpr Uint32 OperationCount = 100000;
+
+	for (Uint32 seed = 1; seed <= 3; ++seed)
+	{
+		std::mt19937 rng(seed);
+		TLSFOffsetAllocator allocator(MaxSize);
+		ReferenceAllocator reference(MaxSize);
+		std::vector<LiveAllocation> live;
+		Uint32 mismatch_count = 0;
+
+		for (Uint32 i = 0; i < OperationCount && mismatch_count == 0; ++i)
+		{
+			//drift between a nearly full and a nearly empty heap so both the fallback search and the merges get exercised
+			Bool const filling = (i / 10000) % 2 == 0;
+			Bool const allocate = live.empty() || (rng() % 100) < (filling ? 70u : 30u);
+			if (allocate)
+			{
+				Uint32 const size = GetRandomSize(rng);
+				Bool const expected = reference.CanAllocate(size);
+				Uint64 const offset = allocator.Allocate(size);
+				if ((offset != INVALID_ALLOC_OFFSET) != expected) ++mismatch_count;
+				else if (offset != INVALID_ALLOC_OFFSET)
+				{
+					if (!reference.Claim(offset, size)) ++mismatch_count;
+					live.push_back(LiveAllocation{ (Uint32)offset, size });
+				}
+			}
+			else
+			{
+				Uint32 const victim = rng() % live.size();
+				allocator.Free(live[victim].offset);
+				reference.Release(live[victim].offset, live[victim].size);
+				live[victim] = live.back();
+				live.pop_back();
+			}
+
+			if (allocator.FreeSize() != reference.FreeSize()) ++mismatch_count;
+			if (i % 64 == 0 && allocator.LargestFreeBlock() != reference.LargestFreeBlock()) ++mismatch_count;
+		}
+		EXPECT_EQ(mismatch_count, 0u);
+
+		for (LiveAllocation const& allocation : live) allocator.Free(allocation.offset);
+		EXPECT_TRUE(allocator.Empty());
+		EXPECT_EQ(allocator.LargestFreeBlock(), MaxSize);
+	}
+}
+
+ADRIA_BENCHMARK(TLSFOffsetAllocator, FragmentedHeapChurn)
+{
+	static constexpr Uint32 MaxSize = 1000000;
+	static constexpr Uint32 OperationCount = 500000;
+	static constexpr Uint32 LiveTarget = 20000;
+
+	Float64 const tlsf_ms = test::MeasureMilliseconds([]()
+		{
+			TLSFOffsetAllocator allocator(MaxSize);
+			Churn(7, OperationCount, LiveTarget,
+				[&](Uint32 size) { return allocator.Allocate(size); },
+				[&](Uint32 offset, Uint32) { allocator.Free(offset); });
+		});
+	Float64 const list_ms = test::MeasureMilliseconds([]()
+		{
+			ListOffsetAllocator allocator(MaxSize);
+			Churn(7, OperationCount, LiveTarget,
+				[&](Uint32 size) { return allocator.Allocate(size); },
+				[&](Uint32 offset, Uint32 size) { allocator.Free(offset, size); });
+		}, 1);
+
+	std::string const details = std::to_string(OperationCount) + " operations, " + std::to_string(LiveTarget) + " live ranges";
+	test::ReportBenchmark("TLSFOffsetAllocator", tlsf_ms, details);
+	test::ReportBenchmark("std::list first fit", list_ms, details);
+}
@@ -0,0 +1,316 @@
+#include "Rendering/TerrainLOD.h"
+
+using namespace adria;
+
+namespace
+{
+	constexpr Uint32 ChunkTileCount = 16;
+
+	//rolling hills with one sharp ridge, enough detail that every lod has a different error
+	Float TestHeight(Uint32 x, Uint32 z)
+	{
+		Float const hills = 4.0f * std::sin(x * 0.35f) * std::cos(z * 0.27f);
+		Float const ridge = (x + z) % 7 == 0 ? 1.5f : 0.0f;
+		return hills + ridge;
+	}
+
+	TerrainLODDesc MakeDesc(Uint32 chunk_count_x, Uint32 chunk_count_z)
+	{
+		return TerrainLODDesc{ .chunk_tile_count = ChunkTileCount, .chunk_count_x = chunk_count_x, .chunk_count_z = chunk_count_z,
+							   .tile_size_x = 2.0f, .tile_size_z = 1.0f, .origin = Vector3(-10.0f, 5.0f, 20.0f) };
+	}
+
+	std::vector<Float> MakeHeights(TerrainLODDesc const& desc, Float(*height)(Uint32, Uint32))
+	{
+		Uint32 const vertex_count_x = desc.chunk_count_x * desc.chunk_tile_count + 1;
+		Uint32 const vertex_count_z = desc.chunk_count_z * desc.chunk_tile_count + 1;
+		std::vector<Float> heights((Uint64)vertex_count_x * vertex_count_z);
+		for (Uint32 z = 0; z < vertex_count_z; ++z)
+		{
+			for (Uint32 x = 0; x < vertex_count_x; ++x) heights[(Uint64)z * vertex_count_x + x] = height(x, z);
+		}
+		return heights;
+	}
+
+	std::vector<Uint32> GetChunkIndices(TerrainLOD const& terrain_lod, Uint32 lod, Uint32 stitch_mask)
+	{
+		TerrainIndexRange const range = terrain_lod.GetIndexRange(lod, stitch_mask);
+		auto const begin = terrain_lod.GetIndices().begin() + range.offset;
+		return std::vector<Uint32>(begin, begin + range.count);
+	}
+
+	//twice the signed area of every triangle in the xz plane of the chunk's vertex grid
+	std::vector<Int64> GetTriangleAreas(std::vector<Uint32> const& indices, Uint32 n)
+	{
+		std::vector<Int64> areas;
+		for (Uint64 i = 0; i < indices.size(); i += 3)
+		{
+			Int64 const x1 = indices[i] % (n + 1), z1 = indices[i] / (n + 1);
+			Int64 const x2 = indices[i + 1] % (n + 1), z2 = indices[i + 1] / (n + 1);
+			Int64 const x3 = indices[i + 2] % (n + 1), z3 = indices[i + 2] / (n + 1);
+			areas.push_back((x2 - x1) * (z3 - z1) - (x3 - x1) * (z2 - z1));
+		}
+		return areas;
+	}
+
+	//the triangle edges of a chunk that lie on one of its borders, as sorted (begin, end) vertex positions along that border
+	std::set<std::pair<Uint32, Uint32>> GetBorderSegments(std::vector<Uint32> const& indices, Uint32 n, TerrainEdge edge)
+	{
+		auto OnBorder = [&](Uint32 index)
+			{
+				Uint32 const x = index % (n + 1), z = index / (n + 1);
+				switch (edge)
+				{
+				case TerrainEdge_NegativeX: return x == 0;
+				case TerrainEdge_PositiveX: return x == n;
+				case TerrainEdge_NegativeZ: return z == 0;
+				case TerrainEdge_PositiveZ: return z == n;
+				}
+				return false;
+			};
+		auto BorderPosition = [&](Uint32 index)
+			{
+				return edge == TerrainEdge_NegativeX || edge == TerrainEdge_PositiveX ? index / (n + 1) : index % (n + 1);
+			};
+
+		std::set<std::pair<Uint32, Uint32>> segments;
+		for (Uint64 i = 0; i < indices.size(); i += 3)
+		{
+			for (Uint32 e = 0; e < 3; ++e)
+			{
+				Uint32 const a = indices[i + e], b = indices[i + (e + 1) % 3];
+				if (OnBorder(a) && OnBorder(b))
+				{
+					Uint32 const pa = BorderPosition(a), pb = BorderPosition(b);
+					segments.insert({ std::min(pa, pb), std::max(pa, pb) });
+				}
+			}
+		}
+		return segments;
+	}
+
+	TerrainEdge GetOppositeEdge(TerrainEdge edge)
+	{
+		switch (edge)
+		{
+		case TerrainEdge_NegativeX: return TerrainEdge_PositiveX;
+		case TerrainEdge_PositiveX: return TerrainEdge_NegativeX;
+		case TerrainEdge_NegativeZ: return TerrainEdge_PositiveZ;
+		case TerrainEdge_PositiveZ: return TerrainEdge_NegativeZ;
+		}
+		return TerrainEdge_None;
+	}
+
+	//every border that two chunks share must be split into the same segments by both of them, otherwise there's a crack or a t-junction
+	void ExpectCrackFree(TerrainLOD const& terrain_lod)
+	{
+		TerrainLODDesc const& desc = terrain_lod.GetDesc();
+		std::vector<TerrainChunkLOD> const& selected_lods = terrain_lod.GetSelectedLODs();
+		for (Uint32 chunk = 0; chunk < terrain_lod.GetChunkCount(); ++chunk)
+		{
+			Uint32 const x = chunk % desc.chunk_count_x, z = chunk / desc.chunk_count_x;
+			std::pair<Uint32, TerrainEdge> neighbors[2];
+			Uint32 neighbor_count = 0;
+			if (x + 1 < desc.chunk_count_x) neighbors[neighbor_count++] = { chunk + 1, TerrainEdge_PositiveX };
+			if (z + 1 < desc.chunk_count_z) neighbors[neighbor_count++] = { chunk + desc.chunk_count_x, TerrainEdge_PositiveZ };
+			for (Uint32 i = 0; i < neighbor_count; ++i)
+			{
+				auto const [neighbor, edge] = neighbors[i];
+				TerrainChunkLOD const& chunk_lod = selected_lods[chunk];
+				TerrainChunkLOD const& neighbor_lod = selected_lods[neighbor];
+				EXPECT_LE(std::max(chunk_lod.lod, neighbor_lod.lod) - std::min(chunk_lod.lod, neighbor_lod.lod), 1u);
+				EXPECT_EQ((chunk_lod.stitch_mask & edge) != 0, neighbor_lod.lod > chunk_lod.lod);
+				EXPECT_EQ((neighbor_lod.stitch_mask & GetOppositeEdge(edge)) != 0, chunk_lod.lod > neighbor_lod.lod);
+
+				auto const chunk_segments = GetBorderSegments(GetChunkIndices(terrain_lod, chunk_lod.lod, chunk_lod.stitch_mask), desc.chunk_tile_count, edge);
+				auto const neighbor_segments = GetBorderSegments(GetChunkIndices(terrain_lod, neighbor_lod.lod, neighbor_lod.stitch_mask), desc.chunk_tile_count, GetOppositeEdge(edge));
+				EXPECT_TRUE(chunk_segments == neighbor_segments);
+			}
+		}
+	}
+}
+
+ADRIA_TEST(TerrainLOD, ChunkingAndBounds)
+{
+	TerrainLODDesc const desc = MakeDesc(3, 2);
+	std::vector<Float> const heights = MakeHeights(desc, TestHeight);
+	TerrainLOD const terrain_lod(desc, heights);
+
+	EXPECT_EQ(terrain_lod.GetChunkCount(), 6u);
+	EXPECT_EQ(terrain_lod.GetLODCount(), 5u);
+	EXPECT_EQ(terrain_lod.GetChunkVertexCount(), 17u * 17u);
+
+	Uint32 const row_pitch = desc.chunk_count_x * ChunkTileCount + 1;
+	for (Uint32 chunk = 0; chunk < terrain_lod.GetChunkCount(); ++chunk)
+	{
+		Uint32 const chunk_x = chunk % desc.chunk_count_x, chunk_z = chunk / desc.chunk_count_x;
+		//chunks share their border vertices, so the range is inclusive on both ends
+		Float min_height = FLT_MAX, max_height = -FLT_MAX;
+		for (Uint32 z = chunk_z * ChunkTileCount; z <= (chunk_z + 1) * ChunkTileCount; ++z)
+		{
+			for (Uint32 x = chunk_x * ChunkTileCount; x <= (chunk_x + 1) * ChunkTileCount; ++x)
+			{
+				min_height = std::min(min_height, heights[z * row_pitch + x]);
+				max_height = std::max(max_height, heights[z * row_pitch + x]);
+			}
+		}
+
+		BoundingBox const& bounding_box = terrain_lod.GetChunkBoundingBox(chunk);
+		EXPECT_NEAR(bounding_box.Center.x - bounding_box.Extents.x, desc.origin.x + chunk_x * ChunkTileCount * desc.tile_size_x, 1e-4f);
+		EXPECT_NEAR(bounding_box.Center.x + bounding_box.Extents.x, desc.origin.x + (chunk_x + 1) * ChunkTileCount * desc.tile_size_x, 1e-4f);
+		EXPECT_NEAR(bounding_box.Center.z - bounding_box.Extents.z, desc.origin.z + chunk_z * ChunkTileCount * desc.tile_size_z, 1e-4f);
+		EXPECT_NEAR(bounding_box.Center.z + bounding_box.Extents.z, desc.origin.z + (chunk_z + 1) * ChunkTileCount * desc.tile_size_z, 1e-4f);
+		EXPECT_NEAR(bounding_box.Center.y - bounding_box.Extents.y, desc.origin.y + min_height, 1e-4f);
+		EXPECT_NEAR(bounding_box.Center.y + bounding_box.Extents.y, desc.origin.y + max_height, 1e-4f);
+	}
+}
+
+ADRIA_TEST(TerrainLOD, IndexListsCoverTheChunk)
+{
+	TerrainLODDesc const desc = MakeDesc(1, 1);
+	TerrainLOD const terrain_lod(desc, MakeHeights(desc, TestHeight));
+
+	Uint32 expected_offset = 0;
+	for (Uint32 lod = 0; lod < terrain_lod.GetLODCount(); ++lod)
+	{
+		Uint32 const quads_per_side = ChunkTileCount >> lod;
+		for (Uint32 stitch_mask = 0; stitch_mask < TerrainStitchMaskCount; ++stitch_mask)
+		{
+			//ranges are packed in lod and stitch mask order
+			TerrainIndexRange const range = terrain_lod.GetIndexRange(lod, stitch_mask);
+			EXPECT_EQ(range.offset, expected_offset);
+			expected_offset += range.count;
+
+			std::vector<Uint32> const indices = GetChunkIndices(terrain_lod, lod, stitch_mask);
+			ASSERT_EQ(indices.size() % 3, 0u);
+			//every stitched edge drops half of its triangles, the coarsest lod is never stitched
+			Uint32 stitched_edge_count = 0;
+			for (Uint32 edge = TerrainEdge_NegativeX; edge <= TerrainEdge_PositiveZ; edge <<= 1) stitched_edge_count += (stitch_mask & edge) != 0;
+			if (quads_per_side == 1) stitched_edge_count = 0;
+			EXPECT_EQ(indices.size() / 3, 2 * quads_per_side * quads_per_side - stitched_edge_count * quads_per_side / 2);
+
+			//same winding everywhere (clockwise with x right and z up) and the triangles tile the chunk without holes or overlaps
+			Int64 area_sum = 0;
+			for (Int64 area : GetTriangleAreas(indices, ChunkTileCount))
+			{
+				EXPECT_LT(area, 0);
+				area_sum += area;
+			}
+			EXPECT_EQ(area_sum, -2 * (Int64)ChunkTileCount * ChunkTileCount);
+			for (Uint32 index : indices) EXPECT_LT(index, terrain_lod.GetChunkVertexCount());
+		}
+	}
+	EXPECT_EQ(expected_offset, (Uint32)terrain_lod.GetIndices().size());
+}
+
+ADRIA_TEST(TerrainLOD, StitchedEdgesMatchTheCoarserLOD)
+{
+	TerrainLODDesc const desc = MakeDesc(1, 1);
+	TerrainLOD const terrain_lod(desc, MakeHeights(desc, TestHeight));
+
+	TerrainEdge const edges[] = { TerrainEdge_NegativeX, TerrainEdge_PositiveX, TerrainEdge_NegativeZ, TerrainEdge_PositiveZ };
+	for (Uint32 lod = 0; lod + 1 < terrain_lod.GetLODCount(); ++lod)
+	{
+		for (Uint32 stitch_mask = 0; stitch_mask < TerrainStitchMaskCount; ++stitch_mask)
+		{
+			std::vector<Uint32> const indices = GetChunkIndices(terrain_lod, lod, stitch_mask);
+			for (TerrainEdge edge : edges)
+			{
+				//a stitched edge has the segments of the coarser neighbor's unstitched edge, the others keep their own
+				Uint32 const expected_lod = (stitch_mask & edge) ? lod + 1 : lod;
+				auto const expected_segments = GetBorderSegments(GetChunkIndices(terrain_lod, expected_lod, TerrainEdge_None), ChunkTileCount, edge);
+				EXPECT_TRUE(GetBorderSegments(indices, ChunkTileCount, edge) == expected_segments);
+			}
+		}
+	}
+}
+
+ADRIA_TEST(TerrainLOD, GeometricErrors)
+{
+	TerrainLODDesc const desc = MakeDesc(2, 2);
+
+	//a plane is reproduced exactly by every lod
+	TerrainLOD const planar(desc, MakeHeights(desc, [](Uint32 x, Uint32 z) { return 0.5f * x - 0.25f * z + 3.0f; }));
+	for (Uint32 chunk = 0; chunk < planar.GetChunkCount(); ++chunk)
+	{
+		for (Uint32 lod = 0; lod < planar.GetLODCount(); ++lod) EXPECT_NEAR(planar.GetGeometricError(chunk, lod), 0.0f, 1e-4f);
+	}
+
+	//a single spike on an odd vertex of the last chunk is lost from lod 1 on, the other chunks don't see it
+	TerrainLOD const spike(desc, MakeHeights(desc, [](Uint32 x, Uint32 z) { return x == 21 && z == 23 ? 8.0f : 0.0f; }));
+	for (Uint32 chunk = 0; chunk < spike.GetChunkCount(); ++chunk)
+	{
+		EXPECT_EQ(spike.GetGeometricError(chunk, 0), 0.0f);
+		for (Uint32 lod = 1; lod < spike.GetLODCount(); ++lod) EXPECT_EQ(spike.GetGeometricError(chunk, lod), chunk == 3 ? 8.0f : 0.0f);
+	}
+
+	//a coarser lod never has a smaller error
+	TerrainLOD const hills(desc, MakeHeights(desc, TestHeight));
+	for (Uint32 chunk = 0; chunk < hills.GetChunkCount(); ++chunk)
+	{
+		EXPECT_EQ(hills.GetGeometricError(chunk, 0), 0.0f);
+		for (Uint32 lod = 1; lod < hills.GetLODCount(); ++lod) EXPECT_GE(hills.GetGeometricError(chunk, lod), hills.GetGeometricError(chunk, lod - 1));
+		EXPECT_GT(hills.GetGeometricError(chunk, hills.GetLODCount() - 1), 0.0f);
+	}
+}
+
+ADRIA_TEST(TerrainLOD, SelectionFollowsTheScreenError)
+{
+	TerrainLODDesc const desc = MakeDesc(8, 8);
+	TerrainLOD terrain_lod(desc, MakeHeights(desc, TestHeight));
+	Float const projection_scale = TerrainLOD::GetProjectionScale(pi_div_4<Float>, 1080.0f);
+	EXPECT_NEAR(projection_scale, 1080.0f / (2.0f * std::tan(pi_div_4<Float> * 0.5f)), 1e-3f);
+
+	//the camera stands above the first chunk
+	BoundingBox const& first_chunk = terrain_lod.GetChunkBoundingBox(0);
+	Vector3 const camera_position(first_chunk.Center.x, first_chunk.Center.y + first_chunk.Extents.y + 2.0f, first_chunk.Center.z);
+	Float const max_screen_error = 16.0f;
+	std::vector<TerrainChunkLOD> const selected_lods = terrain_lod.SelectLODs(camera_position, projection_scale, max_screen_error);
+	ASSERT_EQ(selected_lods.size(), (Uint64)terrain_lod.GetChunkCount());
+	EXPECT_EQ(selected_lods[0].lod, 0u);
+	EXPECT_GT(selected_lods.back().lod, 0u);
+
+	for (Uint32 chunk = 0; chunk < terrain_lod.GetChunkCount(); ++chunk)
+	{
+		BoundingBox const& bounding_box = terrain_lod.GetChunkBoundingBox(chunk);
+		Vector3 const offset(
+			std::max(std::abs(camera_position.x - bounding_box.Center.x) - bounding_box.Extents.x, 0.0f),
+			std::max(std::abs(camera_position.y - bounding_box.Center.y) - bounding_box.Extents.y, 0.0f),
+			std::max(std::abs(camera_position.z - bounding_box.Center.z) - bounding_box.Extents.z, 0.0f));
+		Float const distance = offset.Length();
+		//the selected lod keeps the projected error within the bound, balancing only ever picks a finer lod
+		Uint32 const lod = selected_lods[chunk].lod;
+		EXPECT_LE(terrain_lod.GetGeometricError(chunk, lod) * projection_scale, max_screen_error * distance + 1e-3f);
+	}
+
+	//a larger error bound never picks finer lods
+	std::vector<TerrainChunkLOD> const coarse_lods = terrain_lod.SelectLODs(camera_position, projection_scale, 4.0f * max_screen_error);
+	for (Uint32 chunk = 0; chunk < terrain_lod.GetChunkCount(); ++chunk) EXPECT_GE(coarse_lods[chunk].lod, selected_lods[chunk].lod);
+	EXPECT_GT(coarse_lods.back().lod, selected_lods.back().lod);
+
+	//far away every chunk drops to the coarsest lod and nothing needs stitching
+	for (TerrainChunkLOD const& chunk_lod : terrain_lod.SelectLODs(Vector3(0.0f, 1e6f, 0.0f), projection_scale, 2.0f))
+	{
+		EXPECT_EQ(chunk_lod.lod, terrain_lod.GetLODCount() - 1);
+		EXPECT_EQ(chunk_lod.stitch_mask, (Uint32)TerrainEdge_None);
+	}
+}
+
+ADRIA_TEST(TerrainLOD, SelectedTransitionsAreCrackFree)
+{
+	TerrainLODDesc const desc = MakeDesc(8, 6);
+	TerrainLOD terrain_lod(desc, MakeHeights(desc, TestHeight));
+	Float const projection_scale = TerrainLOD::GetProjectionScale(pi_div_4<Float>, 1080.0f);
+
+	//cameras inside, at the border and outside the terrain, with bounds from fine to coarse
+	Vector3 const camera_positions[] = { Vector3(0.0f, 10.0f, 30.0f), Vector3(150.0f, 6.0f, 70.0f), Vector3(-50.0f, 40.0f, -20.0f), Vector3(300.0f, 2.0f, 120.0f) };
+	Float const max_screen_errors[] = { 0.5f, 2.0f, 8.0f, 32.0f };
+	for (Vector3 const& camera_position : camera_positions)
+	{
+		for (Float max_screen_error : max_screen_errors)
+		{
+			terrain_lod.SelectLODs(camera_position, projection_scale, max_screen_error);
+			ExpectCrackFree(terrain_lod);
+		}
+	}
+}
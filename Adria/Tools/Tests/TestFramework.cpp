@@ -0,0 +1,122 @@
+#include "TestFramework.h"
+
+namespace adria::test
+{
+	namespace
+	{
+		std::vector<TestCase>& GetTests()
+		{
+			static std::vector<TestCase> tests;
+			return tests;
+		}
+
+		Uint32 current_failure_count = 0;
+		std::atomic<Uint64> temp_directory_counter = 0;
+	}
+
+	Bool RegisterTest(Char const* suite, Char const* name, TestFunction function, Bool is_benchmark)
+	{
+		GetTests().push_back(TestCase{ .suite = suite, .name = name, .function = function, .is_benchmark = is_benchmark });
+		return true;
+	}
+
+	void ReportFailure(Char const* file, Uint32 line, std::string const& message)
+	{
+		++current_failure_count;
+		printf("    %s:%u: %s\n", file, line, message.c_str());
+	}
+
+	TempDirectory::TempDirectory()
+	{
+		Uint64 const ticks = (Uint64)std::chrono::steady_clock::now().time_since_epoch().count();
+		path = std::filesystem::temp_directory_path() / ("AdriaTests_" + std::to_string(ticks) + "_" + std::to_string(temp_directory_counter++));
+		std::filesystem::create_directories(path);
+	}
+
+	TempDirectory::~TempDirectory()
+	{
+		std::error_code ec;
+		std::filesystem::remove_all(path, ec);
+	}
+
+	Bool LogCapture::Contains(std::string_view text) const
+	{
+		return std::any_of(lines.begin(), lines.end(), [text](std::string const& line) { return line.find(text) != std::string::npos; });
+	}
+
+	Float64 MeasureMilliseconds(std::function<void()> const& function, Uint32 run_count)
+	{
+		std::vector<Float64> times(run_count);
+		for (Float64& time : times)
+		{
+			auto const start = std::chrono::steady_clock::now();
+			function();
+			time = std::chrono::duration<Float64, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+		std::sort(times.begin(), times.end());
+		return times[times.size() / 2];
+	}
+
+	void ReportBenchmark(Char const* name, Float64 milliseconds, std::string const& details)
+	{
+		printf("    %-48s %10.3f ms  %s\n", name, milliseconds, details.c_str());
+	}
+}
+
+using namespace adria;
+using namespace adria::test;
+
+//AdriaTests [--benchmark] [filter]: runs the tests (or the benchmarks) whose "Suite.Name" contains filter
+int main(Int argc, Char** argv)
+{
+	Bool run_benchmarks = false;
+	std::string filter;
+	for (Int i = 1; i < argc; ++i)
+	{
+		std::string_view const arg = argv[i];
+		if (arg == "--benchmark") run_benchmarks = true;
+		else filter = arg;
+	}
+
+	std::vector<TestCase> tests = GetTests();
+	std::sort(tests.begin(), tests.end(), [](TestCase const& a, TestCase const& b)
+		{
+			Int const suite_order = strcmp(a.suite, b.suite);
+			return suite_order != 0 ? suite_order < 0 : strcmp(a.name, b.name) < 0;
+		});
+
+	Uint32 run_count = 0;
+	std::vector<std::string> failed_tests;
+	for (TestCase const& test : tests)
+	{
+		std::string const full_name = std::string(test.suite) + "." + test.name;
+		if (test.is_benchmark != run_benchmarks || full_name.find(filter) == std::string::npos) continue;
+
+		printf("[ RUN  ] %s\n", full_name.c_str());
+		fflush(stdout);
+		current_failure_count = 0;
+		auto const start = std::chrono::steady_clock::now();
+		try
+		{
+			test.function();
+		}
+		catch (TestAbort const&) {}
+		catch (std::exception const& e)
+		{
+			ReportFailure(__FILE__, __LINE__, std::string("unexpected exception: ") + e.what());
+		}
+		Float64 const milliseconds = std::chrono::duration<Float64, std::milli>(std::chrono::steady_clock::now() - start).count();
+		printf("[ %s ] %s (%.1f ms)\n", current_failure_count == 0 ? " OK " : "FAIL", full_name.c_str(), milliseconds);
+		if (current_failure_count > 0) failed_tests.push_back(full_name);
+		++run_count;
+	}
+
+	printf("\n%u %s run, %zu failed\n", run_count, run_benchmarks ? "benchmarks" : "tests", failed_tests.size());
+	for (std::string const& failed_test : failed_tests) printf("  FAILED %s\n", failed_test.c_str());
+	if (run_count == 0)
+	{
+		printf("no test matches '%s'\n", filter.c_str());
+		return 1;
+	}
+	return failed_tests.empty() ? 0 : 1;
+}
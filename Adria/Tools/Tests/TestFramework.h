@@ -0,0 +1,114 @@
+#pragma once
+
+namespace adria::test
+{
+	using TestFunction = void(*)();
+
+	struct TestCase
+	{
+		Char const* suite;
+		Char const* name;
+		TestFunction function;
+		Bool is_benchmark;
+	};
+
+	Bool RegisterTest(Char const* suite, Char const* name, TestFunction function, Bool is_benchmark);
+	void ReportFailure(Char const* file, Uint32 line, std::string const& message);
+
+	//thrown by the ASSERT_ macros to leave the current test
+	struct TestAbort {};
+
+	template<typename T>
+	std::string ToTestString(T const& value)
+	{
+		if constexpr (std::is_same_v<T, Bool>) return value ? "true" : "false";
+		else if constexpr (std::is_enum_v<T>) return ToTestString(static_cast<std::underlying_type_t<T>>(value));
+		else if constexpr (std::is_arithmetic_v<T>)
+		{
+			//std::to_string and operator+ trip gcc 12's -Wstringop-overflow once inlined, so the text is built in place
+			Char buffer[64];
+			std::to_chars_result const result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+			return std::string(buffer, result.ptr);
+		}
+		else if constexpr (std::is_convertible_v<T const&, std::string_view>)
+		{
+			std::string_view const text(value);
+			std::string quoted(text.size() + 2, '"');
+			text.copy(quoted.data() + 1, text.size());
+			return quoted;
+		}
+		else return "<value>";
+	}
+
+	//unique directory under the system temp folder, removed with its contents on destruction
+	class TempDirectory
+	{
+	public:
+		TempDirectory();
+		ADRIA_NONCOPYABLE_NONMOVABLE(TempDirectory)
+		~TempDirectory();
+
+		std::string GetPath() const { return path.string(); }
+		std::string GetFilePath(std::string_view file_name) const { return (path / file_name).string(); }
+
+	private:
+		std::filesystem::path path;
+	};
+
+	//log lines sent through ADRIA_LOG while the capture is alive
+	class LogCapture
+	{
+	public:
+		LogCapture();
+		ADRIA_NONCOPYABLE_NONMOVABLE(LogCapture)
+		~LogCapture();
+
+		std::vector<std::string> const& GetLines() const { return lines; }
+		Bool Contains(std::string_view text) const;
+		void AddLine(std::string const& line) { lines.push_back(line); }
+
+	private:
+		std::vector<std::string> lines;
+	};
+
+	//median wall time of a few runs in milliseconds
+	Float64 MeasureMilliseconds(std::function<void()> const& function, Uint32 run_count = 5);
+	void ReportBenchmark(Char const* name, Float64 milliseconds, std::string const& details = "");
+}
+
+#define _ADRIA_TEST_IMPL(suite, name, is_benchmark) \
+	static void suite##_##name(); \
+	ADRIA_MAYBE_UNUSED static Bool const suite##_##name##_registered = adria::test::RegisterTest(#suite, #name, &suite##_##name, is_benchmark); \
+	static void suite##_##name()
+
+#define ADRIA_TEST(suite, name)			_ADRIA_TEST_IMPL(suite, name, false)
+//benchmarks only run with --benchmark
+#define ADRIA_BENCHMARK(suite, name)	_ADRIA_TEST_IMPL(suite, name, true)
+
+#define _ADRIA_CHECK_IMPL(cond, message, on_failure) \
+	do { if (!(cond)) { adria::test::ReportFailure(__FILE__, __LINE__, message); on_failure; } } while (0)
+
+#define _ADRIA_CHECK_OP_IMPL(a, op, b, on_failure) \
+	do { \
+		auto const _lhs = (a); auto const _rhs = (b); \
+		if (!(_lhs op _rhs)) \
+		{ \
+			adria::test::ReportFailure(__FILE__, __LINE__, std::string(#a " " #op " " #b " with ") + adria::test::ToTestString(_lhs) + " and " + adria::test::ToTestString(_rhs)); \
+			on_failure; \
+		} \
+	} while (0)
+
+#define EXPECT_TRUE(cond)	_ADRIA_CHECK_IMPL(cond, #cond, (void)0)
+#define EXPECT_FALSE(cond)	_ADRIA_CHECK_IMPL(!(cond), "!(" #cond ")", (void)0)
+#define EXPECT_EQ(a, b)		_ADRIA_CHECK_OP_IMPL(a, ==, b, (void)0)
+#define EXPECT_NE(a, b)		_ADRIA_CHECK_OP_IMPL(a, !=, b, (void)0)
+#define EXPECT_LT(a, b)		_ADRIA_CHECK_OP_IMPL(a, <, b, (void)0)
+#define EXPECT_LE(a, b)		_ADRIA_CHECK_OP_IMPL(a, <=, b, (void)0)
+#define EXPECT_GT(a, b)		_ADRIA_CHECK_OP_IMPL(a, >, b, (void)0)
+#define EXPECT_GE(a, b)		_ADRIA_CHECK_OP_IMPL(a, >=, b, (void)0)
+#define EXPECT_NEAR(a, b, tolerance) _ADRIA_CHECK_IMPL(std::abs((Float64)(a) - (Float64)(b)) <= (tolerance), \
+	std::string("|" #a " - " #b "| <= " #tolerance " with ") + std::to_string((Float64)(a)) + " and " + std::to_string((Float64)(b)), (void)0)
+
+#define ASSERT_TRUE(cond)	_ADRIA_CHECK_IMPL(cond, #cond, throw adria::test::TestAbort{})
+#define ASSERT_FALSE(cond)	_ADRIA_CHECK_IMPL(!(cond), "!(" #cond ")", throw adria::test::TestAbort{})
+#define ASSERT_EQ(a, b)		_ADRIA_CHECK_OP_IMPL(a, ==, b, throw adria::test::TestAbort{})
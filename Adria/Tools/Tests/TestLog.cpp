@@ -0,0 +1,63 @@
+#include "Logging/Log.h"
+
+//logging for the tests: ADRIA_LOG goes straight to the active LogCapture, without the sinks and the logging thread of Log.cpp
+
+namespace adria
+{
+	namespace
+	{
+		std::mutex capture_mutex;
+		std::vector<test::LogCapture*> captures;
+
+		Char const* GetLevelName(LogLevel level)
+		{
+			switch (level)
+			{
+			case LogLevel::LOG_DEBUG:	return "[DEBUG]";
+			case LogLevel::LOG_INFO:	return "[INFO]";
+			case LogLevel::LOG_WARNING:	return "[WARNING]";
+			case LogLevel::LOG_ERROR:	return "[ERROR]";
+			case LogLevel::LOG_FATAL:	return "[FATAL]";
+			}
+			return "[UNKNOWN]";
+		}
+	}
+
+	class LogManagerImpl {};
+
+	LogManager::LogManager() = default;
+	LogManager::~LogManager() = default;
+
+	void LogManager::Log(LogLevel level, LogChannel, Char const* str, Char const*, Uint32)
+	{
+		std::lock_guard lock(capture_mutex);
+		if (!captures.empty()) captures.back()->AddLine(std::string(GetLevelName(level)) + " " + str);
+	}
+	void LogManager::LogSync(LogLevel level, LogChannel channel, Char const* str, Char const* file, Uint32 line)
+	{
+		Log(level, channel, str, file, line);
+	}
+	void LogManager::Flush() {}
+	void LogManager::Register(ILogSink* logger)
+	{
+		delete logger;
+	}
+	ILogSink* LogManager::GetLastSink()
+	{
+		return nullptr;
+	}
+
+	namespace test
+	{
+		LogCapture::LogCapture()
+		{
+			std::lock_guard lock(capture_mutex);
+			captures.push_back(this);
+		}
+		LogCapture::~LogCapture()
+		{
+			std::lock_guard lock(capture_mutex);
+			std::erase(captures, this);
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cfloat>
+#include <limits>
+#include <fstream>
+#include <sstream>
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <thread>
+
+#include <vector>
+#include <array>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <stack>
+#include <queue>
+#include <deque>
+#include <unordered_map>
+#include <map>
+#include <unordered_set>
+#include <set>
+#include <list>
+
+#include <memory>
+#include <optional>
+#include <variant>
+#include <tuple>
+#include <functional>
+#include <span>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <filesystem>
+#include <chrono>
+#include <concepts>
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#if defined(_WIN32)
+#include <d3d12.h>
+#include <dxgi1_6.h>
+#include <windows.h>
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+
+#include "d3dx12.h"
+#include "D3D12MemAlloc.h"
+#include "entt/entt.hpp"
+#else
+//engine headers used by the device-free tests only need a few constants of d3d12.h and the dxgi formats
+#define D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT 256
+#include <dxgiformat.h>
+#endif
+
+#include "Core/Types.h"
+#include "Core/Defines.h"
+#include "Logging/Log.h"
+#if defined(_WIN32)
+#include "Graphics/GfxDefines.h"
+#include "Math/MathCommon.h"
+#include "Utilities/Ref.h"
+#endif
+#include "TestFramework.h"
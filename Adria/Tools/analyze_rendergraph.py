@@ -0,0 +1,136 @@
+# Tools/analyze_rendergraph.py
+#
+# Reports statistics of a render graph exported by RenderGraph::DumpJson (Saved/RenderGraph/rendergraph.json).
+#
+#   python Adria/Tools/analyze_rendergraph.py Adria/Saved/RenderGraph/rendergraph.json
+#   python Adria/Tools/analyze_rendergraph.py rendergraph.json --top 10
+#
+# The report lists the peak transient memory with the resources alive at that point, the critical path
+# through the executed passes and the passes culled by the graph.
+
+import argparse
+import json
+import sys
+
+SUPPORTED_VERSION = 2
+
+
+def format_bytes(size):
+    for unit in ('B', 'KB', 'MB'):
+        if size < 1024:
+            return f"{size:.2f} {unit}" if unit != 'B' else f"{size} {unit}"
+        size /= 1024
+    return f"{size:.2f} GB"
+
+
+def load_graph(path):
+    with open(path, 'r', encoding='utf-8') as f:
+        graph = json.load(f)
+    if graph.get('version') != SUPPORTED_VERSION:
+        raise ValueError(f"unsupported export version {graph.get('version')}, expected {SUPPORTED_VERSION}")
+    return graph
+
+
+def transient_resources(graph):
+    """Returns (kind, resource) for every transient resource that is used by an executed pass."""
+    resources = []
+    for kind in ('textures', 'buffers'):
+        for resource in graph[kind]:
+            if not resource['imported'] and resource['lifetime'] is not None:
+                resources.append((kind[:-1], resource))
+    return resources
+
+
+def peak_transient_memory(graph):
+    """Returns (peak bytes, execution index of the peak, resources alive at the peak) assuming no aliasing between lifetimes."""
+    resources = transient_resources(graph)
+    executed_count = sum(1 for p in graph['passes'] if p['execution_index'] is not None)
+    usage = [0] * executed_count
+    for _, resource in resources:
+        lifetime = resource['lifetime']
+        for index in range(lifetime['begin'], lifetime['end'] + 1):
+            usage[index] += resource['size']
+    if not usage:
+        return 0, None, []
+    peak_index = max(range(len(usage)), key=lambda i: usage[i])
+    alive = [(kind, r) for kind, r in resources if r['lifetime']['begin'] <= peak_index <= r['lifetime']['end']]
+    alive.sort(key=lambda kr: kr[1]['size'], reverse=True)
+    return usage[peak_index], peak_index, alive
+
+
+def critical_path(graph):
+    """Returns the longest dependency chain of executed passes as a list of pass ids."""
+    passes = {p['id']: p for p in graph['passes'] if not p['culled']}
+    order = sorted(passes.values(), key=lambda p: p['execution_index'])
+    length = {pass_id: 1 for pass_id in passes}
+    previous = {pass_id: None for pass_id in passes}
+    for p in order:
+        for successor in p['successors']:
+            if successor in passes and length[p['id']] + 1 > length[successor]:
+                length[successor] = length[p['id']] + 1
+                previous[successor] = p['id']
+    if not length:
+        return []
+    pass_id = max(length, key=lambda i: (length[i], -passes[i]['execution_index']))
+    path = []
+    while pass_id is not None:
+        path.append(pass_id)
+        pass_id = previous[pass_id]
+    return path[::-1]
+
+
+def print_report(graph, top):
+    passes = graph['passes']
+    names = {p['id']: p['name'] for p in passes}
+    executed = [p for p in passes if not p['culled']]
+    culled = [p for p in passes if p['culled']]
+    barrier_count = sum(len(level['barriers']) for level in graph['dependency_levels'])
+    async_count = sum(1 for p in executed if p['queue'] == 'Compute')
+
+    print(f"Passes: {len(passes)} ({len(executed)} executed, {len(culled)} culled, {async_count} on the compute queue)")
+    print(f"Dependency levels: {len(graph['dependency_levels'])}")
+    print(f"Textures: {len(graph['textures'])}, buffers: {len(graph['buffers'])}")
+    print(f"Barriers: {barrier_count}")
+
+    peak, peak_index, alive = peak_transient_memory(graph)
+    total = sum(r['size'] for _, r in transient_resources(graph))
+    print()
+    print(f"Peak transient memory: {format_bytes(peak)} (sum of all transient resources: {format_bytes(total)})")
+    if peak_index is not None:
+        peak_pass = next(p for p in executed if p['execution_index'] == peak_index)
+        print(f"  reached at pass {peak_index}: {peak_pass['name']}")
+        for kind, resource in alive[:top]:
+            print(f"  {format_bytes(resource['size']):>12}  {kind} {resource['name']}")
+        if len(alive) > top:
+            print(f"  ... {len(alive) - top} more")
+
+    path = critical_path(graph)
+    print()
+    print(f"Critical path length: {len(path)} passes")
+    for pass_id in path:
+        print(f"  {names[pass_id]}")
+
+    print()
+    print(f"Culled passes: {len(culled)}")
+    for p in culled:
+        print(f"  {p['name']}")
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Reports statistics of an exported render graph.")
+    parser.add_argument('graph', help="json file written by RenderGraph::DumpJson")
+    parser.add_argument('--top', type=int, default=5, help="number of resources listed at the memory peak (default: %(default)s)")
+    args = parser.parse_args(argv)
+
+    try:
+        graph = load_graph(args.graph)
+    except (OSError, ValueError, KeyError) as e:
+        print(f"error: cannot read '{args.graph}': {e}", file=sys.stderr)
+        return 2
+
+    print_report(graph, args.top)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,43 +1,145 @@
-# scripts/generate_cmake_lists.py
-
-import os 
-
-def generate_list_for_folder(root_folder, output_file, cmake_variable_name, base_path_in_cmake):
-    """
-    Scans a directory recursively and writes a CMake 'set()' command to a file.
-    Args:
-        root_folder (str): The actual folder to scan for source files (e.g., "Adria/src/Rendering").
-        output_file (str): The path to the .cmake file to be generated (e.g., "Adria/cmake/RenderingFiles.cmake").
-        cmake_variable_name (str): The name of the CMake variable for the list (e.g., "ADRIA_RENDERING_SOURCES").
-        base_path_in_cmake (str): The prefix for the file paths inside the CMake file (e.g., "src/Rendering").
-    """
-    print(f"Generating list for '{cmake_variable_name}' from '{root_folder}'...")
-    found_files = []
+# Tools/generate_cmake.py
+#
+# Generates one <Subsystem>Files.cmake source list per subsystem directory of the engine.
+#
+#   python Adria/Tools/generate_cmake.py                  regenerate the lists in Adria/Saved/cmake
+#   python Adria/Tools/generate_cmake.py --check          exit with 1 if the checked in lists are out of date
+#   python Adria/Tools/generate_cmake.py --output-dir DIR write the lists somewhere else
+#
+# Paths given on the command line are relative to the working directory.
+
+import argparse
+import os
+import sys
+
+SOURCE_EXTENSIONS = ('.cpp', '.h', '.hpp', '.inl')
+HEADER_LINE = "# This file is auto-generated by a Python script. DO NOT EDIT MANUALLY.\n"
+
+# directories of the engine folder that are not compiled into the engine target
+EXCLUDED_DIRS = ('Resources', 'Saved', 'Tools')
+
+ENGINE_DIR = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+
+
+def discover_subsystems(source_dir, excluded_dirs):
+    """Returns the sorted names of the direct subdirectories of source_dir that contain source files."""
+    subsystems = []
+    for entry in sorted(os.listdir(source_dir)):
+        entry_path = os.path.join(source_dir, entry)
+        if not os.path.isdir(entry_path) or entry in excluded_dirs or entry.startswith('.'):
+            continue
+        if collect_sources(entry_path):
+            subsystems.append(entry)
+    return subsystems
 
-    for dirpath, _, filenames in os.walk(root_folder):
-        for filename in filenames:
-            if filename.endswith(('.cpp', '.h', '.hpp', '.inl')):
-                full_path = os.path.join(dirpath, filename)
-                relative_path = os.path.relpath(full_path, root_folder)
-                cmake_path = os.path.join(base_path_in_cmake, relative_path).replace('\\', '/')
-                
-                found_files.append(cmake_path)
 
+def collect_sources(root_folder):
+    """Returns the sorted paths of all source files under root_folder, relative to it and with forward slashes."""
+    found_files = []
+    for dirpath, dirnames, filenames in os.walk(root_folder):
+        dirnames.sort()
+        for filename in filenames:
+            if filename.endswith(SOURCE_EXTENSIONS):
+                relative_path = os.path.relpath(os.path.join(dirpath, filename), root_folder)
+                found_files.append(relative_path.replace('\\', '/'))
     found_files.sort()
+    return found_files
+
+
+def get_list_file_name(subsystem):
+    return f"{subsystem}Files.cmake"
+
+
+def get_variable_name(subsystem):
+    return f"ADRIA_{subsystem.upper()}_SOURCES"
+
+
+def generate_list(source_dir, subsystem):
+    """Returns the contents of the cmake file listing the sources of one subsystem."""
+    lines = [HEADER_LINE, "\n", f"set({get_variable_name(subsystem)}\n"]
+    for path in collect_sources(os.path.join(source_dir, subsystem)):
+        lines.append(f'    "${{CMAKE_CURRENT_SOURCE_DIR}}/{subsystem}/{path}"\n')
+    lines.append(")\n")
+    return ''.join(lines)
+
+
+def generate_lists(source_dir, excluded_dirs):
+    """Returns a dict of list file name to contents for every subsystem."""
+    return {get_list_file_name(subsystem): generate_list(source_dir, subsystem)
+            for subsystem in discover_subsystems(source_dir, excluded_dirs)}
+
+
+def read_file(path):
+    with open(path, 'r', encoding='utf-8', newline='') as f:
+        return f.read()
+
+
+def find_stale_lists(output_dir, lists):
+    """Returns the generated list files in output_dir whose subsystem no longer exists."""
+    if not os.path.isdir(output_dir):
+        return []
+    stale = []
+    for entry in sorted(os.listdir(output_dir)):
+        path = os.path.join(output_dir, entry)
+        if entry.endswith('Files.cmake') and entry not in lists and read_file(path).startswith(HEADER_LINE):
+            stale.append(entry)
+    return stale
+
+
+def check_lists(output_dir, lists):
+    """Prints every list that differs from the one in output_dir and returns whether all of them match."""
+    up_to_date = True
+    for file_name, contents in lists.items():
+        path = os.path.join(output_dir, file_name)
+        if not os.path.isfile(path):
+            print(f"missing: {path}")
+            up_to_date = False
+        elif read_file(path) != contents:
+            print(f"out of date: {path}")
+            up_to_date = False
+    for file_name in find_stale_lists(output_dir, lists):
+        print(f"stale: {os.path.join(output_dir, file_name)}")
+        up_to_date = False
+    return up_to_date
+
+
+def write_lists(output_dir, lists):
+    os.makedirs(output_dir, exist_ok=True)
+    for file_name, contents in lists.items():
+        path = os.path.join(output_dir, file_name)
+        with open(path, 'w', encoding='utf-8', newline='\n') as f:
+            f.write(contents)
+        print(f"-> Wrote {contents.count(chr(10)) - 4} files to '{path}'.")
+    for file_name in find_stale_lists(output_dir, lists):
+        os.remove(os.path.join(output_dir, file_name))
+        print(f"-> Removed stale '{os.path.join(output_dir, file_name)}'.")
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Generates the per subsystem cmake source lists of the engine.")
+    parser.add_argument('--source-dir', default=ENGINE_DIR, help="engine folder whose subdirectories are scanned (default: %(default)s)")
+    parser.add_argument('--output-dir', default=None, help="folder of the generated lists (default: <source-dir>/Saved/cmake)")
+    parser.add_argument('--exclude', action='append', default=[], metavar='DIR', help="additional subdirectory to skip, can be repeated")
+    parser.add_argument('--check', action='store_true', help="don't write anything, exit with 1 if the lists in the output folder are out of date")
+    args = parser.parse_args(argv)
+
+    source_dir = os.path.abspath(args.source_dir)
+    if not os.path.isdir(source_dir):
+        print(f"error: source folder '{source_dir}' does not exist", file=sys.stderr)
+        return 2
+    output_dir = os.path.abspath(args.output_dir) if args.output_dir else os.path.join(source_dir, 'Saved', 'cmake')
+
+    lists = generate_lists(source_dir, set(EXCLUDED_DIRS) | set(args.exclude))
+    if args.check:
+        if check_lists(output_dir, lists):
+            print(f"{len(lists)} source lists are up to date.")
+            return 0
+        print(f"Source lists are out of date, run {os.path.relpath(os.path.abspath(__file__))} to regenerate them.")
+        return 1
 
-    with open(output_file, 'w') as f:
-        f.write("# This file is auto-generated by a Python script. DO NOT EDIT MANUALLY.\n\n")
-        f.write(f"set({cmake_variable_name}\n")
-        for path in found_files:
-            f.write(f'    "{path}"\n')
-        f.write(")\n")
-    print(f"-> Success! Wrote {len(found_files)} files to '{output_file}'.")
+    write_lists(output_dir, lists)
+    return 0
 
 
 if __name__ == "__main__":
-    generate_list_for_folder(
-        root_folder="C:\\Users\\Mate\\Desktop\\Projekti\\Adria\\Adria\\Graphics",
-        output_file="C:\\Users\\Mate\\Desktop\\Projekti\\Adria\\Adria\\Saved\\cmake\\GraphicsFiles.cmake",
-        cmake_variable_name="ADRIA_GRAPHICS_SOURCES",
-        base_path_in_cmake="${CMAKE_CURRENT_SOURCE_DIR}/Graphics"
-    )
\ No newline at end of file
+    sys.exit(main())
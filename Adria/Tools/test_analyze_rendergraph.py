@@ -0,0 +1,132 @@
+# Tools/test_analyze_rendergraph.py
+#
+# Unit tests of analyze_rendergraph.py on a small export, the graph is the one RenderGraphTests.cpp compiles
+# against a null device: pass 0 writes TextureA and CountsBuffer, pass 1 reads TextureA and writes TextureB,
+# pass 2 is culled and pass 3 reads TextureB and CountsBuffer.
+#
+#   python Adria/Tools/test_analyze_rendergraph.py
+
+import contextlib
+import copy
+import io
+import json
+import os
+import shutil
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import analyze_rendergraph
+
+
+def make_pass(pass_id, name, execution_index, successors):
+    return {'id': pass_id, 'name': name, 'type': 'Compute', 'queue': 'Graphics', 'culled': execution_index is None,
+            'execution_index': execution_index, 'successors': successors}
+
+
+def make_resource(resource_id, name, size, first_use, last_use, begin, end):
+    lifetime = None if first_use is None else {'first_use': first_use, 'last_use': last_use, 'begin': begin, 'end': end}
+    return {'id': resource_id, 'name': name, 'imported': False, 'size': size, 'lifetime': lifetime}
+
+
+def make_barrier(resource_type, resource, before, after, stage):
+    return {'resource_type': resource_type, 'resource': resource, 'before': before, 'after': after, 'stage': stage}
+
+
+GRAPH = {
+    'version': 2,
+    'passes': [
+        make_pass(0, 'Write Pass', 0, [1, 3]),
+        make_pass(1, 'Read Write Pass', 1, [3]),
+        make_pass(2, 'Unused Pass', None, []),
+        make_pass(3, 'Final Pass', 2, []),
+    ],
+    'textures': [
+        make_resource(0, 'TextureA', 8192, 0, 1, 0, 1),
+        make_resource(1, 'TextureB', 8192, 1, 3, 1, 2),
+        make_resource(2, 'TextureC', 8192, None, None, None, None),
+    ],
+    'buffers': [
+        make_resource(0, 'CountsBuffer', 1024, 0, 3, 0, 2),
+    ],
+    'dependency_levels': [
+        {'index': 0, 'passes': [0, 2], 'barriers': [
+            make_barrier('Buffer', 0, 'Common', 'ComputeUAV', 'Begin'),
+        ]},
+        {'index': 1, 'passes': [1], 'barriers': [
+            make_barrier('Texture', 0, 'ComputeUAV', 'ComputeSRV', 'Begin'),
+            make_barrier('Texture', 0, 'ComputeSRV', 'VertexUAV|PixelUAV|ComputeUAV', 'End'),
+        ]},
+        {'index': 2, 'passes': [3], 'barriers': [
+            make_barrier('Texture', 1, 'ComputeUAV', 'ComputeSRV', 'Begin'),
+            make_barrier('Buffer', 0, 'ComputeUAV', 'ComputeSRV', 'Begin'),
+            make_barrier('Texture', 1, 'ComputeSRV', 'VertexUAV|PixelUAV|ComputeUAV', 'End'),
+            make_barrier('Buffer', 0, 'ComputeSRV', 'Common', 'End'),
+        ]},
+    ],
+}
+
+
+class AnalyzeRenderGraphTests(unittest.TestCase):
+
+    def setUp(self):
+        self.temp_dir = tempfile.mkdtemp(prefix='adria_analyze_rendergraph_')
+
+    def tearDown(self):
+        shutil.rmtree(self.temp_dir, ignore_errors=True)
+
+    def write_graph(self, graph):
+        path = os.path.join(self.temp_dir, 'rendergraph.json')
+        with open(path, 'w', encoding='utf-8') as f:
+            json.dump(graph, f)
+        return path
+
+    def run_main(self, *args):
+        """Runs the script's main and returns its exit code with the captured output."""
+        stdout = io.StringIO()
+        with contextlib.redirect_stdout(stdout), contextlib.redirect_stderr(io.StringIO()):
+            result = analyze_rendergraph.main(list(args))
+        return result, stdout.getvalue()
+
+    def test_peak_transient_memory(self):
+        peak, peak_index, alive = analyze_rendergraph.peak_transient_memory(GRAPH)
+        #both textures and the buffer are alive during the read write pass
+        self.assertEqual(peak, 8192 + 8192 + 1024)
+        self.assertEqual(peak_index, 1)
+        self.assertEqual([r['name'] for _, r in alive], ['TextureA', 'TextureB', 'CountsBuffer'])
+
+    def test_culled_resources_are_not_transient(self):
+        names = [r['name'] for _, r in analyze_rendergraph.transient_resources(GRAPH)]
+        self.assertEqual(names, ['TextureA', 'TextureB', 'CountsBuffer'])
+
+    def test_critical_path(self):
+        self.assertEqual(analyze_rendergraph.critical_path(GRAPH), [0, 1, 3])
+
+    def test_report(self):
+        result, output = self.run_main(self.write_graph(GRAPH))
+        self.assertEqual(result, 0)
+        self.assertIn("Passes: 4 (3 executed, 1 culled, 0 on the compute queue)", output)
+        self.assertIn("Dependency levels: 3", output)
+        self.assertIn("Barriers: 7", output)
+        self.assertIn("Peak transient memory: 17.00 KB (sum of all transient resources: 17.00 KB)", output)
+        self.assertIn("reached at pass 1: Read Write Pass", output)
+        self.assertIn("Critical path length: 3 passes\n  Write Pass\n  Read Write Pass\n  Final Pass\n", output)
+        self.assertIn("Culled passes: 1\n  Unused Pass\n", output)
+
+    def test_top_limits_listed_resources(self):
+        result, output = self.run_main(self.write_graph(GRAPH), '--top', '1')
+        self.assertEqual(result, 0)
+        self.assertIn("texture TextureA", output)
+        self.assertNotIn("texture TextureB", output)
+        self.assertIn("... 2 more", output)
+
+    def test_unsupported_version(self):
+        graph = copy.deepcopy(GRAPH)
+        graph['version'] = 1
+        self.assertEqual(self.run_main(self.write_graph(graph))[0], 2)
+        self.assertEqual(self.run_main(os.path.join(self.temp_dir, 'missing.json'))[0], 2)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,116 @@
+# Tools/test_generate_cmake.py
+#
+# Unit tests of generate_cmake.py, every test generates into its own temporary folder.
+#
+#   python Adria/Tools/test_generate_cmake.py
+
+import contextlib
+import io
+import os
+import shutil
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import generate_cmake
+
+
+def write_file(path, contents=""):
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, 'w', encoding='utf-8', newline='\n') as f:
+        f.write(contents)
+
+
+class GenerateCMakeTests(unittest.TestCase):
+
+    def setUp(self):
+        self.temp_dir = tempfile.mkdtemp(prefix='adria_generate_cmake_')
+        self.source_dir = os.path.join(self.temp_dir, 'Engine')
+        self.output_dir = os.path.join(self.temp_dir, 'cmake')
+        for path in ('Core/Engine.cpp', 'Core/Engine.h', 'Core/Sub/Inline.inl', 'Core/notes.txt',
+                     'Graphics/Device.hpp', 'Graphics/Device.cpp',
+                     'Tools/Tool.cpp', 'Saved/Saved.cpp', 'Resources/Shader.h', '.hidden/Hidden.cpp'):
+            write_file(os.path.join(self.source_dir, path))
+        os.makedirs(os.path.join(self.source_dir, 'Empty'))
+        write_file(os.path.join(self.source_dir, 'Root.cpp'))
+
+    def tearDown(self):
+        shutil.rmtree(self.temp_dir, ignore_errors=True)
+
+    def run_main(self, *args):
+        """Runs the script's main on the temporary engine folder and returns its exit code."""
+        with contextlib.redirect_stdout(io.StringIO()), contextlib.redirect_stderr(io.StringIO()):
+            return generate_cmake.main(['--source-dir', self.source_dir, '--output-dir', self.output_dir, *args])
+
+    def output_files(self):
+        return sorted(os.listdir(self.output_dir))
+
+    def test_discovers_subsystems(self):
+        subsystems = generate_cmake.discover_subsystems(self.source_dir, generate_cmake.EXCLUDED_DIRS)
+        self.assertEqual(subsystems, ['Core', 'Graphics'])
+        self.assertEqual(generate_cmake.discover_subsystems(self.source_dir, set(generate_cmake.EXCLUDED_DIRS) | {'Core'}), ['Graphics'])
+
+    def test_collects_sorted_sources(self):
+        self.assertEqual(generate_cmake.collect_sources(os.path.join(self.source_dir, 'Core')),
+                         ['Engine.cpp', 'Engine.h', 'Sub/Inline.inl'])
+
+    def test_generates_lists(self):
+        self.assertEqual(self.run_main(), 0)
+        self.assertEqual(self.output_files(), ['CoreFiles.cmake', 'GraphicsFiles.cmake'])
+        expected = (generate_cmake.HEADER_LINE + "\n"
+                    "set(ADRIA_CORE_SOURCES\n"
+                    '    "${CMAKE_CURRENT_SOURCE_DIR}/Core/Engine.cpp"\n'
+                    '    "${CMAKE_CURRENT_SOURCE_DIR}/Core/Engine.h"\n'
+                    '    "${CMAKE_CURRENT_SOURCE_DIR}/Core/Sub/Inline.inl"\n'
+                    ")\n")
+        self.assertEqual(generate_cmake.read_file(os.path.join(self.output_dir, 'CoreFiles.cmake')), expected)
+
+    def test_output_is_deterministic(self):
+        self.assertEqual(self.run_main(), 0)
+        first = {name: generate_cmake.read_file(os.path.join(self.output_dir, name)) for name in self.output_files()}
+        self.assertEqual(self.run_main(), 0)
+        second = {name: generate_cmake.read_file(os.path.join(self.output_dir, name)) for name in self.output_files()}
+        self.assertEqual(first, second)
+
+    def test_check(self):
+        self.assertEqual(self.run_main('--check'), 1)
+        self.assertFalse(os.path.exists(self.output_dir))
+        self.assertEqual(self.run_main(), 0)
+        self.assertEqual(self.run_main('--check'), 0)
+
+        #a new source file makes the list out of date
+        write_file(os.path.join(self.source_dir, 'Graphics/Buffer.cpp'))
+        self.assertEqual(self.run_main('--check'), 1)
+        self.assertEqual(self.run_main(), 0)
+        self.assertEqual(self.run_main('--check'), 0)
+
+        #so does a hand edit
+        with open(os.path.join(self.output_dir, 'CoreFiles.cmake'), 'a', encoding='utf-8', newline='\n') as f:
+            f.write("# edit\n")
+        self.assertEqual(self.run_main('--check'), 1)
+
+    def test_stale_lists_are_removed(self):
+        self.assertEqual(self.run_main(), 0)
+        write_file(os.path.join(self.output_dir, 'Custom.cmake'), "set(X)\n")
+        write_file(os.path.join(self.output_dir, 'HandWrittenFiles.cmake'), "set(Y)\n")
+        shutil.rmtree(os.path.join(self.source_dir, 'Graphics'))
+
+        self.assertEqual(self.run_main('--check'), 1)
+        self.assertEqual(self.run_main(), 0)
+        #only generated lists are removed
+        self.assertEqual(self.output_files(), ['CoreFiles.cmake', 'Custom.cmake', 'HandWrittenFiles.cmake'])
+        self.assertEqual(self.run_main('--check'), 0)
+
+    def test_exclude(self):
+        self.assertEqual(self.run_main('--exclude', 'Graphics'), 0)
+        self.assertEqual(self.output_files(), ['CoreFiles.cmake'])
+
+    def test_missing_source_dir(self):
+        self.source_dir = os.path.join(self.temp_dir, 'Missing')
+        self.assertEqual(self.run_main(), 2)
+        self.assertFalse(os.path.exists(self.output_dir))
+
+
+if __name__ == '__main__':
+    unittest.main()
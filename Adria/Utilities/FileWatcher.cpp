@@ -0,0 +1,115 @@
+#include "FileWatcher.h"
+
+namespace fs = std::filesystem;
+
+namespace adria
+{
+	namespace
+	{
+		class PollingFileWatcherBackend final : public IFileWatcherBackend
+		{
+		public:
+			virtual Bool AddPathToWatch(std::string const& path, Bool recursive) override
+			{
+				std::error_code ec;
+				if (recursive)
+				{
+					for (auto& entry : fs::recursive_directory_iterator(path, ec))
+					{
+						if (entry.is_regular_file()) files_map[entry.path().string()] = entry.last_write_time(ec);
+					}
+				}
+				else
+				{
+					for (auto& entry : fs::directory_iterator(path, ec))
+					{
+						if (entry.is_regular_file()) files_map[entry.path().string()] = entry.last_write_time(ec);
+					}
+				}
+				return !ec;
+			}
+
+			virtual void PollChanges(std::vector<std::string>& changed_files) override
+			{
+				for (auto& [file, last_write_time] : files_map)
+				{
+					std::error_code ec;
+					fs::file_time_type const current_last_write_time = fs::last_write_time(file, ec);
+					if (!ec && current_last_write_time != last_write_time)
+					{
+						last_write_time = current_last_write_time;
+						changed_files.push_back(file);
+					}
+				}
+			}
+
+		private:
+			std::unordered_map<std::string, fs::file_time_type> files_map;
+		};
+	}
+
+	std::unique_ptr<IFileWatcherBackend> CreatePollingFileWatcherBackend()
+	{
+		return std::make_unique<PollingFileWatcherBackend>();
+	}
+
+	FileWatcher::FileWatcher(Bool force_polling, std::chrono::milliseconds debounce_interval)
+		: debounce_interval(debounce_interval)
+	{
+		if (!force_polling) backend = CreatePlatformFileWatcherBackend();
+		if (!backend) backend = CreatePollingFileWatcherBackend();
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+		file_modified_event.RemoveAll();
+	}
+
+	void FileWatcher::AddPathToWatch(std::string const& path, Bool recursive)
+	{
+		watched_paths.emplace_back(path, recursive);
+		if (!backend->AddPathToWatch(path, recursive))
+		{
+			FallbackToPolling();
+		}
+	}
+
+	void FileWatcher::CheckWatchedFiles()
+	{
+		changed_files.clear();
+		backend->PollChanges(changed_files);
+
+		//editors often save through several operations (write temp, rename, touch), coalesce them into one notification
+		auto const now = std::chrono::steady_clock::now();
+		for (std::string& file : changed_files)
+		{
+			pending_changes[std::move(file)] = now;
+		}
+
+		for (auto it = pending_changes.begin(); it != pending_changes.end();)
+		{
+			if (now - it->second < debounce_interval)
+			{
+				++it;
+				continue;
+			}
+
+			std::string const file = it->first;
+			it = pending_changes.erase(it);
+			std::error_code ec;
+			if (fs::is_regular_file(file, ec))
+			{
+				file_modified_event.Broadcast(file);
+			}
+		}
+	}
+
+	void FileWatcher::FallbackToPolling()
+	{
+		backend = CreatePollingFileWatcherBackend();
+		for (auto const& [path, recursive] : watched_paths)
+		{
+			backend->AddPathToWatch(path, recursive);
+		}
+	}
+}
@@ -10,50 +10,44 @@ namespace adria
 		Deleted
 	};
 
+	class IFileWatcherBackend
+	{
+	public:
+		virtual ~IFileWatcherBackend() = default;
+		virtual Bool AddPathToWatch(std::string const& path, Bool recursive) = 0;
+		//appends the files changed since the last call, must not block
+		virtual void PollChanges(std::vector<std::string>& changed_files) = 0;
+	};
+
+	//returns nullptr on platforms without a native change notification API
+	std::unique_ptr<IFileWatcherBackend> CreatePlatformFileWatcherBackend();
+	std::unique_ptr<IFileWatcherBackend> CreatePollingFileWatcherBackend();
+
 	DECLARE_EVENT(FileModifiedEvent, FileWatcher, std::string const&)
 	class FileWatcher
 	{
 	public:
-		FileWatcher() = default;
-		~FileWatcher()
-		{
-			file_modified_event.RemoveAll();
-		}
-
-		void AddPathToWatch(std::string const& path, Bool recursive = true)
-		{
-			if (recursive)
-			{
-				for (auto& path : std::filesystem::recursive_directory_iterator(path))
-				{
-					if (path.is_regular_file()) files_map[path.path().string()] = std::filesystem::last_write_time(path);
-				}
-			}
-			else
-			{
-				for (auto& path : std::filesystem::directory_iterator(path))
-				{
-					if (path.is_regular_file()) files_map[path.path().string()] = std::filesystem::last_write_time(path);
-				}
-			}
-		}
-		void CheckWatchedFiles()
-		{
-			for (auto const& [file, ft] : files_map)
-			{
-				auto current_file_last_write_time = std::filesystem::last_write_time(file);
-				if (files_map[file] != current_file_last_write_time)
-				{
-					files_map[file] = current_file_last_write_time;
-					file_modified_event.Broadcast(file);
-				}
-			}
-		}
+		static constexpr std::chrono::milliseconds DefaultDebounceInterval{ 100 };
+
+	public:
+		explicit FileWatcher(Bool force_polling = false, std::chrono::milliseconds debounce_interval = DefaultDebounceInterval);
+		ADRIA_NONCOPYABLE_NONMOVABLE(FileWatcher)
+		~FileWatcher();
+
+		void AddPathToWatch(std::string const& path, Bool recursive = true);
+		void CheckWatchedFiles();
 
 		FileModifiedEvent& GetFileModifiedEvent() { return file_modified_event; }
 
 	private:
-		std::unordered_map<std::string, std::filesystem::file_time_type> files_map;
+		std::unique_ptr<IFileWatcherBackend> backend;
+		std::chrono::milliseconds debounce_interval;
+		std::vector<std::pair<std::string, Bool>> watched_paths;
+		std::vector<std::string> changed_files;
+		std::unordered_map<std::string, std::chrono::steady_clock::time_point> pending_changes;
 		FileModifiedEvent file_modified_event;
+
+	private:
+		void FallbackToPolling();
 	};
-}
\ No newline at end of file
+}
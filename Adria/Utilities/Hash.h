@@ -77,4 +77,99 @@ namespace adria
 	{
 		return crc::crc64_impl(_str, N);
 	}
+
+	struct Hash128
+	{
+		Uint64 low = 0;
+		Uint64 high = 0;
+
+		Bool operator==(Hash128 const&) const = default;
+	};
+
+	struct Hash128Hasher
+	{
+		Uint64 operator()(Hash128 const& h) const
+		{
+			return h.low ^ (h.high * 0x9e3779b97f4a7c15ull);
+		}
+	};
+
+	namespace murmur
+	{
+		inline constexpr Uint64 Rotl64(Uint64 x, Int8 r)
+		{
+			return (x << r) | (x >> (64 - r));
+		}
+		inline constexpr Uint64 Fmix64(Uint64 k)
+		{
+			k ^= k >> 33;
+			k *= 0xff51afd7ed558ccdull;
+			k ^= k >> 33;
+			k *= 0xc4ceb9fe1a85ec53ull;
+			k ^= k >> 33;
+			return k;
+		}
+		inline Uint64 Load64(Uint8 const* p)
+		{
+			Uint64 v;
+			memcpy(&v, p, sizeof(Uint64));
+			return v;
+		}
+	}
+
+	//MurmurHash3_x64_128, https://github.com/aappleby/smhasher
+	inline Hash128 murmur3_128(void const* data, Uint64 size, Uint64 seed = 0)
+	{
+		using namespace murmur;
+		Uint8 const* bytes = static_cast<Uint8 const*>(data);
+		Uint64 const block_count = size / 16;
+
+		Uint64 h1 = seed;
+		Uint64 h2 = seed;
+		constexpr Uint64 c1 = 0x87c37b91114253d5ull;
+		constexpr Uint64 c2 = 0x4cf5ad432745937full;
+
+		for (Uint64 i = 0; i < block_count; ++i)
+		{
+			Uint64 k1 = Load64(bytes + i * 16);
+			Uint64 k2 = Load64(bytes + i * 16 + 8);
+
+			k1 *= c1; k1 = Rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+			h1 = Rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+			k2 *= c2; k2 = Rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+			h2 = Rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+		}
+
+		Uint8 const* tail = bytes + block_count * 16;
+		Uint64 k1 = 0;
+		Uint64 k2 = 0;
+		switch (size & 15)
+		{
+		case 15: k2 ^= Uint64(tail[14]) << 48; [[fallthrough]];
+		case 14: k2 ^= Uint64(tail[13]) << 40; [[fallthrough]];
+		case 13: k2 ^= Uint64(tail[12]) << 32; [[fallthrough]];
+		case 12: k2 ^= Uint64(tail[11]) << 24; [[fallthrough]];
+		case 11: k2 ^= Uint64(tail[10]) << 16; [[fallthrough]];
+		case 10: k2 ^= Uint64(tail[9]) << 8;   [[fallthrough]];
+		case  9: k2 ^= Uint64(tail[8]);
+				 k2 *= c2; k2 = Rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+				 [[fallthrough]];
+		case  8: k1 ^= Uint64(tail[7]) << 56;  [[fallthrough]];
+		case  7: k1 ^= Uint64(tail[6]) << 48;  [[fallthrough]];
+		case  6: k1 ^= Uint64(tail[5]) << 40;  [[fallthrough]];
+		case  5: k1 ^= Uint64(tail[4]) << 32;  [[fallthrough]];
+		case  4: k1 ^= Uint64(tail[3]) << 24;  [[fallthrough]];
+		case  3: k1 ^= Uint64(tail[2]) << 16;  [[fallthrough]];
+		case  2: k1 ^= Uint64(tail[1]) << 8;   [[fallthrough]];
+		case  1: k1 ^= Uint64(tail[0]);
+				 k1 *= c1; k1 = Rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+		}
+
+		h1 ^= size; h2 ^= size;
+		h1 += h2; h2 += h1;
+		h1 = Fmix64(h1); h2 = Fmix64(h2);
+		h1 += h2; h2 += h1;
+		return Hash128{ .low = h1, .high = h2 };
+	}
 }
\ No newline at end of file
@@ -1,8 +1,52 @@
 #include "Heightmap.h"
+#include "ThreadPool.h"
+#include "PathHelpers.h"
+#include "StringConversions.h"
 #include "Cpp/FastNoiseLite.h"
+#include <stb_image.h>
+#include <random>
 
 namespace adria
 {
+	ADRIA_LOG_CHANNEL(Scene);
+
+	namespace
+	{
+		//noise is generated in square tiles, a task gets at least a few of them so the task overhead stays negligible
+		constexpr Uint64 TileSize = 128;
+		constexpr Uint64 ParallelMinTiles = 4;
+		constexpr Uint64 ParallelMinRows = 64;
+
+		//runs task(begin, end) over disjoint ranges of [0, count), part of them on the thread pool.
+		//the ranges only decide who computes what, never the result
+		template<typename F>
+		void ParallelFor(Uint64 count, Uint64 min_count_per_task, F const& task)
+		{
+			Uint64 const task_count = std::min<Uint64>(count / min_count_per_task, std::max(std::thread::hardware_concurrency(), 1u));
+			if (task_count <= 1)
+			{
+				task(0, count);
+				return;
+			}
+
+			Uint64 const count_per_task = (count + task_count - 1) / task_count;
+			std::vector<std::future<void>> task_futures;
+			task_futures.reserve(task_count - 1);
+			for (Uint64 begin = count_per_task; begin < count; begin += count_per_task)
+			{
+				task_futures.push_back(g_ThreadPool.Submit(task, begin, std::min(begin + count_per_task, count)));
+			}
+			task(0, count_per_task);
+			for (auto& task_future : task_futures) task_future.get();
+		}
+
+		std::pair<Float, Float> GetHeightRange(std::vector<Float> const& heights)
+		{
+			auto const [min_it, max_it] = std::minmax_element(heights.begin(), heights.end());
+			return { *min_it, *max_it };
+		}
+	}
+
 	constexpr FastNoiseLite::NoiseType GetNoiseType(NoiseType type)
 	{
 		switch (type)
@@ -42,47 +86,291 @@ namespace adria
 		return FastNoiseLite::FractalType_None;
 	}
 
-	Heightmap::Heightmap(HeightmapDesc const& desc)
+	Heightmap::Heightmap(HeightmapDesc const& desc) : width(desc.width), depth(desc.depth)
 	{
-		FastNoiseLite noise{};
-		noise.SetFractalType(GetFractalType(desc.fractal_type));
-		noise.SetSeed(desc.seed);
-		noise.SetNoiseType(GetNoiseType(desc.noise_type));
-		noise.SetFractalOctaves(desc.octaves);
-		noise.SetFractalLacunarity(desc.lacunarity);
-		noise.SetFractalGain(desc.persistence);
-		noise.SetFrequency(0.1f);
-		heightmap.resize(desc.depth);
-
-		for (Uint32 z = 0; z < desc.depth; z++)
-		{
-			heightmap[z].resize(desc.width);
-			for (Uint32 x = 0; x < desc.width; x++)
-			{
+		heights.resize(width * depth);
 
-				Float xf = x * desc.noise_scale / desc.width; 
-				Float zf = z * desc.noise_scale / desc.depth; 
+		Uint64 const tile_count_x = (width + TileSize - 1) / TileSize;
+		Uint64 const tile_count_z = (depth + TileSize - 1) / TileSize;
+		ParallelFor(tile_count_x * tile_count_z, ParallelMinTiles, [&](Uint64 tile_begin, Uint64 tile_end)
+			{
+				FastNoiseLite noise{};
+				noise.SetFractalType(GetFractalType(desc.fractal_type));
+				noise.SetSeed(desc.seed);
+				noise.SetNoiseType(GetNoiseType(desc.noise_type));
+				noise.SetFractalOctaves(desc.octaves);
+				noise.SetFractalLacunarity(desc.lacunarity);
+				noise.SetFractalGain(desc.persistence);
+				noise.SetFrequency(0.1f);
 
-				Float total = noise.GetNoise(xf, zf);
+				for (Uint64 tile = tile_begin; tile < tile_end; ++tile)
+				{
+					Uint64 const x_begin = (tile % tile_count_x) * TileSize;
+					Uint64 const z_begin = (tile / tile_count_x) * TileSize;
+					Uint64 const x_end = std::min(x_begin + TileSize, width);
+					Uint64 const z_end = std::min(z_begin + TileSize, depth);
+					for (Uint64 z = z_begin; z < z_end; ++z)
+					{
+						Float const zf = z * desc.noise_scale / desc.depth;
+						Float* row = heights.data() + z * width;
+						for (Uint64 x = x_begin; x < x_end; ++x)
+						{
+							Float const xf = x * desc.noise_scale / desc.width;
+							row[x] = noise.GetNoise(xf, zf) * desc.max_height;
+						}
+					}
+				}
+			});
 
-				heightmap[z][x] = total * desc.max_height;
-			}
+		if (desc.hydraulic_erosion)
+		{
+			ApplyHydraulicErosion(*desc.hydraulic_erosion);
+		}
+		if (desc.thermal_erosion)
+		{
+			ApplyThermalErosion(*desc.thermal_erosion);
 		}
 	}
-	Heightmap::Heightmap(std::string_view heightmap_path)
+
+	Heightmap::Heightmap(std::string_view heightmap_path, Float max_height, Uint32 raw_width)
 	{
-		ADRIA_TODO("Add support for heightmap files");
+		std::string const extension = ToLower(GetExtension(heightmap_path));
+		Bool const result = extension == ".raw" || extension == ".r16" ? LoadFromRaw(heightmap_path, max_height, raw_width) : LoadFromImage(heightmap_path, max_height);
+		if (!result)
+		{
+			ADRIA_LOG(ERROR, "Failed to load heightmap %s, using a flat one", heightmap_path.data());
+			width = depth = 2;
+			heights.assign(width * depth, 0.0f);
+		}
 	}
-	Float Heightmap::HeightAt(Uint64 x, Uint64 z)
+
+	Float Heightmap::SampleHeight(Float u, Float v) const
 	{
-		return heightmap[z][x];
+		Float const x = std::clamp(u, 0.0f, 1.0f) * (width - 1);
+		Float const z = std::clamp(v, 0.0f, 1.0f) * (depth - 1);
+		Uint64 const x0 = std::min((Uint64)x, width - 1), z0 = std::min((Uint64)z, depth - 1);
+		Uint64 const x1 = std::min(x0 + 1, width - 1), z1 = std::min(z0 + 1, depth - 1);
+		Float const tx = x - x0, tz = z - z0;
+		Float const h0 = HeightAt(x0, z0) * (1.0f - tx) + HeightAt(x1, z0) * tx;
+		Float const h1 = HeightAt(x0, z1) * (1.0f - tx) + HeightAt(x1, z1) * tx;
+		return h0 * (1.0f - tz) + h1 * tz;
 	}
+
 	Uint64 Heightmap::Width() const
 	{
-		return heightmap[0].size();
+		return width;
 	}
+
 	Uint64 Heightmap::Depth() const
 	{
-		return heightmap.size();
+		return depth;
+	}
+
+	void Heightmap::ApplyHydraulicErosion(HydraulicErosionDesc const& desc)
+	{
+		//droplets run one after another since each one erodes the terrain the next one flows over, which keeps the result deterministic
+		if (width < 3 || depth < 3) return;
+		auto const [min_height, max_height] = GetHeightRange(heights);
+		Float const height_range = max_height - min_height;
+		if (height_range <= 0.0f) return;
+
+		std::vector<Float> map(heights.size());
+		for (Uint64 i = 0; i < heights.size(); ++i) map[i] = (heights[i] - min_height) / height_range;
+
+		struct BrushTap
+		{
+			Int64 dx, dz;
+			Float weight;
+		};
+		std::vector<BrushTap> brush;
+		Int64 const radius = std::max<Int64>(desc.radius, 1);
+		Float weight_sum = 0.0f;
+		for (Int64 dz = -radius; dz <= radius; ++dz)
+		{
+			for (Int64 dx = -radius; dx <= radius; ++dx)
+			{
+				Float const distance = std::sqrt((Float)(dx * dx + dz * dz));
+				if (distance < radius)
+				{
+					brush.push_back(BrushTap{ dx, dz, radius - distance });
+					weight_sum += radius - distance;
+				}
+			}
+		}
+		for (BrushTap& tap : brush) tap.weight /= weight_sum;
+
+		auto HeightAndGradient = [&](Float x, Float z)
+			{
+				Uint64 const cx = (Uint64)x, cz = (Uint64)z;
+				Float const tx = x - cx, tz = z - cz;
+				Uint64 const index = cz * width + cx;
+				Float const h00 = map[index], h10 = map[index + 1];
+				Float const h01 = map[index + width], h11 = map[index + width + 1];
+				Float const gradient_x = (h10 - h00) * (1.0f - tz) + (h11 - h01) * tz;
+				Float const gradient_z = (h01 - h00) * (1.0f - tx) + (h11 - h10) * tx;
+				Float const height = h00 * (1.0f - tx) * (1.0f - tz) + h10 * tx * (1.0f - tz) + h01 * (1.0f - tx) * tz + h11 * tx * tz;
+				return std::array<Float, 3>{ height, gradient_x, gradient_z };
+			};
+
+		//raw engine output instead of std distributions, those produce different values on different standard libraries
+		std::mt19937 rng((Uint32)desc.seed);
+		auto Random = [&rng]() { return (Float)(rng() >> 8) / (Float)(1u << 24); };
+		Float const max_x = (Float)(width - 1), max_z = (Float)(depth - 1);
+		for (Uint32 droplet = 0; droplet < desc.droplet_count; ++droplet)
+		{
+			Float x = Random() * max_x, z = Random() * max_z;
+			Float dir_x = 0.0f, dir_z = 0.0f;
+			Float speed = 1.0f, water = 1.0f, sediment = 0.0f;
+			for (Uint32 step = 0; step < desc.max_lifetime; ++step)
+			{
+				Uint64 const cx = std::min((Uint64)x, width - 2), cz = std::min((Uint64)z, depth - 2);
+				Float const tx = x - cx, tz = z - cz;
+				auto const [height, gradient_x, gradient_z] = HeightAndGradient(x, z);
+
+				dir_x = dir_x * desc.inertia - gradient_x * (1.0f - desc.inertia);
+				dir_z = dir_z * desc.inertia - gradient_z * (1.0f - desc.inertia);
+				Float const length = std::sqrt(dir_x * dir_x + dir_z * dir_z);
+				if (length == 0.0f) break;
+				dir_x /= length, dir_z /= length;
+				x += dir_x, z += dir_z;
+				if (x < 0.0f || z < 0.0f || x >= max_x || z >= max_z) break;
+
+				Float const delta_height = HeightAndGradient(x, z)[0] - height;
+				Float const capacity = std::max(-delta_height * speed * water * desc.sediment_capacity, desc.min_sediment_capacity);
+				if (sediment > capacity || delta_height > 0.0f)
+				{
+					Float const deposit = delta_height > 0.0f ? std::min(delta_height, sediment) : (sediment - capacity) * desc.deposit_speed;
+					sediment -= deposit;
+					Uint64 const index = cz * width + cx;
+					map[index] += deposit * (1.0f - tx) * (1.0f - tz);
+					map[index + 1] += deposit * tx * (1.0f - tz);
+					map[index + width] += deposit * (1.0f - tx) * tz;
+					map[index + width + 1] += deposit * tx * tz;
+				}
+				else
+				{
+					Float const erode = std::min((capacity - sediment) * desc.erode_speed, -delta_height);
+					for (BrushTap const& tap : brush)
+					{
+						Int64 const bx = (Int64)cx + tap.dx, bz = (Int64)cz + tap.dz;
+						if (bx < 0 || bz < 0 || bx >= (Int64)width || bz >= (Int64)depth) continue;
+						Float& cell = map[bz * width + bx];
+						Float const eroded = std::min(cell, erode * tap.weight);
+						cell -= eroded;
+						sediment += eroded;
+					}
+				}
+				speed = std::sqrt(std::max(speed * speed - delta_height * desc.gravity, 0.0f));
+				water *= 1.0f - desc.evaporate_speed;
+			}
+		}
+
+		for (Uint64 i = 0; i < heights.size(); ++i) heights[i] = map[i] * height_range + min_height;
+	}
+
+	void Heightmap::ApplyThermalErosion(ThermalErosionDesc const& desc)
+	{
+		//every iteration first computes how much each cell sheds and then gathers it in the neighbors,
+		//both passes only read the previous iteration so rows can be processed in any order
+		auto const [min_height, max_height] = GetHeightRange(heights);
+		Float const talus = desc.talus * (max_height - min_height);
+		if (max_height - min_height <= 0.0f) return;
+
+		std::vector<Float> eroded_heights(heights.size());
+		std::vector<Float> moved(heights.size());
+		std::vector<Float> moved_per_difference(heights.size());
+		Int64 const w = (Int64)width, d = (Int64)depth;
+		Int64 const neighbor_dx[] = { -1, 1, 0, 0 };
+		Int64 const neighbor_dz[] = { 0, 0, -1, 1 };
+		for (Uint32 iteration = 0; iteration < desc.iterations; ++iteration)
+		{
+			Float const* source = heights.data();
+			Float* destination = eroded_heights.data();
+			ParallelFor(depth, ParallelMinRows, [&](Uint64 z_begin, Uint64 z_end)
+				{
+					for (Int64 z = (Int64)z_begin; z < (Int64)z_end; ++z)
+					{
+						for (Int64 x = 0; x < w; ++x)
+						{
+							Float const height = source[z * w + x];
+							Float max_difference = 0.0f, difference_sum = 0.0f;
+							for (Uint32 n = 0; n < 4; ++n)
+							{
+								Int64 const nx = x + neighbor_dx[n], nz = z + neighbor_dz[n];
+								if (nx < 0 || nz < 0 || nx >= w || nz >= d) continue;
+								Float const difference = height - source[nz * w + nx];
+								if (difference > talus)
+								{
+									max_difference = std::max(max_difference, difference);
+									difference_sum += difference;
+								}
+							}
+							Float const cell_moved = difference_sum > 0.0f ? desc.strength * (max_difference - talus) * 0.5f : 0.0f;
+							moved[z * w + x] = cell_moved;
+							moved_per_difference[z * w + x] = difference_sum > 0.0f ? cell_moved / difference_sum : 0.0f;
+						}
+					}
+				});
+
+			ParallelFor(depth, ParallelMinRows, [&](Uint64 z_begin, Uint64 z_end)
+				{
+					for (Int64 z = (Int64)z_begin; z < (Int64)z_end; ++z)
+					{
+						for (Int64 x = 0; x < w; ++x)
+						{
+							Float const height = source[z * w + x];
+							Float gathered = 0.0f;
+							for (Uint32 n = 0; n < 4; ++n)
+							{
+								Int64 const nx = x + neighbor_dx[n], nz = z + neighbor_dz[n];
+								if (nx < 0 || nz < 0 || nx >= w || nz >= d) continue;
+								Int64 const neighbor = nz * w + nx;
+								Float const difference = source[neighbor] - height;
+								if (difference > talus) gathered += moved_per_difference[neighbor] * difference;
+							}
+							destination[z * w + x] = height - moved[z * w + x] + gathered;
+						}
+					}
+				});
+			std::swap(heights, eroded_heights);
+		}
+	}
+
+	Bool Heightmap::LoadFromImage(std::string_view heightmap_path, Float max_height)
+	{
+		Int _width, _height, components;
+		Uint16* pixels = stbi_load_16(heightmap_path.data(), &_width, &_height, &components, 1);
+		if (pixels == nullptr) return false;
+
+		width = (Uint64)_width;
+		depth = (Uint64)_height;
+		heights.resize(width * depth);
+		for (Uint64 i = 0; i < heights.size(); ++i) heights[i] = pixels[i] / 65535.0f * max_height;
+		stbi_image_free(pixels);
+		return true;
+	}
+
+	Bool Heightmap::LoadFromRaw(std::string_view heightmap_path, Float max_height, Uint32 raw_width)
+	{
+		std::ifstream file(heightmap_path.data(), std::ios::binary | std::ios::ate);
+		if (!file) return false;
+
+		Uint64 const sample_count = (Uint64)file.tellg() / sizeof(Uint16);
+		Uint64 const raw_side = raw_width != 0 ? raw_width : (Uint64)std::llround(std::sqrt((Float64)sample_count));
+		if (raw_side < 2 || sample_count % raw_side != 0 || (raw_width == 0 && raw_side * raw_side != sample_count)) return false;
+
+		std::vector<Uint8> bytes(sample_count * sizeof(Uint16));
+		file.seekg(0);
+		if (!file.read(reinterpret_cast<Char*>(bytes.data()), bytes.size())) return false;
+
+		width = raw_side;
+		depth = sample_count / raw_side;
+		heights.resize(sample_count);
+		for (Uint64 i = 0; i < sample_count; ++i)
+		{
+			Uint16 const sample = (Uint16)(bytes[2 * i] | (bytes[2 * i + 1] << 8));
+			heights[i] = sample / 65535.0f * max_height;
+		}
+		return true;
 	}
-}
\ No newline at end of file
+}
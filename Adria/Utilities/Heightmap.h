@@ -18,6 +18,29 @@ namespace adria
 		Ridged,
 		PingPong
 	};
+
+	//heights are eroded relative to the height range of the map, so the parameters don't depend on max_height
+	struct ThermalErosionDesc
+	{
+		Uint32 iterations = 50;
+		Float talus = 0.004f;		//height difference between neighbors, as a fraction of the height range, above which material slides
+		Float strength = 0.5f;		//fraction of the excess moved per iteration
+	};
+	struct HydraulicErosionDesc
+	{
+		Uint32 droplet_count = 50000;
+		Uint32 max_lifetime = 30;
+		Int32 seed = 1337;
+		Uint32 radius = 3;
+		Float inertia = 0.05f;
+		Float sediment_capacity = 4.0f;
+		Float min_sediment_capacity = 0.01f;
+		Float erode_speed = 0.3f;
+		Float deposit_speed = 0.3f;
+		Float evaporate_speed = 0.01f;
+		Float gravity = 4.0f;
+	};
+
 	struct HeightmapDesc
 	{
 		Uint32 width;
@@ -30,19 +53,39 @@ namespace adria
 		Float lacunarity = 2.0f;
 		Int32 octaves = 3;
 		Float noise_scale = 10;
+		std::optional<HydraulicErosionDesc> hydraulic_erosion = std::nullopt;
+		std::optional<ThermalErosionDesc> thermal_erosion = std::nullopt;
 	};
-	
+
 	class Heightmap
 	{
-	public:	
+	public:
+		//noise is generated in tiles spread over the thread pool, the result doesn't depend on the number of threads
 		explicit Heightmap(HeightmapDesc const& desc);
-		explicit Heightmap(std::string_view heightmap_path);
+		//16 bit png (or any other format stb_image loads) and headerless 16 bit little endian .raw/.r16 files.
+		//raw files are assumed square unless raw_width is given, heights are scaled from [0, 1] to [0, max_height]
+		explicit Heightmap(std::string_view heightmap_path, Float max_height = 1.0f, Uint32 raw_width = 0);
 
-		Float HeightAt(Uint64 x, Uint64 z);
+		Float HeightAt(Uint64 x, Uint64 z) const
+		{
+			return heights[z * width + x];
+		}
+		//bilinear sample, u and v in [0, 1] span the whole map
+		Float SampleHeight(Float u, Float v) const;
 		Uint64 Width() const;
 		Uint64 Depth() const;
+		Float const* Data() const { return heights.data(); }
+
+		void ApplyHydraulicErosion(HydraulicErosionDesc const& desc);
+		void ApplyThermalErosion(ThermalErosionDesc const& desc);
+
+	private:
+		std::vector<Float> heights;
+		Uint64 width = 0;
+		Uint64 depth = 0;
 
 	private:
-		std::vector<std::vector<Float>> heightmap;
+		Bool LoadFromImage(std::string_view heightmap_path, Float max_height);
+		Bool LoadFromRaw(std::string_view heightmap_path, Float max_height, Uint32 raw_width);
 	};
-}
\ No newline at end of file
+}
@@ -2,7 +2,6 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #include "Utilities/PathHelpers.h"
-#include "Utilities/StringConversions.h"
 
 namespace adria
 {
@@ -45,10 +44,6 @@ namespace adria
 			else
 				return ImageFormat::NotSupported;
 		}
-		ImageFormat GetImageFormat(std::wstring_view path)
-		{
-			return GetImageFormat(ToString(std::wstring(path)));
-		}
 	}
 
 	Image::Image(std::string_view file_path)
@@ -92,15 +87,17 @@ namespace adria
 	{
 		//https://github.com/simco50/D3D12_Research/blob/master/D3D12/Content/Image.cpp - LoadDDS
 
-		FILE* file = nullptr;
-		fopen_s(&file, texture_path.data(), "rb");
+		std::string const path(texture_path);
+		FILE* file = fopen(path.c_str(), "rb");
 		if (!file)
 			return false;
 
 		fseek(file, 0, SEEK_END);
 		std::vector<Char> data((Uint64)ftell(file));
 		fseek(file, 0, SEEK_SET);
-		fread(data.data(), data.size(), 1, file);
+		Uint64 const read_size = fread(data.data(), 1, data.size(), file);
+		fclose(file);
+		if (read_size != data.size()) return false;
 
 		Char* bytes = data.data();
 #pragma pack(push,1)
@@ -162,7 +159,7 @@ namespace adria
 		auto MakeFourCC = [](Uint32 a, Uint32 b, Uint32 c, Uint32 d) { return a | (b << 8u) | (c << 16u) | (d << 24u); };
 
 		constexpr const Char magic[] = "DDS ";
-		if (memcmp(magic, bytes, 4) != 0) return false;
+		if (data.size() < 4 + sizeof(FileHeader) || memcmp(magic, bytes, 4) != 0) return false;
 		bytes += 4;
 
 		const FileHeader* dds_header = (FileHeader*)bytes;
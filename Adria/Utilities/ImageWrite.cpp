@@ -1,21 +1,144 @@
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image_write.h"
 #include "ImageWrite.h"
+#include "FloatCompressor.h"
 
 namespace adria
 {
+	namespace
+	{
+		template<typename T>
+		T ReadComponent(Uint8 const* pixel, Uint32 component)
+		{
+			T value;
+			memcpy(&value, pixel + component * sizeof(T), sizeof(T));
+			return value;
+		}
+
+		Float ReadComponentAsFloat(Uint8 const* pixel, Uint32 component, ImageDataFormat format)
+		{
+			switch (format)
+			{
+			case ImageDataFormat::RGBA8:	return pixel[component] / 255.0f;
+			case ImageDataFormat::RGBA16F:	return FloatCompressor::Decompress(ReadComponent<Uint16>(pixel, component));
+			case ImageDataFormat::RGBA32F:	return ReadComponent<Float>(pixel, component);
+			}
+			return 0.0f;
+		}
+
+		Uint8 FloatToUnorm8(Float value)
+		{
+			//also maps NaN to 0
+			value = value > 0.0f ? std::min(value, 1.0f) : 0.0f;
+			return (Uint8)(value * 255.0f + 0.5f);
+		}
+	}
+
+	Char const* GetFileTypeExtension(FileType type)
+	{
+		switch (type)
+		{
+		case FileType::PNG: return ".png";
+		case FileType::JPG: return ".jpg";
+		case FileType::HDR: return ".hdr";
+		case FileType::TGA: return ".tga";
+		case FileType::BMP: return ".bmp";
+		}
+		return "";
+	}
+
+	Uint32 GetImageDataFormatStride(ImageDataFormat format)
+	{
+		switch (format)
+		{
+		case ImageDataFormat::RGBA8:	return 4;
+		case ImageDataFormat::RGBA16F:	return 8;
+		case ImageDataFormat::RGBA32F:	return 16;
+		}
+		return 0;
+	}
+
+	void UnpackImageRows(void const* data, Uint32 width, Uint32 height, Uint32 row_pitch, ImageDataFormat format, std::vector<Uint8>& rgba8)
+	{
+		Uint32 const stride = GetImageDataFormatStride(format);
+		ADRIA_ASSERT(row_pitch >= width * stride);
+
+		rgba8.resize((Uint64)width * height * 4);
+		Uint8 const* src = static_cast<Uint8 const*>(data);
+		for (Uint32 y = 0; y < height; ++y)
+		{
+			Uint8 const* src_row = src + (Uint64)y * row_pitch;
+			Uint8* dst_row = rgba8.data() + (Uint64)y * width * 4;
+			if (format == ImageDataFormat::RGBA8)
+			{
+				memcpy(dst_row, src_row, (Uint64)width * 4);
+				continue;
+			}
+			for (Uint32 x = 0; x < width; ++x)
+			{
+				for (Uint32 c = 0; c < 4; ++c)
+				{
+					dst_row[x * 4 + c] = FloatToUnorm8(ReadComponentAsFloat(src_row + x * stride, c, format));
+				}
+			}
+		}
+	}
+
+	void UnpackImageRows(void const* data, Uint32 width, Uint32 height, Uint32 row_pitch, ImageDataFormat format, std::vector<Float>& rgba32f)
+	{
+		Uint32 const stride = GetImageDataFormatStride(format);
+		ADRIA_ASSERT(row_pitch >= width * stride);
+
+		rgba32f.resize((Uint64)width * height * 4);
+		Uint8 const* src = static_cast<Uint8 const*>(data);
+		for (Uint32 y = 0; y < height; ++y)
+		{
+			Uint8 const* src_row = src + (Uint64)y * row_pitch;
+			Float* dst_row = rgba32f.data() + (Uint64)y * width * 4;
+			if (format == ImageDataFormat::RGBA32F)
+			{
+				memcpy(dst_row, src_row, (Uint64)width * 16);
+				continue;
+			}
+			for (Uint32 x = 0; x < width; ++x)
+			{
+				for (Uint32 c = 0; c < 4; ++c)
+				{
+					dst_row[x * 4 + c] = ReadComponentAsFloat(src_row + x * stride, c, format);
+				}
+			}
+		}
+	}
 
-	void WriteImageToFile(FileType type, std::string_view filename, Uint32 width, Uint32 height, void const* data, Uint32 stride)
+	Bool WriteImageToFile(FileType type, std::string_view filename, Uint32 width, Uint32 height, void const* data, Uint32 row_pitch, ImageDataFormat format)
 	{
+		std::string const path(filename);
+		if (type == FileType::HDR)
+		{
+			std::vector<Float> pixels;
+			UnpackImageRows(data, width, height, row_pitch, format, pixels);
+			return stbi_write_hdr(path.c_str(), (int)width, (int)height, 4, pixels.data()) != 0;
+		}
+
+		//only png takes a stride, everything else goes through a tightly packed copy
+		std::vector<Uint8> pixels;
+		void const* pixel_data = data;
+		Uint32 pixel_stride = row_pitch;
+		if (format != ImageDataFormat::RGBA8 || (type != FileType::PNG && row_pitch != width * 4))
+		{
+			UnpackImageRows(data, width, height, row_pitch, format, pixels);
+			pixel_data = pixels.data();
+			pixel_stride = width * 4;
+		}
+
 		switch (type)
 		{
-		case FileType::PNG: stbi_write_png(filename.data(), (int)width, (int)height, 4, data, (int)stride); break;
-		case FileType::JPG: stbi_write_jpg(filename.data(), (int)width, (int)height, 4, data, 100); break;
-		case FileType::HDR: stbi_write_hdr(filename.data(), (int)width, (int)height, 4, (Float*)data); break;
-		case FileType::TGA: stbi_write_tga(filename.data(), (int)width, (int)height, 4, data); break;
-		case FileType::BMP: stbi_write_bmp(filename.data(), (int)width, (int)height, 4, data); break;
+		case FileType::PNG: return stbi_write_png(path.c_str(), (int)width, (int)height, 4, pixel_data, (int)pixel_stride) != 0;
+		case FileType::JPG: return stbi_write_jpg(path.c_str(), (int)width, (int)height, 4, pixel_data, 100) != 0;
+		case FileType::TGA: return stbi_write_tga(path.c_str(), (int)width, (int)height, 4, pixel_data) != 0;
+		case FileType::BMP: return stbi_write_bmp(path.c_str(), (int)width, (int)height, 4, pixel_data) != 0;
 		default: ADRIA_UNREACHABLE();
 		}
+		return false;
 	}
 }
-
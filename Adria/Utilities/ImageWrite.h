@@ -11,5 +11,23 @@ namespace adria
 		TGA,
 		BMP
 	};
-	void WriteImageToFile(FileType type, std::string_view filename, Uint32 width, Uint32 height, void const* data, Uint32 stride);
-}
\ No newline at end of file
+	Char const* GetFileTypeExtension(FileType type);
+
+	//layout of the pixels passed to WriteImageToFile, always 4 channels
+	enum class ImageDataFormat : Uint8
+	{
+		RGBA8,
+		RGBA16F,
+		RGBA32F
+	};
+	Uint32 GetImageDataFormatStride(ImageDataFormat format);
+
+	//copy the rows of a pitched image, e.g. a texture readback whose rows are padded to 256 bytes, into tightly packed pixels.
+	//floats are clamped to [0, 1] when unpacking to RGBA8, no tonemapping or gamma correction is applied
+	void UnpackImageRows(void const* data, Uint32 width, Uint32 height, Uint32 row_pitch, ImageDataFormat format, std::vector<Uint8>& rgba8);
+	void UnpackImageRows(void const* data, Uint32 width, Uint32 height, Uint32 row_pitch, ImageDataFormat format, std::vector<Float>& rgba32f);
+
+	//row_pitch is the distance in bytes between the starts of two rows of data.
+	//HDR files are written as floats, the other file types as 8 bit
+	Bool WriteImageToFile(FileType type, std::string_view filename, Uint32 width, Uint32 height, void const* data, Uint32 row_pitch, ImageDataFormat format = ImageDataFormat::RGBA8);
+}
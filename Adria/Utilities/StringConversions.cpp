@@ -1,33 +1,8 @@
 #include <sstream>
-#include <codecvt>
-#include <locale>
 #include "StringConversions.h"
 
 namespace adria
 {
-	std::wstring ToWideString(std::string const& str)
-	{
-		Int num_chars = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), (Int)str.length(), NULL, 0);
-		std::wstring wstr;
-		if (num_chars)
-		{
-			wstr.resize(num_chars);
-			MultiByteToWideChar(CP_UTF8, 0, str.c_str(), (Int)str.length(), &wstr[0], num_chars);
-		}
-		return wstr;
-	}
-	std::string ToString(std::wstring const& wstr)
-	{
-		Int num_chars = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), (Int)wstr.length(), NULL, 0, NULL, NULL);
-		std::string str;
-		if (num_chars > 0)
-		{
-			str.resize(num_chars);
-			WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), (Int)wstr.length(), &str[0], num_chars, NULL, NULL);
-		}
-		return str;
-	}
-
 	std::string ToLower(std::string const& str)
 	{
 		std::string out; out.resize(str.size());
@@ -84,17 +59,6 @@ namespace adria
 		return false;
 	}
 
-	Bool FromCString(Char const* in, Vector3& out)
-	{
-		std::istringstream iss(in);
-		Char open_parenthesis, comma1, comma2, close_parenthesis;
-		if (iss >> open_parenthesis >> out.x >> comma1 >> out.y >> comma2 >> out.z >> close_parenthesis) 
-		{
-			return open_parenthesis == '(' && comma1 == ',' && comma2 == ',' && close_parenthesis == ')' && iss.eof();
-		}
-		return false;
-	}
-
 	std::string IntToString(Int val)
 	{
 		return std::to_string(val);
@@ -112,11 +76,6 @@ namespace adria
 		return val ? "true" : "false";
 	}
 
-	std::string Vector3ToString(Vector3 const& val)
-	{
-		return "(" + std::to_string(val.x) + "," + std::to_string(val.y) + "," + std::to_string(val.z) + ")";
-	}
-
 	std::vector<std::string> SplitString(const std::string& text, Char delimeter)
 	{
 		std::vector<std::string> tokens;
@@ -0,0 +1,266 @@
+#pragma once
+#include <bit>
+#include "Align.h"
+
+namespace adria
+{
+	//two level segregated fit allocator over an index range [0, max_size).
+	//free blocks are kept in size class bins indexed by bitmaps, so allocation and free are O(1),
+	//and freed blocks are eagerly merged with their free neighbours.
+	class TLSFOffsetAllocator
+	{
+		static constexpr Uint32 SL_BITS = 3;
+		static constexpr Uint32 SL_COUNT = 1u << SL_BITS;
+		static constexpr Uint32 FL_COUNT = 32;
+		static constexpr Uint32 INVALID_NODE = static_cast<Uint32>(-1);
+
+		struct Node
+		{
+			Uint32 offset = 0;
+			Uint32 size = 0;
+			Uint32 bin_prev = INVALID_NODE;
+			Uint32 bin_next = INVALID_NODE;
+			Uint32 neighbor_prev = INVALID_NODE;
+			Uint32 neighbor_next = INVALID_NODE;
+			Bool used = false;
+		};
+
+	public:
+		explicit TLSFOffsetAllocator(Uint32 max_size)
+			: max_size(max_size), free_size(max_size), offset_to_node(max_size, INVALID_NODE)
+		{
+			std::fill(std::begin(bin_heads), std::end(bin_heads), INVALID_NODE);
+			if (max_size > 0)
+			{
+				Uint32 node = CreateNode(0, max_size);
+				InsertFreeNode(node);
+			}
+		}
+		ADRIA_DEFAULT_COPYABLE_MOVABLE(TLSFOffsetAllocator)
+		~TLSFOffsetAllocator() = default;
+
+		Uint64 Allocate(Uint32 size)
+		{
+			if (size == 0 || size > free_size)
+			{
+				return INVALID_ALLOC_OFFSET;
+			}
+
+			Uint32 fl = 0, sl = 0;
+			MappingSearch(size, fl, sl);
+			Uint32 node_index = INVALID_NODE;
+			if (FindFreeBin(fl, sl))
+			{
+				node_index = bin_heads[fl * SL_COUNT + sl];
+			}
+			else
+			{
+				//the rounded up search skips the bin of the requested size, it can still hold a large enough block
+				node_index = FindFitInBin(size);
+				if (node_index == INVALID_NODE) return INVALID_ALLOC_OFFSET;
+			}
+			RemoveFreeNode(node_index);
+
+			Uint32 const remainder = nodes[node_index].size - size;
+			if (remainder > 0)
+			{
+				Uint32 remainder_index = CreateNode(nodes[node_index].offset + size, remainder);
+				Uint32 const next_index = nodes[node_index].neighbor_next;
+				nodes[remainder_index].neighbor_prev = node_index;
+				nodes[remainder_index].neighbor_next = next_index;
+				if (next_index != INVALID_NODE) nodes[next_index].neighbor_prev = remainder_index;
+				nodes[node_index].neighbor_next = remainder_index;
+				nodes[node_index].size = size;
+				InsertFreeNode(remainder_index);
+			}
+
+			Node& node = nodes[node_index];
+			node.used = true;
+			offset_to_node[node.offset] = node_index;
+			free_size -= size;
+			return node.offset;
+		}
+
+		void Free(Uint64 offset)
+		{
+			ADRIA_ASSERT(offset < max_size);
+			Uint32 node_index = offset_to_node[offset];
+			ADRIA_ASSERT_MSG(node_index != INVALID_NODE && nodes[node_index].used, "Freeing an offset that was not allocated");
+			offset_to_node[offset] = INVALID_NODE;
+
+			nodes[node_index].used = false;
+			free_size += nodes[node_index].size;
+
+			Uint32 const prev_index = nodes[node_index].neighbor_prev;
+			if (prev_index != INVALID_NODE && !nodes[prev_index].used)
+			{
+				RemoveFreeNode(prev_index);
+				MergeWithNext(prev_index);
+				node_index = prev_index;
+			}
+			Uint32 const next_index = nodes[node_index].neighbor_next;
+			if (next_index != INVALID_NODE && !nodes[next_index].used)
+			{
+				RemoveFreeNode(next_index);
+				MergeWithNext(node_index);
+			}
+			InsertFreeNode(node_index);
+		}
+
+		Uint32 MaxSize()  const { return max_size; }
+		Uint32 FreeSize() const { return free_size; }
+		Uint32 UsedSize() const { return max_size - free_size; }
+		Bool Full()		  const { return free_size == 0; }
+		Bool Empty()	  const { return free_size == max_size; }
+
+		Uint32 LargestFreeBlock() const
+		{
+			if (fl_bitmap == 0) return 0;
+			Uint32 const fl = 31 - std::countl_zero(fl_bitmap);
+			Uint32 const sl = 31 - std::countl_zero(sl_bitmaps[fl]);
+			Uint32 largest = 0;
+			for (Uint32 node = bin_heads[fl * SL_COUNT + sl]; node != INVALID_NODE; node = nodes[node].bin_next)
+			{
+				largest = std::max(largest, nodes[node].size);
+			}
+			return largest;
+		}
+
+	private:
+		Uint32 max_size;
+		Uint32 free_size;
+		Uint32 fl_bitmap = 0;
+		Uint32 sl_bitmaps[FL_COUNT] = {};
+		Uint32 bin_heads[FL_COUNT * SL_COUNT];
+		std::vector<Node> nodes;
+		std::vector<Uint32> unused_nodes;
+		std::vector<Uint32> offset_to_node;
+
+	private:
+		static void MappingInsert(Uint32 size, Uint32& fl, Uint32& sl)
+		{
+			if (size < SL_COUNT)
+			{
+				fl = 0;
+				sl = size;
+			}
+			else
+			{
+				Uint32 const msb = 31 - std::countl_zero(size);
+				fl = msb - SL_BITS + 1;
+				sl = (size >> (msb - SL_BITS)) - SL_COUNT;
+			}
+		}
+
+		//rounds the size up to the next bin so every block in the found bin is large enough
+		static void MappingSearch(Uint32 size, Uint32& fl, Uint32& sl)
+		{
+			if (size >= SL_COUNT)
+			{
+				Uint32 const msb = 31 - std::countl_zero(size);
+				Uint64 const rounded_size = (Uint64)size + (1ull << (msb - SL_BITS)) - 1;
+				if (rounded_size > UINT32_MAX)
+				{
+					fl = FL_COUNT;
+					sl = 0;
+					return;
+				}
+				size = (Uint32)rounded_size;
+			}
+			MappingInsert(size, fl, sl);
+		}
+
+		Bool FindFreeBin(Uint32& fl, Uint32& sl) const
+		{
+			if (fl >= FL_COUNT) return false;
+
+			Uint32 sl_map = sl_bitmaps[fl] & (~0u << sl);
+			if (sl_map == 0)
+			{
+				Uint32 const fl_map = fl + 1 < FL_COUNT ? fl_bitmap & (~0u << (fl + 1)) : 0;
+				if (fl_map == 0) return false;
+				fl = std::countr_zero(fl_map);
+				sl_map = sl_bitmaps[fl];
+			}
+			sl = std::countr_zero(sl_map);
+			return true;
+		}
+
+		Uint32 FindFitInBin(Uint32 size) const
+		{
+			Uint32 fl = 0, sl = 0;
+			MappingInsert(size, fl, sl);
+			for (Uint32 node = bin_heads[fl * SL_COUNT + sl]; node != INVALID_NODE; node = nodes[node].bin_next)
+			{
+				if (nodes[node].size >= size) return node;
+			}
+			return INVALID_NODE;
+		}
+
+		Uint32 CreateNode(Uint32 offset, Uint32 size)
+		{
+			Uint32 node_index;
+			if (!unused_nodes.empty())
+			{
+				node_index = unused_nodes.back();
+				unused_nodes.pop_back();
+				nodes[node_index] = Node{};
+			}
+			else
+			{
+				node_index = (Uint32)nodes.size();
+				nodes.emplace_back();
+			}
+			nodes[node_index].offset = offset;
+			nodes[node_index].size = size;
+			return node_index;
+		}
+
+		void InsertFreeNode(Uint32 node_index)
+		{
+			Uint32 fl = 0, sl = 0;
+			MappingInsert(nodes[node_index].size, fl, sl);
+			Uint32& head = bin_heads[fl * SL_COUNT + sl];
+
+			nodes[node_index].bin_prev = INVALID_NODE;
+			nodes[node_index].bin_next = head;
+			if (head != INVALID_NODE) nodes[head].bin_prev = node_index;
+			head = node_index;
+
+			fl_bitmap |= 1u << fl;
+			sl_bitmaps[fl] |= 1u << sl;
+		}
+
+		void RemoveFreeNode(Uint32 node_index)
+		{
+			Node& node = nodes[node_index];
+			Uint32 fl = 0, sl = 0;
+			MappingInsert(node.size, fl, sl);
+			Uint32& head = bin_heads[fl * SL_COUNT + sl];
+
+			if (node.bin_prev != INVALID_NODE) nodes[node.bin_prev].bin_next = node.bin_next;
+			if (node.bin_next != INVALID_NODE) nodes[node.bin_next].bin_prev = node.bin_prev;
+			if (head == node_index)
+			{
+				head = node.bin_next;
+				if (head == INVALID_NODE)
+				{
+					sl_bitmaps[fl] &= ~(1u << sl);
+					if (sl_bitmaps[fl] == 0) fl_bitmap &= ~(1u << fl);
+				}
+			}
+			node.bin_prev = INVALID_NODE;
+			node.bin_next = INVALID_NODE;
+		}
+
+		void MergeWithNext(Uint32 node_index)
+		{
+			Uint32 const next_index = nodes[node_index].neighbor_next;
+			Node const& next = nodes[next_index];
+			nodes[node_index].size += next.size;
+			nodes[node_index].neighbor_next = next.neighbor_next;
+			if (next.neighbor_next != INVALID_NODE) nodes[next.neighbor_next].neighbor_prev = node_index;
+			unused_nodes.push_back(next_index);
+		}
+	};
+}